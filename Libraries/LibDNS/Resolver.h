@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/AnyOf.h>
 #include <AK/AtomicRefCounted.h>
 #include <AK/CountingStream.h>
 #include <AK/HashTable.h>
@@ -101,6 +102,14 @@ public:
         for (size_t i = 0; i < m_cached_records.size();) {
             auto& record = m_cached_records[i];
             if (record.expiration.has_value() && record.expiration.value() < now) {
+                // Expired address records are kept around for a while, so that they may be served while the name is
+                // being refreshed (https://www.rfc-editor.org/rfc/rfc8767).
+                if (is_address_type(record.record.type) && record.expiration.value() + MAXIMUM_STALENESS >= now) {
+                    dbgln_if(DNS_DEBUG, "DNS: Keeping stale record for {}", m_name.to_string());
+                    ++i;
+                    continue;
+                }
+
                 dbgln_if(DNS_DEBUG, "DNS: Removing expired record for {}", m_name.to_string());
                 m_cached_records.remove(i);
             } else {
@@ -116,11 +125,53 @@ public:
 
     void add_record(Messages::ResourceRecord record)
     {
-        m_valid = true;
         auto expiration = record.ttl > 0 ? Optional<AK::UnixDateTime>(AK::UnixDateTime::now() + AK::Duration::from_seconds(record.ttl)) : OptionalNone();
+        add_record(move(record), move(expiration));
+    }
+
+    void add_record(Messages::ResourceRecord record, Optional<AK::UnixDateTime> expiration)
+    {
+        m_valid = true;
         m_cached_records.append({ move(record), move(expiration) });
     }
 
+    // Whether any record has outlived its TTL, and is only being kept to be served while the name is refreshed.
+    bool is_stale() const
+    {
+        auto now = AK::UnixDateTime::now();
+        return any_of(m_cached_records, [&](auto const& re) { return re.expiration.has_value() && re.expiration.value() < now; });
+    }
+
+    // Whether any record has entered the last tenth of its TTL.
+    bool is_nearing_expiration() const
+    {
+        auto now = AK::UnixDateTime::now();
+        return any_of(m_cached_records, [&](auto const& re) {
+            if (!re.expiration.has_value())
+                return false;
+            auto refresh_window = AK::Duration::from_seconds(max(re.record.ttl / 10, 1u));
+            return re.expiration.value() - refresh_window < now;
+        });
+    }
+
+    struct AddressExpiration {
+        AK::UnixDateTime expiration;
+        u32 ttl { 0 };
+    };
+
+    // The expiration of the earliest expiring address record, along with that record's TTL.
+    Optional<AddressExpiration> address_expiration() const
+    {
+        Optional<AddressExpiration> result;
+        for (auto const& re : m_cached_records) {
+            if (!is_address_type(re.record.type) || !re.expiration.has_value())
+                continue;
+            if (!result.has_value() || re.expiration.value() < result->expiration)
+                result = AddressExpiration { re.expiration.value(), re.record.ttl };
+        }
+        return result;
+    }
+
     Vector<Messages::ResourceRecord> records() const
     {
         Vector<Messages::ResourceRecord> result;
@@ -178,6 +229,8 @@ public:
     u16 id() { return m_id; }
 
     bool can_be_removed() const { return !m_valid && m_request_done; }
+    bool is_refreshing() const { return m_refreshing; }
+    void set_refreshing(bool refreshing) { m_refreshing = refreshing; }
     bool is_done() const { return m_request_done; }
     bool is_empty() const { return m_cached_records.is_empty(); }
     void set_dnssec_validated(bool validated) { m_dnssec_validated = validated; }
@@ -193,9 +246,33 @@ public:
             m_used_dnskeys.append(move(key));
     }
 
+    void did_use()
+    {
+        m_last_used_at = MonotonicTime::now();
+        ++m_use_count;
+    }
+
+    // A refreshed result takes over the usage of the result it replaces in the cache.
+    void inherit_usage_from(LookupResult const& other)
+    {
+        m_last_used_at = max(m_last_used_at, other.m_last_used_at);
+        m_use_count += other.m_use_count;
+    }
+
+    MonotonicTime last_used_at() const { return m_last_used_at; }
+    u32 use_count() const { return m_use_count; }
+
+    static constexpr bool is_address_type(Messages::ResourceType type)
+    {
+        return type == Messages::ResourceType::A || type == Messages::ResourceType::AAAA;
+    }
+
+    static constexpr auto MAXIMUM_STALENESS = AK::Duration::from_seconds(24 * 60 * 60);
+
 private:
     bool m_valid { false };
     bool m_request_done { false };
+    bool m_refreshing { false };
     bool m_dnssec_validated { false };
     bool m_being_dnssec_validated { false };
     Messages::DomainName m_name;
@@ -210,6 +287,9 @@ private:
     Vector<Messages::Records::DNSKEY> m_used_dnskeys {};
     HashTable<u16> m_seen_key_tags;
     u16 m_id { 0 };
+
+    MonotonicTime m_last_used_at { MonotonicTime::now() };
+    u32 m_use_count { 0 };
 };
 
 class Resolver {
@@ -221,6 +301,7 @@ class Resolver {
         NonnullRefPtr<Core::Promise<NonnullRefPtr<LookupResult const>>> promise;
         NonnullRefPtr<Core::Timer> repeat_timer;
         size_t times_repeated { 0 };
+        MonotonicTime started_at { MonotonicTime::now() };
     };
 
 public:
@@ -232,6 +313,8 @@ public:
     struct LookupOptions {
         bool validate_dnssec_locally { false };
         PendingLookup* repeating_lookup { nullptr };
+        // Query upstream even if the name is cached. The result replaces the cached one once the query completes.
+        bool bypass_cache { false };
 
         static LookupOptions default_() { return {}; }
     };
@@ -241,6 +324,30 @@ public:
         ConnectionMode mode;
     };
 
+    struct Statistics {
+        u64 hits { 0 };
+        u64 stale_hits { 0 };
+        u64 misses { 0 };
+        u64 refreshes { 0 };
+        u64 evictions { 0 };
+        u64 resolved_lookups { 0 };
+        AK::Duration total_lookup_latency;
+        AK::Duration maximum_lookup_latency;
+    };
+
+    // The addresses a name resolved to, in a form which may be used to seed the cache of another resolver.
+    struct CachedAddresses {
+        ByteString name;
+        Vector<Variant<IPv4Address, IPv6Address>> addresses;
+        AK::UnixDateTime expiration;
+        u32 ttl { 0 };
+    };
+
+    static constexpr size_t DEFAULT_MAXIMUM_CACHE_ENTRY_COUNT = 1000;
+
+    // Names which have been looked up at least this many times are refreshed before they expire.
+    static constexpr u32 PROACTIVE_REFRESH_MINIMUM_USE_COUNT = 3;
+
     Resolver(Function<ErrorOr<SocketResult>()> create_socket)
         : m_pending_lookups(make<RedBlackTree<u16, PendingLookup>>())
         , m_create_socket(move(create_socket))
@@ -267,6 +374,91 @@ public:
         m_socket.with_write_locked([&](auto& socket) { socket = {}; });
     }
 
+    Statistics const& statistics() const { return m_statistics; }
+
+    void set_maximum_cache_entry_count(size_t maximum_cache_entry_count)
+    {
+        m_maximum_cache_entry_count = maximum_cache_entry_count;
+        m_cache.with_write_locked([&](auto& cache) { evict_least_recently_used_entries(cache); });
+    }
+
+    Vector<CachedAddresses> most_recently_used_addresses(size_t maximum_count)
+    {
+        flush_cache();
+
+        Vector<NonnullRefPtr<LookupResult>> results;
+        m_cache.with_read_locked([&](auto& cache) {
+            for (auto const& [name, result] : cache) {
+                if (result->is_done() && result->has_cached_addresses())
+                    results.append(result);
+            }
+        });
+
+        quick_sort(results, [](auto const& a, auto const& b) { return a->last_used_at() > b->last_used_at(); });
+
+        Vector<CachedAddresses> addresses;
+        for (auto const& result : results) {
+            if (addresses.size() == maximum_count)
+                break;
+
+            auto expiration = result->address_expiration();
+            if (!expiration.has_value())
+                continue;
+
+            addresses.append({
+                .name = result->name().to_string().to_byte_string(),
+                .addresses = result->cached_addresses(),
+                .expiration = expiration->expiration,
+                .ttl = expiration->ttl,
+            });
+        }
+
+        return addresses;
+    }
+
+    // Forgets the names that were used since the given time. Lookups that are still in flight are left alone.
+    void remove_cache_entries_used_since(MonotonicTime since)
+    {
+        m_cache.with_write_locked([&](auto& cache) {
+            cache.remove_all_matching([&](auto const&, auto const& result) {
+                return result->is_done() && result->last_used_at() >= since;
+            });
+        });
+    }
+
+    // Entries that are already cached are left untouched. Entries that have expired are served stale (and refreshed)
+    // on their first lookup.
+    void seed_cache(ReadonlySpan<CachedAddresses> entries)
+    {
+        auto now = AK::UnixDateTime::now();
+
+        m_cache.with_write_locked([&](auto& cache) {
+            for (auto const& entry : entries) {
+                if (entry.addresses.is_empty() || entry.expiration + LookupResult::MAXIMUM_STALENESS < now || cache.contains(entry.name))
+                    continue;
+
+                auto result = make_ref_counted<LookupResult>(Messages::DomainName::from_string(entry.name));
+                result->will_add_record_of_type(Messages::ResourceType::A);
+                result->will_add_record_of_type(Messages::ResourceType::AAAA);
+
+                for (auto const& address : entry.addresses) {
+                    address.visit(
+                        [&](IPv4Address const& ipv4) {
+                            result->add_record({ .name = {}, .type = Messages::ResourceType::A, .class_ = Messages::Class::IN, .ttl = entry.ttl, .record = Messages::Records::A { ipv4 }, .raw = {} }, entry.expiration);
+                        },
+                        [&](IPv6Address const& ipv6) {
+                            result->add_record({ .name = {}, .type = Messages::ResourceType::AAAA, .class_ = Messages::Class::IN, .ttl = entry.ttl, .record = Messages::Records::AAAA { ipv6 }, .raw = {} }, entry.expiration);
+                        });
+                }
+
+                result->finished_request();
+                cache.set(entry.name, move(result));
+            }
+
+            evict_least_recently_used_entries(cache);
+        });
+    }
+
     NonnullRefPtr<LookupResult const> expect_cached(StringView name, Messages::Class class_ = Messages::Class::IN)
     {
         return expect_cached(name, class_, Array { Messages::ResourceType::A, Messages::ResourceType::AAAA });
@@ -287,23 +479,7 @@ public:
 
     RefPtr<LookupResult const> lookup_in_cache(StringView name, Messages::Class, Span<Messages::ResourceType const> desired_types)
     {
-        return m_cache.with_read_locked([&](auto& cache) -> RefPtr<LookupResult const> {
-            auto it = cache.find(name);
-            if (it == cache.end())
-                return {};
-
-            auto& result = *it->value;
-            // For completed lookups, treat a previously-asked-about type with no records as a hit (negative cache)
-            // — getaddrinfo and async DNS often return only A when the host has no AAAA. In-flight lookups must
-            // still fall through to the join-pending path, so gate on is_done().
-            auto allow_negative_cache = result.is_done();
-            for (auto const& type : desired_types) {
-                if (!result.has_record_of_type(type, allow_negative_cache))
-                    return {};
-            }
-
-            return result;
-        });
+        return find_in_cache(name, desired_types);
     }
 
     NonnullRefPtr<Core::Promise<NonnullRefPtr<LookupResult const>>> lookup(ByteString name, Messages::Class class_, Vector<Vector<Messages::ResourceType>> desired_types, LookupOptions options = LookupOptions::default_())
@@ -413,17 +589,21 @@ public:
             return promise;
         }
 
-        if (auto result = lookup_in_cache(name, class_, desired_types)) {
+        if (auto result = options.bypass_cache ? nullptr : find_in_cache(name, desired_types)) {
             dbgln_if(DNS_DEBUG, "DNS: Resolving {} from cache...", name);
             if (!options.validate_dnssec_locally || result->is_dnssec_validated()) {
                 dbgln_if(DNS_DEBUG, "DNS: Resolved {} from cache", name);
+                lookup_path = result->is_stale() ? "cache-hit-stale"sv : "cache-hit"sv;
+                did_hit_cache(name, class_, desired_types, options, *result);
                 promise->resolve(result.release_nonnull());
-                lookup_path = "cache-hit"sv;
                 return promise;
             }
             dbgln_if(DNS_DEBUG, "DNS: Cache entry for {} is not DNSSEC validated (and we expect that), re-resolving", name);
         }
 
+        if (!options.repeating_lookup && !options.bypass_cache)
+            ++m_statistics.misses;
+
         auto domain_name = Messages::DomainName::from_string(name);
 
         if (!has_connection()) {
@@ -514,7 +694,7 @@ public:
         auto result = m_cache.with_write_locked([&](auto& cache) -> NonnullRefPtr<LookupResult> {
             dbgln_if(DNS_DEBUG, "DNS: Resolving {}...", name);
             auto existing = [&] -> RefPtr<LookupResult> {
-                if (cache.contains(name)) {
+                if (!options.bypass_cache && cache.contains(name)) {
                     dbgln_if(DNS_DEBUG, "DNS: Resolving {} from cache...", name);
                     auto ptr = *cache.get(name);
 
@@ -540,13 +720,18 @@ public:
                 return *existing;
             }
 
+            if (options.bypass_cache) {
+                // NB: A refresh is only stored in the cache once it completes, so that the cached answer may be served
+                //     until then. Repeated attempts at the refresh reuse the result of the first attempt.
+                return m_refreshing_results.with_write_locked([&](auto& refreshing) -> NonnullRefPtr<LookupResult> {
+                    return refreshing.ensure(name, [&] { return create_pending_result(domain_name, desired_types, options); });
+                });
+            }
+
             dbgln_if(DNS_DEBUG, "DNS: Adding {} to cache", name);
-            auto ptr = make_ref_counted<LookupResult>(domain_name);
-            if (!ptr->is_dnssec_validated())
-                ptr->set_dnssec_validated(options.validate_dnssec_locally);
-            for (auto const& type : desired_types)
-                ptr->will_add_record_of_type(type);
+            auto ptr = create_pending_result(domain_name, desired_types, options);
             cache.set(name, ptr);
+            evict_least_recently_used_entries(cache);
             return ptr;
         });
 
@@ -641,7 +826,7 @@ public:
                   p->repeat_timer->set_single_shot(true);
                   p->repeat_timer->set_interval(1000);
                   p->repeat_timer->on_timeout = [=, this] {
-                      (void)lookup(name, class_, desired_types, { .validate_dnssec_locally = options.validate_dnssec_locally, .repeating_lookup = p });
+                      (void)lookup(name, class_, desired_types, { .validate_dnssec_locally = options.validate_dnssec_locally, .repeating_lookup = p, .bypass_cache = options.bypass_cache });
                   };
 
                   return nullptr;
@@ -696,6 +881,27 @@ public:
     }
 
 private:
+    RefPtr<LookupResult> find_in_cache(StringView name, Span<Messages::ResourceType const> desired_types)
+    {
+        return m_cache.with_read_locked([&](auto& cache) -> RefPtr<LookupResult> {
+            auto it = cache.find(name);
+            if (it == cache.end())
+                return {};
+
+            auto& result = *it->value;
+            // For completed lookups, treat a previously-asked-about type with no records as a hit (negative cache)
+            // — getaddrinfo and async DNS often return only A when the host has no AAAA. In-flight lookups must
+            // still fall through to the join-pending path, so gate on is_done().
+            auto allow_negative_cache = result.is_done();
+            for (auto const& type : desired_types) {
+                if (!result.has_record_of_type(type, allow_negative_cache))
+                    return {};
+            }
+
+            return result;
+        });
+    }
+
     // Per-name state for an in-flight system-resolver lookup. We split the
     // single AF_UNSPEC `getaddrinfo` call into two parallel calls (AF_INET +
     // AF_INET6) so that buggy stub resolvers (notably systemd-resolved under
@@ -736,7 +942,7 @@ private:
 
     // Resolve (or reject) every joined caller's promise from `state` and tear down any pending grace timer.
     // Idempotent — safe to call from both the main completion path and from the grace timer callback.
-    static void try_finalize_pending_system_resolution(PendingSystemResolution& state)
+    void try_finalize_pending_system_resolution(PendingSystemResolution& state)
     {
         if (state.promise_resolved)
             return;
@@ -750,6 +956,7 @@ private:
             for (auto& promise : promises)
                 promise->reject(Error::from_string_literal("Could not resolve to IPv4 or IPv6 address"));
         } else {
+            did_resolve_lookup(state.dispatched_at);
             for (auto& promise : promises)
                 promise->resolve(state.result);
         }
@@ -787,9 +994,7 @@ private:
 
         if (both_completed) {
             state.result->finished_request();
-            m_cache.with_write_locked([&](auto& cache) {
-                cache.set(name, state.result);
-            });
+            store_in_cache(name, state.result);
             m_pending_system_resolutions.with_write_locked([&](auto& pending) {
                 pending.remove(name);
             });
@@ -818,7 +1023,7 @@ private:
             return;
         constexpr int RESOLUTION_DELAY_MS = 50;
         auto weak_state = state.make_weak_ptr();
-        state.grace_timer = Core::Timer::create_single_shot(RESOLUTION_DELAY_MS, [weak_state] {
+        state.grace_timer = Core::Timer::create_single_shot(RESOLUTION_DELAY_MS, [this, weak_state] {
             if (auto state = weak_state.strong_ref())
                 try_finalize_pending_system_resolution(*state);
         });
@@ -894,6 +1099,7 @@ private:
                     result->add_record(move(record));
 
                 result->finished_request();
+                did_resolve_lookup(lookup->started_at);
                 lookup->promise->resolve(*result);
                 lookups->remove(message.header.id);
                 return {};
@@ -1405,6 +1611,113 @@ private:
         m_socket_ready_promises.clear();
     }
 
+    static NonnullRefPtr<LookupResult> create_pending_result(Messages::DomainName const& name, Vector<Messages::ResourceType> const& desired_types, LookupOptions const& options)
+    {
+        auto result = make_ref_counted<LookupResult>(name);
+        result->set_dnssec_validated(options.validate_dnssec_locally);
+        for (auto const& type : desired_types)
+            result->will_add_record_of_type(type);
+        return result;
+    }
+
+    void did_hit_cache(ByteString const& name, Messages::Class class_, Vector<Messages::ResourceType> const& desired_types, LookupOptions const& options, LookupResult& result)
+    {
+        result.did_use();
+
+        // Stale answers are served while the name is refreshed in the background, rather than making the caller wait
+        // for a full round trip.
+        if (result.is_stale()) {
+            ++m_statistics.stale_hits;
+            refresh(name, class_, desired_types, options, result);
+            return;
+        }
+
+        ++m_statistics.hits;
+
+        // Frequently used names are refreshed shortly before they expire, so that they never go stale to begin with.
+        if (result.use_count() >= PROACTIVE_REFRESH_MINIMUM_USE_COUNT && result.is_nearing_expiration())
+            refresh(name, class_, desired_types, options, result);
+    }
+
+    void refresh(ByteString const& name, Messages::Class class_, Vector<Messages::ResourceType> const& desired_types, LookupOptions const& options, LookupResult& cached_result)
+    {
+        if (cached_result.is_refreshing())
+            return;
+
+        dbgln_if(DNS_DEBUG, "DNS: Refreshing {} in the background", name);
+        cached_result.set_refreshing(true);
+        ++m_statistics.refreshes;
+
+        lookup(name, class_, desired_types, { .validate_dnssec_locally = options.validate_dnssec_locally, .bypass_cache = true })
+            ->when_resolved([this, name](auto&) {
+                auto refreshed_result = m_refreshing_results.with_write_locked([&](auto& refreshing) { return refreshing.take(name); });
+                if (refreshed_result.has_value())
+                    store_in_cache(name, refreshed_result.release_value());
+            })
+            .when_rejected([this, name, cached_result = cached_result.make_weak_ptr()](auto& error) {
+                dbgln_if(DNS_DEBUG, "DNS: Unable to refresh {}: {}", name, error);
+                m_refreshing_results.with_write_locked([&](auto& refreshing) { refreshing.remove(name); });
+
+                if (auto result = cached_result.strong_ref())
+                    result->set_refreshing(false);
+            });
+    }
+
+    void store_in_cache(ByteString const& name, NonnullRefPtr<LookupResult> result)
+    {
+        m_cache.with_write_locked([&](auto& cache) {
+            if (auto it = cache.find(name); it != cache.end() && it->value.ptr() != result.ptr()) {
+                auto& existing = *it->value;
+
+                // NB: A refresh which came back empty-handed must not replace an answer we are still able to serve.
+                if (result->is_empty() && !existing.is_empty()) {
+                    existing.set_refreshing(false);
+                    return;
+                }
+
+                result->inherit_usage_from(existing);
+            }
+
+            cache.set(name, move(result));
+            evict_least_recently_used_entries(cache);
+        });
+    }
+
+    void evict_least_recently_used_entries(HashMap<ByteString, NonnullRefPtr<LookupResult>>& cache)
+    {
+        while (cache.size() > m_maximum_cache_entry_count) {
+            Optional<ByteString> least_recently_used;
+            MonotonicTime least_recently_used_at = MonotonicTime::now();
+
+            for (auto const& [name, result] : cache) {
+                // NB: In-flight lookups are only weakly referenced by their pending query, so they must stay cached.
+                if (!result->is_done())
+                    continue;
+
+                if (!least_recently_used.has_value() || result->last_used_at() < least_recently_used_at) {
+                    least_recently_used = name;
+                    least_recently_used_at = result->last_used_at();
+                }
+            }
+
+            if (!least_recently_used.has_value())
+                break;
+
+            dbgln_if(DNS_DEBUG, "DNS: Evicting {} from cache", *least_recently_used);
+            cache.remove(*least_recently_used);
+            ++m_statistics.evictions;
+        }
+    }
+
+    void did_resolve_lookup(MonotonicTime started_at)
+    {
+        auto latency = MonotonicTime::now() - started_at;
+
+        ++m_statistics.resolved_lookups;
+        m_statistics.total_lookup_latency += latency;
+        m_statistics.maximum_lookup_latency = max(m_statistics.maximum_lookup_latency, latency);
+    }
+
     void flush_cache()
     {
         m_cache.with_write_locked([&](auto& cache) {
@@ -1420,6 +1733,9 @@ private:
     }
 
     Sync::RWLockProtected<HashMap<ByteString, NonnullRefPtr<LookupResult>>> m_cache;
+    Sync::RWLockProtected<HashMap<ByteString, NonnullRefPtr<LookupResult>>> m_refreshing_results;
+    size_t m_maximum_cache_entry_count { DEFAULT_MAXIMUM_CACHE_ENTRY_COUNT };
+    Statistics m_statistics;
     Sync::RWLockProtected<HashMap<ByteString, NonnullRefPtr<PendingSystemResolution>>> m_pending_system_resolutions;
     Sync::RWLockProtected<NonnullOwnPtr<RedBlackTree<u16, PendingLookup>>> m_pending_lookups;
     Sync::RWLockProtected<Optional<MaybeOwned<Core::Socket>>> m_socket;
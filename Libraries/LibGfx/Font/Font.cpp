@@ -119,7 +119,7 @@ static int scale_for_harfbuzz(float pixel_size)
 
 hb_font_t* Font::harfbuzz_font() const
 {
-    if (!m_harfbuzz_font) {
+    Sync::call_once(m_harfbuzz_font_once, [&] {
         m_harfbuzz_font = hb_font_create(typeface().harfbuzz_typeface());
         auto harfbuzz_scale = scale_for_harfbuzz(pixel_size());
         hb_font_set_scale(m_harfbuzz_font, harfbuzz_scale, harfbuzz_scale);
@@ -137,7 +137,10 @@ hb_font_t* Font::harfbuzz_font() const
 
             hb_font_set_variations(m_harfbuzz_font, hb_list.data(), hb_list.size());
         }
-    }
+
+        // NB: An immutable hb_font_t can be shaped with from several threads at once.
+        hb_font_make_immutable(m_harfbuzz_font);
+    });
     return m_harfbuzz_font;
 }
 
@@ -199,6 +202,7 @@ Font::ShapingCache::~ShapingCache() = default;
 
 void Font::ShapingCache::clear()
 {
+    Sync::MutexLocker locker(mutex);
     map.clear();
     for (auto& slot : single_ascii_character_map)
         slot = nullptr;
@@ -19,6 +19,8 @@
 #include <LibGfx/Font/Font.h>
 #include <LibGfx/Font/Typeface.h>
 #include <LibGfx/ShapeFeature.h>
+#include <LibSync/Mutex.h>
+#include <LibSync/Once.h>
 
 class SkFont;
 struct hb_font_t;
@@ -105,7 +107,9 @@ public:
     FontVariationSettings const& variation_settings() const { return m_font_variation_settings; }
     ShapeFeatures const& features() const { return m_shape_features; }
 
+    // NB: Text may be shaped from several threads at once, so the cache must only be accessed with its mutex held.
     struct ShapingCache {
+        Sync::Mutex mutex;
         HashMap<ShapingCacheKey, OwnPtr<ShapedGlyphs>> map;
         OwnPtr<ShapedGlyphs> single_ascii_character_map[128];
 
@@ -131,6 +135,7 @@ private:
 
     mutable RefPtr<Font const> m_bold_variant;
     mutable hb_font_t* m_harfbuzz_font { nullptr };
+    mutable Sync::OnceFlag m_harfbuzz_font_once;
 
     mutable ShapingCache m_shaping_cache;
 
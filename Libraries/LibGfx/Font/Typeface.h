@@ -18,6 +18,7 @@
 #include <LibGfx/Forward.h>
 #include <LibGfx/ShapeFeature.h>
 #include <LibIPC/Forward.h>
+#include <LibSync/Once.h>
 
 #define POINTS_PER_INCH 72.0f
 #define DEFAULT_DPI 96
@@ -108,6 +109,7 @@ private:
     mutable HashMap<FontCacheKey, NonnullRefPtr<Font>> m_fonts;
     mutable hb_blob_t* m_harfbuzz_blob { nullptr };
     mutable hb_face_t* m_harfbuzz_face { nullptr };
+    mutable Sync::OnceFlag m_harfbuzz_face_once;
 };
 
 }
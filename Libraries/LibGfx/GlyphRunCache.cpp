@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/BitCast.h>
+#include <AK/HashFunctions.h>
+#include <AK/NeverDestroyed.h>
+#include <LibGfx/GlyphRunCache.h>
+
+namespace Gfx {
+
+// Bound on the glyphs held by a single generation, so the cache as a whole holds at most twice as many. A glyph is
+// around 32 bytes, and the Skia blob built for a run roughly doubles that.
+static constexpr size_t MAXIMUM_GLYPH_COUNT_PER_GENERATION = 128 * KiB;
+
+GlyphRunCache& GlyphRunCache::the()
+{
+    static NeverDestroyed<GlyphRunCache> cache;
+    return *cache;
+}
+
+static unsigned hash_glyph_run_contents(ReadonlySpan<DrawGlyph> glyphs, Font const& font, GlyphRun::TextType text_type, float width)
+{
+    auto hash = pair_int_hash(u64_hash(font.id()), pair_int_hash(to_underlying(text_type), bit_cast<u32>(width)));
+    for (auto const& glyph : glyphs) {
+        hash = pair_int_hash(hash, glyph.glyph_id);
+        hash = pair_int_hash(hash, pair_int_hash(bit_cast<u32>(glyph.position.x()), bit_cast<u32>(glyph.position.y())));
+    }
+    return hash;
+}
+
+// NB: Floats are compared bit for bit, so that a cached run is only handed out for glyphs it reproduces exactly.
+static bool glyphs_are_identical(DrawGlyph const& a, DrawGlyph const& b)
+{
+    return a.glyph_id == b.glyph_id
+        && a.length_in_code_units == b.length_in_code_units
+        && a.should_paint == b.should_paint
+        && bit_cast<u32>(a.position.x()) == bit_cast<u32>(b.position.x())
+        && bit_cast<u32>(a.position.y()) == bit_cast<u32>(b.position.y())
+        && bit_cast<u32>(a.glyph_width) == bit_cast<u32>(b.glyph_width);
+}
+
+static bool glyph_run_has_contents(GlyphRun const& run, ReadonlySpan<DrawGlyph> glyphs, Font const& font, GlyphRun::TextType text_type, float width)
+{
+    if (&run.font() != &font || run.text_type() != text_type || bit_cast<u32>(run.width()) != bit_cast<u32>(width))
+        return false;
+    if (run.glyphs().size() != glyphs.size())
+        return false;
+    for (size_t i = 0; i < glyphs.size(); ++i) {
+        if (!glyphs_are_identical(run.glyphs()[i], glyphs[i]))
+            return false;
+    }
+    return true;
+}
+
+unsigned GlyphRunCache::GlyphRunContentTraits::hash(NonnullRefPtr<GlyphRun> const& run)
+{
+    return hash_glyph_run_contents(run->glyphs(), run->font(), run->text_type(), run->width());
+}
+
+bool GlyphRunCache::GlyphRunContentTraits::equals(NonnullRefPtr<GlyphRun> const& a, NonnullRefPtr<GlyphRun> const& b)
+{
+    return glyph_run_has_contents(*a, b->glyphs(), b->font(), b->text_type(), b->width());
+}
+
+NonnullRefPtr<GlyphRun> GlyphRunCache::find_or_create(ReadonlySpan<DrawGlyph> glyphs, Font const& font, GlyphRun::TextType text_type, float width)
+{
+    auto hash = hash_glyph_run_contents(glyphs, font, text_type, width);
+    auto has_contents = [&](NonnullRefPtr<GlyphRun> const& run) {
+        return glyph_run_has_contents(*run, glyphs, font, text_type, width);
+    };
+
+    if (auto it = m_current.find(hash, has_contents); it != m_current.end()) {
+        ++m_statistics.hits;
+        return *it;
+    }
+
+    if (auto it = m_previous.find(hash, has_contents); it != m_previous.end()) {
+        ++m_statistics.hits;
+        NonnullRefPtr<GlyphRun> run = *it;
+        m_previous.remove(it);
+        m_previous_glyph_count -= run->glyphs().size();
+        insert(run);
+        return run;
+    }
+
+    ++m_statistics.misses;
+    Vector<DrawGlyph> run_glyphs;
+    run_glyphs.ensure_capacity(glyphs.size());
+    run_glyphs.unchecked_append(glyphs.data(), glyphs.size());
+    auto run = adopt_ref(*new GlyphRun(move(run_glyphs), font, text_type, width));
+    insert(run);
+    return run;
+}
+
+void GlyphRunCache::insert(NonnullRefPtr<GlyphRun> run)
+{
+    auto glyph_count = run->glyphs().size();
+
+    // NB: A run too large to ever fit is handed out uncached rather than flushing everything else.
+    if (glyph_count > MAXIMUM_GLYPH_COUNT_PER_GENERATION)
+        return;
+
+    if (m_current_glyph_count + glyph_count > MAXIMUM_GLYPH_COUNT_PER_GENERATION) {
+        m_statistics.evictions += m_previous.size();
+        m_previous = move(m_current);
+        m_previous_glyph_count = m_current_glyph_count;
+        m_current = {};
+        m_current_glyph_count = 0;
+    }
+
+    m_current.set(move(run));
+    m_current_glyph_count += glyph_count;
+}
+
+void GlyphRunCache::purge_unused_runs()
+{
+    auto purge = [&](Generation& generation, size_t& generation_glyph_count) {
+        generation.remove_all_matching([&](NonnullRefPtr<GlyphRun> const& run) {
+            if (run->ref_count() > 1)
+                return false;
+            generation_glyph_count -= run->glyphs().size();
+            ++m_statistics.evictions;
+            return true;
+        });
+    };
+    purge(m_current, m_current_glyph_count);
+    purge(m_previous, m_previous_glyph_count);
+}
+
+void GlyphRunCache::clear()
+{
+    m_current.clear();
+    m_previous.clear();
+    m_current_glyph_count = 0;
+    m_previous_glyph_count = 0;
+}
+
+void GlyphRunCache::dump() const
+{
+    auto lookups = m_statistics.hits + m_statistics.misses;
+    auto hit_rate = lookups == 0 ? 0.0 : 100.0 * static_cast<double>(m_statistics.hits) / static_cast<double>(lookups);
+    warnln("glyph-run-cache: {} runs, {} glyphs", m_current.size() + m_previous.size(), glyph_count());
+    warnln("glyph-run-cache: {} hits, {} misses ({:.1}% hit rate), {} evictions", m_statistics.hits, m_statistics.misses, hit_rate, m_statistics.evictions);
+}
+
+}
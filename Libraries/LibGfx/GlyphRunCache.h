@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/HashTable.h>
+#include <AK/NonnullRefPtr.h>
+#include <AK/Span.h>
+#include <LibGfx/TextLayout.h>
+
+namespace Gfx {
+
+// A process-wide cache of glyph runs, keyed by everything they contain: the font (which carries its features and
+// variations), the text type, the width, and every glyph (which carries the letter-spacing applied while shaping).
+// Text that produces the same glyphs again, such as unchanged lines after a relayout or a word repeated across the
+// page, gets the same GlyphRun back, along with the Skia text blob that was built for it the last time it was painted.
+//
+// The cache is bounded by the number of glyphs it holds. It keeps two generations: once the current one is full it
+// becomes the previous one, and the old previous one is dropped. Runs found in the previous generation move back to
+// the current one, so runs that keep being used survive indefinitely while unused ones fall out within two turnovers.
+//
+// NB: The cache is not thread-safe. It is only used from the thread that runs layout.
+class GlyphRunCache {
+public:
+    static GlyphRunCache& the();
+
+    struct Statistics {
+        u64 hits { 0 };
+        u64 misses { 0 };
+        u64 evictions { 0 };
+    };
+
+    NonnullRefPtr<GlyphRun> find_or_create(ReadonlySpan<DrawGlyph>, Font const&, GlyphRun::TextType, float width);
+
+    // Drops every run that is no longer referenced outside of the cache, such as when the page is hidden and is not
+    // going to lay out or paint anything for a while.
+    void purge_unused_runs();
+    void clear();
+
+    size_t glyph_count() const { return m_current_glyph_count + m_previous_glyph_count; }
+    Statistics const& statistics() const { return m_statistics; }
+    void dump() const;
+
+private:
+    struct GlyphRunContentTraits : public DefaultTraits<NonnullRefPtr<GlyphRun>> {
+        static unsigned hash(NonnullRefPtr<GlyphRun> const&);
+        static bool equals(NonnullRefPtr<GlyphRun> const&, NonnullRefPtr<GlyphRun> const&);
+    };
+    using Generation = HashTable<NonnullRefPtr<GlyphRun>, GlyphRunContentTraits>;
+
+    void insert(NonnullRefPtr<GlyphRun>);
+
+    Generation m_current;
+    Generation m_previous;
+    size_t m_current_glyph_count { 0 };
+    size_t m_previous_glyph_count { 0 };
+
+    Statistics m_statistics;
+};
+
+}
@@ -14,6 +14,7 @@
 #include <LibGfx/Font/Font.h>
 #include <LibGfx/Point.h>
 #include <LibGfx/TextLayout.h>
+#include <LibSync/Mutex.h>
 #include <LibUnicode/CharacterTypes.h>
 #include <RustFFI.h>
 #include <core/SkFont.h>
@@ -286,14 +287,25 @@ NonnullRefPtr<GlyphRun> shape_text(FloatPoint baseline_start, float letter_spaci
         return adopt_ref(*new GlyphRun(move(glyphs), font, text_type, shape.width));
     };
 
+    // NB: The cache is shared by every thread that shapes text with this font, so it is only accessed with its mutex
+    //     held. Shaping a miss happens outside of the lock, and the first of several threads that raced to shape the
+    //     same text gets to store its result.
     // FIXME: The cache currently grows unbounded. We should have some limit and LRU mechanism.
     if (string.length_in_code_units() == 1 && letter_spacing == 0.f && text_type == GlyphRun::TextType::Common) {
         auto code_unit = string.code_unit_at(0);
         if (code_unit < 128) {
             auto& cache_slot = shaping_cache.single_ascii_character_map[code_unit];
+            {
+                Sync::MutexLocker locker(shaping_cache.mutex);
+                if (cache_slot)
+                    return build_glyph_run(*cache_slot);
+            }
+            auto shape = build_origin_relative_shape(string, font, text_type, letter_spacing);
+            auto run = build_glyph_run(*shape);
+            Sync::MutexLocker locker(shaping_cache.mutex);
             if (!cache_slot)
-                cache_slot = build_origin_relative_shape(string, font, text_type, letter_spacing);
-            return build_glyph_run(*cache_slot);
+                cache_slot = move(shape);
+            return run;
         }
     }
 
@@ -301,18 +313,22 @@ NonnullRefPtr<GlyphRun> shape_text(FloatPoint baseline_start, float letter_spaci
     auto letter_spacing_bit_pattern = bit_cast<u32>(letter_spacing);
     auto key_hash = pair_int_hash(string.hash(), pair_int_hash(text_type_bits, letter_spacing_bit_pattern));
 
-    if (auto it = shaping_cache.map.find(key_hash, [&](auto const& candidate) {
-            return candidate.key.text_type == text_type_bits
-                && candidate.key.letter_spacing_bit_pattern == letter_spacing_bit_pattern
-                && candidate.key.text == string;
-        });
-        it != shaping_cache.map.end()) {
-        return build_glyph_run(*it->value);
+    {
+        Sync::MutexLocker locker(shaping_cache.mutex);
+        if (auto it = shaping_cache.map.find(key_hash, [&](auto const& candidate) {
+                return candidate.key.text_type == text_type_bits
+                    && candidate.key.letter_spacing_bit_pattern == letter_spacing_bit_pattern
+                    && candidate.key.text == string;
+            });
+            it != shaping_cache.map.end()) {
+            return build_glyph_run(*it->value);
+        }
     }
 
     auto shape = build_origin_relative_shape(string, font, text_type, letter_spacing);
     auto run = build_glyph_run(*shape);
-    shaping_cache.map.set({ Utf16String::from_utf16(string), text_type_bits, letter_spacing_bit_pattern }, move(shape));
+    Sync::MutexLocker locker(shaping_cache.mutex);
+    shaping_cache.map.ensure({ Utf16String::from_utf16(string), text_type_bits, letter_spacing_bit_pattern }, [&] { return move(shape); });
     return run;
 }
 
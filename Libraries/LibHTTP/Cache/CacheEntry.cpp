@@ -4,18 +4,134 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/AtomicRefCounted.h>
+#include <AK/ConstrainedStream.h>
 #include <AK/Debug.h>
 #include <AK/HashFunctions.h>
 #include <AK/ScopeGuard.h>
+#include <LibCore/AnonymousBuffer.h>
 #include <LibCore/System.h>
 #include <LibFileSystem/FileSystem.h>
 #include <LibHTTP/Cache/CacheEntry.h>
+#include <LibHTTP/Cache/CacheIOQueue.h>
 #include <LibHTTP/Cache/CacheIndex.h>
 #include <LibHTTP/Cache/DiskCache.h>
 #include <LibHTTP/Cache/Utilities.h>
 
 namespace HTTP {
 
+// Entries with bodies up to this size are packed into segments, rather than each having a file of their own. Larger
+// bodies keep their own file, so that they may be streamed and mapped without holding on to an entire segment.
+static constexpr u64 MAXIMUM_PACKED_ENTRY_DATA_SIZE = 64 * KiB;
+
+// Compressing smaller bodies saves too little space to be worth the time spent decompressing them on every read.
+static constexpr u64 MINIMUM_COMPRESSED_BODY_SIZE = 1 * KiB;
+
+// Compressed bodies are decompressed into memory when they are handed off as files, so their decompressed size has to
+// be bounded. Larger bodies are stored as they are.
+static constexpr u64 MAXIMUM_COMPRESSED_BODY_DECODED_SIZE = 64 * MiB;
+
+static constexpr size_t DECODED_BODY_BUFFER_SIZE = 16 * KiB;
+
+static bool is_compressible_mime_type(StringView essence)
+{
+    if (essence.starts_with("text/"sv, CaseSensitivity::CaseInsensitive))
+        return true;
+    if (essence.ends_with("+json"sv, CaseSensitivity::CaseInsensitive) || essence.ends_with("+xml"sv, CaseSensitivity::CaseInsensitive))
+        return true;
+
+    return essence.is_one_of_ignoring_ascii_case(
+        "application/ecmascript"sv,
+        "application/javascript"sv,
+        "application/json"sv,
+        "application/wasm"sv,
+        "application/x-javascript"sv,
+        "application/xml"sv);
+}
+
+static CacheBodyCodec body_codec_for_response(HeaderList const& response_headers)
+{
+    // NB: Bodies are stored as they were decoded from the network, so the response's Content-Encoding does not tell us
+    //     anything about whether the stored body is already compressed.
+    if (auto content_length = response_headers.get("Content-Length"sv); content_length.has_value()) {
+        if (auto length = content_length->to_number<u64>(); length.has_value() && (*length < MINIMUM_COMPRESSED_BODY_SIZE || *length > MAXIMUM_COMPRESSED_BODY_DECODED_SIZE))
+            return CacheBodyCodec::None;
+    }
+
+    auto content_type = response_headers.get("Content-Type"sv);
+    if (!content_type.has_value())
+        return CacheBodyCodec::None;
+
+    auto essence = content_type->view().find_first_split_view(';').trim_whitespace();
+    if (!is_compressible_mime_type(essence))
+        return CacheBodyCodec::None;
+
+    return CacheBodyCodec::Brotli;
+}
+
+static ErrorOr<NonnullOwnPtr<Stream>> create_body_decoder(Core::File& file, CacheBodyCodec body_codec, u64 data_offset, u64 data_size)
+{
+    TRY(file.seek(data_offset, SeekMode::SetPosition));
+    auto body = make<ConstrainedStream>(MaybeOwned<Stream> { file }, data_size);
+
+    switch (body_codec) {
+    case CacheBodyCodec::None:
+        return NonnullOwnPtr<Stream> { move(body) };
+    case CacheBodyCodec::Brotli:
+        return NonnullOwnPtr<Stream> { TRY(Compress::BrotliDecompressor::create(move(body))) };
+    }
+    VERIFY_NOT_REACHED();
+}
+
+static bool body_file_needs_decoding(CacheBodyCodec body_codec, CacheFooter const& footer)
+{
+    return body_codec != CacheBodyCodec::None && footer.decoded_data_size != 0;
+}
+
+static ErrorOr<CacheEntryBodyFile> create_body_file(int fd, u64 data_offset, CacheFooter const& footer)
+{
+    return CacheEntryBodyFile {
+        .fd = TRY(Core::System::dup(fd)),
+        .offset = data_offset,
+        .size = footer.decoded_data_size,
+    };
+}
+
+// Clients map the body file directly, so a compressed body is decompressed into memory they are able to map. The whole
+// body is decompressed at once, so that happens on the IO thread, and `on_complete` is invoked on the event loop.
+static void decode_body_file(CacheIOQueue& io_queue, LexicalPath const& path, NonnullOwnPtr<Core::File> file, CacheBodyCodec body_codec, u64 data_offset, CacheFooter const& footer, Function<void(ErrorOr<CacheEntryBodyFile>)> on_complete)
+{
+    struct DecodedBodyFile : public AtomicRefCounted<DecodedBodyFile> {
+        Optional<ErrorOr<CacheEntryBodyFile>> result;
+    };
+    auto decoded_body_file = adopt_ref(*new DecodedBodyFile);
+
+    io_queue.submit(path, [decoded_body_file, file = move(file), body_codec, data_offset, footer]() mutable {
+        decoded_body_file->result = [&]() -> ErrorOr<CacheEntryBodyFile> {
+            if (footer.decoded_data_size > MAXIMUM_COMPRESSED_BODY_DECODED_SIZE)
+                return Error::from_string_literal("Compressed body is too large to be decoded");
+
+            auto buffer = TRY(Core::AnonymousBuffer::create_with_size(footer.decoded_data_size));
+            auto decoder = TRY(create_body_decoder(*file, body_codec, data_offset, footer.data_size));
+            TRY(decoder->read_until_filled({ buffer.data<u8>(), footer.decoded_data_size }));
+
+            return CacheEntryBodyFile {
+                .fd = TRY(Core::System::dup(buffer.fd())),
+                .offset = 0,
+                .size = footer.decoded_data_size,
+            };
+        }();
+    });
+
+    io_queue.when_pending_jobs_have_run(path, [decoded_body_file, on_complete = move(on_complete)]() {
+        if (!decoded_body_file->result.has_value()) {
+            on_complete(Error::from_string_literal("Compressed body was not decoded"));
+            return;
+        }
+        on_complete(decoded_body_file->result.release_value());
+    });
+}
+
 ErrorOr<CacheHeader> CacheHeader::read_from_stream(Stream& stream)
 {
     CacheHeader header;
@@ -27,6 +143,7 @@ ErrorOr<CacheHeader> CacheHeader::read_from_stream(Stream& stream)
     header.status_code = TRY(stream.read_value<u32>());
     header.reason_phrase_size = TRY(stream.read_value<u32>());
     header.reason_phrase_hash = TRY(stream.read_value<u32>());
+    header.body_codec = static_cast<CacheBodyCodec>(TRY(stream.read_value<u32>()));
     return header;
 }
 
@@ -40,6 +157,7 @@ ErrorOr<void> CacheHeader::write_to_stream(Stream& stream) const
     TRY(stream.write_value(status_code));
     TRY(stream.write_value(reason_phrase_size));
     TRY(stream.write_value(reason_phrase_hash));
+    TRY(stream.write_value(to_underlying(body_codec)));
     return {};
 }
 
@@ -54,12 +172,14 @@ u32 CacheHeader::hash() const
     hash = pair_int_hash(hash, status_code);
     hash = pair_int_hash(hash, reason_phrase_size);
     hash = pair_int_hash(hash, reason_phrase_hash);
+    hash = pair_int_hash(hash, to_underlying(body_codec));
     return hash;
 }
 
 ErrorOr<void> CacheFooter::write_to_stream(Stream& stream) const
 {
     TRY(stream.write_value(data_size));
+    TRY(stream.write_value(decoded_data_size));
     TRY(stream.write_value(header_hash));
     return {};
 }
@@ -68,6 +188,7 @@ ErrorOr<CacheFooter> CacheFooter::read_from_stream(Stream& stream)
 {
     CacheFooter footer;
     footer.data_size = TRY(stream.read_value<u64>());
+    footer.decoded_data_size = TRY(stream.read_value<u64>());
     footer.header_hash = TRY(stream.read_value<u32>());
     return footer;
 }
@@ -88,9 +209,8 @@ void CacheEntry::remove()
     if (!m_path.has_value())
         return;
 
-    (void)FileSystem::remove(m_path->string(), FileSystem::RecursionMode::Disallowed);
-    for (auto associated_data : CACHE_ENTRY_ASSOCIATED_DATA_TYPES)
-        (void)FileSystem::remove(path_for_cache_entry_associated_data(m_disk_cache.cache_directory(), m_cache_key, m_vary_key, associated_data).string(), FileSystem::RecursionMode::Disallowed);
+    m_disk_cache.remove_file(*m_path);
+    m_disk_cache.remove_associated_data(m_cache_key, m_vary_key);
     m_index.remove_entry(m_cache_key, m_vary_key);
 }
 
@@ -111,6 +231,7 @@ ErrorOr<NonnullOwnPtr<CacheEntryWriter>> CacheEntryWriter::create(DiskCache& dis
 
 CacheEntryWriter::CacheEntryWriter(DiskCache& disk_cache, CacheIndex& index, u64 cache_key, String url, CacheHeader cache_header, UnixDateTime request_time, AK::Duration current_time_offset_for_testing)
     : CacheEntry(disk_cache, index, cache_key, 0, move(url), {}, cache_header)
+    , m_file_state(adopt_ref(*new FileState(m_url.to_byte_string())))
     , m_request_time(request_time)
     , m_current_time_offset_for_testing(current_time_offset_for_testing)
 {
@@ -137,6 +258,7 @@ ErrorOr<void> CacheEntryWriter::write_status_and_reason(u32 status_code, Optiona
             return Error::from_string_literal("Response is not cacheable");
 
         m_vary_key = create_vary_key(request_headers, response_headers);
+        m_cache_header.body_codec = body_codec_for_response(response_headers);
         m_path = path_for_cache_entry(m_disk_cache.cache_directory(), m_cache_key, m_vary_key);
         m_temporary_path = LexicalPath::join(m_disk_cache.cache_directory().string(), ByteString::formatted("{}.tmp", m_path->basename()));
 
@@ -148,15 +270,34 @@ ErrorOr<void> CacheEntryWriter::write_status_and_reason(u32 status_code, Optiona
         if (cache_lifetime_status(request_headers, response_headers, freshness_lifetime, current_age) == CacheLifetimeStatus::Expired)
             return Error::from_string_literal("Response has already expired");
 
-        (void)FileSystem::remove(m_temporary_path->string(), FileSystem::RecursionMode::Disallowed);
-        auto unbuffered_file = TRY(Core::File::open(m_temporary_path->string(), Core::File::OpenMode::Write | Core::File::OpenMode::MustBeNew));
-        m_file = TRY(Core::OutputBufferedFile::create(move(unbuffered_file)));
+        auto reason_phrase_bytes = reason_phrase.has_value() ? reason_phrase->to_byte_string() : ByteString {};
 
-        TRY(m_file->write_value(m_cache_header));
-        TRY(m_file->write_until_depleted(m_url));
-        if (reason_phrase.has_value())
-            TRY(m_file->write_until_depleted(*reason_phrase));
-        m_data_offset = TRY(m_file->tell());
+        auto submitted = m_disk_cache.io_queue().try_submit(*m_temporary_path, m_url.byte_count() + reason_phrase_bytes.length(), [state = m_file_state, temporary_path = m_temporary_path->string(), cache_header = m_cache_header, reason_phrase = move(reason_phrase_bytes)]() {
+            auto result = [&]() -> ErrorOr<void> {
+                (void)FileSystem::remove(temporary_path, FileSystem::RecursionMode::Disallowed);
+                auto unbuffered_file = TRY(Core::File::open(temporary_path, Core::File::OpenMode::Write | Core::File::OpenMode::MustBeNew));
+                state->file = TRY(Core::OutputBufferedFile::create(move(unbuffered_file)));
+
+                TRY(state->file->write_value(cache_header));
+                TRY(state->file->write_until_depleted(state->url.bytes()));
+                TRY(state->file->write_until_depleted(reason_phrase.bytes()));
+                state->data_offset = TRY(state->file->tell());
+
+                if (cache_header.body_codec == CacheBodyCodec::Brotli) {
+                    // Writes happen behind the network anyway, but the best compression is still far too slow to keep up.
+                    state->compressor = TRY(Compress::BrotliCompressor::create(MaybeOwned<Stream> { *state->file }, Compress::BrotliCompressionLevel::Fastest));
+                }
+
+                return {};
+            }();
+
+            if (result.is_error()) {
+                dbgln_if(HTTP_DISK_CACHE_DEBUG, "\033[36m[disk]\033[0m \033[31;1mUnable to create cache entry file for\033[0m {}: {}", state->url, result.error());
+                state->has_failed = true;
+            }
+        });
+        if (!submitted)
+            return Error::from_string_literal("Too much cache data is waiting to be written");
 
         return {};
     }();
@@ -181,7 +322,16 @@ ErrorOr<void> CacheEntryWriter::write_data(ReadonlyBytes data)
         return Error::from_string_literal("Cache entry has been deleted");
     }
 
-    if (auto result = m_file->write_until_depleted(data); result.is_error()) {
+    auto result = [&]() -> ErrorOr<void> {
+        auto buffer = TRY(ByteBuffer::copy(data));
+        return submit_write(buffer.size(), [buffer = move(buffer)](FileState& state) -> ErrorOr<void> {
+            if (state.compressor)
+                return state.compressor->write_until_depleted(buffer);
+            return state.file->write_until_depleted(buffer);
+        });
+    }();
+
+    if (result.is_error()) {
         dbgln_if(HTTP_DISK_CACHE_DEBUG, "\033[36m[disk]\033[0m \033[31;1mUnable to write data to cache entry for\033[0m {}: {}", m_url, result.error());
 
         remove_incomplete_temporary_file();
@@ -190,80 +340,230 @@ ErrorOr<void> CacheEntryWriter::write_data(ReadonlyBytes data)
         return result.release_error();
     }
 
-    m_cache_footer.data_size += data.size();
+    m_cache_footer.decoded_data_size += data.size();
+
+    // NB: Bodies without a Content-Length may only turn out to be too large to be compressed once they are written.
+    if (m_cache_header.body_codec != CacheBodyCodec::None && m_cache_footer.decoded_data_size > MAXIMUM_COMPRESSED_BODY_DECODED_SIZE) {
+        dbgln_if(HTTP_DISK_CACHE_DEBUG, "\033[36m[disk]\033[0m \033[31;1mCompressed body is too large to be cached for\033[0m {}", m_url);
+
+        remove_incomplete_temporary_file();
+        close_and_destroy_cache_entry();
+
+        return Error::from_string_literal("Compressed body is too large to be cached");
+    }
+
+    return {};
+}
+
+ErrorOr<void> CacheEntryWriter::submit_write(size_t buffered_size, Function<ErrorOr<void>(FileState&)> write)
+{
+    // Writes that failed on the IO thread only surface here, once we try to write more.
+    if (m_file_state->has_failed)
+        return Error::from_string_literal("Unable to write to cache entry file");
+
+    auto submitted = m_disk_cache.io_queue().try_submit(*m_temporary_path, buffered_size, [state = m_file_state, write = move(write)]() {
+        if (state->has_failed)
+            return;
+
+        if (auto result = write(*state); result.is_error()) {
+            dbgln_if(HTTP_DISK_CACHE_DEBUG, "\033[36m[disk]\033[0m \033[31;1mUnable to write to cache entry file for\033[0m {}: {}", state->url, result.error());
+            state->has_failed = true;
+        }
+    });
+
+    // Rather than stall the network on a slow disk, we give up on caching this response.
+    if (!submitted)
+        return Error::from_string_literal("Too much cache data is waiting to be written");
     return {};
 }
 
-ErrorOr<void> CacheEntryWriter::flush(NonnullRefPtr<HeaderList> request_headers, NonnullRefPtr<HeaderList> response_headers)
+void CacheEntryWriter::flush(NonnullRefPtr<HeaderList> request_headers, NonnullRefPtr<HeaderList> response_headers, Function<void(ErrorOr<void>)> on_complete)
 {
-    return flush_impl(move(request_headers), move(response_headers), nullptr);
+    flush_impl(move(request_headers), move(response_headers), TakeBodyFile::No, [on_complete = move(on_complete)](ErrorOr<Optional<CacheEntryBodyFile>> result) {
+        if (!on_complete)
+            return;
+        if (result.is_error())
+            on_complete(result.release_error());
+        else
+            on_complete({});
+    });
 }
 
-ErrorOr<CacheEntryBodyFile> CacheEntryWriter::flush_and_take_body_file(NonnullRefPtr<HeaderList> request_headers, NonnullRefPtr<HeaderList> response_headers)
+void CacheEntryWriter::flush_and_take_body_file(NonnullRefPtr<HeaderList> request_headers, NonnullRefPtr<HeaderList> response_headers, Function<void(ErrorOr<CacheEntryBodyFile>)> on_complete)
 {
-    CacheEntryBodyFile body_file;
-    TRY(flush_impl(move(request_headers), move(response_headers), &body_file));
-    return body_file;
+    flush_impl(move(request_headers), move(response_headers), TakeBodyFile::Yes, [on_complete = move(on_complete)](ErrorOr<Optional<CacheEntryBodyFile>> result) {
+        if (result.is_error())
+            on_complete(result.release_error());
+        else
+            on_complete(result.release_value().release_value());
+    });
 }
 
-ErrorOr<void> CacheEntryWriter::flush_impl(NonnullRefPtr<HeaderList> request_headers, NonnullRefPtr<HeaderList> response_headers, CacheEntryBodyFile* body_file)
+void CacheEntryWriter::fail_flush(Error error, FlushCallback& on_complete)
 {
-    ScopeGuard guard { [&]() { close_and_destroy_cache_entry(); } };
+    // NB: Closing the entry destroys it, so the callback has to be moved out of it first.
+    auto callback = move(on_complete);
+    close_and_destroy_cache_entry();
+    callback(move(error));
+}
 
+void CacheEntryWriter::flush_impl(NonnullRefPtr<HeaderList> request_headers, NonnullRefPtr<HeaderList> response_headers, TakeBodyFile take_body_file, FlushCallback on_complete)
+{
     if (m_marked_for_deletion) {
         remove_incomplete_temporary_file();
-        return Error::from_string_literal("Cache entry has been deleted");
+        fail_flush(Error::from_string_literal("Cache entry has been deleted"), on_complete);
+        return;
     }
     VERIFY(m_path.has_value());
     VERIFY(m_temporary_path.has_value());
 
-    ArmedScopeGuard remove_temporary_file = [&]() {
+    m_cache_footer.header_hash = m_cache_header.hash();
+
+    auto write_footer = submit_write(0, [footer = m_cache_footer](FileState& state) -> ErrorOr<void> {
+        if (state.compressor) {
+            TRY(state.compressor->finish());
+            state.compressor.clear();
+        }
+
+        // Only now do we know how large the stored (i.e. compressed) data ended up being.
+        state.data_size = TRY(state.file->tell()) - state.data_offset;
+
+        auto stored_footer = footer;
+        stored_footer.data_size = state.data_size;
+
+        TRY(state.file->write_value(stored_footer));
+        TRY(state.file->flush_buffer());
+        return {};
+    });
+    if (write_footer.is_error()) {
+        dbgln_if(HTTP_DISK_CACHE_DEBUG, "\033[36m[disk]\033[0m \033[31;1mUnable to flush cache entry for\033[0m {}: {}", m_url, write_footer.error());
+
         remove_incomplete_temporary_file();
-    };
+        fail_flush(write_footer.release_error(), on_complete);
+        return;
+    }
 
-    m_cache_footer.header_hash = m_cache_header.hash();
+    // The entry is only complete once everything behind it has landed. An older entry at the same path may also still
+    // be waiting to be removed. The entry stays open until then, so requests for it keep waiting for it.
+    m_disk_cache.io_queue().when_pending_jobs_have_run(*m_temporary_path, [this, request_headers = move(request_headers), response_headers = move(response_headers), take_body_file, on_complete = move(on_complete)]() mutable {
+        m_disk_cache.io_queue().when_pending_jobs_have_run(*m_path, [this, request_headers = move(request_headers), response_headers = move(response_headers), take_body_file, on_complete = move(on_complete)]() mutable {
+            finish_flush(move(request_headers), move(response_headers), take_body_file, move(on_complete));
+        });
+    });
+}
+
+void CacheEntryWriter::finish_flush(NonnullRefPtr<HeaderList> request_headers, NonnullRefPtr<HeaderList> response_headers, TakeBodyFile take_body_file, FlushCallback on_complete)
+{
+    if (m_marked_for_deletion) {
+        remove_incomplete_temporary_file();
+        fail_flush(Error::from_string_literal("Cache entry has been deleted"), on_complete);
+        return;
+    }
 
-    if (auto result = m_file->write_value(m_cache_footer); result.is_error()) {
-        dbgln_if(HTTP_DISK_CACHE_DEBUG, "\033[36m[disk]\033[0m \033[31;1mUnable to flush cache entry for\033[0m {}: {}", m_url, result.error());
+    if (m_file_state->has_failed) {
+        dbgln_if(HTTP_DISK_CACHE_DEBUG, "\033[36m[disk]\033[0m \033[31;1mUnable to flush cache entry for\033[0m {}", m_url);
 
-        return result.release_error();
+        remove_incomplete_temporary_file();
+        fail_flush(Error::from_string_literal("Unable to write to cache entry file"), on_complete);
+        return;
+    }
+
+    auto entry_size = m_file_state->file->tell();
+    if (entry_size.is_error()) {
+        remove_incomplete_temporary_file();
+        fail_flush(entry_size.release_error(), on_complete);
+        return;
     }
 
-    TRY(m_file->flush_buffer());
-    m_file.clear();
-    TRY(FileSystem::move_file(m_path->string(), m_temporary_path->string()));
-    remove_temporary_file.disarm();
+    m_file_state->file.clear();
+    m_cache_footer.data_size = m_file_state->data_size;
+
+    // A body that is handed off as a file is large enough to be worth a file of its own.
+    if (take_body_file == TakeBodyFile::No && m_cache_footer.data_size <= MAXIMUM_PACKED_ENTRY_DATA_SIZE) {
+        auto segment_location = m_index.allocate_segment_space(entry_size.value());
+
+        // An older entry at the same (cache_key, vary_key) may have been large enough to have a file of its own.
+        m_disk_cache.remove_file(*m_path);
+
+        // The entry is only added to the index once it has landed in the segment, so that no reader can find it before.
+        m_disk_cache.append_to_segment(*m_temporary_path, segment_location, [this, request_headers = move(request_headers), response_headers = move(response_headers), segment_location, on_complete = move(on_complete)]() mutable {
+            create_index_entry(move(request_headers), move(response_headers), segment_location, {}, move(on_complete));
+        });
+        return;
+    }
+
+    if (auto result = FileSystem::move_file(m_path->string(), m_temporary_path->string()); result.is_error()) {
+        remove_incomplete_temporary_file();
+        fail_flush(result.release_error(), on_complete);
+        return;
+    }
+
+    if (take_body_file == TakeBodyFile::No) {
+        create_index_entry(move(request_headers), move(response_headers), {}, {}, move(on_complete));
+        return;
+    }
+
+    auto file = Core::File::open(m_path->string(), Core::File::OpenMode::Read);
+    if (file.is_error()) {
+        m_disk_cache.remove_file(*m_path);
+        fail_flush(file.release_error(), on_complete);
+        return;
+    }
 
-    int body_fd = -1;
+    auto did_take_body_file = [this, request_headers = move(request_headers), response_headers = move(response_headers), on_complete = move(on_complete)](ErrorOr<CacheEntryBodyFile> body_file) mutable {
+        if (body_file.is_error()) {
+            m_disk_cache.remove_file(*m_path);
+            fail_flush(body_file.release_error(), on_complete);
+            return;
+        }
+        create_index_entry(move(request_headers), move(response_headers), {}, body_file.release_value(), move(on_complete));
+    };
+
+    if (!body_file_needs_decoding(m_cache_header.body_codec, m_cache_footer)) {
+        did_take_body_file(create_body_file(file.value()->fd(), m_file_state->data_offset, m_cache_footer));
+        return;
+    }
+
+    // The entry stays open until its body has been decoded, so requests for it keep waiting for it.
+    decode_body_file(m_disk_cache.io_queue(), *m_path, file.release_value(), m_cache_header.body_codec, m_file_state->data_offset, m_cache_footer, move(did_take_body_file));
+}
+
+void CacheEntryWriter::create_index_entry(NonnullRefPtr<HeaderList> request_headers, NonnullRefPtr<HeaderList> response_headers, Optional<CacheSegmentLocation> segment_location, Optional<CacheEntryBodyFile> body_file, FlushCallback on_complete)
+{
     ArmedScopeGuard close_body_fd = [&] {
-        if (body_fd != -1)
-            (void)Core::System::close(body_fd);
+        if (body_file.has_value())
+            (void)Core::System::close(body_file->fd);
     };
-    if (body_file) {
-        auto opened_body_file = TRY(Core::File::open(m_path->string(), Core::File::OpenMode::Read));
-        body_fd = TRY(Core::System::dup(opened_body_file->fd()));
-        body_file->fd = body_fd;
-        body_file->offset = m_data_offset;
-        body_file->size = m_cache_footer.data_size;
+
+    if (segment_location.has_value())
+        m_index.finish_segment_append(*segment_location);
+
+    // The entry may have been deleted while its data was still on its way to the segment.
+    if (m_marked_for_deletion) {
+        fail_flush(Error::from_string_literal("Cache entry has been deleted"), on_complete);
+        return;
     }
 
     // Drop any sidecars left over from an older entry at the same (cache_key, vary_key). They are tied to the previous
     // response body, so reusing them with the freshly written one would mismatch the source they were generated for.
-    for (auto associated_data : CACHE_ENTRY_ASSOCIATED_DATA_TYPES)
-        (void)FileSystem::remove(path_for_cache_entry_associated_data(m_disk_cache.cache_directory(), m_cache_key, m_vary_key, associated_data).string(), FileSystem::RecursionMode::Disallowed);
+    m_disk_cache.remove_associated_data(m_cache_key, m_vary_key);
 
-    if (auto result = m_index.create_entry(m_cache_key, m_vary_key, m_url, move(request_headers), move(response_headers), m_cache_footer.data_size, m_request_time, m_response_time); result.is_error()) {
+    if (auto result = m_index.create_entry(m_cache_key, m_vary_key, m_url, move(request_headers), move(response_headers), m_cache_footer.data_size, m_request_time, m_response_time, segment_location); result.is_error()) {
         dbgln_if(HTTP_DISK_CACHE_DEBUG, "\033[36m[disk]\033[0m \033[31;1mUnable to flush cache entry for\033[0m {} ({} bytes): {}", m_url, m_cache_footer.data_size, result.error());
         remove();
 
-        return result.release_error();
+        fail_flush(result.release_error(), on_complete);
+        return;
     }
 
     m_disk_cache.remove_entries_exceeding_cache_limit();
 
     dbgln_if(HTTP_DISK_CACHE_DEBUG, "\033[36m[disk]\033[0m \033[34;1mFinished caching\033[0m {} ({} bytes)", m_url, m_cache_footer.data_size);
     close_body_fd.disarm();
-    return {};
+
+    auto callback = move(on_complete);
+    close_and_destroy_cache_entry();
+    callback(move(body_file));
 }
 
 void CacheEntryWriter::remove_incomplete_entry()
@@ -276,23 +576,34 @@ void CacheEntryWriter::remove_incomplete_temporary_file()
 {
     if (!m_temporary_path.has_value())
         return;
-    (void)FileSystem::remove(m_temporary_path->string(), FileSystem::RecursionMode::Disallowed);
+
+    // The file has to be closed before it can be removed on some platforms, and only the IO thread may touch it.
+    m_disk_cache.io_queue().submit(*m_temporary_path, [state = m_file_state, temporary_path = m_temporary_path->string()]() {
+        state->compressor.clear();
+        state->file.clear();
+        (void)FileSystem::remove(temporary_path, FileSystem::RecursionMode::Disallowed);
+    });
 }
 
-ErrorOr<NonnullOwnPtr<CacheEntryReader>> CacheEntryReader::create(DiskCache& disk_cache, CacheIndex& index, u64 cache_key, u64 vary_key, NonnullRefPtr<HeaderList> response_headers, u64 data_size)
+ErrorOr<NonnullOwnPtr<CacheEntryReader>> CacheEntryReader::create(DiskCache& disk_cache, CacheIndex& index, u64 cache_key, u64 vary_key, NonnullRefPtr<HeaderList> response_headers, u64 data_size, Optional<CacheSegmentLocation> segment_location)
 {
     auto path = path_for_cache_entry(disk_cache.cache_directory(), cache_key, vary_key);
+    auto file_path = segment_location.has_value() ? path_for_cache_segment(disk_cache.cache_directory(), segment_location->segment_id) : path;
 
-    auto file = TRY(Core::File::open(path.string(), Core::File::OpenMode::Read));
+    auto file = TRY(Core::File::open(file_path.string(), Core::File::OpenMode::Read));
     auto fd = file->fd();
 
     CacheHeader cache_header;
     size_t cache_header_size { 0 };
+    u64 decoded_data_size = data_size;
 
     String url;
     Optional<String> reason_phrase;
 
     auto result = [&]() -> ErrorOr<void> {
+        if (segment_location.has_value())
+            TRY(file->seek(segment_location->offset, SeekMode::SetPosition));
+
         cache_header = TRY(file->read_value<CacheHeader>());
         cache_header_size = TRY(file->tell());
 
@@ -300,6 +611,8 @@ ErrorOr<NonnullOwnPtr<CacheEntryReader>> CacheEntryReader::create(DiskCache& dis
             return Error::from_string_literal("Magic value mismatch");
         if (cache_header.version != CACHE_VERSION)
             return Error::from_string_literal("Version mismatch");
+        if (cache_header.body_codec != CacheBodyCodec::None && cache_header.body_codec != CacheBodyCodec::Brotli)
+            return Error::from_string_literal("Unknown body codec");
 
         if (cache_header.key_hash != u64_hash(cache_key))
             return Error::from_string_literal("Key hash mismatch");
@@ -314,20 +627,34 @@ ErrorOr<NonnullOwnPtr<CacheEntryReader>> CacheEntryReader::create(DiskCache& dis
                 return Error::from_string_literal("Reason phrase hash mismatch");
         }
 
+        // The size of a compressed body is only recorded in the footer, and is needed before the body is sent.
+        if (cache_header.body_codec != CacheBodyCodec::None) {
+            TRY(file->seek(data_size, SeekMode::FromCurrentPosition));
+            auto cache_footer = TRY(file->read_value<CacheFooter>());
+
+            if (cache_footer.data_size != data_size)
+                return Error::from_string_literal("Invalid data size in footer");
+            if (cache_footer.decoded_data_size > MAXIMUM_COMPRESSED_BODY_DECODED_SIZE)
+                return Error::from_string_literal("Invalid decoded data size in footer");
+            decoded_data_size = cache_footer.decoded_data_size;
+        }
+
         return {};
     }();
 
     if (result.is_error()) {
-        (void)FileSystem::remove(path.string(), FileSystem::RecursionMode::Disallowed);
+        // A segment holds other entries, so only the index entry is removed (by our caller) in that case.
+        if (!segment_location.has_value())
+            (void)FileSystem::remove(path.string(), FileSystem::RecursionMode::Disallowed);
         return result.release_error();
     }
 
     auto data_offset = cache_header_size + cache_header.url_size + cache_header.reason_phrase_size;
 
-    return adopt_own(*new CacheEntryReader { disk_cache, index, cache_key, vary_key, move(url), move(path), move(file), fd, cache_header, move(reason_phrase), move(response_headers), data_offset, data_size });
+    return adopt_own(*new CacheEntryReader { disk_cache, index, cache_key, vary_key, move(url), move(path), move(file), fd, cache_header, move(reason_phrase), move(response_headers), data_offset, data_size, decoded_data_size });
 }
 
-CacheEntryReader::CacheEntryReader(DiskCache& disk_cache, CacheIndex& index, u64 cache_key, u64 vary_key, String url, LexicalPath path, NonnullOwnPtr<Core::File> file, int fd, CacheHeader cache_header, Optional<String> reason_phrase, NonnullRefPtr<HeaderList> response_headers, u64 data_offset, u64 data_size)
+CacheEntryReader::CacheEntryReader(DiskCache& disk_cache, CacheIndex& index, u64 cache_key, u64 vary_key, String url, LexicalPath path, NonnullOwnPtr<Core::File> file, int fd, CacheHeader cache_header, Optional<String> reason_phrase, NonnullRefPtr<HeaderList> response_headers, u64 data_offset, u64 data_size, u64 decoded_data_size)
     : CacheEntry(disk_cache, index, cache_key, vary_key, move(url), move(path), cache_header)
     , m_file(move(file))
     , m_fd(fd)
@@ -335,6 +662,7 @@ CacheEntryReader::CacheEntryReader(DiskCache& disk_cache, CacheIndex& index, u64
     , m_response_headers(move(response_headers))
     , m_data_offset(data_offset)
     , m_data_size(data_size)
+    , m_decoded_data_size(decoded_data_size)
 {
 }
 
@@ -370,6 +698,19 @@ void CacheEntryReader::send_to(int socket_fd, Function<void(u64)> on_complete, F
         return;
     }
 
+    if (m_cache_header.body_codec != CacheBodyCodec::None) {
+        auto result = [&]() -> ErrorOr<void> {
+            m_body_decoder = TRY(create_body_decoder(*m_file, m_cache_header.body_codec, m_data_offset, m_data_size));
+            m_decoded_body_buffer = TRY(ByteBuffer::create_uninitialized(DECODED_BODY_BUFFER_SIZE));
+            return {};
+        }();
+
+        if (result.is_error()) {
+            send_error(result.release_error());
+            return;
+        }
+    }
+
     m_socket_write_notifier = Core::Notifier::construct(m_socket_fd, Core::NotificationType::Write);
     m_socket_write_notifier->set_enabled(false);
 
@@ -381,27 +722,50 @@ void CacheEntryReader::send_to(int socket_fd, Function<void(u64)> on_complete, F
     send_without_blocking();
 }
 
-ErrorOr<CacheEntryBodyFile> CacheEntryReader::take_body_file()
+void CacheEntryReader::take_body_file(Function<void(ErrorOr<CacheEntryBodyFile>)> on_complete)
 {
-    ScopeGuard guard { [&]() { close_and_destroy_cache_entry(); } };
+    auto finish = [this](ErrorOr<CacheEntryBodyFile> body_file, Function<void(ErrorOr<CacheEntryBodyFile>)> on_complete) {
+        if (!body_file.is_error())
+            m_index.update_last_access_time(m_cache_key, m_vary_key);
 
-    if (m_marked_for_deletion)
-        return Error::from_string_literal("Cache entry has been deleted");
+        close_and_destroy_cache_entry();
+        on_complete(move(body_file));
+    };
+
+    if (m_marked_for_deletion) {
+        finish(Error::from_string_literal("Cache entry has been deleted"), move(on_complete));
+        return;
+    }
 
     if (auto result = read_and_validate_footer(); result.is_error()) {
         dbgln_if(HTTP_DISK_CACHE_DEBUG, "\033[36m[disk]\033[0m \033[31;1mError validating cache entry for\033[0m {}: {}", m_url, result.error());
         remove();
-        return result.release_error();
+        finish(result.release_error(), move(on_complete));
+        return;
     }
 
-    auto fd = TRY(Core::System::dup(m_fd));
-    m_index.update_last_access_time(m_cache_key, m_vary_key);
+    if (!body_file_needs_decoding(m_cache_header.body_codec, m_cache_footer)) {
+        finish(create_body_file(m_fd, m_data_offset, m_cache_footer), move(on_complete));
+        return;
+    }
 
-    return CacheEntryBodyFile {
-        .fd = fd,
-        .offset = m_data_offset,
-        .size = m_data_size,
-    };
+    auto file = [&]() -> ErrorOr<NonnullOwnPtr<Core::File>> {
+        auto fd = TRY(Core::System::dup(m_fd));
+        return Core::File::adopt_fd(fd, Core::File::OpenMode::Read);
+    }();
+    if (file.is_error()) {
+        finish(file.release_error(), move(on_complete));
+        return;
+    }
+
+    // The entry stays open until its body has been decoded, so it is not removed from under the IO thread.
+    decode_body_file(m_disk_cache.io_queue(), *m_path, file.release_value(), m_cache_header.body_codec, m_data_offset, m_cache_footer, [this, finish = move(finish), on_complete = move(on_complete)](ErrorOr<CacheEntryBodyFile> body_file) mutable {
+        if (body_file.is_error()) {
+            dbgln_if(HTTP_DISK_CACHE_DEBUG, "\033[36m[disk]\033[0m \033[31;1mError decoding cache entry for\033[0m {}: {}", m_url, body_file.error());
+            remove();
+        }
+        finish(move(body_file), move(on_complete));
+    });
 }
 
 void CacheEntryReader::send_without_blocking()
@@ -411,6 +775,11 @@ void CacheEntryReader::send_without_blocking()
         return;
     }
 
+    if (m_body_decoder) {
+        send_decoded_body_without_blocking();
+        return;
+    }
+
     auto result = Core::System::transfer_file_through_socket(m_fd, m_socket_fd, m_data_offset + m_bytes_sent, m_data_size - m_bytes_sent);
 
     if (result.is_error()) {
@@ -432,6 +801,41 @@ void CacheEntryReader::send_without_blocking()
     send_without_blocking();
 }
 
+void CacheEntryReader::send_decoded_body_without_blocking()
+{
+    while (m_bytes_sent < m_decoded_data_size) {
+        if (m_pending_decoded_body.is_empty()) {
+            auto decoded_body = m_body_decoder->read_some(m_decoded_body_buffer);
+            if (decoded_body.is_error()) {
+                send_error(decoded_body.release_error());
+                return;
+            }
+            if (decoded_body.value().is_empty()) {
+                send_error(Error::from_string_literal("Compressed body ended early"));
+                return;
+            }
+
+            m_pending_decoded_body = decoded_body.value().trim(m_decoded_data_size - m_bytes_sent);
+        }
+
+        auto result = Core::System::write(m_socket_fd, m_pending_decoded_body);
+
+        if (result.is_error()) {
+            if (result.error().code() != EAGAIN && result.error().code() != EWOULDBLOCK)
+                send_error(result.release_error());
+            else
+                m_socket_write_notifier->set_enabled(true);
+
+            return;
+        }
+
+        m_pending_decoded_body = m_pending_decoded_body.slice(result.value());
+        m_bytes_sent += result.value();
+    }
+
+    send_complete();
+}
+
 void CacheEntryReader::send_complete()
 {
     if (auto result = read_and_validate_footer(); result.is_error()) {
@@ -471,6 +875,8 @@ ErrorOr<void> CacheEntryReader::read_and_validate_footer()
 
     if (m_cache_footer.data_size != m_data_size)
         return Error::from_string_literal("Invalid data size in footer");
+    if (m_cache_footer.decoded_data_size != m_decoded_data_size)
+        return Error::from_string_literal("Invalid decoded data size in footer");
     if (m_cache_footer.header_hash != m_cache_header.hash())
         return Error::from_string_literal("Invalid header hash in footer");
 
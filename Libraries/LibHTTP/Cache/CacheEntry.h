@@ -6,20 +6,33 @@
 
 #pragma once
 
+#include <AK/Atomic.h>
+#include <AK/AtomicRefCounted.h>
+#include <AK/ByteBuffer.h>
+#include <AK/ByteString.h>
 #include <AK/Error.h>
+#include <AK/Function.h>
 #include <AK/LexicalPath.h>
 #include <AK/Optional.h>
 #include <AK/String.h>
 #include <AK/Time.h>
 #include <AK/Types.h>
+#include <LibCompress/Brotli.h>
 #include <LibCore/File.h>
 #include <LibCore/Notifier.h>
+#include <LibHTTP/Cache/Utilities.h>
 #include <LibHTTP/Cache/Version.h>
 #include <LibHTTP/Forward.h>
 #include <LibHTTP/HeaderList.h>
 
 namespace HTTP {
 
+// Bodies of compressible resources are stored compressed, and are decompressed again as they are read.
+enum class CacheBodyCodec : u32 {
+    None,
+    Brotli,
+};
+
 struct CacheHeader {
     static ErrorOr<CacheHeader> read_from_stream(Stream&);
     ErrorOr<void> write_to_stream(Stream&) const;
@@ -39,6 +52,8 @@ struct CacheHeader {
     u32 status_code { 0 };
     u32 reason_phrase_size { 0 };
     u32 reason_phrase_hash { 0 };
+
+    CacheBodyCodec body_codec { CacheBodyCodec::None };
 };
 
 struct CacheFooter {
@@ -46,6 +61,7 @@ struct CacheFooter {
     ErrorOr<void> write_to_stream(Stream&) const;
 
     u64 data_size { 0 };
+    u64 decoded_data_size { 0 };
     u32 header_hash { 0 };
 };
 
@@ -60,13 +76,18 @@ struct CacheEntryBodyFile {
 // on disk is:
 //
 //     [CacheHeader][URL][ReasonPhrase][Data][CacheFooter]
+//
+// The data is compressed with the codec recorded in the CacheHeader. The CacheFooter records both its stored size and
+// its decoded size.
+//
+// Entries with small bodies are stored in this same format, packed back to back into a shared segment file.
 class CacheEntry {
 public:
     virtual ~CacheEntry() = default;
 
     u64 cache_key() const { return m_cache_key; }
     u64 vary_key() const { return m_vary_key; }
-    u64 body_size() const { return m_cache_footer.data_size; }
+    u64 body_size() const { return m_cache_footer.decoded_data_size; }
 
     void remove();
 
@@ -99,19 +120,50 @@ public:
 
     ErrorOr<void> write_status_and_reason(u32 status_code, Optional<String> reason_phrase, HeaderList const& request_headers, HeaderList const& response_headers);
     ErrorOr<void> write_data(ReadonlyBytes);
-    ErrorOr<void> flush(NonnullRefPtr<HeaderList> request_headers, NonnullRefPtr<HeaderList> response_headers);
-    ErrorOr<CacheEntryBodyFile> flush_and_take_body_file(NonnullRefPtr<HeaderList> request_headers, NonnullRefPtr<HeaderList> response_headers);
+
+    // The entry is complete once everything written behind it has landed on the disk, which `on_complete` is told about
+    // on the event loop. The entry stays open until then, and must not be used again by the caller.
+    void flush(NonnullRefPtr<HeaderList> request_headers, NonnullRefPtr<HeaderList> response_headers, Function<void(ErrorOr<void>)> on_complete = {});
+    void flush_and_take_body_file(NonnullRefPtr<HeaderList> request_headers, NonnullRefPtr<HeaderList> response_headers, Function<void(ErrorOr<CacheEntryBodyFile>)> on_complete);
     void remove_incomplete_entry();
 
 private:
     CacheEntryWriter(DiskCache&, CacheIndex&, u64 cache_key, String url, CacheHeader, UnixDateTime request_time, AK::Duration current_time_offset_for_testing);
 
-    ErrorOr<void> flush_impl(NonnullRefPtr<HeaderList> request_headers, NonnullRefPtr<HeaderList> response_headers, CacheEntryBodyFile*);
+    struct FileState;
+
+    enum class TakeBodyFile {
+        No,
+        Yes,
+    };
+    using FlushCallback = Function<void(ErrorOr<Optional<CacheEntryBodyFile>>)>;
+
+    void flush_impl(NonnullRefPtr<HeaderList> request_headers, NonnullRefPtr<HeaderList> response_headers, TakeBodyFile, FlushCallback);
+    void finish_flush(NonnullRefPtr<HeaderList> request_headers, NonnullRefPtr<HeaderList> response_headers, TakeBodyFile, FlushCallback);
+    void create_index_entry(NonnullRefPtr<HeaderList> request_headers, NonnullRefPtr<HeaderList> response_headers, Optional<CacheSegmentLocation>, Optional<CacheEntryBodyFile>, FlushCallback);
+    void fail_flush(Error, FlushCallback&);
+    ErrorOr<void> submit_write(size_t buffered_size, Function<ErrorOr<void>(FileState&)>);
     void remove_incomplete_temporary_file();
 
-    OwnPtr<Core::OutputBufferedFile> m_file;
+    // The entry is written behind on the disk cache's IO thread. Everything in here belongs to that thread, until every
+    // write queued for the temporary file has run.
+    struct FileState : public AtomicRefCounted<FileState> {
+        explicit FileState(ByteString url)
+            : url(move(url))
+        {
+        }
+
+        ByteString url;
+        OwnPtr<Core::OutputBufferedFile> file;
+        OwnPtr<Compress::BrotliCompressor> compressor;
+        u64 data_offset { 0 };
+        u64 data_size { 0 };
+
+        // NB: Also read on the event loop, to stop streaming into an entry that can no longer be completed.
+        Atomic<bool> has_failed { false };
+    };
+    NonnullRefPtr<FileState> m_file_state;
     Optional<LexicalPath> m_temporary_path;
-    u64 m_data_offset { 0 };
 
     UnixDateTime m_request_time;
     UnixDateTime m_response_time;
@@ -121,7 +173,7 @@ private:
 
 class CacheEntryReader final : public CacheEntry {
 public:
-    static ErrorOr<NonnullOwnPtr<CacheEntryReader>> create(DiskCache&, CacheIndex&, u64 cache_key, u64 vary_key, NonnullRefPtr<HeaderList>, u64 data_size);
+    static ErrorOr<NonnullOwnPtr<CacheEntryReader>> create(DiskCache&, CacheIndex&, u64 cache_key, u64 vary_key, NonnullRefPtr<HeaderList>, u64 data_size, Optional<CacheSegmentLocation>);
     virtual ~CacheEntryReader() override = default;
 
     enum class RevalidationType {
@@ -137,9 +189,11 @@ public:
 
     void send_to(int socket_fd, Function<void(u64 bytes_sent)> on_complete, Function<void(u64 bytes_sent)> on_error);
 
-    ErrorOr<CacheEntryBodyFile> take_body_file();
+    // A compressed body is decoded on the disk cache's IO thread, in which case `on_complete` is invoked later on the
+    // event loop. The entry is closed once it has been invoked, and must not be used again by the caller.
+    void take_body_file(Function<void(ErrorOr<CacheEntryBodyFile>)> on_complete);
 
-    u64 body_size() const { return m_data_size; }
+    u64 body_size() const { return m_decoded_data_size; }
 
     u32 status_code() const { return m_cache_header.status_code; }
     Optional<String> const& reason_phrase() const { return m_reason_phrase; }
@@ -147,9 +201,10 @@ public:
     HeaderList const& response_headers() const { return m_response_headers; }
 
 private:
-    CacheEntryReader(DiskCache&, CacheIndex&, u64 cache_key, u64 vary_key, String url, LexicalPath, NonnullOwnPtr<Core::File>, int fd, CacheHeader, Optional<String> reason_phrase, NonnullRefPtr<HeaderList>, u64 data_offset, u64 data_size);
+    CacheEntryReader(DiskCache&, CacheIndex&, u64 cache_key, u64 vary_key, String url, LexicalPath, NonnullOwnPtr<Core::File>, int fd, CacheHeader, Optional<String> reason_phrase, NonnullRefPtr<HeaderList>, u64 data_offset, u64 data_size, u64 decoded_data_size);
 
     void send_without_blocking();
+    void send_decoded_body_without_blocking();
     void send_complete();
     void send_error(Error);
 
@@ -165,6 +220,10 @@ private:
     Function<void(u64)> m_on_send_error;
     u64 m_bytes_sent { 0 };
 
+    OwnPtr<Stream> m_body_decoder;
+    ByteBuffer m_decoded_body_buffer;
+    ReadonlyBytes m_pending_decoded_body;
+
     Optional<String> m_reason_phrase;
     NonnullRefPtr<HeaderList> m_response_headers;
 
@@ -172,6 +231,7 @@ private:
 
     u64 const m_data_offset { 0 };
     u64 const m_data_size { 0 };
+    u64 const m_decoded_data_size { 0 };
 };
 
 }
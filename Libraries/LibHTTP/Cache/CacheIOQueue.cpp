@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibHTTP/Cache/CacheIOQueue.h>
+
+namespace HTTP {
+
+static constexpr size_t MAXIMUM_BUFFERED_SIZE = 64 * MiB;
+
+NonnullOwnPtr<CacheIOQueue> CacheIOQueue::create()
+{
+    auto queue = adopt_own(*new CacheIOQueue);
+    queue->m_thread->start();
+    return queue;
+}
+
+CacheIOQueue::CacheIOQueue()
+    : m_event_loop(Core::EventLoop::current_weak())
+    , m_completions(adopt_ref(*new Completions))
+    , m_thread(Threading::Thread::construct("DiskCache IO"sv, [this] { return run(); }))
+{
+}
+
+CacheIOQueue::~CacheIOQueue()
+{
+    {
+        Sync::MutexLocker locker(m_mutex);
+        m_is_exiting = true;
+        m_job_submitted.signal();
+    }
+
+    // Everything that was queued is still written out, so the cache is left in the state the caller asked for.
+    (void)m_thread->join();
+
+    // Whoever was waiting on the queue is going away with it.
+    m_completions->callbacks.clear();
+}
+
+bool CacheIOQueue::try_submit(LexicalPath const& path, size_t buffered_size, Function<void()> job)
+{
+    Sync::MutexLocker locker(m_mutex);
+    VERIFY(!m_is_exiting);
+
+    if (buffered_size > MAXIMUM_BUFFERED_SIZE - m_buffered_size)
+        return false;
+    m_buffered_size += buffered_size;
+
+    ++m_pending_job_counts.ensure(path.string());
+    m_jobs.enqueue({ path.string(), buffered_size, move(job) });
+    m_job_submitted.signal();
+    return true;
+}
+
+void CacheIOQueue::submit(LexicalPath const& path, Function<void()> job)
+{
+    auto submitted = try_submit(path, 0, move(job));
+    VERIFY(submitted);
+}
+
+bool CacheIOQueue::has_pending_jobs(LexicalPath const& path)
+{
+    Sync::MutexLocker locker(m_mutex);
+    return m_pending_job_counts.contains(path.string());
+}
+
+void CacheIOQueue::when_pending_jobs_have_run(LexicalPath const& path, Function<void()> on_complete)
+{
+    auto completion_id = m_completions->next_id++;
+    m_completions->callbacks.set(completion_id, move(on_complete));
+
+    {
+        Sync::MutexLocker locker(m_mutex);
+
+        // Jobs run in order, so a marker queued behind the pending jobs only runs once they all have. Jobs submitted
+        // after it do not hold it up.
+        if (m_pending_job_counts.contains(path.string())) {
+            m_jobs.enqueue({ .path = path.string(), .completion_id = completion_id });
+            m_job_submitted.signal();
+            return;
+        }
+    }
+
+    complete(completion_id);
+}
+
+void CacheIOQueue::complete(u64 completion_id)
+{
+    auto event_loop = m_event_loop->take();
+    if (!event_loop)
+        return;
+
+    event_loop->deferred_invoke([completions = m_completions, completion_id]() {
+        if (auto callback = completions->callbacks.take(completion_id); callback.has_value())
+            (*callback)();
+    });
+}
+
+intptr_t CacheIOQueue::run()
+{
+    while (true) {
+        Job job;
+        {
+            Sync::MutexLocker locker(m_mutex);
+            m_job_submitted.wait_while([&] { return m_jobs.is_empty() && !m_is_exiting; });
+            if (m_jobs.is_empty())
+                return 0;
+            job = m_jobs.dequeue();
+        }
+
+        if (job.completion_id.has_value()) {
+            complete(*job.completion_id);
+            continue;
+        }
+
+        job.function();
+        job.function = nullptr;
+
+        Sync::MutexLocker locker(m_mutex);
+        m_buffered_size -= job.buffered_size;
+
+        auto pending_job_count = m_pending_job_counts.find(job.path);
+        VERIFY(pending_job_count != m_pending_job_counts.end());
+        if (--pending_job_count->value == 0)
+            m_pending_job_counts.remove(pending_job_count);
+    }
+}
+
+}
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/AtomicRefCounted.h>
+#include <AK/ByteString.h>
+#include <AK/Function.h>
+#include <AK/HashMap.h>
+#include <AK/LexicalPath.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Optional.h>
+#include <AK/Queue.h>
+#include <LibCore/EventLoop.h>
+#include <LibSync/ConditionVariable.h>
+#include <LibSync/Mutex.h>
+#include <LibThreading/Thread.h>
+
+namespace HTTP {
+
+// Runs disk cache file IO on a dedicated thread, so that a slow disk does not stall the event loop that also drives
+// the network. Jobs run one at a time in the order they were submitted, so jobs for the same file never race.
+//
+// Data handed to the queue stays buffered in memory until it has been written. That is bounded: once too much is
+// waiting for the disk, further writes are refused and callers are expected to give up on caching that response,
+// rather than wait for the disk to catch up.
+//
+// The queue belongs to the event loop it was created on. Nothing on that event loop ever waits for the IO thread;
+// instead, it is told once the jobs touching a file have run.
+class CacheIOQueue {
+    AK_MAKE_NONCOPYABLE(CacheIOQueue);
+    AK_MAKE_NONMOVABLE(CacheIOQueue);
+
+public:
+    static NonnullOwnPtr<CacheIOQueue> create();
+    ~CacheIOQueue();
+
+    // Queues a job touching the file at `path`, with `buffered_size` bytes held in memory until it has run.
+    [[nodiscard]] bool try_submit(LexicalPath const& path, size_t buffered_size, Function<void()> job);
+
+    // Queues a job that holds no buffered data, such as removing a file. These are never refused.
+    void submit(LexicalPath const& path, Function<void()> job);
+
+    // Whether any job touching the file at `path` has yet to run.
+    [[nodiscard]] bool has_pending_jobs(LexicalPath const& path);
+
+    // Invokes `on_complete` on the owning event loop once every job touching the file at `path` that has been submitted
+    // so far has run, so the file may then be used from there. It is never invoked synchronously, even if there is
+    // nothing to wait for.
+    void when_pending_jobs_have_run(LexicalPath const& path, Function<void()> on_complete);
+
+private:
+    CacheIOQueue();
+
+    intptr_t run();
+    void complete(u64 completion_id);
+
+    struct Job {
+        ByteString path;
+        size_t buffered_size { 0 };
+        Function<void()> function;
+
+        // Set for the marker jobs that only report back once everything queued before them has run.
+        Optional<u64> completion_id;
+    };
+
+    // Completion callbacks never leave the owning event loop, as they are free to capture state that is not thread-safe.
+    // The IO thread only ever hands their IDs back.
+    struct Completions : public AtomicRefCounted<Completions> {
+        HashMap<u64, Function<void()>> callbacks;
+        u64 next_id { 0 };
+    };
+
+    Sync::Mutex m_mutex;
+    Sync::ConditionVariable m_job_submitted { m_mutex };
+    Queue<Job> m_jobs;
+    HashMap<ByteString, size_t> m_pending_job_counts;
+    size_t m_buffered_size { 0 };
+    bool m_is_exiting { false };
+
+    NonnullRefPtr<Core::WeakEventLoopReference> m_event_loop;
+    NonnullRefPtr<Completions> m_completions;
+
+    NonnullRefPtr<Threading::Thread> m_thread;
+};
+
+}
@@ -17,6 +17,10 @@
 namespace HTTP {
 
 static constexpr u32 INDEX_SCHEMA_BASELINE_VERSION = 1u;
+static constexpr u32 INDEX_SCHEMA_SEGMENTS_VERSION = 2u;
+static constexpr u32 INDEX_SCHEMA_BODY_CODEC_VERSION = 3u;
+
+static constexpr u64 MAXIMUM_SEGMENT_SIZE = 8 * MiB;
 
 static ByteString serialize_headers(HeaderList const& headers)
 {
@@ -84,6 +88,9 @@ static void log_orphaned_disk_cache_entries(Database::Database& database)
     )#"sv));
 
     for_each_cache_entry_file(database, [&](LexicalPath const& cache_entry) {
+        if (cache_segment_id_for_file(cache_entry).has_value())
+            return;
+
         auto cache_entry_data = cache_entry_data_for_file(cache_entry);
         if (!cache_entry_data.has_value()) {
             dbgln("Unrecognized cache file: {}", cache_entry);
@@ -104,11 +111,11 @@ static void log_orphaned_disk_cache_entries(Database::Database& database)
 // a migration here without invalidating the cache entries on disk. Entry files embed
 // CACHE_VERSION in their headers and are validated when read, so an entry format break must
 // append a migration that deletes the index rows referencing the now-unreadable entries.
-static_assert(CACHE_VERSION == 7, "Bumping CACHE_VERSION requires appending a CacheIndex migration that deletes the index rows referencing the old entry format");
+static_assert(CACHE_VERSION == 8, "Bumping CACHE_VERSION requires appending a CacheIndex migration that deletes the index rows referencing the old entry format");
 
 ErrorOr<Database::MigrationOutcome> CacheIndex::migrate_schema(Database::Database& database, Database::MigrationMode mode)
 {
-    Array<Database::Migration, 1> migrations { {
+    Array<Database::Migration, 3> migrations { {
         { .version = INDEX_SCHEMA_BASELINE_VERSION, .sql = R"#(
             CREATE TABLE IF NOT EXISTS CacheIndex (
                 cache_key INTEGER,
@@ -124,6 +131,15 @@ ErrorOr<Database::MigrationOutcome> CacheIndex::migrate_schema(Database::Databas
                 PRIMARY KEY(cache_key, vary_key)
             );
         )#"sv },
+        { .version = INDEX_SCHEMA_SEGMENTS_VERSION, .sql = R"#(
+            ALTER TABLE CacheIndex ADD COLUMN segment_id INTEGER NOT NULL DEFAULT 0;
+            ALTER TABLE CacheIndex ADD COLUMN segment_offset INTEGER NOT NULL DEFAULT 0;
+            ALTER TABLE CacheIndex ADD COLUMN segment_size INTEGER NOT NULL DEFAULT 0;
+        )#"sv },
+        // CACHE_VERSION 8 records the body codec in the entry header.
+        { .version = INDEX_SCHEMA_BODY_CODEC_VERSION, .sql = R"#(
+            DELETE FROM CacheIndex;
+        )#"sv },
     } };
 
     return database.migrate("CacheIndex"sv, migrations, mode);
@@ -136,18 +152,18 @@ ErrorOr<CacheIndex> CacheIndex::create(Database::Database& database, LexicalPath
 #endif
 
     Statements statements {};
-    statements.insert_entry = TRY(database.prepare_statement("INSERT OR REPLACE INTO CacheIndex (cache_key, vary_key, url, request_headers, response_headers, data_size, associated_data_size, request_time, response_time, last_access_time) VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?);"sv));
+    statements.insert_entry = TRY(database.prepare_statement("INSERT OR REPLACE INTO CacheIndex (cache_key, vary_key, url, request_headers, response_headers, data_size, associated_data_size, request_time, response_time, last_access_time, segment_id, segment_offset, segment_size) VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?);"sv));
     statements.remove_entry = TRY(database.prepare_statement(R"#(
         DELETE FROM CacheIndex
         WHERE cache_key = ? AND vary_key = ?
-        RETURNING data_size + associated_data_size + OCTET_LENGTH(request_headers) + OCTET_LENGTH(response_headers);
+        RETURNING data_size + associated_data_size + OCTET_LENGTH(request_headers) + OCTET_LENGTH(response_headers), segment_id, segment_size;
     )#"sv));
     statements.remove_entries_accessed_since = TRY(database.prepare_statement(R"#(
         DELETE FROM CacheIndex
         WHERE last_access_time >= ?
-        RETURNING cache_key, vary_key, data_size + associated_data_size + OCTET_LENGTH(request_headers) + OCTET_LENGTH(response_headers);
+        RETURNING cache_key, vary_key, data_size + associated_data_size + OCTET_LENGTH(request_headers) + OCTET_LENGTH(response_headers), segment_id, segment_size;
     )#"sv));
-    statements.select_entries = TRY(database.prepare_statement("SELECT vary_key, url, request_headers, response_headers, data_size, associated_data_size, request_time, response_time, last_access_time FROM CacheIndex WHERE cache_key = ?;"sv));
+    statements.select_entries = TRY(database.prepare_statement("SELECT vary_key, url, request_headers, response_headers, data_size, associated_data_size, request_time, response_time, last_access_time, segment_id, segment_offset, segment_size FROM CacheIndex WHERE cache_key = ?;"sv));
     statements.update_response_headers = TRY(database.prepare_statement("UPDATE CacheIndex SET response_headers = ? WHERE cache_key = ? AND vary_key = ?;"sv));
     statements.update_associated_data_size = TRY(database.prepare_statement("UPDATE CacheIndex SET associated_data_size = ? WHERE cache_key = ? AND vary_key = ?;"sv));
     statements.update_last_access_time = TRY(database.prepare_statement("UPDATE CacheIndex SET last_access_time = ? WHERE cache_key = ? AND vary_key = ?;"sv));
@@ -168,7 +184,7 @@ ErrorOr<CacheIndex> CacheIndex::create(Database::Database& database, LexicalPath
             FROM RankedCacheIndex
             WHERE cumulative_estimated_size > ?
         )
-        RETURNING cache_key, vary_key, data_size + associated_data_size + OCTET_LENGTH(request_headers) + OCTET_LENGTH(response_headers);
+        RETURNING cache_key, vary_key, data_size + associated_data_size + OCTET_LENGTH(request_headers) + OCTET_LENGTH(response_headers), segment_id, segment_size;
     )#"sv));
 
     statements.estimate_cache_size_accessed_since = TRY(database.prepare_statement(R"#(
@@ -182,6 +198,21 @@ ErrorOr<CacheIndex> CacheIndex::create(Database::Database& database, LexicalPath
         FROM CacheIndex;
     )#"sv));
 
+    statements.select_segment_entries = TRY(database.prepare_statement("SELECT cache_key, vary_key, segment_offset, segment_size FROM CacheIndex WHERE segment_id = ? ORDER BY segment_offset;"sv));
+    statements.update_segment_location = TRY(database.prepare_statement(R"#(
+        UPDATE CacheIndex
+        SET segment_id = ?, segment_offset = ?
+        WHERE cache_key = ? AND vary_key = ? AND segment_id = ? AND segment_offset = ?
+        RETURNING segment_size;
+    )#"sv));
+
+    auto select_segment_live_sizes = TRY(database.prepare_statement(R"#(
+        SELECT segment_id, SUM(segment_size)
+        FROM CacheIndex
+        WHERE segment_id != 0
+        GROUP BY segment_id;
+    )#"sv));
+
     auto disk_space = TRY(FileSystem::compute_disk_space(cache_directory));
     auto maximum_disk_cache_size = compute_maximum_disk_cache_size(disk_space.free_bytes);
 
@@ -196,18 +227,49 @@ ErrorOr<CacheIndex> CacheIndex::create(Database::Database& database, LexicalPath
         statements.select_total_estimated_size,
         [&](auto statement_id) { total_estimated_size = database.result_column<u64>(statement_id, 0); });
 
-    return CacheIndex { database, statements, limits, total_estimated_size };
+    // Segments are only ever appended to by the session which created them. Entries removed from the end of a segment
+    // may still be mapped by a previous session's clients, so we always start appending to a fresh segment.
+    SegmentUsages segment_usages;
+    u32 last_segment_id = 0;
+
+    for_each_cache_entry_file(database, [&](LexicalPath const& cache_file) {
+        auto segment_id = cache_segment_id_for_file(cache_file);
+        if (!segment_id.has_value())
+            return;
+
+        auto size = FileSystem::size_from_stat(cache_file.string());
+        if (size.is_error() || size.value() < 0)
+            return;
+
+        segment_usages.set(*segment_id, { .size = static_cast<u64>(size.value()), .live_size = 0 });
+        last_segment_id = max(last_segment_id, *segment_id);
+    });
+
+    database.execute_statement(
+        select_segment_live_sizes,
+        [&](auto statement_id) {
+            auto segment_id = database.result_column<u32>(statement_id, 0);
+            auto live_size = database.result_column<u64>(statement_id, 1);
+
+            segment_usages.ensure(segment_id).live_size = live_size;
+            last_segment_id = max(last_segment_id, segment_id);
+        });
+
+    return CacheIndex { database, statements, limits, total_estimated_size, move(segment_usages), last_segment_id + 1 };
 }
 
-CacheIndex::CacheIndex(Database::Database& database, Statements statements, Limits limits, u64 total_estimated_size)
+CacheIndex::CacheIndex(Database::Database& database, Statements statements, Limits limits, u64 total_estimated_size, SegmentUsages segment_usages, u32 active_segment_id)
     : m_database(database)
     , m_statements(statements)
     , m_limits(limits)
     , m_total_estimated_size(total_estimated_size)
+    , m_segment_usages(move(segment_usages))
+    , m_active_segment_id(active_segment_id)
+    , m_next_segment_id(active_segment_id + 1)
 {
 }
 
-ErrorOr<void> CacheIndex::create_entry(u64 cache_key, u64 vary_key, String url, NonnullRefPtr<HeaderList> request_headers, NonnullRefPtr<HeaderList> response_headers, u64 data_size, UnixDateTime request_time, UnixDateTime response_time)
+ErrorOr<void> CacheIndex::create_entry(u64 cache_key, u64 vary_key, String url, NonnullRefPtr<HeaderList> request_headers, NonnullRefPtr<HeaderList> response_headers, u64 data_size, UnixDateTime request_time, UnixDateTime response_time, Optional<CacheSegmentLocation> segment_location)
 {
     auto now = UnixDateTime::now();
 
@@ -235,6 +297,7 @@ ErrorOr<void> CacheIndex::create_entry(u64 cache_key, u64 vary_key, String url,
         .request_time = request_time,
         .response_time = response_time,
         .last_access_time = now,
+        .segment_location = segment_location,
     };
     auto entry_size = entry.estimated_size();
 
@@ -246,6 +309,7 @@ ErrorOr<void> CacheIndex::create_entry(u64 cache_key, u64 vary_key, String url,
         [&](auto statement_id) {
             auto removed_size = m_database->result_column<u64>(statement_id, 0);
             m_total_estimated_size -= removed_size;
+            release_segment_space(m_database->result_column<u32>(statement_id, 1), m_database->result_column<u64>(statement_id, 2));
         },
         cache_key,
         vary_key);
@@ -255,7 +319,11 @@ ErrorOr<void> CacheIndex::create_entry(u64 cache_key, u64 vary_key, String url,
         return existing_entry.vary_key == vary_key;
     });
 
-    m_database->execute_statement(m_statements.insert_entry, {}, cache_key, vary_key, entry.url, serialized_request_headers, serialized_response_headers, entry.data_size, entry.associated_data_size, entry.request_time, entry.response_time, entry.last_access_time);
+    auto segment = segment_location.value_or(CacheSegmentLocation {});
+    m_database->execute_statement(m_statements.insert_entry, {}, cache_key, vary_key, entry.url, serialized_request_headers, serialized_response_headers, entry.data_size, entry.associated_data_size, entry.request_time, entry.response_time, entry.last_access_time, segment.segment_id, segment.offset, segment.size);
+
+    if (segment_location.has_value())
+        m_segment_usages.ensure(segment_location->segment_id).live_size += segment_location->size;
 
     if (existing_entry_index.has_value())
         entries[*existing_entry_index] = move(entry);
@@ -274,6 +342,7 @@ void CacheIndex::remove_entry(u64 cache_key, u64 vary_key)
         [&](auto statement_id) {
             auto removed_size = m_database->result_column<u64>(statement_id, 0);
             m_total_estimated_size -= removed_size;
+            release_segment_space(m_database->result_column<u32>(statement_id, 1), m_database->result_column<u64>(statement_id, 2));
         },
         cache_key,
         vary_key);
@@ -293,6 +362,7 @@ void CacheIndex::remove_entries_exceeding_cache_limit(Function<void(u64 cache_ke
             auto vary_key = m_database->result_column<u64>(statement_id, 1);
             auto removed_size = m_database->result_column<u64>(statement_id, 2);
             m_total_estimated_size -= removed_size;
+            release_segment_space(m_database->result_column<u32>(statement_id, 3), m_database->result_column<u64>(statement_id, 4));
             delete_entry(cache_key, vary_key);
 
             if (on_entry_removed)
@@ -310,6 +380,7 @@ void CacheIndex::remove_entries_accessed_since(UnixDateTime since, Function<void
             auto vary_key = m_database->result_column<u64>(statement_id, 1);
             auto removed_size = m_database->result_column<u64>(statement_id, 2);
             m_total_estimated_size -= removed_size;
+            release_segment_space(m_database->result_column<u32>(statement_id, 3), m_database->result_column<u64>(statement_id, 4));
             delete_entry(cache_key, vary_key);
 
             if (on_entry_removed)
@@ -380,7 +451,14 @@ Optional<CacheIndex::Entry const&> CacheIndex::find_entry(u64 cache_key, HeaderL
                 auto response_time = m_database->result_column<UnixDateTime>(statement_id, column++);
                 auto last_access_time = m_database->result_column<UnixDateTime>(statement_id, column++);
 
-                entries.empend(vary_key, move(url), deserialize_headers(request_headers), deserialize_headers(response_headers), data_size, associated_data_size, request_headers.length(), response_headers.length(), request_time, response_time, last_access_time);
+                Optional<CacheSegmentLocation> segment_location;
+                if (auto segment_id = m_database->result_column<u32>(statement_id, column++); segment_id != 0) {
+                    auto segment_offset = m_database->result_column<u64>(statement_id, column++);
+                    auto segment_size = m_database->result_column<u64>(statement_id, column++);
+                    segment_location = CacheSegmentLocation { segment_id, segment_offset, segment_size };
+                }
+
+                entries.empend(vary_key, move(url), deserialize_headers(request_headers), deserialize_headers(response_headers), data_size, associated_data_size, request_headers.length(), response_headers.length(), request_time, response_time, last_access_time, segment_location);
             },
             cache_key);
 
@@ -435,6 +513,132 @@ Requests::CacheSizes CacheIndex::estimate_cache_size_accessed_since(UnixDateTime
     return sizes;
 }
 
+CacheSegmentLocation CacheIndex::allocate_segment_space(u64 size)
+{
+    if (auto active_segment_size = m_segment_usages.ensure(m_active_segment_id).size; active_segment_size != 0 && active_segment_size + size > MAXIMUM_SEGMENT_SIZE)
+        m_active_segment_id = m_next_segment_id++;
+
+    auto& usage = m_segment_usages.ensure(m_active_segment_id);
+
+    CacheSegmentLocation location { m_active_segment_id, usage.size, size };
+    usage.size += size;
+    ++usage.pending_append_count;
+    return location;
+}
+
+void CacheIndex::finish_segment_append(CacheSegmentLocation const& location)
+{
+    auto usage = m_segment_usages.get(location.segment_id);
+    VERIFY(usage.has_value());
+    VERIFY(usage->pending_append_count > 0);
+
+    --usage->pending_append_count;
+}
+
+void CacheIndex::release_segment_space(u32 segment_id, u64 size)
+{
+    if (segment_id == 0)
+        return;
+
+    auto usage = m_segment_usages.get(segment_id);
+    if (!usage.has_value())
+        return;
+
+    usage->live_size -= min(usage->live_size, size);
+}
+
+void CacheIndex::compact_segments(Function<void(u32 segment_id, u32 compacted_segment_id, Vector<SegmentRelocation>)> on_segment_compacted)
+{
+    Vector<u32> segments_to_compact;
+
+    for (auto const& [segment_id, usage] : m_segment_usages) {
+        // The active segment is still being appended to, so its removed entries will be reclaimed once it fills up.
+        if (segment_id == m_active_segment_id)
+            continue;
+        // An entry may be on its way into a segment which is no longer active, and is not in the index until it lands.
+        if (usage.pending_append_count != 0)
+            continue;
+        if (m_segments_being_compacted.contains(segment_id))
+            continue;
+        if (usage.live_size * 2 > usage.size)
+            continue;
+
+        segments_to_compact.append(segment_id);
+    }
+
+    for (auto segment_id : segments_to_compact) {
+        Vector<SegmentRelocation> relocations;
+
+        m_database->execute_statement(
+            m_statements.select_segment_entries,
+            [&](auto statement_id) {
+                auto cache_key = m_database->result_column<u64>(statement_id, 0);
+                auto vary_key = m_database->result_column<u64>(statement_id, 1);
+                auto segment_offset = m_database->result_column<u64>(statement_id, 2);
+                auto segment_size = m_database->result_column<u64>(statement_id, 3);
+
+                relocations.append({ .cache_key = cache_key, .vary_key = vary_key, .from = { segment_id, segment_offset, segment_size }, .to = {} });
+            },
+            segment_id);
+
+        // Nothing is ever appended to the new segment, so it may be written out in full before it is used.
+        auto compacted_segment_id = m_next_segment_id++;
+        auto& compacted_usage = m_segment_usages.ensure(compacted_segment_id);
+
+        for (auto& relocation : relocations) {
+            relocation.to = { compacted_segment_id, compacted_usage.size, relocation.from.size };
+            compacted_usage.size += relocation.to.size;
+        }
+
+        m_segments_being_compacted.set(segment_id);
+        m_segments_being_compacted.set(compacted_segment_id);
+
+        on_segment_compacted(segment_id, compacted_segment_id, move(relocations));
+    }
+}
+
+void CacheIndex::commit_segment_compaction(u32 segment_id, u32 compacted_segment_id, ReadonlySpan<SegmentRelocation> relocations)
+{
+    auto& compacted_usage = m_segment_usages.ensure(compacted_segment_id);
+
+    for (auto const& relocation : relocations) {
+        // Entries which were removed or replaced while they were being copied are left where they are.
+        bool was_relocated = false;
+
+        m_database->execute_statement(
+            m_statements.update_segment_location,
+            [&](auto) { was_relocated = true; },
+            relocation.to.segment_id,
+            relocation.to.offset,
+            relocation.cache_key,
+            relocation.vary_key,
+            relocation.from.segment_id,
+            relocation.from.offset);
+
+        if (!was_relocated)
+            continue;
+
+        compacted_usage.live_size += relocation.to.size;
+        if (auto entry = get_entry(relocation.cache_key, relocation.vary_key); entry.has_value())
+            entry->segment_location = relocation.to;
+    }
+
+    if (compacted_usage.size == 0)
+        m_segment_usages.remove(compacted_segment_id);
+    m_segment_usages.remove(segment_id);
+
+    m_segments_being_compacted.remove(segment_id);
+    m_segments_being_compacted.remove(compacted_segment_id);
+}
+
+void CacheIndex::abandon_segment_compaction(u32 segment_id, u32 compacted_segment_id)
+{
+    m_segment_usages.remove(compacted_segment_id);
+
+    m_segments_being_compacted.remove(segment_id);
+    m_segments_being_compacted.remove(compacted_segment_id);
+}
+
 void CacheIndex::set_maximum_disk_cache_size(u64 maximum_disk_cache_size)
 {
     if (maximum_disk_cache_size == m_limits.maximum_disk_cache_size)
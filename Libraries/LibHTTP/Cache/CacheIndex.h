@@ -8,10 +8,12 @@
 
 #include <AK/Error.h>
 #include <AK/HashMap.h>
+#include <AK/HashTable.h>
 #include <AK/NonnullRawPtr.h>
 #include <AK/Time.h>
 #include <AK/Types.h>
 #include <LibDatabase/Database.h>
+#include <LibHTTP/Cache/Utilities.h>
 #include <LibHTTP/HeaderList.h>
 #include <LibRequests/CacheSizes.h>
 
@@ -35,6 +37,8 @@ class CacheIndex {
         UnixDateTime response_time;
         UnixDateTime last_access_time;
 
+        Optional<CacheSegmentLocation> segment_location;
+
         u64 estimated_size() const
         {
             return data_size + associated_data_size + serialized_request_headers_size + serialized_response_headers_size;
@@ -46,7 +50,7 @@ public:
 
     static ErrorOr<CacheIndex> create(Database::Database&, LexicalPath const& cache_directory);
 
-    ErrorOr<void> create_entry(u64 cache_key, u64 vary_key, String url, NonnullRefPtr<HeaderList> request_headers, NonnullRefPtr<HeaderList> response_headers, u64 data_size, UnixDateTime request_time, UnixDateTime response_time);
+    ErrorOr<void> create_entry(u64 cache_key, u64 vary_key, String url, NonnullRefPtr<HeaderList> request_headers, NonnullRefPtr<HeaderList> response_headers, u64 data_size, UnixDateTime request_time, UnixDateTime response_time, Optional<CacheSegmentLocation> = {});
     void remove_entry(u64 cache_key, u64 vary_key);
     void remove_entries_exceeding_cache_limit(Function<void(u64 cache_key, u64 vary_key)> on_entry_removed);
     void remove_entries_accessed_since(UnixDateTime, Function<void(u64 cache_key, u64 vary_key)> on_entry_removed);
@@ -60,6 +64,24 @@ public:
 
     Requests::CacheSizes estimate_cache_size_accessed_since(UnixDateTime since);
 
+    // Reserves space for an entry at the end of the segment currently being appended to. The segment is not compacted
+    // until the append has been finished, whether or not an entry was created at that location.
+    CacheSegmentLocation allocate_segment_space(u64 size);
+    void finish_segment_append(CacheSegmentLocation const&);
+
+    // Moves the entries out of segments which are mostly made up of removed entries, so those segments may be deleted.
+    // The live entries of each such segment are to be copied into a new segment of their own. The index keeps pointing
+    // at the old segment until the compaction is committed, which must only happen once that copy is complete.
+    struct SegmentRelocation {
+        u64 cache_key { 0 };
+        u64 vary_key { 0 };
+        CacheSegmentLocation from;
+        CacheSegmentLocation to;
+    };
+    void compact_segments(Function<void(u32 segment_id, u32 compacted_segment_id, Vector<SegmentRelocation>)> on_segment_compacted);
+    void commit_segment_compaction(u32 segment_id, u32 compacted_segment_id, ReadonlySpan<SegmentRelocation>);
+    void abandon_segment_compaction(u32 segment_id, u32 compacted_segment_id);
+
     void set_maximum_disk_cache_size(u64 maximum_disk_cache_size);
 
 private:
@@ -74,6 +96,8 @@ private:
         Database::StatementID update_last_access_time { 0 };
         Database::StatementID estimate_cache_size_accessed_since { 0 };
         Database::StatementID select_total_estimated_size { 0 };
+        Database::StatementID select_segment_entries { 0 };
+        Database::StatementID update_segment_location { 0 };
     };
 
     struct Limits {
@@ -82,10 +106,18 @@ private:
         u64 maximum_disk_cache_entry_size { 0 };
     };
 
-    CacheIndex(Database::Database&, Statements, Limits, u64 total_estimated_size);
+    struct SegmentUsage {
+        u64 size { 0 };
+        u64 live_size { 0 };
+        size_t pending_append_count { 0 };
+    };
+    using SegmentUsages = HashMap<u32, SegmentUsage>;
+
+    CacheIndex(Database::Database&, Statements, Limits, u64 total_estimated_size, SegmentUsages, u32 active_segment_id);
 
     Optional<Entry&> get_entry(u64 cache_key, u64 vary_key);
     void delete_entry(u64 cache_key, u64 vary_key);
+    void release_segment_space(u32 segment_id, u64 size);
 
     NonnullRawPtr<Database::Database> m_database;
     Statements m_statements;
@@ -94,6 +126,13 @@ private:
 
     Limits m_limits;
     u64 m_total_estimated_size { 0 };
+
+    SegmentUsages m_segment_usages;
+    u32 m_active_segment_id { 0 };
+    u32 m_next_segment_id { 0 };
+
+    // Segments which are being compacted, and the segments they are being compacted into.
+    HashTable<u32> m_segments_being_compacted;
 };
 
 }
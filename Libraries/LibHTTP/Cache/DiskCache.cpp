@@ -5,12 +5,13 @@
  */
 
 #include <AK/Debug.h>
-#include <AK/ScopeGuard.h>
+#include <LibCore/AnonymousBuffer.h>
 #include <LibCore/Directory.h>
 #include <LibCore/EventLoop.h>
 #include <LibCore/File.h>
 #include <LibCore/System.h>
 #include <LibFileSystem/FileSystem.h>
+#include <LibHTTP/Cache/CacheIOQueue.h>
 #include <LibHTTP/Cache/CacheRequest.h>
 #include <LibHTTP/Cache/DiskCache.h>
 #include <LibHTTP/Cache/Utilities.h>
@@ -20,25 +21,6 @@ namespace HTTP {
 
 static constexpr auto INDEX_DATABASE = "INDEX"sv;
 
-static ErrorOr<u64> compute_associated_data_size(LexicalPath const& cache_directory, u64 cache_key, u64 vary_key)
-{
-    u64 associated_data_size = 0;
-    for (auto associated_data : CACHE_ENTRY_ASSOCIATED_DATA_TYPES) {
-        auto path = path_for_cache_entry_associated_data(cache_directory, cache_key, vary_key, associated_data);
-        auto size = FileSystem::size_from_stat(path.string());
-        if (size.is_error()) {
-            if (size.error().is_errno() && size.error().code() == ENOENT)
-                continue;
-            return size.release_error();
-        }
-
-        if (size.value() < 0)
-            return Error::from_errno(EINVAL);
-        associated_data_size += static_cast<u64>(size.value());
-    }
-    return associated_data_size;
-}
-
 static constexpr StringView cache_directory_for_mode(DiskCache::Mode mode)
 {
     switch (mode) {
@@ -73,14 +55,15 @@ ErrorOr<Optional<DiskCache>> DiskCache::create(Mode mode, LexicalPath const& cac
     }
 
     auto index = TRY(CacheIndex::create(database, cache_directory));
-    return DiskCache { mode, move(database), move(cache_directory), move(index) };
+    return DiskCache { mode, move(database), move(cache_directory), move(index), CacheIOQueue::create() };
 }
 
-DiskCache::DiskCache(Mode mode, NonnullRefPtr<Database::Database> database, LexicalPath cache_directory, CacheIndex index)
+DiskCache::DiskCache(Mode mode, NonnullRefPtr<Database::Database> database, LexicalPath cache_directory, CacheIndex index, NonnullOwnPtr<CacheIOQueue> io_queue)
     : m_mode(mode)
     , m_database(move(database))
     , m_cache_directory(move(cache_directory))
     , m_index(move(index))
+    , m_io_queue(move(io_queue))
 {
 }
 
@@ -102,8 +85,8 @@ Variant<Optional<CacheEntryWriter&>, DiskCache::CacheHasOpenEntry> DiskCache::cr
     auto serialized_url = serialize_url_for_cache_storage(url);
     auto cache_key = create_cache_key(serialized_url, method);
 
-    if (check_if_cache_has_open_entry(request, cache_key, url, CheckReaderEntries::Yes))
-        return CacheHasOpenEntry {};
+    if (auto open_entry = check_if_cache_has_open_entry(request, cache_key, url, CheckReaderEntries::Yes); open_entry.has_value())
+        return open_entry.release_value();
 
     auto current_time_offset_for_testing = compute_current_time_offset_for_testing(*this, request_headers);
     request_start_time += current_time_offset_for_testing;
@@ -132,8 +115,8 @@ Variant<Optional<CacheEntryReader&>, DiskCache::CacheHasOpenEntry> DiskCache::op
     auto serialized_url = serialize_url_for_cache_storage(url);
     auto cache_key = create_cache_key(serialized_url, method);
 
-    if (check_if_cache_has_open_entry(request, cache_key, url, open_mode == OpenMode::Read ? CheckReaderEntries::No : CheckReaderEntries::Yes))
-        return CacheHasOpenEntry {};
+    if (auto open_entry = check_if_cache_has_open_entry(request, cache_key, url, open_mode == OpenMode::Read ? CheckReaderEntries::No : CheckReaderEntries::Yes); open_entry.has_value())
+        return open_entry.release_value();
 
     auto index_entry = m_index.find_entry(cache_key, request_headers);
     if (!index_entry.has_value()) {
@@ -141,7 +124,22 @@ Variant<Optional<CacheEntryReader&>, DiskCache::CacheHasOpenEntry> DiskCache::op
         return Optional<CacheEntryReader&> {};
     }
 
-    auto cache_entry = CacheEntryReader::create(*this, m_index, cache_key, index_entry->vary_key, index_entry->response_headers, index_entry->data_size);
+    // Rather than wait for writes to the entry's file to land, we resume the request once they have.
+    auto file_path = index_entry->segment_location.has_value()
+        ? path_for_cache_segment(m_cache_directory, index_entry->segment_location->segment_id)
+        : path_for_cache_entry(m_cache_directory, cache_key, index_entry->vary_key);
+
+    if (m_io_queue->has_pending_jobs(file_path)) {
+        dbgln_if(HTTP_DISK_CACHE_DEBUG, "\033[36m[disk]\033[0m \033[36;1mDeferring cache entry for\033[0m {} (waiting for pending writes)", url);
+
+        m_io_queue->when_pending_jobs_have_run(file_path, [request = request.make_weak_ptr<CacheRequest>()]() {
+            if (request)
+                request->notify_request_unblocked({});
+        });
+        return CacheHasOpenEntry {};
+    }
+
+    auto cache_entry = CacheEntryReader::create(*this, m_index, cache_key, index_entry->vary_key, index_entry->response_headers, index_entry->data_size, index_entry->segment_location);
     if (cache_entry.is_error()) {
         dbgln_if(HTTP_DISK_CACHE_DEBUG, "\033[36m[disk]\033[0m \033[31;1mUnable to open cache entry for\033[0m {}: {}", url, cache_entry.error());
         m_index.remove_entry(cache_key, index_entry->vary_key);
@@ -157,8 +155,8 @@ Variant<Optional<CacheEntryReader&>, DiskCache::CacheHasOpenEntry> DiskCache::op
 
     auto revalidate_cache_entry = [&]() -> ErrorOr<void, CacheHasOpenEntry> {
         // We will hold an exclusive lock on the cache entry for revalidation requests.
-        if (check_if_cache_has_open_entry(request, cache_key, url, CheckReaderEntries::Yes))
-            return CacheHasOpenEntry {};
+        if (auto open_entry = check_if_cache_has_open_entry(request, cache_key, url, CheckReaderEntries::Yes); open_entry.has_value())
+            return open_entry.release_value();
 
         dbgln_if(HTTP_DISK_CACHE_DEBUG, "\033[36m[disk]\033[0m \033[36;1mMust revalidate cache entry for\033[0m {} (lifetime={}s age={}s)", url, freshness_lifetime.to_seconds(), current_age.to_seconds());
         cache_entry.value()->set_revalidation_type(CacheEntryReader::RevalidationType::MustRevalidate);
@@ -260,18 +258,31 @@ ErrorOr<bool> DiskCache::store_associated_data(URL::URL const& url, StringView m
 
     auto path = path_for_cache_entry_associated_data(m_cache_directory, cache_key, *vary_key, associated_data);
     auto temporary_path = LexicalPath::join(m_cache_directory.string(), ByteString::formatted("{}.tmp", path.basename()));
-    ArmedScopeGuard remove_temporary_file = [&]() {
-        (void)FileSystem::remove(temporary_path.string(), FileSystem::RecursionMode::Disallowed);
-    };
+    auto buffer = adopt_ref(*new AssociatedDataBuffer(TRY(ByteBuffer::copy(data))));
+
+    // NB: If the write fails on the IO thread, the entry will simply appear to have no associated data, but still be
+    //     accounted for with this size until it is stored again or evicted.
+    auto submitted = m_io_queue->try_submit(path, data.size(), [path = path.string(), temporary_path = temporary_path.string(), buffer]() {
+        auto result = [&]() -> ErrorOr<void> {
+            auto file = TRY(Core::File::open(temporary_path, Core::File::OpenMode::Write));
+            TRY(file->write_until_depleted(buffer->bytes));
+            file->close();
+
+            TRY(FileSystem::move_file(path, temporary_path));
+            return {};
+        }();
+
+        if (result.is_error()) {
+            dbgln_if(HTTP_DISK_CACHE_DEBUG, "\033[36m[disk]\033[0m \033[31;1mUnable to store associated data\033[0m {}: {}", path, result.error());
+            (void)FileSystem::remove(temporary_path, FileSystem::RecursionMode::Disallowed);
+        }
+    });
+    if (!submitted)
+        return false;
 
-    {
-        auto file = TRY(Core::File::open(temporary_path.string(), Core::File::OpenMode::Write));
-        TRY(file->write_until_depleted(data));
-    }
+    track_pending_associated_data(path, move(buffer));
 
-    TRY(FileSystem::move_file(path.string(), temporary_path.string()));
-    remove_temporary_file.disarm();
-    m_index.update_associated_data_size(cache_key, *vary_key, TRY(compute_associated_data_size(m_cache_directory, cache_key, *vary_key)));
+    m_index.update_associated_data_size(cache_key, *vary_key, TRY(compute_associated_data_size(cache_key, *vary_key)));
     remove_entries_exceeding_cache_limit();
     return m_index.has_entry(cache_key, *vary_key);
 }
@@ -294,6 +305,13 @@ ErrorOr<Optional<ByteBuffer>> DiskCache::retrieve_associated_data(URL::URL const
         return Optional<ByteBuffer> {};
 
     auto path = path_for_cache_entry_associated_data(m_cache_directory, cache_key, *vary_key, associated_data);
+
+    if (auto pending = m_pending_associated_data.get(path.string()); pending.has_value()) {
+        if (!pending->data)
+            return Optional<ByteBuffer> {};
+        return TRY(ByteBuffer::copy(pending->data->bytes.bytes()));
+    }
+
     auto file = Core::File::open(path.string(), Core::File::OpenMode::Read);
     if (file.is_error()) {
         if (file.error().is_errno() && file.error().code() == ENOENT)
@@ -322,6 +340,22 @@ ErrorOr<Optional<CacheEntryBodyFile>> DiskCache::retrieve_associated_data_file(U
         return Optional<CacheEntryBodyFile> {};
 
     auto path = path_for_cache_entry_associated_data(m_cache_directory, cache_key, *vary_key, associated_data);
+
+    // Clients map the file directly, so data that has yet to land on the disk is handed out in memory they can map.
+    if (auto pending = m_pending_associated_data.get(path.string()); pending.has_value()) {
+        if (!pending->data || pending->data->bytes.is_empty())
+            return Optional<CacheEntryBodyFile> {};
+
+        auto buffer = TRY(Core::AnonymousBuffer::create_with_size(pending->data->bytes.size()));
+        pending->data->bytes.span().copy_to({ buffer.data<u8>(), buffer.size() });
+
+        return CacheEntryBodyFile {
+            .fd = TRY(Core::System::dup(buffer.fd())),
+            .offset = 0,
+            .size = buffer.size(),
+        };
+    }
+
     auto file = Core::File::open(path.string(), Core::File::OpenMode::Read);
     if (file.is_error()) {
         if (file.error().is_errno() && file.error().code() == ENOENT)
@@ -340,7 +374,7 @@ ErrorOr<Optional<CacheEntryBodyFile>> DiskCache::retrieve_associated_data_file(U
     };
 }
 
-bool DiskCache::check_if_cache_has_open_entry(CacheRequest& request, u64 cache_key, URL::URL const& url, CheckReaderEntries check_reader_entries)
+Optional<DiskCache::CacheHasOpenEntry> DiskCache::check_if_cache_has_open_entry(CacheRequest& request, u64 cache_key, URL::URL const& url, CheckReaderEntries check_reader_entries)
 {
     // FIXME: We purposefully do not use the vary key here, as we do not yet have it when creating a CacheEntryWriter
     //        (we can only compute it once we receive the response headers). We could come up with a more sophisticated
@@ -348,13 +382,13 @@ bool DiskCache::check_if_cache_has_open_entry(CacheRequest& request, u64 cache_k
     //        lock based on the cache key alone (i.e. URL and method).
     auto open_entries = m_open_cache_entries.get(cache_key);
     if (!open_entries.has_value())
-        return false;
+        return {};
 
     for (auto const& [open_entry, open_request] : *open_entries) {
         if (is<CacheEntryWriter>(*open_entry)) {
             dbgln_if(HTTP_DISK_CACHE_DEBUG, "\033[36m[disk]\033[0m \033[36;1mDeferring cache entry for\033[0m {} (waiting for existing writer)", url);
             m_requests_waiting_completion.ensure(cache_key).append(request);
-            return true;
+            return CacheHasOpenEntry { .writer_request = open_request };
         }
 
         // We allow concurrent readers unless another reader is open for revalidation. That reader will issue the network
@@ -362,11 +396,11 @@ bool DiskCache::check_if_cache_has_open_entry(CacheRequest& request, u64 cache_k
         if (check_reader_entries == CheckReaderEntries::Yes || (open_request && open_request->is_revalidation_request())) {
             dbgln_if(HTTP_DISK_CACHE_DEBUG, "\033[36m[disk]\033[0m \033[36;1mDeferring cache entry for\033[0m {} (waiting for existing reader)", url);
             m_requests_waiting_completion.ensure(cache_key).append(request);
-            return true;
+            return CacheHasOpenEntry {};
         }
     }
 
-    return false;
+    return {};
 }
 
 void DiskCache::remove_entries_exceeding_cache_limit()
@@ -374,6 +408,8 @@ void DiskCache::remove_entries_exceeding_cache_limit()
     m_index.remove_entries_exceeding_cache_limit([&](auto cache_key, auto vary_key) {
         delete_entry(cache_key, vary_key);
     });
+
+    compact_segments();
 }
 
 void DiskCache::set_maximum_disk_cache_size(u64 maximum_disk_cache_size)
@@ -391,6 +427,8 @@ void DiskCache::remove_entries_accessed_since(UnixDateTime since)
     m_index.remove_entries_accessed_since(since, [&](auto cache_key, auto vary_key) {
         delete_entry(cache_key, vary_key);
     });
+
+    compact_segments();
 }
 
 void DiskCache::cache_entry_closed(Badge<CacheEntry>, CacheEntry const& cache_entry)
@@ -430,10 +468,160 @@ void DiskCache::delete_entry(u64 cache_key, u64 vary_key)
             open_entry->mark_for_deletion({});
     }
 
-    auto cache_path = path_for_cache_entry(m_cache_directory, cache_key, vary_key);
-    (void)FileSystem::remove(cache_path.string(), FileSystem::RecursionMode::Disallowed);
-    for (auto associated_data : CACHE_ENTRY_ASSOCIATED_DATA_TYPES)
-        (void)FileSystem::remove(path_for_cache_entry_associated_data(m_cache_directory, cache_key, vary_key, associated_data).string(), FileSystem::RecursionMode::Disallowed);
+    remove_file(path_for_cache_entry(m_cache_directory, cache_key, vary_key));
+    remove_associated_data(cache_key, vary_key);
+}
+
+void DiskCache::remove_associated_data(u64 cache_key, u64 vary_key)
+{
+    for (auto associated_data : CACHE_ENTRY_ASSOCIATED_DATA_TYPES) {
+        auto path = path_for_cache_entry_associated_data(m_cache_directory, cache_key, vary_key, associated_data);
+        remove_file(path);
+        track_pending_associated_data(path, nullptr);
+    }
+}
+
+void DiskCache::track_pending_associated_data(LexicalPath const& path, RefPtr<AssociatedDataBuffer const> data)
+{
+    auto& pending = m_pending_associated_data.ensure(path.string());
+    pending.data = move(data);
+    ++pending.job_count;
+
+    m_io_queue->when_pending_jobs_have_run(path, [this, path = path.string()]() {
+        auto pending = m_pending_associated_data.find(path);
+        VERIFY(pending != m_pending_associated_data.end());
+
+        // Only the most recent job decides what ends up on the disk.
+        if (--pending->value.job_count == 0)
+            m_pending_associated_data.remove(pending);
+    });
+}
+
+ErrorOr<u64> DiskCache::compute_associated_data_size(u64 cache_key, u64 vary_key) const
+{
+    u64 associated_data_size = 0;
+    for (auto associated_data : CACHE_ENTRY_ASSOCIATED_DATA_TYPES) {
+        auto path = path_for_cache_entry_associated_data(m_cache_directory, cache_key, vary_key, associated_data);
+
+        // Data that is still on its way to (or being removed from) the disk is accounted for as it will end up.
+        if (auto pending = m_pending_associated_data.get(path.string()); pending.has_value()) {
+            if (pending->data)
+                associated_data_size += pending->data->bytes.size();
+            continue;
+        }
+
+        auto size = FileSystem::size_from_stat(path.string());
+        if (size.is_error()) {
+            if (size.error().is_errno() && size.error().code() == ENOENT)
+                continue;
+            return size.release_error();
+        }
+
+        if (size.value() < 0)
+            return Error::from_errno(EINVAL);
+        associated_data_size += static_cast<u64>(size.value());
+    }
+    return associated_data_size;
+}
+
+void DiskCache::remove_file(LexicalPath const& path)
+{
+    m_io_queue->submit(path, [path = path.string()]() {
+        (void)FileSystem::remove(path, FileSystem::RecursionMode::Disallowed);
+    });
+}
+
+void DiskCache::append_to_segment(LexicalPath const& cache_entry_path, CacheSegmentLocation const& location, Function<void()> on_complete)
+{
+    auto segment_path = path_for_cache_segment(m_cache_directory, location.segment_id);
+
+    // NB: If the copy fails on the IO thread, the entry will fail validation when it is next read, and be removed then.
+    m_io_queue->submit(segment_path, [segment_path = segment_path.string(), cache_entry_path = cache_entry_path.string(), location]() {
+        auto result = [&]() -> ErrorOr<void> {
+            auto cache_entry_file = TRY(Core::File::open(cache_entry_path, Core::File::OpenMode::Read));
+            auto cache_entry = TRY(cache_entry_file->read_until_eof());
+            if (cache_entry.size() != location.size)
+                return Error::from_string_literal("Cache entry size does not match its reserved segment space");
+
+            // NB: Opening the segment for writing alone would truncate it, losing every entry already packed into it.
+            auto segment_file = TRY(Core::File::open(segment_path, Core::File::OpenMode::ReadWrite));
+            TRY(segment_file->seek(location.offset, SeekMode::SetPosition));
+            TRY(segment_file->write_until_depleted(cache_entry));
+
+            return {};
+        }();
+
+        if (result.is_error())
+            dbgln_if(HTTP_DISK_CACHE_DEBUG, "\033[36m[disk]\033[0m \033[31;1mUnable to append cache entry to segment\033[0m {}: {}", segment_path, result.error());
+
+        (void)FileSystem::remove(cache_entry_path, FileSystem::RecursionMode::Disallowed);
+    });
+
+    m_io_queue->when_pending_jobs_have_run(segment_path, move(on_complete));
+}
+
+void DiskCache::compact_segments()
+{
+    m_index.compact_segments([&](u32 segment_id, u32 compacted_segment_id, Vector<CacheIndex::SegmentRelocation> relocations) {
+        auto segment_path = path_for_cache_segment(m_cache_directory, segment_id);
+
+        if (relocations.is_empty()) {
+            m_index.commit_segment_compaction(segment_id, compacted_segment_id, relocations);
+            remove_file(segment_path);
+
+            dbgln_if(HTTP_DISK_CACHE_DEBUG, "\033[36m[disk]\033[0m \033[34;1mRemoved cache segment\033[0m {}", segment_path);
+            return;
+        }
+
+        auto compacted_segment_path = path_for_cache_segment(m_cache_directory, compacted_segment_id);
+        auto temporary_path = LexicalPath::join(m_cache_directory.string(), ByteString::formatted("{}.tmp", compacted_segment_path.basename()));
+        auto compaction = adopt_ref(*new SegmentCompaction);
+
+        // The live entries are copied into a new segment, which only appears once it is complete. Neither segment is
+        // written to in place, so readers of the old segment (including clients which mapped a body from it) are never
+        // affected by the compaction.
+        m_io_queue->submit(compacted_segment_path, [compaction, segment_path = segment_path.string(), compacted_segment_path = compacted_segment_path.string(), temporary_path = temporary_path.string(), relocations]() {
+            auto result = [&]() -> ErrorOr<void> {
+                auto segment_file = TRY(Core::File::open(segment_path, Core::File::OpenMode::Read));
+                auto compacted_segment_file = TRY(Core::File::open(temporary_path, Core::File::OpenMode::Write));
+
+                for (auto const& relocation : relocations) {
+                    auto cache_entry = TRY(ByteBuffer::create_uninitialized(relocation.from.size));
+
+                    TRY(segment_file->seek(relocation.from.offset, SeekMode::SetPosition));
+                    TRY(segment_file->read_until_filled(cache_entry));
+
+                    TRY(compacted_segment_file->seek(relocation.to.offset, SeekMode::SetPosition));
+                    TRY(compacted_segment_file->write_until_depleted(cache_entry));
+                }
+
+                compacted_segment_file->close();
+                TRY(FileSystem::move_file(compacted_segment_path, temporary_path));
+                return {};
+            }();
+
+            if (result.is_error()) {
+                dbgln_if(HTTP_DISK_CACHE_DEBUG, "\033[36m[disk]\033[0m \033[31;1mUnable to compact cache segment\033[0m {}: {}", segment_path, result.error());
+                (void)FileSystem::remove(temporary_path, FileSystem::RecursionMode::Disallowed);
+                compaction->has_failed = true;
+            }
+        });
+
+        // The index is only pointed at the new segment once it has landed.
+        m_io_queue->when_pending_jobs_have_run(compacted_segment_path, [this, compaction, segment_id, compacted_segment_id, segment_path, relocations = move(relocations)]() {
+            if (compaction->has_failed) {
+                m_index.abandon_segment_compaction(segment_id, compacted_segment_id);
+                return;
+            }
+
+            m_index.commit_segment_compaction(segment_id, compacted_segment_id, relocations);
+
+            // Readers which already have the segment open keep reading from it until they are done.
+            remove_file(segment_path);
+
+            dbgln_if(HTTP_DISK_CACHE_DEBUG, "\033[36m[disk]\033[0m \033[34;1mCompacted cache segment\033[0m {} ({} entries relocated)", segment_path, relocations.size());
+        });
+    });
 }
 
 }
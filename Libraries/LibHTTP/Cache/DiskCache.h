@@ -6,9 +6,14 @@
 
 #pragma once
 
+#include <AK/Atomic.h>
+#include <AK/AtomicRefCounted.h>
 #include <AK/ByteBuffer.h>
 #include <AK/Error.h>
+#include <AK/Function.h>
+#include <AK/HashMap.h>
 #include <AK/LexicalPath.h>
+#include <AK/NonnullOwnPtr.h>
 #include <AK/Optional.h>
 #include <AK/StringView.h>
 #include <AK/Time.h>
@@ -41,7 +46,11 @@ public:
 
     Mode mode() const { return m_mode; }
 
-    struct CacheHasOpenEntry { };
+    struct CacheHasOpenEntry {
+        // The request writing the open entry, if the entry is open for writing. A request waiting on this entry may
+        // receive that request's response instead of waiting for the entry to be written.
+        WeakPtr<CacheRequest> writer_request;
+    };
     Variant<Optional<CacheEntryWriter&>, CacheHasOpenEntry> create_entry(CacheRequest&, URL::URL const&, StringView method, HeaderList const& request_headers, UnixDateTime request_start_time);
 
     enum class OpenMode {
@@ -64,19 +73,47 @@ public:
     void remove_entries_accessed_since(UnixDateTime since);
 
     LexicalPath const& cache_directory() const { return m_cache_directory; }
+    CacheIOQueue& io_queue() { return *m_io_queue; }
+
+    // Removes a cache file once every write queued for it has landed, so it cannot be resurrected by one of them.
+    void remove_file(LexicalPath const&);
+
+    // Copies a fully written cache entry file into its reserved space in a segment, then removes the file. Once that
+    // has happened, `on_complete` is invoked on the event loop.
+    void append_to_segment(LexicalPath const& cache_entry_path, CacheSegmentLocation const&, Function<void()> on_complete);
+
+    // Removes every piece of data associated with a cache entry.
+    void remove_associated_data(u64 cache_key, u64 vary_key);
 
     void cache_entry_closed(Badge<CacheEntry>, CacheEntry const&);
 
 private:
-    DiskCache(Mode, NonnullRefPtr<Database::Database>, LexicalPath cache_directory, CacheIndex);
+    DiskCache(Mode, NonnullRefPtr<Database::Database>, LexicalPath cache_directory, CacheIndex, NonnullOwnPtr<CacheIOQueue>);
 
     enum class CheckReaderEntries {
         No,
         Yes,
     };
-    bool check_if_cache_has_open_entry(CacheRequest&, u64 cache_key, URL::URL const&, CheckReaderEntries);
+    Optional<CacheHasOpenEntry> check_if_cache_has_open_entry(CacheRequest&, u64 cache_key, URL::URL const&, CheckReaderEntries);
 
     void delete_entry(u64 cache_key, u64 vary_key);
+    void compact_segments();
+
+    struct SegmentCompaction : public AtomicRefCounted<SegmentCompaction> {
+        Atomic<bool> has_failed { false };
+    };
+
+    struct AssociatedDataBuffer : public AtomicRefCounted<AssociatedDataBuffer> {
+        explicit AssociatedDataBuffer(ByteBuffer bytes)
+            : bytes(move(bytes))
+        {
+        }
+
+        ByteBuffer const bytes;
+    };
+
+    void track_pending_associated_data(LexicalPath const&, RefPtr<AssociatedDataBuffer const>);
+    ErrorOr<u64> compute_associated_data_size(u64 cache_key, u64 vary_key) const;
 
     Mode m_mode;
     NonnullRefPtr<Database::Database> m_database;
@@ -88,8 +125,18 @@ private:
     HashMap<u64, Vector<OpenCacheEntry, 1>, IdentityHashTraits<u64>> m_open_cache_entries;
     HashMap<u64, Vector<WeakPtr<CacheRequest>, 1>, IdentityHashTraits<u64>> m_requests_waiting_completion;
 
+    // Associated data is written and removed behind on the IO thread. Until that has happened, it is served from here,
+    // so that retrieving it never has to wait for the disk. Data that is being removed has no buffer.
+    struct PendingAssociatedData {
+        RefPtr<AssociatedDataBuffer const> data;
+        size_t job_count { 0 };
+    };
+    HashMap<ByteString, PendingAssociatedData> m_pending_associated_data;
+
     LexicalPath m_cache_directory;
     CacheIndex m_index;
+
+    NonnullOwnPtr<CacheIOQueue> m_io_queue;
 };
 
 }
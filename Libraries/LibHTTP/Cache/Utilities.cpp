@@ -136,6 +136,25 @@ LexicalPath path_for_cache_entry_associated_data(LexicalPath const& cache_direct
     return cache_directory.append(file);
 }
 
+static constexpr auto CACHE_SEGMENT_PREFIX = "segment_"sv;
+
+LexicalPath path_for_cache_segment(LexicalPath const& cache_directory, u32 segment_id)
+{
+    return cache_directory.append(ByteString::formatted("{}{:08x}", CACHE_SEGMENT_PREFIX, segment_id));
+}
+
+Optional<u32> cache_segment_id_for_file(LexicalPath const& cache_file)
+{
+    auto file_name = cache_file.basename();
+    if (!file_name.starts_with(CACHE_SEGMENT_PREFIX))
+        return {};
+
+    auto segment_id = AK::parse_number<u32>(file_name.substring_view(CACHE_SEGMENT_PREFIX.length()), TrimWhitespace::No, 16);
+    if (!segment_id.has_value() || *segment_id == 0)
+        return {};
+    return segment_id;
+}
+
 Optional<CacheEntryData> cache_entry_data_for_file(LexicalPath const& cache_file)
 {
     CacheEntryData result;
@@ -42,6 +42,15 @@ u64 create_vary_key(HeaderList const& request_headers, HeaderList const& respons
 LexicalPath path_for_cache_entry(LexicalPath const& cache_directory, u64 cache_key, u64 vary_key);
 LexicalPath path_for_cache_entry_associated_data(LexicalPath const& cache_directory, u64 cache_key, u64 vary_key, CacheEntryAssociatedData);
 
+// Small cache entries are packed back to back into shared segment files, rather than each being written to its own file.
+struct CacheSegmentLocation {
+    u32 segment_id { 0 };
+    u64 offset { 0 };
+    u64 size { 0 };
+};
+LexicalPath path_for_cache_segment(LexicalPath const& cache_directory, u32 segment_id);
+Optional<u32> cache_segment_id_for_file(LexicalPath const&);
+
 struct CacheEntryData {
     u64 cache_key { 0 };
     u64 vary_key { 0 };
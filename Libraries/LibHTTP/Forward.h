@@ -13,6 +13,7 @@ namespace HTTP {
 class CacheEntry;
 class CacheEntryReader;
 class CacheEntryWriter;
+class CacheIOQueue;
 class CacheIndex;
 class CacheRequest;
 class DiskCache;
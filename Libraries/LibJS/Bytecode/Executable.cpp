@@ -14,6 +14,7 @@
 #include <LibJS/Bytecode/Instruction.h>
 #include <LibJS/Bytecode/Op.h>
 #include <LibJS/Bytecode/RegexTable.h>
+#include <LibJS/Bytecode/Statistics.h>
 #include <LibJS/Runtime/Array.h>
 #include <LibJS/Runtime/ExternalMemory.h>
 #include <LibJS/Runtime/SharedFunctionInstanceData.h>
@@ -308,7 +309,11 @@ Executable::Executable(
     asm_constants_data = this->constants.data();
 }
 
-Executable::~Executable() = default;
+Executable::~Executable()
+{
+    if constexpr (Statistics::is_enabled())
+        Statistics::the().will_destroy_executable(*this);
+}
 
 static SourceMapEntry const* first_real_source_map_entry(Executable const& executable)
 {
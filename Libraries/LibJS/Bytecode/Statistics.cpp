@@ -0,0 +1,322 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/QuickSort.h>
+#include <AK/StringBuilder.h>
+#include <LibJS/Bytecode/Statistics.h>
+#include <LibJS/SourceCode.h>
+
+namespace JS::Bytecode {
+
+static constexpr StringView opcode_names[] = {
+#define __BYTECODE_OP(op) #op##sv,
+    ENUMERATE_BYTECODE_OPS(__BYTECODE_OP)
+#undef __BYTECODE_OP
+};
+
+static constexpr StringView cache_state_names[] = {
+    "empty"sv,
+    "mono"sv,
+    "poly"sv,
+};
+
+static constexpr StringView other_destroyed_executables_description = "(other collected executables)"sv;
+
+Statistics::Statistics()
+{
+    m_other_destroyed_executables.description = MUST(String::from_utf8(other_destroyed_executables_description));
+}
+
+Statistics& Statistics::the()
+{
+    static Statistics statistics;
+    return statistics;
+}
+
+Statistics::CacheSnapshot Statistics::snapshot(PropertyLookupCache const& cache)
+{
+    CacheSnapshot snapshot;
+    if (!cache.m_data)
+        return snapshot;
+
+    snapshot.state = (cache.m_data & PropertyLookupCache::polymorphic_data_tag) ? CacheState::Polymorphic : CacheState::Monomorphic;
+    if (auto const* entry = cache.first_entry()) {
+        snapshot.first_entry_type = to_underlying(entry->type);
+        snapshot.first_entry_shape = entry->shape.ptr();
+        snapshot.first_entry_property_offset = entry->property_offset;
+    }
+    return snapshot;
+}
+
+Statistics::CacheSnapshot Statistics::snapshot(GlobalVariableCache const& cache)
+{
+    CacheSnapshot snapshot;
+    snapshot.has_environment_binding = cache.has_environment_binding_index;
+    if (cache.has_environment_binding_index)
+        snapshot.first_entry_property_offset = cache.environment_binding_index;
+
+    if (auto const* entry = cache.first_entry()) {
+        snapshot.first_entry_type = to_underlying(entry->type);
+        snapshot.first_entry_shape = entry->shape.ptr();
+        if (!cache.has_environment_binding_index)
+            snapshot.first_entry_property_offset = entry->property_offset;
+    }
+
+    // A global variable cache holds a single entry, and either a shape or a binding index fills it.
+    if (snapshot.first_entry_shape || snapshot.has_environment_binding)
+        snapshot.state = CacheState::Monomorphic;
+    return snapshot;
+}
+
+static String describe_executable(Executable const& executable)
+{
+    auto name = executable.name.is_empty() ? "(top-level)"_utf16_fly_string : executable.name;
+
+    // The first position with a line number is where the executable's code begins.
+    for (auto const& entry : executable.source_map) {
+        if (entry.line > 0)
+            return MUST(String::formatted("{} ({}:{}:{})", name, executable.source_code->filename(), entry.line, entry.column));
+    }
+    return MUST(String::formatted("{} ({})", name, executable.source_code->filename()));
+}
+
+Statistics::ExecutableRecord& Statistics::record_for(Executable const& executable)
+{
+    return *m_live_executables.ensure(&executable, [&] {
+        auto record = make<ExecutableRecord>();
+        record->description = describe_executable(executable);
+        return record;
+    });
+}
+
+Statistics::SiteRecord& Statistics::site_for(Executable const& executable, u32 program_counter)
+{
+    return record_for(executable).sites.ensure(program_counter, [&] {
+        SiteRecord site;
+        site.program_counter = program_counter;
+        site.type = reinterpret_cast<Instruction const*>(executable.bytecode.data() + program_counter)->type();
+        if (auto source_range = executable.source_range_at(program_counter); source_range.has_value())
+            site.location = MUST(String::formatted("{}:{}", source_range->start.line, source_range->start.column));
+        return site;
+    });
+}
+
+void Statistics::did_execute_instruction(Executable const& executable, u32 program_counter)
+{
+    auto type = reinterpret_cast<Instruction const*>(executable.bytecode.data() + program_counter)->type();
+    ++m_instruction_counts[to_underlying(type)];
+    ++m_total_instruction_count;
+    ++record_for(executable).instruction_count;
+}
+
+void Statistics::did_enter_slow_path(Executable const& executable, u32 program_counter, SlowPathKind kind)
+{
+    SlowPathEntry entry { &executable, program_counter, kind, m_total_instruction_count };
+    if (entry == m_last_slow_path_entry)
+        return;
+    m_last_slow_path_entry = entry;
+
+    auto& site = site_for(executable, program_counter);
+    switch (kind) {
+    case SlowPathKind::CacheProbe:
+        ++site.cache_probe_count;
+        break;
+    case SlowPathKind::SlowPath:
+        ++site.slow_path_count;
+        break;
+    }
+}
+
+void Statistics::did_update_cache(Executable const& executable, u32 program_counter, CacheSnapshot const& before, CacheSnapshot const& after)
+{
+    if (before == after)
+        return;
+    auto& site = site_for(executable, program_counter);
+    ++site.cache_transitions[to_underlying(before.state)][to_underlying(after.state)];
+}
+
+void Statistics::merge_record(ExecutableRecord& into, ExecutableRecord const& from)
+{
+    into.instruction_count += from.instruction_count;
+    for (auto const& [program_counter, site] : from.sites) {
+        auto it = into.sites.find(program_counter);
+        if (it == into.sites.end()) {
+            into.sites.set(program_counter, site);
+            continue;
+        }
+
+        auto& merged_site = it->value;
+        merged_site.cache_probe_count += site.cache_probe_count;
+        merged_site.slow_path_count += site.slow_path_count;
+        for (size_t from_state = 0; from_state < number_of_cache_states; ++from_state) {
+            for (size_t to_state = 0; to_state < number_of_cache_states; ++to_state)
+                merged_site.cache_transitions[from_state][to_state] += site.cache_transitions[from_state][to_state];
+        }
+    }
+}
+
+void Statistics::will_destroy_executable(Executable const& executable)
+{
+    auto record = m_live_executables.take(&executable);
+    if (!record.has_value())
+        return;
+
+    if (auto it = m_destroyed_executables.find(record.value()->description); it != m_destroyed_executables.end()) {
+        merge_record(*it->value, *record.value());
+        return;
+    }
+
+    if (m_destroyed_executables.size() < max_destroyed_executable_records) {
+        auto description = record.value()->description;
+        m_destroyed_executables.set(move(description), record.release_value());
+        return;
+    }
+
+    // NB: Instruction sites of different code can't be told apart in a shared record, so only the total is kept.
+    m_other_destroyed_executables.instruction_count += record.value()->instruction_count;
+}
+
+static u64 total_cache_transitions(auto const& site)
+{
+    u64 total = 0;
+    for (auto const& row : site.cache_transitions) {
+        for (auto count : row)
+            total += count;
+    }
+    return total;
+}
+
+static double percentage_of(u64 part, u64 whole)
+{
+    if (whole == 0)
+        return 0;
+    return 100.0 * static_cast<double>(part) / static_cast<double>(whole);
+}
+
+ErrorOr<String> Statistics::to_report(size_t max_rows_per_table) const
+{
+    Vector<ExecutableRecord const*> executables;
+    TRY(executables.try_ensure_capacity(m_live_executables.size() + m_destroyed_executables.size() + 1));
+    for (auto const& it : m_live_executables)
+        executables.unchecked_append(it.value.ptr());
+    for (auto const& it : m_destroyed_executables)
+        executables.unchecked_append(it.value.ptr());
+    if (m_other_destroyed_executables.instruction_count != 0)
+        executables.unchecked_append(&m_other_destroyed_executables);
+
+    struct Site {
+        ExecutableRecord const* executable;
+        SiteRecord const* site;
+        u64 transition_count;
+    };
+    Vector<Site> sites;
+    for (auto const* executable : executables) {
+        for (auto const& it : executable->sites)
+            TRY(sites.try_append({ executable, &it.value, total_cache_transitions(it.value) }));
+    }
+
+    StringBuilder builder;
+    builder.appendff("Bytecode statistics: {} instructions executed in {} executables, {} instruction sites took a slow path\n",
+        m_total_instruction_count, executables.size(), sites.size());
+
+    // Opcodes, most frequently executed first.
+    Vector<size_t> opcodes;
+    for (size_t i = 0; i < m_instruction_counts.size(); ++i) {
+        if (m_instruction_counts[i] != 0)
+            TRY(opcodes.try_append(i));
+    }
+    quick_sort(opcodes, [&](auto a, auto b) { return m_instruction_counts[a] > m_instruction_counts[b]; });
+
+    builder.append("\nOpcodes by execution count:\n"sv);
+    builder.appendff("  {:>14}  {:>6}  {}\n", "count"sv, "%"sv, "opcode"sv);
+    for (size_t i = 0; i < min(opcodes.size(), max_rows_per_table); ++i) {
+        auto count = m_instruction_counts[opcodes[i]];
+        builder.appendff("  {:>14}  {:>6.2}  {}\n", count, percentage_of(count, m_total_instruction_count), opcode_names[opcodes[i]]);
+    }
+
+    // Instruction sites, the ones that fell into a slow path most often first.
+    quick_sort(sites, [](auto const& a, auto const& b) {
+        auto a_total = a.site->slow_path_count + a.site->cache_probe_count;
+        auto b_total = b.site->slow_path_count + b.site->cache_probe_count;
+        return a_total > b_total;
+    });
+
+    builder.append("\nInstruction sites by slow path entries:\n"sv);
+    builder.appendff("  {:>12}  {:>12}  {:>11}  {:<24}  {:>8}  {}\n", "slow paths"sv, "cache probes"sv, "transitions"sv, "opcode"sv, "pc"sv, "location"sv);
+    for (size_t i = 0; i < min(sites.size(), max_rows_per_table); ++i) {
+        auto const& [executable, site, transition_count] = sites[i];
+        builder.appendff("  {:>12}  {:>12}  {:>11}  {:<24}  {:>8}  {} @ {}\n",
+            site->slow_path_count, site->cache_probe_count, transition_count, opcode_names[to_underlying(site->type)],
+            site->program_counter, executable->description, site->location.is_empty() ? "?"_string : site->location);
+    }
+
+    // Inline cache transitions, the sites whose caches churn the most first.
+    quick_sort(sites, [](auto const& a, auto const& b) { return a.transition_count > b.transition_count; });
+
+    builder.append("\nInstruction sites by inline cache transitions:\n"sv);
+    builder.appendff("  {:>11}  {:<40}  {:<24}  {}\n", "transitions"sv, "from -> to (count)"sv, "opcode"sv, "location"sv);
+    for (size_t i = 0; i < min(sites.size(), max_rows_per_table); ++i) {
+        auto const& [executable, site, transition_count] = sites[i];
+        if (transition_count == 0)
+            break;
+
+        StringBuilder transitions;
+        for (size_t from = 0; from < number_of_cache_states; ++from) {
+            for (size_t to = 0; to < number_of_cache_states; ++to) {
+                if (auto count = site->cache_transitions[from][to]; count != 0) {
+                    if (!transitions.is_empty())
+                        transitions.append(", "sv);
+                    transitions.appendff("{}->{} ({})", cache_state_names[from], cache_state_names[to], count);
+                }
+            }
+        }
+
+        builder.appendff("  {:>11}  {:<40}  {:<24}  {} @ {}\n",
+            transition_count, transitions.string_view(), opcode_names[to_underlying(site->type)],
+            executable->description, site->location.is_empty() ? "?"_string : site->location);
+    }
+
+    // Executables, the ones that ran the most instructions first.
+    quick_sort(executables, [](auto const* a, auto const* b) { return a->instruction_count > b->instruction_count; });
+
+    builder.append("\nExecutables by instructions executed:\n"sv);
+    builder.appendff("  {:>14}  {:>6}  {}\n", "instructions"sv, "%"sv, "executable"sv);
+    for (size_t i = 0; i < min(executables.size(), max_rows_per_table); ++i) {
+        auto const* executable = executables[i];
+        if (executable->instruction_count == 0)
+            break;
+        builder.appendff("  {:>14}  {:>6.2}  {}\n", executable->instruction_count, percentage_of(executable->instruction_count, m_total_instruction_count), executable->description);
+    }
+
+    return builder.to_string();
+}
+
+void Statistics::dump() const
+{
+    if constexpr (!is_enabled()) {
+        warnln("bytecode-stats: Not collected; LibJS must be built with JS_BYTECODE_STATISTICS_DEBUG");
+        return;
+    }
+
+    auto report = to_report();
+    if (report.is_error()) {
+        warnln("bytecode-stats: Unable to generate report: {}", report.error());
+        return;
+    }
+    warn("{}", report.value());
+}
+
+void Statistics::reset()
+{
+    m_instruction_counts.fill(0);
+    m_total_instruction_count = 0;
+    m_last_slow_path_entry = {};
+    m_live_executables.clear();
+    m_destroyed_executables.clear();
+    m_other_destroyed_executables.instruction_count = 0;
+}
+
+}
@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Array.h>
+#include <AK/Debug.h>
+#include <AK/Error.h>
+#include <AK/HashMap.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Noncopyable.h>
+#include <AK/String.h>
+#include <AK/Vector.h>
+#include <LibJS/Bytecode/Executable.h>
+#include <LibJS/Bytecode/Instruction.h>
+#include <LibJS/Export.h>
+
+namespace JS::Bytecode {
+
+// Counters for finding out where the bytecode interpreter spends its time: how often each opcode runs, how often each
+// instruction falls out of the asm interpreter into a C++ slow path, and how its inline cache changes when it does.
+//
+// Nothing is recorded unless LibJS is built with JS_BYTECODE_STATISTICS_DEBUG. In such builds, the asm interpreter
+// dispatches every instruction through asm_debugger_check_breakpoint(), which counts it, so expect scripts to run
+// several times slower than usual.
+//
+// NB: Counting is not thread-safe; only the thread that runs the VM may record anything.
+class JS_API Statistics {
+    AK_MAKE_NONCOPYABLE(Statistics);
+    AK_MAKE_NONMOVABLE(Statistics);
+
+public:
+    static Statistics& the();
+
+    static constexpr bool is_enabled() { return JS_BYTECODE_STATISTICS_DEBUG; }
+
+    enum class SlowPathKind : u8 {
+        // A C++ probe of every cache entry, for caches the asm fast path could not handle by itself.
+        CacheProbe,
+        // The full slow path, which looks the property up and may update the cache.
+        SlowPath,
+    };
+
+    enum class CacheState : u8 {
+        Empty,
+        Monomorphic,
+        Polymorphic,
+    };
+
+    // Enough of an inline cache to tell whether a slow path changed it.
+    struct CacheSnapshot {
+        CacheState state { CacheState::Empty };
+        u8 first_entry_type { 0 };
+        Shape const* first_entry_shape { nullptr };
+        u32 first_entry_property_offset { 0 };
+        bool has_environment_binding { false };
+
+        bool operator==(CacheSnapshot const&) const = default;
+    };
+
+    static CacheSnapshot snapshot(PropertyLookupCache const&);
+    static CacheSnapshot snapshot(GlobalVariableCache const&);
+
+    void did_execute_instruction(Executable const&, u32 program_counter);
+    void did_enter_slow_path(Executable const&, u32 program_counter, SlowPathKind);
+    void did_update_cache(Executable const&, u32 program_counter, CacheSnapshot const& before, CacheSnapshot const& after);
+
+    // Folds the counters of a dying executable into those of earlier executables with the same description, and makes
+    // sure that a new executable allocated at the same address doesn't inherit them.
+    void will_destroy_executable(Executable const&);
+
+    ErrorOr<String> to_report(size_t max_rows_per_table = 40) const;
+    void dump() const;
+    void reset();
+
+private:
+    Statistics();
+
+    static constexpr size_t number_of_cache_states = 3;
+
+#define __BYTECODE_OP(op) +1
+    static constexpr size_t number_of_opcodes = 0 ENUMERATE_BYTECODE_OPS(__BYTECODE_OP);
+#undef __BYTECODE_OP
+
+    struct SiteRecord {
+        u32 program_counter { 0 };
+        Instruction::Type type {};
+        String location;
+        u64 cache_probe_count { 0 };
+        u64 slow_path_count { 0 };
+        Array<Array<u64, number_of_cache_states>, number_of_cache_states> cache_transitions {};
+    };
+
+    struct ExecutableRecord {
+        String description;
+        u64 instruction_count { 0 };
+        HashMap<u32, SiteRecord> sites;
+    };
+
+    static void merge_record(ExecutableRecord& into, ExecutableRecord const& from);
+
+    ExecutableRecord& record_for(Executable const&);
+    SiteRecord& site_for(Executable const&, u32 program_counter);
+
+    Array<u64, number_of_opcodes> m_instruction_counts {};
+    u64 m_total_instruction_count { 0 };
+
+    // Some slow paths call into others for the same instruction, which should only count once.
+    struct SlowPathEntry {
+        Executable const* executable { nullptr };
+        u32 program_counter { 0 };
+        SlowPathKind kind { SlowPathKind::SlowPath };
+        u64 total_instruction_count { 0 };
+
+        bool operator==(SlowPathEntry const&) const = default;
+    };
+    SlowPathEntry m_last_slow_path_entry;
+
+    HashMap<Executable const*, NonnullOwnPtr<ExecutableRecord>> m_live_executables;
+
+    // Code that is compiled over and over, like eval() in a loop, shares a description and therefore a single record.
+    // Past the limit, collected executables only add to the instruction count of the last record.
+    static constexpr size_t max_destroyed_executable_records = 1024;
+    HashMap<String, NonnullOwnPtr<ExecutableRecord>> m_destroyed_executables;
+    ExecutableRecord m_other_destroyed_executables;
+};
+
+}
@@ -13,6 +13,7 @@
 #include <AK/Utf16StringBuilder.h>
 #include <LibJS/Console.h>
 #include <LibJS/Print.h>
+#include <LibJS/Profiler.h>
 #include <LibJS/Runtime/AbstractOperations.h>
 #include <LibJS/Runtime/Array.h>
 #include <LibJS/Runtime/Completion.h>
@@ -722,6 +723,68 @@ ThrowCompletionOr<Value> Console::time_end()
     return js_undefined();
 }
 
+ThrowCompletionOr<void> Console::print_warning(Utf16String message)
+{
+    if (!m_client)
+        return {};
+
+    GC::RootVector<Value> message_as_vector;
+    message_as_vector.append(PrimitiveString::create(realm().vm(), move(message)));
+    TRY(m_client->printer(LogLevel::Warn, move(message_as_vector)));
+    return {};
+}
+
+// NB: console.profile() and console.profileEnd() are not part of the Console Standard, but are implemented by all
+//     major engines.
+ThrowCompletionOr<Value> Console::profile()
+{
+    auto& vm = realm().vm();
+    auto label = TRY(label_or_fallback(vm, "default"sv));
+
+    if (m_active_profile_label.has_value() || (vm.profiler() && vm.profiler()->is_running())) {
+        TRY(print_warning(Utf16String::formatted("Cannot start profile '{}', another profile is already running.", label)));
+        return js_undefined();
+    }
+
+    vm.enable_profiling();
+    if (auto result = vm.profiler()->start(); result.is_error()) {
+        vm.disable_profiling();
+        TRY(print_warning(Utf16String::formatted("Unable to start profile '{}': {}", label, result.error())));
+        return js_undefined();
+    }
+
+    m_active_profile_label = move(label);
+    return js_undefined();
+}
+
+ThrowCompletionOr<Value> Console::profile_end()
+{
+    auto& vm = realm().vm();
+    auto label = TRY(label_or_fallback(vm, "default"sv));
+
+    if (m_active_profile_label != label) {
+        TRY(print_warning(Utf16String::formatted("Profile '{}' does not exist.", label)));
+        return js_undefined();
+    }
+    m_active_profile_label.clear();
+
+    auto& profiler = *vm.profiler();
+    profiler.stop();
+
+    auto cpu_profile = profiler.to_cpu_profile_json();
+    auto sample_count = profiler.sample_count();
+    vm.disable_profiling();
+
+    if (cpu_profile.is_error()) {
+        TRY(print_warning(Utf16String::formatted("Unable to export profile '{}': {}", label, cpu_profile.error())));
+        return js_undefined();
+    }
+
+    if (m_client)
+        TRY(m_client->report_profile(label, sample_count, cpu_profile.release_value()));
+    return js_undefined();
+}
+
 GC::RootVector<Value> Console::vm_arguments()
 {
     auto& vm = realm().vm();
@@ -976,4 +1039,13 @@ ThrowCompletionOr<Utf16String> ConsoleClient::generically_format_values(GC::Root
     return builder.to_string();
 }
 
+ThrowCompletionOr<void> ConsoleClient::report_profile(Utf16View label, size_t sample_count, String)
+{
+    // Hosts that can present or save the profile override this. By default, just let the user know it finished.
+    GC::RootVector<Value> message_as_vector;
+    message_as_vector.append(PrimitiveString::create(m_console->realm().vm(), Utf16String::formatted("Profile '{}' finished with {} samples.", label, sample_count)));
+    TRY(printer(Console::LogLevel::Info, move(message_as_vector)));
+    return {};
+}
+
 }
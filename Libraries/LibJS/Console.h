@@ -97,6 +97,8 @@ public:
     ThrowCompletionOr<Value> time();
     ThrowCompletionOr<Value> time_log();
     ThrowCompletionOr<Value> time_end();
+    ThrowCompletionOr<Value> profile();
+    ThrowCompletionOr<Value> profile_end();
 
     void output_debug_message(LogLevel log_level, StringView output) const;
     void output_debug_message(LogLevel log_level, Utf16View output) const;
@@ -108,6 +110,7 @@ private:
     virtual void visit_edges(Visitor&) override;
 
     ThrowCompletionOr<Utf16String> value_vector_to_string(GC::RootVector<Value> const&);
+    ThrowCompletionOr<void> print_warning(Utf16String message);
 
     GC::Ref<Realm> m_realm;
     GC::Ptr<ConsoleClient> m_client;
@@ -115,6 +118,7 @@ private:
     HashMap<Utf16String, unsigned> m_counters;
     HashMap<Utf16String, Core::ElapsedTimer> m_timer_table;
     Vector<Group> m_group_stack;
+    Optional<Utf16String> m_active_profile_label;
 };
 
 class JS_API ConsoleClient : public Cell {
@@ -131,6 +135,9 @@ public:
     virtual void add_css_style_to_current_message(Utf16View) { }
     virtual void report_exception(Utf16View, Utf16View, JS::ErrorData const&, bool) { }
 
+    // Called by console.profileEnd() with the finished profile, in the .cpuprofile format.
+    virtual ThrowCompletionOr<void> report_profile(Utf16View label, size_t sample_count, String cpu_profile_json);
+
     virtual void clear() = 0;
     virtual void end_group() = 0;
 
@@ -201,6 +201,7 @@ class NativeJavaScriptBackedFunction;
 class ObjectEnvironment;
 struct ParserError;
 class PrimitiveString;
+class Profiler;
 class PromiseCapability;
 class PromiseReaction;
 class PropertyAttributes;
@@ -324,6 +325,7 @@ class Operand;
 struct PropertyLookupCache;
 class RegexTable;
 class Register;
+class Statistics;
 
 }
 
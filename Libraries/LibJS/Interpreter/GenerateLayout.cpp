@@ -7,6 +7,7 @@
 // Small build-time tool that prints struct field offsets as DSL constants.
 // Compiled with the same flags as LibJS so layouts match exactly.
 
+#include <AK/Debug.h>
 #include <AK/Format.h>
 #include <AK/StringBase.h>
 #include <AK/Utf16StringData.h>
@@ -221,7 +222,12 @@ int main()
     EMIT_OFFSET(VM_STACK_INFO, VM, m_stack_info);
     EMIT_OFFSET(VM_EXECUTION_GENERATION, VM, m_execution_generation);
     EMIT_OFFSET(VM_PRIMITIVE_STORAGE_CAGE_BASE, VM, m_primitive_storage_cage_base);
-    EMIT_OFFSET(VM_BREAKPOINT_CONTROLLER, VM, m_debugger);
+    // NB: Statistics builds send every instruction through the debug dispatch table, since that is where opcode
+    //     executions are counted.
+    if constexpr (JS_BYTECODE_STATISTICS_DEBUG)
+        EMIT_OFFSET(VM_BREAKPOINT_CONTROLLER, VM, m_bytecode_statistics);
+    else
+        EMIT_OFFSET(VM_BREAKPOINT_CONTROLLER, VM, m_debugger);
     outln("field VM.primitive_storage_cage_base u64 VM_PRIMITIVE_STORAGE_CAGE_BASE nonnull");
     outln("const VM_INTERPRETER_STACK_TOP = {}", offsetof(VM, m_interpreter_stack) + offsetof(InterpreterStack, m_top));
     outln("const VM_INTERPRETER_STACK_LIMIT = {}", offsetof(VM, m_interpreter_stack) + offsetof(InterpreterStack, m_limit));
@@ -12,6 +12,7 @@
 #include <LibJS/Bytecode/Op.h>
 #include <LibJS/Bytecode/PropertyAccess.h>
 #include <LibJS/Bytecode/PropertyNameIterator.h>
+#include <LibJS/Bytecode/Statistics.h>
 #include <LibJS/Debugger.h>
 #include <LibJS/Runtime/AbstractOperations.h>
 #include <LibJS/Runtime/Array.h>
@@ -76,6 +77,43 @@ static i64 advance_or_continue(u32 pc, i64 next_pc)
     return static_cast<i64>(pc + sizeof(Op));
 }
 
+// Counts an entry into a slow path for the bytecode statistics report. Compiles to nothing unless LibJS is built with
+// JS_BYTECODE_STATISTICS_DEBUG.
+ALWAYS_INLINE static void record_slow_path_entry([[maybe_unused]] VM& vm, [[maybe_unused]] u32 pc)
+{
+    if constexpr (Statistics::is_enabled())
+        Statistics::the().did_enter_slow_path(vm.current_executable(), pc, Statistics::SlowPathKind::SlowPath);
+}
+
+// Like record_slow_path_entry(), but for instructions with an inline cache, whose changes are recorded as well once
+// the slow path returns.
+template<typename Cache>
+class InlineCacheStatisticsScope {
+public:
+    InlineCacheStatisticsScope([[maybe_unused]] VM& vm, [[maybe_unused]] u32 pc, [[maybe_unused]] Cache const& cache, [[maybe_unused]] Statistics::SlowPathKind kind)
+    {
+        if constexpr (Statistics::is_enabled()) {
+            m_executable = &vm.current_executable();
+            m_cache = &cache;
+            m_program_counter = pc;
+            m_cache_before = Statistics::snapshot(cache);
+            Statistics::the().did_enter_slow_path(*m_executable, pc, kind);
+        }
+    }
+
+    ~InlineCacheStatisticsScope()
+    {
+        if constexpr (Statistics::is_enabled())
+            Statistics::the().did_update_cache(*m_executable, m_program_counter, m_cache_before, Statistics::snapshot(*m_cache));
+    }
+
+private:
+    Executable const* m_executable { nullptr };
+    Cache const* m_cache { nullptr };
+    Statistics::CacheSnapshot m_cache_before;
+    u32 m_program_counter { 0 };
+};
+
 template<typename EnvironmentPointer>
 static EnvironmentPointer asm_get_cacheable_environment(EnvironmentPointer environment, EnvironmentCoordinate const& cache)
 {
@@ -740,6 +778,9 @@ i64 asm_try_put_by_value_typed_array(VM*, u32 pc, Op::PutByValue const*);
 // NB: Every bytecode opcode has a DSL handler, so this should never run.
 void asm_debugger_check_breakpoint(VM* vm, u32 pc)
 {
+    if constexpr (Statistics::is_enabled())
+        Statistics::the().did_execute_instruction(vm->current_executable(), pc);
+
     // NB: The dispatch table is chosen when entering the interpreter, so we keep getting called
     //     for the rest of the frame even if the host detaches its debugger in the meantime.
     auto* debugger = vm->debugger();
@@ -775,6 +816,7 @@ i64 asm_fallback_handler(VM*, u32, u8 const*)
 
 i64 asm_slow_path_add_values(VM* vm, u32 pc, Operand destination, Value lhs, Value rhs)
 {
+    record_slow_path_entry(*vm, pc);
     return finish_binary_slow_path(*vm, pc, destination, add(*vm, lhs, rhs));
 }
 
@@ -785,6 +827,7 @@ i64 asm_slow_path_add(VM* vm, u32 pc, Op::Add const* instruction)
 
 i64 asm_slow_path_sub_values(VM* vm, u32 pc, Operand destination, Value lhs, Value rhs)
 {
+    record_slow_path_entry(*vm, pc);
     return finish_binary_slow_path(*vm, pc, destination, sub(*vm, lhs, rhs));
 }
 
@@ -795,11 +838,13 @@ i64 asm_slow_path_sub(VM* vm, u32 pc, Op::Sub const* instruction)
 
 i64 asm_slow_path_mul_values(VM* vm, u32 pc, Operand destination, Value lhs, Value rhs)
 {
+    record_slow_path_entry(*vm, pc);
     return finish_binary_slow_path(*vm, pc, destination, mul(*vm, lhs, rhs));
 }
 
 i64 asm_slow_path_div_values(VM* vm, u32 pc, Operand destination, Value lhs, Value rhs)
 {
+    record_slow_path_entry(*vm, pc);
     return finish_binary_slow_path(*vm, pc, destination, div(*vm, lhs, rhs));
 }
 
@@ -810,6 +855,7 @@ i64 asm_slow_path_less_than(VM* vm, u32 pc, Op::LessThan const* instruction)
 
 i64 asm_slow_path_less_than_values(VM* vm, u32 pc, Operand destination, Value lhs, Value rhs)
 {
+    record_slow_path_entry(*vm, pc);
     return finish_binary_slow_path(*vm, pc, destination, less_than(*vm, lhs, rhs));
 }
 
@@ -820,6 +866,7 @@ i64 asm_slow_path_less_than_equals(VM* vm, u32 pc, Op::LessThanEquals const* ins
 
 i64 asm_slow_path_less_than_equals_values(VM* vm, u32 pc, Operand destination, Value lhs, Value rhs)
 {
+    record_slow_path_entry(*vm, pc);
     return finish_binary_slow_path(*vm, pc, destination, less_than_equals(*vm, lhs, rhs));
 }
 
@@ -830,6 +877,7 @@ i64 asm_slow_path_greater_than(VM* vm, u32 pc, Op::GreaterThan const* instructio
 
 i64 asm_slow_path_greater_than_values(VM* vm, u32 pc, Operand destination, Value lhs, Value rhs)
 {
+    record_slow_path_entry(*vm, pc);
     return finish_binary_slow_path(*vm, pc, destination, greater_than(*vm, lhs, rhs));
 }
 
@@ -840,11 +888,13 @@ i64 asm_slow_path_greater_than_equals(VM* vm, u32 pc, Op::GreaterThanEquals cons
 
 i64 asm_slow_path_greater_than_equals_values(VM* vm, u32 pc, Operand destination, Value lhs, Value rhs)
 {
+    record_slow_path_entry(*vm, pc);
     return finish_binary_slow_path(*vm, pc, destination, greater_than_equals(*vm, lhs, rhs));
 }
 
 i64 asm_slow_path_increment(VM* vm, u32 pc, Op::Increment const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     auto old_value = ASM_TRY(*vm, pc, vm->get(instruction->dst()).to_numeric(*vm));
     if (old_value.is_number())
         vm->set(instruction->dst(), Value(old_value.as_double() + 1));
@@ -855,6 +905,7 @@ i64 asm_slow_path_increment(VM* vm, u32 pc, Op::Increment const* instruction)
 
 i64 asm_slow_path_decrement(VM* vm, u32 pc, Op::Decrement const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     auto old_value = ASM_TRY(*vm, pc, vm->get(instruction->dst()).to_numeric(*vm));
     if (old_value.is_number())
         vm->set(instruction->dst(), Value(old_value.as_double() - 1));
@@ -868,6 +919,7 @@ i64 asm_slow_path_decrement(VM* vm, u32 pc, Op::Decrement const* instruction)
     i64 asm_slow_path_jump_##snake_name##_values(                                \
         VM* vm, u32 pc, Value lhs, Value rhs, u32 true_target, u32 false_target) \
     {                                                                            \
+        record_slow_path_entry(*vm, pc);                                         \
         if (ASM_TRY(*vm, pc, compare_call))                                      \
             return static_cast<i64>(true_target);                                \
         return static_cast<i64>(false_target);                                   \
@@ -881,6 +933,7 @@ DEFINE_JUMP_COMPARISON_SLOW_PATH(greater_than_equals, greater_than_equals(*vm, l
 
 i64 asm_slow_path_jump_loosely_equals_values(VM* vm, u32 pc, Value lhs, Value rhs, u32 true_target, u32 false_target)
 {
+    record_slow_path_entry(*vm, pc);
     if (ASM_TRY(*vm, pc, is_loosely_equal(*vm, lhs, rhs)))
         return static_cast<i64>(true_target);
     return static_cast<i64>(false_target);
@@ -888,6 +941,7 @@ i64 asm_slow_path_jump_loosely_equals_values(VM* vm, u32 pc, Value lhs, Value rh
 
 i64 asm_slow_path_jump_loosely_inequals_values(VM* vm, u32 pc, Value lhs, Value rhs, u32 true_target, u32 false_target)
 {
+    record_slow_path_entry(*vm, pc);
     if (!ASM_TRY(*vm, pc, is_loosely_equal(*vm, lhs, rhs)))
         return static_cast<i64>(true_target);
     return static_cast<i64>(false_target);
@@ -896,6 +950,7 @@ i64 asm_slow_path_jump_loosely_inequals_values(VM* vm, u32 pc, Value lhs, Value
 i64 asm_slow_path_jump_strictly_equals_values(
     [[maybe_unused]] VM* vm, [[maybe_unused]] u32 pc, Value lhs, Value rhs, u32 true_target, u32 false_target)
 {
+    record_slow_path_entry(*vm, pc);
     if (is_strictly_equal(lhs, rhs))
         return static_cast<i64>(true_target);
     return static_cast<i64>(false_target);
@@ -904,6 +959,7 @@ i64 asm_slow_path_jump_strictly_equals_values(
 i64 asm_slow_path_jump_strictly_inequals_values(
     [[maybe_unused]] VM* vm, [[maybe_unused]] u32 pc, Value lhs, Value rhs, u32 true_target, u32 false_target)
 {
+    record_slow_path_entry(*vm, pc);
     if (!is_strictly_equal(lhs, rhs))
         return static_cast<i64>(true_target);
     return static_cast<i64>(false_target);
@@ -913,12 +969,14 @@ i64 asm_slow_path_jump_strictly_inequals_values(
 
 i64 asm_slow_path_get_initialized_binding(VM* vm, u32 pc, Op::GetInitializedBinding const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     auto next_pc = asm_get_binding<AsmBindingIsKnownToBeInitialized::Yes>(*vm, pc, instruction->dst(), instruction->cache());
     return advance_or_continue<Op::GetInitializedBinding>(pc, next_pc);
 }
 
 i64 asm_slow_path_dynamic_get_initialized_binding(VM* vm, u32 pc, Op::DynamicGetInitializedBinding const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     auto& cache = vm->current_executable().environment_coordinate_caches[instruction->cache()];
     auto next_pc = asm_dynamic_get_binding<AsmBindingIsKnownToBeInitialized::Yes>(*vm, pc, instruction->dst(), instruction->identifier(), instruction->strict(), cache);
     return advance_or_continue<Op::DynamicGetInitializedBinding>(pc, next_pc);
@@ -926,6 +984,7 @@ i64 asm_slow_path_dynamic_get_initialized_binding(VM* vm, u32 pc, Op::DynamicGet
 
 i64 asm_slow_path_get_callee_and_this(VM* vm, u32 pc, Op::GetCalleeAndThisFromEnvironment const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     auto const& cache = instruction->cache();
     VERIFY(cache.is_valid());
 
@@ -944,6 +1003,7 @@ i64 asm_slow_path_get_callee_and_this(VM* vm, u32 pc, Op::GetCalleeAndThisFromEn
 
 i64 asm_slow_path_dynamic_get_callee_and_this(VM* vm, u32 pc, Op::DynamicGetCalleeAndThisFromEnvironment const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     auto& cache = vm->current_executable().environment_coordinate_caches[instruction->cache()];
     auto next_pc = asm_dynamic_get_callee_and_this_from_environment(*vm, pc, instruction->callee(), instruction->this_value(), instruction->identifier(), instruction->strict(), cache);
     return advance_or_continue<Op::DynamicGetCalleeAndThisFromEnvironment>(pc, next_pc);
@@ -951,6 +1011,7 @@ i64 asm_slow_path_dynamic_get_callee_and_this(VM* vm, u32 pc, Op::DynamicGetCall
 
 i64 asm_slow_path_postfix_increment(VM* vm, u32 pc, Op::PostfixIncrement const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     auto old_value = ASM_TRY(*vm, pc, vm->get(instruction->src()).to_numeric(*vm));
     vm->set(instruction->dst(), old_value);
     if (old_value.is_number())
@@ -964,6 +1025,7 @@ i64 asm_slow_path_get_by_id(VM* vm, u32 pc, Op::GetById const* instruction)
 {
     auto base_value = vm->get(instruction->base());
     auto& cache = vm->current_executable().property_lookup_caches[instruction->cache()];
+    InlineCacheStatisticsScope statistics_scope { *vm, pc, cache, Statistics::SlowPathKind::SlowPath };
     auto value = ASM_TRY(*vm, pc, get_by_id<GetByIdMode::Normal>(*vm, [&] { return vm->get_identifier(instruction->base_identifier()); }, [&] -> PropertyKey const& { return vm->get_property_key(instruction->property()); }, base_value, base_value, cache));
     vm->set(instruction->dst(), value);
     return static_cast<i64>(pc + sizeof(Op::GetById));
@@ -974,6 +1036,7 @@ i64 asm_slow_path_get_by_id_with_this(VM* vm, u32 pc, Op::GetByIdWithThis const*
     auto base_value = vm->get(instruction->base());
     auto this_value = vm->get(instruction->this_value());
     auto& cache = vm->current_executable().property_lookup_caches[instruction->cache()];
+    InlineCacheStatisticsScope statistics_scope { *vm, pc, cache, Statistics::SlowPathKind::SlowPath };
     auto value = ASM_TRY(*vm, pc, get_by_id<GetByIdMode::Normal>(*vm, [] { return Optional<Utf16FlyString const&> {}; }, [&] -> PropertyKey const& { return vm->get_property_key(instruction->property()); }, base_value, this_value, cache));
     vm->set(instruction->dst(), value);
     return static_cast<i64>(pc + sizeof(Op::GetByIdWithThis));
@@ -988,6 +1051,7 @@ i64 asm_slow_path_put_by_id(VM* vm, u32 pc, Op::PutById const* instruction)
         base_identifier = vm->get_identifier(instruction->base_identifier().value());
     auto const& property_key = vm->get_property_key(instruction->property());
     auto& cache = vm->current_executable().property_lookup_caches[instruction->cache()];
+    InlineCacheStatisticsScope statistics_scope { *vm, pc, cache, Statistics::SlowPathKind::SlowPath };
     ASM_TRY(*vm, pc, put_by_property_key(*vm, base, base, value, base_identifier, property_key, instruction->kind(), instruction->strict(), &cache));
     return static_cast<i64>(pc + sizeof(Op::PutById));
 }
@@ -998,12 +1062,14 @@ i64 asm_slow_path_put_by_id_with_this(VM* vm, u32 pc, Op::PutByIdWithThis const*
     auto base = vm->get(instruction->base());
     auto const& name = vm->get_property_key(instruction->property());
     auto& cache = vm->current_executable().property_lookup_caches[instruction->cache()];
+    InlineCacheStatisticsScope statistics_scope { *vm, pc, cache, Statistics::SlowPathKind::SlowPath };
     ASM_TRY(*vm, pc, put_by_property_key(*vm, base, vm->get(instruction->this_value()), value, {}, name, instruction->kind(), instruction->strict(), &cache));
     return static_cast<i64>(pc + sizeof(Op::PutByIdWithThis));
 }
 
 i64 asm_slow_path_get_by_value(VM* vm, u32 pc, Op::GetByValue const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     auto base_value = vm->get(instruction->base());
     auto property_key_value = vm->get(instruction->property());
     auto object = ASM_TRY(*vm, pc, base_object_for_get(*vm, base_value, [&]() -> Optional<Utf16FlyString const&> {
@@ -1024,6 +1090,7 @@ i64 asm_slow_path_get_by_value(VM* vm, u32 pc, Op::GetByValue const* instruction
 
 i64 asm_slow_path_get_by_value_with_this(VM* vm, u32 pc, Op::GetByValueWithThis const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     auto property_key_value = vm->get(instruction->property());
     auto object = ASM_TRY(*vm, pc, vm->get(instruction->base()).to_object(*vm));
     auto property_key = ASM_TRY(*vm, pc, property_key_value.to_property_key(*vm));
@@ -1037,6 +1104,7 @@ i64 asm_slow_path_get_length(VM* vm, u32 pc, Op::GetLength const* instruction)
     auto base_value = vm->get(instruction->base());
     auto& executable = vm->current_executable();
     auto& cache = executable.property_lookup_caches[instruction->cache()];
+    InlineCacheStatisticsScope statistics_scope { *vm, pc, cache, Statistics::SlowPathKind::SlowPath };
     auto value = ASM_TRY(*vm, pc, get_by_id<GetByIdMode::Length>(*vm, [&] { return vm->get_identifier(instruction->base_identifier()); }, [&] -> PropertyKey const& { return executable.get_property_key(*executable.length_identifier); }, base_value, base_value, cache));
     vm->set(instruction->dst(), value);
     return static_cast<i64>(pc + sizeof(Op::GetLength));
@@ -1048,6 +1116,7 @@ i64 asm_slow_path_get_length_with_this(VM* vm, u32 pc, Op::GetLengthWithThis con
     auto this_value = vm->get(instruction->this_value());
     auto& executable = vm->current_executable();
     auto& cache = executable.property_lookup_caches[instruction->cache()];
+    InlineCacheStatisticsScope statistics_scope { *vm, pc, cache, Statistics::SlowPathKind::SlowPath };
     auto value = ASM_TRY(*vm, pc, get_by_id<GetByIdMode::Length>(*vm, [] { return Optional<Utf16FlyString const&> {}; }, [&] -> PropertyKey const& { return executable.get_property_key(*executable.length_identifier); }, base_value, this_value, cache));
     vm->set(instruction->dst(), value);
     return static_cast<i64>(pc + sizeof(Op::GetLengthWithThis));
@@ -1055,6 +1124,7 @@ i64 asm_slow_path_get_length_with_this(VM* vm, u32 pc, Op::GetLengthWithThis con
 
 i64 asm_slow_path_get_method(VM* vm, u32 pc, Op::GetMethod const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     auto const& property_key = vm->get_property_key(instruction->property());
     auto method = ASM_TRY(*vm, pc, vm->get(instruction->object()).get_method(*vm, property_key));
     vm->set(instruction->dst(), method ?: js_undefined());
@@ -1063,6 +1133,7 @@ i64 asm_slow_path_get_method(VM* vm, u32 pc, Op::GetMethod const* instruction)
 
 i64 asm_slow_path_get_iterator(VM* vm, u32 pc, Op::GetIterator const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     auto iterator_record = ASM_TRY(*vm, pc, get_iterator_impl(*vm, vm->get(instruction->iterable()), instruction->hint()));
     vm->set(instruction->dst_iterator_object(), iterator_record.iterator);
     vm->set(instruction->dst_iterator_next(), iterator_record.next_method);
@@ -1072,26 +1143,30 @@ i64 asm_slow_path_get_iterator(VM* vm, u32 pc, Op::GetIterator const* instructio
 
 i64 asm_slow_path_get_import_meta(VM* vm, u32 pc, Op::GetImportMeta const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     vm->set(instruction->dst(), vm->get_import_meta());
     return static_cast<i64>(pc + sizeof(Op::GetImportMeta));
 }
 
 i64 asm_slow_path_get_new_target(VM* vm, u32 pc, Op::GetNewTarget const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     vm->set(instruction->dst(), vm->get_new_target());
     return static_cast<i64>(pc + sizeof(Op::GetNewTarget));
 }
 
 i64 asm_slow_path_get_super_constructor(VM* vm, u32 pc, Op::GetSuperConstructor const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     auto* super_constructor = get_super_constructor(*vm);
     vm->set(instruction->dst(), super_constructor ? Value(super_constructor) : js_null());
     return static_cast<i64>(pc + sizeof(Op::GetSuperConstructor));
 }
 
-i64 asm_try_get_global_env_binding(VM* vm, u32, Op::GetGlobal const* instruction)
+i64 asm_try_get_global_env_binding(VM* vm, u32 pc, Op::GetGlobal const* instruction)
 {
     auto& cache = vm->current_executable().global_variable_caches[instruction->cache()];
+    InlineCacheStatisticsScope statistics_scope { *vm, pc, cache, Statistics::SlowPathKind::CacheProbe };
 
     if (!cache.has_environment_binding_index) [[unlikely]]
         return 1;
@@ -1114,10 +1189,10 @@ i64 asm_try_get_global_env_binding(VM* vm, u32, Op::GetGlobal const* instruction
 
 i64 asm_slow_path_get_global(VM* vm, u32 pc, Op::GetGlobal const* instruction)
 {
-
     auto& binding_object = vm->global_object();
     auto& declarative_record = vm->global_declarative_environment();
     auto& cache = vm->current_executable().global_variable_caches[instruction->cache()];
+    InlineCacheStatisticsScope statistics_scope { *vm, pc, cache, Statistics::SlowPathKind::SlowPath };
 
     auto& shape = binding_object.shape();
     if (cache.environment_serial_number == declarative_record.environment_serial_number()) {
@@ -1190,9 +1265,10 @@ i64 asm_slow_path_get_global(VM* vm, u32 pc, Op::GetGlobal const* instruction)
     return handle_asm_exception(*vm, pc, completion.value());
 }
 
-i64 asm_try_set_global_env_binding(VM* vm, u32, Op::SetGlobal const* instruction)
+i64 asm_try_set_global_env_binding(VM* vm, u32 pc, Op::SetGlobal const* instruction)
 {
     auto& cache = vm->current_executable().global_variable_caches[instruction->cache()];
+    InlineCacheStatisticsScope statistics_scope { *vm, pc, cache, Statistics::SlowPathKind::CacheProbe };
 
     if (!cache.has_environment_binding_index) [[unlikely]]
         return 1;
@@ -1215,10 +1291,10 @@ i64 asm_try_set_global_env_binding(VM* vm, u32, Op::SetGlobal const* instruction
 
 i64 asm_slow_path_set_global(VM* vm, u32 pc, Op::SetGlobal const* instruction)
 {
-
     auto& binding_object = vm->global_object();
     auto& declarative_record = vm->global_declarative_environment();
     auto& cache = vm->current_executable().global_variable_caches[instruction->cache()];
+    InlineCacheStatisticsScope statistics_scope { *vm, pc, cache, Statistics::SlowPathKind::SlowPath };
     auto& shape = binding_object.shape();
     auto src = vm->get(instruction->src());
 
@@ -1307,6 +1383,7 @@ i64 asm_slow_path_set_global(VM* vm, u32 pc, Op::SetGlobal const* instruction)
 
 i64 asm_slow_path_concat_string(VM* vm, u32 pc, Op::ConcatString const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     auto string = ASM_TRY(*vm, pc, vm->get(instruction->src()).to_primitive_string(*vm));
     vm->set(instruction->dst(), PrimitiveString::create(*vm, vm->get(instruction->dst()).as_string(), string));
     return static_cast<i64>(pc + sizeof(Op::ConcatString));
@@ -1314,6 +1391,7 @@ i64 asm_slow_path_concat_string(VM* vm, u32 pc, Op::ConcatString const* instruct
 
 i64 asm_slow_path_copy_object_excluding_properties(VM* vm, u32 pc, Op::CopyObjectExcludingProperties const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     auto& realm = *vm->current_realm();
     auto from_object = vm->get(instruction->from_object());
     auto to_object = Object::create(realm, realm.intrinsics().object_prototype());
@@ -1330,11 +1408,13 @@ i64 asm_slow_path_copy_object_excluding_properties(VM* vm, u32 pc, Op::CopyObjec
 
 i64 asm_slow_path_exp_values(VM* vm, u32 pc, Operand destination, Value lhs, Value rhs)
 {
+    record_slow_path_entry(*vm, pc);
     return finish_binary_slow_path(*vm, pc, destination, exp(*vm, lhs, rhs));
 }
 
 i64 asm_slow_path_import_call(VM* vm, u32 pc, Op::ImportCall const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     auto specifier = vm->get(instruction->specifier());
     auto options_value = vm->get(instruction->options());
     vm->set(instruction->dst(), ASM_TRY(*vm, pc, perform_import_call(*vm, specifier, options_value)));
@@ -1343,6 +1423,7 @@ i64 asm_slow_path_import_call(VM* vm, u32 pc, Op::ImportCall const* instruction)
 
 i64 asm_slow_path_new_class(VM* vm, u32 pc, Op::NewClass const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
 
     Value super_class;
     if (instruction->super_class().has_value())
@@ -1451,6 +1532,7 @@ NEVER_INLINE static ThrowCompletionOr<void> execute_asm_call(
 
 i64 asm_slow_path_call(VM* vm, u32 pc, Op::Call const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     ASM_TRY(*vm, pc, execute_asm_call(Op::CallType::Call, *vm, vm->get(instruction->callee()), vm->get(instruction->this_value()), instruction->arguments(), instruction->dst(), instruction->expression_string(), instruction->strict()));
     return static_cast<i64>(pc + instruction->length());
 }
@@ -1502,6 +1584,7 @@ static ThrowCompletionOr<void> call_direct_eval(
 
 i64 asm_slow_path_call_direct_eval(VM* vm, u32 pc, Op::CallDirectEval const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     ASM_TRY(*vm, pc, call_direct_eval(*vm, vm->get(instruction->callee()), vm->get(instruction->this_value()), instruction->arguments(), instruction->dst(), instruction->expression_string(), instruction->strict()));
     return static_cast<i64>(pc + instruction->length());
 }
@@ -1567,18 +1650,21 @@ static ThrowCompletionOr<void> call_with_argument_array(
 
 i64 asm_slow_path_call_with_argument_array(VM* vm, u32 pc, Op::CallWithArgumentArray const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     ASM_TRY(*vm, pc, call_with_argument_array(Op::CallType::Call, *vm, vm->get(instruction->callee()), vm->get(instruction->this_value()), vm->get(instruction->arguments()), instruction->dst(), instruction->expression_string(), instruction->strict()));
     return static_cast<i64>(pc + sizeof(Op::CallWithArgumentArray));
 }
 
 i64 asm_slow_path_call_direct_eval_with_argument_array(VM* vm, u32 pc, Op::CallDirectEvalWithArgumentArray const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     ASM_TRY(*vm, pc, call_with_argument_array(Op::CallType::DirectEval, *vm, vm->get(instruction->callee()), vm->get(instruction->this_value()), vm->get(instruction->arguments()), instruction->dst(), instruction->expression_string(), instruction->strict()));
     return static_cast<i64>(pc + sizeof(Op::CallDirectEvalWithArgumentArray));
 }
 
 i64 asm_slow_path_get_object_property_iterator(VM* vm, u32 pc, Op::GetObjectPropertyIterator const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     auto* cache = &vm->current_executable().object_property_iterator_caches[instruction->cache()];
     vm->set(instruction->dst_iterator(), ASM_TRY(*vm, pc, asm_get_object_property_iterator(*vm, vm->get(instruction->object()), cache)));
     return static_cast<i64>(pc + sizeof(Op::GetObjectPropertyIterator));
@@ -1586,6 +1672,7 @@ i64 asm_slow_path_get_object_property_iterator(VM* vm, u32 pc, Op::GetObjectProp
 
 i64 asm_slow_path_object_property_iterator_next(VM* vm, u32 pc, Op::ObjectPropertyIteratorNext const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     auto& iterator = static_cast<PropertyNameIterator&>(vm->get(instruction->iterator_object()).as_object());
     Value value;
     bool done = false;
@@ -1598,6 +1685,7 @@ i64 asm_slow_path_object_property_iterator_next(VM* vm, u32 pc, Op::ObjectProper
 
 i64 asm_slow_path_iterator_close(VM* vm, u32 pc, Op::IteratorClose const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     auto& iterator_object = vm->get(instruction->iterator_object()).as_object();
     auto iterator_next_method = vm->get(instruction->iterator_next());
     auto iterator_done_property = vm->get(instruction->iterator_done()).as_bool();
@@ -1609,6 +1697,7 @@ i64 asm_slow_path_iterator_close(VM* vm, u32 pc, Op::IteratorClose const* instru
 
 i64 asm_slow_path_iterator_next(VM* vm, u32 pc, Op::IteratorNext const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     auto& iterator_object = vm->get(instruction->iterator_object()).as_object();
     auto iterator_next_method = vm->get(instruction->iterator_next());
     auto iterator_done_property = vm->get(instruction->iterator_done()).as_bool();
@@ -1622,6 +1711,7 @@ i64 asm_slow_path_iterator_next(VM* vm, u32 pc, Op::IteratorNext const* instruct
 
 i64 asm_slow_path_iterator_next_unpack(VM* vm, u32 pc, Op::IteratorNextUnpack const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     auto& iterator_object = vm->get(instruction->iterator_object()).as_object();
     auto iterator_next_method = vm->get(instruction->iterator_next());
     auto iterator_done_property = vm->get(instruction->iterator_done()).as_bool();
@@ -1645,6 +1735,7 @@ i64 asm_slow_path_iterator_next_unpack(VM* vm, u32 pc, Op::IteratorNextUnpack co
 
 i64 asm_slow_path_iterator_to_array(VM* vm, u32 pc, Op::IteratorToArray const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     IteratorRecordImpl iterator_record {
         .done = vm->get(instruction->iterator_done_property()).as_bool(),
         .iterator = vm->get(instruction->iterator_object()).as_object(),
@@ -1763,18 +1854,21 @@ JS_DEFINE_UNARY_GENERIC_BUILTIN_CALL_SLOW_PATH(StringPrototypeCharAt, string_pro
 
 i64 asm_slow_path_call_construct(VM* vm, u32 pc, Op::CallConstruct const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     ASM_TRY(*vm, pc, execute_asm_call(Op::CallType::Construct, *vm, vm->get(instruction->callee()), js_undefined(), instruction->arguments(), instruction->dst(), instruction->expression_string(), instruction->strict()));
     return static_cast<i64>(pc + instruction->length());
 }
 
 i64 asm_slow_path_call_construct_with_argument_array(VM* vm, u32 pc, Op::CallConstructWithArgumentArray const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     ASM_TRY(*vm, pc, call_with_argument_array(Op::CallType::Construct, *vm, vm->get(instruction->callee()), js_undefined(), vm->get(instruction->arguments()), instruction->dst(), instruction->expression_string(), instruction->strict()));
     return static_cast<i64>(pc + sizeof(Op::CallConstructWithArgumentArray));
 }
 
 i64 asm_slow_path_super_call_with_argument_array(VM* vm, u32 pc, Op::SuperCallWithArgumentArray const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
 
     auto new_target = vm->get_new_target();
     VERIFY(new_target.is_object());
@@ -1848,6 +1942,7 @@ i64 asm_slow_path_super_call_with_argument_array(VM* vm, u32 pc, Op::SuperCallWi
 
 i64 asm_slow_path_new_object(VM* vm, u32 pc, Op::NewObject const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     auto& realm = *vm->current_realm();
 
     if (instruction->cache() != NumericLimits<u32>::max()) {
@@ -1865,6 +1960,7 @@ i64 asm_slow_path_new_object(VM* vm, u32 pc, Op::NewObject const* instruction)
 
 i64 asm_slow_path_new_object_with_no_prototype(VM* vm, u32 pc, Op::NewObjectWithNoPrototype const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     auto& realm = *vm->current_realm();
     vm->set(instruction->dst(), Object::create(realm, nullptr));
     return static_cast<i64>(pc + sizeof(Op::NewObjectWithNoPrototype));
@@ -1872,6 +1968,7 @@ i64 asm_slow_path_new_object_with_no_prototype(VM* vm, u32 pc, Op::NewObjectWith
 
 i64 asm_slow_path_cache_object_shape(VM* vm, u32 pc, Op::CacheObjectShape const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     auto& cache = vm->current_executable().object_shape_caches[instruction->cache()];
     if (!cache.shape) {
         auto& object = vm->get(instruction->object()).as_object();
@@ -1883,6 +1980,7 @@ i64 asm_slow_path_cache_object_shape(VM* vm, u32 pc, Op::CacheObjectShape const*
 
 i64 asm_slow_path_init_object_literal_property(VM* vm, u32 pc, Op::InitObjectLiteralProperty const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     auto& object = vm->get(instruction->object()).as_object();
     auto value = vm->get(instruction->src());
     auto& cache = vm->current_executable().object_shape_caches[instruction->shape_cache_index()];
@@ -1910,6 +2008,7 @@ i64 asm_slow_path_init_object_literal_property(VM* vm, u32 pc, Op::InitObjectLit
 
 i64 asm_slow_path_new_array(VM* vm, u32 pc, Op::NewArray const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     auto array = MUST(JS::Array::create(vm->realm(), instruction->element_count()));
     for (size_t i = 0; i < instruction->element_count(); ++i)
         array->indexed_put(i, vm->get(instruction->elements()[i]));
@@ -1919,6 +2018,7 @@ i64 asm_slow_path_new_array(VM* vm, u32 pc, Op::NewArray const* instruction)
 
 i64 asm_slow_path_new_primitive_array(VM* vm, u32 pc, Op::NewPrimitiveArray const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     auto array = MUST(JS::Array::create(vm->realm(), instruction->element_count()));
     for (size_t i = 0; i < instruction->element_count(); ++i)
         array->indexed_put(i, instruction->elements()[i]);
@@ -1928,6 +2028,7 @@ i64 asm_slow_path_new_primitive_array(VM* vm, u32 pc, Op::NewPrimitiveArray cons
 
 i64 asm_slow_path_new_regexp(VM* vm, u32 pc, Op::NewRegExp const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     auto& realm = *vm->current_realm();
     auto regexp_object = RegExpObject::create(
         realm,
@@ -1941,6 +2042,7 @@ i64 asm_slow_path_new_regexp(VM* vm, u32 pc, Op::NewRegExp const* instruction)
 
 i64 asm_slow_path_new_reference_error(VM* vm, u32 pc, Op::NewReferenceError const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     auto& realm = *vm->current_realm();
     vm->set(instruction->dst(), ReferenceError::create(realm, vm->current_executable().get_string(instruction->error_string())));
     return static_cast<i64>(pc + sizeof(Op::NewReferenceError));
@@ -1948,6 +2050,7 @@ i64 asm_slow_path_new_reference_error(VM* vm, u32 pc, Op::NewReferenceError cons
 
 i64 asm_slow_path_new_type_error(VM* vm, u32 pc, Op::NewTypeError const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     auto& realm = *vm->current_realm();
     vm->set(instruction->dst(), TypeError::create(realm, vm->current_executable().get_string(instruction->error_string())));
     return static_cast<i64>(pc + sizeof(Op::NewTypeError));
@@ -1960,6 +2063,7 @@ i64 asm_slow_path_bitwise_xor(VM* vm, u32 pc, Op::BitwiseXor const* instruction)
 
 i64 asm_slow_path_bitwise_xor_values(VM* vm, u32 pc, Operand destination, Value lhs, Value rhs)
 {
+    record_slow_path_entry(*vm, pc);
     return finish_binary_slow_path(*vm, pc, destination, bitwise_xor(*vm, lhs, rhs));
 }
 
@@ -1970,6 +2074,7 @@ i64 asm_slow_path_bitwise_and(VM* vm, u32 pc, Op::BitwiseAnd const* instruction)
 
 i64 asm_slow_path_bitwise_and_values(VM* vm, u32 pc, Operand destination, Value lhs, Value rhs)
 {
+    record_slow_path_entry(*vm, pc);
     return finish_binary_slow_path(*vm, pc, destination, bitwise_and(*vm, lhs, rhs));
 }
 
@@ -1980,26 +2085,31 @@ i64 asm_slow_path_bitwise_or(VM* vm, u32 pc, Op::BitwiseOr const* instruction)
 
 i64 asm_slow_path_bitwise_or_values(VM* vm, u32 pc, Operand destination, Value lhs, Value rhs)
 {
+    record_slow_path_entry(*vm, pc);
     return finish_binary_slow_path(*vm, pc, destination, bitwise_or(*vm, lhs, rhs));
 }
 
 i64 asm_slow_path_left_shift_values(VM* vm, u32 pc, Operand destination, Value lhs, Value rhs)
 {
+    record_slow_path_entry(*vm, pc);
     return finish_binary_slow_path(*vm, pc, destination, left_shift(*vm, lhs, rhs));
 }
 
 i64 asm_slow_path_right_shift_values(VM* vm, u32 pc, Operand destination, Value lhs, Value rhs)
 {
+    record_slow_path_entry(*vm, pc);
     return finish_binary_slow_path(*vm, pc, destination, right_shift(*vm, lhs, rhs));
 }
 
 i64 asm_slow_path_unsigned_right_shift_values(VM* vm, u32 pc, Operand destination, Value lhs, Value rhs)
 {
+    record_slow_path_entry(*vm, pc);
     return finish_binary_slow_path(*vm, pc, destination, unsigned_right_shift(*vm, lhs, rhs));
 }
 
 i64 asm_slow_path_mod_values(VM* vm, u32 pc, Operand destination, Value lhs, Value rhs)
 {
+    record_slow_path_entry(*vm, pc);
     return finish_binary_slow_path(*vm, pc, destination, mod(*vm, lhs, rhs));
 }
 
@@ -2028,32 +2138,38 @@ static bool strictly_equals(Value lhs, Value rhs)
 
 i64 asm_slow_path_strictly_equals_values(VM* vm, u32 pc, Operand destination, Value lhs, Value rhs)
 {
+    record_slow_path_entry(*vm, pc);
     return finish_binary_slow_path_value(*vm, pc, destination, Value { strictly_equals(lhs, rhs) });
 }
 
 i64 asm_slow_path_strictly_inequals_values(VM* vm, u32 pc, Operand destination, Value lhs, Value rhs)
 {
+    record_slow_path_entry(*vm, pc);
     return finish_binary_slow_path_value(*vm, pc, destination, Value { !strictly_equals(lhs, rhs) });
 }
 
 i64 asm_slow_path_loosely_equals_values(VM* vm, u32 pc, Operand destination, Value lhs, Value rhs)
 {
+    record_slow_path_entry(*vm, pc);
     return finish_binary_slow_path(*vm, pc, destination, loosely_equals(*vm, lhs, rhs));
 }
 
 i64 asm_slow_path_loosely_inequals_values(VM* vm, u32 pc, Operand destination, Value lhs, Value rhs)
 {
+    record_slow_path_entry(*vm, pc);
     return finish_binary_slow_path(*vm, pc, destination, loosely_inequals(*vm, lhs, rhs));
 }
 
 i64 asm_slow_path_unary_minus(VM* vm, u32 pc, Op::UnaryMinus const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     vm->set(instruction->dst(), ASM_TRY(*vm, pc, unary_minus(*vm, vm->get(instruction->src()))));
     return static_cast<i64>(pc + sizeof(Op::UnaryMinus));
 }
 
 i64 asm_slow_path_to_string(VM* vm, u32 pc, Op::ToString const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     auto result = ASM_TRY(*vm, pc, vm->get(instruction->value()).to_primitive_string(*vm));
     vm->set(instruction->dst(), Value { result });
     return static_cast<i64>(pc + sizeof(Op::ToString));
@@ -2061,6 +2177,7 @@ i64 asm_slow_path_to_string(VM* vm, u32 pc, Op::ToString const* instruction)
 
 i64 asm_slow_path_to_primitive_with_string_hint(VM* vm, u32 pc, Op::ToPrimitiveWithStringHint const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     auto result = ASM_TRY(*vm, pc, vm->get(instruction->value()).to_primitive(*vm, Value::PreferredType::String));
     vm->set(instruction->dst(), result);
     return static_cast<i64>(pc + sizeof(Op::ToPrimitiveWithStringHint));
@@ -2068,6 +2185,7 @@ i64 asm_slow_path_to_primitive_with_string_hint(VM* vm, u32 pc, Op::ToPrimitiveW
 
 i64 asm_slow_path_to_object(VM* vm, u32 pc, Op::ToObject const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     auto result = ASM_TRY(*vm, pc, vm->get(instruction->value()).to_object(*vm));
     vm->set(instruction->dst(), result);
     return static_cast<i64>(pc + sizeof(Op::ToObject));
@@ -2075,6 +2193,7 @@ i64 asm_slow_path_to_object(VM* vm, u32 pc, Op::ToObject const* instruction)
 
 i64 asm_slow_path_to_length(VM* vm, u32 pc, Op::ToLength const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     auto result = ASM_TRY(*vm, pc, vm->get(instruction->value()).to_length(*vm));
     vm->set(instruction->dst(), Value { result });
     return static_cast<i64>(pc + sizeof(Op::ToLength));
@@ -2082,12 +2201,14 @@ i64 asm_slow_path_to_length(VM* vm, u32 pc, Op::ToLength const* instruction)
 
 i64 asm_slow_path_typeof(VM* vm, u32 pc, Op::Typeof const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     vm->set(instruction->dst(), vm->get(instruction->src()).typeof_(*vm));
     return static_cast<i64>(pc + sizeof(Op::Typeof));
 }
 
 i64 asm_slow_path_postfix_decrement(VM* vm, u32 pc, Op::PostfixDecrement const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     auto old_value = ASM_TRY(*vm, pc, vm->get(instruction->src()).to_numeric(*vm));
     vm->set(instruction->dst(), old_value);
     if (old_value.is_number())
@@ -2099,12 +2220,14 @@ i64 asm_slow_path_postfix_decrement(VM* vm, u32 pc, Op::PostfixDecrement const*
 
 i64 asm_slow_path_to_int32(VM* vm, u32 pc, Op::ToInt32 const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     vm->set(instruction->dst(), Value(ASM_TRY(*vm, pc, vm->get(instruction->value()).to_i32(*vm))));
     return static_cast<i64>(pc + sizeof(Op::ToInt32));
 }
 
 i64 asm_slow_path_put_by_value(VM* vm, u32 pc, Op::PutByValue const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     auto value = vm->get(instruction->src());
     auto base = vm->get(instruction->base());
     Optional<Utf16FlyString const&> base_identifier;
@@ -2118,6 +2241,7 @@ i64 asm_slow_path_put_by_value(VM* vm, u32 pc, Op::PutByValue const* instruction
 
 i64 asm_slow_path_put_by_value_with_this(VM* vm, u32 pc, Op::PutByValueWithThis const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     auto value = vm->get(instruction->src());
     auto base = vm->get(instruction->base());
     auto this_value = vm->get(instruction->this_value());
@@ -2128,6 +2252,7 @@ i64 asm_slow_path_put_by_value_with_this(VM* vm, u32 pc, Op::PutByValueWithThis
 
 i64 asm_slow_path_put_by_spread(VM* vm, u32 pc, Op::PutBySpread const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     auto value = vm->get(instruction->src());
     auto base = vm->get(instruction->base());
 
@@ -2202,7 +2327,7 @@ i64 asm_try_inline_call(VM* vm, u32 pc, Op::Call const* instruction)
 
 // Fast cache-only PutById. Tries all cache entries for ChangeOwnProperty and
 // AddOwnProperty. Returns 0 on cache hit, 1 on miss (caller should use full slow path).
-i64 asm_try_put_by_id_cache(VM* vm, u32, Op::PutById const* instruction)
+i64 asm_try_put_by_id_cache(VM* vm, u32 pc, Op::PutById const* instruction)
 {
     auto base = vm->get(instruction->base());
     if (!base.is_object()) [[unlikely]]
@@ -2210,6 +2335,7 @@ i64 asm_try_put_by_id_cache(VM* vm, u32, Op::PutById const* instruction)
     auto& object = base.as_object();
     auto value = vm->get(instruction->src());
     auto& cache = vm->current_executable().property_lookup_caches[instruction->cache()];
+    InlineCacheStatisticsScope statistics_scope { *vm, pc, cache, Statistics::SlowPathKind::CacheProbe };
 
     for (auto& entry : cache.entries()) {
         switch (entry.type) {
@@ -2254,7 +2380,7 @@ i64 asm_try_put_by_id_cache(VM* vm, u32, Op::PutById const* instruction)
 // Fast cache-only GetById. Tries all cache entries for own-property and prototype
 // chain lookups. On cache hit, writes the result to the dst operand and returns 0.
 // On miss, returns 1 (caller should use full slow path).
-i64 asm_try_get_by_id_cache(VM* vm, u32, Op::GetById const* instruction)
+i64 asm_try_get_by_id_cache(VM* vm, u32 pc, Op::GetById const* instruction)
 {
     auto base = vm->get(instruction->base());
     if (!base.is_object()) [[unlikely]]
@@ -2262,6 +2388,7 @@ i64 asm_try_get_by_id_cache(VM* vm, u32, Op::GetById const* instruction)
     auto& object = base.as_object();
     auto& shape = object.shape();
     auto& cache = vm->current_executable().property_lookup_caches[instruction->cache()];
+    InlineCacheStatisticsScope statistics_scope { *vm, pc, cache, Statistics::SlowPathKind::CacheProbe };
 
     for (auto& entry : cache.entries()) {
         if (entry.type != PropertyLookupCache::Entry::Type::GetOwnProperty
@@ -2300,12 +2427,14 @@ i64 asm_try_get_by_id_cache(VM* vm, u32, Op::GetById const* instruction)
 
 i64 asm_slow_path_get_binding(VM* vm, u32 pc, Op::GetBinding const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     auto next_pc = asm_get_binding<AsmBindingIsKnownToBeInitialized::No>(*vm, pc, instruction->dst(), instruction->cache());
     return advance_or_continue<Op::GetBinding>(pc, next_pc);
 }
 
 i64 asm_slow_path_dynamic_get_binding(VM* vm, u32 pc, Op::DynamicGetBinding const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     auto& cache = vm->current_executable().environment_coordinate_caches[instruction->cache()];
     auto next_pc = asm_dynamic_get_binding<AsmBindingIsKnownToBeInitialized::No>(*vm, pc, instruction->dst(), instruction->identifier(), instruction->strict(), cache);
     return advance_or_continue<Op::DynamicGetBinding>(pc, next_pc);
@@ -2313,54 +2442,63 @@ i64 asm_slow_path_dynamic_get_binding(VM* vm, u32 pc, Op::DynamicGetBinding cons
 
 i64 asm_slow_path_initialize_lexical_binding(VM* vm, u32 pc, Op::InitializeLexicalBinding const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     auto next_pc = asm_initialize_or_set_binding<Op::EnvironmentMode::Lexical, Op::BindingInitializationMode::Initialize>(*vm, pc, instruction->strict(), vm->get(instruction->src()), instruction->cache());
     return advance_or_continue<Op::InitializeLexicalBinding>(pc, next_pc);
 }
 
 i64 asm_slow_path_dynamic_initialize_lexical_binding(VM* vm, u32 pc, Op::DynamicInitializeLexicalBinding const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     auto next_pc = asm_dynamic_initialize_or_set_binding<Op::EnvironmentMode::Lexical, Op::BindingInitializationMode::Initialize>(*vm, pc, instruction->identifier(), instruction->strict(), vm->get(instruction->src()), vm->current_executable().environment_coordinate_caches[instruction->cache()]);
     return advance_or_continue<Op::DynamicInitializeLexicalBinding>(pc, next_pc);
 }
 
 i64 asm_slow_path_initialize_variable_binding(VM* vm, u32 pc, Op::InitializeVariableBinding const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     auto next_pc = asm_initialize_or_set_binding<Op::EnvironmentMode::Var, Op::BindingInitializationMode::Initialize>(*vm, pc, instruction->strict(), vm->get(instruction->src()), instruction->cache());
     return advance_or_continue<Op::InitializeVariableBinding>(pc, next_pc);
 }
 
 i64 asm_slow_path_dynamic_initialize_variable_binding(VM* vm, u32 pc, Op::DynamicInitializeVariableBinding const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     auto next_pc = asm_dynamic_initialize_or_set_binding<Op::EnvironmentMode::Var, Op::BindingInitializationMode::Initialize>(*vm, pc, instruction->identifier(), instruction->strict(), vm->get(instruction->src()), vm->current_executable().environment_coordinate_caches[instruction->cache()]);
     return advance_or_continue<Op::DynamicInitializeVariableBinding>(pc, next_pc);
 }
 
 i64 asm_slow_path_set_lexical_binding(VM* vm, u32 pc, Op::SetLexicalBinding const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     auto next_pc = asm_initialize_or_set_binding<Op::EnvironmentMode::Lexical, Op::BindingInitializationMode::Set>(*vm, pc, instruction->strict(), vm->get(instruction->src()), instruction->cache());
     return advance_or_continue<Op::SetLexicalBinding>(pc, next_pc);
 }
 
 i64 asm_slow_path_dynamic_set_lexical_binding(VM* vm, u32 pc, Op::DynamicSetLexicalBinding const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     auto next_pc = asm_dynamic_initialize_or_set_binding<Op::EnvironmentMode::Lexical, Op::BindingInitializationMode::Set>(*vm, pc, instruction->identifier(), instruction->strict(), vm->get(instruction->src()), vm->current_executable().environment_coordinate_caches[instruction->cache()]);
     return advance_or_continue<Op::DynamicSetLexicalBinding>(pc, next_pc);
 }
 
 i64 asm_slow_path_set_variable_binding(VM* vm, u32 pc, Op::SetVariableBinding const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     auto next_pc = asm_initialize_or_set_binding<Op::EnvironmentMode::Var, Op::BindingInitializationMode::Set>(*vm, pc, instruction->strict(), vm->get(instruction->src()), instruction->cache());
     return advance_or_continue<Op::SetVariableBinding>(pc, next_pc);
 }
 
 i64 asm_slow_path_dynamic_set_variable_binding(VM* vm, u32 pc, Op::DynamicSetVariableBinding const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     auto next_pc = asm_dynamic_initialize_or_set_binding<Op::EnvironmentMode::Var, Op::BindingInitializationMode::Set>(*vm, pc, instruction->identifier(), instruction->strict(), vm->get(instruction->src()), vm->current_executable().environment_coordinate_caches[instruction->cache()]);
     return advance_or_continue<Op::DynamicSetVariableBinding>(pc, next_pc);
 }
 
 i64 asm_slow_path_resolve_binding(VM* vm, u32 pc, Op::ResolveBinding const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     auto const& identifier = vm->get_identifier(instruction->identifier());
     auto reference = ASM_TRY(*vm, pc, vm->resolve_binding(identifier, instruction->strict()));
     if (reference.is_unresolvable()) {
@@ -2375,6 +2513,7 @@ i64 asm_slow_path_resolve_binding(VM* vm, u32 pc, Op::ResolveBinding const* inst
 
 i64 asm_slow_path_resolve_super_base(VM* vm, u32 pc, Op::ResolveSuperBase const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
 
     auto& environment = as<FunctionEnvironment>(*get_this_environment(*vm));
     VERIFY(environment.has_super_binding());
@@ -2385,6 +2524,7 @@ i64 asm_slow_path_resolve_super_base(VM* vm, u32 pc, Op::ResolveSuperBase const*
 
 i64 asm_slow_path_set_resolved_binding(VM* vm, u32 pc, Op::SetResolvedBinding const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     auto const& identifier = vm->get_identifier(instruction->identifier());
     auto environment = vm->get(instruction->environment());
     auto reference = environment.is_null()
@@ -2396,6 +2536,7 @@ i64 asm_slow_path_set_resolved_binding(VM* vm, u32 pc, Op::SetResolvedBinding co
 
 i64 asm_slow_path_typeof_binding(VM* vm, u32 pc, Op::TypeofBinding const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     VERIFY(instruction->cache().is_valid());
 
     auto const* environment = vm->running_execution_context().lexical_environment.ptr();
@@ -2409,6 +2550,7 @@ i64 asm_slow_path_typeof_binding(VM* vm, u32 pc, Op::TypeofBinding const* instru
 
 i64 asm_slow_path_dynamic_typeof_binding(VM* vm, u32 pc, Op::DynamicTypeofBinding const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     auto& cache = vm->current_executable().environment_coordinate_caches[instruction->cache()];
     auto const* current_environment = vm->running_execution_context().lexical_environment.ptr();
     if (auto const* environment = asm_get_cached_environment(current_environment, cache)) [[likely]] {
@@ -2444,6 +2586,7 @@ static Optional<StringView> asm_function_name_prefix_to_string(Op::FunctionNameP
 
 i64 asm_slow_path_has_private_id(VM* vm, u32 pc, Op::HasPrivateId const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     auto base = vm->get(instruction->base());
     if (!base.is_object()) [[unlikely]] {
         auto completion = vm->throw_completion<TypeError>(ErrorType::InOperatorWithObject);
@@ -2459,6 +2602,7 @@ i64 asm_slow_path_has_private_id(VM* vm, u32 pc, Op::HasPrivateId const* instruc
 
 i64 asm_slow_path_set_function_name(VM* vm, u32 pc, Op::SetFunctionName const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     auto function = vm->get(instruction->function()).as_if<ECMAScriptFunctionObject>();
     if (!function || !function->name().is_empty())
         return static_cast<i64>(pc + sizeof(Op::SetFunctionName));
@@ -2470,6 +2614,7 @@ i64 asm_slow_path_set_function_name(VM* vm, u32 pc, Op::SetFunctionName const* i
 
 i64 asm_slow_path_new_array_with_length(VM* vm, u32 pc, Op::NewArrayWithLength const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     auto length = static_cast<u64>(vm->get(instruction->array_length()).as_double());
     auto array = ASM_TRY(*vm, pc, JS::Array::create(vm->realm(), length));
     vm->set(instruction->dst(), array);
@@ -2478,6 +2623,7 @@ i64 asm_slow_path_new_array_with_length(VM* vm, u32 pc, Op::NewArrayWithLength c
 
 i64 asm_slow_path_array_append(VM* vm, u32 pc, Op::ArrayAppend const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     auto rhs = vm->get(instruction->src());
     auto& lhs_array = vm->get(instruction->dst()).as_array_exotic_object();
     auto lhs_size = lhs_array.indexed_array_like_size();
@@ -2500,6 +2646,7 @@ i64 asm_slow_path_array_append(VM* vm, u32 pc, Op::ArrayAppend const* instructio
 
 i64 asm_slow_path_create_variable(VM* vm, u32 pc, Op::CreateVariable const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     auto const& name = vm->get_identifier(instruction->identifier());
     ASM_TRY(*vm, pc, asm_create_variable(*vm, name, instruction->mode(), instruction->is_global(), instruction->is_immutable(), instruction->is_strict()));
     return static_cast<i64>(pc + sizeof(Op::CreateVariable));
@@ -2507,6 +2654,7 @@ i64 asm_slow_path_create_variable(VM* vm, u32 pc, Op::CreateVariable const* inst
 
 i64 asm_slow_path_enter_object_environment(VM* vm, u32 pc, Op::EnterObjectEnvironment const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     auto object = ASM_TRY(*vm, pc, vm->get(instruction->object()).to_object(*vm));
     auto& old_environment = vm->running_execution_context().lexical_environment;
     auto new_environment = new_object_environment(*object, true, old_environment);
@@ -2517,24 +2665,28 @@ i64 asm_slow_path_enter_object_environment(VM* vm, u32 pc, Op::EnterObjectEnviro
 
 i64 asm_slow_path_bitwise_not(VM* vm, u32 pc, Op::BitwiseNot const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     vm->set(instruction->dst(), ASM_TRY(*vm, pc, bitwise_not(*vm, vm->get(instruction->src()))));
     return static_cast<i64>(pc + sizeof(Op::BitwiseNot));
 }
 
 i64 asm_slow_path_unary_plus(VM* vm, u32 pc, Op::UnaryPlus const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     vm->set(instruction->dst(), ASM_TRY(*vm, pc, unary_plus(*vm, vm->get(instruction->src()))));
     return static_cast<i64>(pc + sizeof(Op::UnaryPlus));
 }
 
 i64 asm_slow_path_is_constructor(VM* vm, u32 pc, Op::IsConstructor const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     vm->set(instruction->dst(), Value(vm->get(instruction->value()).is_constructor()));
     return static_cast<i64>(pc + sizeof(Op::IsConstructor));
 }
 
 i64 asm_slow_path_add_private_name(VM* vm, u32 pc, Op::AddPrivateName const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     auto const& name = vm->get_identifier(instruction->name());
     vm->running_execution_context().private_environment->add_private_name(name);
     return static_cast<i64>(pc + sizeof(Op::AddPrivateName));
@@ -2542,6 +2694,7 @@ i64 asm_slow_path_add_private_name(VM* vm, u32 pc, Op::AddPrivateName const* ins
 
 i64 asm_slow_path_create_async_from_sync_iterator(VM* vm, u32 pc, Op::CreateAsyncFromSyncIterator const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     auto& realm = vm->realm();
 
     auto& iterator = vm->get(instruction->iterator()).as_object();
@@ -2562,6 +2715,7 @@ i64 asm_slow_path_create_async_from_sync_iterator(VM* vm, u32 pc, Op::CreateAsyn
 
 i64 asm_slow_path_create_data_property_or_throw(VM* vm, u32 pc, Op::CreateDataPropertyOrThrow const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     auto& object = vm->get(instruction->object()).as_object();
     auto property = ASM_TRY(*vm, pc, vm->get(instruction->property()).to_property_key(*vm));
     auto value = vm->get(instruction->value());
@@ -2571,6 +2725,7 @@ i64 asm_slow_path_create_data_property_or_throw(VM* vm, u32 pc, Op::CreateDataPr
 
 i64 asm_slow_path_create_immutable_binding(VM* vm, u32 pc, Op::CreateImmutableBinding const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     auto& environment = as<Environment>(vm->get(instruction->environment()).as_cell());
     ASM_TRY(*vm, pc, environment.create_immutable_binding(*vm, vm->get_identifier(instruction->identifier()), instruction->strict_binding()));
     return static_cast<i64>(pc + sizeof(Op::CreateImmutableBinding));
@@ -2578,6 +2733,7 @@ i64 asm_slow_path_create_immutable_binding(VM* vm, u32 pc, Op::CreateImmutableBi
 
 i64 asm_slow_path_create_mutable_binding(VM* vm, u32 pc, Op::CreateMutableBinding const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     auto& environment = as<Environment>(vm->get(instruction->environment()).as_cell());
     ASM_TRY(*vm, pc, environment.create_mutable_binding(*vm, vm->get_identifier(instruction->identifier()), instruction->can_be_deleted()));
     return static_cast<i64>(pc + sizeof(Op::CreateMutableBinding));
@@ -2585,6 +2741,7 @@ i64 asm_slow_path_create_mutable_binding(VM* vm, u32 pc, Op::CreateMutableBindin
 
 i64 asm_slow_path_create_rest_params(VM* vm, u32 pc, Op::CreateRestParams const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     auto const arguments = vm->running_execution_context().arguments_span();
     auto arguments_count = vm->running_execution_context().passed_argument_count;
     auto array = MUST(JS::Array::create(vm->realm(), 0));
@@ -2596,6 +2753,7 @@ i64 asm_slow_path_create_rest_params(VM* vm, u32 pc, Op::CreateRestParams const*
 
 i64 asm_slow_path_create_arguments(VM* vm, u32 pc, Op::CreateArguments const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     auto const& function = vm->running_execution_context().function;
     auto const arguments = vm->running_execution_context().arguments_span();
     auto const& environment = vm->running_execution_context().lexical_environment;
@@ -2625,6 +2783,7 @@ i64 asm_slow_path_create_arguments(VM* vm, u32 pc, Op::CreateArguments const* in
 
 i64 asm_slow_path_await(VM* vm, [[maybe_unused]] u32 pc, Op::Await const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     auto yielded_value = vm->get(instruction->argument()).is_special_empty_value() ? js_undefined() : vm->get(instruction->argument());
     auto& context = vm->running_execution_context();
     context.yield_continuation = instruction->continuation_label().address();
@@ -2636,6 +2795,7 @@ i64 asm_slow_path_await(VM* vm, [[maybe_unused]] u32 pc, Op::Await const* instru
 
 i64 asm_slow_path_create_lexical_environment(VM* vm, u32 pc, Op::CreateLexicalEnvironment const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     auto& parent = as<Environment>(vm->get(instruction->parent()).as_cell());
     auto environment = new_declarative_environment(parent);
     environment->ensure_capacity(instruction->capacity());
@@ -2647,6 +2807,7 @@ i64 asm_slow_path_create_lexical_environment(VM* vm, u32 pc, Op::CreateLexicalEn
 
 i64 asm_slow_path_create_private_environment(VM* vm, u32 pc, Op::CreatePrivateEnvironment const*)
 {
+    record_slow_path_entry(*vm, pc);
     auto& running_execution_context = vm->running_execution_context();
     auto outer_private_environment = running_execution_context.private_environment;
     running_execution_context.private_environment = new_private_environment(*vm, outer_private_environment);
@@ -2655,6 +2816,7 @@ i64 asm_slow_path_create_private_environment(VM* vm, u32 pc, Op::CreatePrivateEn
 
 i64 asm_slow_path_create_variable_environment(VM* vm, u32 pc, Op::CreateVariableEnvironment const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     auto& running_execution_context = vm->running_execution_context();
     auto var_environment = new_declarative_environment(*running_execution_context.lexical_environment);
     if (auto* shared_data = vm->active_shared_function_data(); shared_data && instruction->capacity() == shared_data->m_var_environment_bindings_count)
@@ -2667,6 +2829,7 @@ i64 asm_slow_path_create_variable_environment(VM* vm, u32 pc, Op::CreateVariable
 
 i64 asm_slow_path_delete_by_id(VM* vm, u32 pc, Op::DeleteById const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     auto const& property_key = vm->get_property_key(instruction->property());
     auto reference = Reference { vm->get(instruction->base()), property_key, {}, instruction->strict() };
     auto result = ASM_TRY(*vm, pc, reference.delete_(*vm));
@@ -2676,6 +2839,7 @@ i64 asm_slow_path_delete_by_id(VM* vm, u32 pc, Op::DeleteById const* instruction
 
 i64 asm_slow_path_delete_by_value(VM* vm, u32 pc, Op::DeleteByValue const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     auto property_key = ASM_TRY(*vm, pc, vm->get(instruction->property()).to_property_key(*vm));
     auto reference = Reference { vm->get(instruction->base()), property_key, {}, instruction->strict() };
     auto result = ASM_TRY(*vm, pc, reference.delete_(*vm));
@@ -2685,6 +2849,7 @@ i64 asm_slow_path_delete_by_value(VM* vm, u32 pc, Op::DeleteByValue const* instr
 
 i64 asm_slow_path_delete_variable(VM* vm, u32 pc, Op::DeleteVariable const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     auto const& string = vm->get_identifier(instruction->identifier());
     auto reference = ASM_TRY(*vm, pc, vm->resolve_binding(string, instruction->strict()));
     auto result = ASM_TRY(*vm, pc, reference.delete_(*vm));
@@ -2694,6 +2859,7 @@ i64 asm_slow_path_delete_variable(VM* vm, u32 pc, Op::DeleteVariable const* inst
 
 i64 asm_slow_path_get_completion_fields(VM* vm, u32 pc, Op::GetCompletionFields const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     auto& completion_source = vm->get(instruction->completion()).as_object();
     if (is<GeneratorObject>(completion_source)) {
         auto const& generator = as<GeneratorObject>(completion_source);
@@ -2710,6 +2876,7 @@ i64 asm_slow_path_get_completion_fields(VM* vm, u32 pc, Op::GetCompletionFields
 
 i64 asm_slow_path_set_completion_type(VM* vm, u32 pc, Op::SetCompletionType const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     auto& completion_source = vm->get(instruction->completion()).as_object();
     if (is<GeneratorObject>(completion_source)) {
         as<GeneratorObject>(completion_source).set_pending_completion_type(instruction->completion_type());
@@ -2722,6 +2889,7 @@ i64 asm_slow_path_set_completion_type(VM* vm, u32 pc, Op::SetCompletionType cons
 
 i64 asm_slow_path_get_template_object(VM* vm, u32 pc, Op::GetTemplateObject const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     auto& cache = *vm->current_executable().template_object_caches[instruction->cache()];
 
     if (cache.cached_template_object) {
@@ -2751,6 +2919,7 @@ i64 asm_slow_path_get_template_object(VM* vm, u32 pc, Op::GetTemplateObject cons
 
 i64 asm_slow_path_new_function(VM* vm, u32 pc, Op::NewFunction const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     auto& shared_data = *vm->current_executable().shared_function_data[instruction->shared_function_data_index()];
     auto& realm = *vm->current_realm();
 
@@ -2786,11 +2955,13 @@ i64 asm_slow_path_new_function(VM* vm, u32 pc, Op::NewFunction const* instructio
 
 i64 asm_slow_path_throw(VM* vm, u32 pc, Op::Throw const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     return handle_asm_exception(*vm, pc, vm->get(instruction->src()));
 }
 
 i64 asm_slow_path_throw_if_tdz(VM* vm, u32 pc, Op::ThrowIfTDZ const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     auto value = vm->get(instruction->src());
     if (value.is_special_empty_value()) [[unlikely]] {
         auto completion = vm->throw_completion<ReferenceError>(ErrorType::BindingNotInitialized, value);
@@ -2801,6 +2972,7 @@ i64 asm_slow_path_throw_if_tdz(VM* vm, u32 pc, Op::ThrowIfTDZ const* instruction
 
 i64 asm_slow_path_throw_if_not_object(VM* vm, u32 pc, Op::ThrowIfNotObject const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     auto src = vm->get(instruction->src());
     if (!src.is_object()) [[unlikely]] {
         auto completion = vm->throw_completion<TypeError>(ErrorType::NotAnObject, src);
@@ -2811,6 +2983,7 @@ i64 asm_slow_path_throw_if_not_object(VM* vm, u32 pc, Op::ThrowIfNotObject const
 
 i64 asm_slow_path_throw_if_nullish(VM* vm, u32 pc, Op::ThrowIfNullish const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     auto value = vm->get(instruction->src());
     if (value.is_nullish()) [[unlikely]] {
         auto completion = vm->throw_completion<TypeError>(ErrorType::NotObjectCoercible, value);
@@ -2821,12 +2994,14 @@ i64 asm_slow_path_throw_if_nullish(VM* vm, u32 pc, Op::ThrowIfNullish const* ins
 
 i64 asm_slow_path_throw_const_assignment(VM* vm, u32 pc, Op::ThrowConstAssignment const*)
 {
+    record_slow_path_entry(*vm, pc);
     auto completion = vm->throw_completion<TypeError>(ErrorType::InvalidAssignToConst);
     return handle_asm_exception(*vm, pc, completion.value());
 }
 
 i64 asm_slow_path_debugger(VM* vm, u32 pc, Op::Debugger const*)
 {
+    record_slow_path_entry(*vm, pc);
     // NB: Don't pause twice if the debugger trampoline already paused before this instruction.
     if (auto* debugger = vm->debugger(); debugger && !debugger->did_pause_before_current_instruction())
         debugger->pause_execution(vm->current_executable(), pc, Debugger::PauseReason::DebuggerStatement);
@@ -2835,6 +3010,7 @@ i64 asm_slow_path_debugger(VM* vm, u32 pc, Op::Debugger const*)
 
 i64 asm_slow_path_yield(VM* vm, [[maybe_unused]] u32 pc, Op::Yield const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     auto yielded_value = vm->get(instruction->value()).is_special_empty_value() ? js_undefined() : vm->get(instruction->value());
     auto& context = vm->running_execution_context();
     if (instruction->continuation_label().has_value())
@@ -2849,6 +3025,7 @@ i64 asm_slow_path_yield(VM* vm, [[maybe_unused]] u32 pc, Op::Yield const* instru
 
 i64 asm_slow_path_yield_iterator_result(VM* vm, [[maybe_unused]] u32 pc, Op::YieldIteratorResult const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     auto yielded_value = vm->get(instruction->value()).is_special_empty_value() ? js_undefined() : vm->get(instruction->value());
     auto& context = vm->running_execution_context();
     context.yield_continuation = instruction->continuation_label().address();
@@ -3023,6 +3200,7 @@ i64 asm_try_put_by_value_typed_array(VM* vm, u32, Op::PutByValue const* instruct
 
 i64 asm_slow_path_instance_of(VM* vm, u32 pc, Op::InstanceOf const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     auto result = ASM_TRY(*vm, pc, instance_of(*vm, vm->get(instruction->lhs()), vm->get(instruction->rhs())));
     vm->set(instruction->dst(), result);
     return static_cast<i64>(pc + sizeof(Op::InstanceOf));
@@ -3030,6 +3208,7 @@ i64 asm_slow_path_instance_of(VM* vm, u32 pc, Op::InstanceOf const* instruction)
 
 i64 asm_slow_path_in(VM* vm, u32 pc, Op::In const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     auto result = ASM_TRY(*vm, pc, in(*vm, vm->get(instruction->lhs()), vm->get(instruction->rhs())));
     vm->set(instruction->dst(), result);
     return static_cast<i64>(pc + sizeof(Op::In));
@@ -3037,6 +3216,7 @@ i64 asm_slow_path_in(VM* vm, u32 pc, Op::In const* instruction)
 
 i64 asm_slow_path_resolve_this_binding(VM* vm, u32 pc, Op::ResolveThisBinding const*)
 {
+    record_slow_path_entry(*vm, pc);
     auto& cached_this_value = vm->reg(Register::this_value());
     if (!cached_this_value.is_special_empty_value())
         return static_cast<i64>(pc + sizeof(Op::ResolveThisBinding));
@@ -3056,6 +3236,7 @@ i64 asm_slow_path_resolve_this_binding(VM* vm, u32 pc, Op::ResolveThisBinding co
 // Direct handler for GetPrivateById: bypasses Reference indirection.
 i64 asm_slow_path_get_private_by_id(VM* vm, u32 pc, Op::GetPrivateById const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     auto base_value = vm->get(instruction->base());
     auto& current_vm = *vm;
 
@@ -3080,6 +3261,7 @@ i64 asm_slow_path_get_private_by_id(VM* vm, u32 pc, Op::GetPrivateById const* in
 // Direct handler for PutPrivateById: bypasses Reference indirection.
 i64 asm_slow_path_put_private_by_id(VM* vm, u32 pc, Op::PutPrivateById const* instruction)
 {
+    record_slow_path_entry(*vm, pc);
     auto base_value = vm->get(instruction->base());
     auto& current_vm = *vm;
     auto value = vm->get(instruction->src());
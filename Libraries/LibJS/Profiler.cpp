@@ -0,0 +1,486 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/JsonArraySerializer.h>
+#include <AK/JsonObjectSerializer.h>
+#include <AK/StringBuilder.h>
+#include <LibJS/Bytecode/Executable.h>
+#include <LibJS/Profiler.h>
+#include <LibJS/Runtime/FunctionObject.h>
+#include <LibJS/Runtime/VM.h>
+
+#if !defined(AK_OS_WINDOWS)
+#    include <errno.h>
+#    include <signal.h>
+#    include <time.h>
+#endif
+
+namespace JS {
+
+// Enough for several minutes of samples at the default sampling interval.
+static constexpr size_t max_sample_count = 256 * KiB;
+static constexpr size_t max_frame_count = 1 * MiB;
+
+// Deeper stacks are truncated, keeping their innermost frames. This also bounds the stack walk if the signal ever
+// interrupts the VM at a point where the execution context chain is not well-formed.
+static constexpr size_t max_sampled_stack_depth = 1024;
+
+static Atomic<Profiler*> s_running_profiler { nullptr };
+
+Profiler::Profiler(VM& vm)
+    : m_vm(vm)
+{
+}
+
+Profiler::~Profiler()
+{
+    if (m_is_running)
+        stop();
+}
+
+bool Profiler::is_supported()
+{
+#if defined(AK_OS_WINDOWS)
+    return false;
+#else
+    return true;
+#endif
+}
+
+#if defined(AK_OS_WINDOWS)
+
+ErrorOr<void> Profiler::start(AK::Duration)
+{
+    return Error::from_string_literal("Sampling profiling is not supported on this platform");
+}
+
+void Profiler::stop()
+{
+}
+
+void Profiler::handle_sampling_signal(int)
+{
+}
+
+void* Profiler::sampling_thread_main(void*)
+{
+    return nullptr;
+}
+
+void Profiler::take_sample()
+{
+}
+
+#else
+
+static ErrorOr<void> install_sampling_signal_handler(void (*handler)(int))
+{
+    // The handler stays installed once the first profiler has started. It does nothing while no profiler is running,
+    // so there's no need to worry about a signal still being in flight when a profiler stops.
+    static bool s_installed = false;
+    if (s_installed)
+        return {};
+
+    struct sigaction action {};
+    action.sa_handler = handler;
+    action.sa_flags = SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    if (sigaction(SIGPROF, &action, nullptr) < 0)
+        return Error::from_errno(errno);
+
+    s_installed = true;
+    return {};
+}
+
+ErrorOr<void> Profiler::start(AK::Duration sampling_interval)
+{
+    VERIFY(!m_is_running);
+
+    if (sampling_interval <= AK::Duration::zero())
+        return Error::from_string_literal("The sampling interval must be positive");
+
+    Profiler* expected_profiler = nullptr;
+    if (!s_running_profiler.compare_exchange_strong(expected_profiler, this))
+        return Error::from_string_literal("Another profiler is already running");
+
+    auto result = [&]() -> ErrorOr<void> {
+        TRY(install_sampling_signal_handler(handle_sampling_signal));
+
+        m_frames.clear_with_capacity();
+        m_samples.clear_with_capacity();
+        m_dropped_sample_count = 0;
+
+        TRY(m_frames.try_ensure_capacity(max_frame_count));
+        TRY(m_samples.try_ensure_capacity(max_sample_count));
+
+        m_sampling_interval = sampling_interval;
+        m_sampled_thread = pthread_self();
+        m_should_stop_sampling.store(false);
+        m_start_time_in_nanoseconds = MonotonicTime::now().nanoseconds();
+        m_is_running = true;
+
+        if (auto rc = pthread_create(&m_sampling_thread, nullptr, sampling_thread_main, this); rc != 0) {
+            m_is_running = false;
+            return Error::from_errno(rc);
+        }
+        return {};
+    }();
+
+    if (result.is_error())
+        s_running_profiler.store(nullptr);
+    return result;
+}
+
+void Profiler::stop()
+{
+    VERIFY(m_is_running);
+
+    // Samples taken from here on are ignored by the signal handler.
+    s_running_profiler.store(nullptr);
+
+    m_should_stop_sampling.store(true);
+    pthread_join(m_sampling_thread, nullptr);
+
+    m_end_time_in_nanoseconds = MonotonicTime::now().nanoseconds();
+    m_is_running = false;
+}
+
+void Profiler::handle_sampling_signal(int)
+{
+    auto saved_errno = errno;
+    if (auto* profiler = s_running_profiler.load())
+        profiler->take_sample();
+    errno = saved_errno;
+}
+
+void* Profiler::sampling_thread_main(void* argument)
+{
+    auto& profiler = *static_cast<Profiler*>(argument);
+    auto interval = profiler.m_sampling_interval.to_timespec();
+
+    while (!profiler.m_should_stop_sampling.load()) {
+        nanosleep(&interval, nullptr);
+        if (profiler.m_should_stop_sampling.load())
+            break;
+        pthread_kill(profiler.m_sampled_thread, SIGPROF);
+    }
+    return nullptr;
+}
+
+// NB: This runs in a signal handler on the VM's thread, so it must not allocate, lock or touch the GC heap.
+void Profiler::take_sample()
+{
+    if (m_samples.size() == m_samples.capacity()) {
+        ++m_dropped_sample_count;
+        return;
+    }
+
+    // The signal may have interrupted the VM while it was pushing or popping an execution context, possibly with the
+    // stack's storage halfway through a reallocation. Rather than reading memory that may be freed, drop the sample.
+    // Otherwise, the VM stays suspended until the handler returns, so the stack can't change while it is walked.
+    if (m_vm.is_changing_execution_context_stack()) {
+        ++m_dropped_sample_count;
+        return;
+    }
+
+    auto const& stack = m_vm.m_execution_context_stack;
+    auto const& previous_running_contexts = m_vm.m_execution_context_stack_previous_running_contexts;
+
+    auto first_frame = m_frames.size();
+    bool ran_out_of_frame_storage = false;
+    auto record_frame = [&](ExecutionContext const& context) {
+        if (!context.executable && !context.function)
+            return true;
+        if (m_frames.size() == m_frames.capacity()) {
+            ran_out_of_frame_storage = true;
+            return false;
+        }
+        // NB: The interpreter keeps the program counter of the running frame in a register, and only stores it to
+        //     the execution context when calling out of the frame. For the innermost frame, this is the position of
+        //     its last call or slow path, which is good enough to attribute time to a function and roughly to a line.
+        m_frames.unchecked_append({ context.executable, context.function, context.program_counter });
+        return true;
+    };
+
+    auto stack_index = stack.size();
+    auto* context = m_vm.m_running_execution_context;
+
+    for (size_t depth = 0; context && depth < max_sampled_stack_depth; ++depth) {
+        if (!record_frame(*context))
+            break;
+        if (stack_index > 0 && context == stack[stack_index - 1]) {
+            context = previous_running_contexts[stack_index - 1];
+            --stack_index;
+            continue;
+        }
+        context = context->caller_frame;
+    }
+
+    if (ran_out_of_frame_storage) {
+        m_frames.shrink(first_frame, true);
+        ++m_dropped_sample_count;
+        return;
+    }
+
+    m_samples.unchecked_append({
+        .time_in_nanoseconds = MonotonicTime::now().nanoseconds(),
+        .first_frame = static_cast<u32>(first_frame),
+        .frame_count = static_cast<u32>(m_frames.size() - first_frame),
+    });
+}
+
+#endif
+
+void Profiler::gather_roots(HashMap<GC::Cell*, GC::HeapRoot>& roots) const
+{
+    // Sampled frames are only symbolicated when the profile is exported, so the executables and functions they
+    // refer to have to stay alive until then.
+    for (auto const& frame : m_frames) {
+        if (frame.executable)
+            roots.set(frame.executable.ptr(), GC::HeapRoot { .type = GC::HeapRoot::Type::VM });
+        if (frame.function)
+            roots.set(frame.function.ptr(), GC::HeapRoot { .type = GC::HeapRoot::Type::VM });
+    }
+}
+
+struct Profiler::CallTree {
+    struct Node {
+        Optional<size_t> parent;
+        Optional<SampledFrame> frame;
+        HashMap<FlatPtr, size_t> children_by_key;
+        Vector<size_t> children;
+        u32 hit_count { 0 };
+        HashMap<u32, u32> hit_count_by_line;
+    };
+
+    Vector<Node> nodes;
+    Vector<size_t> sample_leaf_nodes;
+};
+
+// Frames of the same function share a node, regardless of where in the function they were sampled.
+static FlatPtr call_tree_key(Optional<Profiler::SampledFrame> const& frame)
+{
+    if (!frame.has_value())
+        return 0;
+    if (frame->executable)
+        return bit_cast<FlatPtr>(frame->executable.ptr());
+    return bit_cast<FlatPtr>(frame->function.ptr());
+}
+
+Profiler::CallTree Profiler::build_call_tree() const
+{
+    CallTree tree;
+    tree.nodes.append({});
+
+    auto child_of = [&](size_t parent, Optional<SampledFrame> const& frame) {
+        auto key = call_tree_key(frame);
+        if (auto child = tree.nodes[parent].children_by_key.get(key); child.has_value())
+            return *child;
+
+        auto child = tree.nodes.size();
+        tree.nodes.append({ .parent = parent, .frame = frame });
+        tree.nodes[parent].children_by_key.set(key, child);
+        tree.nodes[parent].children.append(child);
+        return child;
+    };
+
+    tree.sample_leaf_nodes.ensure_capacity(m_samples.size());
+
+    for (auto const& sample : m_samples) {
+        size_t node = 0;
+
+        // A sample with no frames was taken while no JavaScript was running.
+        if (sample.frame_count == 0)
+            node = child_of(node, {});
+
+        for (size_t i = sample.frame_count; i-- > 0;)
+            node = child_of(node, m_frames[sample.first_frame + i]);
+
+        auto& leaf = tree.nodes[node];
+        ++leaf.hit_count;
+        if (sample.frame_count > 0) {
+            auto const& innermost_frame = m_frames[sample.first_frame];
+            if (innermost_frame.executable) {
+                if (auto source_range = innermost_frame.executable->source_range_at(innermost_frame.program_counter); source_range.has_value())
+                    ++leaf.hit_count_by_line.ensure(source_range->start.line);
+            }
+        }
+
+        tree.sample_leaf_nodes.unchecked_append(node);
+    }
+
+    return tree;
+}
+
+namespace {
+
+struct FrameDescription {
+    Utf16String function_name;
+    Utf16String url;
+    Optional<Position> position;
+};
+
+}
+
+static FrameDescription describe_frame(Optional<Profiler::SampledFrame> const& frame)
+{
+    if (!frame.has_value())
+        return { .function_name = "(idle)"_utf16 };
+
+    FrameDescription description;
+
+    if (frame->function)
+        description.function_name = frame->function->name_for_call_stack();
+    if (description.function_name.is_empty())
+        description.function_name = frame->function ? "(anonymous)"_utf16 : "(top-level)"_utf16;
+
+    if (frame->executable) {
+        description.url = frame->executable->source_code->filename();
+
+        // The first position with a line number is where the function's code begins.
+        for (auto const& entry : frame->executable->source_map) {
+            if (entry.line > 0) {
+                description.position = Position { .line = entry.line, .column = entry.column };
+                break;
+            }
+        }
+    }
+
+    return description;
+}
+
+ErrorOr<String> Profiler::to_collapsed_stacks() const
+{
+    auto tree = build_call_tree();
+
+    Vector<Utf16String> labels;
+    labels.ensure_capacity(tree.nodes.size());
+    for (auto const& node : tree.nodes) {
+        if (!node.parent.has_value()) {
+            labels.unchecked_append({});
+            continue;
+        }
+
+        auto description = describe_frame(node.frame);
+        Utf16String label;
+        if (description.position.has_value())
+            label = Utf16String::formatted("{} ({}:{})", description.function_name, description.url, description.position->line);
+        else
+            label = move(description.function_name);
+
+        // Semicolons separate frames in the collapsed format.
+        labels.unchecked_append(label.replace(u';', ":"sv, ReplaceMode::All));
+    }
+
+    StringBuilder builder;
+    Vector<size_t> path;
+
+    for (size_t i = 1; i < tree.nodes.size(); ++i) {
+        auto const& node = tree.nodes[i];
+        if (node.hit_count == 0)
+            continue;
+
+        path.clear_with_capacity();
+        for (Optional<size_t> ancestor = i; ancestor.has_value() && *ancestor != 0; ancestor = tree.nodes[*ancestor].parent)
+            path.append(*ancestor);
+
+        for (size_t j = path.size(); j-- > 0;) {
+            builder.append(labels[path[j]].utf16_view());
+            if (j > 0)
+                builder.append(';');
+        }
+        builder.appendff(" {}\n", node.hit_count);
+    }
+
+    return builder.to_string();
+}
+
+ErrorOr<String> Profiler::to_cpu_profile_json() const
+{
+    auto tree = build_call_tree();
+
+    HashMap<Utf16String, u32> script_ids;
+    auto script_id_for = [&](Utf16String const& url) -> u32 {
+        if (url.is_empty())
+            return 0;
+        return script_ids.ensure(url, [&] { return static_cast<u32>(script_ids.size() + 1); });
+    };
+
+    StringBuilder builder;
+    auto profile = TRY(JsonObjectSerializer<>::try_create(builder));
+
+    auto nodes = TRY(profile.add_array("nodes"sv));
+    for (size_t i = 0; i < tree.nodes.size(); ++i) {
+        auto const& node = tree.nodes[i];
+
+        auto node_object = TRY(nodes.add_object());
+        TRY(node_object.add("id"sv, i + 1));
+
+        auto call_frame = TRY(node_object.add_object("callFrame"sv));
+        if (!node.parent.has_value()) {
+            TRY(call_frame.add("functionName"sv, "(root)"sv));
+            TRY(call_frame.add("scriptId"sv, "0"sv));
+            TRY(call_frame.add("url"sv, ""sv));
+            TRY(call_frame.add("lineNumber"sv, -1));
+            TRY(call_frame.add("columnNumber"sv, -1));
+        } else {
+            auto description = describe_frame(node.frame);
+            TRY(call_frame.add("functionName"sv, description.function_name.to_well_formed_utf8()));
+            TRY(call_frame.add("scriptId"sv, String::number(script_id_for(description.url))));
+            TRY(call_frame.add("url"sv, description.url.to_well_formed_utf8()));
+
+            // The format's line and column numbers are zero-based.
+            auto line = description.position.has_value() ? static_cast<i64>(description.position->line) - 1 : -1;
+            auto column = description.position.has_value() ? static_cast<i64>(description.position->column) - 1 : -1;
+            TRY(call_frame.add("lineNumber"sv, line));
+            TRY(call_frame.add("columnNumber"sv, column));
+        }
+        TRY(call_frame.finish());
+
+        TRY(node_object.add("hitCount"sv, node.hit_count));
+
+        auto children = TRY(node_object.add_array("children"sv));
+        for (auto child : node.children)
+            TRY(children.add(child + 1));
+        TRY(children.finish());
+
+        if (!node.hit_count_by_line.is_empty()) {
+            auto position_ticks = TRY(node_object.add_array("positionTicks"sv));
+            for (auto const& [line, ticks] : node.hit_count_by_line) {
+                auto position_tick = TRY(position_ticks.add_object());
+                TRY(position_tick.add("line"sv, line));
+                TRY(position_tick.add("ticks"sv, ticks));
+                TRY(position_tick.finish());
+            }
+            TRY(position_ticks.finish());
+        }
+
+        TRY(node_object.finish());
+    }
+    TRY(nodes.finish());
+
+    auto end_time_in_nanoseconds = m_is_running ? MonotonicTime::now().nanoseconds() : m_end_time_in_nanoseconds;
+    TRY(profile.add("startTime"sv, m_start_time_in_nanoseconds / 1000));
+    TRY(profile.add("endTime"sv, end_time_in_nanoseconds / 1000));
+
+    auto samples = TRY(profile.add_array("samples"sv));
+    for (auto leaf : tree.sample_leaf_nodes)
+        TRY(samples.add(leaf + 1));
+    TRY(samples.finish());
+
+    auto time_deltas = TRY(profile.add_array("timeDeltas"sv));
+    auto previous_time_in_nanoseconds = m_start_time_in_nanoseconds;
+    for (auto const& sample : m_samples) {
+        TRY(time_deltas.add((sample.time_in_nanoseconds - previous_time_in_nanoseconds) / 1000));
+        previous_time_in_nanoseconds = sample.time_in_nanoseconds;
+    }
+    TRY(time_deltas.finish());
+
+    TRY(profile.finish());
+    return builder.to_string();
+}
+
+}
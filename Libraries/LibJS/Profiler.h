@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Atomic.h>
+#include <AK/Error.h>
+#include <AK/HashMap.h>
+#include <AK/Noncopyable.h>
+#include <AK/String.h>
+#include <AK/Time.h>
+#include <AK/Vector.h>
+#include <LibGC/Heap.h>
+#include <LibGC/Ptr.h>
+#include <LibJS/Export.h>
+#include <LibJS/Forward.h>
+
+#if !defined(AK_OS_WINDOWS)
+#    include <pthread.h>
+#endif
+
+namespace JS {
+
+// A sampling CPU profiler for JavaScript. While running, a helper thread periodically interrupts the thread the VM runs
+// on with a signal, and the signal handler records the VM's execution context stack. Recording a sample neither
+// allocates nor takes locks; all of the symbolication happens when a profile is exported.
+class JS_API Profiler {
+    AK_MAKE_NONCOPYABLE(Profiler);
+    AK_MAKE_NONMOVABLE(Profiler);
+
+public:
+    static constexpr AK::Duration default_sampling_interval = AK::Duration::from_milliseconds(1);
+
+    struct SampledFrame {
+        GC::RawPtr<Bytecode::Executable> executable;
+        GC::RawPtr<FunctionObject> function;
+        u32 program_counter { 0 };
+    };
+
+    explicit Profiler(VM&);
+    ~Profiler();
+
+    static bool is_supported();
+
+    // NB: Must be called on the thread the VM runs on, which is the thread that will be sampled. Only one profiler
+    //     may be running in a process at a time.
+    ErrorOr<void> start(AK::Duration sampling_interval = default_sampling_interval);
+    void stop();
+    bool is_running() const { return m_is_running; }
+
+    size_t sample_count() const { return m_samples.size(); }
+    size_t dropped_sample_count() const { return m_dropped_sample_count; }
+
+    // Folded stacks, as consumed by flamegraph.pl, speedscope and friends: one line per distinct stack, with the
+    // outermost frame first, followed by the number of samples that hit it.
+    ErrorOr<String> to_collapsed_stacks() const;
+
+    // The .cpuprofile format used by the Chrome DevTools Performance panel and console.profile() in other engines.
+    ErrorOr<String> to_cpu_profile_json() const;
+
+    void gather_roots(HashMap<GC::Cell*, GC::HeapRoot>&) const;
+
+private:
+    struct Sample {
+        i64 time_in_nanoseconds { 0 };
+        u32 first_frame { 0 };
+        u32 frame_count { 0 };
+    };
+
+    struct CallTree;
+    CallTree build_call_tree() const;
+
+    static void handle_sampling_signal(int);
+    static void* sampling_thread_main(void*);
+    void take_sample();
+
+    VM& m_vm;
+
+    Vector<SampledFrame> m_frames;
+    Vector<Sample> m_samples;
+    size_t m_dropped_sample_count { 0 };
+
+    AK::Duration m_sampling_interval { default_sampling_interval };
+    i64 m_start_time_in_nanoseconds { 0 };
+    i64 m_end_time_in_nanoseconds { 0 };
+
+    bool m_is_running { false };
+
+#if !defined(AK_OS_WINDOWS)
+    Atomic<bool> m_should_stop_sampling { false };
+    pthread_t m_sampled_thread {};
+    pthread_t m_sampling_thread {};
+#endif
+};
+
+}
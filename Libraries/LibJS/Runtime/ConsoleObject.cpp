@@ -58,6 +58,8 @@ void ConsoleObject::initialize(Realm& realm)
     define_native_function(realm, vm.names.time, time, 0, attr);
     define_native_function(realm, vm.names.timeLog, time_log, 0, attr);
     define_native_function(realm, vm.names.timeEnd, time_end, 0, attr);
+    define_native_function(realm, vm.names.profile, profile, 0, attr);
+    define_native_function(realm, vm.names.profileEnd, profile_end, 0, attr);
 
     define_direct_property(vm.well_known_symbol_to_string_tag(), PrimitiveString::create(vm, "console"_utf16_fly_string), Attribute::Configurable);
 }
@@ -195,4 +197,16 @@ JS_DEFINE_NATIVE_FUNCTION(ConsoleObject::time_end)
     return console_object.console().time_end();
 }
 
+JS_DEFINE_NATIVE_FUNCTION(ConsoleObject::profile)
+{
+    auto& console_object = *vm.current_realm()->intrinsics().console_object();
+    return console_object.console().profile();
+}
+
+JS_DEFINE_NATIVE_FUNCTION(ConsoleObject::profile_end)
+{
+    auto& console_object = *vm.current_realm()->intrinsics().console_object();
+    return console_object.console().profile_end();
+}
+
 }
@@ -43,6 +43,8 @@ private:
     JS_DECLARE_NATIVE_FUNCTION(time);
     JS_DECLARE_NATIVE_FUNCTION(time_log);
     JS_DECLARE_NATIVE_FUNCTION(time_end);
+    JS_DECLARE_NATIVE_FUNCTION(profile);
+    JS_DECLARE_NATIVE_FUNCTION(profile_end);
 
     GC::Ptr<Console> m_console;
 };
@@ -19,7 +19,9 @@
 #include <LibGC/Heap.h>
 #include <LibGC/PrimitiveStorage.h>
 #include <LibJS/Bytecode/Executable.h>
+#include <LibJS/Bytecode/Statistics.h>
 #include <LibJS/Debugger.h>
+#include <LibJS/Profiler.h>
 #include <LibJS/Runtime/AbstractOperations.h>
 #include <LibJS/Runtime/Array.h>
 #include <LibJS/Runtime/ArrayBuffer.h>
@@ -89,6 +91,9 @@ VM::VM(ErrorMessages error_messages)
     m_primitive_storage_cage_base = js_primitive_storage_cage_base;
     VERIFY(m_primitive_storage_cage_base != 0);
 
+    if constexpr (Bytecode::Statistics::is_enabled())
+        m_bytecode_statistics = &Bytecode::Statistics::the();
+
     m_heap.register_sweep_callback([] {
         Bytecode::StaticPropertyLookupCache::sweep_all();
     });
@@ -262,6 +267,17 @@ void VM::disable_debugging()
     m_debugger = nullptr;
 }
 
+void VM::enable_profiling()
+{
+    if (!m_profiler)
+        m_profiler = make<Profiler>(*this);
+}
+
+void VM::disable_profiling()
+{
+    m_profiler = nullptr;
+}
+
 SharedFunctionInstanceData* VM::active_shared_function_data()
 {
     auto* function = active_function_object();
@@ -355,6 +371,9 @@ void VM::gather_roots(HashMap<GC::Cell*, GC::HeapRoot>& roots)
 
     for (auto& job : m_promise_jobs)
         roots.set(job, GC::HeapRoot { .type = GC::HeapRoot::Type::VM });
+
+    if (m_profiler)
+        m_profiler->gather_roots(roots);
 }
 
 // 9.1.2.1 GetIdentifierReference ( env, name, strict ), https://tc39.es/ecma262/#sec-getidentifierreference
@@ -569,27 +588,33 @@ void VM::dump_backtrace() const
 
 void VM::save_execution_context_stack()
 {
+    begin_execution_context_stack_change();
     m_saved_execution_context_stacks.append({
         .stack = move(m_execution_context_stack),
         .previous_running_contexts = move(m_execution_context_stack_previous_running_contexts),
         .running_execution_context = m_running_execution_context,
     });
     m_running_execution_context = nullptr;
+    end_execution_context_stack_change();
 }
 
 void VM::clear_execution_context_stack()
 {
+    begin_execution_context_stack_change();
     m_execution_context_stack.clear_with_capacity();
     m_execution_context_stack_previous_running_contexts.clear_with_capacity();
     m_running_execution_context = nullptr;
+    end_execution_context_stack_change();
 }
 
 void VM::restore_execution_context_stack()
 {
+    begin_execution_context_stack_change();
     auto saved_stack = m_saved_execution_context_stacks.take_last();
     m_execution_context_stack = move(saved_stack.stack);
     m_execution_context_stack_previous_running_contexts = move(saved_stack.previous_running_contexts);
     m_running_execution_context = saved_stack.running_execution_context;
+    end_execution_context_stack_change();
 }
 
 ExecutionContext* VM::previous_execution_context() const
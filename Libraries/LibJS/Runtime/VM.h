@@ -9,6 +9,7 @@
 
 #pragma once
 
+#include <AK/Atomic.h>
 #include <AK/FlyString.h>
 #include <AK/Function.h>
 #include <AK/HashMap.h>
@@ -142,6 +143,11 @@ public:
     [[nodiscard]] Debugger* debugger() { return m_debugger; }
     [[nodiscard]] Debugger const* debugger() const { return m_debugger; }
 
+    void enable_profiling();
+    void disable_profiling();
+    [[nodiscard]] Profiler* profiler() { return m_profiler; }
+    [[nodiscard]] Profiler const* profiler() const { return m_profiler; }
+
     enum class HandleExceptionResponse {
         ExitFromExecutable,
         ContinueInThisExecutable,
@@ -221,9 +227,11 @@ public:
         context.caller_return_pc = 0;
         context.caller_dst_raw = 0;
         context.caller_is_construct = false;
+        begin_execution_context_stack_change();
         m_execution_context_stack.append(&context);
         m_execution_context_stack_previous_running_contexts.append(m_running_execution_context);
         m_running_execution_context = &context;
+        end_execution_context_stack_change();
         return {};
     }
 
@@ -233,20 +241,24 @@ public:
         context.caller_return_pc = 0;
         context.caller_dst_raw = 0;
         context.caller_is_construct = false;
+        begin_execution_context_stack_change();
         m_execution_context_stack.append(&context);
         m_execution_context_stack_previous_running_contexts.append(m_running_execution_context);
         m_running_execution_context = &context;
+        end_execution_context_stack_change();
     }
 
     ExecutionContext* pop_execution_context()
     {
         VERIFY(!m_execution_context_stack.is_empty());
+        begin_execution_context_stack_change();
         auto* context = m_execution_context_stack.take_last();
         context->caller_frame = nullptr;
         context->caller_return_pc = 0;
         context->caller_dst_raw = 0;
         context->caller_is_construct = false;
         m_running_execution_context = m_execution_context_stack_previous_running_contexts.take_last();
+        end_execution_context_stack_change();
         return context;
     }
 
@@ -460,6 +472,24 @@ public:
     [[nodiscard]] Vector<StackTraceElement> stack_trace() const;
 
 private:
+    // NB: The profiler walks the execution context stack from a signal handler, where the usual accessors and their
+    //     assertions can't be used.
+    friend class Profiler;
+
+    // NB: The profiler's signal handler may interrupt this thread anywhere, including in the middle of a change to the
+    //     execution context stack that reallocates its storage. The change count is odd for as long as that is the case.
+    void begin_execution_context_stack_change()
+    {
+        m_execution_context_stack_change_count.store(m_execution_context_stack_change_count.load() + 1);
+        AK::atomic_signal_fence(AK::MemoryOrder::memory_order_seq_cst);
+    }
+    void end_execution_context_stack_change()
+    {
+        AK::atomic_signal_fence(AK::MemoryOrder::memory_order_seq_cst);
+        m_execution_context_stack_change_count.store(m_execution_context_stack_change_count.load() + 1);
+    }
+    bool is_changing_execution_context_stack() const { return m_execution_context_stack_change_count.load() & 1; }
+
     using ErrorMessages = AK::Array<Utf16String, to_underlying(ErrorMessage::__Count)>;
 
     struct WellKnownSymbols {
@@ -539,6 +569,7 @@ private:
     // walk the full active stack without relying on caller_frame there.
     Vector<ExecutionContext*> m_execution_context_stack_previous_running_contexts;
     ExecutionContext* m_running_execution_context { nullptr };
+    Atomic<u32, AK::MemoryOrder::memory_order_relaxed> m_execution_context_stack_change_count { 0 };
 
     Vector<SavedExecutionContextStack> m_saved_execution_context_stacks;
 
@@ -578,6 +609,11 @@ private:
     u64 m_module_async_evaluation_count { 0 }; // [[ModuleAsyncEvaluationCount]]
 
     OwnPtr<Debugger> m_debugger;
+    OwnPtr<Profiler> m_profiler;
+
+    // NB: Only set in builds with JS_BYTECODE_STATISTICS_DEBUG, where the asm interpreter checks this instead of
+    //     m_debugger when choosing its dispatch table, so that every instruction goes through the counting trampoline.
+    Bytecode::Statistics* m_bytecode_statistics { nullptr };
     OwnPtr<Agent> m_agent;
 
     bool m_dynamic_imports_allowed { false };
@@ -407,6 +407,53 @@ static constexpr u64 trace_missing = NumericLimits<u64>::max();
 #define LOAD_ADDRESSES() auto addresses = addresses_ptr[short_ip.current_ip_value]
 
 void BytecodeInterpreter::interpret(Configuration& configuration)
+{
+    interpret_frame(configuration);
+    if (m_pending_tail_call.has_value()) [[unlikely]]
+        run_pending_tail_calls(configuration);
+}
+
+void BytecodeInterpreter::run_pending_tail_calls(Configuration& configuration)
+{
+    while (m_pending_tail_call.has_value()) {
+        auto [address, arguments] = m_pending_tail_call.release_value();
+
+        // Like return_call, drop the labels of the frame that's being replaced; frames set up by compiled callers don't push any.
+        if (configuration.frame().owns_locals())
+            configuration.label_stack().shrink(configuration.frame().label_index(), true);
+
+        auto prepare_result = configuration.prepare_call(address, arguments, true);
+        if (prepare_result.is_error()) {
+            m_trap = prepare_result.release_error();
+            return;
+        }
+
+        if (prepare_result.value().has_value()) {
+            // Host functions don't replace the frame, their results simply become its results.
+            auto result = prepare_result.value()->function()(configuration, arguments);
+            configuration.release_arguments_allocation(arguments);
+            if (result.is_trap()) {
+                m_trap = move(result.trap());
+                return;
+            }
+            if (result.values().size() == 1) {
+                configuration.value_stack().append(result.values().first());
+            } else {
+                configuration.value_stack().ensure_capacity(configuration.value_stack().size() + result.values().size());
+                for (auto& entry : result.values().in_reverse())
+                    configuration.value_stack().unchecked_append(entry);
+            }
+            return;
+        }
+
+        // prepare_call() unwound the replaced frame, but the new one will be unwound by whoever set up the old one.
+        configuration.depth()++;
+        configuration.ip() = 0;
+        interpret_frame(configuration);
+    }
+}
+
+void BytecodeInterpreter::interpret_frame(Configuration& configuration)
 {
     m_trap = Empty {};
     auto& expression = configuration.frame().expression();
@@ -6967,6 +7014,13 @@ CompiledInstructions try_compile_instructions(Expression const& expression, Span
             // we can't zero reference-typed locals without potentially dropping a live reference, so reject those callees.
             if (local.type().is_reference())
                 return nullptr;
+            // Cranelift only knows the types of the caller's own locals, and would treat inlined v128 locals as 64-bit ones.
+            if (local.type().kind() == ValueType::V128)
+                return nullptr;
+        }
+        for (auto const& type : functions[func_index].parameters()) {
+            if (type.kind() == ValueType::V128)
+                return nullptr;
         }
         for (auto& gi : callee->body().instructions()) {
             if (first_is_one_of(gi.opcode(),
@@ -103,6 +103,16 @@ struct WASM_API BytecodeInterpreter final : public Interpreter {
     Outcome call_address(Configuration&, FunctionAddress, SourcesAndDestination const&, CallAddressSource = CallAddressSource::DirectCall, CallType = CallType::UsingStack);
     Outcome run_compiled_function_direct(Configuration&);
     Outcome run_native_entry(Configuration&);
+
+    // Compiled code can't replace its own frame, so its tail calls only record the callee here and return.
+    // Whoever entered the compiled code then makes the call in place of the returning frame.
+    ALWAYS_INLINE bool has_pending_tail_call() const { return m_pending_tail_call.has_value(); }
+    void set_pending_tail_call(FunctionAddress address, Vector<Value, ArgumentsStaticSize> arguments)
+    {
+        m_pending_tail_call = PendingTailCall { address, move(arguments) };
+    }
+    void run_pending_tail_calls(Configuration&);
+
     bool trap_if_insufficient_native_stack_space(size_t minimum_native_stack_space_to_keep_free = 2 * MiB);
 
     template<typename T>
@@ -149,7 +159,15 @@ struct WASM_API BytecodeInterpreter final : public Interpreter {
     }
 
 protected:
+    void interpret_frame(Configuration&);
+
+    struct PendingTailCall {
+        FunctionAddress address;
+        Vector<Value, ArgumentsStaticSize> arguments;
+    };
+
     Variant<Trap, Empty> m_trap;
+    Optional<PendingTailCall> m_pending_tail_call;
     StackInfo const& m_stack_info;
 };
 
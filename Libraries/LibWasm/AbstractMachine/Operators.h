@@ -762,8 +762,8 @@ struct VectorMultiplySub {
         auto a = bit_cast<VectorInput>(a1);
         auto b = bit_cast<VectorInput>(a2);
         auto c = bit_cast<VectorInput>(a3);
-        // Spec talks about rounding and such, but v8's arm impl just does vmul + vsub with nothing in between.
-        return bit_cast<u128>(a * b - c);
+        // relaxed_nmadd is -(a * b) + c; as with madd, v8's arm impl just does vmul + vsub with nothing in between.
+        return bit_cast<u128>(c - a * b);
     }
 };
 
@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/ScopeGuard.h>
+#include <AK/Time.h>
+#include <LibThreading/Thread.h>
+#include <LibWasm/AbstractMachine/StreamingCompiler.h>
+
+namespace Wasm {
+
+// Every batch spawns a compiler process, so keep them large enough for that to be noise.
+static constexpr size_t streaming_batch_dispatch_count = 32 * KiB;
+
+StreamingCompiler::StreamingCompiler()
+    : m_work_queue(adopt_ref(*new WorkQueue))
+{
+    // Anyone trying to instantiate the module will wait for the worker instead of compiling it again.
+    auto has_begun_compilation = m_parser.module().try_begin_cranelift_compilation();
+    VERIFY(has_begun_compilation);
+
+    auto thread = Threading::Thread::construct("Wasm/Streaming"sv, [module = NonnullRefPtr { m_parser.module() }, work_queue = m_work_queue]() -> intptr_t {
+        compile_pending_functions(*module, *work_queue);
+        return 0;
+    });
+    thread->start();
+    thread->detach();
+}
+
+StreamingCompiler::~StreamingCompiler()
+{
+    if (m_is_finished)
+        return;
+
+    Sync::MutexLocker locker(m_work_queue->mutex);
+    m_work_queue->is_aborted = true;
+    m_work_queue->condition.signal();
+}
+
+ErrorOr<void, ValidationError> StreamingCompiler::append(ReadonlyBytes bytes)
+{
+    VERIFY(!m_is_finished);
+
+    if (auto result = m_parser.append(bytes); result.is_error())
+        return ValidationError { parse_error_to_byte_string(result.error()) };
+
+    TRY(validate_parsed_functions());
+
+    if (m_pending_dispatch_count >= streaming_batch_dispatch_count)
+        submit_pending_functions(false);
+    return {};
+}
+
+ErrorOr<NonnullRefPtr<Module>, ValidationError> StreamingCompiler::finish(Optional<CompileCacheConfig> cache_config, Optional<ModuleStats> stats)
+{
+    VERIFY(!m_is_finished);
+
+    auto module_or_error = m_parser.finish();
+    if (module_or_error.is_error())
+        return ValidationError { parse_error_to_byte_string(module_or_error.error()) };
+    auto module = module_or_error.release_value();
+
+    // A module without a code section never told us that everything preceding it is there.
+    TRY(validate_parsed_functions());
+    if (!m_has_begun_validation) {
+        TRY(m_validator.begin_validation(*module));
+        m_has_begun_validation = true;
+    }
+
+    if (auto result = m_validator.finish_validation(*module); result.is_error()) {
+        module->set_validation_error(result.error().error_string);
+        return result.release_error();
+    }
+
+    if (cache_config.has_value())
+        module->set_cranelift_cache_config(cache_config.release_value());
+    if (stats.has_value())
+        module->set_compile_stats(stats.release_value());
+
+    submit_pending_functions(true);
+    m_is_finished = true;
+    return module;
+}
+
+ErrorOr<void, ValidationError> StreamingCompiler::validate_parsed_functions()
+{
+    if (!m_parser.has_reached_code_section())
+        return {};
+
+    auto& module = m_parser.module();
+    if (!m_has_begun_validation) {
+        TRY(m_validator.begin_validation(module));
+        m_has_begun_validation = true;
+    }
+
+    auto& functions = module.code_section().functions();
+    for (; m_validated_function_count < m_parser.parsed_function_count(); ++m_validated_function_count) {
+        auto& function = functions[m_validated_function_count].func();
+        if (auto result = m_validator.validate_function(function, m_validated_function_count); result.is_error()) {
+            module.set_validation_error(result.error().error_string);
+            return result.release_error();
+        }
+
+        auto& compiled = function.body().compiled_instructions;
+        if (!compiled.cranelift_eligible)
+            continue;
+        m_pending_functions.append({ static_cast<u32>(m_validator.imported_function_count() + m_validated_function_count), &compiled });
+        m_pending_dispatch_count += compiled.dispatches.size();
+    }
+    return {};
+}
+
+void StreamingCompiler::submit_pending_functions(bool is_finished)
+{
+    Sync::MutexLocker locker(m_work_queue->mutex);
+    m_work_queue->pending.extend(move(m_pending_functions));
+    m_work_queue->is_finished = is_finished;
+    m_work_queue->condition.signal();
+
+    m_pending_functions.clear();
+    m_pending_dispatch_count = 0;
+}
+
+void StreamingCompiler::compile_pending_functions(Module& module, WorkQueue& work_queue)
+{
+    bool installing = false;
+    bool capturing = true;
+    AK::Duration cranelift_duration;
+    Optional<CompileCacheConfig> cache_config;
+
+    // The content hash is only known at the very end, so capture everything in case the embedder wants to cache it.
+    begin_cranelift_cache_capture();
+
+    ScopeGuard cleanup = [&] {
+        set_cranelift_active_function_index(NumericLimits<u32>::max());
+        module.finish_cranelift_compilation();
+    };
+
+    while (true) {
+        Vector<PendingFunction> functions;
+        bool is_finished = false;
+        {
+            Sync::MutexLocker locker(work_queue.mutex);
+            work_queue.condition.wait_while([&] {
+                return work_queue.pending.is_empty() && !work_queue.is_finished && !work_queue.is_aborted;
+            });
+            if (work_queue.is_aborted) {
+                abort_cranelift_cache_capture();
+                return;
+            }
+            functions = move(work_queue.pending);
+            is_finished = work_queue.is_finished;
+        }
+
+        if (is_finished) {
+            cache_config = module.take_cranelift_cache_config();
+            if (cache_config.has_value() && !cache_config->existing_blob.is_empty()) {
+                auto hash = ReadonlyBytes { cache_config->wasm_hash.data(), 32 };
+                installing = try_install_cranelift_cache_blob(hash, cache_config->existing_blob.bytes());
+            }
+            // A partially installed module would produce an incomplete blob, so leave the cache as it is.
+            if (installing || !cache_config.has_value() || !cache_config->on_compiled) {
+                abort_cranelift_cache_capture();
+                capturing = false;
+            }
+        }
+
+        auto cranelift_start = MonotonicTime::now();
+        for (auto& function : functions) {
+            set_cranelift_active_function_index(function.function_index);
+            try_cranelift_compile(*function.compiled, function.compiled->cranelift_result_arity);
+        }
+        flush_cranelift_batch();
+        cranelift_duration += MonotonicTime::now() - cranelift_start;
+
+        if (is_finished)
+            break;
+    }
+
+    if (installing)
+        abort_cranelift_cache_install();
+
+    size_t produced_blob_size = 0;
+    if (capturing) {
+        auto hash = ReadonlyBytes { cache_config->wasm_hash.data(), 32 };
+        if (auto blob = serialize_cranelift_cache_blob(hash); blob.has_value()) {
+            produced_blob_size = blob->size();
+            cache_config->on_compiled(blob.release_value());
+        } else {
+            abort_cranelift_cache_capture();
+        }
+    }
+
+    if (auto stats = module.take_compile_stats(); stats.has_value()) {
+        stats->cranelift_time = cranelift_duration;
+        stats->cranelift_blob_size_bytes = produced_blob_size;
+        stats->cache_hit = installing;
+        record_native_compile_stats(module, stats.release_value());
+    }
+}
+
+}
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/AtomicRefCounted.h>
+#include <AK/NonnullRefPtr.h>
+#include <AK/Vector.h>
+#include <LibWasm/AbstractMachine/Validator.h>
+#include <LibWasm/Export.h>
+#include <LibWasm/Types.h>
+
+namespace Wasm {
+
+// Parses, validates and compiles a module while its bytes are still arriving.
+// Each function body is validated on the calling thread as soon as it has been parsed, and handed in batches to a worker
+// thread that runs them through Cranelift, so native code is mostly ready by the time the last byte has arrived.
+// NB: Parse errors are reported as validation errors carrying the parser's message; embedders treat both the same.
+class WASM_API StreamingCompiler {
+    AK_MAKE_NONCOPYABLE(StreamingCompiler);
+    AK_MAKE_NONMOVABLE(StreamingCompiler);
+
+public:
+    StreamingCompiler();
+    ~StreamingCompiler();
+
+    ErrorOr<void, ValidationError> append(ReadonlyBytes);
+
+    // The cache config and stats are parked on the module for the worker, just like for compile_module_to_native().
+    // As the content hash is only known now, a cached blob can only be used for the functions not compiled yet.
+    ErrorOr<NonnullRefPtr<Module>, ValidationError> finish(Optional<CompileCacheConfig>, Optional<ModuleStats>);
+
+private:
+    struct PendingFunction {
+        u32 function_index { 0 };
+        CompiledInstructions* compiled { nullptr };
+    };
+
+    struct WorkQueue : public AtomicRefCounted<WorkQueue> {
+        Sync::Mutex mutex;
+        Sync::ConditionVariable condition { mutex };
+        Vector<PendingFunction> pending;
+        bool is_finished { false };
+        bool is_aborted { false };
+    };
+
+    static void compile_pending_functions(Module&, WorkQueue&);
+
+    ErrorOr<void, ValidationError> validate_parsed_functions();
+    void submit_pending_functions(bool is_finished);
+
+    StreamingModuleParser m_parser;
+    Validator m_validator;
+    NonnullRefPtr<WorkQueue> m_work_queue;
+    Vector<PendingFunction> m_pending_functions;
+    size_t m_pending_dispatch_count { 0 };
+    size_t m_validated_function_count { 0 };
+    bool m_has_begun_validation { false };
+    bool m_is_finished { false };
+};
+
+}
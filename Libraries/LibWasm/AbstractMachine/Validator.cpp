@@ -4,17 +4,30 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/AllOf.h>
+#include <AK/AnyOf.h>
 #include <AK/GenericShorthands.h>
 #include <AK/HashTable.h>
 #include <AK/SourceLocation.h>
 #include <AK/TemporaryChange.h>
 #include <AK/Try.h>
+#include <LibCore/System.h>
+#include <LibSync/ConditionVariable.h>
+#include <LibSync/Mutex.h>
+#include <LibThreading/Thread.h>
 #include <LibWasm/AbstractMachine/Validator.h>
 #include <LibWasm/Printer/Printer.h>
 
 namespace Wasm {
 
 ErrorOr<void, ValidationError> Validator::validate(Module& module)
+{
+    TRY(begin_validation(module));
+    TRY(validate(module.code_section()));
+    return finish_validation(module);
+}
+
+ErrorOr<void, ValidationError> Validator::begin_validation(Module& module)
 {
     // Pre-emptively make invalid. The module will be set to `Valid` at the end
     // of validation.
@@ -89,9 +102,6 @@ ErrorOr<void, ValidationError> Validator::validate(Module& module)
             }));
     }
 
-    if (module.code_section().functions().size() != module.function_section().types().size())
-        return Errors::invalid("FunctionSection"sv);
-
     m_context.functions.ensure_capacity(module.function_section().types().size() + m_context.functions.size());
     m_context.function_type_indices.ensure_capacity(module.function_section().types().size() + m_context.function_type_indices.size());
     for (auto& index : module.function_section().types()) {
@@ -117,7 +127,9 @@ ErrorOr<void, ValidationError> Validator::validate(Module& module)
     for (auto& segment : module.element_section().segments())
         m_context.elements.append(segment.type);
 
-    m_context.datas.resize(module.data_section().data().size());
+    // NB: The data section follows the code section, so a streamed module has not seen it yet. Function bodies may only
+    //     refer to data segments if there is a data count section, which then has to agree with the data section anyway.
+    m_context.datas.resize(m_context.data_count.value_or(module.data_section().data().size()));
 
     m_context.tags.ensure_capacity(m_context.tags.size() + module.tag_section().tags().size());
     for (auto& tag : module.tag_section().tags())
@@ -153,21 +165,74 @@ ErrorOr<void, ValidationError> Validator::validate(Module& module)
     TRY(validate(module.import_section()));
     TRY(validate(module.export_section()));
     TRY(validate(module.start_section()));
-    TRY(validate(module.data_section()));
     TRY(validate(module.element_section()));
     TRY(validate(module.global_section()));
     TRY(validate(module.memory_section()));
     TRY(validate(module.table_section()));
-    TRY(validate(module.code_section()));
     TRY(validate(module.tag_section()));
 
-    for (auto& entry : module.code_section().functions())
+    m_callee_bodies.clear_with_capacity();
+    m_callee_bodies.resize(m_context.imported_function_count + module.function_section().types().size());
+    return {};
+}
+
+ErrorOr<void, ValidationError> Validator::finish_validation(Module& module)
+{
+    auto& functions = module.code_section().functions();
+    if (functions.size() != module.function_section().types().size())
+        return Errors::invalid("FunctionSection"sv);
+
+    m_context.datas.resize(module.data_section().data().size());
+    TRY(validate(module.data_section()));
+
+    // Calls through a call record need room for the callee's locals, which for forward calls are only known now.
+    for (auto& entry : functions) {
+        auto& function = entry.func();
+        if (function.body().compiled_instructions.max_call_rec_size == 0)
+            continue;
+
+        size_t max_callee_locals = 0;
+        for (auto& insn : function.body().instructions()) {
+            if (!first_is_one_of(insn.opcode(), Instructions::call, Instructions::synthetic_call_with_record_0, Instructions::synthetic_call_with_record_1))
+                continue;
+            auto callee_index = insn.arguments().template get<FunctionIndex>();
+            if (callee_index.value() - m_context.imported_function_count < functions.size())
+                max_callee_locals = max(max_callee_locals, functions[callee_index.value() - m_context.imported_function_count].func().total_local_count());
+        }
+
+        function.body().compiled_instructions.max_call_rec_size += max_callee_locals;
+    }
+
+    for (auto& entry : functions)
         module.set_minimum_call_record_allocation_size(max(entry.func().body().compiled_instructions.max_call_rec_size, module.minimum_call_record_allocation_size()));
 
     module.set_validation_status(Module::ValidationStatus::Valid, {});
     return {};
 }
 
+void record_native_compile_stats(Module const& module, ModuleStats stats)
+{
+    size_t count = 0;
+    size_t tier_up_functions = 0;
+    size_t tier_up_checkpoints = 0;
+    for (auto& entry : module.code_section().functions()) {
+        auto const& ci = entry.func().body().compiled_instructions;
+        if (ci.cranelift_compiled)
+            ++count;
+        if (ci.has_tier_up_checkpoints) {
+            ++tier_up_functions;
+            for (auto const& dispatch : ci.dispatches) {
+                if (dispatch.instruction->opcode() == Instructions::synthetic_tier_up)
+                    ++tier_up_checkpoints;
+            }
+        }
+    }
+    stats.function_count = count;
+    stats.tier_up_function_count = tier_up_functions;
+    stats.tier_up_checkpoint_count = tier_up_checkpoints;
+    record_module_stats(move(stats));
+}
+
 void compile_module_to_native(Module& module)
 {
     auto cache_config = module.take_cranelift_cache_config();
@@ -209,25 +274,7 @@ void compile_module_to_native(Module& module)
             stats->cranelift_time = cranelift_duration;
             stats->cranelift_blob_size_bytes = produced_blob_size;
             stats->cache_hit = installing;
-            size_t count = 0;
-            size_t tier_up_functions = 0;
-            size_t tier_up_checkpoints = 0;
-            for (auto& entry : module.code_section().functions()) {
-                auto const& ci = entry.func().body().compiled_instructions;
-                if (ci.cranelift_compiled)
-                    ++count;
-                if (ci.has_tier_up_checkpoints) {
-                    ++tier_up_functions;
-                    for (auto const& dispatch : ci.dispatches) {
-                        if (dispatch.instruction->opcode() == Instructions::synthetic_tier_up)
-                            ++tier_up_checkpoints;
-                    }
-                }
-            }
-            stats->function_count = count;
-            stats->tier_up_function_count = tier_up_functions;
-            stats->tier_up_checkpoint_count = tier_up_checkpoints;
-            record_module_stats(stats.release_value());
+            record_native_compile_stats(module, stats.release_value());
         }
 
         set_cranelift_active_function_index(NumericLimits<u32>::max());
@@ -409,68 +456,209 @@ ErrorOr<void, ValidationError> Validator::validate(TableSection const& section)
     return {};
 }
 
+// Spreading function bodies over threads only pays off once there are enough of them to amortize starting the threads.
+static constexpr size_t parallel_validation_min_function_count = 128;
+static constexpr size_t parallel_validation_min_functions_per_thread = 32;
+static constexpr size_t parallel_validation_thread_stack_size = 8 * MiB;
+
 ErrorOr<void, ValidationError> Validator::validate(CodeSection const& section)
 {
-    Vector<CodeSection::Func const*> callee_bodies;
-    callee_bodies.resize(m_context.imported_function_count + section.functions().size());
-
-    size_t index = m_context.imported_function_count;
-    for (auto& entry : section.functions()) {
-        auto function_index = index++;
-        VERIFY(function_index <= NumericLimits<u32>::max());
-        TRY(validate(FunctionIndex { static_cast<u32>(function_index) }));
-        auto& function_type = m_context.functions[function_index];
-        auto& function = entry.func();
+    auto function_count = section.functions().size();
+    auto thread_count = min(static_cast<size_t>(Core::System::hardware_concurrency()), function_count / parallel_validation_min_functions_per_thread);
+    if (function_count >= parallel_validation_min_function_count && thread_count > 1) {
+        m_code_section_thread_count = thread_count;
+        return validate_in_parallel(section, thread_count);
+    }
 
-        auto function_validator = fork();
-        function_validator.m_context.locals = {};
-        function_validator.m_context.locals.extend(function_type.parameters());
-        function_validator.m_context.current_function_parameter_count = function_type.parameters().size();
-        for (auto& local : function.locals()) {
-            // https://webassembly.github.io/spec/core/valid/modules.html#functions
-            // The locals' value types must be valid (in particular, type uses must exist).
-            TRY(function_validator.validate(local.type()));
-            for (size_t i = 0; i < local.n(); ++i)
-                function_validator.m_context.locals.append(local.type());
+    m_code_section_thread_count = 1;
+    for (size_t code_index = 0; code_index < function_count; ++code_index)
+        TRY(validate_function(section.functions()[code_index].func(), code_index));
+    return {};
+}
+
+ErrorOr<void, ValidationError> Validator::validate_in_parallel(CodeSection const& section, size_t thread_count)
+{
+    auto const& functions = section.functions();
+    auto function_count = functions.size();
+    auto imported_function_count = m_context.imported_function_count;
+
+    // A function body can only be validated once every function it may inline has been, as the validator compiles
+    // the body right away, and inlining looks at the callee's compiled instructions. Those are exactly the earlier
+    // functions it calls directly, so validating in that order sees the same callees as validating front to back
+    // would, and produces the same code.
+    struct Scheduler {
+        Sync::Mutex mutex;
+        Sync::ConditionVariable condition { mutex };
+        Vector<size_t> ready;
+        Vector<size_t> remaining_dependency_counts;
+        Vector<Vector<size_t>> dependents;
+        size_t completed_count { 0 };
+        size_t first_failed_index { NumericLimits<size_t>::max() };
+        Optional<ValidationError> error;
+    } scheduler;
+
+    scheduler.remaining_dependency_counts.resize(function_count);
+    scheduler.dependents.resize(function_count);
+    for (size_t code_index = 0; code_index < function_count; ++code_index) {
+        HashTable<size_t> dependencies;
+        for (auto const& instruction : functions[code_index].func().body().instructions()) {
+            if (instruction.opcode() != Instructions::call)
+                continue;
+            auto callee_index = instruction.arguments().get<FunctionIndex>().value();
+            if (callee_index < imported_function_count || callee_index - imported_function_count >= code_index)
+                continue;
+            if (dependencies.set(callee_index - imported_function_count) == HashSetResult::InsertedNewEntry)
+                scheduler.dependents[callee_index - imported_function_count].append(code_index);
         }
+        scheduler.remaining_dependency_counts[code_index] = dependencies.size();
+    }
 
-        // https://webassembly.github.io/spec/core/valid/modules.html#functions
-        function_validator.m_local_initialized.clear_with_capacity();
-        function_validator.m_local_init_log.clear_with_capacity();
-        for (auto& parameter : function_type.parameters()) {
-            (void)parameter;
-            function_validator.m_local_initialized.append(true);
-        }
-        for (auto& local : function.locals()) {
-            for (size_t i = 0; i < local.n(); ++i)
-                function_validator.m_local_initialized.append(local.type().is_defaultable());
+    // Start out with the lowest indices, so an invalid module fails about as early as it would otherwise.
+    for (size_t code_index = function_count; code_index > 0; --code_index) {
+        if (scheduler.remaining_dependency_counts[code_index - 1] == 0)
+            scheduler.ready.append(code_index - 1);
+    }
+
+    auto run_worker = [&](Validator& validator) {
+        while (true) {
+            size_t code_index;
+            bool should_skip;
+            {
+                Sync::MutexLocker locker(scheduler.mutex);
+                scheduler.condition.wait_while([&] {
+                    return scheduler.ready.is_empty() && scheduler.completed_count < function_count;
+                });
+                if (scheduler.completed_count == function_count)
+                    return;
+                code_index = scheduler.ready.take_last();
+                // Only the first error in code order is reported, so anything after it need not be validated at all.
+                should_skip = code_index > scheduler.first_failed_index;
+            }
+
+            auto const& function = functions[code_index].func();
+            Optional<ValidationError> error;
+            if (!should_skip) {
+                if (auto result = validator.validate_function(function, code_index, m_callee_bodies.span()); result.is_error())
+                    error = result.release_error();
+            }
+
+            Sync::MutexLocker locker(scheduler.mutex);
+            if (error.has_value()) {
+                if (code_index < scheduler.first_failed_index) {
+                    scheduler.first_failed_index = code_index;
+                    scheduler.error = error.release_value();
+                }
+            } else if (!should_skip) {
+                m_callee_bodies[imported_function_count + code_index] = &function;
+            }
+            for (auto dependent : scheduler.dependents[code_index]) {
+                if (--scheduler.remaining_dependency_counts[dependent] == 0)
+                    scheduler.ready.append(dependent);
+            }
+            ++scheduler.completed_count;
+            scheduler.condition.broadcast();
         }
+    };
 
-        function_validator.push_frame(Frame { function_type, FrameKind::Function, (size_t)0 });
+    Vector<NonnullOwnPtr<Validator>> validators;
+    Vector<NonnullRefPtr<Threading::Thread>> threads;
+    for (size_t i = 1; i < thread_count; ++i) {
+        validators.append(isolated_fork());
+        auto& validator = *validators.last();
+        auto thread = Threading::Thread::construct("Wasm/Validator"sv, [&run_worker, &validator]() -> intptr_t {
+            run_worker(validator);
+            return 0;
+        });
+        thread->set_stack_size(parallel_validation_thread_stack_size);
+        thread->start();
+        threads.append(move(thread));
+    }
 
-        auto results = TRY(function_validator.validate(function.body(), function_type.results(), callee_bodies.span(), function_index));
-        if (results.result_types.size() != function_type.results().size())
-            return Errors::invalid("function result"sv, function_type.results(), results.result_types);
+    run_worker(*this);
+    for (auto& thread : threads)
+        (void)thread->join();
 
-        callee_bodies[function_index] = &function;
+    if (scheduler.error.has_value())
+        return scheduler.error.release_value();
+    return {};
+}
 
-        if (function.body().compiled_instructions.max_call_rec_size != 0) {
-            size_t max_callee_locals = 0;
-            for (auto& insn : function.body().instructions()) {
-                if (!first_is_one_of(insn.opcode(), Instructions::call, Instructions::synthetic_call_with_record_0, Instructions::synthetic_call_with_record_1))
-                    continue;
-                auto callee_index = insn.arguments().template get<FunctionIndex>();
-                if (callee_index.value() - m_context.imported_function_count < section.functions().size())
-                    max_callee_locals = max(max_callee_locals, section.functions()[callee_index.value() - m_context.imported_function_count].func().total_local_count());
-            }
+ErrorOr<void, ValidationError> Validator::validate_function(CodeSection::Func const& function, size_t code_index)
+{
+    TRY(validate_function(function, code_index, m_callee_bodies.span()));
+    m_callee_bodies[m_context.imported_function_count + code_index] = &function;
+    return {};
+}
 
-            function.body().compiled_instructions.max_call_rec_size += max_callee_locals;
-        }
+ErrorOr<void, ValidationError> Validator::validate_function(CodeSection::Func const& function, size_t code_index, Span<CodeSection::Func const* const> callee_bodies)
+{
+    auto function_index = m_context.imported_function_count + code_index;
+    VERIFY(function_index <= NumericLimits<u32>::max());
+    TRY(validate(FunctionIndex { static_cast<u32>(function_index) }));
+    auto& function_type = m_context.functions[function_index];
+
+    auto function_validator = fork();
+    function_validator.m_context.locals = {};
+    function_validator.m_context.locals.extend(function_type.parameters());
+    function_validator.m_context.current_function_parameter_count = function_type.parameters().size();
+    for (auto& local : function.locals()) {
+        // https://webassembly.github.io/spec/core/valid/modules.html#functions
+        // The locals' value types must be valid (in particular, type uses must exist).
+        TRY(function_validator.validate(local.type()));
+        for (size_t i = 0; i < local.n(); ++i)
+            function_validator.m_context.locals.append(local.type());
     }
 
+    // https://webassembly.github.io/spec/core/valid/modules.html#functions
+    function_validator.m_local_initialized.clear_with_capacity();
+    function_validator.m_local_init_log.clear_with_capacity();
+    for (auto& parameter : function_type.parameters()) {
+        (void)parameter;
+        function_validator.m_local_initialized.append(true);
+    }
+    for (auto& local : function.locals()) {
+        for (size_t i = 0; i < local.n(); ++i)
+            function_validator.m_local_initialized.append(local.type().is_defaultable());
+    }
+
+    function_validator.push_frame(Frame { function_type, FrameKind::Function, (size_t)0 });
+
+    auto results = TRY(function_validator.validate(function.body(), function_type.results(), callee_bodies, function_index));
+    if (results.result_types.size() != function_type.results().size())
+        return Errors::invalid("function result"sv, function_type.results(), results.result_types);
     return {};
 }
 
+NonnullOwnPtr<Validator> Validator::isolated_fork() const
+{
+    // NB: A COWVector copy shares its storage through a non-atomic refcount, so give the fork storage of its own.
+    auto isolated_copy = []<typename T>(COWVector<T> const& vector) {
+        COWVector<T> copy;
+        copy.extend(vector);
+        return copy;
+    };
+
+    Context context;
+    context.types = isolated_copy(m_context.types);
+    context.canonical_types = isolated_copy(m_context.canonical_types);
+    context.functions = isolated_copy(m_context.functions);
+    context.function_type_indices = isolated_copy(m_context.function_type_indices);
+    context.structs = isolated_copy(m_context.structs);
+    context.arrays = isolated_copy(m_context.arrays);
+    context.tables = isolated_copy(m_context.tables);
+    context.memories = isolated_copy(m_context.memories);
+    context.globals = isolated_copy(m_context.globals);
+    context.elements = isolated_copy(m_context.elements);
+    context.datas = isolated_copy(m_context.datas);
+    context.locals = isolated_copy(m_context.locals);
+    context.tags = isolated_copy(m_context.tags);
+    context.data_count = m_context.data_count;
+    context.references = m_context.references;
+    context.imported_function_count = m_context.imported_function_count;
+    context.current_function_parameter_count = m_context.current_function_parameter_count;
+    return adopt_own(*new Validator(move(context)));
+}
+
 ErrorOr<void, ValidationError> Validator::validate(TagSection const& section)
 {
     for (auto& entry : section.tags())
@@ -5121,20 +5309,76 @@ ErrorOr<Validator::ExpressionTypeResult, ValidationError> Validator::validate(Ex
     expression.compiled_instructions = try_compile_instructions(expression, m_context.functions.span(), callee_bodies, current_function_index, m_context.locals.size(), m_context.imported_function_count);
 
     if (expression.compiled_instructions.direct && !is_constant_expression) {
-        bool has_unsupported_types = false;
-        for (auto& type : m_context.locals) {
-            if (type.is_reference() || type.kind() == ValueType::V128) {
-                has_unsupported_types = true;
-                break;
+        // Cranelift handles references from the func, extern and exn hierarchies, which it carries around like v128 values.
+        // Leave functions that touch the any hierarchy (GC objects, i31s, structs and arrays) to the interpreter.
+        auto is_supported_type = [&](ValueType const& type) {
+            switch (type.kind()) {
+            case ValueType::AnyReference:
+            case ValueType::EqReference:
+            case ValueType::I31Reference:
+            case ValueType::StructReference:
+            case ValueType::ArrayReference:
+            case ValueType::NoneReference:
+                return false;
+            case ValueType::TypeUseReference:
+                return m_context.types[type.unsafe_typeindex().value()].is_function();
+            default:
+                return true;
             }
-        }
+        };
+        auto is_wide = [](ValueType const& type) { return type.kind() == ValueType::V128 || type.is_reference(); };
+
+        bool has_unsupported_types = !all_of(m_context.locals, is_supported_type) || !all_of(result_types, is_supported_type);
+        bool has_wide_locals = any_of(m_context.locals, is_wide);
+        // Cranelift keeps full 128-bit values only in functions that visibly work with them (through a v128 or reference local, a SIMD
+        // instruction or a reference instruction), so skip functions that would otherwise only pass such values along from globals or calls.
+        // Also skip direct calls with v128s or references in the callee's signature, as the compiled code hands their arguments and results
+        // over as 64-bit payloads.
         if (!has_unsupported_types) {
-            for (auto& type : result_types) {
-                if (type.is_reference() || type.kind() == ValueType::V128) {
-                    has_unsupported_types = true;
-                    break;
+            auto signature_is_wide = [&](FunctionType const& type) {
+                return any_of(type.parameters(), is_wide) || any_of(type.results(), is_wide);
+            };
+            auto results_are_supported = [&](FunctionType const& type) {
+                return all_of(type.results(), is_supported_type);
+            };
+            bool has_wide_instructions = false;
+            bool has_opaque_wide_values = false;
+            for (auto const& dispatch : expression.compiled_instructions.dispatches) {
+                auto const& insn = *dispatch.instruction;
+                auto const opcode = insn.opcode();
+                if (opcode.value() >= Instructions::v128_load.value() && opcode.value() <= Instructions::i32x4_relaxed_dot_i8x16_i7x16_add_s.value()) {
+                    has_wide_instructions = true;
+                } else if (opcode == Instructions::ref_null || opcode == Instructions::ref_func || opcode == Instructions::ref_is_null
+                    || opcode == Instructions::ref_as_non_null || opcode == Instructions::ref_eq) {
+                    has_wide_instructions = true;
+                } else if (opcode == Instructions::table_get || opcode == Instructions::table_set || opcode == Instructions::table_grow
+                    || opcode == Instructions::table_fill) {
+                    has_wide_instructions = true;
+                    has_unsupported_types |= !is_supported_type(m_context.tables[insn.arguments().get<TableIndex>().value()].element_type());
+                } else if (opcode == Instructions::global_get) {
+                    auto const& type = m_context.globals[insn.arguments().get<GlobalIndex>().value()].type();
+                    has_unsupported_types |= !is_supported_type(type);
+                    has_opaque_wide_values |= is_wide(type);
+                } else if (opcode.value() >= Instructions::synthetic_call_00.value() && opcode.value() <= Instructions::synthetic_call_31.value()) {
+                    has_unsupported_types |= signature_is_wide(m_context.functions[insn.arguments().get<FunctionIndex>().value()]);
+                } else if (opcode == Instructions::call || opcode == Instructions::synthetic_call_with_record_1) {
+                    auto const& type = m_context.functions[insn.arguments().get<FunctionIndex>().value()];
+                    has_unsupported_types |= !results_are_supported(type);
+                    has_opaque_wide_values |= any_of(type.results(), is_wide);
+                } else if (opcode == Instructions::call_indirect) {
+                    auto const& type = m_context.types[insn.arguments().get<Instruction::IndirectCallArgs>().type.value()].function();
+                    has_unsupported_types |= !results_are_supported(type);
+                    has_opaque_wide_values |= any_of(type.results(), is_wide);
+                } else if (opcode == Instructions::call_ref || opcode == Instructions::return_call_ref) {
+                    has_wide_instructions = true;
+                    auto const& type = m_context.types[insn.arguments().get<TypeIndex>().value()].function();
+                    has_unsupported_types |= !results_are_supported(type) || type.results().size() > 1;
                 }
+                if (has_unsupported_types)
+                    break;
             }
+            if (has_opaque_wide_values && !has_wide_instructions && !has_wide_locals)
+                has_unsupported_types = true;
         }
         // Also skip 64-bit addressing (cranelift truncates base to u32).
         if (!has_unsupported_types) {
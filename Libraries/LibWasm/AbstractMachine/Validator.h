@@ -6,8 +6,10 @@
 
 #pragma once
 
+#include <AK/AtomicRefCounted.h>
 #include <AK/COWVector.h>
 #include <AK/Debug.h>
+#include <AK/NonnullOwnPtr.h>
 #include <AK/RedBlackTree.h>
 #include <AK/SourceLocation.h>
 #include <AK/Tuple.h>
@@ -19,7 +21,8 @@
 namespace Wasm {
 
 struct Context {
-    struct RefRBTree : RefCounted<RefRBTree> {
+    // NB: Shared between the validators of function bodies that are validated in parallel, see Validator::validate(CodeSection const&).
+    struct RefRBTree : AtomicRefCounted<RefRBTree> {
         RedBlackTree<size_t, FunctionIndex> tree;
     };
 
@@ -68,6 +71,16 @@ public:
 
     // Module
     ErrorOr<void, ValidationError> validate(Module&);
+
+    // Validates a module piecewise while it is being streamed in: begin_validation() once every section preceding the code
+    // section is available, validate_function() for each code section entry in order, and finish_validation() once the
+    // whole module has been parsed. validate(Module&) is exactly these three steps.
+    ErrorOr<void, ValidationError> begin_validation(Module&);
+    ErrorOr<void, ValidationError> validate_function(CodeSection::Func const&, size_t code_index);
+    ErrorOr<void, ValidationError> finish_validation(Module&);
+    size_t imported_function_count() const { return m_context.imported_function_count; }
+    // How many threads the last code section was validated on.
+    size_t code_section_thread_count() const { return m_code_section_thread_count; }
     ErrorOr<void, ValidationError> validate(ImportSection const&);
     ErrorOr<void, ValidationError> validate(ExportSection const&);
     ErrorOr<void, ValidationError> validate(StartSection const&);
@@ -360,6 +373,13 @@ private:
     {
     }
 
+    // Validates a single function body, with calls to already validated functions available for inlining through `callee_bodies`.
+    ErrorOr<void, ValidationError> validate_function(CodeSection::Func const&, size_t code_index, Span<CodeSection::Func const* const> callee_bodies);
+    ErrorOr<void, ValidationError> validate_in_parallel(CodeSection const&, size_t thread_count);
+
+    // A fork that shares no non-atomically refcounted state with this validator, so it can be used from another thread.
+    [[nodiscard]] NonnullOwnPtr<Validator> isolated_fork() const;
+
     ErrorOr<void, ValidationError> validate_struct_get(Stack&, Instruction const&, bool requires_packed);
     ErrorOr<FieldType, ValidationError> array_field_type(TypeIndex, StringView instruction_name, bool requires_mutable);
     ErrorOr<void, ValidationError> validate_array_get(Stack&, Instruction const&, bool requires_packed);
@@ -459,6 +479,8 @@ private:
     Vector<u32> m_local_init_log;
     size_t m_max_frame_size { 0 };
     COWVector<GlobalType> m_globals_without_internal_globals;
+    Vector<CodeSection::Func const*> m_callee_bodies;
+    size_t m_code_section_thread_count { 1 };
 };
 
 }
@@ -103,7 +103,7 @@ struct BatchInput {
 // any rebuild that changes those will simply miss the cache rather than try to
 // execute incompatible bytes.
 constexpr u64 cache_blob_magic = 0x4354494A4D534157ULL; // "WASMJITC" little-endian
-constexpr u32 cache_blob_format_version = 13;
+constexpr u32 cache_blob_format_version = 15;
 
 struct CacheBlobHeader {
     u64 magic;
@@ -188,7 +188,8 @@ static u64 compute_layout_hash(RuntimeHelpers const& h)
 static_assert(offsetof(RuntimeHelpers, call_function) == 0);
 static_assert(offsetof(RuntimeHelpers, memory_fill) == sizeof(size_t) * 11);
 static_assert(offsetof(RuntimeHelpers, primitive_storage_cage_base) == sizeof(size_t) * 12);
-static_assert(HELPER_COUNT == 13);
+static_assert(offsetof(RuntimeHelpers, throw_exception) == sizeof(size_t) * 23);
+static_assert(HELPER_COUNT == 24);
 
 static bool apply_helper_relocs(u8* code_bytes, size_t code_size, HelperReloc const* relocs, size_t reloc_count, RuntimeHelpers const& helpers)
 {
@@ -303,6 +304,14 @@ static ALWAYS_INLINE i32 wasm_cl_run_compiled(BytecodeInterpreter& interpreter,
     }
     if (interpreter.did_trap())
         return 1;
+    if (interpreter.has_pending_tail_call()) [[unlikely]] {
+        interpreter.run_pending_tail_calls(config);
+        if (interpreter.did_trap())
+            return 1;
+        // A tail-called wasm function replaced the lightweight frame with a regular one, which did push a label.
+        if (config.frame().owns_locals() && config.label_stack().size() > config.frame().label_index())
+            config.label_stack().shrink(config.frame().label_index(), true);
+    }
     if (entry.arity == 1)
         config.compiled_call_result_scratch() = config.value_stack().unsafe_take_last();
     // No label pop: set_frame_lightweight doesn't push labels.
@@ -382,6 +391,11 @@ static ALWAYS_INLINE i32 wasm_cl_finish_call(BytecodeInterpreter& interpreter, C
         }
         if (interpreter.did_trap())
             return 1;
+        if (interpreter.has_pending_tail_call()) [[unlikely]] {
+            interpreter.run_pending_tail_calls(config);
+            if (interpreter.did_trap())
+                return 1;
+        }
         if (config.frame().arity() == 1)
             config.compiled_call_result_scratch() = config.value_stack().unsafe_take_last();
         if (config.label_stack().size() > config.frame().label_index())
@@ -465,33 +479,61 @@ i32 wasm_cl_memory_grow(void* config_ptr, u32 mem_idx, i32 pages)
     return static_cast<i32>(old_pages);
 }
 
-i32 wasm_cl_call_indirect(void* interp_ptr, void* config_ptr, i32 table_idx, i32 type_idx, i32 element_index);
-i32 wasm_cl_call_indirect(void* interp_ptr, void* config_ptr, i32 table_idx, i32 type_idx, i32 element_index)
+static bool wasm_cl_check_callee_type(BytecodeInterpreter& interpreter, Configuration& config, FunctionAddress address, i32 type_idx)
 {
-    auto& interpreter = *static_cast<BytecodeInterpreter*>(interp_ptr);
-    auto& config = *static_cast<Configuration*>(config_ptr);
+    auto* function = config.store().get(address);
+    if (!function) {
+        interpreter.set_trap(Trap::from_string("Indirect call to freed function"));
+        return false;
+    }
+    // https://webassembly.github.io/spec/core/exec/instructions.html#xref-syntax-instructions-syntax-instr-control-mathsf-call-indirect-x-y
+    // call_indirect's runtime check is a defined-type match (a downcast), not structural equality.
+    auto const* type_actual = function->visit([](auto& f) { return f.defined_type(); });
+    auto const* type_expected = config.frame().module().canonical_types()[type_idx];
+    if (!type_actual || !matches_defined_type(*type_actual, *type_expected)) {
+        interpreter.set_trap(Trap::from_string("Indirect call type mismatch"));
+        return false;
+    }
+    return true;
+}
 
-    auto const& module = config.frame().module();
-    auto table_address = module.tables()[table_idx];
+static Optional<FunctionAddress> wasm_cl_resolve_indirect_callee(BytecodeInterpreter& interpreter, Configuration& config, i32 table_idx, i32 type_idx, i32 element_index)
+{
+    auto table_address = config.frame().module().tables()[table_idx];
     auto* table_instance = config.store().get(table_address);
-    if (!table_instance || element_index < 0 || static_cast<size_t>(element_index) >= table_instance->elements().size())
-        return interpreter.set_trap(Trap::from_string("Table index out of bounds"));
+    if (!table_instance || element_index < 0 || static_cast<size_t>(element_index) >= table_instance->elements().size()) {
+        interpreter.set_trap(Trap::from_string("Table index out of bounds"));
+        return {};
+    }
 
     auto& element = table_instance->elements()[element_index];
-    if (!element.ref().has<Reference::Func>())
-        return interpreter.set_trap(Trap::from_string("Table element is not a function reference"));
+    if (!element.ref().has<Reference::Func>()) {
+        interpreter.set_trap(Trap::from_string("Table element is not a function reference"));
+        return {};
+    }
 
     auto address = element.ref().get<Reference::Func>().address;
-    auto* function = config.store().get(address);
-    if (!function)
-        return interpreter.set_trap(Trap::from_string("Indirect call to freed function"));
-    // https://webassembly.github.io/spec/core/exec/instructions.html#xref-syntax-instructions-syntax-instr-control-mathsf-call-indirect-x-y
-    // call_indirect's runtime check is a defined-type match (a downcast), not structural equality.
-    auto const* type_actual = function->visit([](auto& f) { return f.defined_type(); });
-    auto const* type_expected = module.canonical_types()[type_idx];
-    if (!type_actual || !matches_defined_type(*type_actual, *type_expected))
-        return interpreter.set_trap(Trap::from_string("Indirect call type mismatch"));
+    if (!wasm_cl_check_callee_type(interpreter, config, address, type_idx))
+        return {};
+    return address;
+}
 
+static Optional<FunctionAddress> wasm_cl_resolve_ref_callee(BytecodeInterpreter& interpreter, Configuration& config, i32 type_idx, i64 ref_lo, i64 ref_hi)
+{
+    auto reference = Value(u128(bit_cast<u64>(ref_lo), bit_cast<u64>(ref_hi))).to<Reference>();
+    if (reference.ref().has<Reference::Null>()) {
+        interpreter.set_trap(Trap::from_string("Null function reference"));
+        return {};
+    }
+
+    auto address = reference.ref().get<Reference::Func>().address;
+    if (!wasm_cl_check_callee_type(interpreter, config, address, type_idx))
+        return {};
+    return address;
+}
+
+static i32 wasm_cl_call_address_from_stack(BytecodeInterpreter& interpreter, Configuration& config, FunctionAddress address)
+{
     SourcesAndDestination addrs {};
     addrs.sources[0] = Dispatch::RegisterOrStack::Stack;
     addrs.sources[1] = Dispatch::RegisterOrStack::Stack;
@@ -503,6 +545,192 @@ i32 wasm_cl_call_indirect(void* interp_ptr, void* config_ptr, i32 table_idx, i32
     return outcome == Outcome::Return && interpreter.did_trap() ? 1 : 0;
 }
 
+// Compiled code can't replace its own native frame, so a tail call moves the arguments off the value stack and leaves
+// the call itself to whoever entered the compiled code (see BytecodeInterpreter::run_pending_tail_calls()). The caller
+// returns right after this, which keeps the native stack bounded however long the chain of tail calls is.
+static i32 wasm_cl_tail_call(BytecodeInterpreter& interpreter, Configuration& config, FunctionAddress address)
+{
+    auto* instance = config.store().get(address);
+    if (!instance)
+        return interpreter.set_trap(Trap::from_string("Tail call to freed function"));
+
+    auto param_count = instance->visit([](auto& function) { return function.type().parameters().size(); });
+    Vector<Value, ArgumentsStaticSize> args;
+    config.get_arguments_allocation_if_possible(args, param_count);
+    args.ensure_capacity(param_count);
+    auto span = config.value_stack().span().slice_from_end(param_count);
+    for (auto& value : span)
+        args.unchecked_append(value);
+    config.value_stack().remove(config.value_stack().size() - span.size(), span.size());
+
+    interpreter.set_pending_tail_call(address, move(args));
+    return 0;
+}
+
+i32 wasm_cl_call_indirect(void* interp_ptr, void* config_ptr, i32 table_idx, i32 type_idx, i32 element_index);
+i32 wasm_cl_call_indirect(void* interp_ptr, void* config_ptr, i32 table_idx, i32 type_idx, i32 element_index)
+{
+    auto& interpreter = *static_cast<BytecodeInterpreter*>(interp_ptr);
+    auto& config = *static_cast<Configuration*>(config_ptr);
+
+    auto address = wasm_cl_resolve_indirect_callee(interpreter, config, table_idx, type_idx, element_index);
+    if (!address.has_value())
+        return 1;
+    return wasm_cl_call_address_from_stack(interpreter, config, *address);
+}
+
+i32 wasm_cl_return_call(void* interp_ptr, void* config_ptr, i32 func_index);
+i32 wasm_cl_return_call(void* interp_ptr, void* config_ptr, i32 func_index)
+{
+    auto& interpreter = *static_cast<BytecodeInterpreter*>(interp_ptr);
+    auto& config = *static_cast<Configuration*>(config_ptr);
+
+    auto address = config.frame().module().functions()[func_index];
+    return wasm_cl_tail_call(interpreter, config, address);
+}
+
+i32 wasm_cl_return_call_indirect(void* interp_ptr, void* config_ptr, i32 table_idx, i32 type_idx, i32 element_index);
+i32 wasm_cl_return_call_indirect(void* interp_ptr, void* config_ptr, i32 table_idx, i32 type_idx, i32 element_index)
+{
+    auto& interpreter = *static_cast<BytecodeInterpreter*>(interp_ptr);
+    auto& config = *static_cast<Configuration*>(config_ptr);
+
+    auto address = wasm_cl_resolve_indirect_callee(interpreter, config, table_idx, type_idx, element_index);
+    if (!address.has_value())
+        return 1;
+    return wasm_cl_tail_call(interpreter, config, *address);
+}
+
+i32 wasm_cl_call_ref(void* interp_ptr, void* config_ptr, i32 type_idx, i64 ref_lo, i64 ref_hi);
+i32 wasm_cl_call_ref(void* interp_ptr, void* config_ptr, i32 type_idx, i64 ref_lo, i64 ref_hi)
+{
+    auto& interpreter = *static_cast<BytecodeInterpreter*>(interp_ptr);
+    auto& config = *static_cast<Configuration*>(config_ptr);
+
+    auto address = wasm_cl_resolve_ref_callee(interpreter, config, type_idx, ref_lo, ref_hi);
+    if (!address.has_value())
+        return 1;
+    return wasm_cl_call_address_from_stack(interpreter, config, *address);
+}
+
+i32 wasm_cl_return_call_ref(void* interp_ptr, void* config_ptr, i32 type_idx, i64 ref_lo, i64 ref_hi);
+i32 wasm_cl_return_call_ref(void* interp_ptr, void* config_ptr, i32 type_idx, i64 ref_lo, i64 ref_hi)
+{
+    auto& interpreter = *static_cast<BytecodeInterpreter*>(interp_ptr);
+    auto& config = *static_cast<Configuration*>(config_ptr);
+
+    auto address = wasm_cl_resolve_ref_callee(interpreter, config, type_idx, ref_lo, ref_hi);
+    if (!address.has_value())
+        return 1;
+    return wasm_cl_tail_call(interpreter, config, *address);
+}
+
+void wasm_cl_ref_func(void* config_ptr, u32 func_index);
+void wasm_cl_ref_func(void* config_ptr, u32 func_index)
+{
+    auto& config = *static_cast<Configuration*>(config_ptr);
+    auto address = config.frame().module().functions()[func_index];
+    config.compiled_call_result_scratch() = Value(Reference { Reference::Func { address, config.store().get_module_for(address) } });
+}
+
+static inline TableInstance* wasm_cl_get_table(Configuration& config, u32 table_idx)
+{
+    return config.store().get(config.frame().module().tables()[table_idx]);
+}
+
+// Like the interpreter, keep the module that owns a stored function alive for as long as the table holds it.
+static void wasm_cl_set_table_elements(Configuration& config, TableInstance& table, u32 start, u32 count, i64 ref_lo, i64 ref_hi)
+{
+    auto reference = Value(u128(bit_cast<u64>(ref_lo), bit_cast<u64>(ref_hi))).to<Reference>();
+    RefPtr<ModuleInstance const> anchor;
+    if (auto const* func = reference.ref().get_pointer<Reference::Func>())
+        anchor = config.store().get_module_instance_for(func->address);
+    for (u32 i = 0; i < count; ++i)
+        table.set_element(start + i, reference, anchor);
+}
+
+i32 wasm_cl_table_get(void* interp_ptr, void* config_ptr, u32 table_idx, i32 index);
+i32 wasm_cl_table_get(void* interp_ptr, void* config_ptr, u32 table_idx, i32 index)
+{
+    auto& interpreter = *static_cast<BytecodeInterpreter*>(interp_ptr);
+    auto& config = *static_cast<Configuration*>(config_ptr);
+
+    auto* table = wasm_cl_get_table(config, table_idx);
+    if (static_cast<u32>(index) >= table->elements().size())
+        return interpreter.set_trap(Trap::from_string("Table index out of bounds"));
+    config.compiled_call_result_scratch() = Value(table->elements()[static_cast<u32>(index)]);
+    return 0;
+}
+
+i32 wasm_cl_table_set(void* interp_ptr, void* config_ptr, u32 table_idx, i32 index, i64 ref_lo, i64 ref_hi);
+i32 wasm_cl_table_set(void* interp_ptr, void* config_ptr, u32 table_idx, i32 index, i64 ref_lo, i64 ref_hi)
+{
+    auto& interpreter = *static_cast<BytecodeInterpreter*>(interp_ptr);
+    auto& config = *static_cast<Configuration*>(config_ptr);
+
+    auto* table = wasm_cl_get_table(config, table_idx);
+    if (static_cast<u32>(index) >= table->elements().size())
+        return interpreter.set_trap(Trap::from_string("Table index out of bounds"));
+    wasm_cl_set_table_elements(config, *table, static_cast<u32>(index), 1, ref_lo, ref_hi);
+    return 0;
+}
+
+i32 wasm_cl_table_size(void* config_ptr, u32 table_idx);
+i32 wasm_cl_table_size(void* config_ptr, u32 table_idx)
+{
+    auto& config = *static_cast<Configuration*>(config_ptr);
+    return static_cast<i32>(wasm_cl_get_table(config, table_idx)->elements().size());
+}
+
+i32 wasm_cl_table_grow(void* config_ptr, u32 table_idx, i32 delta, i64 ref_lo, i64 ref_hi);
+i32 wasm_cl_table_grow(void* config_ptr, u32 table_idx, i32 delta, i64 ref_lo, i64 ref_hi)
+{
+    auto& config = *static_cast<Configuration*>(config_ptr);
+    auto* table = wasm_cl_get_table(config, table_idx);
+    auto previous_size = table->elements().size();
+    auto fill_value = Value(u128(bit_cast<u64>(ref_lo), bit_cast<u64>(ref_hi))).to<Reference>();
+    if (!table->grow(static_cast<u32>(delta), fill_value))
+        return -1;
+    return static_cast<i32>(previous_size);
+}
+
+i32 wasm_cl_table_fill(void* interp_ptr, void* config_ptr, u32 table_idx, i32 start, i64 ref_lo, i64 ref_hi, i32 count);
+i32 wasm_cl_table_fill(void* interp_ptr, void* config_ptr, u32 table_idx, i32 start, i64 ref_lo, i64 ref_hi, i32 count)
+{
+    auto& interpreter = *static_cast<BytecodeInterpreter*>(interp_ptr);
+    auto& config = *static_cast<Configuration*>(config_ptr);
+
+    auto* table = wasm_cl_get_table(config, table_idx);
+    Checked<u32> end = static_cast<u32>(start);
+    end += static_cast<u32>(count);
+    if (end.has_overflow() || end.value() > table->elements().size())
+        return interpreter.set_trap(Trap::from_string("Table index out of bounds"));
+    wasm_cl_set_table_elements(config, *table, static_cast<u32>(start), static_cast<u32>(count), ref_lo, ref_hi);
+    return 0;
+}
+
+// https://webassembly.github.io/spec/core/exec/instructions.html#xref-syntax-instructions-syntax-instr-control-mathsf-throw-x
+i32 wasm_cl_throw_exception(void* interp_ptr, void* config_ptr, u32 tag_idx);
+i32 wasm_cl_throw_exception(void* interp_ptr, void* config_ptr, u32 tag_idx)
+{
+    auto& interpreter = *static_cast<BytecodeInterpreter*>(interp_ptr);
+    auto& config = *static_cast<Configuration*>(config_ptr);
+
+    auto tag_address = config.frame().module().tags()[tag_idx];
+    auto param_count = config.store().get(tag_address)->type().parameters().size();
+    auto values = Vector<Value>(config.value_stack().span().slice_from_end(param_count));
+    config.value_stack().shrink(config.value_stack().size() - param_count);
+    auto exception_address = config.store().allocate(tag_address, move(values));
+    if (!exception_address.has_value())
+        return interpreter.set_trap("Out of memory"sv);
+
+    // Compiled functions contain no try_table, so the exception always leaves this frame. Drop its labels as
+    // unwind_to_throw_handler() would; frames set up for compiled callers don't push any.
+    if (config.frame().owns_locals())
+        config.label_stack().shrink(config.frame().label_index(), true);
+    return interpreter.set_trap(Trap { UncaughtException { *exception_address } });
+}
+
 i32 wasm_cl_memory_copy(void* interp_ptr, void* config_ptr, u32 dst_mem, u32 src_mem, i32 dst_offset, i32 src_offset, i32 count);
 i32 wasm_cl_memory_copy(void* interp_ptr, void* config_ptr, u32 dst_mem, u32 src_mem, i32 dst_offset, i32 src_offset, i32 count)
 {
@@ -675,6 +903,17 @@ static RuntimeHelpers make_runtime_helpers()
         .memory_copy = bit_cast<uintptr_t>(&wasm_cl_memory_copy),
         .memory_fill = bit_cast<uintptr_t>(&wasm_cl_memory_fill),
         .primitive_storage_cage_base = bit_cast<uintptr_t>(&js_primitive_storage_cage_base),
+        .return_call = bit_cast<uintptr_t>(&wasm_cl_return_call),
+        .return_call_indirect = bit_cast<uintptr_t>(&wasm_cl_return_call_indirect),
+        .call_ref = bit_cast<uintptr_t>(&wasm_cl_call_ref),
+        .return_call_ref = bit_cast<uintptr_t>(&wasm_cl_return_call_ref),
+        .ref_func = bit_cast<uintptr_t>(&wasm_cl_ref_func),
+        .table_get = bit_cast<uintptr_t>(&wasm_cl_table_get),
+        .table_set = bit_cast<uintptr_t>(&wasm_cl_table_set),
+        .table_size = bit_cast<uintptr_t>(&wasm_cl_table_size),
+        .table_grow = bit_cast<uintptr_t>(&wasm_cl_table_grow),
+        .table_fill = bit_cast<uintptr_t>(&wasm_cl_table_fill),
+        .throw_exception = bit_cast<uintptr_t>(&wasm_cl_throw_exception),
         .regs_offset = static_cast<u32>(offsetof(Configuration, regs)),
         .value_size = static_cast<u32>(sizeof(Value)),
         .locals_base_offset = static_cast<u32>(Configuration::locals_base_offset()),
@@ -758,7 +997,21 @@ static CraneliftInsn serialize_insn(Dispatch const& dispatch, SourcesAndDestinat
         }
     } else if (opc == Instructions::call.value()) {
         out.imm1 = static_cast<i64>(args.get<FunctionIndex>().value());
-    } else if (opc == Instructions::call_indirect.value()) {
+    } else if (opc == Instructions::return_call.value() || opc == Instructions::ref_func.value()) {
+        out.imm1 = static_cast<i64>(args.get<FunctionIndex>().value());
+    } else if (opc == Instructions::call_ref.value() || opc == Instructions::return_call_ref.value()) {
+        out.imm1 = static_cast<i64>(args.get<TypeIndex>().value());
+    } else if (opc == Instructions::table_get.value() || opc == Instructions::table_set.value() || opc == Instructions::table_size.value()
+        || opc == Instructions::table_grow.value() || opc == Instructions::table_fill.value()) {
+        out.imm1 = static_cast<i64>(args.get<TableIndex>().value());
+    } else if (opc == Instructions::ref_null.value()) {
+        // The typed null as a Value, so the compiled code doesn't need to know how references are encoded.
+        auto const value = Value(args.get<ValueType>()).value();
+        out.imm1 = bit_cast<i64>(value.low());
+        out.imm2 = bit_cast<i64>(value.high());
+    } else if (opc == Instructions::throw_.value()) {
+        out.imm1 = static_cast<i64>(args.get<TagIndex>().value());
+    } else if (opc == Instructions::call_indirect.value() || opc == Instructions::return_call_indirect.value()) {
         auto const& indirect_args = args.get<Instruction::IndirectCallArgs>();
         out.imm1 = static_cast<i64>(indirect_args.type.value());
         out.imm2 = static_cast<i64>(indirect_args.table.value());
@@ -773,6 +1026,33 @@ static CraneliftInsn serialize_insn(Dispatch const& dispatch, SourcesAndDestinat
         auto const& mem_arg = args.get<Instruction::MemoryArgument>();
         out.imm1 = static_cast<i64>(mem_arg.offset);
         out.imm3 = static_cast<u32>(mem_arg.memory_index.value());
+    } else if ((opc >= Instructions::v128_load.value() && opc <= Instructions::v128_store.value())
+        || opc == Instructions::v128_load32_zero.value() || opc == Instructions::v128_load64_zero.value()) {
+        auto const& mem_arg = args.get<Instruction::MemoryArgument>();
+        out.imm1 = static_cast<i64>(mem_arg.offset);
+        out.imm3 = static_cast<u32>(mem_arg.memory_index.value());
+    } else if (opc >= Instructions::v128_load8_lane.value() && opc <= Instructions::v128_store64_lane.value()) {
+        auto const& lane_arg = args.get<Instruction::MemoryAndLaneArgument>();
+        out.imm1 = static_cast<i64>(lane_arg.memory.offset);
+        out.imm2 = static_cast<i64>(lane_arg.lane);
+        out.imm3 = static_cast<u32>(lane_arg.memory.memory_index.value());
+    } else if (opc == Instructions::v128_const.value()) {
+        // Low 8 bytes in imm1, high 8 bytes in imm2.
+        auto const value = args.get<u128>();
+        out.imm1 = bit_cast<i64>(value.low());
+        out.imm2 = bit_cast<i64>(value.high());
+    } else if (opc == Instructions::i8x16_shuffle.value()) {
+        // Lanes 0-7 in imm1, lanes 8-15 in imm2, one byte each (little-endian).
+        auto const& shuffle_arg = args.get<Instruction::ShuffleArgument>();
+        for (size_t i = 0; i < 16; ++i) {
+            auto const encoded = static_cast<u64>(shuffle_arg.lanes[i]) << ((i % 8) * 8);
+            if (i < 8)
+                out.imm1 |= static_cast<i64>(encoded);
+            else
+                out.imm2 |= static_cast<i64>(encoded);
+        }
+    } else if (opc >= Instructions::i8x16_extract_lane_s.value() && opc <= Instructions::f64x2_replace_lane.value()) {
+        out.imm1 = static_cast<i64>(args.get<Instruction::LaneIndex>().lane);
     } else if (opc == Instructions::memory_size.value()
         || opc == Instructions::memory_grow.value()) {
         auto const& mem_idx_arg = args.get<Instruction::MemoryIndexArgument>();
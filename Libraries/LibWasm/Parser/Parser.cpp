@@ -1752,6 +1752,78 @@ ParseResult<SectionId> SectionId::parse(Stream& stream)
     }
 }
 
+static ParseResult<void> parse_section_contents(Module& module, SectionId section_id, ConstrainedStream& section_stream)
+{
+    switch (section_id.kind()) {
+    case SectionId::SectionIdKind::Custom:
+        module.custom_sections().append(TRY(CustomSection::parse(section_stream)));
+        break;
+    case SectionId::SectionIdKind::Type:
+        module.type_section() = TRY(TypeSection::parse(section_stream));
+        break;
+    case SectionId::SectionIdKind::Import:
+        module.import_section() = TRY(ImportSection::parse(section_stream));
+        break;
+    case SectionId::SectionIdKind::Function:
+        module.function_section() = TRY(FunctionSection::parse(section_stream));
+        break;
+    case SectionId::SectionIdKind::Table:
+        module.table_section() = TRY(TableSection::parse(section_stream));
+        break;
+    case SectionId::SectionIdKind::Memory:
+        module.memory_section() = TRY(MemorySection::parse(section_stream));
+        break;
+    case SectionId::SectionIdKind::Global:
+        module.global_section() = TRY(GlobalSection::parse(section_stream));
+        break;
+    case SectionId::SectionIdKind::Export:
+        module.export_section() = TRY(ExportSection::parse(section_stream));
+        break;
+    case SectionId::SectionIdKind::Start:
+        module.start_section() = TRY(StartSection::parse(section_stream));
+        break;
+    case SectionId::SectionIdKind::Element:
+        module.element_section() = TRY(ElementSection::parse(section_stream));
+        break;
+    case SectionId::SectionIdKind::Code:
+        module.code_section() = TRY(CodeSection::parse(section_stream));
+        break;
+    case SectionId::SectionIdKind::Data:
+        module.data_section() = TRY(DataSection::parse(section_stream));
+        break;
+    case SectionId::SectionIdKind::DataCount:
+        module.data_count_section() = TRY(DataCountSection::parse(section_stream));
+        break;
+    case SectionId::SectionIdKind::Tag:
+        module.tag_section() = TRY(TagSection::parse(section_stream));
+        break;
+    default:
+        return ParseError::InvalidIndex;
+    }
+    return {};
+}
+
+static ParseResult<void> check_for_duplicate_section(SectionId section_id, u32& seen_section_kinds)
+{
+    if (section_id.kind() == SectionId::SectionIdKind::Custom)
+        return {};
+    auto kind_bit = 1u << to_underlying(section_id.kind());
+    if (seen_section_kinds & kind_bit)
+        return ParseError::DuplicateSection;
+    seen_section_kinds |= kind_bit;
+    return {};
+}
+
+static ParseResult<void> check_section_order(SectionId section_id, SectionId::SectionIdKind& last_section_id)
+{
+    if (!section_id.can_appear_after(last_section_id))
+        return ParseError::SectionOutOfOrder;
+    // Custom sections don't participate in ordering.
+    if (section_id.kind() != SectionId::SectionIdKind::Custom)
+        last_section_id = section_id.kind();
+    return {};
+}
+
 ParseResult<NonnullRefPtr<Module>> Module::parse(Stream& stream)
 {
     ScopeLogger<WASM_BINPARSER_DEBUG> logger("Module"sv);
@@ -1776,64 +1848,9 @@ ParseResult<NonnullRefPtr<Module>> Module::parse(Stream& stream)
         size_t section_size = TRY_READ(stream, LEB128<u32>, ParseError::ExpectedSize);
         auto section_stream = ConstrainedStream { MaybeOwned<Stream>(stream), section_size };
 
-        if (section_id.kind() != SectionId::SectionIdKind::Custom) {
-            auto kind_bit = 1u << to_underlying(section_id.kind());
-            if (seen_section_kinds & kind_bit)
-                return ParseError::DuplicateSection;
-            seen_section_kinds |= kind_bit;
-        }
-
-        switch (section_id.kind()) {
-        case SectionId::SectionIdKind::Custom:
-            module.custom_sections().append(TRY(CustomSection::parse(section_stream)));
-            break;
-        case SectionId::SectionIdKind::Type:
-            module.type_section() = TRY(TypeSection::parse(section_stream));
-            break;
-        case SectionId::SectionIdKind::Import:
-            module.import_section() = TRY(ImportSection::parse(section_stream));
-            break;
-        case SectionId::SectionIdKind::Function:
-            module.function_section() = TRY(FunctionSection::parse(section_stream));
-            break;
-        case SectionId::SectionIdKind::Table:
-            module.table_section() = TRY(TableSection::parse(section_stream));
-            break;
-        case SectionId::SectionIdKind::Memory:
-            module.memory_section() = TRY(MemorySection::parse(section_stream));
-            break;
-        case SectionId::SectionIdKind::Global:
-            module.global_section() = TRY(GlobalSection::parse(section_stream));
-            break;
-        case SectionId::SectionIdKind::Export:
-            module.export_section() = TRY(ExportSection::parse(section_stream));
-            break;
-        case SectionId::SectionIdKind::Start:
-            module.start_section() = TRY(StartSection::parse(section_stream));
-            break;
-        case SectionId::SectionIdKind::Element:
-            module.element_section() = TRY(ElementSection::parse(section_stream));
-            break;
-        case SectionId::SectionIdKind::Code:
-            module.code_section() = TRY(CodeSection::parse(section_stream));
-            break;
-        case SectionId::SectionIdKind::Data:
-            module.data_section() = TRY(DataSection::parse(section_stream));
-            break;
-        case SectionId::SectionIdKind::DataCount:
-            module.data_count_section() = TRY(DataCountSection::parse(section_stream));
-            break;
-        case SectionId::SectionIdKind::Tag:
-            module.tag_section() = TRY(TagSection::parse(section_stream));
-            break;
-        default:
-            return ParseError::InvalidIndex;
-        }
-        if (!section_id.can_appear_after(last_section_id))
-            return ParseError::SectionOutOfOrder;
-        // Custom sections don't participate in ordering.
-        if (section_id.kind() != SectionId::SectionIdKind::Custom)
-            last_section_id = section_id.kind();
+        TRY(check_for_duplicate_section(section_id, seen_section_kinds));
+        TRY(parse_section_contents(module, section_id, section_stream));
+        TRY(check_section_order(section_id, last_section_id));
         if (section_stream.remaining() != 0)
             return ParseError::SectionSizeMismatch;
     }
@@ -1843,6 +1860,153 @@ ParseResult<NonnullRefPtr<Module>> Module::parse(Stream& stream)
     return module_ptr;
 }
 
+// Reads an unsigned LEB128 value from the start of `bytes`. Returns an empty Optional if the value may continue past the
+// bytes received so far, unless `is_complete` says that no more bytes are coming.
+static ParseResult<Optional<u32>> try_read_streamed_u32(ReadonlyBytes bytes, bool is_complete, size_t& consumed, ParseError error)
+{
+    FixedMemoryStream stream { bytes };
+    auto value_or_error = stream.read_value<LEB128<u32>>();
+    if (value_or_error.is_error()) {
+        if (stream.is_eof() && !is_complete)
+            return OptionalNone {};
+        return with_eof_check(stream, error);
+    }
+    consumed = stream.offset();
+    return value_or_error.release_value();
+}
+
+StreamingModuleParser::StreamingModuleParser()
+    : m_module(make_ref_counted<Module>())
+{
+}
+
+ParseResult<void> StreamingModuleParser::append(ReadonlyBytes bytes)
+{
+    if (m_buffer.try_append(bytes).is_error())
+        return ParseError::OutOfMemory;
+
+    while (TRY(parse_next())) { }
+
+    // Drop what has been consumed so the buffer only ever holds the entry or section that is still incomplete.
+    if (m_offset != 0) {
+        auto remaining = m_buffer.size() - m_offset;
+        if (remaining != 0)
+            __builtin_memmove(m_buffer.data(), m_buffer.data() + m_offset, remaining);
+        m_buffer.trim(remaining, false);
+        m_offset = 0;
+    }
+    return {};
+}
+
+ParseResult<bool> StreamingModuleParser::parse_next()
+{
+    auto bytes = unconsumed_bytes();
+
+    switch (m_state) {
+    case State::Header: {
+        if (bytes.size() >= 4 && bytes.slice(0, 4) != Module::wasm_magic.span())
+            return ParseError::InvalidModuleMagic;
+        if (bytes.size() < 8)
+            return false;
+        if (bytes.slice(4, 4) != Module::wasm_version.span())
+            return ParseError::InvalidModuleVersion;
+        m_offset += 8;
+        m_state = State::SectionHeader;
+        return true;
+    }
+    case State::SectionHeader: {
+        if (bytes.is_empty())
+            return false;
+        FixedMemoryStream id_stream { bytes.slice(0, 1) };
+        auto section_id = TRY(SectionId::parse(id_stream));
+
+        size_t size_length = 0;
+        auto section_size = TRY(try_read_streamed_u32(bytes.slice(1), false, size_length, ParseError::ExpectedSize));
+        if (!section_size.has_value())
+            return false;
+        m_offset += 1 + size_length;
+
+        TRY(check_for_duplicate_section(section_id, m_seen_section_kinds));
+        TRY(check_section_order(section_id, m_last_section_id));
+
+        m_section_id = section_id;
+        m_section_remaining = *section_size;
+        if (section_id.kind() == SectionId::SectionIdKind::Code) {
+            m_has_reached_code_section = true;
+            m_state = State::CodeEntryCount;
+        } else {
+            m_state = State::SectionContents;
+        }
+        return true;
+    }
+    case State::SectionContents: {
+        if (bytes.size() < m_section_remaining)
+            return false;
+        FixedMemoryStream stream { bytes.trim(m_section_remaining) };
+        auto section_stream = ConstrainedStream { MaybeOwned<Stream>(stream), m_section_remaining };
+        TRY(parse_section_contents(*m_module, m_section_id, section_stream));
+        if (section_stream.remaining() != 0)
+            return ParseError::SectionSizeMismatch;
+        m_offset += m_section_remaining;
+        m_state = State::SectionHeader;
+        return true;
+    }
+    case State::CodeEntryCount: {
+        size_t count_length = 0;
+        auto section_bytes = bytes.trim(m_section_remaining);
+        auto count = TRY(try_read_streamed_u32(section_bytes, section_bytes.size() == m_section_remaining, count_length, ParseError::ExpectedSize));
+        if (!count.has_value())
+            return false;
+        // Every entry takes at least a byte, so a count that doesn't fit in the section is malformed rather than huge.
+        if (*count > m_section_remaining)
+            return ParseError::HugeAllocationRequested;
+        m_offset += count_length;
+        m_section_remaining -= count_length;
+        m_remaining_code_entries = *count;
+        m_module->code_section().ensure_capacity(*count);
+        m_state = State::CodeEntries;
+        return true;
+    }
+    case State::CodeEntries: {
+        if (m_remaining_code_entries == 0) {
+            if (m_section_remaining != 0)
+                return ParseError::SectionSizeMismatch;
+            m_state = State::SectionHeader;
+            return true;
+        }
+
+        size_t size_length = 0;
+        auto section_bytes = bytes.trim(m_section_remaining);
+        auto entry_size = TRY(try_read_streamed_u32(section_bytes, section_bytes.size() == m_section_remaining, size_length, ParseError::InvalidSize));
+        if (!entry_size.has_value())
+            return false;
+        auto entry_length = size_length + *entry_size;
+        if (entry_length > m_section_remaining)
+            return ParseError::SectionSizeMismatch;
+        if (bytes.size() < entry_length)
+            return false;
+
+        FixedMemoryStream stream { bytes.trim(entry_length) };
+        auto entry_stream = ConstrainedStream { MaybeOwned<Stream>(stream), entry_length };
+        m_module->code_section().append(TRY(CodeSection::Code::parse(entry_stream)));
+        m_offset += entry_length;
+        m_section_remaining -= entry_length;
+        --m_remaining_code_entries;
+        return true;
+    }
+    }
+    VERIFY_NOT_REACHED();
+}
+
+ParseResult<NonnullRefPtr<Module>> StreamingModuleParser::finish()
+{
+    if (m_state != State::SectionHeader || !unconsumed_bytes().is_empty())
+        return ParseError::UnexpectedEof;
+
+    m_module->preprocess();
+    return m_module;
+}
+
 void Module::preprocess()
 {
 }
@@ -15,6 +15,8 @@ use libwasm_cranelift::compile_to_bytes;
 use std::env;
 use std::mem::size_of;
 use std::mem::size_of_val;
+use std::sync::atomic::AtomicUsize;
+use std::sync::atomic::Ordering;
 
 #[cfg(all(unix, not(target_os = "macos")))]
 use std::fs::File;
@@ -257,28 +259,35 @@ fn main() -> Result<(), Box<dyn std::error::Error>> {
         entries.push(read_pod(mapped, entry_offset)?);
     }
 
+    // Hand out functions largest first, so a single huge function can't leave the other threads idle at the end.
+    // Results are still written out in input order, which keeps the output independent of the scheduling.
+    let mut order: Vec<usize> = (0..func_count).collect();
+    order.sort_by_key(|&i| std::cmp::Reverse(entries[i].insn_count));
+
     let thread_count = std::thread::available_parallelism()
         .map(|n| n.get())
         .unwrap_or(1)
-        .max(1);
-    let chunk_size = func_count.div_ceil(thread_count.max(1));
+        .clamp(1, func_count.max(1));
+    let next_order_index = AtomicUsize::new(0);
     let mapped_ref: &[u8] = mapped;
     let helpers_ref = &helpers;
+    let entries_ref = &entries;
+    let order_ref = &order;
+    let next_order_index_ref = &next_order_index;
     let outcome_return = header.outcome_return;
 
-    let compiled_chunks: Vec<Vec<(usize, CompiledFunction)>> = std::thread::scope(|scope| {
+    let mut compiled_functions: Vec<Option<CompiledFunction>> = (0..func_count).map(|_| None).collect();
+    std::thread::scope(|scope| {
         let mut handles = Vec::with_capacity(thread_count);
-        for chunk_idx in 0..thread_count {
-            let start = chunk_idx * chunk_size;
-            if start >= func_count {
-                break;
-            }
-            let end = (start + chunk_size).min(func_count);
-            let chunk_entries = &entries[start..end];
+        for _ in 0..thread_count {
             handles.push(scope.spawn(move || {
-                let mut out: Vec<(usize, CompiledFunction)> = Vec::with_capacity(end - start);
-                for (offset_in_chunk, entry) in chunk_entries.iter().enumerate() {
-                    let i = start + offset_in_chunk;
+                let mut out: Vec<(usize, CompiledFunction)> = Vec::new();
+                loop {
+                    let order_index = next_order_index_ref.fetch_add(1, Ordering::Relaxed);
+                    let Some(&i) = order_ref.get(order_index) else {
+                        break;
+                    };
+                    let entry = &entries_ref[i];
                     if entry.insn_count == 0 {
                         continue;
                     }
@@ -317,58 +326,63 @@ fn main() -> Result<(), Box<dyn std::error::Error>> {
                 out
             }));
         }
-        handles.into_iter().map(|h| h.join().unwrap()).collect()
+        for handle in handles {
+            for (i, compiled) in handle.join().unwrap() {
+                compiled_functions[i] = Some(compiled);
+            }
+        }
     });
 
     let mut code_cursor = 0usize;
     let mut reloc_cursor = 0usize;
-    for chunk in compiled_chunks {
-        for (i, compiled) in chunk {
-            let code = compiled.code;
-            let relocs = compiled.relocs;
-            let traps = compiled.traps;
-            let aligned = (code.len() + 15) & !15;
-            let reloc_bytes_len = relocs.len() * size_of::<HelperReloc>();
-            let trap_bytes_len = traps.len() * size_of::<CraneliftTrap>();
-            if code_cursor + aligned > code_capacity {
-                continue;
-            }
-            if reloc_cursor + reloc_bytes_len + trap_bytes_len > reloc_capacity {
-                continue;
-            }
-            let code_offset = code_cursor;
-            let code_dst = code_base_offset + code_offset;
-            mapped[code_dst..code_dst + code.len()].copy_from_slice(&code);
-
-            let reloc_offset = reloc_cursor;
-            if !relocs.is_empty() {
-                let reloc_dst = reloc_region_start + reloc_offset;
-                mapped[reloc_dst..reloc_dst + reloc_bytes_len].copy_from_slice(as_bytes_slice(&relocs));
-            }
-
-            let trap_offset = reloc_cursor + reloc_bytes_len;
-            if !traps.is_empty() {
-                let trap_dst = reloc_region_start + trap_offset;
-                mapped[trap_dst..trap_dst + trap_bytes_len].copy_from_slice(as_bytes_slice(&traps));
-            }
-
-            let entry = OutputFunctionEntry {
-                code_offset: u64::try_from(code_offset).map_err(|_| "code offset overflow")?,
-                code_size: u32::try_from(code.len()).map_err(|_| "code size overflow")?,
-                compiled: 1,
-                reloc_offset: u64::try_from(reloc_offset).map_err(|_| "reloc offset overflow")?,
-                reloc_count: u32::try_from(relocs.len()).map_err(|_| "reloc count overflow")?,
-                trap_offset: u64::try_from(trap_offset).map_err(|_| "trap offset overflow")?,
-                trap_count: u32::try_from(traps.len()).map_err(|_| "trap count overflow")?,
-                _pad: 0,
-            };
-            let entry_dst = out_entries_offset + i * size_of::<OutputFunctionEntry>();
-            let entry_bytes = as_bytes_slice(std::slice::from_ref(&entry));
-            mapped[entry_dst..entry_dst + size_of::<OutputFunctionEntry>()].copy_from_slice(entry_bytes);
+    for (i, compiled) in compiled_functions.into_iter().enumerate() {
+        let Some(compiled) = compiled else {
+            continue;
+        };
+        let code = compiled.code;
+        let relocs = compiled.relocs;
+        let traps = compiled.traps;
+        let aligned = (code.len() + 15) & !15;
+        let reloc_bytes_len = relocs.len() * size_of::<HelperReloc>();
+        let trap_bytes_len = traps.len() * size_of::<CraneliftTrap>();
+        if code_cursor + aligned > code_capacity {
+            continue;
+        }
+        if reloc_cursor + reloc_bytes_len + trap_bytes_len > reloc_capacity {
+            continue;
+        }
+        let code_offset = code_cursor;
+        let code_dst = code_base_offset + code_offset;
+        mapped[code_dst..code_dst + code.len()].copy_from_slice(&code);
+
+        let reloc_offset = reloc_cursor;
+        if !relocs.is_empty() {
+            let reloc_dst = reloc_region_start + reloc_offset;
+            mapped[reloc_dst..reloc_dst + reloc_bytes_len].copy_from_slice(as_bytes_slice(&relocs));
+        }
 
-            code_cursor += aligned;
-            reloc_cursor += reloc_bytes_len + trap_bytes_len;
+        let trap_offset = reloc_cursor + reloc_bytes_len;
+        if !traps.is_empty() {
+            let trap_dst = reloc_region_start + trap_offset;
+            mapped[trap_dst..trap_dst + trap_bytes_len].copy_from_slice(as_bytes_slice(&traps));
         }
+
+        let entry = OutputFunctionEntry {
+            code_offset: u64::try_from(code_offset).map_err(|_| "code offset overflow")?,
+            code_size: u32::try_from(code.len()).map_err(|_| "code size overflow")?,
+            compiled: 1,
+            reloc_offset: u64::try_from(reloc_offset).map_err(|_| "reloc offset overflow")?,
+            reloc_count: u32::try_from(relocs.len()).map_err(|_| "reloc count overflow")?,
+            trap_offset: u64::try_from(trap_offset).map_err(|_| "trap offset overflow")?,
+            trap_count: u32::try_from(traps.len()).map_err(|_| "trap count overflow")?,
+            _pad: 0,
+        };
+        let entry_dst = out_entries_offset + i * size_of::<OutputFunctionEntry>();
+        let entry_bytes = as_bytes_slice(std::slice::from_ref(&entry));
+        mapped[entry_dst..entry_dst + size_of::<OutputFunctionEntry>()].copy_from_slice(entry_bytes);
+
+        code_cursor += aligned;
+        reloc_cursor += reloc_bytes_len + trap_bytes_len;
     }
 
     #[cfg(all(unix, not(target_os = "macos")))]
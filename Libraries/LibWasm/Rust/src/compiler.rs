@@ -16,6 +16,8 @@ use cranelift_codegen::FinalizedRelocTarget;
 use cranelift_codegen::binemit::Reloc;
 use cranelift_codegen::ir::AbiParam;
 use cranelift_codegen::ir::Block;
+use cranelift_codegen::ir::ConstantData;
+use cranelift_codegen::ir::Endianness;
 use cranelift_codegen::ir::ExtFuncData;
 use cranelift_codegen::ir::ExternalName;
 use cranelift_codegen::ir::Function;
@@ -51,11 +53,13 @@ const CALLREC_BASE: u8 = 9;
 
 /// The `Int` bank is always defined.
 /// The `F64` bank is trusted only until the next control-flow merge, where it may be undefined on an incoming edge.
+/// The same goes for `V128`, whose values are also kept as two i64 halves in the `Int` bank (and its high-half twin).
 #[derive(Debug, Clone, Copy, PartialEq, Eq)]
 enum Bank {
     Int,
     F32,
     F64,
+    V128,
 }
 
 /// Control flow frame tracking for structured control flow.
@@ -204,6 +208,14 @@ impl CraneliftCompiler {
             mem_grow_sig:      i32 fn(ptr, i32, i32);
             call_wr_sig:       i32 fn(ptr, ptr, i32);
             set_trap_sig:      void fn(ptr, ptr, i32);
+            call_ref_sig:      i32 fn(ptr, ptr, i32, i64, i64);
+            ref_func_sig:      void fn(ptr, i32);
+            table_get_sig:     i32 fn(ptr, ptr, i32, i32);
+            table_set_sig:     i32 fn(ptr, ptr, i32, i32, i64, i64);
+            table_size_sig:    i32 fn(ptr, i32);
+            table_grow_sig:    i32 fn(ptr, i32, i32, i64, i64);
+            table_fill_sig:    i32 fn(ptr, ptr, i32, i32, i64, i64, i32);
+            throw_sig:         i32 fn(ptr, ptr, i32);
         }
 
         // Declare each runtime helper as an imported external function. At every use site
@@ -236,6 +248,17 @@ impl CraneliftCompiler {
         let h_memory_copy = decl_helper!(memory_copy_sig, HelperId::memory_copy);
         let h_memory_fill = decl_helper!(memory_fill_sig, HelperId::memory_fill);
         let h_primitive_storage_cage_base = decl_helper!(cage_base_sig, HelperId::primitive_storage_cage_base);
+        let h_return_call = decl_helper!(call_fn_sig, HelperId::return_call);
+        let h_return_call_indirect = decl_helper!(call_indirect_sig, HelperId::return_call_indirect);
+        let h_call_ref = decl_helper!(call_ref_sig, HelperId::call_ref);
+        let h_return_call_ref = decl_helper!(call_ref_sig, HelperId::return_call_ref);
+        let h_ref_func = decl_helper!(ref_func_sig, HelperId::ref_func);
+        let h_table_get = decl_helper!(table_get_sig, HelperId::table_get);
+        let h_table_set = decl_helper!(table_set_sig, HelperId::table_set);
+        let h_table_size = decl_helper!(table_size_sig, HelperId::table_size);
+        let h_table_grow = decl_helper!(table_grow_sig, HelperId::table_grow);
+        let h_table_fill = decl_helper!(table_fill_sig, HelperId::table_fill);
+        let h_throw = decl_helper!(throw_sig, HelperId::throw_exception);
         let locals_base_offset = helpers.locals_base_offset as i32;
         let memory_instances_offset = helpers.memory_instances_offset as i32;
         let global_instances_offset = helpers.global_instances_offset as i32;
@@ -262,7 +285,7 @@ impl CraneliftCompiler {
                 .ins()
                 .load(ptr_type, MemFlags::trusted(), configuration_val, locals_base_offset);
         builder.def_var(locals_base_var, initial_locals_base);
-        let is_scalar_memory_access = |opcode: u64| {
+        let is_memory_access = |opcode: u64| {
             matches!(
                 opcode,
                 op::I32_LOAD
@@ -290,11 +313,13 @@ impl CraneliftCompiler {
                     | op::I64_STORE32
                     | op::SYNTHETIC_I32_STORELOCAL
                     | op::SYNTHETIC_I64_STORELOCAL
+                    | op::V128_LOAD..=op::V128_STORE
+                    | op::V128_LOAD8_LANE..=op::V128_LOAD64_ZERO
             )
         };
         let mut used_memory_indices: Vec<u32> = insns
             .iter()
-            .filter(|insn| is_scalar_memory_access(insn.opcode))
+            .filter(|insn| is_memory_access(insn.opcode))
             .map(|insn| insn.imm3)
             .collect();
         used_memory_indices.sort_unstable();
@@ -367,10 +392,45 @@ impl CraneliftCompiler {
         let mut control_stack: Vec<ControlFrame> = Vec::new();
 
         // Virtual stack, to avoid touching the interpreter-side stack as much as possible.
-        let has_raw_call = insns
-            .iter()
-            .any(|i| i.opcode == op::CALL || i.opcode == op::CALL_INDIRECT);
-        let max_stack_depth = match has_raw_call {
+        let has_raw_call = insns.iter().any(|i| {
+            matches!(
+                i.opcode,
+                op::CALL
+                    | op::CALL_INDIRECT
+                    | op::CALL_REF
+                    | op::RETURN_CALL
+                    | op::RETURN_CALL_INDIRECT
+                    | op::RETURN_CALL_REF
+                    | op::THROW
+            )
+        });
+        // Functions that work with v128 values or references keep every value in a full 16-byte slot: registers carry
+        // a high half next to the i64 payload, and the value stack stays in memory instead of in i64 SSA variables.
+        // The validator only lets such values into functions that have a v128 or reference local, a SIMD instruction
+        // or a reference instruction.
+        const V128_KIND: u8 = 4;
+        const FIRST_REFERENCE_KIND: u8 = 7;
+        let is_wide_kind = |kind: u8| kind == V128_KIND || kind >= FIRST_REFERENCE_KIND;
+        let has_wide_values = local_types.iter().any(|&kind| is_wide_kind(kind))
+            || insns.iter().any(|i| {
+                matches!(
+                    i.opcode,
+                    op::V128_LOAD..=op::I32X4_RELAXED_DOT_I8X16_I7X16_ADD_S
+                        | op::REF_NULL
+                        | op::REF_FUNC
+                        | op::REF_IS_NULL
+                        | op::REF_AS_NON_NULL
+                        | op::REF_EQ
+                        | op::TABLE_GET
+                        | op::TABLE_SET
+                        | op::TABLE_GROW
+                        | op::TABLE_FILL
+                        | op::CALL_REF
+                        | op::RETURN_CALL_REF
+                )
+            });
+        let uses_real_stack = has_raw_call || has_wide_values;
+        let max_stack_depth = match uses_real_stack {
             true => 0,
             // We can't easily track across control flow merges, so count dests instead.
             false => insns.iter().filter(|i| i.destination == STACK_MARKER).count().max(16),
@@ -422,9 +482,36 @@ impl CraneliftCompiler {
                 v
             })
             .collect();
+        // High halves of R0-R7 and the V128 bank; only used (and defined) when the function has v128 values.
+        let reg_vars_hi: [Variable; REG_COUNT] = std::array::from_fn(|_| {
+            let v = Variable::from_u32(next_var_id);
+            next_var_id += 1;
+            builder.declare_var(v, types::I64);
+            v
+        });
+        let reg_vars_v128: [Variable; REG_COUNT] = std::array::from_fn(|_| {
+            let v = Variable::from_u32(next_var_id);
+            next_var_id += 1;
+            builder.declare_var(v, types::I8X16);
+            v
+        });
+        if has_wide_values {
+            for (i, var) in reg_vars_hi.iter().enumerate() {
+                let offset = regs_offset + (i as i32) * value_size + 8;
+                let val = builder
+                    .ins()
+                    .load(types::I64, MemFlags::trusted(), configuration_val, offset);
+                builder.def_var(*var, val);
+            }
+        }
         let mut reg_ty = [Bank::Int; REG_COUNT];
         let mut stack_ty = vec![Bank::Int; max_stack_depth];
 
+        // Lane reinterpretation between vector types, which cranelift wants an explicit byte order for.
+        let vector_flags = MemFlags::new().with_endianness(Endianness::Little);
+        // Interpreter-owned value slots aren't known to be 16-byte aligned, so vector accesses to them are unaligned.
+        let vector_slot_flags = MemFlags::new().with_notrap();
+
         const F32_KIND: u8 = 2;
         const F64_KIND: u8 = 3;
         let num_locals = num_locals as usize;
@@ -435,6 +522,38 @@ impl CraneliftCompiler {
         let local_is_f32: Vec<bool> = (0..num_locals)
             .map(|i| local_types.get(i).copied() == Some(F32_KIND))
             .collect();
+        // References are stored like v128 locals, as they need both halves of the value.
+        let local_is_wide: Vec<bool> = (0..num_locals)
+            .map(|i| local_types.get(i).copied().is_some_and(is_wide_kind))
+            .collect();
+        // The high half of a default-initialized local, i.e. the typed null for references (see Value(ValueType)).
+        let local_default_high = |i: usize| -> i64 {
+            match local_types.get(i).copied() {
+                Some(7 | 8) => 2,
+                Some(9 | 10) => 3,
+                Some(17 | 18) => 4,
+                Some(kind) if kind >= FIRST_REFERENCE_KIND => 8,
+                _ => 0,
+            }
+        };
+        let local_var_type = |i: usize| {
+            if local_is_wide[i] {
+                types::I8X16
+            } else if local_is_f64[i] {
+                types::F64
+            } else if local_is_f32[i] {
+                types::F32
+            } else {
+                types::I64
+            }
+        };
+        let local_load_flags = |i: usize| {
+            if local_is_wide[i] {
+                vector_slot_flags
+            } else {
+                MemFlags::trusted()
+            }
+        };
 
         // Promoting wasm locals to SSA variables keeps them in registers, which is a win only
         // as long as they actually fit. Functions with more locals than the machine has usable
@@ -462,34 +581,25 @@ impl CraneliftCompiler {
         };
         let mut dirty_locals = vec![false; num_locals];
         for (i, var) in local_vars.iter().enumerate() {
-            let ty = if local_is_f64[i] {
-                types::F64
-            } else if local_is_f32[i] {
-                types::F32
-            } else {
-                types::I64
-            };
-            builder.declare_var(*var, ty);
+            builder.declare_var(*var, local_var_type(i));
         }
 
         // set_frame_lightweight verifies the stack-usage hint before these unchecked operations.
-        macro_rules! emit_stack_push {
-            ($builder:expr, $val:expr) => {{
-                let v = $val;
+        // Both evaluate to the address of the pushed/popped slot.
+        macro_rules! emit_stack_push_slot {
+            ($builder:expr) => {{
                 let cfg = $builder.use_var(config_var);
                 let top = $builder
                     .ins()
                     .load(ptr_type, MemFlags::trusted(), cfg, value_stack_top_offset);
-                $builder.ins().store(MemFlags::trusted(), v, top, 0);
-                let zero_tag = $builder.ins().iconst(types::I64, 0);
-                $builder.ins().store(MemFlags::trusted(), zero_tag, top, 8);
                 let new_top = $builder.ins().iadd_imm(top, i64::from(value_size));
                 $builder
                     .ins()
                     .store(MemFlags::trusted(), new_top, cfg, value_stack_top_offset);
+                top
             }};
         }
-        macro_rules! emit_stack_pop {
+        macro_rules! emit_stack_pop_slot {
             ($builder:expr) => {{
                 let cfg = $builder.use_var(config_var);
                 let top = $builder
@@ -499,7 +609,22 @@ impl CraneliftCompiler {
                 $builder
                     .ins()
                     .store(MemFlags::trusted(), new_top, cfg, value_stack_top_offset);
-                $builder.ins().load(types::I64, MemFlags::trusted(), new_top, 0)
+                new_top
+            }};
+        }
+        macro_rules! emit_stack_push {
+            ($builder:expr, $val:expr) => {{
+                let v = $val;
+                let slot = emit_stack_push_slot!($builder);
+                $builder.ins().store(MemFlags::trusted(), v, slot, 0);
+                let zero_tag = $builder.ins().iconst(types::I64, 0);
+                $builder.ins().store(MemFlags::trusted(), zero_tag, slot, 8);
+            }};
+        }
+        macro_rules! emit_stack_pop {
+            ($builder:expr) => {{
+                let slot = emit_stack_pop_slot!($builder);
+                $builder.ins().load(types::I64, MemFlags::trusted(), slot, 0)
             }};
         }
         macro_rules! emit_stack_size {
@@ -549,7 +674,7 @@ impl CraneliftCompiler {
             }};
         }
 
-        if has_raw_call {
+        if uses_real_stack {
             let initial_stack_size = emit_stack_size!(builder);
             builder.def_var(initial_stack_size_var, initial_stack_size);
         } else {
@@ -634,12 +759,23 @@ impl CraneliftCompiler {
             }};
         }
 
+        // A scalar written to a register must not leave a stale high half behind for a later 128-bit move.
+        macro_rules! clear_reg_hi {
+            ($builder:expr, $dst:expr) => {{
+                if has_wide_values {
+                    let zero = $builder.ins().iconst(types::I64, 0);
+                    $builder.def_var(reg_vars_hi[$dst as usize], zero);
+                }
+            }};
+        }
+
         macro_rules! write_dst {
             ($builder:expr, $dst:expr, $val:expr) => {{
                 let dst = $dst;
                 let val = $val;
                 if dst < STACK_MARKER {
                     $builder.def_var(reg_vars[dst as usize], val);
+                    clear_reg_hi!($builder, dst);
                     reg_ty[dst as usize] = Bank::Int;
                     dirty_regs[dst as usize] = true;
                 } else if dst == STACK_MARKER {
@@ -706,6 +842,7 @@ impl CraneliftCompiler {
                 if dst < STACK_MARKER {
                     $builder.def_var(reg_vars_f64[dst as usize], val);
                     $builder.def_var(reg_vars[dst as usize], bits);
+                    clear_reg_hi!($builder, dst);
                     reg_ty[dst as usize] = Bank::F64;
                     dirty_regs[dst as usize] = true;
                 } else if dst == STACK_MARKER {
@@ -778,6 +915,7 @@ impl CraneliftCompiler {
                 if dst < STACK_MARKER {
                     $builder.def_var(reg_vars_f32[dst as usize], val);
                     $builder.def_var(reg_vars[dst as usize], bits);
+                    clear_reg_hi!($builder, dst);
                     reg_ty[dst as usize] = Bank::F32;
                     dirty_regs[dst as usize] = true;
                 } else if dst == STACK_MARKER {
@@ -813,6 +951,147 @@ impl CraneliftCompiler {
             }};
         }
 
+        // v128 values are I8X16 at rest; operations bitcast to the lane shape they need.
+        macro_rules! vcast {
+            ($builder:expr, $ty:expr, $val:expr) => {{
+                let val = $val;
+                let ty = $ty;
+                if $builder.func.dfg.value_type(val) == ty {
+                    val
+                } else {
+                    $builder.ins().bitcast(ty, vector_flags, val)
+                }
+            }};
+        }
+        macro_rules! v128_const {
+            ($builder:expr, $bytes:expr) => {{
+                let bytes: [u8; 16] = $bytes;
+                let constant = $builder.func.dfg.constants.insert(ConstantData::from(&bytes[..]));
+                $builder.ins().vconst(types::I8X16, constant)
+            }};
+        }
+        macro_rules! v128_from_halves {
+            ($builder:expr, $lo:expr, $hi:expr) => {{
+                let lo = $lo;
+                let hi = $hi;
+                let v = $builder.ins().scalar_to_vector(types::I64X2, lo);
+                let v = $builder.ins().insertlane(v, hi, 1);
+                vcast!($builder, types::I8X16, v)
+            }};
+        }
+        macro_rules! v128_halves {
+            ($builder:expr, $val:expr) => {{
+                let v = vcast!($builder, types::I64X2, $val);
+                let lo = $builder.ins().extractlane(v, 0);
+                let hi = $builder.ins().extractlane(v, 1);
+                (lo, hi)
+            }};
+        }
+        macro_rules! call_record_slot {
+            ($builder:expr, $index:expr) => {{
+                let cfg = $builder.use_var(config_var);
+                let base = $builder
+                    .ins()
+                    .load(ptr_type, MemFlags::trusted(), cfg, call_record_base_offset);
+                $builder
+                    .ins()
+                    .iadd_imm(base, i64::from(i32::from($index - CALLREC_BASE) * value_size))
+            }};
+        }
+
+        // Only functions with has_wide_values set read or write full 128-bit values, so the value stack is never virtual here.
+        macro_rules! read_src_v128 {
+            ($builder:expr, $src:expr, $ty:expr) => {{
+                let v = read_src_v128!($builder, $src);
+                vcast!($builder, $ty, v)
+            }};
+            ($builder:expr, $src:expr) => {{
+                let src = $src;
+                debug_assert!(has_wide_values && max_stack_depth == 0);
+                if src < STACK_MARKER {
+                    if reg_ty[src as usize] == Bank::V128 {
+                        $builder.use_var(reg_vars_v128[src as usize])
+                    } else {
+                        let lo = $builder.use_var(reg_vars[src as usize]);
+                        let hi = $builder.use_var(reg_vars_hi[src as usize]);
+                        v128_from_halves!($builder, lo, hi)
+                    }
+                } else {
+                    let slot = if src == STACK_MARKER {
+                        emit_stack_pop_slot!($builder)
+                    } else {
+                        call_record_slot!($builder, src)
+                    };
+                    $builder.ins().load(types::I8X16, vector_slot_flags, slot, 0)
+                }
+            }};
+        }
+        macro_rules! write_dst_v128 {
+            ($builder:expr, $dst:expr, $val:expr) => {{
+                let dst = $dst;
+                let val = vcast!($builder, types::I8X16, $val);
+                debug_assert!(has_wide_values && max_stack_depth == 0);
+                if dst < STACK_MARKER {
+                    let (lo, hi) = v128_halves!($builder, val);
+                    $builder.def_var(reg_vars_v128[dst as usize], val);
+                    $builder.def_var(reg_vars[dst as usize], lo);
+                    $builder.def_var(reg_vars_hi[dst as usize], hi);
+                    reg_ty[dst as usize] = Bank::V128;
+                    dirty_regs[dst as usize] = true;
+                } else {
+                    let slot = if dst == STACK_MARKER {
+                        emit_stack_push_slot!($builder)
+                    } else {
+                        call_record_slot!($builder, dst)
+                    };
+                    $builder.ins().store(vector_slot_flags, val, slot, 0);
+                }
+            }};
+        }
+        // Untyped moves (globals, select, call results) in has_wide_values functions carry both halves of the value along.
+        macro_rules! read_src_pair {
+            ($builder:expr, $src:expr) => {{
+                let src = $src;
+                debug_assert!(has_wide_values && max_stack_depth == 0);
+                if src < STACK_MARKER {
+                    let lo = $builder.use_var(reg_vars[src as usize]);
+                    let hi = $builder.use_var(reg_vars_hi[src as usize]);
+                    (lo, hi)
+                } else {
+                    let slot = if src == STACK_MARKER {
+                        emit_stack_pop_slot!($builder)
+                    } else {
+                        call_record_slot!($builder, src)
+                    };
+                    let lo = $builder.ins().load(types::I64, MemFlags::trusted(), slot, 0);
+                    let hi = $builder.ins().load(types::I64, MemFlags::trusted(), slot, 8);
+                    (lo, hi)
+                }
+            }};
+        }
+        macro_rules! write_dst_pair {
+            ($builder:expr, $dst:expr, $lo:expr, $hi:expr) => {{
+                let dst = $dst;
+                let lo = $lo;
+                let hi = $hi;
+                debug_assert!(has_wide_values && max_stack_depth == 0);
+                if dst < STACK_MARKER {
+                    $builder.def_var(reg_vars[dst as usize], lo);
+                    $builder.def_var(reg_vars_hi[dst as usize], hi);
+                    reg_ty[dst as usize] = Bank::Int;
+                    dirty_regs[dst as usize] = true;
+                } else {
+                    let slot = if dst == STACK_MARKER {
+                        emit_stack_push_slot!($builder)
+                    } else {
+                        call_record_slot!($builder, dst)
+                    };
+                    $builder.ins().store(MemFlags::trusted(), lo, slot, 0);
+                    $builder.ins().store(MemFlags::trusted(), hi, slot, 8);
+                }
+            }};
+        }
+
         // Note that all reads from sources have to be in order (sources[0] before sources[1])
         macro_rules! i32_binop {
             ($builder:expr, $insn:expr, $op:ident) => {{
@@ -917,13 +1196,128 @@ impl CraneliftCompiler {
                 write_dst!($builder, $insn.destination, result);
             }};
         }
+        macro_rules! v128_binop {
+            ($builder:expr, $insn:expr, $ty:expr, $op:ident) => {{
+                let rhs = read_src_v128!($builder, $insn.sources[0], $ty);
+                let lhs = read_src_v128!($builder, $insn.sources[1], $ty);
+                let result = $builder.ins().$op(lhs, rhs);
+                write_dst_v128!($builder, $insn.destination, result);
+            }};
+        }
+        macro_rules! v128_unop {
+            ($builder:expr, $insn:expr, $ty:expr, $op:ident) => {{
+                let src = read_src_v128!($builder, $insn.sources[0], $ty);
+                let result = $builder.ins().$op(src);
+                write_dst_v128!($builder, $insn.destination, result);
+            }};
+        }
+        macro_rules! v128_icmp {
+            ($builder:expr, $insn:expr, $ty:expr, $cc:expr) => {{
+                let rhs = read_src_v128!($builder, $insn.sources[0], $ty);
+                let lhs = read_src_v128!($builder, $insn.sources[1], $ty);
+                let result = $builder.ins().icmp($cc, lhs, rhs);
+                write_dst_v128!($builder, $insn.destination, result);
+            }};
+        }
+        macro_rules! v128_fcmp {
+            ($builder:expr, $insn:expr, $ty:expr, $cc:expr) => {{
+                let rhs = read_src_v128!($builder, $insn.sources[0], $ty);
+                let lhs = read_src_v128!($builder, $insn.sources[1], $ty);
+                let result = $builder.ins().fcmp($cc, lhs, rhs);
+                write_dst_v128!($builder, $insn.destination, result);
+            }};
+        }
+        // Cranelift masks the shift amount to the lane width, as wasm wants.
+        macro_rules! v128_shift {
+            ($builder:expr, $insn:expr, $ty:expr, $op:ident) => {{
+                let amount_raw = read_src!($builder, $insn.sources[0]);
+                let amount = $builder.ins().ireduce(types::I32, amount_raw);
+                let src = read_src_v128!($builder, $insn.sources[1], $ty);
+                let result = $builder.ins().$op(src, amount);
+                write_dst_v128!($builder, $insn.destination, result);
+            }};
+        }
+        // vany_true/vall_true produce an i8 flag.
+        macro_rules! v128_test {
+            ($builder:expr, $insn:expr, $ty:expr, $op:ident) => {{
+                let src = read_src_v128!($builder, $insn.sources[0], $ty);
+                let flag = $builder.ins().$op(src);
+                let result = $builder.ins().uextend(types::I64, flag);
+                write_dst!($builder, $insn.destination, result);
+            }};
+        }
+        macro_rules! v128_bitmask {
+            ($builder:expr, $insn:expr, $ty:expr) => {{
+                let src = read_src_v128!($builder, $insn.sources[0], $ty);
+                let mask = $builder.ins().vhigh_bits(types::I32, src);
+                let result = $builder.ins().uextend(types::I64, mask);
+                write_dst!($builder, $insn.destination, result);
+            }};
+        }
+        macro_rules! v128_widen {
+            ($builder:expr, $insn:expr, $ty:expr, $op:ident) => {{
+                let src = read_src_v128!($builder, $insn.sources[0], $ty);
+                let result = $builder.ins().$op(src);
+                write_dst_v128!($builder, $insn.destination, result);
+            }};
+        }
+        // Lane-wise product of the low or high halves of both operands, widened to twice the lane width.
+        macro_rules! v128_extmul {
+            ($builder:expr, $insn:expr, $ty:expr, $widen:ident) => {{
+                let rhs = read_src_v128!($builder, $insn.sources[0], $ty);
+                let lhs = read_src_v128!($builder, $insn.sources[1], $ty);
+                let lhs = $builder.ins().$widen(lhs);
+                let rhs = $builder.ins().$widen(rhs);
+                let result = $builder.ins().imul(lhs, rhs);
+                write_dst_v128!($builder, $insn.destination, result);
+            }};
+        }
+        macro_rules! v128_extadd_pairwise {
+            ($builder:expr, $insn:expr, $ty:expr, $widen_low:ident, $widen_high:ident) => {{
+                let src = read_src_v128!($builder, $insn.sources[0], $ty);
+                let low = $builder.ins().$widen_low(src);
+                let high = $builder.ins().$widen_high(src);
+                let result = $builder.ins().iadd_pairwise(low, high);
+                write_dst_v128!($builder, $insn.destination, result);
+            }};
+        }
+        // Sums of adjacent products of sign-extended lanes, as used by the dot product instructions.
+        macro_rules! v128_dot {
+            ($builder:expr, $lhs:expr, $rhs:expr) => {{
+                let lhs = $lhs;
+                let rhs = $rhs;
+                let lhs_low = $builder.ins().swiden_low(lhs);
+                let rhs_low = $builder.ins().swiden_low(rhs);
+                let low = $builder.ins().imul(lhs_low, rhs_low);
+                let lhs_high = $builder.ins().swiden_high(lhs);
+                let rhs_high = $builder.ins().swiden_high(rhs);
+                let high = $builder.ins().imul(lhs_high, rhs_high);
+                $builder.ins().iadd_pairwise(low, high)
+            }};
+        }
+        macro_rules! v128_extract_lane {
+            ($builder:expr, $insn:expr, $ty:expr) => {{
+                let src = read_src_v128!($builder, $insn.sources[0], $ty);
+                $builder.ins().extractlane(src, $insn.imm1 as u8)
+            }};
+        }
+        macro_rules! v128_replace_lane {
+            ($builder:expr, $insn:expr, $ty:expr, $val:expr) => {{
+                let val = $val;
+                let src = read_src_v128!($builder, $insn.sources[1], $ty);
+                let result = $builder.ins().insertlane(src, val, $insn.imm1 as u8);
+                write_dst_v128!($builder, $insn.destination, result);
+            }};
+        }
 
         macro_rules! read_local_inline {
             ($builder:expr, $idx_imm:expr) => {{
                 let idx = ($idx_imm) as usize;
                 if idx < local_vars.len() {
                     let v = $builder.use_var(local_vars[idx]);
-                    if local_is_f64[idx] {
+                    if local_is_wide[idx] {
+                        v128_halves!($builder, v).0
+                    } else if local_is_f64[idx] {
                         $builder.ins().bitcast(types::I64, MemFlags::new(), v)
                     } else if local_is_f32[idx] {
                         let bits32 = $builder.ins().bitcast(types::I32, MemFlags::new(), v);
@@ -977,7 +1371,10 @@ impl CraneliftCompiler {
                 let idx = ($idx_imm) as usize;
                 let v = $val;
                 if idx < local_vars.len() {
-                    let stored = if local_is_f64[idx] {
+                    let stored = if local_is_wide[idx] {
+                        let zero = $builder.ins().iconst(types::I64, 0);
+                        v128_from_halves!($builder, v, zero)
+                    } else if local_is_f64[idx] {
                         $builder.ins().bitcast(types::F64, MemFlags::new(), v)
                     } else if local_is_f32[idx] {
                         let v32 = $builder.ins().ireduce(types::I32, v);
@@ -1030,10 +1427,41 @@ impl CraneliftCompiler {
                 }
             }};
         }
+        macro_rules! read_local_v128 {
+            ($builder:expr, $idx_imm:expr) => {{
+                let idx = ($idx_imm) as usize;
+                if idx < local_vars.len() {
+                    $builder.use_var(local_vars[idx])
+                } else {
+                    let lb = $builder.use_var(locals_base_var);
+                    $builder
+                        .ins()
+                        .load(types::I8X16, vector_slot_flags, lb, (idx as i32) * value_size)
+                }
+            }};
+        }
+        macro_rules! write_local_v128 {
+            ($builder:expr, $idx_imm:expr, $val:expr) => {{
+                let idx = ($idx_imm) as usize;
+                let v = vcast!($builder, types::I8X16, $val);
+                if idx < local_vars.len() {
+                    $builder.def_var(local_vars[idx], v);
+                    dirty_locals[idx] = true;
+                } else {
+                    let lb = $builder.use_var(locals_base_var);
+                    $builder
+                        .ins()
+                        .store(vector_slot_flags, v, lb, (idx as i32) * value_size);
+                }
+            }};
+        }
         macro_rules! local_get {
             ($builder:expr, $idx_imm:expr, $dst:expr) => {{
                 let idx = ($idx_imm) as usize;
-                if idx < local_vars.len() && local_is_f64[idx] {
+                if local_is_wide.get(idx) == Some(&true) {
+                    let result = read_local_v128!($builder, $idx_imm);
+                    write_dst_v128!($builder, $dst, result);
+                } else if idx < local_vars.len() && local_is_f64[idx] {
                     let result = read_local_f64!($builder, $idx_imm);
                     write_dst_f64!($builder, $dst, result);
                 } else if idx < local_vars.len() && local_is_f32[idx] {
@@ -1048,7 +1476,10 @@ impl CraneliftCompiler {
         macro_rules! local_set {
             ($builder:expr, $idx_imm:expr, $src:expr) => {{
                 let idx = ($idx_imm) as usize;
-                if idx < local_vars.len() && local_is_f64[idx] {
+                if local_is_wide.get(idx) == Some(&true) {
+                    let val = read_src_v128!($builder, $src);
+                    write_local_v128!($builder, $idx_imm, val);
+                } else if idx < local_vars.len() && local_is_f64[idx] {
                     let val = read_src_f64!($builder, $src);
                     write_local_f64!($builder, $idx_imm, val);
                 } else if idx < local_vars.len() && local_is_f32[idx] {
@@ -1069,13 +1500,17 @@ impl CraneliftCompiler {
                             continue;
                         }
                         let v = $builder.use_var(local_vars[i]);
+                        let offset = (i as i32) * value_size;
+                        if local_is_wide[i] {
+                            $builder.ins().store(vector_slot_flags, v, lb, offset);
+                            continue;
+                        }
                         let stored = if local_is_f32[i] {
                             let bits32 = $builder.ins().bitcast(types::I32, MemFlags::new(), v);
                             $builder.ins().sextend(types::I64, bits32)
                         } else {
                             v
                         };
-                        let offset = (i as i32) * value_size;
                         $builder.ins().store(MemFlags::trusted(), stored, lb, offset);
                         let zero = $builder.ins().iconst(types::I64, 0);
                         $builder.ins().store(MemFlags::trusted(), zero, lb, offset + 8);
@@ -1124,6 +1559,53 @@ impl CraneliftCompiler {
                     .call_indirect(set_trap_sig, st_ptr, &[interp, msg_ptr, msg_len]);
             }};
         }
+        // Helpers that produce a reference leave it in the call result scratch slot.
+        macro_rules! load_call_result_pair {
+            ($builder:expr) => {{
+                let cv = $builder.use_var(config_var);
+                let lo = $builder.ins().load(
+                    types::I64,
+                    MemFlags::trusted(),
+                    cv,
+                    compiled_call_result_scratch_offset,
+                );
+                let hi = $builder.ins().load(
+                    types::I64,
+                    MemFlags::trusted(),
+                    cv,
+                    compiled_call_result_scratch_offset + 8,
+                );
+                (lo, hi)
+            }};
+        }
+        // The helpers for CALL, CALL_INDIRECT and CALL_REF push the result to the value stack; pop it to the actual destination.
+        macro_rules! pop_call_result {
+            ($builder:expr, $dst:expr) => {{
+                let dst = $dst;
+                if dst != STACK_MARKER && has_wide_values {
+                    let slot = emit_stack_pop_slot!($builder);
+                    let lo = $builder.ins().load(types::I64, MemFlags::trusted(), slot, 0);
+                    let hi = $builder.ins().load(types::I64, MemFlags::trusted(), slot, 8);
+                    write_dst_pair!($builder, dst, lo, hi);
+                } else if dst != STACK_MARKER {
+                    let result = emit_stack_pop!($builder);
+                    write_dst!($builder, dst, result);
+                }
+            }};
+        }
+        // Only null references have one of these high halves, see Value(Reference const&).
+        macro_rules! ref_is_null {
+            ($builder:expr, $hi:expr) => {{
+                let hi = $hi;
+                let mut is_null = $builder.ins().icmp_imm(IntCC::Equal, hi, 2);
+                for tag in [3i64, 4, 8] {
+                    let has_tag = $builder.ins().icmp_imm(IntCC::Equal, hi, tag);
+                    is_null = $builder.ins().bor(is_null, has_tag);
+                }
+                is_null
+            }};
+        }
+
         // No bounds checks: the memory reserves the full base (u32) + offset (u32) span, so any
         // out-of-bounds access faults on an uncommitted page and unwinds as a wasm trap.
         macro_rules! inline_memory_address {
@@ -1158,24 +1640,26 @@ impl CraneliftCompiler {
                         let zero = $builder.ins().iconst(types::I64, 0);
                         for i in num_params..num_locals {
                             let offset = (i as i32) * value_size;
+                            let high = match local_default_high(i) {
+                                0 => zero,
+                                high => $builder.ins().iconst(types::I64, high),
+                            };
                             $builder.ins().store(MemFlags::trusted(), zero, lb, offset);
-                            $builder.ins().store(MemFlags::trusted(), zero, lb, offset + 8);
+                            $builder.ins().store(MemFlags::trusted(), high, lb, offset + 8);
                         }
                     }
                 } else {
                     let lb = $builder.use_var(locals_base_var);
                     for (i, var) in local_vars.iter().enumerate() {
                         if i < num_params {
-                            let ty = if local_is_f64[i] {
-                                types::F64
-                            } else if local_is_f32[i] {
-                                types::F32
-                            } else {
-                                types::I64
-                            };
                             let offset = (i as i32) * value_size;
-                            let val = $builder.ins().load(ty, MemFlags::trusted(), lb, offset);
+                            let val = $builder.ins().load(local_var_type(i), local_load_flags(i), lb, offset);
                             $builder.def_var(*var, val);
+                        } else if local_is_wide[i] {
+                            let mut bytes = [0; 16];
+                            bytes[8..].copy_from_slice(&local_default_high(i).to_le_bytes());
+                            let default = v128_const!($builder, bytes);
+                            $builder.def_var(*var, default);
                         } else if local_is_f64[i] {
                             let zero = $builder.ins().f64const(0.0);
                             $builder.def_var(*var, zero);
@@ -1195,15 +1679,8 @@ impl CraneliftCompiler {
                 if !local_vars.is_empty() {
                     let lb = $builder.use_var(locals_base_var);
                     for (i, var) in local_vars.iter().enumerate() {
-                        let ty = if local_is_f64[i] {
-                            types::F64
-                        } else if local_is_f32[i] {
-                            types::F32
-                        } else {
-                            types::I64
-                        };
                         let offset = (i as i32) * value_size;
-                        let val = $builder.ins().load(ty, MemFlags::trusted(), lb, offset);
+                        let val = $builder.ins().load(local_var_type(i), local_load_flags(i), lb, offset);
                         $builder.def_var(*var, val);
                     }
                 }
@@ -1253,6 +1730,7 @@ impl CraneliftCompiler {
                     Self::sync_regs_to_config(
                         &mut builder,
                         &reg_vars,
+                        has_wide_values.then_some(&reg_vars_hi),
                         config_var,
                         regs_offset,
                         value_size,
@@ -1567,7 +2045,11 @@ impl CraneliftCompiler {
                 }
                 op::LOCAL_TEE | op::SYNTHETIC_ARGUMENT_TEE => {
                     let idx = insn.imm1 as usize;
-                    if idx < local_vars.len() && local_is_f64[idx] {
+                    if local_is_wide.get(idx) == Some(&true) {
+                        let val = read_src_v128!(builder, insn.sources[0]);
+                        write_local_v128!(builder, insn.imm1, val);
+                        write_dst_v128!(builder, insn.destination, val);
+                    } else if idx < local_vars.len() && local_is_f64[idx] {
                         let val = read_src_f64!(builder, insn.sources[0]);
                         write_local_f64!(builder, insn.imm1, val);
                         write_dst_f64!(builder, insn.destination, val);
@@ -1591,10 +2073,35 @@ impl CraneliftCompiler {
                     local_set!(builder, local_idx, insn.sources[0]);
                 }
                 op::SYNTHETIC_LOCAL_COPY => {
-                    let val = read_local_inline!(builder, insn.imm1);
-                    write_local_inline!(builder, insn.imm2, val);
+                    if local_is_wide.get(insn.imm1 as usize) == Some(&true) {
+                        let val = read_local_v128!(builder, insn.imm1);
+                        write_local_v128!(builder, insn.imm2, val);
+                    } else {
+                        let val = read_local_inline!(builder, insn.imm1);
+                        write_local_inline!(builder, insn.imm2, val);
+                    }
                 }
 
+                op::GLOBAL_GET if has_wide_values => {
+                    let global = inline_global_instance!(insn.imm1 as u32);
+                    let lo = builder
+                        .ins()
+                        .load(types::I64, MemFlags::trusted(), global, global_instance_value_offset);
+                    let hi = builder
+                        .ins()
+                        .load(types::I64, MemFlags::trusted(), global, global_instance_value_offset + 8);
+                    write_dst_pair!(builder, insn.destination, lo, hi);
+                }
+                op::GLOBAL_SET if has_wide_values => {
+                    let (lo, hi) = read_src_pair!(builder, insn.sources[0]);
+                    let global = inline_global_instance!(insn.imm1 as u32);
+                    builder
+                        .ins()
+                        .store(MemFlags::trusted(), lo, global, global_instance_value_offset);
+                    builder
+                        .ins()
+                        .store(MemFlags::trusted(), hi, global, global_instance_value_offset + 8);
+                }
                 op::GLOBAL_GET => {
                     let global = inline_global_instance!(insn.imm1 as u32);
                     let result =
@@ -1622,6 +2129,15 @@ impl CraneliftCompiler {
                     // No need to do anything if it's not on the real stack.
                 }
 
+                op::SELECT | op::SELECT_TYPED if has_wide_values => {
+                    let cond_raw = read_src!(builder, insn.sources[0]);
+                    let (rhs_lo, rhs_hi) = read_src_pair!(builder, insn.sources[1]);
+                    let (lhs_lo, lhs_hi) = read_src_pair!(builder, insn.sources[2]);
+                    let cond = builder.ins().icmp_imm(IntCC::NotEqual, cond_raw, 0);
+                    let lo = builder.ins().select(cond, lhs_lo, rhs_lo);
+                    let hi = builder.ins().select(cond, lhs_hi, rhs_hi);
+                    write_dst_pair!(builder, insn.destination, lo, hi);
+                }
                 op::SELECT | op::SELECT_TYPED => {
                     let cond_raw = read_src!(builder, insn.sources[0]);
                     let rhs = read_src!(builder, insn.sources[1]);
@@ -2142,6 +2658,510 @@ impl CraneliftCompiler {
                     builder.ins().store(wasm_memory_flags, value, address, 0);
                 }
 
+                op::V128_LOAD..=op::V128_LOAD64_SPLAT | op::V128_LOAD32_ZERO | op::V128_LOAD64_ZERO => {
+                    let base_raw = read_src!(builder, insn.sources[0]);
+                    let base_u32 = builder.ins().ireduce(types::I32, base_raw);
+                    let base_u64 = builder.ins().uextend(types::I64, base_u32);
+                    let offset = builder.ins().iconst(types::I64, insn.imm1);
+                    let addr = builder.ins().iadd(base_u64, offset);
+                    let address = inline_memory_address!(builder, insn.imm3, addr);
+                    let flags = wasm_memory_flags;
+                    let result = match opc {
+                        op::V128_LOAD => builder.ins().load(types::I8X16, flags, address, 0),
+                        op::V128_LOAD8X8_S => builder.ins().sload8x8(flags, address, 0),
+                        op::V128_LOAD8X8_U => builder.ins().uload8x8(flags, address, 0),
+                        op::V128_LOAD16X4_S => builder.ins().sload16x4(flags, address, 0),
+                        op::V128_LOAD16X4_U => builder.ins().uload16x4(flags, address, 0),
+                        op::V128_LOAD32X2_S => builder.ins().sload32x2(flags, address, 0),
+                        op::V128_LOAD32X2_U => builder.ins().uload32x2(flags, address, 0),
+                        op::V128_LOAD8_SPLAT => {
+                            let value = builder.ins().load(types::I8, flags, address, 0);
+                            builder.ins().splat(types::I8X16, value)
+                        }
+                        op::V128_LOAD16_SPLAT => {
+                            let value = builder.ins().load(types::I16, flags, address, 0);
+                            builder.ins().splat(types::I16X8, value)
+                        }
+                        op::V128_LOAD32_SPLAT => {
+                            let value = builder.ins().load(types::I32, flags, address, 0);
+                            builder.ins().splat(types::I32X4, value)
+                        }
+                        op::V128_LOAD64_SPLAT => {
+                            let value = builder.ins().load(types::I64, flags, address, 0);
+                            builder.ins().splat(types::I64X2, value)
+                        }
+                        op::V128_LOAD32_ZERO => {
+                            let value = builder.ins().load(types::I32, flags, address, 0);
+                            builder.ins().scalar_to_vector(types::I32X4, value)
+                        }
+                        op::V128_LOAD64_ZERO => {
+                            let value = builder.ins().load(types::I64, flags, address, 0);
+                            builder.ins().scalar_to_vector(types::I64X2, value)
+                        }
+                        _ => unreachable!(),
+                    };
+                    write_dst_v128!(builder, insn.destination, result);
+                }
+                op::V128_STORE => {
+                    let val = read_src_v128!(builder, insn.sources[0]);
+                    let base_raw = read_src!(builder, insn.sources[1]);
+                    let base_u32 = builder.ins().ireduce(types::I32, base_raw);
+                    let base_u64 = builder.ins().uextend(types::I64, base_u32);
+                    let offset = builder.ins().iconst(types::I64, insn.imm1);
+                    let addr = builder.ins().iadd(base_u64, offset);
+                    let address = inline_memory_address!(builder, insn.imm3, addr);
+                    builder.ins().store(wasm_memory_flags, val, address, 0);
+                }
+                // imm2 is the lane; the vector is on top of the address.
+                op::V128_LOAD8_LANE..=op::V128_STORE64_LANE => {
+                    let (vector_type, lane_type) = match opc {
+                        op::V128_LOAD8_LANE | op::V128_STORE8_LANE => (types::I8X16, types::I8),
+                        op::V128_LOAD16_LANE | op::V128_STORE16_LANE => (types::I16X8, types::I16),
+                        op::V128_LOAD32_LANE | op::V128_STORE32_LANE => (types::I32X4, types::I32),
+                        op::V128_LOAD64_LANE | op::V128_STORE64_LANE => (types::I64X2, types::I64),
+                        _ => unreachable!(),
+                    };
+                    let vector = read_src_v128!(builder, insn.sources[0], vector_type);
+                    let base_raw = read_src!(builder, insn.sources[1]);
+                    let base_u32 = builder.ins().ireduce(types::I32, base_raw);
+                    let base_u64 = builder.ins().uextend(types::I64, base_u32);
+                    let offset = builder.ins().iconst(types::I64, insn.imm1);
+                    let addr = builder.ins().iadd(base_u64, offset);
+                    let address = inline_memory_address!(builder, insn.imm3, addr);
+                    let lane = insn.imm2 as u8;
+                    if opc <= op::V128_LOAD64_LANE {
+                        let value = builder.ins().load(lane_type, wasm_memory_flags, address, 0);
+                        let result = builder.ins().insertlane(vector, value, lane);
+                        write_dst_v128!(builder, insn.destination, result);
+                    } else {
+                        let value = builder.ins().extractlane(vector, lane);
+                        builder.ins().store(wasm_memory_flags, value, address, 0);
+                    }
+                }
+
+                op::V128_CONST => {
+                    let mut bytes = [0u8; 16];
+                    bytes[..8].copy_from_slice(&insn.imm1.to_le_bytes());
+                    bytes[8..].copy_from_slice(&insn.imm2.to_le_bytes());
+                    let result = v128_const!(builder, bytes);
+                    write_dst_v128!(builder, insn.destination, result);
+                }
+                op::I8X16_SHUFFLE => {
+                    let mut lanes = [0u8; 16];
+                    lanes[..8].copy_from_slice(&insn.imm1.to_le_bytes());
+                    lanes[8..].copy_from_slice(&insn.imm2.to_le_bytes());
+                    let mask = builder.func.dfg.immediates.push(ConstantData::from(&lanes[..]));
+                    let rhs = read_src_v128!(builder, insn.sources[0]);
+                    let lhs = read_src_v128!(builder, insn.sources[1]);
+                    let result = builder.ins().shuffle(lhs, rhs, mask);
+                    write_dst_v128!(builder, insn.destination, result);
+                }
+                // Cranelift's swizzle already zeroes out-of-range lanes; the relaxed variant may do the same.
+                op::I8X16_SWIZZLE | op::I8X16_RELAXED_SWIZZLE => v128_binop!(builder, insn, types::I8X16, swizzle),
+
+                op::I8X16_SPLAT | op::I16X8_SPLAT | op::I32X4_SPLAT | op::I64X2_SPLAT => {
+                    let (vector_type, lane_type) = match opc {
+                        op::I8X16_SPLAT => (types::I8X16, types::I8),
+                        op::I16X8_SPLAT => (types::I16X8, types::I16),
+                        op::I32X4_SPLAT => (types::I32X4, types::I32),
+                        _ => (types::I64X2, types::I64),
+                    };
+                    let raw = read_src!(builder, insn.sources[0]);
+                    let value = if lane_type == types::I64 {
+                        raw
+                    } else {
+                        builder.ins().ireduce(lane_type, raw)
+                    };
+                    let result = builder.ins().splat(vector_type, value);
+                    write_dst_v128!(builder, insn.destination, result);
+                }
+                op::F32X4_SPLAT => {
+                    let value = read_src_f32!(builder, insn.sources[0]);
+                    let result = builder.ins().splat(types::F32X4, value);
+                    write_dst_v128!(builder, insn.destination, result);
+                }
+                op::F64X2_SPLAT => {
+                    let value = read_src_f64!(builder, insn.sources[0]);
+                    let result = builder.ins().splat(types::F64X2, value);
+                    write_dst_v128!(builder, insn.destination, result);
+                }
+
+                op::I8X16_EXTRACT_LANE_S | op::I8X16_EXTRACT_LANE_U => {
+                    let lane = v128_extract_lane!(builder, insn, types::I8X16);
+                    let result = if opc == op::I8X16_EXTRACT_LANE_S {
+                        builder.ins().sextend(types::I64, lane)
+                    } else {
+                        builder.ins().uextend(types::I64, lane)
+                    };
+                    write_dst!(builder, insn.destination, result);
+                }
+                op::I16X8_EXTRACT_LANE_S | op::I16X8_EXTRACT_LANE_U => {
+                    let lane = v128_extract_lane!(builder, insn, types::I16X8);
+                    let result = if opc == op::I16X8_EXTRACT_LANE_S {
+                        builder.ins().sextend(types::I64, lane)
+                    } else {
+                        builder.ins().uextend(types::I64, lane)
+                    };
+                    write_dst!(builder, insn.destination, result);
+                }
+                op::I32X4_EXTRACT_LANE => {
+                    let lane = v128_extract_lane!(builder, insn, types::I32X4);
+                    let result = builder.ins().sextend(types::I64, lane);
+                    write_dst!(builder, insn.destination, result);
+                }
+                op::I64X2_EXTRACT_LANE => {
+                    let result = v128_extract_lane!(builder, insn, types::I64X2);
+                    write_dst!(builder, insn.destination, result);
+                }
+                op::F32X4_EXTRACT_LANE => {
+                    let result = v128_extract_lane!(builder, insn, types::F32X4);
+                    write_dst_f32!(builder, insn.destination, result);
+                }
+                op::F64X2_EXTRACT_LANE => {
+                    let result = v128_extract_lane!(builder, insn, types::F64X2);
+                    write_dst_f64!(builder, insn.destination, result);
+                }
+                op::I8X16_REPLACE_LANE | op::I16X8_REPLACE_LANE | op::I32X4_REPLACE_LANE => {
+                    let (vector_type, lane_type) = match opc {
+                        op::I8X16_REPLACE_LANE => (types::I8X16, types::I8),
+                        op::I16X8_REPLACE_LANE => (types::I16X8, types::I16),
+                        _ => (types::I32X4, types::I32),
+                    };
+                    let raw = read_src!(builder, insn.sources[0]);
+                    let value = builder.ins().ireduce(lane_type, raw);
+                    v128_replace_lane!(builder, insn, vector_type, value);
+                }
+                op::I64X2_REPLACE_LANE => {
+                    let value = read_src!(builder, insn.sources[0]);
+                    v128_replace_lane!(builder, insn, types::I64X2, value);
+                }
+                op::F32X4_REPLACE_LANE => {
+                    let value = read_src_f32!(builder, insn.sources[0]);
+                    v128_replace_lane!(builder, insn, types::F32X4, value);
+                }
+                op::F64X2_REPLACE_LANE => {
+                    let value = read_src_f64!(builder, insn.sources[0]);
+                    v128_replace_lane!(builder, insn, types::F64X2, value);
+                }
+
+                op::I8X16_EQ => v128_icmp!(builder, insn, types::I8X16, IntCC::Equal),
+                op::I8X16_NE => v128_icmp!(builder, insn, types::I8X16, IntCC::NotEqual),
+                op::I8X16_LT_S => v128_icmp!(builder, insn, types::I8X16, IntCC::SignedLessThan),
+                op::I8X16_LT_U => v128_icmp!(builder, insn, types::I8X16, IntCC::UnsignedLessThan),
+                op::I8X16_GT_S => v128_icmp!(builder, insn, types::I8X16, IntCC::SignedGreaterThan),
+                op::I8X16_GT_U => v128_icmp!(builder, insn, types::I8X16, IntCC::UnsignedGreaterThan),
+                op::I8X16_LE_S => v128_icmp!(builder, insn, types::I8X16, IntCC::SignedLessThanOrEqual),
+                op::I8X16_LE_U => v128_icmp!(builder, insn, types::I8X16, IntCC::UnsignedLessThanOrEqual),
+                op::I8X16_GE_S => v128_icmp!(builder, insn, types::I8X16, IntCC::SignedGreaterThanOrEqual),
+                op::I8X16_GE_U => v128_icmp!(builder, insn, types::I8X16, IntCC::UnsignedGreaterThanOrEqual),
+                op::I16X8_EQ => v128_icmp!(builder, insn, types::I16X8, IntCC::Equal),
+                op::I16X8_NE => v128_icmp!(builder, insn, types::I16X8, IntCC::NotEqual),
+                op::I16X8_LT_S => v128_icmp!(builder, insn, types::I16X8, IntCC::SignedLessThan),
+                op::I16X8_LT_U => v128_icmp!(builder, insn, types::I16X8, IntCC::UnsignedLessThan),
+                op::I16X8_GT_S => v128_icmp!(builder, insn, types::I16X8, IntCC::SignedGreaterThan),
+                op::I16X8_GT_U => v128_icmp!(builder, insn, types::I16X8, IntCC::UnsignedGreaterThan),
+                op::I16X8_LE_S => v128_icmp!(builder, insn, types::I16X8, IntCC::SignedLessThanOrEqual),
+                op::I16X8_LE_U => v128_icmp!(builder, insn, types::I16X8, IntCC::UnsignedLessThanOrEqual),
+                op::I16X8_GE_S => v128_icmp!(builder, insn, types::I16X8, IntCC::SignedGreaterThanOrEqual),
+                op::I16X8_GE_U => v128_icmp!(builder, insn, types::I16X8, IntCC::UnsignedGreaterThanOrEqual),
+                op::I32X4_EQ => v128_icmp!(builder, insn, types::I32X4, IntCC::Equal),
+                op::I32X4_NE => v128_icmp!(builder, insn, types::I32X4, IntCC::NotEqual),
+                op::I32X4_LT_S => v128_icmp!(builder, insn, types::I32X4, IntCC::SignedLessThan),
+                op::I32X4_LT_U => v128_icmp!(builder, insn, types::I32X4, IntCC::UnsignedLessThan),
+                op::I32X4_GT_S => v128_icmp!(builder, insn, types::I32X4, IntCC::SignedGreaterThan),
+                op::I32X4_GT_U => v128_icmp!(builder, insn, types::I32X4, IntCC::UnsignedGreaterThan),
+                op::I32X4_LE_S => v128_icmp!(builder, insn, types::I32X4, IntCC::SignedLessThanOrEqual),
+                op::I32X4_LE_U => v128_icmp!(builder, insn, types::I32X4, IntCC::UnsignedLessThanOrEqual),
+                op::I32X4_GE_S => v128_icmp!(builder, insn, types::I32X4, IntCC::SignedGreaterThanOrEqual),
+                op::I32X4_GE_U => v128_icmp!(builder, insn, types::I32X4, IntCC::UnsignedGreaterThanOrEqual),
+                op::I64X2_EQ => v128_icmp!(builder, insn, types::I64X2, IntCC::Equal),
+                op::I64X2_NE => v128_icmp!(builder, insn, types::I64X2, IntCC::NotEqual),
+                op::I64X2_LT_S => v128_icmp!(builder, insn, types::I64X2, IntCC::SignedLessThan),
+                op::I64X2_GT_S => v128_icmp!(builder, insn, types::I64X2, IntCC::SignedGreaterThan),
+                op::I64X2_LE_S => v128_icmp!(builder, insn, types::I64X2, IntCC::SignedLessThanOrEqual),
+                op::I64X2_GE_S => v128_icmp!(builder, insn, types::I64X2, IntCC::SignedGreaterThanOrEqual),
+                op::F32X4_EQ => v128_fcmp!(builder, insn, types::F32X4, FloatCC::Equal),
+                op::F32X4_NE => v128_fcmp!(builder, insn, types::F32X4, FloatCC::NotEqual),
+                op::F32X4_LT => v128_fcmp!(builder, insn, types::F32X4, FloatCC::LessThan),
+                op::F32X4_GT => v128_fcmp!(builder, insn, types::F32X4, FloatCC::GreaterThan),
+                op::F32X4_LE => v128_fcmp!(builder, insn, types::F32X4, FloatCC::LessThanOrEqual),
+                op::F32X4_GE => v128_fcmp!(builder, insn, types::F32X4, FloatCC::GreaterThanOrEqual),
+                op::F64X2_EQ => v128_fcmp!(builder, insn, types::F64X2, FloatCC::Equal),
+                op::F64X2_NE => v128_fcmp!(builder, insn, types::F64X2, FloatCC::NotEqual),
+                op::F64X2_LT => v128_fcmp!(builder, insn, types::F64X2, FloatCC::LessThan),
+                op::F64X2_GT => v128_fcmp!(builder, insn, types::F64X2, FloatCC::GreaterThan),
+                op::F64X2_LE => v128_fcmp!(builder, insn, types::F64X2, FloatCC::LessThanOrEqual),
+                op::F64X2_GE => v128_fcmp!(builder, insn, types::F64X2, FloatCC::GreaterThanOrEqual),
+
+                op::V128_NOT => v128_unop!(builder, insn, types::I8X16, bnot),
+                op::V128_AND => v128_binop!(builder, insn, types::I8X16, band),
+                op::V128_ANDNOT => v128_binop!(builder, insn, types::I8X16, band_not),
+                op::V128_OR => v128_binop!(builder, insn, types::I8X16, bor),
+                op::V128_XOR => v128_binop!(builder, insn, types::I8X16, bxor),
+                // The relaxed lane selects are allowed to be a plain bitselect, which is what the interpreter does too.
+                op::V128_BITSELECT | op::I8X16_RELAXED_LANESELECT..=op::I64X2_RELAXED_LANESELECT => {
+                    let mask = read_src_v128!(builder, insn.sources[0]);
+                    let if_clear = read_src_v128!(builder, insn.sources[1]);
+                    let if_set = read_src_v128!(builder, insn.sources[2]);
+                    let result = builder.ins().bitselect(mask, if_set, if_clear);
+                    write_dst_v128!(builder, insn.destination, result);
+                }
+                op::V128_ANY_TRUE => v128_test!(builder, insn, types::I8X16, vany_true),
+                op::I8X16_ALL_TRUE => v128_test!(builder, insn, types::I8X16, vall_true),
+                op::I16X8_ALL_TRUE => v128_test!(builder, insn, types::I16X8, vall_true),
+                op::I32X4_ALL_TRUE => v128_test!(builder, insn, types::I32X4, vall_true),
+                op::I64X2_ALL_TRUE => v128_test!(builder, insn, types::I64X2, vall_true),
+                op::I8X16_BITMASK => v128_bitmask!(builder, insn, types::I8X16),
+                op::I16X8_BITMASK => v128_bitmask!(builder, insn, types::I16X8),
+                op::I32X4_BITMASK => v128_bitmask!(builder, insn, types::I32X4),
+                op::I64X2_BITMASK => v128_bitmask!(builder, insn, types::I64X2),
+
+                op::I8X16_ABS => v128_unop!(builder, insn, types::I8X16, iabs),
+                op::I8X16_NEG => v128_unop!(builder, insn, types::I8X16, ineg),
+                op::I8X16_POPCNT => v128_unop!(builder, insn, types::I8X16, popcnt),
+                op::I8X16_SHL => v128_shift!(builder, insn, types::I8X16, ishl),
+                op::I8X16_SHR_S => v128_shift!(builder, insn, types::I8X16, sshr),
+                op::I8X16_SHR_U => v128_shift!(builder, insn, types::I8X16, ushr),
+                op::I8X16_ADD => v128_binop!(builder, insn, types::I8X16, iadd),
+                op::I8X16_ADD_SAT_S => v128_binop!(builder, insn, types::I8X16, sadd_sat),
+                op::I8X16_ADD_SAT_U => v128_binop!(builder, insn, types::I8X16, uadd_sat),
+                op::I8X16_SUB => v128_binop!(builder, insn, types::I8X16, isub),
+                op::I8X16_SUB_SAT_S => v128_binop!(builder, insn, types::I8X16, ssub_sat),
+                op::I8X16_SUB_SAT_U => v128_binop!(builder, insn, types::I8X16, usub_sat),
+                op::I8X16_MIN_S => v128_binop!(builder, insn, types::I8X16, smin),
+                op::I8X16_MIN_U => v128_binop!(builder, insn, types::I8X16, umin),
+                op::I8X16_MAX_S => v128_binop!(builder, insn, types::I8X16, smax),
+                op::I8X16_MAX_U => v128_binop!(builder, insn, types::I8X16, umax),
+                op::I8X16_AVGR_U => v128_binop!(builder, insn, types::I8X16, avg_round),
+                op::I8X16_NARROW_I16X8_S => v128_binop!(builder, insn, types::I16X8, snarrow),
+                op::I8X16_NARROW_I16X8_U => v128_binop!(builder, insn, types::I16X8, unarrow),
+
+                op::I16X8_ABS => v128_unop!(builder, insn, types::I16X8, iabs),
+                op::I16X8_NEG => v128_unop!(builder, insn, types::I16X8, ineg),
+                op::I16X8_SHL => v128_shift!(builder, insn, types::I16X8, ishl),
+                op::I16X8_SHR_S => v128_shift!(builder, insn, types::I16X8, sshr),
+                op::I16X8_SHR_U => v128_shift!(builder, insn, types::I16X8, ushr),
+                op::I16X8_ADD => v128_binop!(builder, insn, types::I16X8, iadd),
+                op::I16X8_ADD_SAT_S => v128_binop!(builder, insn, types::I16X8, sadd_sat),
+                op::I16X8_ADD_SAT_U => v128_binop!(builder, insn, types::I16X8, uadd_sat),
+                op::I16X8_SUB => v128_binop!(builder, insn, types::I16X8, isub),
+                op::I16X8_SUB_SAT_S => v128_binop!(builder, insn, types::I16X8, ssub_sat),
+                op::I16X8_SUB_SAT_U => v128_binop!(builder, insn, types::I16X8, usub_sat),
+                op::I16X8_MUL => v128_binop!(builder, insn, types::I16X8, imul),
+                op::I16X8_MIN_S => v128_binop!(builder, insn, types::I16X8, smin),
+                op::I16X8_MIN_U => v128_binop!(builder, insn, types::I16X8, umin),
+                op::I16X8_MAX_S => v128_binop!(builder, insn, types::I16X8, smax),
+                op::I16X8_MAX_U => v128_binop!(builder, insn, types::I16X8, umax),
+                op::I16X8_AVGR_U => v128_binop!(builder, insn, types::I16X8, avg_round),
+                op::I16X8_Q15MULR_SAT_S | op::I16X8_RELAXED_Q15MULR_S => {
+                    v128_binop!(builder, insn, types::I16X8, sqmul_round_sat)
+                }
+                op::I16X8_NARROW_I32X4_S => v128_binop!(builder, insn, types::I32X4, snarrow),
+                op::I16X8_NARROW_I32X4_U => v128_binop!(builder, insn, types::I32X4, unarrow),
+                op::I16X8_EXTEND_LOW_I8X16_S => v128_widen!(builder, insn, types::I8X16, swiden_low),
+                op::I16X8_EXTEND_HIGH_I8X16_S => v128_widen!(builder, insn, types::I8X16, swiden_high),
+                op::I16X8_EXTEND_LOW_I8X16_U => v128_widen!(builder, insn, types::I8X16, uwiden_low),
+                op::I16X8_EXTEND_HIGH_I8X16_U => v128_widen!(builder, insn, types::I8X16, uwiden_high),
+                op::I16X8_EXTADD_PAIRWISE_I8X16_S => {
+                    v128_extadd_pairwise!(builder, insn, types::I8X16, swiden_low, swiden_high)
+                }
+                op::I16X8_EXTADD_PAIRWISE_I8X16_U => {
+                    v128_extadd_pairwise!(builder, insn, types::I8X16, uwiden_low, uwiden_high)
+                }
+                op::I16X8_EXTMUL_LOW_I8X16_S => v128_extmul!(builder, insn, types::I8X16, swiden_low),
+                op::I16X8_EXTMUL_HIGH_I8X16_S => v128_extmul!(builder, insn, types::I8X16, swiden_high),
+                op::I16X8_EXTMUL_LOW_I8X16_U => v128_extmul!(builder, insn, types::I8X16, uwiden_low),
+                op::I16X8_EXTMUL_HIGH_I8X16_U => v128_extmul!(builder, insn, types::I8X16, uwiden_high),
+
+                op::I32X4_ABS => v128_unop!(builder, insn, types::I32X4, iabs),
+                op::I32X4_NEG => v128_unop!(builder, insn, types::I32X4, ineg),
+                op::I32X4_SHL => v128_shift!(builder, insn, types::I32X4, ishl),
+                op::I32X4_SHR_S => v128_shift!(builder, insn, types::I32X4, sshr),
+                op::I32X4_SHR_U => v128_shift!(builder, insn, types::I32X4, ushr),
+                op::I32X4_ADD => v128_binop!(builder, insn, types::I32X4, iadd),
+                op::I32X4_SUB => v128_binop!(builder, insn, types::I32X4, isub),
+                op::I32X4_MUL => v128_binop!(builder, insn, types::I32X4, imul),
+                op::I32X4_MIN_S => v128_binop!(builder, insn, types::I32X4, smin),
+                op::I32X4_MIN_U => v128_binop!(builder, insn, types::I32X4, umin),
+                op::I32X4_MAX_S => v128_binop!(builder, insn, types::I32X4, smax),
+                op::I32X4_MAX_U => v128_binop!(builder, insn, types::I32X4, umax),
+                op::I32X4_EXTEND_LOW_I16X8_S => v128_widen!(builder, insn, types::I16X8, swiden_low),
+                op::I32X4_EXTEND_HIGH_I16X8_S => v128_widen!(builder, insn, types::I16X8, swiden_high),
+                op::I32X4_EXTEND_LOW_I16X8_U => v128_widen!(builder, insn, types::I16X8, uwiden_low),
+                op::I32X4_EXTEND_HIGH_I16X8_U => v128_widen!(builder, insn, types::I16X8, uwiden_high),
+                op::I32X4_EXTADD_PAIRWISE_I16X8_S => {
+                    v128_extadd_pairwise!(builder, insn, types::I16X8, swiden_low, swiden_high)
+                }
+                op::I32X4_EXTADD_PAIRWISE_I16X8_U => {
+                    v128_extadd_pairwise!(builder, insn, types::I16X8, uwiden_low, uwiden_high)
+                }
+                op::I32X4_EXTMUL_LOW_I16X8_S => v128_extmul!(builder, insn, types::I16X8, swiden_low),
+                op::I32X4_EXTMUL_HIGH_I16X8_S => v128_extmul!(builder, insn, types::I16X8, swiden_high),
+                op::I32X4_EXTMUL_LOW_I16X8_U => v128_extmul!(builder, insn, types::I16X8, uwiden_low),
+                op::I32X4_EXTMUL_HIGH_I16X8_U => v128_extmul!(builder, insn, types::I16X8, uwiden_high),
+                // The relaxed i16x8 dot product wraps its pairwise sums, like the interpreter does.
+                op::I32X4_DOT_I16X8_S | op::I16X8_RELAXED_DOT_I8X16_I7X16_S => {
+                    let lane_type = if opc == op::I32X4_DOT_I16X8_S {
+                        types::I16X8
+                    } else {
+                        types::I8X16
+                    };
+                    let rhs = read_src_v128!(builder, insn.sources[0], lane_type);
+                    let lhs = read_src_v128!(builder, insn.sources[1], lane_type);
+                    let result = v128_dot!(builder, lhs, rhs);
+                    write_dst_v128!(builder, insn.destination, result);
+                }
+                // Widen the i16 products before summing them, so the four-way sum is exact.
+                op::I32X4_RELAXED_DOT_I8X16_I7X16_ADD_S => {
+                    let accumulator = read_src_v128!(builder, insn.sources[0], types::I32X4);
+                    let rhs = read_src_v128!(builder, insn.sources[1], types::I8X16);
+                    let lhs = read_src_v128!(builder, insn.sources[2], types::I8X16);
+                    let lhs_low = builder.ins().swiden_low(lhs);
+                    let rhs_low = builder.ins().swiden_low(rhs);
+                    let products_low = builder.ins().imul(lhs_low, rhs_low);
+                    let lhs_high = builder.ins().swiden_high(lhs);
+                    let rhs_high = builder.ins().swiden_high(rhs);
+                    let products_high = builder.ins().imul(lhs_high, rhs_high);
+                    let pairs = [products_low, products_high].map(|products| {
+                        let low = builder.ins().swiden_low(products);
+                        let high = builder.ins().swiden_high(products);
+                        builder.ins().iadd_pairwise(low, high)
+                    });
+                    let sums = builder.ins().iadd_pairwise(pairs[0], pairs[1]);
+                    let result = builder.ins().iadd(sums, accumulator);
+                    write_dst_v128!(builder, insn.destination, result);
+                }
+
+                op::I64X2_ABS => v128_unop!(builder, insn, types::I64X2, iabs),
+                op::I64X2_NEG => v128_unop!(builder, insn, types::I64X2, ineg),
+                op::I64X2_SHL => v128_shift!(builder, insn, types::I64X2, ishl),
+                op::I64X2_SHR_S => v128_shift!(builder, insn, types::I64X2, sshr),
+                op::I64X2_SHR_U => v128_shift!(builder, insn, types::I64X2, ushr),
+                op::I64X2_ADD => v128_binop!(builder, insn, types::I64X2, iadd),
+                op::I64X2_SUB => v128_binop!(builder, insn, types::I64X2, isub),
+                op::I64X2_MUL => v128_binop!(builder, insn, types::I64X2, imul),
+                op::I64X2_EXTEND_LOW_I32X4_S => v128_widen!(builder, insn, types::I32X4, swiden_low),
+                op::I64X2_EXTEND_HIGH_I32X4_S => v128_widen!(builder, insn, types::I32X4, swiden_high),
+                op::I64X2_EXTEND_LOW_I32X4_U => v128_widen!(builder, insn, types::I32X4, uwiden_low),
+                op::I64X2_EXTEND_HIGH_I32X4_U => v128_widen!(builder, insn, types::I32X4, uwiden_high),
+                op::I64X2_EXTMUL_LOW_I32X4_S => v128_extmul!(builder, insn, types::I32X4, swiden_low),
+                op::I64X2_EXTMUL_HIGH_I32X4_S => v128_extmul!(builder, insn, types::I32X4, swiden_high),
+                op::I64X2_EXTMUL_LOW_I32X4_U => v128_extmul!(builder, insn, types::I32X4, uwiden_low),
+                op::I64X2_EXTMUL_HIGH_I32X4_U => v128_extmul!(builder, insn, types::I32X4, uwiden_high),
+
+                op::F32X4_ABS => v128_unop!(builder, insn, types::F32X4, fabs),
+                op::F32X4_NEG => v128_unop!(builder, insn, types::F32X4, fneg),
+                op::F32X4_SQRT => v128_unop!(builder, insn, types::F32X4, sqrt),
+                op::F32X4_CEIL => v128_unop!(builder, insn, types::F32X4, ceil),
+                op::F32X4_FLOOR => v128_unop!(builder, insn, types::F32X4, floor),
+                op::F32X4_TRUNC => v128_unop!(builder, insn, types::F32X4, trunc),
+                op::F32X4_NEAREST => v128_unop!(builder, insn, types::F32X4, nearest),
+                op::F32X4_ADD => v128_binop!(builder, insn, types::F32X4, fadd),
+                op::F32X4_SUB => v128_binop!(builder, insn, types::F32X4, fsub),
+                op::F32X4_MUL => v128_binop!(builder, insn, types::F32X4, fmul),
+                op::F32X4_DIV => v128_binop!(builder, insn, types::F32X4, fdiv),
+                op::F32X4_MIN | op::F32X4_RELAXED_MIN => v128_binop!(builder, insn, types::F32X4, fmin),
+                op::F32X4_MAX | op::F32X4_RELAXED_MAX => v128_binop!(builder, insn, types::F32X4, fmax),
+                op::F64X2_ABS => v128_unop!(builder, insn, types::F64X2, fabs),
+                op::F64X2_NEG => v128_unop!(builder, insn, types::F64X2, fneg),
+                op::F64X2_SQRT => v128_unop!(builder, insn, types::F64X2, sqrt),
+                op::F64X2_CEIL => v128_unop!(builder, insn, types::F64X2, ceil),
+                op::F64X2_FLOOR => v128_unop!(builder, insn, types::F64X2, floor),
+                op::F64X2_TRUNC => v128_unop!(builder, insn, types::F64X2, trunc),
+                op::F64X2_NEAREST => v128_unop!(builder, insn, types::F64X2, nearest),
+                op::F64X2_ADD => v128_binop!(builder, insn, types::F64X2, fadd),
+                op::F64X2_SUB => v128_binop!(builder, insn, types::F64X2, fsub),
+                op::F64X2_MUL => v128_binop!(builder, insn, types::F64X2, fmul),
+                op::F64X2_DIV => v128_binop!(builder, insn, types::F64X2, fdiv),
+                op::F64X2_MIN | op::F64X2_RELAXED_MIN => v128_binop!(builder, insn, types::F64X2, fmin),
+                op::F64X2_MAX | op::F64X2_RELAXED_MAX => v128_binop!(builder, insn, types::F64X2, fmax),
+                // pmin is b < a ? b : a, and pmax is a < b ? b : a.
+                op::F32X4_PMIN | op::F32X4_PMAX | op::F64X2_PMIN | op::F64X2_PMAX => {
+                    let ty = if opc == op::F32X4_PMIN || opc == op::F32X4_PMAX {
+                        types::F32X4
+                    } else {
+                        types::F64X2
+                    };
+                    let rhs = read_src_v128!(builder, insn.sources[0], ty);
+                    let lhs = read_src_v128!(builder, insn.sources[1], ty);
+                    let cmp = if opc == op::F32X4_PMIN || opc == op::F64X2_PMIN {
+                        builder.ins().fcmp(FloatCC::LessThan, rhs, lhs)
+                    } else {
+                        builder.ins().fcmp(FloatCC::LessThan, lhs, rhs)
+                    };
+                    let cmp = vcast!(builder, ty, cmp);
+                    let result = builder.ins().bitselect(cmp, rhs, lhs);
+                    write_dst_v128!(builder, insn.destination, result);
+                }
+                // The interpreter doesn't fuse the relaxed multiply-adds either, so neither do we.
+                op::F32X4_RELAXED_MADD..=op::F64X2_RELAXED_NMADD => {
+                    let ty = if opc <= op::F32X4_RELAXED_NMADD {
+                        types::F32X4
+                    } else {
+                        types::F64X2
+                    };
+                    let addend = read_src_v128!(builder, insn.sources[0], ty);
+                    let rhs = read_src_v128!(builder, insn.sources[1], ty);
+                    let lhs = read_src_v128!(builder, insn.sources[2], ty);
+                    let product = builder.ins().fmul(lhs, rhs);
+                    let result = if opc == op::F32X4_RELAXED_MADD || opc == op::F64X2_RELAXED_MADD {
+                        builder.ins().fadd(product, addend)
+                    } else {
+                        builder.ins().fsub(addend, product)
+                    };
+                    write_dst_v128!(builder, insn.destination, result);
+                }
+
+                op::I32X4_TRUNC_SAT_F32X4_S | op::I32X4_RELAXED_TRUNC_F32X4_S => {
+                    let src = read_src_v128!(builder, insn.sources[0], types::F32X4);
+                    let result = builder.ins().fcvt_to_sint_sat(types::I32X4, src);
+                    write_dst_v128!(builder, insn.destination, result);
+                }
+                op::I32X4_TRUNC_SAT_F32X4_U | op::I32X4_RELAXED_TRUNC_F32X4_U => {
+                    let src = read_src_v128!(builder, insn.sources[0], types::F32X4);
+                    let result = builder.ins().fcvt_to_uint_sat(types::I32X4, src);
+                    write_dst_v128!(builder, insn.destination, result);
+                }
+                op::I32X4_TRUNC_SAT_F64X2_S_ZERO
+                | op::I32X4_TRUNC_SAT_F64X2_U_ZERO
+                | op::I32X4_RELAXED_TRUNC_F64X2_S_ZERO
+                | op::I32X4_RELAXED_TRUNC_F64X2_U_ZERO => {
+                    let src = read_src_v128!(builder, insn.sources[0], types::F64X2);
+                    let zero = v128_const!(builder, [0; 16]);
+                    let zero = vcast!(builder, types::I64X2, zero);
+                    let result = if opc == op::I32X4_TRUNC_SAT_F64X2_S_ZERO || opc == op::I32X4_RELAXED_TRUNC_F64X2_S_ZERO
+                    {
+                        let converted = builder.ins().fcvt_to_sint_sat(types::I64X2, src);
+                        builder.ins().snarrow(converted, zero)
+                    } else {
+                        let converted = builder.ins().fcvt_to_uint_sat(types::I64X2, src);
+                        builder.ins().uunarrow(converted, zero)
+                    };
+                    write_dst_v128!(builder, insn.destination, result);
+                }
+                op::F32X4_CONVERT_I32X4_S | op::F32X4_CONVERT_I32X4_U => {
+                    let src = read_src_v128!(builder, insn.sources[0], types::I32X4);
+                    let result = if opc == op::F32X4_CONVERT_I32X4_S {
+                        builder.ins().fcvt_from_sint(types::F32X4, src)
+                    } else {
+                        builder.ins().fcvt_from_uint(types::F32X4, src)
+                    };
+                    write_dst_v128!(builder, insn.destination, result);
+                }
+                op::F64X2_CONVERT_LOW_I32X4_S | op::F64X2_CONVERT_LOW_I32X4_U => {
+                    let src = read_src_v128!(builder, insn.sources[0], types::I32X4);
+                    let result = if opc == op::F64X2_CONVERT_LOW_I32X4_S {
+                        let widened = builder.ins().swiden_low(src);
+                        builder.ins().fcvt_from_sint(types::F64X2, widened)
+                    } else {
+                        let widened = builder.ins().uwiden_low(src);
+                        builder.ins().fcvt_from_uint(types::F64X2, widened)
+                    };
+                    write_dst_v128!(builder, insn.destination, result);
+                }
+                op::F32X4_DEMOTE_F64X2_ZERO => v128_unop!(builder, insn, types::F64X2, fvdemote),
+                op::F64X2_PROMOTE_LOW_F32X4 => v128_unop!(builder, insn, types::F32X4, fvpromote_low),
+
                 op::MEMORY_SIZE => {
                     let mem_idx = builder.ins().iconst(types::I32, insn.imm1);
                     let _xv_config_var = builder.use_var(config_var);
@@ -2219,11 +3239,7 @@ impl CraneliftCompiler {
                     let iv = builder.use_var(interp_var);
                     let cv = builder.use_var(config_var);
                     do_call_and_check!(builder, call_fn_sig, cfp, &[iv, cv, func_idx]);
-                    // The helper pushes results to value_stack; pop to the actual destination.
-                    if insn.destination != STACK_MARKER {
-                        let result = emit_stack_pop!(builder);
-                        write_dst!(builder, insn.destination, result);
-                    }
+                    pop_call_result!(builder, insn.destination);
                 }
 
                 op::CALL_INDIRECT => {
@@ -2241,10 +3257,213 @@ impl CraneliftCompiler {
                         cfp,
                         &[iv, cv, table_idx, type_idx, element_index]
                     );
-                    if insn.destination != STACK_MARKER {
-                        let result = emit_stack_pop!(builder);
-                        write_dst!(builder, insn.destination, result);
+                    pop_call_result!(builder, insn.destination);
+                }
+
+                op::CALL_REF => {
+                    flush_vstack_to_real!(builder);
+                    let (ref_lo, ref_hi) = read_src_pair!(builder, insn.sources[0]);
+                    let type_idx = builder.ins().iconst(types::I32, insn.imm1);
+                    let cfp = builder.ins().func_addr(ptr_type, h_call_ref);
+                    let iv = builder.use_var(interp_var);
+                    let cv = builder.use_var(config_var);
+                    do_call_and_check!(builder, call_ref_sig, cfp, &[iv, cv, type_idx, ref_lo, ref_hi]);
+                    pop_call_result!(builder, insn.destination);
+                }
+
+                // Compiled code can't replace its own frame, so the helpers move the arguments aside and leave the call to whoever
+                // entered this code (see BytecodeInterpreter::run_pending_tail_calls()); all that's left to do here is return.
+                op::RETURN_CALL | op::RETURN_CALL_INDIRECT | op::RETURN_CALL_REF => {
+                    flush_vstack_to_real!(builder);
+                    match opc {
+                        op::RETURN_CALL => {
+                            let func_idx = builder.ins().iconst(types::I32, insn.imm1);
+                            let cfp = builder.ins().func_addr(ptr_type, h_return_call);
+                            let iv = builder.use_var(interp_var);
+                            let cv = builder.use_var(config_var);
+                            do_call_and_check!(builder, call_fn_sig, cfp, &[iv, cv, func_idx]);
+                        }
+                        op::RETURN_CALL_INDIRECT => {
+                            let element_index = read_src!(builder, insn.sources[0]);
+                            let element_index = builder.ins().ireduce(types::I32, element_index);
+                            let type_idx = builder.ins().iconst(types::I32, insn.imm1);
+                            let table_idx = builder.ins().iconst(types::I32, insn.imm2);
+                            let cfp = builder.ins().func_addr(ptr_type, h_return_call_indirect);
+                            let iv = builder.use_var(interp_var);
+                            let cv = builder.use_var(config_var);
+                            do_call_and_check!(
+                                builder,
+                                call_indirect_sig,
+                                cfp,
+                                &[iv, cv, table_idx, type_idx, element_index]
+                            );
+                        }
+                        _ => {
+                            let (ref_lo, ref_hi) = read_src_pair!(builder, insn.sources[0]);
+                            let type_idx = builder.ins().iconst(types::I32, insn.imm1);
+                            let cfp = builder.ins().func_addr(ptr_type, h_return_call_ref);
+                            let iv = builder.use_var(interp_var);
+                            let cv = builder.use_var(config_var);
+                            do_call_and_check!(builder, call_ref_sig, cfp, &[iv, cv, type_idx, ref_lo, ref_hi]);
+                        }
                     }
+                    // Drop whatever else this frame left on the value stack; the callee's results take its place.
+                    let init_size = builder.use_var(initial_stack_size_var);
+                    emit_stack_cleanup!(builder, init_size, 0);
+                    let ret_val = builder.ins().iconst(types::I64, outcome_return_value as i64);
+                    builder.ins().return_(&[ret_val]);
+                    sp = 0;
+                    is_unreachable = true;
+                    let dead = builder.create_block();
+                    builder.switch_to_block(dead);
+                    builder.seal_block(dead);
+                }
+
+                op::THROW => {
+                    flush_vstack_to_real!(builder);
+                    Self::sync_regs_to_config(
+                        &mut builder,
+                        &reg_vars,
+                        has_wide_values.then_some(&reg_vars_hi),
+                        config_var,
+                        regs_offset,
+                        value_size,
+                        &dirty_regs,
+                    );
+                    flush_locals!(builder);
+                    // The helper always traps, with the exception for the caller to catch.
+                    let tag_idx = builder.ins().iconst(types::I32, insn.imm1);
+                    let cfp = builder.ins().func_addr(ptr_type, h_throw);
+                    let iv = builder.use_var(interp_var);
+                    let cv = builder.use_var(config_var);
+                    builder.ins().call_indirect(throw_sig, cfp, &[iv, cv, tag_idx]);
+                    builder.ins().jump(trap_block, &[]);
+                    sp = 0;
+                    is_unreachable = true;
+                    let dead = builder.create_block();
+                    builder.switch_to_block(dead);
+                    builder.seal_block(dead);
+                }
+
+                op::REF_NULL => {
+                    // imm1/imm2 = low/high half of the typed null
+                    let lo = builder.ins().iconst(types::I64, insn.imm1);
+                    let hi = builder.ins().iconst(types::I64, insn.imm2);
+                    write_dst_pair!(builder, insn.destination, lo, hi);
+                }
+                op::REF_IS_NULL => {
+                    let (_, hi) = read_src_pair!(builder, insn.sources[0]);
+                    let is_null = ref_is_null!(builder, hi);
+                    let result = builder.ins().uextend(types::I64, is_null);
+                    write_dst!(builder, insn.destination, result);
+                }
+                op::REF_AS_NON_NULL => {
+                    let (lo, hi) = read_src_pair!(builder, insn.sources[0]);
+                    let is_null = ref_is_null!(builder, hi);
+                    let null_block = builder.create_block();
+                    let cont = builder.create_block();
+                    builder.ins().brif(is_null, null_block, &[], cont, &[]);
+                    builder.switch_to_block(null_block);
+                    builder.seal_block(null_block);
+                    Self::sync_regs_to_config(
+                        &mut builder,
+                        &reg_vars,
+                        has_wide_values.then_some(&reg_vars_hi),
+                        config_var,
+                        regs_offset,
+                        value_size,
+                        &dirty_regs,
+                    );
+                    flush_locals!(builder);
+                    set_trap!(builder, "null reference");
+                    builder.ins().jump(trap_block, &[]);
+                    builder.switch_to_block(cont);
+                    builder.seal_block(cont);
+                    write_dst_pair!(builder, insn.destination, lo, hi);
+                }
+                op::REF_EQ => {
+                    let (rhs_lo, rhs_hi) = read_src_pair!(builder, insn.sources[0]);
+                    let (lhs_lo, lhs_hi) = read_src_pair!(builder, insn.sources[1]);
+                    let lo_eq = builder.ins().icmp(IntCC::Equal, lhs_lo, rhs_lo);
+                    let hi_eq = builder.ins().icmp(IntCC::Equal, lhs_hi, rhs_hi);
+                    let eq = builder.ins().band(lo_eq, hi_eq);
+                    let result = builder.ins().uextend(types::I64, eq);
+                    write_dst!(builder, insn.destination, result);
+                }
+                op::REF_FUNC => {
+                    // imm1 = function index
+                    let func_idx = builder.ins().iconst(types::I32, insn.imm1);
+                    let cfp = builder.ins().func_addr(ptr_type, h_ref_func);
+                    let cv = builder.use_var(config_var);
+                    builder.ins().call_indirect(ref_func_sig, cfp, &[cv, func_idx]);
+                    let (lo, hi) = load_call_result_pair!(builder);
+                    write_dst_pair!(builder, insn.destination, lo, hi);
+                }
+
+                // imm1 = table index for all of the table instructions.
+                op::TABLE_GET => {
+                    let index = read_src!(builder, insn.sources[0]);
+                    let index = builder.ins().ireduce(types::I32, index);
+                    let table_idx = builder.ins().iconst(types::I32, insn.imm1);
+                    let cfp = builder.ins().func_addr(ptr_type, h_table_get);
+                    let iv = builder.use_var(interp_var);
+                    let cv = builder.use_var(config_var);
+                    do_call_and_check!(builder, table_get_sig, cfp, &[iv, cv, table_idx, index]);
+                    let (lo, hi) = load_call_result_pair!(builder);
+                    write_dst_pair!(builder, insn.destination, lo, hi);
+                }
+                op::TABLE_SET => {
+                    // sources: [0]=value, [1]=index
+                    let (ref_lo, ref_hi) = read_src_pair!(builder, insn.sources[0]);
+                    let index = read_src!(builder, insn.sources[1]);
+                    let index = builder.ins().ireduce(types::I32, index);
+                    let table_idx = builder.ins().iconst(types::I32, insn.imm1);
+                    let cfp = builder.ins().func_addr(ptr_type, h_table_set);
+                    let iv = builder.use_var(interp_var);
+                    let cv = builder.use_var(config_var);
+                    do_call_and_check!(builder, table_set_sig, cfp, &[iv, cv, table_idx, index, ref_lo, ref_hi]);
+                }
+                op::TABLE_SIZE => {
+                    let table_idx = builder.ins().iconst(types::I32, insn.imm1);
+                    let cfp = builder.ins().func_addr(ptr_type, h_table_size);
+                    let cv = builder.use_var(config_var);
+                    let call = builder.ins().call_indirect(table_size_sig, cfp, &[cv, table_idx]);
+                    let size = builder.inst_results(call)[0];
+                    let result = builder.ins().uextend(types::I64, size);
+                    write_dst!(builder, insn.destination, result);
+                }
+                op::TABLE_GROW => {
+                    // sources: [0]=delta, [1]=value
+                    let delta = read_src!(builder, insn.sources[0]);
+                    let delta = builder.ins().ireduce(types::I32, delta);
+                    let (ref_lo, ref_hi) = read_src_pair!(builder, insn.sources[1]);
+                    let table_idx = builder.ins().iconst(types::I32, insn.imm1);
+                    let cfp = builder.ins().func_addr(ptr_type, h_table_grow);
+                    let cv = builder.use_var(config_var);
+                    let call = builder
+                        .ins()
+                        .call_indirect(table_grow_sig, cfp, &[cv, table_idx, delta, ref_lo, ref_hi]);
+                    let previous_size = builder.inst_results(call)[0];
+                    let result = builder.ins().sextend(types::I64, previous_size);
+                    write_dst!(builder, insn.destination, result);
+                }
+                op::TABLE_FILL => {
+                    // sources: [0]=count, [1]=value, [2]=start
+                    let count = read_src!(builder, insn.sources[0]);
+                    let count = builder.ins().ireduce(types::I32, count);
+                    let (ref_lo, ref_hi) = read_src_pair!(builder, insn.sources[1]);
+                    let start = read_src!(builder, insn.sources[2]);
+                    let start = builder.ins().ireduce(types::I32, start);
+                    let table_idx = builder.ins().iconst(types::I32, insn.imm1);
+                    let cfp = builder.ins().func_addr(ptr_type, h_table_fill);
+                    let iv = builder.use_var(interp_var);
+                    let cv = builder.use_var(config_var);
+                    do_call_and_check!(
+                        builder,
+                        table_fill_sig,
+                        cfp,
+                        &[iv, cv, table_idx, start, ref_lo, ref_hi, count]
+                    );
                 }
 
                 opc if (op::SYNTHETIC_CALL_00..=op::SYNTHETIC_CALL_31).contains(&opc) => {
@@ -2298,7 +3517,10 @@ impl CraneliftCompiler {
                     let iv = builder.use_var(interp_var);
                     let cv = builder.use_var(config_var);
                     do_call_and_check!(builder, call_wr_sig, cwp, &[iv, cv, func_idx]);
-                    if opc == op::SYNTHETIC_CALL_WITH_RECORD_1 {
+                    if opc == op::SYNTHETIC_CALL_WITH_RECORD_1 && has_wide_values {
+                        let (lo, hi) = load_call_result_pair!(builder);
+                        write_dst_pair!(builder, insn.destination, lo, hi);
+                    } else if opc == op::SYNTHETIC_CALL_WITH_RECORD_1 {
                         let cv2 = builder.use_var(config_var);
                         let result = builder.ins().load(
                             types::I64,
@@ -2466,13 +3688,14 @@ impl CraneliftCompiler {
         builder.switch_to_block(epilogue_block);
         builder.seal_block(epilogue_block);
         // Clean up excess values on the real stack (e.g. from BR out of nested blocks); nothing to touch if we have vstack info.
-        if has_raw_call {
+        if uses_real_stack {
             let init_size = builder.use_var(initial_stack_size_var);
             emit_stack_cleanup!(builder, init_size, result_arity);
         }
         Self::sync_regs_to_config(
             &mut builder,
             &reg_vars,
+            has_wide_values.then_some(&reg_vars_hi),
             config_var,
             regs_offset,
             value_size,
@@ -2577,6 +3800,21 @@ impl CraneliftCompiler {
                 | op::MEMORY_SIZE
                 | op::MEMORY_GROW
                 | op::CALL_INDIRECT
+                | op::CALL_REF
+                | op::RETURN_CALL
+                | op::RETURN_CALL_INDIRECT
+                | op::RETURN_CALL_REF
+                | op::THROW
+                | op::REF_NULL
+                | op::REF_IS_NULL
+                | op::REF_AS_NON_NULL
+                | op::REF_EQ
+                | op::REF_FUNC
+                | op::TABLE_GET
+                | op::TABLE_SET
+                | op::TABLE_SIZE
+                | op::TABLE_GROW
+                | op::TABLE_FILL
                 | op::I32_TRUNC_SAT_F32_S..=op::I64_TRUNC_SAT_F64_U
                 | op::MEMORY_COPY
                 | op::MEMORY_FILL
@@ -2599,12 +3837,14 @@ impl CraneliftCompiler {
                 | op::SYNTHETIC_I64_ADD2LOCAL..=op::SYNTHETIC_LOCAL_SETI64_CONST
                 | op::SYNTHETIC_BR_TABLE_CONT
                 | op::SYNTHETIC_TIER_UP
+                | op::V128_LOAD..=op::I32X4_RELAXED_DOT_I8X16_I7X16_ADD_S
         )
     }
 
     fn sync_regs_to_config(
         builder: &mut FunctionBuilder,
         reg_vars: &[Variable; REG_COUNT],
+        reg_vars_hi: Option<&[Variable; REG_COUNT]>,
         config_var: Variable,
         regs_offset: i32,
         value_size: i32,
@@ -2618,8 +3858,11 @@ impl CraneliftCompiler {
             let val = builder.use_var(reg_vars[i]);
             let offset = regs_offset + (i as i32) * value_size;
             builder.ins().store(MemFlags::trusted(), val, config, offset);
-            let zero = builder.ins().iconst(types::I64, 0);
-            builder.ins().store(MemFlags::trusted(), zero, config, offset + 8);
+            let hi = match reg_vars_hi {
+                Some(reg_vars_hi) => builder.use_var(reg_vars_hi[i]),
+                None => builder.ins().iconst(types::I64, 0),
+            };
+            builder.ins().store(MemFlags::trusted(), hi, config, offset + 8);
         }
     }
 }
@@ -15,6 +15,11 @@ use compiler::CraneliftCompiler;
 ///   branch:       imm1 = label index (from control stack)
 ///   block/loop:   imm1 = end_ip, imm2 = else_ip (-1 if none), imm3 = arity | (param_count << 16)
 ///   call:         imm1 = function index
+///   call_ref:     imm1 = type index
+///   table ops:    imm1 = table index
+///   ref.null:     imm1/imm2 = low/high half of the typed null value
+///   ref.func:     imm1 = function index
+///   throw:        imm1 = tag index
 ///   memory ops:   imm1 = offset, imm3 = memory index
 #[repr(C)]
 #[derive(Clone, Copy, Debug)]
@@ -54,6 +59,27 @@ pub struct RuntimeHelpers {
     pub memory_fill: usize,
     // Address of the process-global primitive storage cage base.
     pub primitive_storage_cage_base: usize,
+    // i32 fn(interp, config, func_index); records a tail call for the caller of the compiled code
+    pub return_call: usize,
+    // i32 fn(interp, config, table_idx, type_idx, element_index)
+    pub return_call_indirect: usize,
+    // i32 fn(interp, config, type_idx, ref_lo, ref_hi)
+    pub call_ref: usize,
+    pub return_call_ref: usize,
+    // void fn(config, func_index); result in the call result scratch
+    pub ref_func: usize,
+    // i32 fn(interp, config, table_idx, index); result in the call result scratch
+    pub table_get: usize,
+    // i32 fn(interp, config, table_idx, index, ref_lo, ref_hi)
+    pub table_set: usize,
+    // i32 fn(config, table_idx); returns size in elements
+    pub table_size: usize,
+    // i32 fn(config, table_idx, delta, ref_lo, ref_hi); returns old size or -1
+    pub table_grow: usize,
+    // i32 fn(interp, config, table_idx, start, ref_lo, ref_hi, count)
+    pub table_fill: usize,
+    // i32 fn(interp, config, tag_idx); always traps with the thrown exception
+    pub throw_exception: usize,
 
     pub regs_offset: u32,
     pub value_size: u32,
@@ -89,9 +115,20 @@ pub enum HelperId {
     memory_copy = 10,
     memory_fill = 11,
     primitive_storage_cage_base = 12,
+    return_call = 13,
+    return_call_indirect = 14,
+    call_ref = 15,
+    return_call_ref = 16,
+    ref_func = 17,
+    table_get = 18,
+    table_set = 19,
+    table_size = 20,
+    table_grow = 21,
+    table_fill = 22,
+    throw_exception = 23,
 }
 
-pub const HELPER_COUNT: u32 = 13;
+pub const HELPER_COUNT: u32 = 24;
 
 /// One relocation slot in the generated machine code. `code_offset` is the byte offset
 /// from the start of the function where 8 contiguous bytes hold the absolute helper
@@ -1559,6 +1559,15 @@ public:
 
     auto& functions() const { return m_functions; }
 
+    // NB: The streaming parser fills the section one entry at a time, and reserves room for all of them up front so that
+    //     entries handed out for validation and compilation never move.
+    void ensure_capacity(size_t count) { m_functions.ensure_capacity(count); }
+    void append(Code code)
+    {
+        VERIFY(m_functions.size() < m_functions.capacity());
+        m_functions.unchecked_append(move(code));
+    }
+
     static ParseResult<CodeSection> parse(ConstrainedStream& stream);
 
 private:
@@ -1761,6 +1770,8 @@ public:
     void set_canonical_types(Vector<DefinedType const*> types) { m_canonical_types = move(types); }
 
 private:
+    friend class StreamingModuleParser;
+
     void set_validation_status(ValidationStatus status) { m_validation_status = status; }
     void preprocess();
 
@@ -1792,6 +1803,49 @@ private:
     size_t m_minimum_call_record_allocation_size { 0 };
 };
 
+// Parses a module whose bytes arrive in chunks, e.g. from a network stream.
+// Code section entries are parsed one at a time as soon as all of their bytes are available, so they can be validated
+// and compiled while the rest of the module is still arriving; every other section is parsed once it is complete.
+class WASM_API StreamingModuleParser {
+    AK_MAKE_NONCOPYABLE(StreamingModuleParser);
+    AK_MAKE_NONMOVABLE(StreamingModuleParser);
+
+public:
+    StreamingModuleParser();
+
+    ParseResult<void> append(ReadonlyBytes);
+    ParseResult<NonnullRefPtr<Module>> finish();
+
+    Module& module() { return *m_module; }
+
+    // Once the code section has been reached, every section that may precede it has been parsed.
+    bool has_reached_code_section() const { return m_has_reached_code_section; }
+    size_t parsed_function_count() const { return m_module->code_section().functions().size(); }
+
+private:
+    enum class State : u8 {
+        Header,
+        SectionHeader,
+        SectionContents,
+        CodeEntryCount,
+        CodeEntries,
+    };
+
+    ParseResult<bool> parse_next();
+    ReadonlyBytes unconsumed_bytes() const { return m_buffer.bytes().slice(m_offset); }
+
+    NonnullRefPtr<Module> m_module;
+    ByteBuffer m_buffer;
+    size_t m_offset { 0 };
+    State m_state { State::Header };
+    SectionId m_section_id { SectionId::SectionIdKind::Custom };
+    size_t m_section_remaining { 0 };
+    size_t m_remaining_code_entries { 0 };
+    SectionId::SectionIdKind m_last_section_id { SectionId::SectionIdKind::Custom };
+    u32 m_seen_section_kinds { 0 };
+    bool m_has_reached_code_section { false };
+};
+
 CompiledInstructions try_compile_instructions(Expression const&, Span<FunctionType const> functions, Span<CodeSection::Func const* const> callee_bodies = {}, size_t current_function_index = 0, size_t caller_local_count = 0, size_t imported_function_count = 0);
 ErrorOr<void, ValidationError> ensure_cranelift_compiled(Module&);
 WASM_API void start_cranelift_compilation(Module&);
@@ -1800,6 +1854,8 @@ void flush_cranelift_batch();
 void discard_cranelift_batch();
 
 void compile_module_to_native(Module&);
+// Counts the compiled functions and tier-up checkpoints into the (otherwise filled in) stats, and records them.
+void record_native_compile_stats(Module const&, ModuleStats);
 
 WASM_API void record_module_stats(ModuleStats);
 WASM_API void dump_module_stats();
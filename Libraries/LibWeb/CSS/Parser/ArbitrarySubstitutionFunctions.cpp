@@ -513,6 +513,10 @@ static Vector<ComponentValue> replace_a_var_function(AbstractOrHypotheticalEleme
         // Look up the value of the custom property
         auto custom_property_name = name_token.token().ident();
 
+        // NB: Remember that this element's style depends on the custom property, so that changing it restyles the
+        //     element. This includes custom properties looked up while computing other custom properties.
+        element.abstract_element().element().add_custom_property_dependency(custom_property_name);
+
         // NB: We compute against the element that declared the custom property (if any did) - this is irrelevant for
         //     normal style computation since inherited values are already in computed form (since style computation
         //     occurs in tree order), but it is required for custom function evaluation.
@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Debug.h>
+#include <AK/NeverDestroyed.h>
+#include <LibCore/EventLoop.h>
+#include <LibThreading/ThreadPool.h>
+#include <LibURL/URL.h>
+#include <LibWeb/CSS/Parser/BackgroundStyleSheetTokenizer.h>
+#include <LibWeb/CSS/Parser/ParsedStyleSheetCache.h>
+
+namespace Web::CSS::Parser {
+
+// Style sheets fetched speculatively may never be used by the document, so only a bounded number of results are kept
+// around waiting for it.
+static constexpr size_t MAXIMUM_PENDING_STYLE_SHEET_COUNT = 16;
+
+BackgroundStyleSheetTokenizer& BackgroundStyleSheetTokenizer::the()
+{
+    static NeverDestroyed<BackgroundStyleSheetTokenizer> tokenizer;
+    return *tokenizer;
+}
+
+void BackgroundStyleSheetTokenizer::Job::run()
+{
+    auto tokens = Tokenizer::tokenize_without_interning(m_source);
+
+    Sync::MutexLocker locker(m_mutex);
+    m_tokens = move(tokens);
+    m_condition.broadcast();
+}
+
+Tokenizer::UninternedTokens BackgroundStyleSheetTokenizer::Job::wait_for_tokens()
+{
+    Sync::MutexLocker locker(m_mutex);
+    m_condition.wait_while([this] { return !m_tokens.has_value(); });
+    return m_tokens.release_value();
+}
+
+bool BackgroundStyleSheetTokenizer::should_tokenize_in_background(URL::URL const& url, Utf16View source) const
+{
+    if (source.length_in_code_units() < MINIMUM_SOURCE_LENGTH)
+        return false;
+
+    // NB: Sheets that are already parsed will not be tokenized again.
+    return !ParsedStyleSheetCache::the().contains(url, source);
+}
+
+void BackgroundStyleSheetTokenizer::tokenize(URL::URL const& url, Utf16View source, Function<void()> on_complete)
+{
+    auto key = url.serialize();
+    auto source_hash = source.hash();
+
+    if (auto existing = m_style_sheets.find(key); existing != m_style_sheets.end()) {
+        auto& style_sheet = existing->value;
+
+        if (style_sheet.source_hash == source_hash && style_sheet.job->source().utf16_view() == source) {
+            if (!on_complete)
+                return;
+            if (style_sheet.finished)
+                on_complete();
+            else
+                style_sheet.completion_callbacks.append(move(on_complete));
+            return;
+        }
+
+        // NB: The URL now serves different contents. Anyone waiting for the old contents is still told that the job
+        //     finished; they will find no tokens for their contents and tokenize them on the main thread instead.
+        for (auto& callback : style_sheet.completion_callbacks)
+            Core::deferred_invoke(move(callback));
+
+        m_style_sheets.remove(existing);
+        ++m_statistics.discarded;
+    }
+
+    auto job = adopt_ref(*new Job(source));
+
+    PendingStyleSheet style_sheet {
+        .job = job,
+        .source_hash = source_hash,
+        .started_at = ++m_job_counter,
+        .finished = false,
+        .completion_callbacks = {},
+    };
+    if (on_complete)
+        style_sheet.completion_callbacks.append(move(on_complete));
+
+    dbgln_if(CSS_LOADER_DEBUG, "BackgroundStyleSheetTokenizer: Tokenizing {} ({} code units)", key, source.length_in_code_units());
+
+    m_style_sheets.set(move(key), move(style_sheet));
+    ++m_statistics.started;
+
+    discard_unused_style_sheets();
+
+    auto& main_thread_event_loop = Core::EventLoop::current();
+
+    Threading::ThreadPool::the().submit([job = move(job), &main_thread_event_loop]() mutable {
+        job->run();
+
+        main_thread_event_loop.deferred_invoke([job = move(job)] {
+            BackgroundStyleSheetTokenizer::the().did_finish_job(*job);
+        });
+    });
+}
+
+Optional<Vector<Token>> BackgroundStyleSheetTokenizer::take_tokens(URL::URL const& url, Utf16View source)
+{
+    auto it = m_style_sheets.find(url.serialize());
+    if (it == m_style_sheets.end())
+        return {};
+
+    auto& style_sheet = it->value;
+    if (style_sheet.source_hash != source.hash() || style_sheet.job->source().utf16_view() != source)
+        return {};
+
+    // NB: Someone is still waiting to be told that this job finished, so leave it to them.
+    if (!style_sheet.finished && !style_sheet.completion_callbacks.is_empty())
+        return {};
+
+    auto job = style_sheet.job;
+    m_style_sheets.remove(it);
+    ++m_statistics.used;
+
+    return Tokenizer::intern_string_values(job->wait_for_tokens());
+}
+
+void BackgroundStyleSheetTokenizer::did_finish_job(Job const& job)
+{
+    Vector<Function<void()>> completion_callbacks;
+
+    // NB: The tokens may already have been taken, or the style sheet replaced by newer contents.
+    for (auto& [key, style_sheet] : m_style_sheets) {
+        if (style_sheet.job.ptr() != &job)
+            continue;
+
+        style_sheet.finished = true;
+        completion_callbacks = move(style_sheet.completion_callbacks);
+        break;
+    }
+
+    for (auto& callback : completion_callbacks)
+        callback();
+}
+
+void BackgroundStyleSheetTokenizer::discard_unused_style_sheets()
+{
+    while (m_style_sheets.size() > MAXIMUM_PENDING_STYLE_SHEET_COUNT) {
+        Optional<String> oldest_key;
+        u64 oldest_started_at = NumericLimits<u64>::max();
+
+        // NB: Style sheets that someone is waiting for are never discarded.
+        for (auto const& [key, style_sheet] : m_style_sheets) {
+            if (!style_sheet.completion_callbacks.is_empty())
+                continue;
+            if (style_sheet.started_at < oldest_started_at) {
+                oldest_key = key;
+                oldest_started_at = style_sheet.started_at;
+            }
+        }
+
+        if (!oldest_key.has_value())
+            return;
+
+        dbgln_if(CSS_LOADER_DEBUG, "BackgroundStyleSheetTokenizer: Discarding unused tokens for {}", *oldest_key);
+
+        m_style_sheets.remove(*oldest_key);
+        ++m_statistics.discarded;
+    }
+}
+
+}
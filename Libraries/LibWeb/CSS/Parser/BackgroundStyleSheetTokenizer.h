@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/AtomicRefCounted.h>
+#include <AK/Function.h>
+#include <AK/HashMap.h>
+#include <AK/NonnullRefPtr.h>
+#include <AK/Optional.h>
+#include <AK/String.h>
+#include <AK/Utf16String.h>
+#include <AK/Vector.h>
+#include <LibSync/ConditionVariable.h>
+#include <LibSync/Mutex.h>
+#include <LibURL/Forward.h>
+#include <LibWeb/CSS/Parser/Token.h>
+#include <LibWeb/CSS/Parser/Tokenizer.h>
+#include <LibWeb/Export.h>
+
+namespace Web::CSS::Parser {
+
+// Tokenizes large external style sheets on a worker thread, so that the work overlaps with HTML parsing and script
+// execution. Style sheets are registered by URL as soon as their contents are known, including those fetched
+// speculatively for the preload scanner, and parse_css_stylesheet() then picks up the finished tokens instead of
+// tokenizing the sheet itself.
+//
+// Tokens hold interned strings, which may only be created on the main thread, so the worker leaves their string values
+// uninterned and the main thread interns them before parsing.
+class WEB_API BackgroundStyleSheetTokenizer {
+public:
+    static BackgroundStyleSheetTokenizer& the();
+
+    struct Statistics {
+        u64 started { 0 };
+        u64 used { 0 };
+        u64 discarded { 0 };
+    };
+
+    // Small style sheets are tokenized faster than a round trip through the thread pool.
+    static constexpr size_t MINIMUM_SOURCE_LENGTH = 32 * KiB;
+
+    bool should_tokenize_in_background(URL::URL const&, Utf16View source) const;
+
+    // Starts tokenizing the given style sheet, unless the same contents are already being tokenized for that URL.
+    // The completion callback is invoked on the main thread once the tokens are ready to be taken.
+    void tokenize(URL::URL const&, Utf16View source, Function<void()> on_complete = {});
+
+    // Returns the tokens of the given style sheet if it was tokenized in the background, waiting for the worker to
+    // finish if needed.
+    Optional<Vector<Token>> take_tokens(URL::URL const&, Utf16View source);
+
+    Statistics const& statistics() const { return m_statistics; }
+
+private:
+    class Job : public AtomicRefCounted<Job> {
+    public:
+        explicit Job(Utf16View source)
+            : m_source(Utf16String::from_utf16(source))
+        {
+        }
+
+        Utf16String const& source() const { return m_source; }
+
+        void run();
+        Tokenizer::UninternedTokens wait_for_tokens();
+
+    private:
+        // NB: The source is a private copy, which is only ever read once the job has been created, so the worker
+        //     may read it without synchronization.
+        Utf16String m_source;
+
+        Sync::Mutex m_mutex;
+        Sync::ConditionVariable m_condition { m_mutex };
+        Optional<Tokenizer::UninternedTokens> m_tokens;
+    };
+
+    struct PendingStyleSheet {
+        NonnullRefPtr<Job> job;
+        u32 source_hash { 0 };
+        u64 started_at { 0 };
+        bool finished { false };
+        Vector<Function<void()>> completion_callbacks;
+    };
+
+    void did_finish_job(Job const&);
+    void discard_unused_style_sheets();
+
+    HashMap<String, PendingStyleSheet> m_style_sheets;
+    u64 m_job_counter { 0 };
+
+    Statistics m_statistics;
+};
+
+}
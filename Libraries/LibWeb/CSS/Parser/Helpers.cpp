@@ -15,6 +15,8 @@
 #include <LibWeb/CSS/CSSRuleList.h>
 #include <LibWeb/CSS/CSSStyleSheet.h>
 #include <LibWeb/CSS/Keyword.h>
+#include <LibWeb/CSS/Parser/BackgroundStyleSheetTokenizer.h>
+#include <LibWeb/CSS/Parser/ParsedStyleSheetCache.h>
 #include <LibWeb/CSS/Parser/Parser.h>
 #include <LibWeb/HTML/Window.h>
 
@@ -59,6 +61,16 @@ GC::Ref<CSS::CSSStyleSheet> parse_css_stylesheet(CSS::Parser::ParsingParams cons
     return style_sheet;
 }
 
+static CSS::Parser::Parser create_style_sheet_parser(CSS::Parser::ParsingParams const& context, Utf16View css, Optional<::URL::URL> const& location)
+{
+    // OPTIMIZATION: Large style sheets may already have been tokenized on a worker thread.
+    if (location.has_value()) {
+        if (auto tokens = CSS::Parser::BackgroundStyleSheetTokenizer::the().take_tokens(*location, css); tokens.has_value())
+            return CSS::Parser::Parser::create(context, tokens.release_value());
+    }
+    return CSS::Parser::Parser::create(context, css);
+}
+
 GC::Ref<CSS::CSSStyleSheet> parse_css_stylesheet(CSS::Parser::ParsingParams const& context, Utf16View css, Optional<::URL::URL> location, GC::Ptr<CSS::MediaList> media_list)
 {
     if (css.is_empty()) {
@@ -69,7 +81,26 @@ GC::Ref<CSS::CSSStyleSheet> parse_css_stylesheet(CSS::Parser::ParsingParams cons
         style_sheet->set_source_text({});
         return style_sheet;
     }
-    auto style_sheet = CSS::Parser::Parser::create(context, css).parse_as_css_stylesheet(location, move(media_list));
+
+    // NB: Style sheets fetched from a URL are likely to be loaded again by other documents, so their parsed rules are
+    //     kept around. Each document still gets its own CSSOM objects from them.
+    if (location.has_value() && CSS::Parser::ParsedStyleSheetCache::is_cacheable(css)) {
+        auto& cache = CSS::Parser::ParsedStyleSheetCache::the();
+
+        auto entry = cache.find(*location, css);
+        if (!entry) {
+            auto rules = create_style_sheet_parser(context, css, location).parse_as_css_stylesheet_rules(location);
+            auto new_entry = adopt_ref(*new CSS::Parser::ParsedStyleSheetCache::Entry(Utf16String::from_utf16(css), move(rules)));
+            cache.insert(*location, new_entry);
+            entry = move(new_entry);
+        }
+
+        auto style_sheet = CSS::Parser::Parser::create(context, u""sv).convert_to_css_stylesheet(entry->rules, location, move(media_list));
+        style_sheet->set_source_text(entry->source);
+        return style_sheet;
+    }
+
+    auto style_sheet = create_style_sheet_parser(context, css, location).parse_as_css_stylesheet(location, move(media_list));
     style_sheet->set_source_text(Utf16String::from_utf16(css));
     return style_sheet;
 }
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Debug.h>
+#include <AK/NeverDestroyed.h>
+#include <LibURL/URL.h>
+#include <LibWeb/CSS/Parser/ComponentValue.h>
+#include <LibWeb/CSS/Parser/ParsedStyleSheetCache.h>
+
+namespace Web::CSS::Parser {
+
+ParsedStyleSheetCache& ParsedStyleSheetCache::the()
+{
+    static NeverDestroyed<ParsedStyleSheetCache> cache;
+    return *cache;
+}
+
+RefPtr<ParsedStyleSheetCache::Entry const> ParsedStyleSheetCache::find(URL::URL const& url, Utf16View source)
+{
+    auto it = m_style_sheets.find(url.serialize());
+
+    // NB: The same URL may serve different contents over time, so the contents must match as well.
+    if (it == m_style_sheets.end() || it->value.source_hash != source.hash() || it->value.entry->source.utf16_view() != source) {
+        ++m_statistics.misses;
+        return {};
+    }
+
+    ++m_statistics.hits;
+    it->value.last_used = ++m_use_counter;
+
+    return it->value.entry;
+}
+
+bool ParsedStyleSheetCache::contains(URL::URL const& url, Utf16View source) const
+{
+    auto it = m_style_sheets.find(url.serialize());
+    return it != m_style_sheets.end() && it->value.source_hash == source.hash() && it->value.entry->source.utf16_view() == source;
+}
+
+void ParsedStyleSheetCache::insert(URL::URL const& url, NonnullRefPtr<Entry const> entry)
+{
+    auto source_length = entry->source.length_in_code_units();
+    if (source_length > MAXIMUM_TOTAL_SOURCE_LENGTH)
+        return;
+
+    auto key = url.serialize();
+    if (auto existing = m_style_sheets.find(key); existing != m_style_sheets.end()) {
+        m_total_source_length -= existing->value.entry->source.length_in_code_units();
+        m_style_sheets.remove(existing);
+    }
+
+    auto source_hash = entry->source.utf16_view().hash();
+    m_style_sheets.set(move(key), { .entry = move(entry), .source_hash = source_hash, .last_used = ++m_use_counter });
+    m_total_source_length += source_length;
+
+    evict_least_recently_used_entries();
+}
+
+void ParsedStyleSheetCache::clear()
+{
+    m_style_sheets.clear();
+    m_total_source_length = 0;
+}
+
+void ParsedStyleSheetCache::evict_least_recently_used_entries()
+{
+    while (m_style_sheets.size() > MAXIMUM_ENTRY_COUNT || m_total_source_length > MAXIMUM_TOTAL_SOURCE_LENGTH) {
+        auto oldest = m_style_sheets.begin();
+
+        for (auto it = m_style_sheets.begin(); it != m_style_sheets.end(); ++it) {
+            if (it->value.last_used < oldest->value.last_used)
+                oldest = it;
+        }
+
+        dbgln_if(CSS_LOADER_DEBUG, "ParsedStyleSheetCache: Evicting {}", oldest->key);
+
+        m_total_source_length -= oldest->value.entry->source.length_in_code_units();
+        m_style_sheets.remove(oldest);
+        ++m_statistics.evictions;
+    }
+}
+
+}
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/HashMap.h>
+#include <AK/NonnullRefPtr.h>
+#include <AK/RefCounted.h>
+#include <AK/String.h>
+#include <AK/Utf16String.h>
+#include <AK/Vector.h>
+#include <LibURL/Forward.h>
+#include <LibWeb/CSS/Parser/Types.h>
+#include <LibWeb/Export.h>
+
+namespace Web::CSS::Parser {
+
+// A process-wide cache of parsed style sheets, keyed by their URL and contents, so that documents loading the same
+// style sheet (other pages of the same site, iframes, @imports shared between sheets) only tokenize and parse it
+// once. Only the realm-independent result of "parse a stylesheet" is cached. Every document still converts those
+// rules into its own CSSOM objects, which it is then free to mutate without affecting other documents.
+class WEB_API ParsedStyleSheetCache {
+public:
+    static ParsedStyleSheetCache& the();
+
+    struct Entry : public RefCounted<Entry> {
+        Entry(Utf16String source, Vector<Rule> rules)
+            : source(move(source))
+            , rules(move(rules))
+        {
+        }
+
+        Utf16String source;
+        Vector<Rule> rules;
+    };
+
+    struct Statistics {
+        u64 hits { 0 };
+        u64 misses { 0 };
+        u64 evictions { 0 };
+    };
+
+    // Small style sheets are cheap enough to parse that caching them would only evict more valuable entries.
+    static constexpr size_t MINIMUM_SOURCE_LENGTH = 1024;
+
+    static bool is_cacheable(Utf16View source) { return source.length_in_code_units() >= MINIMUM_SOURCE_LENGTH; }
+
+    // Bounds on the cache. Parsed rules take up several times the memory of their source text, so the total is measured
+    // in source code units rather than entries alone.
+    static constexpr size_t MAXIMUM_ENTRY_COUNT = 64;
+    static constexpr size_t MAXIMUM_TOTAL_SOURCE_LENGTH = 4 * MiB;
+
+    RefPtr<Entry const> find(URL::URL const&, Utf16View source);
+    bool contains(URL::URL const&, Utf16View source) const;
+    void insert(URL::URL const&, NonnullRefPtr<Entry const>);
+    void clear();
+
+    Statistics const& statistics() const { return m_statistics; }
+
+private:
+    struct CachedStyleSheet {
+        NonnullRefPtr<Entry const> entry;
+        u32 source_hash { 0 };
+        u64 last_used { 0 };
+    };
+
+    void evict_least_recently_used_entries();
+
+    HashMap<String, CachedStyleSheet> m_style_sheets;
+    size_t m_total_source_length { 0 };
+    u64 m_use_counter { 0 };
+
+    Statistics m_statistics;
+};
+
+}
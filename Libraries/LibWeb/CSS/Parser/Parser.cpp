@@ -82,6 +82,11 @@ Parser Parser::create(ParsingParams const& context, Utf16View input)
     return Parser { context, move(tokens) };
 }
 
+Parser Parser::create(ParsingParams const& context, Vector<Token> tokens)
+{
+    return Parser { context, move(tokens) };
+}
+
 Parser::Parser(ParsingParams const& context, Vector<Token> tokens)
     : m_document(context.document)
     , m_realm(context.realm)
@@ -193,7 +198,17 @@ GC::Ref<CSS::CSSStyleSheet> Parser::parse_as_css_stylesheet(Optional<::URL::URL>
     // To parse a CSS stylesheet, first parse a stylesheet.
     auto const& style_sheet = parse_a_stylesheet(m_token_stream, location);
 
-    auto rule_list = CSSRuleList::create(realm(), convert_rules(style_sheet.rules));
+    return convert_to_css_stylesheet(style_sheet.rules, move(location), move(media_list));
+}
+
+Vector<Rule> Parser::parse_as_css_stylesheet_rules(Optional<::URL::URL> location)
+{
+    return parse_a_stylesheet(m_token_stream, move(location)).rules;
+}
+
+GC::Ref<CSS::CSSStyleSheet> Parser::convert_to_css_stylesheet(Vector<Rule> const& raw_rules, Optional<::URL::URL> location, GC::Ptr<MediaList> media_list)
+{
+    auto rule_list = CSSRuleList::create(realm(), convert_rules(raw_rules));
     if (!media_list)
         media_list = MediaList::create(realm(), {});
     return CSSStyleSheet::create(realm(), rule_list, *media_list, move(location));
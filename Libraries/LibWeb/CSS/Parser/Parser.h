@@ -137,9 +137,14 @@ class Parser {
 public:
     static Parser create(ParsingParams const&, StringView input, StringView encoding = "utf-8"sv);
     static Parser create(ParsingParams const&, Utf16View input);
+    static Parser create(ParsingParams const&, Vector<Token> tokens);
 
     GC::RootVector<GC::Ref<CSSRule>> convert_rules(Vector<Rule> const& raw_rules);
     GC::Ref<CSS::CSSStyleSheet> parse_as_css_stylesheet(Optional<::URL::URL> location, GC::Ptr<MediaList> = {});
+    // Only runs "parse a stylesheet", producing the realm-independent rules that convert_to_css_stylesheet() turns
+    // into CSSOM objects. This lets callers parse a style sheet once and instantiate it in several documents.
+    Vector<Rule> parse_as_css_stylesheet_rules(Optional<::URL::URL> location);
+    GC::Ref<CSS::CSSStyleSheet> convert_to_css_stylesheet(Vector<Rule> const& raw_rules, Optional<::URL::URL> location, GC::Ptr<MediaList> = {});
 
     struct PropertiesAndCustomProperties {
         Vector<StyleProperty> properties;
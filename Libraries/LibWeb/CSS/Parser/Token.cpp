@@ -457,6 +457,15 @@ void Token::set_position_range(Badge<Tokenizer, RustTokenizer>, SourcePosition s
     m_end_position = end;
 }
 
+void Token::set_string_value(Badge<Tokenizer>, Utf16FlyString value)
+{
+    m_value.visit(
+        [&](Utf16FlyString& string) { string = move(value); },
+        [&](HashValue& hash) { hash.value = move(value); },
+        [&](DimensionValue& dimension) { dimension.unit = move(value); },
+        [](auto&) { VERIFY_NOT_REACHED(); });
+}
+
 Utf16FlyString const& Token::string_value() const
 {
     return m_value.get<Utf16FlyString>();
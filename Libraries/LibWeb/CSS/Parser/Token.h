@@ -185,6 +185,7 @@ public:
     SourcePosition const& start_position() const { return m_start_position; }
     SourcePosition const& end_position() const { return m_end_position; }
     void set_position_range(Badge<Tokenizer, RustTokenizer>, SourcePosition start, SourcePosition end);
+    void set_string_value(Badge<Tokenizer>, Utf16FlyString);
 
     bool operator==(Token const& other) const
     {
@@ -234,6 +234,33 @@ Vector<Token> Tokenizer::tokenize(StringView input, StringView encoding, Tokeniz
 }
 
 Vector<Token> Tokenizer::tokenize(Utf16View input)
+{
+    Tokenizer tokenizer { filter_code_points(input) };
+    return tokenizer.tokenize();
+}
+
+Tokenizer::UninternedTokens Tokenizer::tokenize_without_interning(Utf16View input)
+{
+    // NB: This may run off the main thread, so it must not touch the table of interned strings.
+    Tokenizer tokenizer { filter_code_points(input), Interning::Deferred };
+
+    UninternedTokens uninterned_tokens;
+    uninterned_tokens.m_tokens = tokenizer.tokenize();
+    uninterned_tokens.m_string_values = move(tokenizer.m_deferred_string_values);
+    return uninterned_tokens;
+}
+
+Vector<Token> Tokenizer::intern_string_values(UninternedTokens uninterned_tokens)
+{
+    auto tokens = move(uninterned_tokens.m_tokens);
+
+    for (auto& [token_index, value] : uninterned_tokens.m_string_values)
+        tokens[token_index].set_string_value({}, Utf16FlyString { value });
+
+    return tokens;
+}
+
+String Tokenizer::filter_code_points(Utf16View input)
 {
     StringBuilder builder { input.length_in_code_units() };
     bool last_was_carriage_return = false;
@@ -267,14 +294,14 @@ Vector<Token> Tokenizer::tokenize(Utf16View input)
     if (last_was_carriage_return)
         builder.append('\n');
 
-    Tokenizer tokenizer { builder.to_string_without_validation() };
-    return tokenizer.tokenize();
+    return builder.to_string_without_validation();
 }
 
-Tokenizer::Tokenizer(String decoded_input)
+Tokenizer::Tokenizer(String decoded_input, Interning interning)
     : m_decoded_input(move(decoded_input))
     , m_utf8_view(m_decoded_input)
     , m_utf8_iterator(m_utf8_view.begin())
+    , m_interning(interning)
 {
 }
 
@@ -287,6 +314,9 @@ Vector<Token> Tokenizer::tokenize()
         token.set_position_range(Badge<Tokenizer> {}, token_start, m_position);
         tokens.append(token);
 
+        if (m_deferred_string_value.has_value())
+            m_deferred_string_values.append({ tokens.size() - 1, m_deferred_string_value.release_value() });
+
         if (token.is(Token::Type::EndOfFile)) {
             return tokens;
         }
@@ -379,6 +409,18 @@ Token Tokenizer::create_eof_token()
     return Token::create(Token::Type::EndOfFile);
 }
 
+Utf16FlyString Tokenizer::create_string_value(Utf16View value)
+{
+    if (m_interning == Interning::Immediate)
+        return Utf16FlyString::from_utf16(value);
+
+    // NB: Every token has at most one string value. It is interned once the tokens reach the main thread, and until
+    //     then the token holds an empty placeholder, which does not need the table of interned strings.
+    VERIFY(!m_deferred_string_value.has_value());
+    m_deferred_string_value = Utf16String::from_utf16(value);
+    return {};
+}
+
 // https://www.w3.org/TR/css-syntax-3/#consume-escaped-code-point
 u32 Tokenizer::consume_escaped_code_point()
 {
@@ -439,11 +481,12 @@ Token Tokenizer::consume_an_ident_like_token()
 
     // Consume an ident sequence, and let string be the result.
     auto start_byte_offset = current_byte_offset();
-    auto string = consume_an_ident_sequence();
+    Utf16StringBuilder string;
+    consume_an_ident_sequence(string);
 
     // If string’s value is an ASCII case-insensitive match for "url", and the next input code
     // point is U+0028 LEFT PARENTHESIS ((), consume it.
-    if (string.equals_ignoring_ascii_case("url"sv) && is_left_paren(peek_code_point())) {
+    if (string.view().equals_ignoring_ascii_case("url"sv) && is_left_paren(peek_code_point())) {
         (void)next_code_point();
 
         // While the next two input code points are whitespace, consume the next input code point.
@@ -461,7 +504,7 @@ Token Tokenizer::consume_an_ident_like_token()
         // <function-token> with its value set to string and return it.
         auto next_two = peek_twin();
         if (is_quotation_mark(next_two.first) || is_apostrophe(next_two.first) || (is_whitespace(next_two.first) && (is_quotation_mark(next_two.second) || is_apostrophe(next_two.second)))) {
-            return Token::create_function(move(string), input_since(start_byte_offset));
+            return Token::create_function(create_string_value(string.view()), input_since(start_byte_offset));
         }
 
         // Otherwise, consume a url token, and return it.
@@ -473,11 +516,11 @@ Token Tokenizer::consume_an_ident_like_token()
         (void)next_code_point();
 
         // Create a <function-token> with its value set to string and return it.
-        return Token::create_function(move(string), input_since(start_byte_offset));
+        return Token::create_function(create_string_value(string.view()), input_since(start_byte_offset));
     }
 
     // Otherwise, create an <ident-token> with its value set to string and return it.
-    return Token::create_ident(move(string), input_since(start_byte_offset));
+    return Token::create_ident(create_string_value(string.view()), input_since(start_byte_offset));
 }
 
 // https://www.w3.org/TR/css-syntax-3/#consume-number
@@ -586,7 +629,7 @@ double Tokenizer::convert_a_string_to_a_number(StringView string)
 }
 
 // https://www.w3.org/TR/css-syntax-3/#consume-name
-Utf16FlyString Tokenizer::consume_an_ident_sequence()
+void Tokenizer::consume_an_ident_sequence(Utf16StringBuilder& result)
 {
     // This section describes how to consume an ident sequence from a stream of code points.
     // It returns a string containing the largest name that can be formed from adjacent
@@ -598,7 +641,7 @@ Utf16FlyString Tokenizer::consume_an_ident_sequence()
     // calling this algorithm.
 
     // Let result initially be an empty string.
-    Utf16StringBuilder result;
+    VERIFY(result.is_empty());
 
     // Repeatedly consume the next input code point from the stream:
     for (;;) {
@@ -626,8 +669,6 @@ Utf16FlyString Tokenizer::consume_an_ident_sequence()
         reconsume_current_input_code_point();
         break;
     }
-
-    return Utf16FlyString::from_utf16(result.view());
 }
 
 // https://www.w3.org/TR/css-syntax-3/#consume-url-token
@@ -655,14 +696,14 @@ Token Tokenizer::consume_a_url_token(size_t start_byte_offset)
         // U+0029 RIGHT PARENTHESIS ())
         if (is_right_paren(input)) {
             // Return the <url-token>.
-            return Token::create_url(Utf16FlyString::from_utf16(builder.view()), input_since(start_byte_offset));
+            return Token::create_url(create_string_value(builder.view()), input_since(start_byte_offset));
         }
 
         // EOF
         if (is_eof(input)) {
             // This is a parse error. Return the <url-token>.
             log_parse_error();
-            return Token::create_url(Utf16FlyString::from_utf16(builder.view()), input_since(start_byte_offset));
+            return Token::create_url(create_string_value(builder.view()), input_since(start_byte_offset));
         }
 
         // whitespace
@@ -676,13 +717,13 @@ Token Tokenizer::consume_a_url_token(size_t start_byte_offset)
 
             if (is_right_paren(input)) {
                 (void)next_code_point();
-                return Token::create_url(Utf16FlyString::from_utf16(builder.view()), input_since(start_byte_offset));
+                return Token::create_url(create_string_value(builder.view()), input_since(start_byte_offset));
             }
 
             if (is_eof(input)) {
                 (void)next_code_point();
                 log_parse_error();
-                return Token::create_url(Utf16FlyString::from_utf16(builder.view()), input_since(start_byte_offset));
+                return Token::create_url(create_string_value(builder.view()), input_since(start_byte_offset));
             }
 
             // otherwise, consume the remnants of a bad url, create a <bad-url-token>, and return it.
@@ -785,12 +826,13 @@ Token Tokenizer::consume_a_numeric_token()
         //    and a unit set initially to the empty string.
 
         // 2. Consume an ident sequence. Set the <dimension-token>’s unit to the returned value.
-        auto unit = consume_an_ident_sequence();
+        Utf16StringBuilder unit;
+        consume_an_ident_sequence(unit);
         VERIFY(!unit.is_empty());
         // NOTE: We intentionally store this in the `value`, to save space.
 
         // 3. Return the <dimension-token>.
-        return Token::create_dimension(number, unit, input_since(start_byte_offset));
+        return Token::create_dimension(number, create_string_value(unit.view()), input_since(start_byte_offset));
     }
 
     // Otherwise, if the next input code point is U+0025 PERCENTAGE SIGN (%), consume it.
@@ -936,14 +978,14 @@ Token Tokenizer::consume_string_token(u32 ending_code_point)
         // ending code point
         if (input == ending_code_point) {
             // Return the <string-token>.
-            return Token::create_string(Utf16FlyString::from_utf16(builder.view()), input_since(original_source_text_start_byte_offset_including_quotation_mark));
+            return Token::create_string(create_string_value(builder.view()), input_since(original_source_text_start_byte_offset_including_quotation_mark));
         }
 
         // EOF
         if (is_eof(input)) {
             // This is a parse error. Return the <string-token>.
             log_parse_error();
-            return Token::create_string(Utf16FlyString::from_utf16(builder.view()), input_since(original_source_text_start_byte_offset_including_quotation_mark));
+            return Token::create_string(create_string_value(builder.view()), input_since(original_source_text_start_byte_offset_including_quotation_mark));
         }
 
         // newline
@@ -1071,10 +1113,11 @@ Token Tokenizer::consume_a_token()
                 hash_type = Token::HashType::Id;
 
             // 3. Consume an ident sequence, and set the <hash-token>’s value to the returned string.
-            auto value = consume_an_ident_sequence();
+            Utf16StringBuilder value;
+            consume_an_ident_sequence(value);
 
             // 4. Return the <hash-token>.
-            return Token::create_hash(move(value), hash_type, input_since(start_byte_offset));
+            return Token::create_hash(create_string_value(value.view()), hash_type, input_since(start_byte_offset));
         }
 
         // Otherwise, return a <delim-token> with its value set to the current input code point.
@@ -1206,8 +1249,9 @@ Token Tokenizer::consume_a_token()
         // If the next 3 input code points would start an ident sequence, consume an ident sequence, create
         // an <at-keyword-token> with its value set to the returned value, and return it.
         if (would_start_an_ident_sequence(peek_triplet())) {
-            auto name = consume_an_ident_sequence();
-            return Token::create_at_keyword(move(name), input_since(start_byte_offset));
+            Utf16StringBuilder name;
+            consume_an_ident_sequence(name);
+            return Token::create_at_keyword(create_string_value(name.view()), input_since(start_byte_offset));
         }
 
         // Otherwise, return a <delim-token> with its value set to the current input code point.
@@ -10,6 +10,7 @@
 #include <AK/Optional.h>
 #include <AK/StringView.h>
 #include <AK/Types.h>
+#include <AK/Utf16String.h>
 #include <AK/Utf16View.h>
 #include <AK/Utf8View.h>
 #include <LibWeb/CSS/Parser/Token.h>
@@ -69,10 +70,39 @@ public:
     static Vector<Token> tokenize(StringView input, StringView encoding, TokenizerInput = TokenizerInput::DecodedText);
     static Vector<Token> tokenize(Utf16View input);
 
+    // https://www.w3.org/TR/css-syntax-3/#css-filter-code-points
+    static String filter_code_points(Utf16View input);
+
+    // Tokens whose string values have yet to be interned. Interned strings may only be created on the main thread,
+    // whereas these may be produced on any thread and then handed to the main thread to finish.
+    class WEB_API UninternedTokens {
+    public:
+        size_t size() const { return m_tokens.size(); }
+
+    private:
+        friend class Tokenizer;
+
+        struct StringValue {
+            size_t token_index { 0 };
+            Utf16String value;
+        };
+
+        Vector<Token> m_tokens;
+        Vector<StringValue> m_string_values;
+    };
+
+    static UninternedTokens tokenize_without_interning(Utf16View input);
+    static Vector<Token> intern_string_values(UninternedTokens);
+
     [[nodiscard]] static Token create_eof_token();
 
 private:
-    explicit Tokenizer(String decoded_input);
+    enum class Interning : u8 {
+        Immediate,
+        Deferred,
+    };
+
+    explicit Tokenizer(String decoded_input, Interning = Interning::Immediate);
 
     [[nodiscard]] Vector<Token> tokenize();
 
@@ -87,13 +117,15 @@ private:
     [[nodiscard]] U32Twin start_of_input_stream_twin();
     [[nodiscard]] U32Triplet start_of_input_stream_triplet();
 
+    [[nodiscard]] Utf16FlyString create_string_value(Utf16View);
+
     [[nodiscard]] Token consume_a_token();
     [[nodiscard]] Token consume_string_token(u32 ending_code_point);
     [[nodiscard]] Token consume_a_numeric_token();
     [[nodiscard]] Token consume_an_ident_like_token();
     [[nodiscard]] Number consume_a_number();
     [[nodiscard]] double convert_a_string_to_a_number(StringView);
-    [[nodiscard]] Utf16FlyString consume_an_ident_sequence();
+    void consume_an_ident_sequence(Utf16StringBuilder& result);
     [[nodiscard]] u32 consume_escaped_code_point();
     [[nodiscard]] Token consume_a_url_token(size_t start_byte_offset);
     void consume_the_remnants_of_a_bad_url();
@@ -110,6 +142,10 @@ private:
     Utf8CodePointIterator m_prev_utf8_iterator;
     SourcePosition m_position;
     SourcePosition m_prev_position;
+
+    Interning m_interning { Interning::Immediate };
+    Optional<Utf16String> m_deferred_string_value;
+    Vector<UninternedTokens::StringValue> m_deferred_string_values;
 };
 
 }
@@ -7,6 +7,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/AnyOf.h>
 #include <AK/Array.h>
 #include <AK/BinarySearch.h>
 #include <AK/Bitmap.h>
@@ -91,6 +92,7 @@
 #include <LibWeb/DOM/Document.h>
 #include <LibWeb/DOM/Element.h>
 #include <LibWeb/DOM/ShadowRoot.h>
+#include <LibWeb/DOM/Text.h>
 #include <LibWeb/HTML/AttributeNames.h>
 #include <LibWeb/HTML/HTMLBRElement.h>
 #include <LibWeb/HTML/HTMLHtmlElement.h>
@@ -172,6 +174,8 @@ void StyleComputer::visit_edges(Visitor& visitor)
         visitor.visit(*m_has_result_cache);
     if (m_has_fast_reject_filter_cache)
         visitor.visit(*m_has_fast_reject_filter_cache);
+    for (auto const& candidate : m_style_sharing_candidates)
+        visitor.visit(candidate.element);
 
     if (m_cached_font_computation_context.has_value())
         m_cached_font_computation_context->visit_edges(visitor);
@@ -2523,6 +2527,11 @@ NonnullRefPtr<CascadedProperties> StyleComputer::compute_cascaded_values(DOM::Ab
             bulk_context.pinned_values.append(move(resolved));
             return result;
         },
+        .record_custom_property_dependency = [](void* context, u8 const* name, size_t name_length) {
+            auto& bulk_context = *static_cast<BulkCascadeContext*>(context);
+            bulk_context.abstract_element.element().add_custom_property_dependency(
+                Utf16FlyString::from_utf8(StringView { reinterpret_cast<char const*>(name), name_length }));
+        },
         .assign_source_slots = [](void* context, ComputedValuesFFI::FfiSourceSlotAssignment const* assignments, size_t count) {
             auto& bulk_context = *static_cast<BulkCascadeContext*>(context);
             for (size_t i = 0; i < count; ++i) {
@@ -3106,10 +3115,21 @@ NonnullRefPtr<ComputedValues const> StyleComputer::create_document_style() const
 
 NonnullRefPtr<ComputedValues const> StyleComputer::compute_style(DOM::AbstractElement abstract_element, Optional<bool&> did_change_custom_properties) const
 {
+    auto const may_share_style = m_style_sharing_enabled && !abstract_element.pseudo_element().has_value();
+    if (may_share_style) {
+        if (auto shared_style = find_shared_style(abstract_element.element(), did_change_custom_properties))
+            return shared_style.release_nonnull();
+    }
+
     auto& style_scope = abstract_element.style_scope();
     auto computed_properties = compute_style_impl(abstract_element, ComputeStyleMode::Normal, did_change_custom_properties, style_scope, IncludeInlineStyle::Yes);
     VERIFY(computed_properties);
-    return build_computed_values(*computed_properties, abstract_element, style_scope);
+    auto computed_values = build_computed_values(*computed_properties, abstract_element, style_scope);
+
+    if (may_share_style)
+        remember_style_for_sharing(abstract_element.element(), computed_values);
+
+    return computed_values;
 }
 
 NonnullRefPtr<ComputedProperties> StyleComputer::compute_properties_without_inline_style(DOM::AbstractElement abstract_element) const
@@ -3246,6 +3266,17 @@ NonnullRefPtr<ComputedProperties> StyleComputer::reconstruct_computed_properties
     return style;
 }
 
+static bool own_custom_properties_differ(RefPtr<CustomPropertyData const> const& old_custom_property_data, RefPtr<CustomPropertyData const> const& new_custom_property_data)
+{
+    if (old_custom_property_data.ptr() == new_custom_property_data.ptr())
+        return false;
+
+    static NeverDestroyed<OrderedHashMap<Utf16FlyString, StyleProperty>> empty_own_values;
+    auto const& old_own = old_custom_property_data ? old_custom_property_data->own_values() : *empty_own_values;
+    auto const& new_own = new_custom_property_data ? new_custom_property_data->own_values() : *empty_own_values;
+    return old_own != new_own;
+}
+
 RefPtr<ComputedProperties> StyleComputer::compute_style_impl(DOM::AbstractElement abstract_element, ComputeStyleMode mode, Optional<bool&> did_change_custom_properties, StyleScope const& style_scope, IncludeInlineStyle include_inline_style) const
 {
     style_scope.build_rule_cache_if_needed();
@@ -3309,16 +3340,8 @@ RefPtr<ComputedProperties> StyleComputer::compute_style_impl(DOM::AbstractElemen
 
     auto computed_properties = compute_properties(abstract_element, cascaded_properties, matching_rule_set.matching_pseudo_element_styles);
 
-    if (did_change_custom_properties.has_value()) {
-        auto new_custom_property_data = abstract_element.custom_property_data();
-        if (old_custom_property_data.ptr() != new_custom_property_data.ptr()) {
-            static NeverDestroyed<OrderedHashMap<Utf16FlyString, StyleProperty>> empty_own_values;
-            auto const& old_own = old_custom_property_data ? old_custom_property_data->own_values() : *empty_own_values;
-            auto const& new_own = new_custom_property_data ? new_custom_property_data->own_values() : *empty_own_values;
-            if (old_own != new_own)
-                *did_change_custom_properties = true;
-        }
-    }
+    if (did_change_custom_properties.has_value() && own_custom_properties_differ(old_custom_property_data, abstract_element.custom_property_data()))
+        *did_change_custom_properties = true;
 
     return computed_properties;
 }
@@ -4162,6 +4185,231 @@ static bool matches_subject_pseudo_class_bucket(PseudoClass pseudo_class, DOM::E
     }
 }
 
+// NB: The pseudo-class states that any element can be in, and that can therefore differ between two siblings with
+//     identical attributes. States specific to links, form controls, media elements, etc. are not listed here, as
+//     those elements never share style.
+static constexpr Array style_sharing_pseudo_classes {
+    PseudoClass::Active,
+    PseudoClass::Focus,
+    PseudoClass::FocusVisible,
+    PseudoClass::FocusWithin,
+    PseudoClass::Fullscreen,
+    PseudoClass::Hover,
+    PseudoClass::Target,
+};
+
+static bool matches_empty_pseudo_class(DOM::Element const& element)
+{
+    if (element.first_child_of_type<DOM::Element>())
+        return false;
+
+    bool has_nonempty_text_child = false;
+    element.for_each_child_of_type<DOM::Text>([&](auto const& text) {
+        if (!text.data().is_empty()) {
+            has_nonempty_text_child = true;
+            return IterationDecision::Break;
+        }
+        return IterationDecision::Continue;
+    });
+    return !has_nonempty_text_child;
+}
+
+static u32 style_sharing_pseudo_class_state(DOM::Element const& element)
+{
+    u32 state = 0;
+    for (size_t i = 0; i < style_sharing_pseudo_classes.size(); ++i) {
+        if (matches_subject_pseudo_class_bucket(style_sharing_pseudo_classes[i], element))
+            state |= 1u << i;
+    }
+    if (matches_empty_pseudo_class(element))
+        state |= 1u << style_sharing_pseudo_classes.size();
+    return state;
+}
+
+static bool element_may_share_style(DOM::Element const& element)
+{
+    // Only siblings share style, so that every selector reaching past the element itself sees the same ancestors.
+    // Children of shadow roots are excluded, since the shadow root itself has no style to compare.
+    auto const* parent = element.parent();
+    if (!parent || !parent->is_element())
+        return false;
+
+    if (!element.is_html_element() || element.is_document_element())
+        return false;
+    if (element.inline_style() || element.is_shadow_host() || element.assigned_slot_internal())
+        return false;
+    if (element.associated_shadow_host_pseudo_element().has_value())
+        return false;
+    if (element.is_custom() || !element.is_defined())
+        return false;
+    if (element.has_css_defined_animations() || element.has_relevant_animations())
+        return false;
+
+    // NB: :dir() and :popover-open depend on state that isn't reflected in the element's attributes.
+    if (element.has_attribute(HTML::AttributeNames::dir) || element.has_attribute(HTML::AttributeNames::popover))
+        return false;
+
+    // Links, form controls, media and embedded content carry state that selectors can observe (:visited, :checked,
+    // :open, :playing, ...), or presentational hints that depend on more than their attributes.
+    return !element.local_name().is_one_of(
+        HTML::TagNames::a,
+        HTML::TagNames::area,
+        HTML::TagNames::audio,
+        HTML::TagNames::bdi,
+        HTML::TagNames::button,
+        HTML::TagNames::canvas,
+        HTML::TagNames::details,
+        HTML::TagNames::dialog,
+        HTML::TagNames::embed,
+        HTML::TagNames::fieldset,
+        HTML::TagNames::form,
+        HTML::TagNames::iframe,
+        HTML::TagNames::img,
+        HTML::TagNames::input,
+        HTML::TagNames::link,
+        HTML::TagNames::meter,
+        HTML::TagNames::object,
+        HTML::TagNames::optgroup,
+        HTML::TagNames::option,
+        HTML::TagNames::output,
+        HTML::TagNames::progress,
+        HTML::TagNames::select,
+        HTML::TagNames::selectedcontent,
+        HTML::TagNames::slot,
+        HTML::TagNames::textarea,
+        HTML::TagNames::video);
+}
+
+// NB: Comparing every attribute covers the class list, the id, presentational hints and attr() in one go.
+static bool elements_have_identical_attributes(DOM::Element const& a, DOM::Element const& b)
+{
+    if (a.local_name() != b.local_name() || a.namespace_uri() != b.namespace_uri())
+        return false;
+
+    auto attribute_count = a.attribute_list_size();
+    if (attribute_count != b.attribute_list_size())
+        return false;
+    if (attribute_count == 0)
+        return true;
+
+    auto a_attributes = a.attributes();
+    auto b_attributes = b.attributes();
+    for (u32 i = 0; i < attribute_count; ++i) {
+        auto const* a_attribute = a_attributes->item(i);
+        auto const* b_attribute = b_attributes->item(i);
+        if (a_attribute->local_name() != b_attribute->local_name()
+            || a_attribute->namespace_uri() != b_attribute->namespace_uri()
+            || a_attribute->value() != b_attribute->value())
+            return false;
+    }
+    return true;
+}
+
+void StyleComputer::set_style_sharing_enabled(bool enabled)
+{
+    m_style_sharing_enabled = enabled;
+    m_style_sharing_candidates.clear();
+}
+
+// OPTIMIZATION: Siblings with the same tag, attributes and interaction state match exactly the same rules, so they
+//               end up with identical computed values. Rather than running the cascade for each of them, we reuse the
+//               style of a recently computed sibling.
+RefPtr<ComputedValues const> StyleComputer::find_shared_style(DOM::Element& element, Optional<bool&> did_change_custom_properties) const
+{
+    if (m_style_sharing_candidates.is_empty() || !element_may_share_style(element))
+        return {};
+
+    auto const* parent = element.parent_element();
+    auto const* parent_style = parent->computed_values();
+    Optional<u32> pseudo_class_state;
+
+    for (auto const& candidate : m_style_sharing_candidates) {
+        if (candidate.element->parent_element() != parent || candidate.parent_style.ptr() != parent_style)
+            continue;
+        if (!elements_have_identical_attributes(element, *candidate.element))
+            continue;
+
+        if (!pseudo_class_state.has_value())
+            pseudo_class_state = style_sharing_pseudo_class_state(element);
+        if (candidate.pseudo_class_state != *pseudo_class_state)
+            continue;
+
+        DOM::AbstractElement abstract_element { element };
+        auto old_custom_property_data = abstract_element.custom_property_data();
+        abstract_element.set_custom_property_data(candidate.custom_property_data);
+        if (did_change_custom_properties.has_value() && own_custom_properties_differ(old_custom_property_data, candidate.custom_property_data))
+            *did_change_custom_properties = true;
+
+        // The candidate's dependencies are ours too, so that we get invalidated along with it.
+        if (candidate.style_uses_var_css_function)
+            element.set_style_uses_var_css_function();
+        if (candidate.style_uses_if_css_function)
+            element.set_style_uses_if_css_function();
+        if (candidate.style_uses_inherit_css_function)
+            element.set_style_uses_inherit_css_function();
+        if (candidate.style_uses_attr_css_function)
+            element.set_style_uses_attr_css_function();
+        if (candidate.style_depends_on_size_container_query)
+            element.set_style_depends_on_size_container_query();
+        if (candidate.style_depends_on_style_container_query)
+            element.set_style_depends_on_style_container_query();
+        for (auto const& name : candidate.custom_property_dependencies)
+            element.add_custom_property_dependency(name);
+
+        element.set_needs_style_update(false);
+        document().style_invalidation_counters().element_style_sharing_hits++;
+        return candidate.style;
+    }
+
+    return {};
+}
+
+void StyleComputer::remember_style_for_sharing(DOM::Element const& element, NonnullRefPtr<ComputedValues const> const& style) const
+{
+    if (!element_may_share_style(element))
+        return;
+
+    // Styles that depend on the element's position among its siblings or on its descendants can't be shared.
+    if (element.affected_by_direct_sibling_combinator()
+        || element.affected_by_indirect_sibling_combinator()
+        || element.affected_by_first_child_pseudo_class()
+        || element.affected_by_last_child_pseudo_class()
+        || element.affected_by_forward_positional_pseudo_class()
+        || element.affected_by_backward_positional_pseudo_class()
+        || element.affected_by_has_pseudo_class_in_subject_position()
+        || element.affected_by_has_pseudo_class_with_relative_selector_that_has_sibling_combinator()
+        || element.style_uses_tree_counting_function())
+        return;
+
+    // Animations and transitions are started per element while cascading, which sharing would skip.
+    if (style->has_animated_values())
+        return;
+    if (any_of(style->animation_names(), [](auto const& name) { return name.syntax != ComputedAnimationNameSyntax::None; }))
+        return;
+    if (any_of(style->transition_durations(), [](auto const& duration) { return duration.to_seconds() > 0; })
+        || any_of(style->transition_delays(), [](auto const& delay) { return delay.to_seconds() > 0; }))
+        return;
+
+    if (m_style_sharing_candidates.size() == STYLE_SHARING_CACHE_SIZE)
+        m_style_sharing_candidates.take_last();
+
+    auto const* parent_style = element.parent_element()->computed_values();
+    m_style_sharing_candidates.prepend({
+        .element = element,
+        .style = style,
+        .parent_style = parent_style,
+        .custom_property_data = element.custom_property_data({}),
+        .pseudo_class_state = style_sharing_pseudo_class_state(element),
+        .style_uses_var_css_function = element.style_uses_var_css_function(),
+        .style_uses_if_css_function = element.style_uses_if_css_function(),
+        .style_uses_inherit_css_function = element.style_uses_inherit_css_function(),
+        .style_uses_attr_css_function = element.style_uses_attr_css_function(),
+        .style_depends_on_size_container_query = element.style_depends_on_size_container_query(),
+        .style_depends_on_style_container_query = element.style_depends_on_style_container_query(),
+        .custom_property_dependencies = element.custom_property_dependencies(),
+    });
+}
+
 static NonnullRefPtr<StyleValue const> resolve_css_wide_keyword_for_custom_property(Optional<CustomPropertyRegistration const&> registration, AbstractOrHypotheticalElement const& element, Utf16FlyString const& name, NonnullRefPtr<StyleValue const> keyword_value, ComputedProperties const* computed_style_for_custom_property_resolution, Optional<Parser::GuardedSubstitutionContexts&> guarded_contexts)
 {
     VERIFY(keyword_value->is_css_wide_keyword());
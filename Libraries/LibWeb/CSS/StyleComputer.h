@@ -103,6 +103,11 @@ public:
     void push_ancestor(DOM::Element const&);
     void pop_ancestor(DOM::Element const&);
 
+    // While enabled, elements may reuse the computed style of a structurally identical sibling instead of running
+    // the cascade. Only enable this for the duration of a style update pass, as candidates are not invalidated by
+    // DOM mutations.
+    void set_style_sharing_enabled(bool);
+
     [[nodiscard]] NonnullRefPtr<ComputedValues const> create_document_style() const;
 
     [[nodiscard]] NonnullRefPtr<ComputedValues const> compute_style(DOM::AbstractElement, Optional<bool&> did_change_custom_properties = {}) const;
@@ -207,6 +212,24 @@ private:
 
     [[nodiscard]] Length::FontMetrics calculate_root_element_font_metrics(ComputedProperties const&) const;
 
+    struct StyleSharingCandidate {
+        GC::Ref<DOM::Element const> element;
+        NonnullRefPtr<ComputedValues const> style;
+        RefPtr<ComputedValues const> parent_style;
+        RefPtr<CustomPropertyData const> custom_property_data;
+        u32 pseudo_class_state { 0 };
+        bool style_uses_var_css_function { false };
+        bool style_uses_if_css_function { false };
+        bool style_uses_inherit_css_function { false };
+        bool style_uses_attr_css_function { false };
+        bool style_depends_on_size_container_query { false };
+        bool style_depends_on_style_container_query { false };
+        Vector<Utf16FlyString> custom_property_dependencies;
+    };
+
+    [[nodiscard]] RefPtr<ComputedValues const> find_shared_style(DOM::Element&, Optional<bool&> did_change_custom_properties) const;
+    void remember_style_for_sharing(DOM::Element const&, NonnullRefPtr<ComputedValues const> const&) const;
+
     [[nodiscard]] Vector<ScopedMatchingRule> collect_matching_rules_from_context(DOM::AbstractElement, CascadeOrigin, GC::Ptr<DOM::ShadowRoot const>, Optional<Utf16FlyString const> qualified_layer_name = {}, u64* matching_pseudo_element_styles = nullptr) const;
 
     GC::Ref<DOM::Document> m_document;
@@ -243,6 +266,10 @@ private:
     OwnPtr<CountingBloomFilter<u8, 14>> m_ancestor_filter;
     OwnPtr<SelectorMatching::HasResultCache> m_has_result_cache;
     OwnPtr<SelectorMatching::HasFastRejectFilterCache> m_has_fast_reject_filter_cache;
+
+    static constexpr size_t STYLE_SHARING_CACHE_SIZE = 32;
+    bool m_style_sharing_enabled { false };
+    mutable Vector<StyleSharingCandidate, STYLE_SHARING_CACHE_SIZE> m_style_sharing_candidates;
 };
 
 inline bool StyleComputer::should_reject_with_ancestor_filter(Selector const& selector) const
@@ -4,10 +4,15 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/AllOf.h>
+#include <AK/AnyOf.h>
+#include <AK/HashTable.h>
+#include <AK/RefCounted.h>
 #include <AK/ScopeGuard.h>
 #include <LibGC/ConservativeVector.h>
 #include <LibGC/RootVector.h>
 #include <LibWeb/CSS/ComputedProperties.h>
+#include <LibWeb/CSS/CustomPropertyData.h>
 #include <LibWeb/CSS/Invalidation/HasMutationInvalidator.h>
 #include <LibWeb/CSS/Invalidation/SlotInvalidator.h>
 #include <LibWeb/CSS/Invalidation/StyleInvalidator.h>
@@ -114,11 +119,17 @@ private:
     GC::RootVector<GC::Ref<DOM::Element>> m_ancestors;
 };
 
+// The names of the custom properties whose values changed on an ancestor during a style update.
+struct ChangedCustomProperties : public RefCounted<ChangedCustomProperties> {
+    HashTable<Utf16FlyString> names;
+};
+
 struct StyleUpdateFrame {
     StyleUpdateFrame(
         DOM::Node& node,
         bool needs_inherited_style_update,
         bool recompute_elements_depending_on_custom_properties,
+        RefPtr<ChangedCustomProperties const> changed_custom_properties,
         bool parent_display_changed,
         bool ancestor_needs_descendant_style_recompute,
         StyleUpdateTraversal traversal,
@@ -126,6 +137,7 @@ struct StyleUpdateFrame {
         : node(node)
         , needs_inherited_style_update(needs_inherited_style_update)
         , recompute_elements_depending_on_custom_properties(recompute_elements_depending_on_custom_properties)
+        , changed_custom_properties(move(changed_custom_properties))
         , parent_display_changed(parent_display_changed)
         , ancestor_needs_descendant_style_recompute(ancestor_needs_descendant_style_recompute)
         , traversal(traversal)
@@ -139,6 +151,9 @@ struct StyleUpdateFrame {
     RequiredInvalidationAfterStyleChange node_invalidation;
     bool needs_inherited_style_update { false };
     bool recompute_elements_depending_on_custom_properties { false };
+    // NB: If this is null while recompute_elements_depending_on_custom_properties is set, any custom property may have
+    //     changed.
+    RefPtr<ChangedCustomProperties const> changed_custom_properties;
     bool parent_display_changed { false };
     bool ancestor_needs_descendant_style_recompute { false };
     bool needs_full_style_update { false };
@@ -154,6 +169,61 @@ struct StyleUpdateFrame {
     StyleInvalidationBehavior invalidation_behavior { StyleInvalidationBehavior::Apply };
 };
 
+static bool style_depends_on_changed_custom_properties(DOM::Element const& element, ChangedCustomProperties const* changed_custom_properties)
+{
+    // FIXME: Track which custom properties inherit() functions look up, as we do for var().
+    if (element.style_uses_inherit_css_function())
+        return true;
+    if (!element.style_uses_var_css_function())
+        return false;
+    if (!changed_custom_properties)
+        return true;
+    return any_of(element.custom_property_dependencies(), [&](auto const& name) { return changed_custom_properties->names.contains(name); });
+}
+
+// Returns the custom properties that changed for the element's descendants, given that the element's own custom
+// properties changed from old_custom_property_data to new_custom_property_data.
+static RefPtr<ChangedCustomProperties const> changed_custom_properties_for_descendants(StyleUpdateFrame const& frame, CustomPropertyData const* old_custom_property_data, CustomPropertyData const* new_custom_property_data)
+{
+    // NB: Once any custom property may have changed, there is nothing left to narrow down.
+    if (frame.recompute_elements_depending_on_custom_properties && !frame.changed_custom_properties)
+        return nullptr;
+
+    HashTable<Utf16FlyString> changed_names;
+    auto collect_changed_names = [&](CustomPropertyData const* data, CustomPropertyData const* other_data) {
+        if (!data)
+            return;
+        for (auto const& [name, property] : data->own_values()) {
+            if (!other_data) {
+                changed_names.set(name);
+                continue;
+            }
+            auto other_property = other_data->own_values().find(name);
+            if (other_property == other_data->own_values().end() || other_property->value != property)
+                changed_names.set(name);
+        }
+    };
+    collect_changed_names(old_custom_property_data, new_custom_property_data);
+    collect_changed_names(new_custom_property_data, old_custom_property_data);
+
+    // NB: The element's own custom properties are unchanged, so it was one of its pseudo-elements' that changed. We
+    //     don't track those by name.
+    if (changed_names.is_empty())
+        return nullptr;
+
+    if (frame.recompute_elements_depending_on_custom_properties) {
+        auto const& inherited_names = frame.changed_custom_properties->names;
+        if (all_of(changed_names, [&](auto const& name) { return inherited_names.contains(name); }))
+            return frame.changed_custom_properties;
+        for (auto const& name : inherited_names)
+            changed_names.set(name);
+    }
+
+    auto changed_custom_properties = adopt_ref(*new ChangedCustomProperties);
+    changed_custom_properties->names = move(changed_names);
+    return changed_custom_properties;
+}
+
 static void enter_style_update_frame(StyleUpdateFrame& frame, StyleComputer& style_computer)
 {
     auto& node = *frame.node;
@@ -178,9 +248,12 @@ static void enter_style_update_frame(StyleUpdateFrame& frame, StyleComputer& sty
             || (frame.traversal == StyleUpdateTraversal::TraverseDisplayNoneSubtrees && !element.computed_values())
             || frame.parent_display_changed
             || frame.ancestor_needs_descendant_style_recompute
-            || (frame.recompute_elements_depending_on_custom_properties && (element.style_uses_var_css_function() || element.style_uses_inherit_css_function()))
+            || (frame.recompute_elements_depending_on_custom_properties && style_depends_on_changed_custom_properties(element, frame.changed_custom_properties))
             || needs_style_update_due_to_if_media) {
+            auto old_custom_property_data = element.custom_property_data({});
             frame.node_invalidation = element.recompute_style(did_change_custom_properties);
+            if (did_change_custom_properties)
+                frame.changed_custom_properties = changed_custom_properties_for_descendants(frame, old_custom_property_data, element.custom_property_data({}));
         } else {
             if (frame.needs_inherited_style_update)
                 frame.node_invalidation = element.recompute_inherited_style(DOM::ScheduleAnimationUpdate::Yes);
@@ -277,6 +350,7 @@ static void finish_style_update_frame(StyleUpdateFrame& frame, StyleComputer& st
 static void push_style_update_frame_for_child(GC::ConservativeVector<StyleUpdateFrame, 32>& stack, StyleUpdateFrame const& parent_frame, DOM::Node& child, bool child_needs_inherited_style_update)
 {
     auto recompute_elements_depending_on_custom_properties = parent_frame.recompute_elements_depending_on_custom_properties;
+    auto changed_custom_properties = parent_frame.changed_custom_properties;
     auto children_need_full_style_recompute = parent_frame.children_need_full_style_recompute;
     auto descendant_style_recompute_needed = parent_frame.descendant_style_recompute_needed;
     auto traversal = parent_frame.traversal;
@@ -286,6 +360,7 @@ static void push_style_update_frame_for_child(GC::ConservativeVector<StyleUpdate
         child,
         child_needs_inherited_style_update,
         recompute_elements_depending_on_custom_properties,
+        move(changed_custom_properties),
         children_need_full_style_recompute,
         descendant_style_recompute_needed,
         traversal,
@@ -303,7 +378,7 @@ static void push_style_update_frame_for_child(GC::ConservativeVector<StyleUpdate
     StyleInvalidationBehavior invalidation_behavior = StyleInvalidationBehavior::Apply)
 {
     GC::ConservativeVector<StyleUpdateFrame, 32> stack;
-    stack.empend(root, needs_inherited_style_update, recompute_elements_depending_on_custom_properties, parent_display_changed, ancestor_needs_descendant_style_recompute, traversal, invalidation_behavior);
+    stack.empend(root, needs_inherited_style_update, recompute_elements_depending_on_custom_properties, nullptr, parent_display_changed, ancestor_needs_descendant_style_recompute, traversal, invalidation_behavior);
 
     RequiredInvalidationAfterStyleChange root_invalidation;
     while (!stack.is_empty()) {
@@ -411,7 +486,9 @@ void update_style(DOM::Document& document)
         document.style_computer().reset_has_result_cache();
         document.style_computer().reset_ancestor_filter();
 
+        document.style_computer().set_style_sharing_enabled(true);
         invalidation |= update_style_iteratively(document, document.style_computer(), false, false, false, false);
+        document.style_computer().set_style_sharing_enabled(false);
         document.set_needs_full_style_update(false);
 
         if (!document.style_invalidator().has_pending_invalidations() && !document.needs_style_update() && !document.child_needs_style_update())
@@ -2130,6 +2130,7 @@ void Document::update_layout(UpdateLayoutReason reason)
     for (size_t layout_pass = 0; layout_pass < max_container_query_layout_passes; ++layout_pass) {
         update_style();
         process_pending_top_layer_layout_changes();
+        update_content_visibility_relevance_if_needed();
 
         auto const should_collect_devtools_layout_data = page().client().has_active_devtools_client();
         auto const force_devtools_layout_data_collection = should_collect_devtools_layout_data
@@ -2267,6 +2268,23 @@ void Document::collect_paintable_boxes_with_auto_content_visibility()
     unsafe_paintable()->set_paintable_boxes_with_auto_content_visibility(move(paintables_with_auto_content_visibility));
 }
 
+void Document::update_content_visibility_relevance_if_needed()
+{
+    if (!m_needs_content_visibility_relevance_update)
+        return;
+    m_needs_content_visibility_relevance_update = false;
+
+    // NB: Called during layout update.
+    auto viewport = unsafe_paintable();
+    if (!viewport)
+        return;
+
+    for (auto& paintable_box : viewport->paintable_boxes_with_auto_content_visibility()) {
+        if (paintable_box)
+            as<Element>(*paintable_box->dom_node()).update_content_visibility_relevance();
+    }
+}
+
 void Document::clear_devtools_layout_inspection_data()
 {
     clear_grid_highlighted_node(nullptr);
@@ -3084,18 +3102,22 @@ void Document::set_hovered_node(GC::Ptr<Node> node, Optional<HoverEventData> hov
 // https://html.spec.whatwg.org/multipage/dom.html#dom-document-getelementsbyname
 GC::Ref<NodeList> Document::get_elements_by_name(Utf16View name)
 {
-    return LiveNodeList::create(realm(), *this, LiveNodeList::Scope::Descendants, [name = Utf16String::from_utf16(name)](auto const& node) {
+    auto node_list = LiveNodeList::create(realm(), *this, LiveNodeList::Scope::Descendants, [name = Utf16String::from_utf16(name)](auto const& node) {
         if (!is<HTML::HTMLElement>(node))
             return false;
         return as<HTML::HTMLElement>(node).name() == name;
     });
+    node_list->set_filter_attribute_dependencies({ HTML::AttributeNames::name });
+    return node_list;
 }
 
 // https://html.spec.whatwg.org/multipage/obsolete.html#dom-document-applets
 GC::Ref<HTMLCollection> Document::applets()
 {
-    if (!m_applets)
+    if (!m_applets) {
         m_applets = HTMLCollection::create(*this, HTMLCollection::Scope::Descendants, [](auto&) { return false; });
+        m_applets->set_filter_attribute_dependencies({});
+    }
     return *m_applets;
 }
 
@@ -3106,6 +3128,7 @@ GC::Ref<HTMLCollection> Document::anchors()
         m_anchors = HTMLCollection::create(*this, HTMLCollection::Scope::Descendants, [](Element const& element) {
             return is<HTML::HTMLAnchorElement>(element) && element.name().has_value();
         });
+        m_anchors->set_filter_attribute_dependencies({ HTML::AttributeNames::name });
     }
     return *m_anchors;
 }
@@ -3117,6 +3140,7 @@ GC::Ref<HTMLCollection> Document::images()
         m_images = HTMLCollection::create(*this, HTMLCollection::Scope::Descendants, [](Element const& element) {
             return is<HTML::HTMLImageElement>(element);
         });
+        m_images->set_filter_attribute_dependencies({});
     }
     return *m_images;
 }
@@ -3128,6 +3152,7 @@ GC::Ref<HTMLCollection> Document::embeds()
         m_embeds = HTMLCollection::create(*this, HTMLCollection::Scope::Descendants, [](Element const& element) {
             return is<HTML::HTMLEmbedElement>(element);
         });
+        m_embeds->set_filter_attribute_dependencies({});
     }
     return *m_embeds;
 }
@@ -3145,6 +3170,7 @@ GC::Ref<HTMLCollection> Document::links()
         m_links = HTMLCollection::create(*this, HTMLCollection::Scope::Descendants, [](Element const& element) {
             return (is<HTML::HTMLAnchorElement>(element) || is<HTML::HTMLAreaElement>(element)) && element.has_attribute(HTML::AttributeNames::href);
         });
+        m_links->set_filter_attribute_dependencies({ HTML::AttributeNames::href });
     }
     return *m_links;
 }
@@ -3156,6 +3182,7 @@ GC::Ref<HTMLCollection> Document::forms()
         m_forms = HTMLCollection::create(*this, HTMLCollection::Scope::Descendants, [](Element const& element) {
             return is<HTML::HTMLFormElement>(element);
         });
+        m_forms->set_filter_attribute_dependencies({});
     }
     return *m_forms;
 }
@@ -3167,6 +3194,7 @@ GC::Ref<HTMLCollection> Document::scripts()
         m_scripts = HTMLCollection::create(*this, HTMLCollection::Scope::Descendants, [](Element const& element) {
             return is<HTML::HTMLScriptElement>(element);
         });
+        m_scripts->set_filter_attribute_dependencies({});
     }
     return *m_scripts;
 }
@@ -3615,6 +3643,7 @@ void Document::set_focused_area(GC::Ptr<Node> node)
     if (new_focused_element)
         new_focused_element->did_receive_focus();
 
+    set_needs_content_visibility_relevance_update();
     reset_cursor_blink_cycle();
 
     set_needs_repaint();
@@ -4886,6 +4915,51 @@ GC::Ref<TreeWalker> Document::create_tree_walker(Node& root, unsigned what_to_sh
     return TreeWalker::create(realm(), root, what_to_show, filter);
 }
 
+void Document::record_subtree_change_on_inclusive_ancestors(Node& node, SubtreeChangeType type, Vector<u64>* previous_versions)
+{
+    auto version_of = [type](Node const& node) {
+        return type == SubtreeChangeType::Attribute ? node.subtree_attribute_change_version() : node.subtree_change_version();
+    };
+
+    for (auto* ancestor = &node; ancestor; ancestor = ancestor->parent()) {
+        // NB: A version newer than the last live collection cache update means this node was already marked after
+        //     every existing cache was computed, and so were all of its ancestors. There's nothing left to do.
+        auto previous_version = version_of(*ancestor);
+        if (previous_version > m_live_collection_cache_version)
+            break;
+        if (type == SubtreeChangeType::Attribute)
+            ancestor->set_subtree_attribute_change_version({}, m_dom_tree_version);
+        else
+            ancestor->set_subtree_change_version({}, m_dom_tree_version);
+        if (previous_versions)
+            previous_versions->append(previous_version);
+    }
+}
+
+void Document::bump_dom_tree_version_for_subtree_change(Node& node)
+{
+    ++m_dom_tree_version;
+    record_subtree_change_on_inclusive_ancestors(node, SubtreeChangeType::Any);
+}
+
+void Document::bump_dom_tree_version_for_insertion(Node& parent, Node& first_inserted_node, Node& last_inserted_node)
+{
+    ++m_dom_tree_version;
+    m_last_insertion.version = m_dom_tree_version;
+    m_last_insertion.parent = parent;
+    m_last_insertion.first_inserted_node = first_inserted_node;
+    m_last_insertion.last_inserted_node = last_inserted_node;
+    m_last_insertion.previous_subtree_change_versions.clear_with_capacity();
+    record_subtree_change_on_inclusive_ancestors(parent, SubtreeChangeType::Any, &m_last_insertion.previous_subtree_change_versions);
+}
+
+void Document::bump_dom_tree_version_for_attribute_change(Element& element, Utf16FlyString const& local_name)
+{
+    ++m_dom_tree_version;
+    m_attribute_change_versions.set(local_name, m_dom_tree_version);
+    record_subtree_change_on_inclusive_ancestors(element, SubtreeChangeType::Attribute);
+}
+
 void Document::register_node_iterator(Badge<NodeIterator>, NodeIterator& node_iterator)
 {
     auto result = m_node_iterators.set(&node_iterator);
@@ -7925,6 +7999,7 @@ void Document::add_an_element_to_the_top_layer(GC::Ref<Element> element)
     // 3. Append el to doc’s top layer.
     m_top_layer_elements.set(element);
     element->set_in_top_layer(true);
+    set_needs_content_visibility_relevance_update();
 
     // FIXME: 4. At the UA !important cascade origin, add a rule targeting el containing an overlay: auto declaration.
     element->set_rendered_in_top_layer(true);
@@ -7949,6 +8024,7 @@ void Document::request_an_element_to_be_remove_from_the_top_layer(GC::Ref<Elemen
     // 4. Append el to doc’s pending top layer removals.
     m_top_layer_pending_removals.set(element);
     element->set_in_top_layer(false);
+    set_needs_content_visibility_relevance_update();
 }
 
 // https://drafts.csswg.org/css-position-4/#remove-an-element-from-the-top-layer-immediately
@@ -7959,6 +8035,7 @@ void Document::remove_an_element_from_the_top_layer_immediately(GC::Ref<Element>
     // 2. Remove el from doc’s top layer and pending top layer removals.
     m_top_layer_elements.remove(element);
     element->set_in_top_layer(false);
+    set_needs_content_visibility_relevance_update();
 
     // FIXME: 3. Remove the UA !important overlay: auto rule targeting el, if it exists.
     element->set_rendered_in_top_layer(false);
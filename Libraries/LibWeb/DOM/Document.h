@@ -24,6 +24,7 @@
 #include <AK/WeakPtr.h>
 #include <LibCore/Forward.h>
 #include <LibCore/SharedVersion.h>
+#include <LibGC/Weak.h>
 #include <LibGC/WeakHashSet.h>
 #include <LibJS/Forward.h>
 #include <LibURL/Origin.h>
@@ -260,7 +261,38 @@ public:
     // AD-HOC: This number increments whenever a node is added or removed from the document, or an element attribute changes.
     //         It can be used as a crude invalidation mechanism for caches that depend on the DOM structure.
     u64 dom_tree_version() const { return m_dom_tree_version; }
-    void bump_dom_tree_version() { ++m_dom_tree_version; }
+    void bump_dom_tree_version()
+    {
+        ++m_dom_tree_version;
+        m_unscoped_dom_tree_version = m_dom_tree_version;
+    }
+
+    // AD-HOC: Variants of bump_dom_tree_version() for changes that are known to only affect the inclusive subtree of a
+    //         node. Besides bumping dom_tree_version, they record the new version on the node's inclusive ancestors,
+    //         which lets live collections ignore changes outside of their root's subtree (see LiveCollectionCacheState).
+    void bump_dom_tree_version_for_subtree_change(Node&);
+    void bump_dom_tree_version_for_insertion(Node& parent, Node& first_inserted_node, Node& last_inserted_node);
+    void bump_dom_tree_version_for_attribute_change(Element&, Utf16FlyString const& local_name);
+
+    // The dom_tree_version of the last change that was not scoped to a subtree.
+    u64 unscoped_dom_tree_version() const { return m_unscoped_dom_tree_version; }
+
+    // The dom_tree_version of the last change to an attribute with the given local name, on any element.
+    u64 attribute_change_version(Utf16FlyString const& local_name) const { return m_attribute_change_versions.get(local_name).value_or(0); }
+
+    struct LastInsertion {
+        u64 version { 0 };
+        GC::Weak<Node> parent;
+        GC::Weak<Node> first_inserted_node;
+        GC::Weak<Node> last_inserted_node;
+
+        // The subtree change versions that the insertion overwrote, starting at parent and going up its ancestors.
+        Vector<u64> previous_subtree_change_versions;
+    };
+    LastInsertion const& last_insertion() const { return m_last_insertion; }
+
+    // Called whenever a live collection brings its cache up to date with dom_tree_version.
+    void did_update_live_collection_cache() { m_live_collection_cache_version = m_dom_tree_version; }
 
     // AD-HOC: This number increments whenever CharacterData is modified in the document. It is used together with
     //         dom_tree_version() to understand whether either the DOM tree structure or contents were changed.
@@ -977,6 +1009,10 @@ public:
 
     void set_needs_animated_style_update();
 
+    // Focus, selection and the top layer can make content-visibility: auto elements (ir)relevant to the user without
+    // any change to their proximity to the viewport, so those changes ask for relevance to be checked again.
+    void set_needs_content_visibility_relevance_update() { m_needs_content_visibility_relevance_update = true; }
+
     void set_needs_invalidation_of_elements_affected_by_has() { m_needs_invalidation_of_elements_affected_by_has = true; }
     bool needs_invalidation_of_elements_affected_by_has() const { return m_needs_invalidation_of_elements_affected_by_has; }
     bool consume_needs_invalidation_of_elements_affected_by_has()
@@ -1021,6 +1057,7 @@ public:
         u64 style_invalidations { 0 };
         u64 element_style_recomputations { 0 };
         u64 element_style_noop_recomputations { 0 };
+        u64 element_style_sharing_hits { 0 };
         u64 element_inherited_style_recomputations { 0 };
         u64 element_inherited_style_noop_recomputations { 0 };
         u64 previous_sibling_invalidation_walk_visits { 0 };
@@ -1341,6 +1378,7 @@ private:
 
     void update_active_element();
     void collect_paintable_boxes_with_auto_content_visibility();
+    void update_content_visibility_relevance_if_needed();
     bool needs_style_update_after_layout();
     bool any_anchor_names_are_registered() const;
     PartialRelayoutResult try_partial_relayout(HashTable<WeakPtr<Layout::Box>> registered_partial_relayout_roots, bool& needs_layout_tree_rebuild, bool should_collect_devtools_layout_data);
@@ -1368,6 +1406,12 @@ private:
 
     void dispatch_events_for_transition(GC::Ref<CSS::CSSTransition>);
 
+    enum class SubtreeChangeType {
+        Any,
+        Attribute,
+    };
+    void record_subtree_change_on_inclusive_ancestors(Node&, SubtreeChangeType, Vector<u64>* previous_versions = nullptr);
+
     template<typename GetNotifier, typename... Args>
     void notify_each_document_observer(GetNotifier&& get_notifier, Args&&... args)
     {
@@ -1714,6 +1758,7 @@ private:
     Layout::ContainedBoxesMap m_scrollable_overflow_contained_boxes_from_last_layout;
     bool m_needs_invalidation_of_elements_affected_by_has { false };
     Vector<GC::Ref<Node>> m_style_scopes_with_pending_has_invalidations;
+    bool m_needs_content_visibility_relevance_update { false };
     CSS::SheetSetStyleCacheRegistry m_sheet_set_style_cache_registry;
     RefPtr<Painting::HitTestDisplayList> m_hit_test_display_list;
     // The previous recording's list, retained so cached per-paintable item ranges can be spliced into
@@ -1741,6 +1786,11 @@ private:
     u64 m_dom_tree_version { 0 };
     u64 m_character_data_version { 0 };
 
+    u64 m_unscoped_dom_tree_version { 0 };
+    u64 m_live_collection_cache_version { 0 };
+    HashMap<Utf16FlyString, u64> m_attribute_change_versions;
+    LastInsertion m_last_insertion;
+
     // https://drafts.csswg.org/css-position-4/#document-top-layer
     // Documents have a top layer, an ordered set containing elements from the document.
     // Elements in the top layer do not lay out normally based on their position in the document;
@@ -1096,7 +1096,7 @@ void Element::run_attribute_change_steps(Utf16FlyString const& local_name, Optio
             if (local_name == HTML::AttributeNames::id || local_name == HTML::AttributeNames::class_)
                 invalidate_content_blocker_style_if_needed(*this);
         }
-        document().bump_dom_tree_version();
+        document().bump_dom_tree_version_for_attribute_change(*this, local_name);
     }
 }
 
@@ -1326,6 +1326,7 @@ CSS::RequiredInvalidationAfterStyleChange Element::recompute_style(bool& did_cha
     m_style_uses_tree_counting_function = false;
     m_style_uses_if_css_function = false;
     m_style_uses_inherit_css_function = false;
+    m_custom_property_dependencies.clear_with_capacity();
     m_style_depends_on_size_container_query = false;
     m_style_depends_on_style_container_query = false;
     m_affected_by_has_pseudo_class_in_subject_position = false;
@@ -2053,7 +2054,7 @@ Vector<CSSPixelRect> Element::get_client_rects() const
         return {};
 
     // NOTE: Ensure that layout is up-to-date before looking at metrics.
-    const_cast<Document&>(document()).update_layout_if_needed_for_node(*this, UpdateLayoutReason::ElementGetClientRects);
+    update_layout_for_geometry_query(UpdateLayoutReason::ElementGetClientRects);
 
     if (!layout_node())
         return {};
@@ -2139,7 +2140,7 @@ int Element::client_width() const
     }
 
     // NOTE: Ensure that layout is up-to-date before looking at metrics.
-    const_cast<Document&>(document()).update_layout_if_needed_for_node(*this, UpdateLayoutReason::ElementClientWidth);
+    update_layout_for_geometry_query(UpdateLayoutReason::ElementClientWidth);
 
     // 1. If the element has no associated CSS layout box or if the CSS layout box is inline, return zero.
     if (!paintable_box())
@@ -2164,7 +2165,7 @@ int Element::client_height() const
     }
 
     // NOTE: Ensure that layout is up-to-date before looking at metrics.
-    const_cast<Document&>(document()).update_layout_if_needed_for_node(*this, UpdateLayoutReason::ElementClientHeight);
+    update_layout_for_geometry_query(UpdateLayoutReason::ElementClientHeight);
 
     // 1. If the element has no associated CSS layout box or if the CSS layout box is inline, return zero.
     if (!paintable_box())
@@ -3563,7 +3564,8 @@ GC::Ref<WebIDL::Promise> Element::scroll_into_view(Optional<Variant<bool, Bindin
 
     // 7. If the element does not have any associated box, or is not available to user-agent features, then return a
     //    resolved Promise and abort the remaining steps.
-    document().update_layout(UpdateLayoutReason::ElementScrollIntoView);
+    // NB: This is also how fragment navigation scrolls to its target, which may be inside a skipped subtree.
+    update_layout_for_geometry_query(UpdateLayoutReason::ElementScrollIntoView);
     HTML::TemporaryExecutionContext temporary_execution_context { realm() };
     if (!layout_node())
         return WebIDL::create_resolved_promise(realm(), JS::js_undefined());
@@ -4401,8 +4403,26 @@ bool Element::check_visibility(Optional<Bindings::CheckVisibilityOptions> option
     // NOTE: Ensure that layout is up-to-date before looking at metrics.
     document().update_layout_if_needed_for_node(*this, UpdateLayoutReason::ElementCheckVisibility);
 
+    // NB: The contents an element skips due to content-visibility: auto are left out of the layout tree, but they still
+    //     have boxes as far as the spec is concerned. Those are not laid out here, as that would make them relevant.
+    auto const skipped_contents_due_to_content_visibility_auto = [&] {
+        for (auto* element = this; element; element = element->flat_tree_parent_element()) {
+            auto computed_values = element->computed_values();
+            if (!computed_values)
+                return false;
+
+            if (element != this && computed_values->content_visibility() == CSS::ContentVisibility::Auto && element->paintable_box())
+                return element->skips_its_contents();
+
+            auto display = computed_values->display();
+            if (display.is_none() || (element == this && display.is_contents()))
+                return false;
+        }
+        return false;
+    }();
+
     // 1. If this does not have an associated box, return false.
-    if (!paintable_box())
+    if (!paintable_box() && !skipped_contents_due_to_content_visibility_auto)
         return false;
 
     // 2. If an ancestor of this in the flat tree has content-visibility: hidden, return false.
@@ -4433,14 +4453,8 @@ bool Element::check_visibility(Optional<Bindings::CheckVisibilityOptions> option
 
     // 5. If the contentVisibilityAuto dictionary member of options is true and an ancestor of this in the flat tree
     //    skips its contents due to content-visibility: auto, return false.
-    // FIXME: Currently we do not skip any content if content-visibility is auto: https://drafts.csswg.org/css-contain-2/#proximity-to-the-viewport
-    auto const skipped_contents_due_to_content_visibility_auto = false;
-    if (options->content_visibility_auto && skipped_contents_due_to_content_visibility_auto) {
-        for (auto* element = flat_tree_parent_element(); element; element = element->flat_tree_parent_element()) {
-            if (element->computed_values()->content_visibility() == CSS::ContentVisibility::Auto)
-                return false;
-        }
-    }
+    if (options->content_visibility_auto && skipped_contents_due_to_content_visibility_auto)
+        return false;
 
     // 6. Return true.
     return true;
@@ -4458,9 +4472,20 @@ void Element::determine_proximity_to_the_viewport()
     // NOTE: This margin is meant to allow the user agent to begin preparing for an element to be in the
     // viewport soon. A margin of 50% is suggested as a reasonable default.
     viewport_rect.inflate(viewport_rect.width(), viewport_rect.height());
+    auto previous_proximity = m_proximity_to_the_viewport;
+
+    // NB: While the element is close to the viewport its contents were laid out with it, so its current size is the
+    //     one to fall back on once it gets far away and stops rendering them.
+    // FIXME: Record this at ResizeObserver timing, and only for elements with contain-intrinsic-size: auto, once we
+    //        support that property.
+    if (previous_proximity == ProximityToTheViewport::CloseToTheViewport) {
+        auto const& paintable_box = *this->paintable_box();
+        auto is_horizontal_writing_mode = paintable_box.computed_values().writing_mode() == CSS::WritingMode::HorizontalTb;
+        m_last_remembered_block_size = is_horizontal_writing_mode ? paintable_box.content_height() : paintable_box.content_width();
+    }
+
     // FIXME: We don't have paint containment or the overflow clip edge yet, so this is just using the absolute rect for now.
-    if (paintable_box()->absolute_rect().intersects(viewport_rect))
-        m_proximity_to_the_viewport = ProximityToTheViewport::CloseToTheViewport;
+    bool is_close_to_the_viewport = paintable_box()->absolute_rect().intersects(viewport_rect);
 
     // FIXME: If a filter (see [FILTER-EFFECTS-1]) with non local effects includes the element as part of its input, the user
     //        agent should also treat the element as relevant to the user when the filter’s output can affect the rendering
@@ -4469,7 +4494,10 @@ void Element::determine_proximity_to_the_viewport()
 
     // - The element is far away from the viewport: In this state, the element’s proximity to the viewport has been
     //   computed and is not close to the viewport.
-    m_proximity_to_the_viewport = ProximityToTheViewport::FarAwayFromTheViewport;
+    m_proximity_to_the_viewport = is_close_to_the_viewport ? ProximityToTheViewport::CloseToTheViewport : ProximityToTheViewport::FarAwayFromTheViewport;
+
+    if (m_proximity_to_the_viewport != previous_proximity)
+        update_content_visibility_relevance();
 
     // - The element’s proximity to the viewport is not determined: In this state, the computation to determine the
     //   element’s proximity to the viewport has not been done since the last time the element was connected.
@@ -4535,6 +4563,47 @@ bool Element::skips_its_contents()
     return false;
 }
 
+void Element::update_content_visibility_relevance()
+{
+    // NB: The layout tree builder leaves out the contents of elements that skip them, so they have to be built (or
+    //     torn down) whenever the element becomes relevant (or irrelevant) to the user. The box remembers whether its
+    //     contents were skipped when it was built.
+    // NB: Called during layout update.
+    auto* box = as_if<Layout::Box>(unsafe_layout_node());
+    if (box && box->skips_its_contents() != skips_its_contents())
+        set_needs_layout_tree_update(true, SetNeedsLayoutTreeUpdateReason::ContentVisibilityRelevanceChange);
+}
+
+// Returns whether any ancestor started laying out its contents, in which case layout has to be updated again.
+bool Element::lay_out_contents_skipped_by_content_visibility_auto_ancestors()
+{
+    // NB: Features that need this element's box, such as scrolling it into view, have to lay out the contents of any
+    //     content-visibility: auto ancestor that skips them. Such an ancestor is treated as close to the viewport
+    //     until the next time its proximity is determined, which keeps its contents if they are still nearby by then.
+    bool did_change = false;
+    for (auto* ancestor = flat_tree_parent_element(); ancestor; ancestor = ancestor->flat_tree_parent_element()) {
+        auto ancestor_computed_values = ancestor->computed_values();
+        if (!ancestor_computed_values || ancestor_computed_values->content_visibility() != CSS::ContentVisibility::Auto)
+            continue;
+        if (ancestor->m_proximity_to_the_viewport == ProximityToTheViewport::CloseToTheViewport)
+            continue;
+        ancestor->m_proximity_to_the_viewport = ProximityToTheViewport::CloseToTheViewport;
+        ancestor->set_needs_layout_tree_update(true, SetNeedsLayoutTreeUpdateReason::ContentVisibilityRelevanceChange);
+        did_change = true;
+    }
+    return did_change;
+}
+
+// Geometry queries see this element's box even if a content-visibility: auto ancestor skips its contents.
+void Element::update_layout_for_geometry_query(UpdateLayoutReason reason) const
+{
+    auto& document = const_cast<Document&>(this->document());
+    document.update_layout_if_needed_for_node(*this, reason);
+
+    if (is_connected() && const_cast<Element&>(*this).lay_out_contents_skipped_by_content_visibility_auto_ancestors())
+        document.update_layout(reason);
+}
+
 void Element::invalidate_list_item_counters_for_list_owner()
 {
     for_each_ancestor([](GC::Ref<Node> node) {
@@ -360,6 +360,15 @@ public:
     void set_style_uses_if_css_function() { m_style_uses_if_css_function = true; }
     bool style_uses_inherit_css_function() const { return m_style_uses_inherit_css_function; }
     void set_style_uses_inherit_css_function() { m_style_uses_inherit_css_function = true; }
+
+    // The custom properties that var() functions in this element's style (or the style of its pseudo-elements)
+    // looked up when it was last computed.
+    Vector<Utf16FlyString> const& custom_property_dependencies() const { return m_custom_property_dependencies; }
+    void add_custom_property_dependency(Utf16FlyString const& name)
+    {
+        if (!m_custom_property_dependencies.contains_slow(name))
+            m_custom_property_dependencies.append(name);
+    }
     bool style_depends_on_size_container_query() const { return m_style_depends_on_size_container_query; }
     void set_style_depends_on_size_container_query() { m_style_depends_on_size_container_query = true; }
     bool style_depends_on_style_container_query() const { return m_style_depends_on_style_container_query; }
@@ -541,10 +550,16 @@ public:
 
     ProximityToTheViewport proximity_to_the_viewport() const { return m_proximity_to_the_viewport; }
     void determine_proximity_to_the_viewport();
+
+    // https://drafts.csswg.org/css-sizing-4/#last-remembered
+    Optional<CSSPixels> last_remembered_block_size() const { return m_last_remembered_block_size; }
     bool is_relevant_to_the_user();
 
     // https://drafts.csswg.org/css-contain-2/#skips-its-contents
     bool skips_its_contents();
+    void update_content_visibility_relevance();
+    bool lay_out_contents_skipped_by_content_visibility_auto_ancestors();
+    void update_layout_for_geometry_query(UpdateLayoutReason) const;
 
     bool matches_enabled_pseudo_class() const;
     bool matches_disabled_pseudo_class() const;
@@ -764,6 +779,7 @@ private:
 
     CSSPixelPoint m_scroll_offset;
     Vector<Utf16FlyString, 1> m_removed_attributes_for_style_invalidation;
+    Vector<Utf16FlyString> m_custom_property_dependencies;
 
     bool m_is_being_activated : 1 { false };
     bool m_in_top_layer : 1 { false };
@@ -810,6 +826,9 @@ private:
     // https://drafts.csswg.org/css-contain/#proximity-to-the-viewport
     ProximityToTheViewport m_proximity_to_the_viewport { ProximityToTheViewport::NotDetermined };
 
+    // https://drafts.csswg.org/css-sizing-4/#last-remembered
+    Optional<CSSPixels> m_last_remembered_block_size;
+
     // https://drafts.csswg.org/css-view-transitions-1/#captured-in-a-view-transition
     bool m_captured_in_a_view_transition { false };
 
@@ -12,6 +12,7 @@
 #include <LibWeb/DOM/Element.h>
 #include <LibWeb/DOM/HTMLCollection.h>
 #include <LibWeb/DOM/ParentNode.h>
+#include <LibWeb/HTML/AttributeNames.h>
 #include <LibWeb/Namespace.h>
 
 namespace Web::DOM {
@@ -61,46 +62,53 @@ GC::Cell const& HTMLCollection::owner_cell(Badge<GC::Heap>) const
 
 void HTMLCollection::remove_dead_cells(Badge<GC::Heap>)
 {
-    m_cached_elements.remove_all_matching([&](GC::RawPtr<Element> const& element) {
+    auto is_dead = [&](GC::RawPtr<Element> const& element) {
         auto* block = GC::HeapBlock::from_cell(element);
         return !heap().is_live_heap_block(block) || element->state() != Cell::State::Live || !element->is_marked();
-    });
+    };
+    // NB: A cached element can only die after it was removed from the tree, which invalidates the cache anyway. Make
+    //     sure that it gets rebuilt rather than appended to.
+    if (m_cached_elements.remove_all_matching(is_dead))
+        m_cache_state = {};
+    if (m_last_cached_element_in_tree_order && is_dead(m_last_cached_element_in_tree_order)) {
+        m_last_cached_element_in_tree_order = nullptr;
+        m_cache_state = {};
+    }
     if (m_cached_name_to_element_mappings) {
         m_cached_name_to_element_mappings->remove_all_matching([&](Utf16FlyString const&, GC::RawPtr<Element> const& element) {
-            auto* block = GC::HeapBlock::from_cell(element);
-            return !heap().is_live_heap_block(block) || element->state() != Cell::State::Live || !element->is_marked();
+            return is_dead(element);
         });
     }
 }
 
+void HTMLCollection::add_name_to_element_mappings(Element& element) const
+{
+    // 1. If element has an ID which is not in result, append element’s ID to result.
+    if (auto const& id = element.id(); id.has_value()) {
+        if (!id.value().is_empty() && !m_cached_name_to_element_mappings->contains(id.value()))
+            m_cached_name_to_element_mappings->set(id.value(), element);
+    }
+
+    // 2. If element is in the HTML namespace and has a name attribute whose value is neither the empty string nor is in result, append element’s name attribute value to result.
+    if (element.namespace_uri() == Namespace::HTML && element.name().has_value()) {
+        auto element_name = element.name().value();
+        if (!element_name.is_empty() && !m_cached_name_to_element_mappings->contains(element_name))
+            m_cached_name_to_element_mappings->set(move(element_name), element);
+    }
+}
+
 void HTMLCollection::update_name_to_element_mappings_if_needed() const
 {
     update_cache_if_needed();
     if (m_cached_name_to_element_mappings)
         return;
     m_cached_name_to_element_mappings = make<OrderedHashMap<Utf16FlyString, GC::RawPtr<Element>>>();
-    for (auto const& element : m_cached_elements) {
-        // 1. If element has an ID which is not in result, append element’s ID to result.
-        if (auto const& id = element->id(); id.has_value()) {
-            if (!id.value().is_empty() && !m_cached_name_to_element_mappings->contains(id.value()))
-                m_cached_name_to_element_mappings->set(id.value(), element);
-        }
-
-        // 2. If element is in the HTML namespace and has a name attribute whose value is neither the empty string nor is in result, append element’s name attribute value to result.
-        if (element->namespace_uri() == Namespace::HTML && element->name().has_value()) {
-            auto element_name = element->name().value();
-            if (!element_name.is_empty() && !m_cached_name_to_element_mappings->contains(element_name))
-                m_cached_name_to_element_mappings->set(move(element_name), element);
-        }
-    }
+    for (auto const& element : m_cached_elements)
+        add_name_to_element_mappings(*element);
 }
 
-void HTMLCollection::update_cache_if_needed() const
+void HTMLCollection::rebuild_cache() const
 {
-    // Nothing to do, the DOM hasn't updated since we last built the cache.
-    if (m_cached_dom_tree_version == root()->document().dom_tree_version())
-        return;
-
     m_cached_elements.clear();
     m_cached_name_to_element_mappings = nullptr;
     if (m_scope == Scope::Descendants) {
@@ -117,13 +125,76 @@ void HTMLCollection::update_cache_if_needed() const
         });
     }
 
+    m_last_cached_element_in_tree_order = m_cached_elements.is_empty() ? nullptr : m_cached_elements.last();
+
     if (m_sort) {
         insertion_sort(m_cached_elements, [this](auto const& a, auto const& b) {
             return this->m_sort(*a, *b);
         });
     }
+}
+
+void HTMLCollection::append_to_cache(LiveCollectionCacheState::AppendedNodes const& appended_nodes) const
+{
+    auto old_size = m_cached_elements.size();
+    for (GC::Ptr<Node> node = appended_nodes.first; node; node = node->next_sibling()) {
+        if (m_scope == Scope::Descendants) {
+            node->for_each_in_inclusive_subtree_of_type<Element>([&](auto& element) {
+                if (m_filter(element))
+                    m_cached_elements.append(element);
+                return TraversalDecision::Continue;
+            });
+        } else if (auto* element = as_if<Element>(*node); element && m_filter(*element)) {
+            m_cached_elements.append(*element);
+        }
+        if (node.ptr() == appended_nodes.last.ptr())
+            break;
+    }
+
+    if (m_cached_elements.size() == old_size)
+        return;
+
+    m_last_cached_element_in_tree_order = m_cached_elements.last();
+
+    // NB: Insertion sort only has to move the new elements, so this stays cheap for sorts that keep most of them at
+    //     the end (such as rows appended to the last table body).
+    if (m_sort) {
+        insertion_sort(m_cached_elements, [this](auto const& a, auto const& b) {
+            return this->m_sort(*a, *b);
+        });
+        m_cached_name_to_element_mappings = nullptr;
+    }
+
+    if (m_cached_name_to_element_mappings) {
+        for (size_t i = old_size; i < m_cached_elements.size(); ++i)
+            add_name_to_element_mappings(*m_cached_elements[i]);
+    }
+}
+
+void HTMLCollection::update_cache_if_needed() const
+{
+    // Nothing to do, the DOM hasn't updated since we last built the cache.
+    if (m_cache_state.is_up_to_date(*m_root))
+        return;
+
+    auto children_only = m_scope == Scope::Children ? LiveCollectionCacheState::ChildrenOnly::Yes : LiveCollectionCacheState::ChildrenOnly::No;
+    switch (m_cache_state.change_since_last_update(*m_root, children_only, m_filter_attribute_dependencies, m_last_cached_element_in_tree_order)) {
+    case LiveCollectionCacheState::Change::None:
+        break;
+    case LiveCollectionCacheState::Change::NodesAppended:
+        append_to_cache(m_cache_state.appended_nodes(*m_root));
+        break;
+    case LiveCollectionCacheState::Change::Unknown:
+        rebuild_cache();
+        break;
+    }
+
+    // The elements may still be the same while their IDs or names changed.
+    static Array const attributes_affecting_names { HTML::AttributeNames::id, HTML::AttributeNames::name };
+    if (m_cached_name_to_element_mappings && m_cache_state.attributes_changed_since_last_update(*m_root, attributes_affecting_names))
+        m_cached_name_to_element_mappings = nullptr;
 
-    m_cached_dom_tree_version = root()->document().dom_tree_version();
+    m_cache_state.did_update(*m_root);
 }
 
 GC::RootVector<GC::Ref<Element>> HTMLCollection::collect_matching_elements() const
@@ -11,6 +11,7 @@
 #include <LibGC/Ptr.h>
 #include <LibGC/WeakContainer.h>
 #include <LibWeb/Bindings/PlatformObject.h>
+#include <LibWeb/DOM/LiveCollectionCacheState.h>
 #include <LibWeb/Forward.h>
 
 namespace Web::DOM {
@@ -43,6 +44,10 @@ public:
 
     GC::RootVector<GC::Ref<Element>> collect_matching_elements() const;
 
+    // Declares that the filter only looks at the given attributes (besides the element's tag and position in the
+    // tree), so that changes to other attributes don't invalidate the cached elements.
+    void set_filter_attribute_dependencies(Vector<Utf16FlyString> attribute_names) { m_filter_attribute_dependencies = move(attribute_names); }
+
     virtual Optional<JS::Value> item_value(size_t index) const override;
     virtual JS::Value named_item_value(Utf16FlyString const& name) const override;
     virtual Vector<Utf16FlyString> supported_property_names() const override;
@@ -62,12 +67,19 @@ private:
     virtual GC::Cell const& owner_cell(Badge<GC::Heap>) const override;
 
     void update_cache_if_needed() const;
+    void rebuild_cache() const;
+    void append_to_cache(LiveCollectionCacheState::AppendedNodes const&) const;
     void update_name_to_element_mappings_if_needed() const;
+    void add_name_to_element_mappings(Element&) const;
 
-    mutable u64 m_cached_dom_tree_version { 0 };
+    mutable LiveCollectionCacheState m_cache_state;
     mutable Vector<GC::RawPtr<Element>> m_cached_elements;
+    // NB: Differs from m_cached_elements.last() if m_sort reordered the elements.
+    mutable GC::RawPtr<Element> m_last_cached_element_in_tree_order;
     mutable OwnPtr<OrderedHashMap<Utf16FlyString, GC::RawPtr<Element>>> m_cached_name_to_element_mappings;
 
+    LiveCollectionAttributeDependencies m_filter_attribute_dependencies;
+
     GC::Ref<ParentNode> m_root;
     Function<bool(Element const&)> m_filter;
     Function<bool(Element const&, Element const&)> m_sort;
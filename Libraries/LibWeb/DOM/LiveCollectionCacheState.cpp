@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/AnyOf.h>
+#include <LibWeb/DOM/Document.h>
+#include <LibWeb/DOM/LiveCollectionCacheState.h>
+#include <LibWeb/DOM/Node.h>
+
+namespace Web::DOM {
+
+bool LiveCollectionCacheState::is_up_to_date(Node const& root) const
+{
+    auto const& document = root.document();
+    return m_document.ptr() == &document && m_dom_tree_version == document.dom_tree_version();
+}
+
+bool LiveCollectionCacheState::attributes_changed_since_last_update(Node const& root, ReadonlySpan<Utf16FlyString> attribute_names) const
+{
+    if (root.subtree_attribute_change_version() <= m_dom_tree_version)
+        return false;
+
+    auto const& document = root.document();
+    return any_of(attribute_names, [&](auto const& attribute_name) {
+        return document.attribute_change_version(attribute_name) > m_dom_tree_version;
+    });
+}
+
+LiveCollectionCacheState::Change LiveCollectionCacheState::change_since_last_update(Node const& root, ChildrenOnly children_only, LiveCollectionAttributeDependencies const& attribute_dependencies, Node const* last_cached_node) const
+{
+    auto const& document = root.document();
+    if (m_document.ptr() != &document)
+        return Change::Unknown;
+    if (m_dom_tree_version == document.dom_tree_version())
+        return Change::None;
+    if (document.unscoped_dom_tree_version() > m_dom_tree_version)
+        return Change::Unknown;
+
+    if (root.subtree_attribute_change_version() > m_dom_tree_version) {
+        if (!attribute_dependencies.has_value() || attributes_changed_since_last_update(root, *attribute_dependencies))
+            return Change::Unknown;
+    }
+
+    if (root.subtree_change_version() <= m_dom_tree_version)
+        return Change::None;
+
+    // The only subtree change we can apply incrementally is a single insertion, and only if the insertion was the
+    // first change within root's subtree since the last update.
+    auto const& insertion = document.last_insertion();
+    if (root.subtree_change_version() != insertion.version || !insertion.parent || !insertion.first_inserted_node || !insertion.last_inserted_node)
+        return Change::Unknown;
+
+    size_t distance_from_parent = 0;
+    for (auto const* node = insertion.parent.ptr().ptr(); node != &root; node = node->parent()) {
+        if (!node)
+            return Change::Unknown;
+        ++distance_from_parent;
+    }
+    if (distance_from_parent >= insertion.previous_subtree_change_versions.size()
+        || insertion.previous_subtree_change_versions[distance_from_parent] > m_dom_tree_version)
+        return Change::Unknown;
+
+    // Insertions below root's children don't change the children.
+    if (children_only == ChildrenOnly::Yes && insertion.parent.ptr() != &root)
+        return Change::None;
+
+    // The inserted nodes must come after every cached node, so that their matches can be appended to the cache.
+    if (last_cached_node) {
+        auto position = const_cast<Node&>(*last_cached_node).compare_document_position(insertion.first_inserted_node.ptr());
+        if (!(position & Node::DOCUMENT_POSITION_FOLLOWING))
+            return Change::Unknown;
+    }
+
+    return Change::NodesAppended;
+}
+
+LiveCollectionCacheState::AppendedNodes LiveCollectionCacheState::appended_nodes(Node const& root) const
+{
+    auto const& insertion = root.document().last_insertion();
+    return { *insertion.first_inserted_node, *insertion.last_inserted_node };
+}
+
+void LiveCollectionCacheState::did_update(Node const& root)
+{
+    auto& document = const_cast<Document&>(root.document());
+    m_document = document;
+    m_dom_tree_version = document.dom_tree_version();
+    document.did_update_live_collection_cache();
+}
+
+}
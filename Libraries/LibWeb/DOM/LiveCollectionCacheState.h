@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Optional.h>
+#include <AK/Utf16FlyString.h>
+#include <AK/Vector.h>
+#include <LibGC/Weak.h>
+#include <LibWeb/Forward.h>
+
+namespace Web::DOM {
+
+// The element attributes that a live collection's filter looks at. OptionalNone means that the filter may depend on
+// any attribute, which is the conservative default.
+using LiveCollectionAttributeDependencies = Optional<Vector<Utf16FlyString>>;
+
+// Remembers which version of the DOM a live collection (HTMLCollection, LiveNodeList) last computed its cached nodes
+// from, and works out what happened to the collection's root since then.
+//
+// Validation is lazy, like QuerySelectorResultCache, but scoped: the Document records the version of the last change
+// within each node's subtree (see Document::bump_dom_tree_version_for_subtree_change()), so mutations outside of the
+// root's subtree, and changes to attributes the filter does not depend on, leave the cache intact.
+class LiveCollectionCacheState {
+public:
+    enum class ChildrenOnly {
+        No,
+        Yes,
+    };
+
+    enum class Change {
+        // Nothing that could affect the collection has changed.
+        None,
+        // The only change is an insertion of nodes that all follow the last cached node in tree order, so the new
+        // members of the collection can be found in appended_nodes() and added to the end of the cache.
+        NodesAppended,
+        // Anything else. The cache has to be rebuilt from scratch.
+        Unknown,
+    };
+
+    struct AppendedNodes {
+        GC::Ref<Node> first;
+        GC::Ref<Node> last;
+    };
+
+    bool is_up_to_date(Node const& root) const;
+
+    // NB: last_cached_node must be the last cached node in tree order, or null if the cache is empty.
+    Change change_since_last_update(Node const& root, ChildrenOnly, LiveCollectionAttributeDependencies const&, Node const* last_cached_node) const;
+
+    // Whether any of the given attributes may have changed on an element in root's inclusive subtree since the last update.
+    bool attributes_changed_since_last_update(Node const& root, ReadonlySpan<Utf16FlyString> attribute_names) const;
+
+    // Only valid right after change_since_last_update() returned Change::NodesAppended.
+    AppendedNodes appended_nodes(Node const& root) const;
+
+    void did_update(Node const& root);
+
+private:
+    // Weak so that a cache computed under one document is never mistaken for valid after its root was adopted into
+    // another one, whose version counters are unrelated.
+    GC::Weak<Document const> m_document;
+    u64 m_dom_tree_version { 0 };
+};
+
+}
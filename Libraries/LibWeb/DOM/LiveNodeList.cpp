@@ -14,13 +14,14 @@ namespace Web::DOM {
 
 GC_DEFINE_ALLOCATOR(LiveNodeList);
 
-GC::Ref<NodeList> LiveNodeList::create(JS::Realm& realm, Node const& root, Scope scope, Function<bool(Node const&)> filter)
+GC::Ref<LiveNodeList> LiveNodeList::create(JS::Realm& realm, Node const& root, Scope scope, Function<bool(Node const&)> filter)
 {
     return realm.create<LiveNodeList>(realm, root, scope, move(filter));
 }
 
 LiveNodeList::LiveNodeList(JS::Realm& realm, Node const& root, Scope scope, Function<bool(Node const&)> filter)
     : NodeList(realm)
+    , GC::WeakContainer(heap())
     , m_root(root)
     , m_filter(move(filter))
     , m_scope(scope)
@@ -36,23 +37,74 @@ void LiveNodeList::visit_edges(Cell::Visitor& visitor)
     visitor.visit_possible_values(m_filter.raw_capture_range());
 }
 
-GC::RootVector<Node*> LiveNodeList::collection() const
+GC::Cell const& LiveNodeList::owner_cell(Badge<GC::Heap>) const
+{
+    return *this;
+}
+
+void LiveNodeList::remove_dead_cells(Badge<GC::Heap>)
+{
+    // NB: A cached node can only die after it was removed from the tree, which invalidates the cache anyway. Make sure
+    //     that it gets rebuilt rather than appended to.
+    bool removed_any = m_cached_nodes.remove_all_matching([&](GC::RawPtr<Node const> const& node) {
+        auto* block = GC::HeapBlock::from_cell(node);
+        return !heap().is_live_heap_block(block) || node->state() != Cell::State::Live || !node->is_marked();
+    });
+    if (removed_any)
+        m_cache_state = {};
+}
+
+void LiveNodeList::append_matching_nodes(Node const& node, Vector<GC::RawPtr<Node const>>& nodes) const
 {
-    GC::RootVector<Node*> nodes;
     if (m_scope == Scope::Descendants) {
-        m_root->for_each_in_subtree([&](auto& node) {
-            if (m_filter(node))
-                nodes.append(const_cast<Node*>(&node));
+        node.for_each_in_inclusive_subtree([&](auto& descendant) {
+            if (m_filter(descendant))
+                nodes.append(&descendant);
             return TraversalDecision::Continue;
         });
-    } else {
-        m_root->for_each_child([&](auto& node) {
-            if (m_filter(node))
-                nodes.append(const_cast<Node*>(&node));
-            return IterationDecision::Continue;
-        });
+    } else if (m_filter(node)) {
+        nodes.append(&node);
     }
-    return nodes;
+}
+
+void LiveNodeList::update_cache_if_needed() const
+{
+    // Nothing to do, the DOM hasn't updated since we last built the cache.
+    if (m_cache_state.is_up_to_date(*m_root))
+        return;
+
+    auto children_only = m_scope == Scope::Children ? LiveCollectionCacheState::ChildrenOnly::Yes : LiveCollectionCacheState::ChildrenOnly::No;
+    auto const* last_cached_node = m_cached_nodes.is_empty() ? nullptr : m_cached_nodes.last().ptr();
+    switch (m_cache_state.change_since_last_update(*m_root, children_only, m_filter_attribute_dependencies, last_cached_node)) {
+    case LiveCollectionCacheState::Change::None:
+        break;
+    case LiveCollectionCacheState::Change::NodesAppended: {
+        auto appended_nodes = m_cache_state.appended_nodes(*m_root);
+        for (GC::Ptr<Node const> node = appended_nodes.first; node; node = node->next_sibling()) {
+            append_matching_nodes(*node, m_cached_nodes);
+            if (node.ptr() == appended_nodes.last.ptr())
+                break;
+        }
+        break;
+    }
+    case LiveCollectionCacheState::Change::Unknown:
+        m_cached_nodes.clear();
+        if (m_scope == Scope::Descendants) {
+            m_root->for_each_in_subtree([&](auto& node) {
+                if (m_filter(node))
+                    m_cached_nodes.append(&node);
+                return TraversalDecision::Continue;
+            });
+        } else {
+            m_root->for_each_child([&](auto& node) {
+                append_matching_nodes(node, m_cached_nodes);
+                return IterationDecision::Continue;
+            });
+        }
+        break;
+    }
+
+    m_cache_state.did_update(*m_root);
 }
 
 Node* LiveNodeList::first_matching(Function<bool(Node const&)> const& filter) const
@@ -81,17 +133,18 @@ Node* LiveNodeList::first_matching(Function<bool(Node const&)> const& filter) co
 // https://dom.spec.whatwg.org/#dom-nodelist-length
 u32 LiveNodeList::length() const
 {
-    return collection().size();
+    update_cache_if_needed();
+    return m_cached_nodes.size();
 }
 
 // https://dom.spec.whatwg.org/#dom-nodelist-item
 Node const* LiveNodeList::item(u32 index) const
 {
     // The item(index) method must return the indexth node in the collection. If there is no indexth node in the collection, then the method must return null.
-    auto nodes = collection();
-    if (index >= nodes.size())
+    update_cache_if_needed();
+    if (index >= m_cached_nodes.size())
         return nullptr;
-    return nodes[index];
+    return m_cached_nodes[index];
 }
 
 }
@@ -8,13 +8,15 @@
 #pragma once
 
 #include <AK/Function.h>
+#include <LibGC/WeakContainer.h>
+#include <LibWeb/DOM/LiveCollectionCacheState.h>
 #include <LibWeb/DOM/NodeList.h>
 
 namespace Web::DOM {
 
-// FIXME: Just like HTMLCollection, LiveNodeList currently does no caching.
-
-class LiveNodeList : public NodeList {
+class LiveNodeList
+    : public NodeList
+    , public GC::WeakContainer {
     WEB_NON_IDL_PLATFORM_OBJECT(LiveNodeList, NodeList);
     GC_DECLARE_ALLOCATOR(LiveNodeList);
 
@@ -24,12 +26,16 @@ public:
         Descendants,
     };
 
-    [[nodiscard]] static GC::Ref<NodeList> create(JS::Realm&, Node const& root, Scope, ESCAPING Function<bool(Node const&)> filter);
+    [[nodiscard]] static GC::Ref<LiveNodeList> create(JS::Realm&, Node const& root, Scope, ESCAPING Function<bool(Node const&)> filter);
     virtual ~LiveNodeList() override;
 
     virtual u32 length() const override;
     virtual Node const* item(u32 index) const override;
 
+    // Declares that the filter only looks at the given element attributes (besides the node's type and position in
+    // the tree), so that changes to other attributes don't invalidate the cached nodes.
+    void set_filter_attribute_dependencies(Vector<Utf16FlyString> attribute_names) { m_filter_attribute_dependencies = move(attribute_names); }
+
 protected:
     LiveNodeList(JS::Realm&, Node const& root, Scope, ESCAPING Function<bool(Node const&)> filter);
 
@@ -37,8 +43,15 @@ protected:
 
 private:
     virtual void visit_edges(Cell::Visitor&) override;
+    virtual void remove_dead_cells(Badge<GC::Heap>) override;
+    virtual GC::Cell const& owner_cell(Badge<GC::Heap>) const override;
+
+    void update_cache_if_needed() const;
+    void append_matching_nodes(Node const& node, Vector<GC::RawPtr<Node const>>&) const;
 
-    GC::RootVector<Node*> collection() const;
+    mutable LiveCollectionCacheState m_cache_state;
+    mutable Vector<GC::RawPtr<Node const>> m_cached_nodes;
+    LiveCollectionAttributeDependencies m_filter_attribute_dependencies;
 
     GC::Ref<Node const> m_root;
     Function<bool(Node const&)> m_filter;
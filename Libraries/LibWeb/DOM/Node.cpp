@@ -315,7 +315,7 @@ WebIDL::ExceptionOr<void> Node::set_text_content(Optional<Utf16String> const& ma
         set_needs_layout_tree_update(true, SetNeedsLayoutTreeUpdateReason::NodeSetTextContent);
     }
 
-    document().bump_dom_tree_version();
+    document().bump_dom_tree_version_for_subtree_change(*this);
     return {};
 }
 
@@ -896,7 +896,7 @@ void Node::insert_before(GC::Ref<Node> node, GC::Ptr<Node> child, bool suppress_
         }
     }
 
-    document().bump_dom_tree_version();
+    document().bump_dom_tree_version_for_insertion(*this, *nodes.first(), *nodes.last());
 }
 
 // https://dom.spec.whatwg.org/#concept-node-pre-insert
@@ -1128,7 +1128,7 @@ void Node::remove(bool suppress_observers)
     ChildrenChangedMetadata metadata { ChildrenChangedMetadata::Type::Removal, *this };
     parent->children_changed(metadata);
 
-    document().bump_dom_tree_version();
+    document().bump_dom_tree_version_for_subtree_change(*parent);
 }
 
 // https://dom.spec.whatwg.org/#concept-node-replace
@@ -1454,7 +1454,8 @@ WebIDL::ExceptionOr<void> Node::move_node(Node& new_parent, Node* child)
     // 26. Queue a tree mutation record for newParent with « node », « », newPreviousSibling, and child.
     new_parent.queue_tree_mutation_record({ *this }, {}, new_previous_sibling, child);
 
-    document().bump_dom_tree_version();
+    document().bump_dom_tree_version_for_subtree_change(*old_parent);
+    document().bump_dom_tree_version_for_subtree_change(new_parent);
 
     return {};
 }
@@ -1637,6 +1638,10 @@ void Node::set_document(Document& document)
     bool const descendants_need_style_update = child_needs_style_update();
     m_document = &document;
 
+    // The subtree change versions were recorded against the old document's dom_tree_version and mean nothing here.
+    m_subtree_change_version = 0;
+    m_subtree_attribute_change_version = 0;
+
     if (auto* animatable = as_if<Animations::Animatable>(*this))
         animatable->on_document_changed(old_document, document);
 
@@ -1835,6 +1840,8 @@ static bool is_structural_boundary_self_rebuild_reason(SetNeedsLayoutTreeUpdateR
     // The box of an element that entered the top layer leaves the parent's subtree,
     // which is a child-list change.
     case SetNeedsLayoutTreeUpdateReason::TopLayerMembershipChange:
+    // A content-visibility: auto element that starts or stops skipping its contents keeps its own box.
+    case SetNeedsLayoutTreeUpdateReason::ContentVisibilityRelevanceChange:
         return true;
     default:
         return false;
@@ -2086,9 +2093,11 @@ Slottable Node::as_slottable()
 GC::Ref<NodeList> Node::child_nodes()
 {
     if (!m_child_nodes) {
-        m_child_nodes = LiveNodeList::create(realm(), *this, LiveNodeList::Scope::Children, [](auto&) {
+        auto child_nodes = LiveNodeList::create(realm(), *this, LiveNodeList::Scope::Children, [](auto&) {
             return true;
         });
+        child_nodes->set_filter_attribute_dependencies({});
+        m_child_nodes = child_nodes;
     }
     return *m_child_nodes;
 }
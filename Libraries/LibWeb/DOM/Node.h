@@ -94,6 +94,7 @@ enum class SetNeedsLayoutReason {
 
 #define ENUMERATE_SET_NEEDS_LAYOUT_TREE_UPDATE_REASONS(X) \
     X(CharacterDataReplaceData)                           \
+    X(ContentVisibilityRelevanceChange)                   \
     X(ElementSetInnerHTML)                                \
     X(ElementSetShadowRoot)                               \
     X(DetailsElementOpenedOrClosed)                       \
@@ -313,6 +314,14 @@ public:
 
     bool is_connected() const { return m_is_connected; }
     void set_is_connected(bool is_connected) { m_is_connected = is_connected; }
+
+    // AD-HOC: The document's dom_tree_version at the last change (or attribute change) in this node's inclusive
+    //         subtree that was recorded for live collections. See Document::bump_dom_tree_version_for_subtree_change().
+    u64 subtree_change_version() const { return m_subtree_change_version; }
+    void set_subtree_change_version(Badge<Document>, u64 version) { m_subtree_change_version = version; }
+    u64 subtree_attribute_change_version() const { return m_subtree_attribute_change_version; }
+    void set_subtree_attribute_change_version(Badge<Document>, u64 version) { m_subtree_attribute_change_version = version; }
+
     bool inside_blocking_wheel_event_handler() const { return m_inside_blocking_wheel_event_handler; }
     void update_inside_blocking_wheel_event_handler_state();
     void update_inside_blocking_wheel_event_handler_state_for_subtree();
@@ -556,6 +565,9 @@ protected:
 
     UniqueNodeID m_unique_id;
 
+    u64 m_subtree_change_version { 0 };
+    u64 m_subtree_attribute_change_version { 0 };
+
     // https://dom.spec.whatwg.org/#registered-observer-list
     // "Nodes have a strong reference to registered observers in their registered observer list." https://dom.spec.whatwg.org/#garbage-collection
     OwnPtr<Vector<GC::Ref<RegisteredObserver>>> m_registered_observer_list;
@@ -15,6 +15,7 @@
 #include <LibWeb/DOM/SelectorQuery.h>
 #include <LibWeb/DOM/ShadowRoot.h>
 #include <LibWeb/Dump.h>
+#include <LibWeb/HTML/AttributeNames.h>
 #include <LibWeb/Infra/CharacterTypes.h>
 #include <LibWeb/Infra/Strings.h>
 #include <LibWeb/Namespace.h>
@@ -91,17 +92,26 @@ GC::Ref<HTMLCollection> ParentNode::children()
         m_children = HTMLCollection::create(*this, HTMLCollection::Scope::Children, [](Element const&) {
             return true;
         });
+        m_children->set_filter_attribute_dependencies({});
     }
     return *m_children;
 }
 
+// A descendant collection whose filter only looks at the qualified name or namespace of elements, which never change.
+static GC::Ref<HTMLCollection> create_attribute_independent_collection(ParentNode& root, Function<bool(Element const&)> filter)
+{
+    auto collection = HTMLCollection::create(root, HTMLCollection::Scope::Descendants, move(filter));
+    collection->set_filter_attribute_dependencies({});
+    return collection;
+}
+
 // https://dom.spec.whatwg.org/#concept-getelementsbytagname
 // NOTE: This method is only exposed on Document and Element, but is in ParentNode to prevent code duplication.
 GC::Ref<HTMLCollection> ParentNode::get_elements_by_tag_name(Utf16FlyString const& qualified_name)
 {
     // 1. If qualifiedName is "*" (U+002A), return a HTMLCollection rooted at root, whose filter matches only descendant elements.
     if (qualified_name == u"*"sv) {
-        return HTMLCollection::create(*this, HTMLCollection::Scope::Descendants, [](Element const&) {
+        return create_attribute_independent_collection(*this, [](Element const&) {
             return true;
         });
     }
@@ -109,7 +119,7 @@ GC::Ref<HTMLCollection> ParentNode::get_elements_by_tag_name(Utf16FlyString cons
     // 2. Otherwise, if root’s node document is an HTML document, return a HTMLCollection rooted at root, whose filter matches the following descendant elements:
     if (root().document().document_type() == Document::Type::HTML) {
         auto lowercase_qualified_name = qualified_name.to_ascii_lowercase();
-        return HTMLCollection::create(*this, HTMLCollection::Scope::Descendants, [qualified_name, lowercase_qualified_name = move(lowercase_qualified_name)](Element const& element) {
+        return create_attribute_independent_collection(*this, [qualified_name, lowercase_qualified_name = move(lowercase_qualified_name)](Element const& element) {
             // - Whose namespace is the HTML namespace and whose qualified name is qualifiedName, in ASCII lowercase.
             if (element.namespace_uri() == Namespace::HTML)
                 return element.qualified_name() == lowercase_qualified_name;
@@ -120,7 +130,7 @@ GC::Ref<HTMLCollection> ParentNode::get_elements_by_tag_name(Utf16FlyString cons
     }
 
     // 3. Otherwise, return a HTMLCollection rooted at root, whose filter matches descendant elements whose qualified name is qualifiedName.
-    return HTMLCollection::create(*this, HTMLCollection::Scope::Descendants, [qualified_name](Element const& element) {
+    return create_attribute_independent_collection(*this, [qualified_name](Element const& element) {
         return element.qualified_name().view() == qualified_name.view();
     });
 }
@@ -135,21 +145,21 @@ GC::Ref<HTMLCollection> ParentNode::get_elements_by_tag_name_ns(Optional<Utf16Fl
 
     // 2. If both namespace and localName are "*" (U+002A), return a HTMLCollection rooted at root, whose filter matches descendant elements.
     if (namespace_ == u"*"sv && local_name == u"*"sv) {
-        return HTMLCollection::create(*this, HTMLCollection::Scope::Descendants, [](Element const&) {
+        return create_attribute_independent_collection(*this, [](Element const&) {
             return true;
         });
     }
 
     // 3. Otherwise, if namespace is "*" (U+002A), return a HTMLCollection rooted at root, whose filter matches descendant elements whose local name is localName.
     if (namespace_ == u"*"sv) {
-        return HTMLCollection::create(*this, HTMLCollection::Scope::Descendants, [local_name](Element const& element) {
+        return create_attribute_independent_collection(*this, [local_name](Element const& element) {
             return element.local_name().view() == local_name.view();
         });
     }
 
     // 4. Otherwise, if localName is "*" (U+002A), return a HTMLCollection rooted at root, whose filter matches descendant elements whose namespace is namespace.
     if (local_name == u"*"sv) {
-        return HTMLCollection::create(*this, HTMLCollection::Scope::Descendants, [namespace_](Element const& element) {
+        return create_attribute_independent_collection(*this, [namespace_](Element const& element) {
             auto element_namespace = element.namespace_uri();
             if (element_namespace.has_value() != namespace_.has_value())
                 return false;
@@ -158,7 +168,7 @@ GC::Ref<HTMLCollection> ParentNode::get_elements_by_tag_name_ns(Optional<Utf16Fl
     }
 
     // 5. Otherwise, return a HTMLCollection rooted at root, whose filter matches descendant elements whose namespace is namespace and local name is localName.
-    return HTMLCollection::create(*this, HTMLCollection::Scope::Descendants, [namespace_, local_name](Element const& element) {
+    return create_attribute_independent_collection(*this, [namespace_, local_name](Element const& element) {
         auto element_namespace = element.namespace_uri();
         if (element_namespace.has_value() != namespace_.has_value())
             return false;
@@ -247,13 +257,15 @@ GC::Ref<HTMLCollection> ParentNode::get_elements_by_class_name(Utf16View class_n
     if (token_start.has_value())
         append_class_name(class_names.substring_view(*token_start));
 
-    return HTMLCollection::create(*this, HTMLCollection::Scope::Descendants, [list_of_class_names = move(list_of_class_names), quirks_mode = document().in_quirks_mode()](Element const& element) {
+    auto collection = HTMLCollection::create(*this, HTMLCollection::Scope::Descendants, [list_of_class_names = move(list_of_class_names), quirks_mode = document().in_quirks_mode()](Element const& element) {
         for (auto& name : list_of_class_names) {
             if (!element.has_class(name.utf16_view(), quirks_mode ? CaseSensitivity::CaseInsensitive : CaseSensitivity::CaseSensitive))
                 return false;
         }
         return !list_of_class_names.is_empty();
     });
+    collection->set_filter_attribute_dependencies({ HTML::AttributeNames::class_ });
+    return collection;
 }
 
 GC::Ptr<Element> ParentNode::get_element_by_id(Utf16View id) const
@@ -108,6 +108,7 @@ void Range::visit_edges(Cell::Visitor& visitor)
 void Range::set_associated_selection(Badge<Selection::Selection>, GC::Ptr<Selection::Selection> selection)
 {
     m_associated_selection = selection;
+    m_start_container->document().set_needs_content_visibility_relevance_update();
     update_associated_selection();
 }
 
@@ -127,6 +128,10 @@ void Range::update_associated_selection()
     if (!m_associated_selection)
         return;
 
+    // NB: Selected contents are relevant to the user, even inside content-visibility: auto elements that are far away
+    //     from the viewport.
+    document.set_needs_content_visibility_relevance_update();
+
     document.reset_cursor_blink_cycle();
     document.set_cursor_position_needs_repaint();
 
@@ -590,6 +590,7 @@ class XMLDocument;
 
 enum class QuirksMode;
 enum class SetNeedsLayoutReason;
+enum class UpdateLayoutReason;
 
 }
 
@@ -40,6 +40,7 @@ GC::Ref<DOM::HTMLCollection> HTMLDataListElement::options()
         m_options = DOM::HTMLCollection::create(*this, DOM::HTMLCollection::Scope::Descendants, [](Element const& element) {
             return is<HTML::HTMLOptionElement>(element);
         });
+        m_options->set_filter_attribute_dependencies({});
     }
     return *m_options;
 }
@@ -16,6 +16,7 @@
 #include <LibURL/URL.h>
 #include <LibWeb/Bindings/HTMLLinkElement.h>
 #include <LibWeb/CSS/CSSStyleSheet.h>
+#include <LibWeb/CSS/Parser/BackgroundStyleSheetTokenizer.h>
 #include <LibWeb/CSS/Parser/Parser.h>
 #include <LibWeb/CSS/StyleSheetList.h>
 #include <LibWeb/DOM/DOMTokenList.h>
@@ -851,6 +852,53 @@ void HTMLLinkElement::process_stylesheet_resource(bool success, Fetch::Infrastru
     if (mime_type_string.has_value() && mime_type_string != u"text/css"sv)
         success = false;
 
+    // NB: Decoding is done ahead of the remaining steps, so that large style sheets can be tokenized in the
+    //     background before they continue.
+    // The CSS environment encoding is the result of running the following steps: [CSSSYNTAX]
+    //     1. If the element has a charset attribute, get an encoding from that attribute's value. If that succeeds, return the resulting encoding. [ENCODING]
+    //     2. Otherwise, return the document's character encoding. [DOM]
+    Optional<Utf16String> decoded_style_sheet;
+    Optional<URL::URL> location;
+
+    if (success) {
+        Optional<StringView> environment_encoding;
+        if (auto charset = attribute(HTML::AttributeNames::charset); charset.has_value())
+            environment_encoding = TextCodec::get_standardized_encoding(*charset);
+
+        if (!environment_encoding.has_value() && document().encoding().has_value())
+            environment_encoding = TextCodec::get_standardized_encoding(document().encoding().value());
+
+        auto maybe_decoded_string = css_decode_bytes(environment_encoding, mime_type_charset, body_bytes);
+        if (maybe_decoded_string.is_error())
+            dbgln("Failed to decode CSS file: {}", response.url().value_or(URL::URL()));
+        else
+            decoded_style_sheet = maybe_decoded_string.release_value();
+
+        VERIFY(!response.url_list().is_empty());
+        location = response.url_list().first();
+    }
+
+    // OPTIMIZATION: Large style sheets are tokenized on a worker thread while the HTML parser carries on. Until the
+    //               tokens are ready, this element keeps delaying the load event and blocking scripts and rendering.
+    auto& background_tokenizer = CSS::Parser::BackgroundStyleSheetTokenizer::the();
+    if (decoded_style_sheet.has_value() && background_tokenizer.should_tokenize_in_background(*location, *decoded_style_sheet)) {
+        auto source = decoded_style_sheet->utf16_view();
+        background_tokenizer.tokenize(*location, source, [this, self = GC::make_root(*this), fetch_generation = m_current_fetch_generation, success, decoded_style_sheet = move(decoded_style_sheet), location]() mutable {
+            // "if, since the resource in question was fetched, it has become appropriate to fetch it again"
+            if (fetch_generation != m_current_fetch_generation)
+                return;
+            if (!document().is_fully_active())
+                return;
+            finish_processing_stylesheet_resource(success, move(decoded_style_sheet), location);
+        });
+        return;
+    }
+
+    finish_processing_stylesheet_resource(success, move(decoded_style_sheet), location);
+}
+
+void HTMLLinkElement::finish_processing_stylesheet_resource(bool success, Optional<Utf16String> decoded_style_sheet, Optional<URL::URL> const& location)
+{
     // 2. If el no longer creates an external resource link that contributes to the styling processing model, or
     //    if, since the resource in question was fetched, it has become appropriate to fetch it again, then return.
     // NB: The "fetch it again" case is handled by the fetch generation check in
@@ -886,34 +934,20 @@ void HTMLLinkElement::process_stylesheet_resource(bool success, Fetch::Infrastru
         //            Left at its default value.
         //        CSS rules
         //          Left uninitialized.
-        //
-        // The CSS environment encoding is the result of running the following steps: [CSSSYNTAX]
-        //     1. If the element has a charset attribute, get an encoding from that attribute's value. If that succeeds, return the resulting encoding. [ENCODING]
-        //     2. Otherwise, return the document's character encoding. [DOM]
-        Optional<StringView> environment_encoding;
-        if (auto charset = attribute(HTML::AttributeNames::charset); charset.has_value())
-            environment_encoding = TextCodec::get_standardized_encoding(*charset);
-
-        if (!environment_encoding.has_value() && document().encoding().has_value())
-            environment_encoding = TextCodec::get_standardized_encoding(document().encoding().value());
-
-        auto maybe_decoded_string = css_decode_bytes(environment_encoding, mime_type_charset, body_bytes);
-        if (maybe_decoded_string.is_error()) {
-            dbgln("Failed to decode CSS file: {}", response.url().value_or(URL::URL()));
+        if (!decoded_style_sheet.has_value()) {
             dispatch_event(*DOM::Event::create(realm(), HTML::EventNames::error));
         } else {
-            VERIFY(!response.url_list().is_empty());
             auto media = attribute(HTML::AttributeNames::media);
             auto media_value = media.has_value() ? media->utf16_view() : u""sv;
             auto title = in_a_document_tree() ? attribute(HTML::AttributeNames::title) : Optional<Utf16String> {};
             m_loaded_style_sheet = document_or_shadow_root_style_sheets().create_a_css_style_sheet(
-                maybe_decoded_string.release_value(),
+                decoded_style_sheet.release_value(),
                 this,
                 media_value,
                 title.has_value() ? title.release_value() : Utf16String {},
                 (m_relationship & Relationship::Alternate && !m_explicitly_enabled) ? CSS::StyleSheetList::Alternate::Yes : CSS::StyleSheetList::Alternate::No,
                 CSS::StyleSheetList::OriginClean::Yes,
-                response.url_list().first(),
+                location.value(),
                 nullptr,
                 nullptr);
 
@@ -173,6 +173,7 @@ private:
     void process_linked_resource(bool success, Fetch::Infrastructure::Response const&, Core::ImmutableBytes const*);
     void process_icon_resource(bool success, Fetch::Infrastructure::Response const&, ByteBuffer);
     void process_stylesheet_resource(bool success, Fetch::Infrastructure::Response const&, ReadonlyBytes);
+    void finish_processing_stylesheet_resource(bool success, Optional<Utf16String> decoded_style_sheet, Optional<URL::URL> const& location);
 
     bool should_fetch_and_process_resource_type() const;
 
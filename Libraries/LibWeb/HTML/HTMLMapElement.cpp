@@ -40,6 +40,7 @@ GC::Ref<DOM::HTMLCollection> HTMLMapElement::areas()
         m_areas = DOM::HTMLCollection::create(*this, DOM::HTMLCollection::Scope::Descendants, [](Element const& element) {
             return is<HTML::HTMLAreaElement>(element);
         });
+        m_areas->set_filter_attribute_dependencies({});
     }
     return *m_areas;
 }
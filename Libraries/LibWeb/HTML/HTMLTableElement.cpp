@@ -368,6 +368,7 @@ GC::Ref<DOM::HTMLCollection> HTMLTableElement::t_bodies()
         m_t_bodies = DOM::HTMLCollection::create(*this, DOM::HTMLCollection::Scope::Children, [](DOM::Element const& element) {
             return element.local_name() == TagNames::tbody;
         });
+        m_t_bodies->set_filter_attribute_dependencies({});
     }
     return *m_t_bodies;
 }
@@ -440,6 +441,7 @@ GC::Ref<DOM::HTMLCollection> HTMLTableElement::rows()
                     return prio_a < prio_b;
 
                 return false; });
+        m_rows->set_filter_attribute_dependencies({});
     }
     return *m_rows;
 }
@@ -93,6 +93,7 @@ GC::Ref<DOM::HTMLCollection> HTMLTableRowElement::cells() const
         m_cells = DOM::HTMLCollection::create(const_cast<HTMLTableRowElement&>(*this), DOM::HTMLCollection::Scope::Children, [](Element const& element) {
             return is<HTMLTableCellElement>(element);
         });
+        m_cells->set_filter_attribute_dependencies({});
     }
     return *m_cells;
 }
@@ -76,6 +76,7 @@
 #include <LibWeb/Loader/GeneratedPagesLoader.h>
 #include <LibWeb/Page/Page.h>
 #include <LibWeb/Painting/DisplayListDamage.h>
+#include <LibWeb/Painting/DisplayListOptimizer.h>
 #include <LibWeb/Painting/DisplayListRecordingContext.h>
 #include <LibWeb/Painting/Paintable.h>
 #include <LibWeb/Painting/ViewportPaintable.h>
@@ -4807,6 +4808,18 @@ bool LocalNavigable::record_display_list_and_scroll_state(PaintConfig paint_conf
         resource_transaction = m_display_list_resource_storage.create_transaction(
             m_compositor_display_list_resources,
             display_list_resources);
+
+        // NB: The recording itself stays behind as the paint command cache source, so only the list that the
+        //     compositor replays is optimized.
+        Painting::DisplayListOptimizationStatistics optimization_statistics;
+        display_list = Painting::optimize_display_list(*display_list, *visual_context_tree, optimization_statistics);
+        dbgln_if(DISPLAY_LIST_DEBUG, "Display list optimized from {} to {} commands ({} culled, {} state changes dropped, {} merged, {} occluded)",
+            optimization_statistics.commands_before,
+            optimization_statistics.commands_after,
+            optimization_statistics.culled_commands,
+            optimization_statistics.dropped_state_changes,
+            optimization_statistics.merged_commands,
+            optimization_statistics.occluded_commands);
     }
 
     auto document_paintable = document->paintable();
@@ -282,7 +282,9 @@ WebIDL::ExceptionOr<void> MessagePort::message_port_post_message_steps(GC::Ptr<M
     }
 
     // 5. Let serializeWithTransferResult be StructuredSerializeWithTransfer(message, transfer). Rethrow any exceptions.
-    auto serialize_with_transfer_result = TRY(structured_serialize_with_transfer(vm, message, transfer));
+    // NB: Messages to an entangled port in this process are handed over directly, so shared memory would only add a copy.
+    auto is_sent_to_another_process = !(m_transport && m_remote_port && !m_has_been_shipped);
+    auto serialize_with_transfer_result = TRY(structured_serialize_with_transfer(vm, message, transfer, is_sent_to_another_process ? SharedMemoryTransfer::Allowed : SharedMemoryTransfer::Disallowed));
 
     // 6. If targetPort is null, or if doomed is true, then return.
 
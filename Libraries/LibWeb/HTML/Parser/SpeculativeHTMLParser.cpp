@@ -6,12 +6,19 @@
 
 #include <AK/Assertions.h>
 #include <AK/FFIHelpers.h>
+#include <LibCore/ImmutableBytes.h>
 #include <LibJS/Runtime/Realm.h>
+#include <LibTextCodec/Decoder.h>
+#include <LibWeb/CSS/Parser/BackgroundStyleSheetTokenizer.h>
+#include <LibWeb/CSS/Parser/Parser.h>
 #include <LibWeb/DOM/Document.h>
 #include <LibWeb/Fetch/Fetching/Fetching.h>
 #include <LibWeb/Fetch/Infrastructure/FetchAlgorithms.h>
 #include <LibWeb/Fetch/Infrastructure/FetchController.h>
+#include <LibWeb/Fetch/Infrastructure/HTTP/MIME.h>
 #include <LibWeb/Fetch/Infrastructure/HTTP/Requests.h>
+#include <LibWeb/Fetch/Infrastructure/HTTP/Responses.h>
+#include <LibWeb/Fetch/Infrastructure/HTTP/Statuses.h>
 #include <LibWeb/HTML/CORSSettingAttribute.h>
 #include <LibWeb/HTML/Parser/SpeculativeHTMLParser.h>
 #include <LibWeb/HTML/PotentialCORSRequest.h>
@@ -115,6 +122,45 @@ void issue_speculative_fetch(JS::Realm& realm, DOM::Document& document, URL::URL
     request->set_client(&document.relevant_settings_object());
 
     Fetch::Infrastructure::FetchAlgorithms::Input fetch_algorithms_input {};
+
+    // OPTIMIZATION: Style sheets start being tokenized on a worker thread as soon as they arrive, rather than once the
+    //               parser reaches their <link> element, so that the work overlaps with HTML parsing and scripts.
+    if (destination == Fetch::Infrastructure::Request::Destination::Style) {
+        GC::Weak weak_document { document };
+        fetch_algorithms_input.process_response_consume_body = [weak_document](auto response, auto body_bytes) {
+            auto document = weak_document.ptr();
+            if (!document)
+                return;
+
+            response = response->unsafe_response();
+            auto const* bytes = body_bytes.template get_pointer<Core::ImmutableBytes>();
+            if (!bytes || !Fetch::Infrastructure::is_ok_status(response->status()) || response->url_list().is_empty())
+                return;
+
+            // NB: This guesses the encoding the <link> element will use. If it guesses wrong, the decoded contents
+            //     will not match, and the element tokenizes the style sheet itself.
+            Optional<StringView> environment_encoding;
+            if (document->encoding().has_value())
+                environment_encoding = TextCodec::get_standardized_encoding(document->encoding().value());
+
+            Optional<StringView> mime_type_charset;
+            auto extracted_mime_type = Fetch::Infrastructure::extract_mime_type(response->header_list());
+            if (extracted_mime_type.has_value()) {
+                if (auto charset = extracted_mime_type->parameters().get("charset"sv); charset.has_value())
+                    mime_type_charset = charset->bytes_as_string_view();
+            }
+
+            auto decoded_style_sheet = css_decode_bytes(environment_encoding, mime_type_charset, bytes->bytes());
+            if (decoded_style_sheet.is_error())
+                return;
+
+            auto const& location = response->url_list().first();
+            auto& background_tokenizer = CSS::Parser::BackgroundStyleSheetTokenizer::the();
+            if (background_tokenizer.should_tokenize_in_background(location, decoded_style_sheet.value()))
+                background_tokenizer.tokenize(location, decoded_style_sheet.value());
+        };
+    }
+
     auto algorithms = Fetch::Infrastructure::FetchAlgorithms::create(vm, move(fetch_algorithms_input));
 
     // The fetch stays alive via ResourceLoader's GC::Root callbacks for the duration of the
@@ -16,11 +16,13 @@
 #include <AK/StdLibExtras.h>
 #include <AK/String.h>
 #include <AK/UnicodeUtils.h>
+#include <LibCore/AnonymousBuffer.h>
 #include <LibCrypto/BigInt/SignedBigInteger.h>
 #include <LibCrypto/BigInt/UnsignedBigInteger.h>
 #include <LibGfx/Bitmap.h>
 #include <LibGfx/Color.h>
 #include <LibIPC/File.h>
+#include <LibIPC/Limits.h>
 #include <LibJS/Runtime/Array.h>
 #include <LibJS/Runtime/ArrayBuffer.h>
 #include <LibJS/Runtime/BigInt.h>
@@ -1937,8 +1939,59 @@ private:
     DeserializationMemory& m_memory;
 };
 
+// Transferred ArrayBuffers at least this large are handed over in shared memory, so that their contents reach the
+// receiving process as a file descriptor instead of being streamed through the IPC socket (and copied on both ends).
+static constexpr size_t minimum_array_buffer_size_for_shared_memory_transfer = 64 * KiB;
+
+// Every shared memory buffer is a file descriptor attached to the IPC message that carries the record, and a message
+// can only carry so many. Half of them are left for the other transferred objects, such as MessagePorts.
+static constexpr size_t maximum_shared_memory_array_buffers_per_record = IPC::MAX_MESSAGE_FD_COUNT / 2;
+
+// Encodes transferable.[[ArrayBufferData]] and transferable.[[ArrayBufferByteLength]] into the data holder.
+static WebIDL::ExceptionOr<void> encode_transferred_array_buffer_data(JS::Realm& realm, TransferDataEncoder& data_holder, JS::ArrayBuffer const& array_buffer, size_t& remaining_shared_memory_buffers)
+{
+    auto byte_length = array_buffer.byte_length();
+
+    // NB: The IPC encoding of an anonymous buffer's size is limited to 32 bits. Once the record has as many shared
+    //     memory buffers as it may carry, the remaining ArrayBuffers are sent inline.
+    if (remaining_shared_memory_buffers == 0 || byte_length < minimum_array_buffer_size_for_shared_memory_transfer || byte_length > NumericLimits<u32>::max()) {
+        MUST(data_holder.encode(false));
+        MUST(data_holder.encode(MUST(array_buffer.copy_to_byte_buffer())));
+        return {};
+    }
+
+    auto shared_buffer = Core::AnonymousBuffer::create_with_size(byte_length);
+    if (shared_buffer.is_error())
+        return data_clone_error_from_serialization_error(realm, shared_buffer.release_error());
+    array_buffer.copy_to(0, { shared_buffer.value().data<u8>(), byte_length });
+
+    MUST(data_holder.encode(true));
+    TRY(encode_or_throw_data_clone_error(realm, data_holder, shared_buffer.value()));
+    --remaining_shared_memory_buffers;
+    return {};
+}
+
+static WebIDL::ExceptionOr<GC::Ref<JS::ArrayBuffer>> decode_transferred_array_buffer_data(JS::Realm& target_realm, TransferDataDecoder& decoder)
+{
+    auto is_in_shared_memory = TRY(decode_or_throw_data_clone_error<bool>(target_realm, decoder));
+    if (!is_in_shared_memory) {
+        auto buffer = TRY(decode_or_throw_data_clone_error<ByteBuffer>(target_realm, decoder));
+        return JS::ArrayBuffer::create(target_realm, move(buffer));
+    }
+
+    auto shared_buffer = TRY(decode_or_throw_data_clone_error<Core::AnonymousBuffer>(target_realm, decoder));
+    if (!shared_buffer.is_valid())
+        return data_clone_error_from_serialization_error(target_realm, AK::Error::from_string_literal("Transferred buffer has no shared memory"));
+
+    // NB: The shared memory can't become the ArrayBuffer's storage itself, as ArrayBuffer data has to live in the
+    //     primitive storage cage. Copying it there once still beats decoding it from the IPC message.
+    auto array_buffer = TRY(JS::ArrayBuffer::create(target_realm, shared_buffer.size()));
+    array_buffer->overwrite(0, shared_buffer.data<void>(), shared_buffer.size());
+    return array_buffer;
+}
+
 // https://html.spec.whatwg.org/multipage/structured-data.html#structuredserializewithtransfer
-WebIDL::ExceptionOr<SerializedTransferRecord> structured_serialize_with_transfer(JS::VM& vm, JS::Value value, ReadonlySpan<GC::Ref<JS::Object>> transfer_list)
+WebIDL::ExceptionOr<SerializedTransferRecord> structured_serialize_with_transfer(JS::VM& vm, JS::Value value, ReadonlySpan<GC::Ref<JS::Object>> transfer_list, SharedMemoryTransfer shared_memory_transfer)
 {
     // 1. Let memory be an empty map.
     SerializationMemory memory = {};
@@ -1975,6 +2028,8 @@ WebIDL::ExceptionOr<SerializedTransferRecord> structured_serialize_with_transfer
     Vector<TransferDataEncoder> transfer_data_holders;
     transfer_data_holders.ensure_capacity(transfer_list.size());
 
+    size_t remaining_shared_memory_buffers = shared_memory_transfer == SharedMemoryTransfer::Allowed ? maximum_shared_memory_array_buffers_per_record : 0;
+
     // 5. For each transferable of transferList:
     for (auto const& transferable : transfer_list) {
         auto* array_buffer = as_if<JS::ArrayBuffer>(*transferable);
@@ -1997,15 +2052,13 @@ WebIDL::ExceptionOr<SerializedTransferRecord> structured_serialize_with_transfer
         // 4. If transferable has an [[ArrayBufferData]] internal slot, then:
         if (array_buffer) {
             // 1. If transferable has an [[ArrayBufferMaxByteLength]] internal slot, then:
-            auto buffer_data = MUST(array_buffer->copy_to_byte_buffer());
-
             if (!array_buffer->is_fixed_length()) {
                 // 1. Set dataHolder.[[Type]] to "ResizableArrayBuffer".
                 MUST(data_holder.encode(TransferType::ResizableArrayBuffer));
 
                 // 2. Set dataHolder.[[ArrayBufferData]] to transferable.[[ArrayBufferData]].
                 // 3. Set dataHolder.[[ArrayBufferByteLength]] to transferable.[[ArrayBufferByteLength]].
-                MUST(data_holder.encode(buffer_data));
+                TRY(encode_transferred_array_buffer_data(*vm.current_realm(), data_holder, *array_buffer, remaining_shared_memory_buffers));
 
                 // 4. Set dataHolder.[[ArrayBufferMaxByteLength]] to transferable.[[ArrayBufferMaxByteLength]].
                 MUST(data_holder.encode(array_buffer->max_byte_length()));
@@ -2017,7 +2070,7 @@ WebIDL::ExceptionOr<SerializedTransferRecord> structured_serialize_with_transfer
 
                 // 2. Set dataHolder.[[ArrayBufferData]] to transferable.[[ArrayBufferData]].
                 // 3. Set dataHolder.[[ArrayBufferByteLength]] to transferable.[[ArrayBufferByteLength]].
-                MUST(data_holder.encode(buffer_data));
+                TRY(encode_transferred_array_buffer_data(*vm.current_realm(), data_holder, *array_buffer, remaining_shared_memory_buffers));
             }
 
             // 3. Perform ? DetachArrayBuffer(transferable).
@@ -2161,8 +2214,7 @@ WebIDL::ExceptionOr<JS::Value> structured_deserialize_with_transfer_internal(Tra
     //       [[ArrayBufferData]] is instead just getting transferred into the new ArrayBuffer. This could be true, for example,
     //       when both the source and target realms are in the same process.
     if (type == TransferType::ArrayBuffer) {
-        auto buffer = TRY(decode_or_throw_data_clone_error<ByteBuffer>(target_realm, decoder));
-        value = JS::ArrayBuffer::create(target_realm, move(buffer));
+        value = TRY(decode_transferred_array_buffer_data(target_realm, decoder));
     }
 
     // 3. Otherwise, if transferDataHolder.[[Type]] is "ResizableArrayBuffer", then set value to a new ArrayBuffer object
@@ -2171,10 +2223,8 @@ WebIDL::ExceptionOr<JS::Value> structured_deserialize_with_transfer_internal(Tra
     //     [[ArrayBufferMaxByteLength]] internal slot value is transferDataHolder.[[ArrayBufferMaxByteLength]].
     // NOTE: For the same reason as the previous step, this step is also unlikely to throw an exception.
     else if (type == TransferType::ResizableArrayBuffer) {
-        auto buffer = TRY(decode_or_throw_data_clone_error<ByteBuffer>(target_realm, decoder));
+        auto data = TRY(decode_transferred_array_buffer_data(target_realm, decoder));
         auto max_byte_length = TRY(decode_or_throw_data_clone_error<size_t>(target_realm, decoder));
-
-        auto data = JS::ArrayBuffer::create(target_realm, move(buffer));
         data->set_max_byte_length(max_byte_length);
 
         value = data;
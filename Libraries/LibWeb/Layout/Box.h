@@ -56,6 +56,11 @@ public:
 
     virtual RefPtr<Painting::Paintable> create_paintable() const override;
 
+    // https://drafts.csswg.org/css-contain-2/#skips-its-contents
+    // Stamped by the layout tree builder, which leaves the contents of such a box out of the tree.
+    bool skips_its_contents() const { return has_flag(RustFFI::NodeFlag::SkipsItsContents); }
+    void set_skips_its_contents(bool value) { set_flag(RustFFI::NodeFlag::SkipsItsContents, value); }
+
     bool has_saved_abspos_layout_inputs() const { return has_flag(RustFFI::NodeFlag::HasSavedAbsposLayoutInputs); }
     bool saved_abspos_cb_derives_from_own_computed_values() const { return has_flag(RustFFI::NodeFlag::SavedAbsposCbDerivesFromOwnComputedValues); }
     bool saved_abspos_alignment_derives_from_own_computed_values() const { return has_flag(RustFFI::NodeFlag::SavedAbsposAlignmentDerivesFromOwnComputedValues); }
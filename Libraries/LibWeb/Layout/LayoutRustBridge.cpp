@@ -15,6 +15,7 @@
 #include <AK/Utf16StringBuilder.h>
 #include <AK/Variant.h>
 #include <LibGfx/Font/Font.h>
+#include <LibGfx/GlyphRunCache.h>
 #include <LibGfx/Path.h>
 #include <LibGfx/TextLayout.h>
 #include <LibUnicode/CharacterTypes.h>
@@ -794,15 +795,13 @@ RustFFI::FfiCommitSink LayoutRustBridge::commit_sink()
             if (fragment.has_glyph_run) {
                 VERIFY(fragment.glyph_font);
                 VERIFY(fragment.glyphs || fragment.glyph_count == 0);
-                Vector<Gfx::DrawGlyph> glyphs;
-                glyphs.ensure_capacity(fragment.glyph_count);
-                auto const* draw_glyphs = reinterpret_cast<Gfx::DrawGlyph const*>(fragment.glyphs);
-                glyphs.unchecked_append(draw_glyphs, fragment.glyph_count);
-                glyph_run = adopt_ref(*new Gfx::GlyphRun(
-                    move(glyphs),
+                // OPTIMIZATION: Fragments whose glyphs didn't change since the last layout (or that repeat another
+                //               fragment's glyphs) share its glyph run, and with it the text blob built to paint it.
+                glyph_run = Gfx::GlyphRunCache::the().find_or_create(
+                    { reinterpret_cast<Gfx::DrawGlyph const*>(fragment.glyphs), fragment.glyph_count },
                     *static_cast<Gfx::Font const*>(fragment.glyph_font),
                     static_cast<Gfx::GlyphRun::TextType>(fragment.glyph_text_type),
-                    fragment.glyph_run_width));
+                    fragment.glyph_run_width);
             }
             line_context.paintable.add_fragment({
                 .layout_node = *static_cast<Node const*>(fragment.layout_node),
@@ -1085,6 +1084,12 @@ RustFFI::FfiLayoutFcCallbacks LayoutRustBridge::formatting_context_callbacks()
                 facts.auto_content_aspect_ratio_numerator = auto_content_size.aspect_ratio->numerator().raw_value();
                 facts.auto_content_aspect_ratio_denominator = auto_content_size.aspect_ratio->denominator().raw_value();
             }
+            if (auto const* element = as_if<DOM::Element>(box->dom_node()); element && box->skips_its_contents()) {
+                if (auto block_size = element->last_remembered_block_size(); block_size.has_value()) {
+                    facts.has_last_remembered_block_size = true;
+                    facts.last_remembered_block_size = block_size->raw_value();
+                }
+            }
             if (box->computed_values().appearance() == CSS::Appearance::None) {
                 if (auto const* input = as_if<HTML::HTMLInputElement>(box->dom_node())) {
                     switch (input->type_state()) {
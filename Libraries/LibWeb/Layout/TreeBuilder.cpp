@@ -629,6 +629,20 @@ RustFFI::FfiPseudoTreeBuilderCallbacks LayoutTreeBuildBridge::make_ffi_pseudo_tr
     };
 }
 
+// https://drafts.csswg.org/css-contain-2/#skips-its-contents
+// The contents of an element that skips them get no layout or paint nodes at all, so an offscreen
+// content-visibility: auto subtree costs nothing to lay out or record until it nears the viewport.
+static bool element_skips_its_contents(DOM::Element& element, Node& layout_node)
+{
+    // NB: Only boxes have their proximity to the viewport determined, so anything else would never get its contents back.
+    auto* box = as_if<Box>(layout_node);
+    if (!box)
+        return element.computed_values()->content_visibility() == CSS::ContentVisibility::Hidden;
+    auto skips_its_contents = element.skips_its_contents();
+    box->set_skips_its_contents(skips_its_contents);
+    return skips_its_contents;
+}
+
 static bool is_svg_resource_box(Node const& layout_node)
 {
     return is<SVGPatternBox>(layout_node) || is<SVGMaskBox>(layout_node) || is<SVGClipBox>(layout_node);
@@ -784,7 +798,9 @@ RustFFI::FfiDomTreeBuilderCallbacks LayoutTreeBuildBridge::make_ffi_dom_tree_bui
             auto shadow_root = element.shadow_root();
             return {
                 .rendered_in_top_layer = element.rendered_in_top_layer(),
-                .content_visibility_hidden = element.computed_values()->content_visibility() == CSS::ContentVisibility::Hidden,
+                // NB: Without a principal box there is nothing to determine the proximity to the viewport of, so
+                //     only content-visibility: hidden skips the contents of a display: contents element.
+                .skips_its_contents = element.computed_values()->content_visibility() == CSS::ContentVisibility::Hidden,
                 .should_layout_dom_children = slot_element ? slot_element->assigned_nodes_internal().is_empty() && element.has_children() : element.has_children(),
                 .child_needs_layout_tree_update = element.child_needs_layout_tree_update(),
                 .dom_children_parent = static_cast<DOM::ParentNode*>(&element),
@@ -836,7 +852,7 @@ RustFFI::FfiDomTreeBuilderCallbacks LayoutTreeBuildBridge::make_ffi_dom_tree_bui
             auto stroke_pattern = graphics_element ? graphics_element->stroke_pattern() : nullptr;
             return {
                 .is_element = element != nullptr,
-                .content_visibility_hidden = element && element->computed_values()->content_visibility() == CSS::ContentVisibility::Hidden,
+                .skips_its_contents = element && element_skips_its_contents(*element, layout_node),
                 .should_layout_dom_children = slot_element ? slot_element->assigned_nodes_internal().is_empty() && node.has_children() : node.has_children(),
                 .child_needs_layout_tree_update = node.child_needs_layout_tree_update(),
                 .is_svg_switch_element = is<SVG::SVGSwitchElement>(node),
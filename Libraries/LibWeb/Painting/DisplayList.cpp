@@ -85,6 +85,19 @@ bool DisplayList::append_bytes(
     return true;
 }
 
+NonnullRefPtr<DisplayList> DisplayList::with_command_bytes(ByteBuffer&& command_bytes) const
+{
+    VERIFY(command_bytes.size() % DisplayList::command_alignment == 0);
+    auto mask_display_lists = m_mask_display_lists;
+    return adopt_ref(*new DisplayList(
+        m_compatible_visual_context_tree_version,
+        s_next_id.fetch_add(1, AK::MemoryOrder::memory_order_relaxed),
+        move(command_bytes),
+        m_surface_clear_color,
+        m_async_scrolling_metadata,
+        move(mask_display_lists)));
+}
+
 u32 DisplayList::append_command_range_from(
     DisplayList const& source_display_list,
     DisplayListCommandRange source_range,
@@ -155,6 +155,9 @@ public:
         for_each_command_header(command_bytes(), move(callback));
     }
 
+    // A new list with this one's properties that replays the given commands instead.
+    NonnullRefPtr<DisplayList> with_command_bytes(ByteBuffer&&) const;
+
     u32 append_command_range_from(DisplayList const& source_display_list, DisplayListCommandRange, AccumulatedVisualContextTree const&, VisualContextIndex recorded_context_index, VisualContextIndex current_context_index);
     size_t command_byte_size() const { return m_command_bytes.size(); }
 
@@ -0,0 +1,339 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/ByteBuffer.h>
+#include <AK/NumericLimits.h>
+#include <AK/Vector.h>
+#include <LibWeb/Painting/AccumulatedVisualContext.h>
+#include <LibWeb/Painting/DisplayList.h>
+#include <LibWeb/Painting/DisplayListCommand.h>
+#include <LibWeb/Painting/DisplayListOptimizer.h>
+
+namespace Web::Painting {
+
+// Bound on the commands a single opaque fill is checked against, so that long runs of commands in one context stay
+// linear to optimize.
+static constexpr size_t MAXIMUM_OCCLUSION_CANDIDATES = 32;
+
+struct OptimizerVisualContext {
+    // Intersection of the clip rects that apply to the context in its own coordinate space, if there are any.
+    Optional<Gfx::IntRect> clip_rect;
+    // Whether the context is only offset from the root by whole device pixels, so that commands in it are
+    // rasterized without partially covered pixels at the edges of integer rects.
+    bool is_pixel_aligned { true };
+};
+
+struct OptimizerCommand {
+    DisplayListCommandHeader header;
+    ReadonlyBytes payload;
+    Optional<FillRect> merged_fill_rect;
+    Vector<ReadonlyBytes> merged_glyph_run_payloads;
+    bool is_dropped { false };
+};
+
+static Optional<Gfx::IntRect> intersect_clip_rects(Optional<Gfx::IntRect> const& a, Gfx::IntRect const& b)
+{
+    if (!a.has_value())
+        return b;
+    return a->intersected(b);
+}
+
+static Vector<OptimizerVisualContext> compute_optimizer_visual_contexts(AccumulatedVisualContextTree const& visual_context_tree)
+{
+    auto nodes = visual_context_tree.nodes();
+    Vector<OptimizerVisualContext> contexts;
+    contexts.ensure_capacity(nodes.size());
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        if (i == VISUAL_VIEWPORT_NODE_INDEX.value()) {
+            // NB: The visual viewport transform never scales below 1, so a whole pixel of content covers at least
+            //     one whole device pixel.
+            contexts.unchecked_append({});
+            continue;
+        }
+
+        auto const& node = nodes[i];
+        auto const& parent = contexts[node.parent_index.value()];
+        contexts.unchecked_append(node.data.visit(
+            // Clips don't change the coordinate space, so they narrow the parent's clip.
+            [&](ClipData const& clip) -> OptimizerVisualContext {
+                return { intersect_clip_rects(parent.clip_rect, clip.rect.to_type<int>()), parent.is_pixel_aligned };
+            },
+            [&](ClipPathData const& clip_path) -> OptimizerVisualContext {
+                return { intersect_clip_rects(parent.clip_rect, clip_path.bounding_rect.to_type<int>()), parent.is_pixel_aligned };
+            },
+            [&](MaskData const& mask) -> OptimizerVisualContext {
+                return { intersect_clip_rects(parent.clip_rect, mask.rect.to_type<int>()), parent.is_pixel_aligned };
+            },
+            [&](EffectsData const& effects) -> OptimizerVisualContext {
+                // NB: A filter can pull in content from outside of the clip, such as a blur near its edge.
+                if (effects.gfx_filter.has_value())
+                    return { {}, parent.is_pixel_aligned };
+                return parent;
+            },
+            [&](BackfaceVisibilityData const&) -> OptimizerVisualContext {
+                return parent;
+            },
+            // Scrolling moves the coordinate space by whole device pixels at replay time, by amounts not known yet.
+            [&](ScrollData const&) -> OptimizerVisualContext {
+                return { {}, parent.is_pixel_aligned };
+            },
+            [&](ScrollCompensation const&) -> OptimizerVisualContext {
+                return { {}, parent.is_pixel_aligned };
+            },
+            [&](AnchorScrollShift const&) -> OptimizerVisualContext {
+                return { {}, parent.is_pixel_aligned };
+            },
+            [&](TransformData const&) -> OptimizerVisualContext {
+                return { {}, false };
+            },
+            [&](PerspectiveData const&) -> OptimizerVisualContext {
+                return { {}, false };
+            }));
+    }
+    return contexts;
+}
+
+static bool rects_form_a_single_rect(Gfx::IntRect const& a, Gfx::IntRect const& b)
+{
+    if (a.y() == b.y() && a.height() == b.height())
+        return a.x() + a.width() == b.x() || b.x() + b.width() == a.x();
+    if (a.x() == b.x() && a.width() == b.width())
+        return a.y() + a.height() == b.y() || b.y() + b.height() == a.y();
+    return false;
+}
+
+static bool try_to_merge_into(OptimizerCommand& previous, DisplayListCommandHeader const& header, ReadonlyBytes payload)
+{
+    if (previous.header.type != header.type
+        || previous.header.context_index != header.context_index
+        || previous.header.context_geometry_only != header.context_geometry_only)
+        return false;
+
+    switch (header.type) {
+    case DisplayListCommandType::FillRect: {
+        auto previous_fill = previous.merged_fill_rect.value_or(read_display_list_command_payload<FillRect>(previous.payload));
+        auto fill = read_display_list_command_payload<FillRect>(payload);
+        // NB: Fills that overlap would blend twice where they overlap unless they are opaque, so only fills that
+        //     share an edge are merged.
+        if (previous_fill.color != fill.color || !rects_form_a_single_rect(previous_fill.rect, fill.rect))
+            return false;
+        auto merged_rect = previous_fill.rect.united(fill.rect);
+        previous.merged_fill_rect = FillRect { merged_rect, fill.color };
+        previous.header.bounding_rect = merged_rect;
+        return true;
+    }
+    case DisplayListCommandType::DrawGlyphRun: {
+        auto previous_run = read_display_list_command_payload<DrawGlyphRun>(previous.payload);
+        auto run = read_display_list_command_payload<DrawGlyphRun>(payload);
+        if (previous_run.font_id != run.font_id
+            || previous_run.scale != run.scale
+            || previous_run.color != run.color
+            || previous_run.orientation != Gfx::Orientation::Horizontal
+            || run.orientation != Gfx::Orientation::Horizontal
+            || previous_run.translation.y() != run.translation.y())
+            return false;
+        previous.merged_glyph_run_payloads.append(payload);
+        previous.header.bounding_rect = previous.header.bounding_rect.united(header.bounding_rect);
+        return true;
+    }
+    default:
+        return false;
+    }
+}
+
+static bool is_opaque_fill(DisplayListCommandHeader const& header, ReadonlyBytes payload)
+{
+    if (header.type != DisplayListCommandType::FillRect || header.context_geometry_only)
+        return false;
+    return read_display_list_command_payload<FillRect>(payload).color.alpha() == 255;
+}
+
+static void append_command(ByteBuffer& command_bytes, DisplayListCommandHeader header, ReadonlyBytes payload, ReadonlyBytes inline_data = {})
+{
+    auto record_size = sizeof(DisplayListCommandHeader) + payload.size() + inline_data.size();
+    auto aligned_record_size = align_up_to(record_size, DisplayList::command_alignment);
+    VERIFY(aligned_record_size - sizeof(DisplayListCommandHeader) <= NumericLimits<u32>::max());
+    header.payload_size = static_cast<u32>(aligned_record_size - sizeof(DisplayListCommandHeader));
+    command_bytes.append(display_list_object_bytes(header));
+    command_bytes.append(payload);
+    if (!inline_data.is_empty())
+        command_bytes.append(inline_data);
+    command_bytes.resize(command_bytes.size() + aligned_record_size - record_size, ByteBuffer::ZeroFillNewElements::Yes);
+}
+
+static void append_merged_glyph_run(ByteBuffer& command_bytes, OptimizerCommand const& command)
+{
+    auto merged_run = read_display_list_command_payload<DrawGlyphRun>(command.payload);
+    Vector<DisplayListGlyph> glyphs;
+    auto append_glyphs_of = [&](DrawGlyphRun const& run, ReadonlyBytes payload) {
+        // Glyph positions are relative to the run's translation, which is scaled along with them during replay.
+        auto offset_x = (run.translation.x() - merged_run.translation.x()) / merged_run.scale;
+        auto glyph_bytes = payload.slice(run.glyphs.offset, run.glyphs.size);
+        for (size_t offset = 0; offset + sizeof(DisplayListGlyph) <= glyph_bytes.size(); offset += sizeof(DisplayListGlyph)) {
+            auto glyph = read_display_list_object<DisplayListGlyph>(glyph_bytes.slice(offset));
+            glyph.position.translate_by(offset_x, 0);
+            glyphs.append(glyph);
+        }
+    };
+
+    append_glyphs_of(merged_run, command.payload);
+    auto rect = merged_run.rect;
+    for (auto payload : command.merged_glyph_run_payloads) {
+        auto run = read_display_list_command_payload<DrawGlyphRun>(payload);
+        append_glyphs_of(run, payload);
+        rect = rect.united(run.rect);
+    }
+
+    // NB: Like the recorder, align the glyphs relative to where the payload lands in the command bytes.
+    auto payload_offset = command_bytes.size() + sizeof(DisplayListCommandHeader);
+    auto glyphs_offset = align_up_to(payload_offset + sizeof(DrawGlyphRun), alignof(DisplayListGlyph)) - payload_offset;
+    merged_run.rect = rect;
+    merged_run.glyph_bounding_rect = command.header.bounding_rect;
+    merged_run.glyphs = { static_cast<u32>(glyphs_offset), static_cast<u32>(glyphs.size() * sizeof(DisplayListGlyph)) };
+
+    ByteBuffer inline_data;
+    inline_data.resize(glyphs_offset - sizeof(DrawGlyphRun), ByteBuffer::ZeroFillNewElements::Yes);
+    inline_data.append(ReadonlyBytes { glyphs.data(), glyphs.size() * sizeof(DisplayListGlyph) });
+    append_command(command_bytes, command.header, display_list_object_bytes(merged_run), inline_data);
+}
+
+NonnullRefPtr<DisplayList> optimize_display_list(DisplayList const& display_list, AccumulatedVisualContextTree const& visual_context_tree, DisplayListOptimizationStatistics& statistics)
+{
+    VERIFY(display_list.compatible_visual_context_tree_version() == visual_context_tree.version());
+    auto visual_contexts = compute_optimizer_visual_contexts(visual_context_tree);
+
+    struct OpenSave {
+        size_t command_index { 0 };
+        bool has_content { false };
+    };
+
+    Vector<OptimizerCommand> commands;
+    Vector<OpenSave> open_saves;
+    // The last drawing command, while nothing that changes state has come after it.
+    Optional<size_t> merge_candidate;
+    // Drawing commands since the last state change, all in the same context.
+    Vector<size_t, MAXIMUM_OCCLUSION_CANDIDATES> occlusion_candidates;
+
+    auto did_change_state = [&] {
+        merge_candidate.clear();
+        occlusion_candidates.clear_with_capacity();
+    };
+    auto did_add_content = [&] {
+        if (!open_saves.is_empty())
+            open_saves.last().has_content = true;
+    };
+
+    display_list.for_each_command_header([&](DisplayListCommandHeader const& header, ReadonlyBytes payload) {
+        ++statistics.commands_before;
+
+        if (display_list_command_is_compositor_metadata(header.type)) {
+            did_add_content();
+            commands.append({ header, payload });
+            return;
+        }
+
+        switch (header.type) {
+        case DisplayListCommandType::Save:
+        case DisplayListCommandType::SaveLayer:
+        case DisplayListCommandType::ApplyEffects:
+            did_change_state();
+            // NB: A filter can draw something even when nothing is drawn under it, so effects are always kept.
+            open_saves.append({ commands.size(), header.type == DisplayListCommandType::ApplyEffects });
+            commands.append({ header, payload });
+            return;
+        case DisplayListCommandType::Restore: {
+            did_change_state();
+            if (open_saves.is_empty()) {
+                commands.append({ header, payload });
+                return;
+            }
+            auto save = open_saves.take_last();
+            if (!save.has_content) {
+                // Only state changes came after the save, so it is dropped together with all of them.
+                statistics.dropped_state_changes += commands.size() - save.command_index + 1;
+                commands.shrink(save.command_index);
+                return;
+            }
+            did_add_content();
+            commands.append({ header, payload });
+            return;
+        }
+        default:
+            break;
+        }
+
+        if (header.is_clip) {
+            did_change_state();
+            commands.append({ header, payload });
+            return;
+        }
+
+        // NB: These read back what was drawn before them, possibly from outside of their own bounds, so nothing drawn
+        //     before them may be merged across them or dropped in favor of something drawn after them.
+        if (header.type == DisplayListCommandType::ApplyBackdropFilter
+            || header.type == DisplayListCommandType::PaintNestedDisplayList
+            || header.type == DisplayListCommandType::DrawRepeatedDisplayList)
+            did_change_state();
+
+        auto const& visual_context = visual_contexts[header.context_index.value()];
+        if (header.has_bounding_rect) {
+            auto is_clipped_out = !header.context_geometry_only
+                && visual_context.clip_rect.has_value()
+                && !visual_context.clip_rect->intersects(header.bounding_rect);
+            if (header.bounding_rect.is_empty() || is_clipped_out) {
+                ++statistics.culled_commands;
+                return;
+            }
+        }
+
+        did_add_content();
+
+        if (merge_candidate.has_value() && try_to_merge_into(commands[*merge_candidate], header, payload)) {
+            ++statistics.merged_commands;
+            return;
+        }
+
+        if (!occlusion_candidates.is_empty() && commands[occlusion_candidates.first()].header.context_index != header.context_index)
+            occlusion_candidates.clear_with_capacity();
+
+        // NB: Whatever an opaque fill covers is only ever visible through pixels it covers partially, so commands
+        //     that stay a whole pixel inside of it can go.
+        if (visual_context.is_pixel_aligned && is_opaque_fill(header, payload)) {
+            auto fully_covered_rect = header.bounding_rect.shrunken(1, 1, 1, 1);
+            occlusion_candidates.remove_all_matching([&](size_t command_index) {
+                auto& command = commands[command_index];
+                if (!fully_covered_rect.contains(command.header.bounding_rect))
+                    return false;
+                command.is_dropped = true;
+                ++statistics.occluded_commands;
+                return true;
+            });
+        }
+
+        commands.append({ header, payload });
+        merge_candidate = commands.size() - 1;
+        if (header.has_bounding_rect && !header.context_geometry_only && occlusion_candidates.size() < MAXIMUM_OCCLUSION_CANDIDATES)
+            occlusion_candidates.append(commands.size() - 1);
+    });
+
+    ByteBuffer command_bytes;
+    command_bytes.ensure_capacity(display_list.command_byte_size());
+    for (auto const& command : commands) {
+        if (command.is_dropped)
+            continue;
+        ++statistics.commands_after;
+        if (command.merged_fill_rect.has_value())
+            append_command(command_bytes, command.header, display_list_object_bytes(*command.merged_fill_rect));
+        else if (!command.merged_glyph_run_payloads.is_empty())
+            append_merged_glyph_run(command_bytes, command);
+        else
+            append_command(command_bytes, command.header, command.payload);
+    }
+
+    return display_list.with_command_bytes(move(command_bytes));
+}
+
+}
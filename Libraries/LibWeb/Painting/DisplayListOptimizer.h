@@ -0,0 +1,38 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/NonnullRefPtr.h>
+#include <AK/Types.h>
+#include <LibWeb/Export.h>
+
+namespace Web::Painting {
+
+class AccumulatedVisualContextTree;
+class DisplayList;
+
+struct DisplayListOptimizationStatistics {
+    size_t commands_before { 0 };
+    size_t commands_after { 0 };
+    size_t culled_commands { 0 };
+    size_t dropped_state_changes { 0 };
+    size_t merged_commands { 0 };
+    size_t occluded_commands { 0 };
+};
+
+// Returns a copy of the display list that replays to the same pixels with fewer commands:
+// - drawing commands that their context's clip rects leave nothing of are culled,
+// - saves and layers that nothing is drawn under are dropped along with their clips,
+// - adjacent fills of the same color that form a single rect, and adjacent glyph runs of the same font and color on
+//   the same baseline, are merged,
+// - drawing commands that a later opaque fill in the same context completely covers are dropped.
+//
+// NB: Nothing is culled against the viewport, since the compositor replays the list at scroll offsets it picks
+//     itself. Commands outside of it are skipped during replay instead.
+WEB_API NonnullRefPtr<DisplayList> optimize_display_list(DisplayList const&, AccumulatedVisualContextTree const&, DisplayListOptimizationStatistics&);
+
+}
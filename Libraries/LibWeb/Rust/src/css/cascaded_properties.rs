@@ -376,6 +376,7 @@ fn apply_declaration_block(
     is_property_disallowed: &dyn Fn(u16) -> bool,
     resolve_unresolved: &dyn Fn(u16, *const c_void) -> FfiResolvedStyleValue,
     parse_substituted: &dyn Fn(u16, &[u8]) -> FfiResolvedStyleValue,
+    record_custom_property_dependencies: &dyn Fn(&[String]),
     custom_property_store: *const c_void,
     custom_property_registry: *const c_void,
     mut assign_source_slot: impl FnMut(u32),
@@ -402,9 +403,18 @@ fn apply_declaration_block(
         let mut has_style_sheet_context = declaration.has_style_sheet_context;
 
         if declared_is_unresolved {
+            let mut referenced_names = Vec::new();
             let native_resolution = unsafe {
-                crate::css::custom_properties::resolve_vars(custom_property_store, custom_property_registry, data)
+                crate::css::custom_properties::resolve_vars(
+                    custom_property_store,
+                    custom_property_registry,
+                    data,
+                    &mut referenced_names,
+                )
             };
+            if !referenced_names.is_empty() {
+                record_custom_property_dependencies(&referenced_names);
+            }
             match native_resolution {
                 crate::css::custom_properties::NativeVarResolution::Resolved(source) => {
                     let resolved = parse_substituted(declaration.property_id, &source);
@@ -572,6 +582,9 @@ pub struct FfiBulkCascadeCallbacks {
         source: *const u8,
         source_length: usize,
     ) -> FfiResolvedStyleValue,
+    /// Records a custom property that resolving a declaration's var() functions looked up.
+    pub record_custom_property_dependency:
+        unsafe extern "C" fn(context: *mut c_void, name: *const u8, name_length: usize),
     /// Receives every winning slot's source assignment in one batch.
     pub assign_source_slots:
         unsafe extern "C" fn(context: *mut c_void, assignments: *const FfiSourceSlotAssignment, count: usize),
@@ -788,6 +801,11 @@ pub unsafe extern "C" fn rust_cascade_matched_blocks(
                     crate::css::ffi_stats::bump(crate::css::ffi_stats::FfiOp::CascadeParseSubstitutedCallback);
                     unsafe { (callbacks.parse_substituted)(context, property_id, source.as_ptr(), source.len()) }
                 },
+                &|names| {
+                    for name in names {
+                        unsafe { (callbacks.record_custom_property_dependency)(context, name.as_ptr(), name.len()) };
+                    }
+                },
                 custom_property_store,
                 custom_property_registry,
                 |slot| {
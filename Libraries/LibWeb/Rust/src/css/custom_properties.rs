@@ -97,6 +97,9 @@ enum TokenResolution {
 struct VarResolutionContext {
     active_names: Vec<String>,
     cyclic_names: HashSet<String>,
+    // Every custom property looked up while resolving, including through other custom properties and
+    // fallbacks, so that the element can be restyled when any of them changes.
+    referenced_names: Vec<String>,
 }
 
 fn matching_close(kind: &OwnedTokenKind) -> Option<OwnedTokenKind> {
@@ -251,6 +254,9 @@ fn replace_var_function(
     if !name.starts_with("--") {
         return TokenResolution::Invalid;
     }
+    if !context.referenced_names.iter().any(|referenced_name| referenced_name == name) {
+        context.referenced_names.push(name.clone());
+    }
 
     // 2. Substitute arbitrary substitution functions in first arg, then parse it as a <custom-property-name>.
     //    If parsing returned a <custom-property-name>, let result be the computed value of the corresponding custom
@@ -386,6 +392,7 @@ pub(crate) unsafe fn resolve_vars(
     store: *const c_void,
     registry: *const c_void,
     value_data: *const c_void,
+    referenced_names: &mut Vec<String>,
 ) -> NativeVarResolution {
     let store = if store.is_null() {
         None
@@ -404,13 +411,10 @@ pub(crate) unsafe fn resolve_vars(
     if !includes_var {
         return NativeVarResolution::NotHandled;
     }
-    match substitute_tokens(
-        store,
-        registry,
-        &tokenize_owned(source),
-        &mut VarResolutionContext::default(),
-        0,
-    ) {
+    let mut context = VarResolutionContext::default();
+    let resolution = substitute_tokens(store, registry, &tokenize_owned(source), &mut context, 0);
+    referenced_names.append(&mut context.referenced_names);
+    match resolution {
         TokenResolution::Resolved(tokens) => NativeVarResolution::Resolved(serialize_tokens(&tokens)),
         TokenResolution::Invalid | TokenResolution::Cyclic => NativeVarResolution::Invalid,
         TokenResolution::NotHandled => NativeVarResolution::NotHandled,
@@ -46,3 +46,75 @@ pub(crate) fn shape_text_with_font(
         .collect();
     (glyphs, shaped.width())
 }
+
+/// Below this many code units per thread, spawning threads costs more than shaping the text on the calling thread.
+const MINIMUM_TEXT_LENGTH_PER_SHAPING_THREAD: usize = 2048;
+
+/// A run of text to shape, along with its shaping inputs.
+pub(crate) struct TextToShape<'a> {
+    pub(crate) font: *const c_void,
+    pub(crate) text: &'a [u16],
+    pub(crate) text_type: u8,
+    pub(crate) baseline_start_x: f32,
+    pub(crate) letter_spacing: f32,
+}
+
+// SAFETY: Gfx::shape_text() may be called from any thread, and the fonts are kept alive by the layout pass until
+// shape_texts_with_fonts() has joined every thread it shapes on.
+unsafe impl Sync for TextToShape<'_> {}
+
+fn shaping_thread_count() -> usize {
+    static THREAD_COUNT: std::sync::OnceLock<usize> = std::sync::OnceLock::new();
+    *THREAD_COUNT.get_or_init(|| std::thread::available_parallelism().map_or(1, |count| count.get()))
+}
+
+/// Shapes each of the given runs, returned in the same order. When there is enough text, the runs are split into
+/// contiguous batches of roughly equal length that are shaped on scoped threads, with the calling thread taking the
+/// first batch.
+pub(crate) fn shape_texts_with_fonts(texts: &[TextToShape<'_>]) -> Vec<(Vec<FfiDrawGlyph>, f32)> {
+    let shape = |text: &TextToShape<'_>| {
+        shape_text_with_font(
+            text.font,
+            text.text,
+            text.text_type,
+            text.baseline_start_x,
+            text.letter_spacing,
+        )
+    };
+
+    let total_length: usize = texts.iter().map(|text| text.text.len()).sum();
+    let thread_count = shaping_thread_count()
+        .min(total_length / MINIMUM_TEXT_LENGTH_PER_SHAPING_THREAD)
+        .min(texts.len());
+    if thread_count <= 1 {
+        return texts.iter().map(shape).collect();
+    }
+
+    let length_per_thread = total_length.div_ceil(thread_count);
+    let mut batches = Vec::with_capacity(thread_count);
+    let mut batch_start = 0;
+    let mut batch_length = 0;
+    for (index, text) in texts.iter().enumerate() {
+        batch_length += text.text.len();
+        if batch_length >= length_per_thread {
+            batches.push(&texts[batch_start..=index]);
+            batch_start = index + 1;
+            batch_length = 0;
+        }
+    }
+    if batch_start < texts.len() {
+        batches.push(&texts[batch_start..]);
+    }
+
+    std::thread::scope(|scope| {
+        let threads: Vec<_> = batches[1..]
+            .iter()
+            .map(|batch| scope.spawn(move || batch.iter().map(shape).collect::<Vec<_>>()))
+            .collect();
+        let mut shaped: Vec<_> = batches[0].iter().map(shape).collect();
+        for thread in threads {
+            shaped.extend(thread.join().expect("text shaping thread panicked"));
+        }
+        shaped
+    })
+}
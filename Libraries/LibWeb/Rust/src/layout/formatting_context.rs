@@ -1490,6 +1490,17 @@ fn run_formatting_context<'pass>(
         result
     };
 
+    // https://drafts.csswg.org/css-contain-2/#content-visibility
+    // A box that skips its contents was built without them, so it keeps the block size it last had while they
+    // were rendered instead of collapsing, and stays put until it gets close enough to the viewport to be rebuilt.
+    let result = match run.state.node_facts(&run.callbacks, run.box_).last_remembered_block_size() {
+        Some(block_size) => ChildLayoutResult {
+            automatic_content_block_size: block_size,
+            ..result
+        },
+        None => result,
+    };
+
     match input.participation {
         ParticipationInParentFormattingContext::BlockLevel => {
             finalize_block_level_root(run, &input, parent_block, &result);
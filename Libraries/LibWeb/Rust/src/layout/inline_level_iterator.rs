@@ -76,6 +76,19 @@ struct TextNodeContext {
     last_known_direction: Option<u8>,
 }
 
+/// A text item that has not been shaped yet. Shaping is deferred until an item's size is needed, so that the text of a
+/// whole inline formatting context can be shaped in one batch.
+struct PendingTextShape {
+    item_index: usize,
+    text_node: Node,
+    chunk_index: Option<usize>,
+    text: &'static [u16],
+    font: *const c_void,
+    text_type: u8,
+    baseline_start_x: f32,
+    letter_spacing: f32,
+}
+
 struct InlineLevelIteratorGenerator<'iterator, 'context, 'pass> {
     context: &'iterator mut InlineFormattingContext<'context, 'pass>,
     current_node: Node,
@@ -89,6 +102,8 @@ struct InlineLevelIteratorGenerator<'iterator, 'context, 'pass> {
     items: Vec<Item>,
     next_item_index: usize,
     accumulated_inline_size_for_tabs: CssPixels,
+    items_accumulated_for_tabs: usize,
+    pending_text_shapes: Vec<PendingTextShape>,
     previous_chunk_can_break_after: bool,
 }
 
@@ -109,6 +124,8 @@ impl<'iterator, 'context, 'pass> InlineLevelIteratorGenerator<'iterator, 'contex
             items: Vec::new(),
             next_item_index: 0,
             accumulated_inline_size_for_tabs: CssPixels::default(),
+            items_accumulated_for_tabs: 0,
+            pending_text_shapes: Vec::new(),
             previous_chunk_can_break_after: false,
         };
         iterator.is_unidirectional_left_to_right = iterator.compute_is_unidirectional_left_to_right();
@@ -171,12 +188,93 @@ impl<'iterator, 'context, 'pass> InlineLevelIteratorGenerator<'iterator, 'contex
 
     fn generate_all_items(&mut self) {
         while let Some(item) = self.generate_next_item() {
-            if matches!(item.type_, ItemType::ForcedBreak | ItemType::BlockLevelBox) {
+            let resets_tab_stops = matches!(item.type_, ItemType::ForcedBreak | ItemType::BlockLevelBox);
+            self.items.push(item);
+            if resets_tab_stops {
                 self.accumulated_inline_size_for_tabs = CssPixels::default();
-            } else {
-                self.accumulated_inline_size_for_tabs += item.border_box_inline_size();
+                self.items_accumulated_for_tabs = self.items.len();
             }
-            self.items.push(item);
+        }
+        self.shape_pending_text_items();
+    }
+
+    /// Returns the inline size of the items since the last forced break, which tab stops are measured from.
+    fn accumulated_inline_size_for_tabs(&mut self) -> CssPixels {
+        self.shape_pending_text_items();
+        for item in &self.items[self.items_accumulated_for_tabs..] {
+            self.accumulated_inline_size_for_tabs += item.border_box_inline_size();
+        }
+        self.items_accumulated_for_tabs = self.items.len();
+        self.accumulated_inline_size_for_tabs
+    }
+
+    // OPTIMIZATION: Text items are generated unshaped, and shaped here in one batch once every item has been generated
+    //               or a tab needs the size of the items before it. Chunks that were not shaped during an earlier pass
+    //               are shaped together, spread across threads when there is enough text (see shape_texts_with_fonts()),
+    //               so the first layout of text-heavy content is not bound to a single core.
+    fn shape_pending_text_items(&mut self) {
+        let pending = std::mem::take(&mut self.pending_text_shapes);
+        if pending.is_empty() {
+            return;
+        }
+        let callbacks = self.context().callbacks;
+        let arena = callbacks.arena();
+        let mut shaped: Vec<_> = pending
+            .iter()
+            .map(|pending| {
+                pending.chunk_index.and_then(|chunk_index| {
+                    arena.cached_shaped_text_chunk(
+                        pending.text_node,
+                        chunk_index,
+                        pending.text_type,
+                        pending.baseline_start_x,
+                        pending.letter_spacing,
+                    )
+                })
+            })
+            .collect();
+
+        let unshaped: Vec<_> = pending
+            .iter()
+            .zip(&shaped)
+            .filter(|(_, shaped)| shaped.is_none())
+            .map(|(pending, _)| TextToShape {
+                font: pending.font,
+                text: pending.text,
+                text_type: pending.text_type,
+                baseline_start_x: pending.baseline_start_x,
+                letter_spacing: pending.letter_spacing,
+            })
+            .collect();
+        let mut newly_shaped = shape_texts_with_fonts(&unshaped).into_iter();
+
+        for (pending, shaped) in pending.iter().zip(&mut shaped) {
+            let (glyphs, width) = match shaped.take() {
+                Some(cached) => cached,
+                None => {
+                    let (glyphs, width) = newly_shaped.next().expect("every unshaped text item was shaped");
+                    if let Some(chunk_index) = pending.chunk_index {
+                        arena.remember_shaped_text_chunk(
+                            pending.text_node,
+                            chunk_index,
+                            pending.text_type,
+                            pending.baseline_start_x,
+                            pending.letter_spacing,
+                            &glyphs,
+                            width,
+                        );
+                    }
+                    (glyphs, width)
+                }
+            };
+            let item = &mut self.items[pending.item_index];
+            item.inline_size = CssPixels::nearest_value_for_f32(width + pending.baseline_start_x);
+            item.glyphs = Some(GlyphData {
+                glyphs,
+                font: pending.font,
+                text_type: pending.text_type,
+                width,
+            });
         }
     }
 
@@ -344,23 +442,6 @@ impl<'iterator, 'context, 'pass> InlineLevelIteratorGenerator<'iterator, 'contex
             .unwrap_or(GLYPH_TEXT_TYPE_CONTEXT_DEPENDENT)
     }
 
-    fn shape_text(
-        &mut self,
-        text: &[u16],
-        font: *const c_void,
-        text_type: u8,
-        baseline_start_x: f32,
-        letter_spacing: f32,
-    ) -> GlyphData {
-        let (glyphs, width) = shape_text_with_font(font, text, text_type, baseline_start_x, letter_spacing);
-        GlyphData {
-            glyphs,
-            font,
-            text_type,
-            width,
-        }
-    }
-
     fn add_extra_box_model_metrics_to_item(
         &mut self,
         item: &mut Item,
@@ -386,7 +467,9 @@ impl<'iterator, 'context, 'pass> InlineLevelIteratorGenerator<'iterator, 'contex
         let mut text_context = self.text_node_context.unwrap();
         let chunks = text_context.chunks;
         let is_first_chunk = text_context.next_chunk_index == 0;
-        let chunk = chunks.get(text_context.next_chunk_index).copied();
+        let chunk_index = text_context.next_chunk_index;
+        let chunk = chunks.get(chunk_index).copied();
+        let is_synthesized_chunk = chunk.is_none();
         if chunk.is_some() {
             text_context.next_chunk_index += 1;
         }
@@ -452,7 +535,7 @@ impl<'iterator, 'context, 'pass> InlineLevelIteratorGenerator<'iterator, 'contex
             } else {
                 style.tab_size()
             };
-            let accumulated = self.accumulated_inline_size_for_tabs;
+            let accumulated = self.accumulated_inline_size_for_tabs();
             let mut tab_stop_distance = if accumulated > CssPixels::default() {
                 accumulated.div_as_fraction(tab_inline_size).ceil() * tab_inline_size - accumulated
             } else {
@@ -471,22 +554,21 @@ impl<'iterator, 'context, 'pass> InlineLevelIteratorGenerator<'iterator, 'contex
             shaped_length -= tab_count;
             inline_offset = tab_stop_distance.to_double() as f32;
         }
-        let shaped_text = &full_text[shaped_start..shaped_start + shaped_length];
-        let glyphs = self.shape_text(
-            shaped_text,
-            chunk.font,
+        self.pending_text_shapes.push(PendingTextShape {
+            item_index: self.items.len(),
+            text_node,
+            chunk_index: (!is_synthesized_chunk).then_some(chunk_index),
+            text: &full_text[shaped_start..shaped_start + shaped_length],
+            font: chunk.font,
             text_type,
-            inline_offset,
-            style.letter_spacing().to_double() as f32,
-        );
-        let chunk_inline_size = CssPixels::nearest_value_for_f32(glyphs.width + inline_offset);
+            baseline_start_x: inline_offset,
+            letter_spacing: style.letter_spacing().to_double() as f32,
+        });
         let generated_empty = synthesize_zero_length_chunk
             || (self.context().facts(text_node).is_generated_for_pseudo_element() && chunk.length == 0);
         let mut item = Item::new(ItemType::Text, text_node);
-        item.glyphs = Some(glyphs);
         item.offset_in_node = chunk.start;
         item.length_in_node = chunk.length;
-        item.inline_size = chunk_inline_size;
         item.is_collapsible_whitespace =
             text_context.should_collapse_whitespace && chunk.is_all_whitespace && !generated_empty;
         item.can_break_before = self.previous_chunk_can_break_after;
@@ -154,16 +154,36 @@ pub(crate) struct TextChunkCacheKey {
     pub(crate) font_cascade_list: *const c_void,
 }
 
+/// A text chunk's shaped glyph run, along with the shaping inputs that aren't part of the chunk itself.
+#[derive(Clone)]
+struct ShapedTextChunk {
+    text_type: u8,
+    baseline_start_x: f32,
+    letter_spacing: f32,
+    glyphs: Vec<crate::layout::FfiDrawGlyph>,
+    width: f32,
+}
+
 struct TextChunkCacheEntry {
     key: TextChunkCacheKey,
     _retained_font_cascade_list: libgfx_rust::font::RetainedFontCascadeList,
     chunks: Vec<crate::layout::TextChunk>,
+    // The glyph runs of the chunks, indexed like them. These are only kept for text that has been edited, so that
+    // editing does not reshape the chunks that the edit did not touch.
+    shaped_chunks: Option<RefCell<Vec<Option<ShapedTextChunk>>>>,
+}
+
+/// The chunks of a text node from before its text was edited, kept until it is chunked again.
+struct EditedTextChunks {
+    text: Vec<u16>,
+    entry: Box<TextChunkCacheEntry>,
 }
 
 #[derive(Default)]
 struct TextChunkCacheSlot {
     generation: u8,
     entry: Option<Box<TextChunkCacheEntry>>,
+    edited: Option<Box<EditedTextChunks>>,
 }
 
 // NodeData is sized to one cache line; the aligned chunk keeps every densely-strided slot
@@ -659,6 +679,10 @@ impl LayoutNodeArena {
         if self.text_contents.len() <= index {
             self.text_contents.resize_with(index + 1, TextContentSlot::default);
         }
+        let previous_text = (self.text_contents[index].generation == id.generation())
+            .then(|| self.text_contents[index].content.take())
+            .flatten()
+            .map(|content| content.text);
         self.text_contents[index] = TextContentSlot {
             generation: id.generation(),
             content: Some(Box::new(TextContent {
@@ -668,7 +692,20 @@ impl LayoutNodeArena {
             })),
         };
         if let Some(slot) = self.text_chunk_caches.get_mut().get_mut(index) {
-            *slot = TextChunkCacheSlot::default();
+            // NB: Remember how the text was chunked before, so that the new text only needs to be chunked around the
+            //     edit. If the text changed several times since, the previous chunks still match the oldest text.
+            let edited = if slot.generation != id.generation() {
+                None
+            } else if let Some(entry) = slot.entry.take() {
+                previous_text.map(|text| Box::new(EditedTextChunks { text, entry }))
+            } else {
+                slot.edited.take()
+            };
+            *slot = TextChunkCacheSlot {
+                generation: id.generation(),
+                entry: None,
+                edited,
+            };
         }
     }
 
@@ -715,6 +752,9 @@ impl LayoutNodeArena {
         id: NodeSlotId,
         key: TextChunkCacheKey,
         compute: impl FnOnce() -> Vec<crate::layout::TextChunk>,
+        compute_incrementally: impl FnOnce(
+            crate::layout::PreviousTextChunks<'_>,
+        ) -> Option<crate::layout::IncrementalTextChunks>,
     ) -> &'static [crate::layout::TextChunk] {
         // data() validates that id names a live slot with a matching generation.
         self.data(id);
@@ -736,7 +776,63 @@ impl LayoutNodeArena {
             }
         }
 
-        let chunks = compute();
+        let edited = self
+            .text_chunk_caches
+            .borrow_mut()
+            .get_mut(index)
+            .filter(|slot| slot.generation == id.generation())
+            .and_then(|slot| slot.edited.take());
+
+        let (chunks, shaped_chunks) = match edited {
+            Some(edited) => {
+                let EditedTextChunks {
+                    text: previous_text,
+                    entry: previous_entry,
+                } = *edited;
+                let incremental = (previous_entry.key == key)
+                    .then(|| {
+                        compute_incrementally(crate::layout::PreviousTextChunks {
+                            text: &previous_text,
+                            chunks: &previous_entry.chunks,
+                        })
+                    })
+                    .flatten();
+                let (chunks, shaped_chunks) = match incremental {
+                    Some(incremental) => {
+                        let mut previous_shaped_chunks = previous_entry
+                            .shaped_chunks
+                            .map(RefCell::into_inner)
+                            .unwrap_or_default();
+                        let mut take_previous_shaped_chunk = |previous_index: usize| {
+                            previous_shaped_chunks.get_mut(previous_index).and_then(Option::take)
+                        };
+                        let shaped_chunks = (0..incremental.chunks.len())
+                            .map(|chunk_index| {
+                                if chunk_index < incremental.reused_prefix_count {
+                                    take_previous_shaped_chunk(chunk_index)
+                                } else if chunk_index >= incremental.reused_suffix_start {
+                                    take_previous_shaped_chunk(
+                                        incremental.reused_previous_suffix_start + chunk_index
+                                            - incremental.reused_suffix_start,
+                                    )
+                                } else {
+                                    None
+                                }
+                            })
+                            .collect();
+                        (incremental.chunks, shaped_chunks)
+                    }
+                    None => {
+                        let chunks = compute();
+                        let shaped_chunks = vec![None; chunks.len()];
+                        (chunks, shaped_chunks)
+                    }
+                };
+                (chunks, Some(shaped_chunks))
+            }
+            None => (compute(), None),
+        };
+
         let mut slots = self.text_chunk_caches.borrow_mut();
         if slots.len() <= index {
             slots.resize_with(index + 1, TextChunkCacheSlot::default);
@@ -751,12 +847,78 @@ impl LayoutNodeArena {
                     libgfx_rust::font::RetainedFontCascadeList::retain(key.font_cascade_list)
                 },
                 chunks,
+                shaped_chunks: shaped_chunks.map(RefCell::new),
             })),
+            edited: None,
         };
         let entry = slots[index].entry.as_deref().expect("entry was just stored");
         unsafe { std::slice::from_raw_parts(entry.chunks.as_ptr(), entry.chunks.len()) }
     }
 
+    /// Returns the glyph run of one of the node's current text chunks if the chunk was already shaped with the same
+    /// inputs.
+    pub(crate) fn cached_shaped_text_chunk(
+        &self,
+        id: NodeSlotId,
+        chunk_index: usize,
+        text_type: u8,
+        baseline_start_x: f32,
+        letter_spacing: f32,
+    ) -> Option<(Vec<crate::layout::FfiDrawGlyph>, f32)> {
+        let mut cached = None;
+        self.with_shaped_text_chunks(id, &mut |shaped_chunks| {
+            cached = shaped_chunks
+                .get(chunk_index)
+                .and_then(Option::as_ref)
+                .filter(|shaped| {
+                    shaped.text_type == text_type
+                        && shaped.baseline_start_x.to_bits() == baseline_start_x.to_bits()
+                        && shaped.letter_spacing.to_bits() == letter_spacing.to_bits()
+                })
+                .map(|shaped| (shaped.glyphs.clone(), shaped.width));
+        });
+        cached
+    }
+
+    /// Remembers the glyph run of one of the node's current text chunks, if the node keeps its glyph runs around.
+    #[allow(clippy::too_many_arguments)]
+    pub(crate) fn remember_shaped_text_chunk(
+        &self,
+        id: NodeSlotId,
+        chunk_index: usize,
+        text_type: u8,
+        baseline_start_x: f32,
+        letter_spacing: f32,
+        glyphs: &[crate::layout::FfiDrawGlyph],
+        width: f32,
+    ) {
+        self.with_shaped_text_chunks(id, &mut |shaped_chunks| {
+            if let Some(shaped) = shaped_chunks.get_mut(chunk_index) {
+                *shaped = Some(ShapedTextChunk {
+                    text_type,
+                    baseline_start_x,
+                    letter_spacing,
+                    glyphs: glyphs.to_vec(),
+                    width,
+                });
+            }
+        });
+    }
+
+    fn with_shaped_text_chunks(&self, id: NodeSlotId, callback: &mut dyn FnMut(&mut Vec<Option<ShapedTextChunk>>)) {
+        // data() validates that id names a live slot with a matching generation.
+        self.data(id);
+        let slots = self.text_chunk_caches.borrow();
+        if let Some(shaped_chunks) = slots
+            .get(id.slot_index() as usize)
+            .filter(|slot| slot.generation == id.generation())
+            .and_then(|slot| slot.entry.as_deref())
+            .and_then(|entry| entry.shaped_chunks.as_ref())
+        {
+            callback(&mut shaped_chunks.borrow_mut());
+        }
+    }
+
     pub(crate) unsafe fn from_handle<'a>(arena: *mut c_void) -> &'a Self {
         assert!(!arena.is_null(), "layout node arena handle is null");
         // SAFETY: Layout passes borrow the document's arena synchronously,
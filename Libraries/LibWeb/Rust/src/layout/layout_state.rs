@@ -675,7 +675,9 @@ impl<'pass> NodeFacts<'pass> {
             return false;
         }
         let style = self.style();
-        style.has_size_containment() || style.is_size_container()
+        style.has_size_containment()
+            || style.is_size_container()
+            || crate::layout::has_flag(self.data(), NodeFlag::SkipsItsContents)
     }
 
     pub(crate) fn has_preferred_aspect_ratio(&self) -> bool {
@@ -697,6 +699,17 @@ impl<'pass> NodeFacts<'pass> {
         (denominator != crate::layout::CssPixels::default()).then_some(PixelFraction { numerator, denominator })
     }
 
+    // https://drafts.csswg.org/css-sizing-4/#last-remembered
+    pub(crate) fn last_remembered_block_size(&self) -> Option<crate::layout::CssPixels> {
+        if !crate::layout::has_flag(self.data(), NodeFlag::SkipsItsContents) {
+            return None;
+        }
+        let replaced = self.replaced_content();
+        replaced
+            .has_last_remembered_block_size
+            .then_some(replaced.last_remembered_block_size)
+    }
+
     pub(crate) fn has_default_preferred_width(&self) -> bool {
         self.replaced_content().has_default_preferred_width
     }
@@ -1175,9 +1188,12 @@ impl LayoutState {
         let data = callbacks.node_data(node);
         // Size containment gives any box an auto content box size of zero, so
         // size-contained boxes join the replaced kinds in fetching real facts.
+        // A box that skips its contents is size-contained too, with its last remembered size standing in.
         let size_containment_may_apply = crate::layout::kind_is_box(data.kind) && !data.style.is_null() && {
             let style = self.style_facts(callbacks, node);
-            style.has_size_containment() || style.is_size_container()
+            style.has_size_containment()
+                || style.is_size_container()
+                || crate::layout::has_flag(data, NodeFlag::SkipsItsContents)
         };
         let facts = if crate::layout::node_may_have_replaced_content_facts(data) || size_containment_may_apply {
             // SAFETY: The callback table and node are supplied by the live C++
@@ -1208,19 +1224,22 @@ impl LayoutState {
             font_variant_emoji: parent_style.font_variant_emoji(),
             font_cascade_list: parent_style.font_cascade_list(),
         };
-        let text = &callbacks.text_content(node).text;
-        callbacks.arena().text_chunks(node, key, || {
-            chunk_text(TextChunkInputs {
-                text,
-                font_cascade_list: key.font_cascade_list,
-                white_space_collapse: key.white_space_collapse,
-                word_break: key.word_break,
-                font_variant_emoji: key.font_variant_emoji,
-                should_wrap_lines,
-                should_respect_linebreaks,
-                unidirectional_ltr,
-            })
-        })
+        let inputs = TextChunkInputs {
+            text: &callbacks.text_content(node).text,
+            font_cascade_list: key.font_cascade_list,
+            white_space_collapse: key.white_space_collapse,
+            word_break: key.word_break,
+            font_variant_emoji: key.font_variant_emoji,
+            should_wrap_lines,
+            should_respect_linebreaks,
+            unidirectional_ltr,
+        };
+        callbacks.arena().text_chunks(
+            node,
+            key,
+            || chunk_text(inputs),
+            |previous| chunk_text_incrementally(inputs, previous),
+        )
     }
 
     pub(crate) fn line_data_cell(&self, slot_index: u32) -> &RefCell<LineData> {
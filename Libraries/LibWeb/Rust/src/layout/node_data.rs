@@ -143,6 +143,7 @@ pub enum NodeFlag {
     SavedAbsposAlignmentDerivesFromOwnComputedValues = 1 << 21,
     ProducesLineBoxFragmentWhenEmpty = 1 << 22,
     ListMarkerIsInside = 1 << 23,
+    SkipsItsContents = 1 << 24,
 }
 
 #[repr(C)]
@@ -234,6 +235,11 @@ mod tests {
         assert_eq!(NodeFlag::ListMarkerIsInside as u32, 1 << 23);
     }
 
+    #[test]
+    fn skipped_contents_flag_uses_previously_unassigned_bit() {
+        assert_eq!(NodeFlag::SkipsItsContents as u32, 1 << 24);
+    }
+
     #[test]
     fn stamped_fact_flags_use_previously_unassigned_bits() {
         assert_eq!(NodeFlag::IsHtmlInputElement as u32, 1 << 13);
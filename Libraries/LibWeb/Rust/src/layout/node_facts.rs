@@ -22,6 +22,10 @@ pub struct FfiReplacedContentFacts {
     pub default_preferred_width: CssPixels,
     pub has_default_preferred_height: bool,
     pub default_preferred_height: CssPixels,
+    /// Set only while a content-visibility: auto box skips its contents and
+    /// has been rendered with them before.
+    pub has_last_remembered_block_size: bool,
+    pub last_remembered_block_size: CssPixels,
 }
 
 pub(crate) fn node_may_have_replaced_content_facts(data: &NodeData) -> bool {
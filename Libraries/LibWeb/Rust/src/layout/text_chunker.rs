@@ -30,6 +30,7 @@ pub(crate) struct TextChunk {
     pub text_type: u8,
 }
 
+#[derive(Clone, Copy)]
 pub(crate) struct TextChunkInputs<'text> {
     pub text: &'text [u16],
     pub font_cascade_list: *const c_void,
@@ -50,6 +51,150 @@ pub(crate) fn chunk_text(inputs: TextChunkInputs<'_>) -> Vec<TextChunk> {
     chunks
 }
 
+/// The chunks of a text node's previous contents, from before its text was edited.
+pub(crate) struct PreviousTextChunks<'text> {
+    pub text: &'text [u16],
+    pub chunks: &'text [TextChunk],
+}
+
+/// The result of rechunking edited text. Chunks before `reused_prefix_count` are identical to the previous chunks
+/// with the same index, and chunks from `reused_suffix_start` onwards are the previous chunks from
+/// `reused_previous_suffix_start` onwards, moved by the length difference of the edit.
+pub(crate) struct IncrementalTextChunks {
+    pub chunks: Vec<TextChunk>,
+    pub reused_prefix_count: usize,
+    pub reused_suffix_start: usize,
+    pub reused_previous_suffix_start: usize,
+}
+
+/// Rechunks text after an edit, only chunking the lines around the edit and reusing the previous chunks for the rest.
+/// Returns None if the chunks can't be reused, in which case the text has to be chunked from scratch.
+///
+/// Preserved newlines always end a chunk, and chunking after a newline only depends on the text that follows it and
+/// on the font of the last non-whitespace chunk. So, chunking can resume at the start of any line given that font, and
+/// stops once it reaches a line start after the edit that has the same font as before.
+pub(crate) fn chunk_text_incrementally(
+    inputs: TextChunkInputs<'_>,
+    previous: PreviousTextChunks<'_>,
+) -> Option<IncrementalTextChunks> {
+    if !inputs.should_respect_linebreaks
+        || matches!(
+            inputs.white_space_collapse,
+            white_space_collapse::COLLAPSE | white_space_collapse::PRESERVE_BREAKS
+        )
+    {
+        return None;
+    }
+
+    let text = inputs.text;
+    let previous_text = previous.text;
+
+    // NB: ASCII text is segmented into graphemes differently, so it can't share chunks with non-ASCII text.
+    let is_ascii = |text: &[u16]| text.iter().all(|unit| *unit <= 0x7f);
+    if is_ascii(text) != is_ascii(previous_text) {
+        return None;
+    }
+
+    let common_prefix_length = text
+        .iter()
+        .zip(previous_text)
+        .take_while(|(unit, previous_unit)| unit == previous_unit)
+        .count();
+    let common_suffix_length = text[common_prefix_length..]
+        .iter()
+        .rev()
+        .zip(previous_text[common_prefix_length..].iter().rev())
+        .take_while(|(unit, previous_unit)| unit == previous_unit)
+        .count();
+    let edit_end = text.len() - common_suffix_length;
+    let previous_edit_end = previous_text.len() - common_suffix_length;
+
+    let line_start_before = |index: usize| {
+        text[..index]
+            .iter()
+            .rposition(|unit| *unit == '\n' as u16)
+            .map_or(0, |newline| newline + 1)
+    };
+
+    // Resume chunking at the start of the edited line. Spaces look ahead to the next non-space to pick their font,
+    // so we also have to go back over any lines that end in whitespace, as their chunks may have looked into the edit.
+    let mut restart = line_start_before(common_prefix_length);
+    while restart > 0 {
+        let is_preceded_by_whitespace = restart < 2 || {
+            let code_point = u32::from(text[restart - 2]);
+            code_point_is_ascii_space(code_point) || is_interword_space(code_point)
+        };
+        if !is_preceded_by_whitespace {
+            break;
+        }
+        restart = line_start_before(restart - 1);
+    }
+
+    let reused_prefix_count = previous.chunks.partition_point(|chunk| chunk.start < restart);
+    let restarts_at_chunk_boundary = previous
+        .chunks
+        .get(reused_prefix_count)
+        .map_or(restart == previous_text.len(), |chunk| chunk.start == restart);
+    if !restarts_at_chunk_boundary {
+        return None;
+    }
+
+    let last_non_whitespace_font_before = |chunks: &[TextChunk]| {
+        chunks
+            .iter()
+            .rev()
+            .find(|chunk| !chunk.is_all_whitespace)
+            .map(|chunk| chunk.font)
+    };
+
+    let mut chunker = TextChunker::new(inputs);
+    chunker.current_index = restart;
+    // SAFETY: The previous chunks' fonts belong to the same, still retained, font cascade list.
+    chunker.last_non_whitespace_font = last_non_whitespace_font_before(&previous.chunks[..reused_prefix_count])
+        .map(|font| unsafe { FontRef::from_raw(font) });
+
+    let mut chunks = previous.chunks[..reused_prefix_count].to_vec();
+    while let Some(chunk) = chunker.next_chunk() {
+        chunks.push(chunk);
+
+        let chunk_end = chunk.start + chunk.length;
+        if !chunk.has_breaking_newline || chunk_end < edit_end {
+            continue;
+        }
+
+        let previous_chunk_end = chunk_end - edit_end + previous_edit_end;
+        let previous_index = previous.chunks.partition_point(|chunk| chunk.start < previous_chunk_end);
+        if previous.chunks.get(previous_index).is_none_or(|chunk| chunk.start != previous_chunk_end) {
+            continue;
+        }
+        if chunker.last_non_whitespace_font.map(FontRef::as_raw)
+            != last_non_whitespace_font_before(&previous.chunks[..previous_index])
+        {
+            continue;
+        }
+
+        let reused_suffix_start = chunks.len();
+        chunks.extend(previous.chunks[previous_index..].iter().map(|previous_chunk| TextChunk {
+            start: previous_chunk.start - previous_chunk_end + chunk_end,
+            ..*previous_chunk
+        }));
+        return Some(IncrementalTextChunks {
+            chunks,
+            reused_prefix_count,
+            reused_suffix_start,
+            reused_previous_suffix_start: previous_index,
+        });
+    }
+
+    let reused_suffix_start = chunks.len();
+    Some(IncrementalTextChunks {
+        chunks,
+        reused_prefix_count,
+        reused_suffix_start,
+        reused_previous_suffix_start: previous.chunks.len(),
+    })
+}
+
 struct IcuSegmenterHandle {
     raw: *mut c_void,
 }
@@ -139,7 +139,7 @@ pub struct FfiPreparedPrincipalElementFacts {
 #[repr(C)]
 pub struct FfiDisplayContentsFacts {
     pub rendered_in_top_layer: bool,
-    pub content_visibility_hidden: bool,
+    pub skips_its_contents: bool,
     pub should_layout_dom_children: bool,
     pub child_needs_layout_tree_update: bool,
     pub dom_children_parent: *mut c_void,
@@ -168,7 +168,7 @@ pub struct FfiFlatTreeRenderFacts {
 #[repr(C)]
 pub struct FfiPrincipalDescendantFacts {
     pub is_element: bool,
-    pub content_visibility_hidden: bool,
+    pub skips_its_contents: bool,
     pub should_layout_dom_children: bool,
     pub child_needs_layout_tree_update: bool,
     pub is_svg_switch_element: bool,
@@ -787,7 +787,7 @@ unsafe fn update_layout_tree_for_display_contents(
             }
         }
 
-        if !facts.content_visibility_hidden {
+        if !facts.skips_its_contents {
             create_pseudo_element(
                 host,
                 state,
@@ -797,7 +797,7 @@ unsafe fn update_layout_tree_for_display_contents(
             );
         }
 
-        if !facts.content_visibility_hidden && (should_create_layout_node || facts.child_needs_layout_tree_update) {
+        if !facts.skips_its_contents && (should_create_layout_node || facts.child_needs_layout_tree_update) {
             let must_create_children = should_create_layout_node;
             if !facts.shadow_root.is_null() {
                 // SAFETY: The callback table, shadow root, and context remain valid.
@@ -826,7 +826,7 @@ unsafe fn update_layout_tree_for_display_contents(
         }
 
         if !facts.slot_element.is_null() {
-            if !facts.content_visibility_hidden {
+            if !facts.skips_its_contents {
                 // SAFETY: The callback table, slot element, and context remain valid.
                 unsafe {
                     update_layout_tree_for_assigned_slottables(
@@ -853,7 +853,7 @@ unsafe fn update_layout_tree_for_display_contents(
             }
         }
 
-        if !facts.content_visibility_hidden {
+        if !facts.skips_its_contents {
             create_pseudo_element(
                 host,
                 state,
@@ -983,7 +983,7 @@ unsafe fn update_principal_node_descendants(
             }
 
             // Add the ::before pseudo-element before walking normal children.
-            if facts.is_element && layout_node_can_have_children && !facts.content_visibility_hidden {
+            if facts.is_element && layout_node_can_have_children && !facts.skips_its_contents {
                 state.ancestor_stack.push(layout_node);
                 create_pseudo_element(
                     host,
@@ -996,7 +996,7 @@ unsafe fn update_principal_node_descendants(
             }
         }
 
-        if facts.content_visibility_hidden {
+        if facts.skips_its_contents {
             // SAFETY: The builder and DOM node remain live throughout the call.
             unsafe {
                 (host.callbacks.clear_stale_subtree)(
@@ -1010,7 +1010,7 @@ unsafe fn update_principal_node_descendants(
         if (should_create_layout_node || facts.child_needs_layout_tree_update)
             && (!facts.shadow_root.is_null() || facts.should_layout_dom_children)
             && layout_node_can_have_children
-            && !facts.content_visibility_hidden
+            && !facts.skips_its_contents
         {
             state.ancestor_stack.push(layout_node);
 
@@ -1108,7 +1108,7 @@ unsafe fn update_principal_node_descendants(
         }
 
         if !facts.slot_element.is_null() {
-            if !facts.content_visibility_hidden {
+            if !facts.skips_its_contents {
                 state.ancestor_stack.push(layout_node);
                 // SAFETY: The callback table, slot element, and context remain valid.
                 unsafe {
@@ -1177,7 +1177,7 @@ unsafe fn update_principal_node_descendants(
             }
 
             // Add ::marker and ::after once normal and SVG resource children are complete.
-            if facts.is_element && layout_node_can_have_children && !facts.content_visibility_hidden {
+            if facts.is_element && layout_node_can_have_children && !facts.skips_its_contents {
                 state.ancestor_stack.push(layout_node);
                 if layout_host.data(layout_node).kind == NodeKind::ListItemBox {
                     create_pseudo_element(
@@ -27,16 +27,19 @@
 #include <LibRequests/RequestClient.h>
 #include <LibThreading/ThreadPool.h>
 #include <LibURL/Parser.h>
+#include <LibWasm/AbstractMachine/StreamingCompiler.h>
 #include <LibWasm/AbstractMachine/Validator.h>
 #include <LibWeb/Bindings/Intrinsics.h>
 #include <LibWeb/Bindings/Response.h>
 #include <LibWeb/ContentSecurityPolicy/BlockingAlgorithms.h>
+#include <LibWeb/Fetch/Infrastructure/HTTP/Bodies.h>
 #include <LibWeb/Fetch/Infrastructure/HTTP/MIME.h>
 #include <LibWeb/Fetch/Infrastructure/URL.h>
 #include <LibWeb/Fetch/Response.h>
 #include <LibWeb/HTML/Scripting/TemporaryExecutionContext.h>
 #include <LibWeb/Loader/ResourceLoader.h>
 #include <LibWeb/Platform/EventLoopPlugin.h>
+#include <LibWeb/Streams/ReadableStreamDefaultReader.h>
 #include <LibWeb/WebAssembly/Global.h>
 #include <LibWeb/WebAssembly/Instance.h>
 #include <LibWeb/WebAssembly/Memory.h>
@@ -447,6 +450,53 @@ JS::ThrowCompletionOr<NonnullRefPtr<Wasm::ModuleInstance>> instantiate_module(JS
     return instance_result.release_value();
 }
 
+static bool can_use_compiled_code_cache()
+{
+    return ResourceLoader::is_initialized() && ResourceLoader::the().request_client();
+}
+
+// Content-keyed disk cache: slot the compiled code for the wasm bytes with the given SHA-256 digest into the HTTP side-data shelf under a synthetic wasm-cache://<hex> URL
+static Optional<Wasm::CompileCacheConfig> create_compiled_code_cache_config(ReadonlyBytes digest)
+{
+    StringBuilder hex_builder;
+    for (auto byte : digest)
+        hex_builder.appendff("{:02x}", byte);
+    auto synthetic_url = URL::Parser::basic_parse(ByteString::formatted("wasm-cache://{}", hex_builder.to_byte_string()));
+    if (!synthetic_url.has_value())
+        return {};
+
+    auto method = "GET"_string.to_byte_string();
+    (void)ResourceLoader::the().request_client()->create_synthetic_cache_entry(*synthetic_url, method);
+
+    Wasm::CompileCacheConfig config;
+    __builtin_memcpy(config.wasm_hash.data(), digest.data(), 32);
+
+    auto retrieve_result = ResourceLoader::the().request_client()->retrieve_cache_associated_data(
+        *synthetic_url, method, OptionalNone {}, 0u,
+        HTTP::CacheEntryAssociatedData::WebAssemblyCompiledCode);
+    if (!retrieve_result.is_error()) {
+        if (auto buf = retrieve_result.release_value(); buf.has_value()) {
+            // Copy into an owned buffer: compilation may run on another thread long after the AnonymousBuffer here goes away.
+            if (auto copy = ByteBuffer::copy(buf->bytes()); !copy.is_error())
+                config.existing_blob = copy.release_value();
+        }
+    }
+
+    config.on_compiled = [url = *synthetic_url, method = move(method), event_loop_weak = Core::EventLoop::current_weak()](ByteBuffer blob) mutable {
+        auto origin = event_loop_weak->take();
+        if (!origin)
+            return;
+        origin->deferred_invoke([url = move(url), method = move(method), blob = move(blob)]() mutable {
+            if (!ResourceLoader::is_initialized() || !ResourceLoader::the().request_client())
+                return;
+            (void)ResourceLoader::the().request_client()->store_cache_associated_data(
+                url, method, OptionalNone {}, 0u,
+                HTTP::CacheEntryAssociatedData::WebAssemblyCompiledCode, blob.bytes());
+        });
+    };
+    return config;
+}
+
 // https://webassembly.github.io/spec/js-api/#compile-a-webassembly-module
 // https://webassembly.github.io/content-security-policy/js-api/#compile-a-webassembly-module
 JS::ThrowCompletionOr<NonnullRefPtr<CompiledWebAssemblyModule>> compile_a_webassembly_module(JS::VM& vm, ByteBuffer data)
@@ -464,48 +514,11 @@ JS::ThrowCompletionOr<NonnullRefPtr<CompiledWebAssemblyModule>> compile_a_webass
         return vm.throw_completion<CompileError>(Wasm::parse_error_to_byte_string(module_result.error()));
     }
 
-    // Content-keyed disk cache: hash the wasm bytes, slot into the HTTP side-data shelf under a synthetic wasm-cache://<hex> URL
     Optional<Wasm::CompileCacheConfig> wasm_cache_config;
-    if (ResourceLoader::is_initialized() && ResourceLoader::the().request_client()) {
+    if (can_use_compiled_code_cache()) {
         auto digest = ::Crypto::Hash::SHA256::hash(data.data(), data.size());
         __builtin_memcpy(stats.wasm_hash.data(), digest.bytes().data(), 32);
-
-        StringBuilder hex_builder;
-        for (auto byte : digest.bytes())
-            hex_builder.appendff("{:02x}", byte);
-        auto synthetic_url = URL::Parser::basic_parse(ByteString::formatted("wasm-cache://{}", hex_builder.to_byte_string()));
-        if (synthetic_url.has_value()) {
-            auto method = "GET"_string.to_byte_string();
-            (void)ResourceLoader::the().request_client()->create_synthetic_cache_entry(*synthetic_url, method);
-
-            Wasm::CompileCacheConfig config;
-            __builtin_memcpy(config.wasm_hash.data(), digest.bytes().data(), 32);
-
-            auto retrieve_result = ResourceLoader::the().request_client()->retrieve_cache_associated_data(
-                *synthetic_url, method, OptionalNone {}, 0u,
-                HTTP::CacheEntryAssociatedData::WebAssemblyCompiledCode);
-            if (!retrieve_result.is_error()) {
-                if (auto buf = retrieve_result.release_value(); buf.has_value()) {
-                    // Copy into an owned buffer: compilation may run on another thread long after the AnonymousBuffer here goes away.
-                    if (auto copy = ByteBuffer::copy(buf->bytes()); !copy.is_error())
-                        config.existing_blob = copy.release_value();
-                }
-            }
-
-            config.on_compiled = [url = *synthetic_url, method = move(method), event_loop_weak = Core::EventLoop::current_weak()](ByteBuffer blob) mutable {
-                auto origin = event_loop_weak->take();
-                if (!origin)
-                    return;
-                origin->deferred_invoke([url = move(url), method = move(method), blob = move(blob)]() mutable {
-                    if (!ResourceLoader::is_initialized() || !ResourceLoader::the().request_client())
-                        return;
-                    (void)ResourceLoader::the().request_client()->store_cache_associated_data(
-                        url, method, OptionalNone {}, 0u,
-                        HTTP::CacheEntryAssociatedData::WebAssemblyCompiledCode, blob.bytes());
-                });
-            };
-            wasm_cache_config = move(config);
-        }
+        wasm_cache_config = create_compiled_code_cache_config(digest.bytes());
     }
 
     constexpr auto compile_to_native = Wasm::CompileToNative::No;
@@ -1097,6 +1110,106 @@ GC::Ref<WebIDL::Promise> instantiate_promise_of_module(JS::VM& vm, GC::Ref<WebID
     return promise;
 }
 
+// Compiles the body of a (checked) response chunk by chunk, and settles returnValue like steps 8-10 of compiling a
+// potential WebAssembly response would.
+static void streaming_compile_webassembly_response(JS::VM& vm, Fetch::Response& response_object, GC::Ref<WebIDL::Promise> return_value)
+{
+    auto& realm = HTML::relevant_realm(*return_value->promise());
+
+    // https://fetch.spec.whatwg.org/#concept-body-consume-body
+    // 1. If object is unusable, then return a promise rejected with a TypeError.
+    if (response_object.is_unusable()) {
+        WebIDL::reject_promise(realm, return_value, vm.throw_completion<JS::TypeError>("Body is unusable"_utf16).value());
+        return;
+    }
+
+    // 5. If object’s body is null, then run successSteps with an empty byte sequence.
+    auto body = response_object.body_impl();
+    if (!body) {
+        auto result = asynchronously_compile_webassembly_module(vm, {}, HTML::Task::Source::Networking);
+        WebIDL::resolve_promise(realm, return_value, result->promise());
+        return;
+    }
+
+    if (auto result = Detail::host_ensure_can_compile_wasm_bytes(vm); result.is_error()) {
+        WebIDL::reject_promise(realm, return_value, result.release_error().value());
+        return;
+    }
+
+    struct StreamingCompilation : public RefCounted<StreamingCompilation> {
+        Wasm::StreamingCompiler compiler;
+        NonnullOwnPtr<::Crypto::Hash::SHA256> hasher { ::Crypto::Hash::SHA256::create() };
+        Wasm::ModuleStats stats;
+        GC::Root<Streams::ReadableStreamDefaultReader> reader;
+        bool is_done { false };
+    };
+    auto compilation = make_ref_counted<StreamingCompilation>();
+
+    auto fail = [&realm, return_value](StreamingCompilation& compilation, JS::Value reason) {
+        compilation.is_done = true;
+        if (compilation.reader) {
+            Fetch::Infrastructure::cancel_incremental_read(*compilation.reader);
+            compilation.reader = {};
+        }
+        WebIDL::reject_promise(realm, return_value, reason);
+    };
+
+    auto process_body_chunk = GC::create_function(vm.heap(), [&vm, &realm, compilation, fail](ByteBuffer chunk) {
+        if (compilation->is_done)
+            return;
+        HTML::TemporaryExecutionContext context(realm, HTML::TemporaryExecutionContext::CallbacksEnabled::Yes);
+
+        compilation->hasher->update(chunk);
+        compilation->stats.input_size_bytes += chunk.size();
+
+        // NB: Parsing and validation are interleaved here, so all of it is accounted as validation.
+        auto validate_start = MonotonicTime::now();
+        auto result = compilation->compiler.append(chunk);
+        compilation->stats.validate_time += MonotonicTime::now() - validate_start;
+
+        if (result.is_error())
+            fail(*compilation, vm.throw_completion<CompileError>(result.error().error_string).value());
+    });
+
+    auto process_end_of_body = GC::create_function(vm.heap(), [&vm, &realm, compilation, fail, return_value]() {
+        if (compilation->is_done)
+            return;
+        compilation->is_done = true;
+        compilation->reader = {};
+        HTML::TemporaryExecutionContext context(realm, HTML::TemporaryExecutionContext::CallbacksEnabled::Yes);
+
+        Optional<Wasm::CompileCacheConfig> cache_config;
+        if (Detail::can_use_compiled_code_cache()) {
+            auto digest = compilation->hasher->digest();
+            __builtin_memcpy(compilation->stats.wasm_hash.data(), digest.bytes().data(), 32);
+            cache_config = Detail::create_compiled_code_cache_config(digest.bytes());
+        }
+
+        auto module_or_error = compilation->compiler.finish(move(cache_config), compilation->stats);
+        if (module_or_error.is_error()) {
+            fail(*compilation, vm.throw_completion<CompileError>(module_or_error.error().error_string).value());
+            return;
+        }
+
+        // NB: Native compilation has been running all along, so there's nothing left to kick off here.
+        auto compiled_module = make_ref_counted<Detail::CompiledWebAssemblyModule>(module_or_error.release_value());
+        Detail::get_cache(realm).add_compiled_module(compiled_module);
+
+        auto module_object = realm.create<Module>(realm, move(compiled_module));
+        WebIDL::resolve_promise(realm, return_value, module_object);
+    });
+
+    auto process_body_error = GC::create_function(vm.heap(), [&realm, compilation, fail](JS::Value reason) {
+        if (compilation->is_done)
+            return;
+        HTML::TemporaryExecutionContext context(realm, HTML::TemporaryExecutionContext::CallbacksEnabled::Yes);
+        compilation->reader = {};
+        fail(*compilation, reason);
+    });
+
+    compilation->reader = body->incrementally_read(process_body_chunk, process_end_of_body, process_body_error, GC::Ref { HTML::relevant_global_object(response_object) });
+}
+
 // https://webassembly.github.io/spec/web-api/index.html#compile-a-potential-webassembly-response
 GC::Ref<WebIDL::Promise> compile_potential_webassembly_response(JS::VM& vm, GC::Ref<WebIDL::Promise> source)
 {
@@ -1147,42 +1260,14 @@ GC::Ref<WebIDL::Promise> compile_potential_webassembly_response(JS::VM& vm, GC::
         }
 
         // 8. Consume response’s body as an ArrayBuffer, and let bodyPromise be the result.
-        auto body_promise_or_error = response_object->array_buffer();
-        if (body_promise_or_error.is_error()) {
-            auto throw_completion = Bindings::exception_to_throw_completion(realm.vm(), body_promise_or_error.release_error());
-            WebIDL::reject_promise(realm, return_value, throw_completion.value());
-            return JS::js_undefined();
-        }
-        auto body_promise = body_promise_or_error.release_value();
-
         // 9. Upon fulfillment of bodyPromise with value bodyArrayBuffer:
-        auto body_fulfillment_steps = GC::create_function(vm.heap(), [&vm, return_value](JS::Value body_array_buffer) -> WebIDL::ExceptionOr<JS::Value> {
-            // 1. Let stableBytes be a copy of the bytes held by the buffer bodyArrayBuffer.
-            VERIFY(body_array_buffer.is_object());
-            auto stable_bytes = WebIDL::get_buffer_source_copy(body_array_buffer.as_object());
-            if (stable_bytes.is_error()) {
-                VERIFY(stable_bytes.error().code() == ENOMEM);
-                WebIDL::reject_promise(HTML::relevant_realm(*return_value->promise()), return_value, vm.throw_completion<JS::InternalError>(vm.error_message(JS::VM::ErrorMessage::OutOfMemory)).value());
-                return JS::js_undefined();
-            }
-
-            // 2. Asynchronously compile the WebAssembly module stableBytes using the networking task source and resolve returnValue with the result.
-            auto result = asynchronously_compile_webassembly_module(vm, stable_bytes.release_value(), HTML::Task::Source::Networking);
-
-            // Need to manually convert WebIDL promise to an ECMAScript value here to resolve
-            WebIDL::resolve_promise(HTML::relevant_realm(*return_value->promise()), return_value, result->promise());
-
-            return JS::js_undefined();
-        });
-
+        //    1. Let stableBytes be a copy of the bytes held by the buffer bodyArrayBuffer.
+        //    2. Asynchronously compile the WebAssembly module stableBytes using the networking task source and resolve returnValue with the result.
         // 10. Upon rejection of bodyPromise with reason reason:
-        auto body_rejection_steps = GC::create_function(vm.heap(), [return_value](JS::Value reason) -> WebIDL::ExceptionOr<JS::Value> {
-            // 1. Reject returnValue with reason.
-            WebIDL::reject_promise(HTML::relevant_realm(*return_value->promise()), return_value, reason);
-            return JS::js_undefined();
-        });
-
-        WebIDL::react_to_promise(body_promise, body_fulfillment_steps, body_rejection_steps);
+        //    1. Reject returnValue with reason.
+        // AD-HOC: Instead of waiting for the whole body, we feed it to a streaming compiler as it arrives, so that function
+        //         bodies are validated and compiled while the rest of the module is still downloading.
+        streaming_compile_webassembly_response(vm, *response_object, return_value);
 
         return JS::js_undefined();
     });
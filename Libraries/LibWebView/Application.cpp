@@ -1982,6 +1982,9 @@ void Application::initialize_actions()
     m_debug_menu->add_action(Action::create("Dump Local Storage"sv, ActionID::DumpLocalStorage, debug_request("dump-local-storage"sv)));
     m_debug_menu->add_action(Action::create("Dump Session Storage"sv, ActionID::DumpSessionStorage, debug_request("dump-session-storage"sv)));
     m_debug_menu->add_action(Action::create("Dump WASM Stats"sv, ActionID::DumpWasmStats, debug_request("dump-wasm-stats"sv)));
+    if constexpr (JS_BYTECODE_STATISTICS_DEBUG)
+        m_debug_menu->add_action(Action::create("Dump Bytecode Stats"sv, ActionID::DumpBytecodeStats, debug_request("dump-bytecode-stats"sv)));
+    m_debug_menu->add_action(Action::create("Dump Glyph Run Cache Stats"sv, ActionID::DumpGlyphRunCacheStats, debug_request("dump-glyph-run-cache-stats"sv)));
     m_debug_menu->add_action(Action::create("Dump GC graph"sv, ActionID::DumpGCGraph, [this]() {
         if (auto view = active_web_view(); view.has_value()) {
             auto gc_graph_path = view->dump_gc_graph();
@@ -36,6 +36,7 @@ class ViewImplementation;
 class WebContentClient;
 class WebWorkerClient;
 class WebUI;
+class WorkerProcessManager;
 
 struct Attribute;
 struct AutocompleteEngine;
@@ -116,6 +116,8 @@ enum class ActionID {
     DumpSessionStorage,
     DumpGCGraph,
     DumpWasmStats,
+    DumpBytecodeStats,
+    DumpGlyphRunCacheStats,
     ShowLineBoxBorders,
     ShowCaretHitTestDebugOverlay,
     CollectGarbage,
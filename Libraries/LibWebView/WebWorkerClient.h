@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/Badge.h>
 #include <AK/ByteString.h>
 #include <AK/Types.h>
 #include <AK/Utf16String.h>
@@ -18,6 +19,7 @@
 #include <LibWeb/Worker/WebWorkerClientEndpoint.h>
 #include <LibWeb/Worker/WebWorkerServerEndpoint.h>
 #include <LibWebView/Export.h>
+#include <LibWebView/Forward.h>
 #include <LibWebView/PrivateBrowsing.h>
 
 namespace WebView {
@@ -35,6 +37,9 @@ public:
 
     IsPrivate is_private() const { return m_is_private; }
 
+    Web::HTML::WorkerAgentId agent_id() const { return m_agent_id; }
+    void set_agent_id(Badge<WorkerProcessManager>, Web::HTML::WorkerAgentId agent_id) { m_agent_id = agent_id; }
+
     pid_t pid() const { return m_pid; }
     void set_pid(pid_t pid) { m_pid = pid; }
 
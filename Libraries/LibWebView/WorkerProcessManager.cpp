@@ -110,18 +110,9 @@ Web::HTML::WorkerAgentId WorkerProcessManager::start_worker_agent(Owner owner, W
 
     // 11.6. Otherwise, in parallel, run a worker given worker, urlRecord, outsideSettings, outsidePort,
     //       and options.
-    // AD-HOC: For DedicatedWorker there is no shared worker manager step; we always launch a fresh
-    //         worker process here.
+    // AD-HOC: For DedicatedWorker there is no shared worker manager step; we always use a fresh worker process here.
     auto agent_id = ++m_next_agent_id;
-    auto client = MUST(launch_web_worker_process(request.agent_type, is_private, agent_id));
-
-    auto request_server_handle = MUST(connect_new_request_server_client(is_private));
-    auto image_decoder_handle = MUST(connect_new_image_decoder_client());
-    client->async_connect_to_request_server(move(request_server_handle));
-    client->async_connect_to_image_decoder(move(image_decoder_handle));
-
-    if (auto compositor_handle = Application::the().connect_new_compositor_canvas_client(); !compositor_handle.is_error())
-        client->async_connect_to_compositor(compositor_handle.release_value());
+    auto client = launch_web_worker_process(request.agent_type, is_private, agent_id);
 
     Vector<Owner> owners;
     owners.append(owner);
@@ -159,6 +150,74 @@ Web::HTML::WorkerAgentId WorkerProcessManager::start_worker_agent(Owner owner, W
     return agent_id;
 }
 
+ErrorOr<NonnullRefPtr<WebWorkerClient>> WorkerProcessManager::create_web_worker_client(Web::Bindings::AgentType agent_type, IsPrivate is_private, Web::HTML::WorkerAgentId agent_id)
+{
+    auto client = TRY(WebView::launch_web_worker_process(agent_type, is_private, agent_id));
+
+    auto request_server_handle = TRY(connect_new_request_server_client(is_private));
+    auto image_decoder_handle = TRY(connect_new_image_decoder_client());
+    client->async_connect_to_request_server(move(request_server_handle));
+    client->async_connect_to_image_decoder(move(image_decoder_handle));
+
+    if (auto compositor_handle = Application::the().connect_new_compositor_canvas_client(); !compositor_handle.is_error())
+        client->async_connect_to_compositor(compositor_handle.release_value());
+
+    return client;
+}
+
+NonnullRefPtr<WebWorkerClient> WorkerProcessManager::launch_web_worker_process(Web::Bindings::AgentType agent_type, IsPrivate is_private, Web::HTML::WorkerAgentId agent_id)
+{
+    // Shared workers are rare and long-lived enough that keeping a spare process around for them is not worthwhile.
+    if (agent_type != Web::Bindings::AgentType::DedicatedWorker || is_private == IsPrivate::Yes)
+        return MUST(create_web_worker_client(agent_type, is_private, agent_id));
+
+    if (m_spare_dedicated_worker_process) {
+        auto client = m_spare_dedicated_worker_process.release_nonnull();
+        launch_spare_dedicated_worker_process();
+
+        client->set_agent_id({}, agent_id);
+        if (auto process = Application::the().find_process(client->pid()); process.has_value())
+            process->set_title(OptionalNone {});
+
+        return client;
+    }
+
+    launch_spare_dedicated_worker_process();
+    return MUST(create_web_worker_client(agent_type, is_private, agent_id));
+}
+
+void WorkerProcessManager::launch_spare_dedicated_worker_process()
+{
+    auto const& browser_options = Application::browser_options();
+
+    // See Application::launch_spare_web_content_process() for why spare processes are disabled in these cases.
+    if (browser_options.webdriver_endpoint.has_value())
+        return;
+    if (browser_options.debug_helper_processes.contains_slow(ProcessType::WebWorker))
+        return;
+    if (browser_options.profile_helper_process == ProcessType::WebWorker)
+        return;
+
+    if (m_has_queued_task_to_launch_spare_dedicated_worker_process)
+        return;
+    m_has_queued_task_to_launch_spare_dedicated_worker_process = true;
+
+    Core::deferred_invoke([this]() {
+        m_has_queued_task_to_launch_spare_dedicated_worker_process = false;
+
+        auto client = create_web_worker_client(Web::Bindings::AgentType::DedicatedWorker, IsPrivate::No, 0);
+        if (client.is_error()) {
+            dbgln("Unable to create spare dedicated worker client: {}", client.error());
+            return;
+        }
+
+        m_spare_dedicated_worker_process = client.release_value();
+
+        if (auto process = Application::the().find_process(m_spare_dedicated_worker_process->pid()); process.has_value())
+            process->set_title("(spare)"_utf16);
+    });
+}
+
 void WorkerProcessManager::close_worker_agent(WebContentClient& client, Web::HTML::WorkerAgentId agent_id, Web::HTML::WorkerAgentOwnerToken owner_token)
 {
     Owner identity {
@@ -336,6 +395,12 @@ void WorkerProcessManager::worker_did_close(Web::HTML::WorkerAgentId agent_id)
 
 void WorkerProcessManager::worker_did_die(Web::HTML::WorkerAgentId agent_id)
 {
+    // The spare dedicated worker process has not been assigned an agent yet.
+    if (agent_id == 0) {
+        m_spare_dedicated_worker_process = nullptr;
+        return;
+    }
+
     worker_did_close(agent_id);
 }
 
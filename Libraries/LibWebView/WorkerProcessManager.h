@@ -6,9 +6,11 @@
 
 #pragma once
 
+#include <AK/Error.h>
 #include <AK/HashMap.h>
 #include <AK/NonnullRefPtr.h>
 #include <AK/Optional.h>
+#include <AK/RefPtr.h>
 #include <AK/Utf16String.h>
 #include <AK/Variant.h>
 #include <AK/Vector.h>
@@ -64,6 +66,10 @@ private:
 
     Web::HTML::WorkerAgentId start_worker_agent(Owner, Web::HTML::WorkerAgentStartRequest, IsPrivate);
 
+    ErrorOr<NonnullRefPtr<WebWorkerClient>> create_web_worker_client(Web::Bindings::AgentType, IsPrivate, Web::HTML::WorkerAgentId);
+    NonnullRefPtr<WebWorkerClient> launch_web_worker_process(Web::Bindings::AgentType, IsPrivate, Web::HTML::WorkerAgentId);
+    void launch_spare_dedicated_worker_process();
+
     void notify_worker_script_load_success(Owner const&);
     void notify_worker_script_load_failure(Owner const&);
     void notify_worker_exception(Owner const&, Utf16String const& message, Utf16String const& filename, u32 lineno, u32 colno);
@@ -97,6 +103,11 @@ private:
     Web::HTML::WorkerAgentId m_next_agent_id { 0 };
     HashMap<Web::HTML::WorkerAgentId, WorkerAgent> m_agents;
     HashMap<SharedWorkerKey, Web::HTML::WorkerAgentId> m_shared_workers;
+
+    // A dedicated worker process that has already been launched, connected to the helper services, and has prepared
+    // its JS realm, waiting to be assigned an agent. It has an agent ID of 0 until then.
+    RefPtr<WebWorkerClient> m_spare_dedicated_worker_process;
+    bool m_has_queued_task_to_launch_spare_dedicated_worker_process { false };
 };
 
 }
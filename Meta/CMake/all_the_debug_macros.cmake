@@ -12,6 +12,7 @@ set(CSS_TOKENIZER_DEBUG ON)
 set(CSS_TRANSITIONS_DEBUG ON)
 set(CURL_DEBUG ON)
 set(DEVTOOLS_DEBUG ON)
+set(DISPLAY_LIST_DEBUG ON)
 set(DNS_DEBUG ON)
 set(EDITOR_DEBUG ON)
 set(FILE_WATCHER_DEBUG ON)
@@ -82,6 +83,8 @@ set(WEB_WORKER_DEBUG ON)
 set(WEBP_DEBUG ON)
 set(XML_PARSER_DEBUG ON)
 
+# Performance-only: changes how the asm interpreter dispatches, which would skew the all-debug build
+# set(JS_BYTECODE_STATISTICS_DEBUG ON)
 # False positive: ANDROID_LOG_DEBUG is a log level, not a debug flag
 # set(ANDROID_LOG_DEBUG ON)
 # Third-party: skia vcpkg port overlay
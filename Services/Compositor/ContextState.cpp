@@ -4,7 +4,9 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Debug.h>
 #include <AK/Math.h>
+#include <AK/NumericLimits.h>
 #include <AK/StdLibExtras.h>
 #include <Compositor/CompositorState.h>
 #include <Compositor/ContextState.h>
@@ -13,6 +15,7 @@
 #include <LibGfx/PaintingSurface.h>
 #include <LibGfx/SkiaUtils.h>
 #include <LibWeb/Page/InputEvent.h>
+#include <LibWeb/Painting/DisplayListDamage.h>
 #include <LibWeb/Painting/DisplayListPlayerSkia.h>
 #include <core/SkCanvas.h>
 #include <core/SkImage.h>
@@ -81,6 +84,82 @@ static void clamp_visual_viewport_transform_to_viewport(Web::Painting::Transform
     transform.matrix[1, 3] = clamp(transform.matrix[1, 3], min_y, 0.0f);
 }
 
+// Everything painted at a visual context that descends from the viewport's scroll node moves with the viewport's scroll
+// offset and nothing else, so it can be rasterized once in content coordinates and reused at any scroll offset.
+static bool display_list_scrolls_with_viewport(
+    Web::Painting::DisplayList const& display_list,
+    Web::Painting::AccumulatedVisualContextTree const& visual_context_tree,
+    Web::Painting::VisualContextIndex viewport_scroll_node_index,
+    Gfx::IntSize viewport_size)
+{
+    auto nodes = visual_context_tree.nodes();
+    if (viewport_scroll_node_index.value() >= nodes.size())
+        return false;
+    auto const& viewport_scroll_node = nodes[viewport_scroll_node_index.value()];
+    if (!viewport_scroll_node.data.has<Web::Painting::ScrollData>() || viewport_scroll_node.parent_index != Web::Painting::VISUAL_VIEWPORT_NODE_INDEX)
+        return false;
+    if (!visual_viewport_transform(visual_context_tree).matrix.is_identity())
+        return false;
+
+    Vector<bool> scrolls_with_viewport;
+    scrolls_with_viewport.resize(nodes.size());
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        auto const& node = nodes[i];
+        // NB: Fixed backgrounds, anchor-positioned boxes and sticky boxes shift relative to the content as the
+        //     viewport scrolls, so they would be left behind in the tiles.
+        if (node.data.has<Web::Painting::ScrollCompensation>() || node.data.has<Web::Painting::AnchorScrollShift>())
+            return false;
+        if (auto const* scroll_data = node.data.get_pointer<Web::Painting::ScrollData>(); scroll_data && scroll_data->is_sticky)
+            return false;
+        if (i == viewport_scroll_node_index.value())
+            scrolls_with_viewport[i] = true;
+        else if (i != Web::Painting::VISUAL_VIEWPORT_NODE_INDEX.value())
+            scrolls_with_viewport[i] = scrolls_with_viewport[node.parent_index.value()];
+    }
+
+    Gfx::IntRect viewport_rect { {}, viewport_size };
+    Gfx::IntRect tile_rect { 0, 0, TileCache::tile_size, TileCache::tile_size };
+    bool scrolls = true;
+    display_list.for_each_command_header([&](Web::Painting::DisplayListCommandHeader const& header, ReadonlyBytes payload) {
+        if (!scrolls)
+            return;
+        switch (header.type) {
+        // NB: Canvases, videos and composited contexts change without the display list changing, which would leave
+        //     stale pixels in the tiles they are in.
+        case Web::Painting::DisplayListCommandType::DrawCompositedContext:
+        case Web::Painting::DisplayListCommandType::DrawCanvas:
+        case Web::Painting::DisplayListCommandType::DrawVideoFrame:
+            scrolls = false;
+            return;
+        case Web::Painting::DisplayListCommandType::PaintScrollBar:
+            if (Web::Painting::read_display_list_command_payload<Web::Painting::PaintScrollBar>(payload).scroll_node_index == viewport_scroll_node_index) {
+                scrolls = false;
+                return;
+            }
+            break;
+        case Web::Painting::DisplayListCommandType::Save:
+        case Web::Painting::DisplayListCommandType::Restore:
+            return;
+        default:
+            break;
+        }
+        if (Web::Painting::display_list_command_is_compositor_metadata(header.type))
+            return;
+        if (header.context_index.value() < scrolls_with_viewport.size() && scrolls_with_viewport[header.context_index.value()])
+            return;
+        // NB: A fill that covers the whole viewport from outside the scrolled content, such as the canvas background,
+        //     looks the same at every scroll offset.
+        if (header.type == Web::Painting::DisplayListCommandType::FillRect
+            && header.context_index == Web::Painting::VISUAL_VIEWPORT_NODE_INDEX
+            && header.has_bounding_rect
+            && header.bounding_rect.contains(viewport_rect)
+            && header.bounding_rect.contains(tile_rect))
+            return;
+        scrolls = false;
+    });
+    return scrolls;
+}
+
 ContextState::ContextState(Optional<u64> page_id, CompositorStateWebContentClient& web_content_client, Web::Painting::CanvasSurfaceRegistry const& canvas_surface_registry, bool async_scrolling_enabled)
     : m_web_content_client(web_content_client)
     , m_canvas_surface_registry(canvas_surface_registry)
@@ -116,6 +195,7 @@ void ContextState::stop_presenting_to_client()
 {
     auto was_presenting_to_client = m_presents_to_client;
     m_presents_to_client = false;
+    drop_tile_cache();
     did_stop_presenting_to_client_if_needed(was_presenting_to_client, m_presents_to_client);
 }
 
@@ -137,8 +217,12 @@ void ContextState::apply_display_list_resource_transaction(Web::Painting::Displa
 
 void ContextState::update_image_frame_resources(Vector<Web::Painting::DisplayListImageFrameResource> image_frames)
 {
-    for (auto& frame : image_frames)
+    HashTable<Web::Painting::ImageFrameResourceId> updated_image_frame_ids;
+    for (auto& frame : image_frames) {
+        updated_image_frame_ids.set(frame.id);
         m_display_list_resource_storage.set_image_frame(frame.id, move(frame.frame));
+    }
+    invalidate_tiles_for_image_frames(updated_image_frame_ids);
 }
 
 void ContextState::install_display_list_update(
@@ -150,6 +234,7 @@ void ContextState::install_display_list_update(
     m_display_list = move(display_list);
     m_visual_context_tree = move(visual_context_tree);
     m_visual_context_tree_for_compositing.clear();
+    ++m_display_list_generation;
     m_scroll_state_snapshot = move(scroll_state_snapshot);
     if (m_async_visual_viewport_transform.has_value() && visual_viewport_transforms_match(visual_viewport_transform(*m_visual_context_tree), *m_async_visual_viewport_transform))
         m_async_visual_viewport_transform.clear();
@@ -195,6 +280,7 @@ void ContextState::update_visual_context_tree(Web::Painting::AccumulatedVisualCo
     }
     m_visual_context_tree = move(visual_context_tree);
     m_visual_context_tree_for_compositing.clear();
+    ++m_display_list_generation;
     if (m_async_visual_viewport_transform.has_value() && visual_viewport_transforms_match(visual_viewport_transform(*m_visual_context_tree), *m_async_visual_viewport_transform))
         m_async_visual_viewport_transform.clear();
 
@@ -626,6 +712,7 @@ Optional<BackingStoreManager::Publication> ContextState::resize_backing_stores_i
 void ContextState::invalidate_backing_stores()
 {
     m_backing_store_manager.invalidate();
+    drop_tile_cache();
 }
 
 bool ContextState::set_display_metadata(Optional<u64> display_id, double refresh_rate)
@@ -981,6 +1068,9 @@ Web::Painting::AccumulatedVisualContextTree const& ContextState::visual_context_
 void ContextState::paint_current_display_list(Web::Painting::DisplayListPlayerSkia& display_list_player, Gfx::PaintingSurface& surface, CompositedContextResolver const* composited_context_resolver, Optional<Gfx::IntRect> damage_rect)
 {
     VERIFY(m_display_list);
+    if (damage_rect.has_value() && !damage_rect->is_empty() && paint_from_tile_cache(display_list_player, surface, composited_context_resolver, *damage_rect))
+        return;
+
     auto surface_clear_color = Gfx::to_skia_color(m_display_list->surface_clear_color().value_or(Gfx::Color::Transparent));
     auto paint_display_list = [&](Gfx::PaintingSurface& target_surface) {
         display_list_player.execute(
@@ -1030,4 +1120,173 @@ void ContextState::paint_current_display_list(Web::Painting::DisplayListPlayerSk
     canvas.restoreToCount(save_count);
 }
 
+Optional<Web::Painting::VisualContextIndex> ContextState::tileable_viewport_scroll_node_index() const
+{
+    if (!m_async_scrolling_enabled || !m_has_async_scrolling_state || m_async_visual_viewport_transform.has_value())
+        return {};
+    if (m_viewport_size.width() < TileCache::tile_size || m_viewport_size.height() < TileCache::tile_size)
+        return {};
+    auto viewport_node_id = m_async_scroll_tree.viewport_scroll_node_id();
+    if (!viewport_node_id.has_value())
+        return {};
+
+    if (!m_tile_cache_eligibility.has_value()
+        || m_tile_cache_eligibility->display_list_generation != m_display_list_generation
+        || m_tile_cache_eligibility->viewport_size != m_viewport_size
+        || m_tile_cache_eligibility->viewport_scroll_node_index != viewport_node_id->scroll_node_index) {
+        auto scrolls_with_viewport = display_list_scrolls_with_viewport(*m_display_list, current_visual_context_tree(), viewport_node_id->scroll_node_index, m_viewport_size);
+        m_tile_cache_eligibility = TileCacheEligibility {
+            .display_list_generation = m_display_list_generation,
+            .viewport_size = m_viewport_size,
+            .viewport_scroll_node_index = viewport_node_id->scroll_node_index,
+            .is_tileable = scrolls_with_viewport,
+        };
+    }
+    if (!m_tile_cache_eligibility->is_tileable)
+        return {};
+    return viewport_node_id->scroll_node_index;
+}
+
+// OPTIMIZATION: While the content scrolls with the viewport, it is painted from tiles rasterized in content coordinates.
+//               A scrolled frame then only rasterizes the tiles that scrolled into view for the first time, rather than
+//               replaying the whole display list.
+bool ContextState::paint_from_tile_cache(Web::Painting::DisplayListPlayerSkia& display_list_player, Gfx::PaintingSurface& surface, CompositedContextResolver const* composited_context_resolver, Gfx::IntRect damage_rect)
+{
+    auto viewport_scroll_node_index = tileable_viewport_scroll_node_index();
+    if (!viewport_scroll_node_index.has_value()) {
+        drop_tile_cache();
+        return false;
+    }
+
+    // NB: Tiles are drawn at whole device pixels, so a fractional scroll offset would shift the content relative to
+    //     where the display list player puts it. Such frames are replayed normally, and the tiles are kept for later.
+    auto device_offset = m_scroll_state_snapshot.device_offset_for_index(*viewport_scroll_node_index);
+    if (device_offset.to_type<int>().to_type<float>() != device_offset)
+        return false;
+
+    auto scroll_offset = -device_offset.to_type<int>();
+    auto tile_scroll_state = m_scroll_state_snapshot;
+    tile_scroll_state.set_device_offset_for_index(*viewport_scroll_node_index, {});
+    invalidate_tiles_changed_since_rasterization(*viewport_scroll_node_index, tile_scroll_state);
+
+    auto surface_clear_color = Gfx::to_skia_color(m_display_list->surface_clear_color().value_or(Gfx::Color::Transparent));
+    auto& canvas = surface.canvas();
+    auto save_count = canvas.save();
+    canvas.clipIRect(SkIRect::MakeXYWH(damage_rect.x(), damage_rect.y(), damage_rect.width(), damage_rect.height()));
+    auto statistics = m_tile_cache.composite(surface, scroll_offset, damage_rect, [&](Gfx::PaintingSurface& content_surface, Gfx::IntRect content_rect) {
+        auto scroll_state = tile_scroll_state;
+        scroll_state.set_device_offset_for_index(*viewport_scroll_node_index, -content_rect.location().to_type<float>());
+        content_surface.canvas().clear(surface_clear_color);
+        display_list_player.execute(
+            *m_display_list,
+            current_visual_context_tree(),
+            m_display_list_resource_storage,
+            scroll_state,
+            content_surface,
+            &m_canvas_surface_registry,
+            composited_context_resolver);
+    });
+    m_viewport_scrollbar_controller.paint(surface, display_list_player, m_scroll_state_snapshot);
+    canvas.restoreToCount(save_count);
+
+    dbgln_if(COMPOSITOR_DEBUG, "[Compositor] Composited {} tiles ({} rasterized, {} evicted), {} tiles cached in {} KiB",
+        statistics.composited_tiles, statistics.rasterized_tiles, statistics.evicted_tiles,
+        m_tile_cache.tile_count(), m_tile_cache.memory_usage() / KiB);
+    return true;
+}
+
+void ContextState::invalidate_tiles_changed_since_rasterization(Web::Painting::VisualContextIndex viewport_scroll_node_index, Web::Painting::ScrollStateSnapshot const& tile_scroll_state)
+{
+    auto surface_clear_color = m_display_list->surface_clear_color().value_or(Gfx::Color::Transparent);
+    if (m_tile_cache_source.has_value()) {
+        auto const& source = *m_tile_cache_source;
+        if (source.viewport_scroll_node_index != viewport_scroll_node_index || source.surface_clear_color != surface_clear_color) {
+            m_tile_cache.invalidate_all();
+        } else if (source.display_list_generation != m_display_list_generation || source.scroll_state.device_offsets() != tile_scroll_state.device_offsets()) {
+            // NB: Neither scroll state includes the viewport's own scroll offset, so the damage comes out in content
+            //     coordinates, and the "viewport" it is clipped to has to cover all of the content.
+            Gfx::IntRect all_content_rect { 0, 0, NumericLimits<int>::max(), NumericLimits<int>::max() };
+            auto damage_rect = Web::Painting::compute_display_list_damage(
+                source.display_list->command_bytes(),
+                source.visual_context_tree,
+                source.scroll_state,
+                m_display_list->command_bytes(),
+                current_visual_context_tree(),
+                tile_scroll_state,
+                all_content_rect);
+            if (damage_rect.has_value())
+                m_tile_cache.invalidate(*damage_rect);
+            else
+                m_tile_cache.invalidate_all();
+        } else {
+            return;
+        }
+    }
+
+    m_tile_cache_source = TileCacheSource {
+        .display_list = m_display_list,
+        .visual_context_tree = current_visual_context_tree(),
+        .scroll_state = tile_scroll_state,
+        .display_list_generation = m_display_list_generation,
+        .viewport_scroll_node_index = viewport_scroll_node_index,
+        .surface_clear_color = surface_clear_color,
+    };
+}
+
+void ContextState::invalidate_tiles_for_image_frames(HashTable<Web::Painting::ImageFrameResourceId> const& image_frame_ids)
+{
+    if (!m_tile_cache_source.has_value() || image_frame_ids.is_empty())
+        return;
+
+    auto const& source = *m_tile_cache_source;
+    // NB: Frames drawn by mask display lists are not tracked back to the rects they affect.
+    if (!source.display_list->mask_display_lists().is_empty()) {
+        m_tile_cache.invalidate_all();
+        return;
+    }
+
+    auto invalidate_command = [&](Web::Painting::DisplayListCommandHeader const& header) {
+        if (!header.has_bounding_rect) {
+            m_tile_cache.invalidate_all();
+            return;
+        }
+        auto content_rect = source.visual_context_tree.transform_rect_to_viewport(
+            header.context_index,
+            header.bounding_rect.to_type<float>(),
+            source.scroll_state,
+            Web::Painting::AccumulatedVisualContextTree::IncludeVisualViewportTransform::No);
+        m_tile_cache.invalidate(Gfx::enclosing_int_rect(content_rect).inflated(1, 1, 1, 1));
+    };
+
+    source.display_list->for_each_command_header([&](Web::Painting::DisplayListCommandHeader const& header, ReadonlyBytes payload) {
+        switch (header.type) {
+        case Web::Painting::DisplayListCommandType::DrawScaledDecodedImageFrame:
+            if (image_frame_ids.contains(Web::Painting::read_display_list_command_payload<Web::Painting::DrawScaledDecodedImageFrame>(payload).frame_id))
+                invalidate_command(header);
+            break;
+        case Web::Painting::DisplayListCommandType::DrawRepeatedDecodedImageFrame:
+            if (image_frame_ids.contains(Web::Painting::read_display_list_command_payload<Web::Painting::DrawRepeatedDecodedImageFrame>(payload).frame_id))
+                invalidate_command(header);
+            break;
+        case Web::Painting::DisplayListCommandType::DrawTiledDecodedImageFrame:
+            if (image_frame_ids.contains(Web::Painting::read_display_list_command_payload<Web::Painting::DrawTiledDecodedImageFrame>(payload).frame_id))
+                invalidate_command(header);
+            break;
+        // NB: Nested display lists may draw any of the frames, so they are invalidated on every frame update.
+        case Web::Painting::DisplayListCommandType::DrawRepeatedDisplayList:
+        case Web::Painting::DisplayListCommandType::PaintNestedDisplayList:
+            invalidate_command(header);
+            break;
+        default:
+            break;
+        }
+    });
+}
+
+void ContextState::drop_tile_cache()
+{
+    m_tile_cache.invalidate_all();
+    m_tile_cache_source.clear();
+}
+
 }
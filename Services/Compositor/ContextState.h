@@ -7,12 +7,14 @@
 #pragma once
 
 #include <AK/Function.h>
+#include <AK/HashTable.h>
 #include <AK/Noncopyable.h>
 #include <AK/NonnullRefPtr.h>
 #include <AK/Optional.h>
 #include <AK/RefPtr.h>
 #include <AK/Vector.h>
 #include <Compositor/BackingStoreManager.h>
+#include <Compositor/TileCache.h>
 #include <Compositor/ViewportScrollbarController.h>
 #include <LibCore/Forward.h>
 #include <LibGfx/PaintingSurface.h>
@@ -164,6 +166,24 @@ private:
         Gfx::FloatPoint consumed_delta;
     };
 
+    // What the cached tiles were rasterized from. The scroll state has the viewport's own scroll offset left out, so
+    // that scrolling the viewport never invalidates a tile.
+    struct TileCacheSource {
+        RefPtr<Web::Painting::DisplayList const> display_list;
+        Web::Painting::AccumulatedVisualContextTree visual_context_tree;
+        Web::Painting::ScrollStateSnapshot scroll_state;
+        u64 display_list_generation { 0 };
+        Web::Painting::VisualContextIndex viewport_scroll_node_index;
+        Gfx::Color surface_clear_color;
+    };
+
+    struct TileCacheEligibility {
+        u64 display_list_generation { 0 };
+        Gfx::IntSize viewport_size;
+        Web::Painting::VisualContextIndex viewport_scroll_node_index;
+        bool is_tileable { false };
+    };
+
     void stop_backing_store_shrink_timer();
     Web::Painting::AccumulatedVisualContextTree const& current_visual_context_tree() const;
     Optional<Gfx::FloatPoint> viewport_scroll_offset_from(Vector<Web::Compositor::AsyncScrollOffset> const&) const;
@@ -178,6 +198,11 @@ private:
     bool can_render_frame() const;
     Web::Painting::AccumulatedVisualContextTree const& visual_context_tree_for_compositing() const;
     void paint_current_display_list(Web::Painting::DisplayListPlayerSkia&, Gfx::PaintingSurface&, CompositedContextResolver const*, Optional<Gfx::IntRect> damage_rect = {});
+    Optional<Web::Painting::VisualContextIndex> tileable_viewport_scroll_node_index() const;
+    bool paint_from_tile_cache(Web::Painting::DisplayListPlayerSkia&, Gfx::PaintingSurface&, CompositedContextResolver const*, Gfx::IntRect damage_rect);
+    void invalidate_tiles_changed_since_rasterization(Web::Painting::VisualContextIndex viewport_scroll_node_index, Web::Painting::ScrollStateSnapshot const&);
+    void invalidate_tiles_for_image_frames(HashTable<Web::Painting::ImageFrameResourceId> const&);
+    void drop_tile_cache();
 
     CompositorStateWebContentClient& m_web_content_client;
     Web::Painting::CanvasSurfaceRegistry const& m_canvas_surface_registry;
@@ -196,6 +221,12 @@ private:
     RefPtr<Gfx::PaintingSurface> m_latest_rendered_surface;
     RefPtr<Gfx::PaintingSurface> m_damage_surface;
 
+    // Bumped whenever the display list or its visual context tree is replaced.
+    u64 m_display_list_generation { 0 };
+    TileCache m_tile_cache;
+    Optional<TileCacheSource> m_tile_cache_source;
+    mutable Optional<TileCacheEligibility> m_tile_cache_eligibility;
+
     Web::Compositor::AsyncScrollTree m_async_scroll_tree;
     ViewportScrollbarController m_viewport_scrollbar_controller;
 
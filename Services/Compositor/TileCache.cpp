@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Vector.h>
+#include <Compositor/TileCache.h>
+#include <LibGfx/Bitmap.h>
+#include <core/SkCanvas.h>
+#include <core/SkImage.h>
+
+namespace Compositor {
+
+static int tile_coordinate_containing(int content_coordinate)
+{
+    if (content_coordinate >= 0)
+        return content_coordinate / TileCache::tile_size;
+    return -((-content_coordinate + TileCache::tile_size - 1) / TileCache::tile_size);
+}
+
+static SkRect to_skia_rect(Gfx::IntRect const& rect)
+{
+    return SkRect::MakeXYWH(rect.x(), rect.y(), rect.width(), rect.height());
+}
+
+TileCache::TileCache(size_t memory_budget)
+    : m_memory_budget(memory_budget)
+{
+}
+
+Gfx::IntRect TileCache::content_rect_for_tile(TileIndex index)
+{
+    return { index.column * tile_size, index.row * tile_size, tile_size, tile_size };
+}
+
+TileCache::Statistics TileCache::composite(Gfx::PaintingSurface& target, Gfx::IntPoint scroll_offset, Gfx::IntRect target_rect, RasterizeContent const& rasterize_content)
+{
+    ++m_frame;
+    Statistics statistics;
+    if (target_rect.is_empty())
+        return statistics;
+
+    auto content_rect = target_rect.translated(scroll_offset);
+    auto first_column = tile_coordinate_containing(content_rect.x());
+    auto last_column = tile_coordinate_containing(content_rect.x() + content_rect.width() - 1);
+    auto first_row = tile_coordinate_containing(content_rect.y());
+    auto last_row = tile_coordinate_containing(content_rect.y() + content_rect.height() - 1);
+
+    SkPaint paint;
+    paint.setBlendMode(SkBlendMode::kSrc);
+
+    // NB: Tiles that are already cached are marked as composited first, so that making room for the missing ones
+    //     never evicts a tile this frame needs.
+    Vector<TileIndex> missing_tiles;
+    Gfx::IntRect missing_content_rect;
+    for (auto row = first_row; row <= last_row; ++row) {
+        for (auto column = first_column; column <= last_column; ++column) {
+            TileIndex index { column, row };
+            if (auto it = m_tiles.find(index); it != m_tiles.end()) {
+                it->value.last_composited_frame = m_frame;
+            } else {
+                missing_tiles.append(index);
+                missing_content_rect.unite(content_rect_for_tile(index));
+            }
+        }
+    }
+
+    // OPTIMIZATION: Every rasterization replays the whole display list, so the missing tiles share a single one, which
+    //               is then split up into their surfaces.
+    if (!missing_tiles.is_empty()) {
+        auto& rasterization_surface = ensure_rasterization_surface(target, missing_content_rect.size());
+        auto& rasterization_canvas = rasterization_surface.canvas();
+        auto save_count = rasterization_canvas.save();
+        rasterization_canvas.clipIRect(SkIRect::MakeWH(missing_content_rect.width(), missing_content_rect.height()));
+        rasterize_content(rasterization_surface, missing_content_rect);
+        rasterization_canvas.restoreToCount(save_count);
+
+        auto rasterized_image = rasterization_surface.sk_image_snapshot<sk_sp<SkImage>>();
+        for (auto index : missing_tiles) {
+            auto surface = take_surface_for_new_tile(target, statistics);
+            surface->canvas().drawImageRect(
+                rasterized_image.get(),
+                to_skia_rect(content_rect_for_tile(index).translated(-missing_content_rect.location())),
+                SkRect::MakeWH(tile_size, tile_size),
+                SkSamplingOptions {},
+                &paint,
+                SkCanvas::kStrict_SrcRectConstraint);
+            ++statistics.rasterized_tiles;
+            m_tiles.set(index, Tile { move(surface), m_frame });
+        }
+    }
+
+    auto& canvas = target.canvas();
+    for (auto row = first_row; row <= last_row; ++row) {
+        for (auto column = first_column; column <= last_column; ++column) {
+            TileIndex index { column, row };
+            auto tile_content_rect = content_rect_for_tile(index);
+            auto const& tile = m_tiles.find(index)->value;
+
+            auto visible_content_rect = tile_content_rect.intersected(content_rect);
+            auto image = tile.surface->sk_image_snapshot<sk_sp<SkImage>>();
+            canvas.drawImageRect(
+                image.get(),
+                to_skia_rect(visible_content_rect.translated(-tile_content_rect.location())),
+                to_skia_rect(visible_content_rect.translated(-scroll_offset)),
+                SkSamplingOptions {},
+                &paint,
+                SkCanvas::kStrict_SrcRectConstraint);
+            ++statistics.composited_tiles;
+        }
+    }
+
+    evict_tiles_over_budget(statistics);
+    return statistics;
+}
+
+void TileCache::invalidate(Gfx::IntRect content_rect)
+{
+    if (content_rect.is_empty())
+        return;
+    m_tiles.remove_all_matching([&](TileIndex const& index, Tile const&) {
+        return content_rect_for_tile(index).intersects(content_rect);
+    });
+}
+
+void TileCache::invalidate_all()
+{
+    m_tiles.clear();
+    m_rasterization_surface = nullptr;
+}
+
+size_t TileCache::memory_usage() const
+{
+    auto usage = m_tiles.size() * tile_byte_size();
+    if (m_rasterization_surface) {
+        auto size = m_rasterization_surface->size();
+        usage += static_cast<size_t>(size.width()) * size.height() * 4;
+    }
+    return usage;
+}
+
+Optional<TileIndex> TileCache::least_recently_composited_tile() const
+{
+    Optional<TileIndex> least_recently_composited;
+    u64 oldest_frame = m_frame;
+    for (auto const& [index, tile] : m_tiles) {
+        if (tile.last_composited_frame < oldest_frame) {
+            oldest_frame = tile.last_composited_frame;
+            least_recently_composited = index;
+        }
+    }
+    return least_recently_composited;
+}
+
+NonnullRefPtr<Gfx::PaintingSurface> TileCache::take_surface_for_new_tile(Gfx::PaintingSurface const& target, Statistics& statistics)
+{
+    // NB: Once the budget is reached, the surface of the least recently composited tile is handed over to the new tile
+    //     instead of allocating another one.
+    if (memory_usage() + tile_byte_size() > m_memory_budget) {
+        auto least_recently_composited = least_recently_composited_tile();
+        if (least_recently_composited.has_value()) {
+            auto tile = m_tiles.take(*least_recently_composited).release_value();
+            ++statistics.evicted_tiles;
+            if (tile.surface->skia_backend_context() == target.skia_backend_context())
+                return move(tile.surface);
+        }
+    }
+
+    return Gfx::PaintingSurface::create_with_size({ tile_size, tile_size }, Gfx::BitmapFormat::BGRA8888, Gfx::AlphaType::Premultiplied, target.skia_backend_context());
+}
+
+Gfx::PaintingSurface& TileCache::ensure_rasterization_surface(Gfx::PaintingSurface const& target, Gfx::IntSize size)
+{
+    // NB: The surface only grows, so that strips of different sizes scrolling into view do not each allocate a new one.
+    if (m_rasterization_surface && m_rasterization_surface->skia_backend_context() == target.skia_backend_context()) {
+        auto current_size = m_rasterization_surface->size();
+        if (current_size.width() >= size.width() && current_size.height() >= size.height())
+            return *m_rasterization_surface;
+        size = { max(size.width(), current_size.width()), max(size.height(), current_size.height()) };
+    }
+
+    m_rasterization_surface = Gfx::PaintingSurface::create_with_size(size, Gfx::BitmapFormat::BGRA8888, Gfx::AlphaType::Premultiplied, target.skia_backend_context());
+    return *m_rasterization_surface;
+}
+
+void TileCache::evict_tiles_over_budget(Statistics& statistics)
+{
+    // NB: Allocating the rasterization surface again is cheaper than rasterizing evicted tiles again, so it goes first.
+    if (memory_usage() > m_memory_budget)
+        m_rasterization_surface = nullptr;
+
+    while (memory_usage() > m_memory_budget) {
+        auto least_recently_composited = least_recently_composited_tile();
+        // NB: Tiles that are all needed for the current frame stay, even if they do not fit the budget on their own.
+        if (!least_recently_composited.has_value())
+            return;
+        m_tiles.remove(*least_recently_composited);
+        ++statistics.evicted_tiles;
+    }
+}
+
+}
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Function.h>
+#include <AK/HashFunctions.h>
+#include <AK/HashMap.h>
+#include <AK/NonnullRefPtr.h>
+#include <AK/RefPtr.h>
+#include <AK/Traits.h>
+#include <LibGfx/PaintingSurface.h>
+#include <LibGfx/Point.h>
+#include <LibGfx/Rect.h>
+
+namespace Compositor {
+
+struct TileIndex {
+    int column { 0 };
+    int row { 0 };
+
+    bool operator==(TileIndex const&) const = default;
+};
+
+}
+
+namespace AK {
+
+template<>
+struct Traits<Compositor::TileIndex> : public DefaultTraits<Compositor::TileIndex> {
+    static unsigned hash(Compositor::TileIndex const& index) { return pair_int_hash(index.column, index.row); }
+};
+
+}
+
+namespace Compositor {
+
+// Rasterized content of a scrolling viewport, kept in fixed-size tiles laid out in content coordinates. Scrolling
+// only changes where the tiles are drawn, so a scrolled frame is composited from tiles that are already there and
+// only the strip of content that scrolled into view for the first time needs to be rasterized.
+//
+// Tiles stay valid until the content they cover is invalidated. The cache is bounded by a memory budget, which also
+// covers the surface missing tiles are rasterized into. Once the budget is exceeded, that surface is released first.
+// Then the tiles that were least recently composited are dropped, and their surfaces are reused for new tiles.
+class TileCache {
+public:
+    static constexpr int tile_size = 256;
+    static constexpr size_t default_memory_budget = 64 * MiB;
+
+    struct Statistics {
+        size_t composited_tiles { 0 };
+        size_t rasterized_tiles { 0 };
+        size_t evicted_tiles { 0 };
+    };
+
+    using RasterizeContent = Function<void(Gfx::PaintingSurface&, Gfx::IntRect content_rect)>;
+
+    explicit TileCache(size_t memory_budget = default_memory_budget);
+
+    // Draws the content at target_rect.translated(scroll_offset) into target_rect of the target surface, rasterizing
+    // the tiles it covers that are not cached yet. Those tiles are rasterized together, with a single call that covers
+    // the union of their content rects. The surface handed to the callback is clipped to that union, and maps its
+    // origin to its top-left corner.
+    Statistics composite(Gfx::PaintingSurface& target, Gfx::IntPoint scroll_offset, Gfx::IntRect target_rect, RasterizeContent const&);
+
+    void invalidate(Gfx::IntRect content_rect);
+    void invalidate_all();
+
+    size_t tile_count() const { return m_tiles.size(); }
+    size_t memory_usage() const;
+    size_t memory_budget() const { return m_memory_budget; }
+    bool contains_tile(TileIndex index) const { return m_tiles.contains(index); }
+
+    static Gfx::IntRect content_rect_for_tile(TileIndex);
+
+private:
+    struct Tile {
+        NonnullRefPtr<Gfx::PaintingSurface> surface;
+        u64 last_composited_frame { 0 };
+    };
+
+    static constexpr size_t tile_byte_size() { return static_cast<size_t>(tile_size) * tile_size * 4; }
+
+    // Tiles composited in the current frame are never returned.
+    Optional<TileIndex> least_recently_composited_tile() const;
+    NonnullRefPtr<Gfx::PaintingSurface> take_surface_for_new_tile(Gfx::PaintingSurface const& target, Statistics&);
+    Gfx::PaintingSurface& ensure_rasterization_surface(Gfx::PaintingSurface const& target, Gfx::IntSize);
+    void evict_tiles_over_budget(Statistics&);
+
+    HashMap<TileIndex, Tile> m_tiles;
+    RefPtr<Gfx::PaintingSurface> m_rasterization_surface;
+    size_t m_memory_budget { default_memory_budget };
+    u64 m_frame { 0 };
+};
+
+}
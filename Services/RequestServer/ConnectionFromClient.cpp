@@ -81,11 +81,12 @@ static auto time_curl_call(StringView label, F&& f)
 static constexpr i64 BURST_WINDOW_MS = 100;
 static constexpr u64 BURST_REPORT_THRESHOLD = 5;
 
-ConnectionFromClient::ConnectionFromClient(NonnullOwnPtr<IPC::Transport> transport, IsPrimaryConnection is_primary_connection, IsPrivate is_private, ConnectionMap& connections, Optional<HTTP::DiskCache&> disk_cache, ByteString alt_svc_cache_path)
+ConnectionFromClient::ConnectionFromClient(NonnullOwnPtr<IPC::Transport> transport, IsPrimaryConnection is_primary_connection, IsPrivate is_private, ConnectionMap& connections, Optional<HTTP::DiskCache&> disk_cache, Optional<ConnectionPredictor&> connection_predictor, ByteString alt_svc_cache_path)
     : IPC::ConnectionFromClient<RequestClientEndpoint, RequestServerEndpoint>(*this, move(transport), s_client_ids.allocate())
     , m_is_private(is_private)
     , m_connections(connections)
     , m_disk_cache(disk_cache)
+    , m_connection_predictor(connection_predictor)
     , m_curl_multi(curl_multi_init())
     , m_resolver(Resolver::default_resolver())
 {
@@ -123,6 +124,7 @@ ConnectionFromClient::~ConnectionFromClient()
 {
     m_active_requests.clear();
     m_active_revalidation_requests.clear();
+    m_active_preconnect_requests.clear();
     m_pending_websockets.clear();
     m_websockets.clear();
 
@@ -146,6 +148,8 @@ void ConnectionFromClient::request_complete(Badge<Request>, Request const& reque
         if (auto self = weak_self.strong_ref()) {
             if (type == RequestType::BackgroundRevalidation)
                 self->m_active_revalidation_requests.remove(request_id);
+            else if (type == RequestType::Preconnect)
+                self->m_active_preconnect_requests.remove(request_id);
             else
                 self->m_active_requests.remove(request_id);
         }
@@ -208,9 +212,10 @@ ErrorOr<IPC::TransportHandle> ConnectionFromClient::create_client_socket(IsPriva
     auto paired = TRY(IPC::Transport::create_paired());
     auto handle = move(paired.remote_handle);
     auto disk_cache = is_private == IsPrivate::Yes ? Optional<HTTP::DiskCache&> {} : m_disk_cache;
+    auto connection_predictor = is_private == IsPrivate::Yes ? Optional<ConnectionPredictor&> {} : m_connection_predictor;
 
     // Note: A ref is stored in the m_connections map
-    auto client = adopt_ref(*new ConnectionFromClient(move(paired.local), IsPrimaryConnection::No, is_private, m_connections, disk_cache, m_alt_svc_cache_path.value_or({})));
+    auto client = adopt_ref(*new ConnectionFromClient(move(paired.local), IsPrimaryConnection::No, is_private, m_connections, disk_cache, connection_predictor, m_alt_svc_cache_path.value_or({})));
 
     return handle;
 }
@@ -289,10 +294,39 @@ void ConnectionFromClient::start_request(u64 request_id, ByteString method, URL:
         }
     }
 
-    auto request = Request::fetch(request_id, m_disk_cache, cache_mode, *this, m_curl_multi, m_resolver, move(url), move(method), HTTP::HeaderList::create(move(request_headers)), move(request_body), include_credentials, m_alt_svc_cache_path, proxy_data, keep_alive_for_transfer);
+    auto headers = HTTP::HeaderList::create(move(request_headers));
+
+    if (m_connection_predictor.has_value())
+        predict_connections_for_request(url, method, *headers);
+
+    auto request = Request::fetch(request_id, m_disk_cache, cache_mode, *this, m_curl_multi, m_resolver, move(url), move(method), move(headers), move(request_body), include_credentials, m_alt_svc_cache_path, proxy_data, keep_alive_for_transfer);
     m_active_requests.set(request_id, move(request));
 }
 
+void ConnectionFromClient::predict_connections_for_request(URL::URL const& url, StringView method, HTTP::HeaderList const& request_headers)
+{
+    // NB: Each WebContent process has its own connection, so every request issued after a top-level navigation is
+    //     attributed to that navigation's site until the next one begins.
+    if (ConnectionPredictor::is_navigation_request(method, request_headers)) {
+        m_predicted_navigation = m_connection_predictor->did_start_navigation(url, [this](URL::URL origin) {
+            start_preconnect_request(move(origin));
+        });
+        return;
+    }
+
+    if (m_predicted_navigation.has_value())
+        m_connection_predictor->did_start_subresource_request(*m_predicted_navigation, url);
+}
+
+void ConnectionFromClient::start_preconnect_request(URL::URL url)
+{
+    auto request_id = m_next_preconnect_request_id++;
+    dbgln_if(REQUESTSERVER_DEBUG, "RequestServer: start_preconnect_request({}, {})", request_id, url);
+
+    auto request = Request::preconnect(request_id, *this, m_curl_multi, m_resolver, move(url));
+    m_active_preconnect_requests.set(request_id, move(request));
+}
+
 void ConnectionFromClient::adopt_request(int source_client_id, u64 source_request_id, u64 target_request_id)
 {
     auto source_connection = m_connections.get(source_client_id);
@@ -487,6 +521,7 @@ void ConnectionFromClient::retrieved_http_cookie(int client_id, u64 request_id,
             case RequestType::BackgroundRevalidation:
                 return (*connection)->m_active_revalidation_requests.get(request_id);
             case RequestType::Connect:
+            case RequestType::Preconnect:
                 break;
             }
             VERIFY_NOT_REACHED();
@@ -511,6 +546,10 @@ void ConnectionFromClient::remove_cache_entries_accessed_since(UnixDateTime sinc
 {
     if (m_disk_cache.has_value())
         m_disk_cache->remove_entries_accessed_since(since);
+    if (m_connection_predictor.has_value())
+        m_connection_predictor->remove_sites_navigated_since(since);
+
+    m_resolver->remove_cache_entries_used_since(since);
 }
 
 Messages::RequestServer::StoreCacheAssociatedDataResponse ConnectionFromClient::store_cache_associated_data(URL::URL url, ByteString method, Vector<HTTP::Header> request_headers, Optional<u64> vary_key, HTTP::CacheEntryAssociatedData associated_data, Core::AnonymousBuffer data)
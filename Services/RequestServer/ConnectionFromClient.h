@@ -18,6 +18,7 @@
 #include <LibIPC/ConnectionFromClient.h>
 #include <LibRequests/WebSocket.h>
 #include <LibWebSocket/WebSocket.h>
+#include <RequestServer/ConnectionPredictor.h>
 #include <RequestServer/Forward.h>
 #include <RequestServer/IsPrivate.h>
 #include <RequestServer/RequestClientEndpoint.h>
@@ -49,7 +50,7 @@ public:
     void request_complete(Badge<Request>, Request const&);
 
 private:
-    ConnectionFromClient(NonnullOwnPtr<IPC::Transport>, IsPrimaryConnection, IsPrivate, ConnectionMap&, Optional<HTTP::DiskCache&>, ByteString alt_svc_cache_path);
+    ConnectionFromClient(NonnullOwnPtr<IPC::Transport>, IsPrimaryConnection, IsPrivate, ConnectionMap&, Optional<HTTP::DiskCache&>, Optional<ConnectionPredictor&>, ByteString alt_svc_cache_path);
 
     virtual Messages::RequestServer::InitTransportResponse init_transport(int peer_pid) override;
     virtual Messages::RequestServer::ConnectNewClientResponse connect_new_client(IsPrivate) override;
@@ -87,6 +88,9 @@ private:
     void check_active_requests();
     void fail_websocket(u64 websocket_id, Requests::WebSocket::Error);
 
+    void predict_connections_for_request(URL::URL const&, StringView method, HTTP::HeaderList const& request_headers);
+    void start_preconnect_request(URL::URL);
+
     ErrorOr<IPC::TransportHandle> create_client_socket(IsPrivate);
 
     IsPrivate m_is_private { IsPrivate::No };
@@ -94,10 +98,14 @@ private:
     ConnectionMap& m_connections;
     Optional<HTTP::DiskCache&> m_disk_cache;
 
+    Optional<ConnectionPredictor&> m_connection_predictor;
+    Optional<ConnectionPredictor::Navigation> m_predicted_navigation;
+
     void* m_curl_multi { nullptr };
 
     HashMap<u64, NonnullOwnPtr<Request>> m_active_requests;
     HashMap<u64, NonnullOwnPtr<Request>> m_active_revalidation_requests;
+    HashMap<u64, NonnullOwnPtr<Request>> m_active_preconnect_requests;
     HashTable<u64> m_pending_websockets;
     HashMap<u64, RefPtr<WebSocket::WebSocket>> m_websockets;
 
@@ -109,6 +117,7 @@ private:
     Optional<ByteString> m_alt_svc_cache_path;
 
     u64 m_next_revalidation_request_id { 0 };
+    u64 m_next_preconnect_request_id { 0 };
 
     Optional<MonotonicTime> m_burst_window_started_at;
     u64 m_requests_in_burst_window { 0 };
@@ -0,0 +1,318 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Debug.h>
+#include <AK/JsonObject.h>
+#include <AK/JsonValue.h>
+#include <AK/QuickSort.h>
+#include <LibCore/File.h>
+#include <LibCore/Timer.h>
+#include <LibFileSystem/FileSystem.h>
+#include <LibHTTP/HeaderList.h>
+#include <LibURL/Parser.h>
+#include <LibURL/Site.h>
+#include <LibURL/URL.h>
+#include <RequestServer/ConnectionPredictor.h>
+
+namespace RequestServer {
+
+static constexpr u32 CONNECTION_PREDICTOR_VERSION = 1;
+
+// Bounds on the persisted history. When full, the least recently navigated site and the least used origin of a site
+// are evicted.
+static constexpr size_t MAXIMUM_SITE_COUNT = 256;
+static constexpr size_t MAXIMUM_ORIGINS_PER_SITE = 32;
+
+// Once an origin's score reaches this value, every score of its site is halved. This lets origins a site has stopped
+// using fade out, rather than being preconnected forever on the strength of old navigations.
+static constexpr u32 MAXIMUM_ORIGIN_SCORE = 32;
+
+// The number of origins we will speculatively connect to for a single navigation.
+static constexpr size_t MAXIMUM_PRECONNECTS_PER_NAVIGATION = 6;
+
+static constexpr int SAVE_DELAY_MS = 10'000;
+
+static bool is_http_or_https(URL::URL const& url)
+{
+    return url.scheme().is_one_of("http"sv, "https"sv);
+}
+
+NonnullOwnPtr<ConnectionPredictor> ConnectionPredictor::create(LexicalPath path)
+{
+    auto predictor = adopt_own(*new ConnectionPredictor(move(path)));
+
+    if (auto result = predictor->load(); result.is_error()) {
+        dbgln("ConnectionPredictor: Unable to load connection history from '{}': {}", predictor->m_path, result.error());
+        predictor->m_sites.clear();
+    }
+
+    return predictor;
+}
+
+ConnectionPredictor::ConnectionPredictor(LexicalPath path)
+    : m_path(move(path))
+{
+    m_save_timer = Core::Timer::create_single_shot(SAVE_DELAY_MS, [this]() {
+        if (auto result = save(); result.is_error())
+            dbgln("ConnectionPredictor: Unable to save connection history to '{}': {}", m_path, result.error());
+    });
+}
+
+ConnectionPredictor::~ConnectionPredictor()
+{
+    m_save_timer->stop();
+
+    if (m_is_dirty) {
+        if (auto result = save(); result.is_error())
+            dbgln("ConnectionPredictor: Unable to save connection history to '{}': {}", m_path, result.error());
+    }
+
+    dbgln_if(REQUESTSERVER_DEBUG, "ConnectionPredictor: {} navigations, {} preconnects, {} hits, {} misses",
+        m_statistics.navigations, m_statistics.preconnects, m_statistics.hits, m_statistics.misses);
+}
+
+// We only learn from top-level document loads. Fetch metadata headers are only attached to requests for potentially
+// trustworthy URLs, so plain HTTP navigations are never predicted for.
+bool ConnectionPredictor::is_navigation_request(StringView method, HTTP::HeaderList const& request_headers)
+{
+    if (method != "GET"sv)
+        return false;
+
+    auto destination = request_headers.get("Sec-Fetch-Dest"sv);
+    auto mode = request_headers.get("Sec-Fetch-Mode"sv);
+
+    return destination.has_value() && *destination == "document"sv
+        && mode.has_value() && *mode == "navigate"sv;
+}
+
+Optional<ConnectionPredictor::Navigation> ConnectionPredictor::did_start_navigation(URL::URL const& url, Function<void(URL::URL)> const& preconnect)
+{
+    if (!is_http_or_https(url))
+        return {};
+
+    Navigation navigation {
+        .site = URL::Site::obtain(url.origin()).serialize(),
+        .document_origin = url.origin().serialize(),
+        .preconnected_origins = {},
+        .observed_origins = {},
+    };
+
+    ++m_statistics.navigations;
+
+    auto& site = ensure_site(navigation.site);
+    site.last_navigated_at = UnixDateTime::now();
+    schedule_save();
+
+    auto origins = site.origins;
+    quick_sort(origins, [](auto const& a, auto const& b) { return a.score > b.score; });
+
+    for (auto const& origin : origins) {
+        if (navigation.preconnected_origins.size() == MAXIMUM_PRECONNECTS_PER_NAVIGATION)
+            break;
+        if (origin.origin == navigation.document_origin)
+            continue;
+
+        auto origin_url = URL::Parser::basic_parse(origin.origin);
+        if (!origin_url.has_value() || !is_http_or_https(*origin_url))
+            continue;
+
+        navigation.preconnected_origins.set(origin.origin);
+        ++m_statistics.preconnects;
+
+        preconnect(origin_url.release_value());
+    }
+
+    dbgln_if(REQUESTSERVER_DEBUG, "ConnectionPredictor: Navigation to {} preconnecting {} of {} known origins",
+        navigation.site, navigation.preconnected_origins.size(), origins.size());
+
+    return navigation;
+}
+
+void ConnectionPredictor::did_start_subresource_request(Navigation& navigation, URL::URL const& url)
+{
+    if (!is_http_or_https(url))
+        return;
+
+    auto origin = url.origin().serialize();
+    if (origin == navigation.document_origin)
+        return;
+
+    // Only the first request to an origin during a navigation pays for the connection setup.
+    if (navigation.observed_origins.set(origin) != HashSetResult::InsertedNewEntry)
+        return;
+
+    if (navigation.preconnected_origins.contains(origin))
+        ++m_statistics.hits;
+    else
+        ++m_statistics.misses;
+
+    record_origin(navigation.site, origin);
+    schedule_save();
+}
+
+void ConnectionPredictor::remove_sites_navigated_since(UnixDateTime since)
+{
+    auto removed_any = m_sites.remove_all_matching([&](auto const&, auto const& history) {
+        return history.last_navigated_at >= since;
+    });
+
+    if (!removed_any && !m_is_dirty)
+        return;
+
+    // NB: Save right away, rather than leaving the removed sites on disk until the save timer fires.
+    m_save_timer->stop();
+
+    if (auto result = save(); result.is_error())
+        dbgln("ConnectionPredictor: Unable to save connection history to '{}': {}", m_path, result.error());
+}
+
+ConnectionPredictor::SiteHistory& ConnectionPredictor::ensure_site(String const& site)
+{
+    if (auto history = m_sites.find(site); history != m_sites.end())
+        return history->value;
+
+    if (m_sites.size() >= MAXIMUM_SITE_COUNT) {
+        auto oldest = m_sites.begin();
+
+        for (auto it = m_sites.begin(); it != m_sites.end(); ++it) {
+            if (it->value.last_navigated_at < oldest->value.last_navigated_at)
+                oldest = it;
+        }
+
+        m_sites.remove(oldest);
+    }
+
+    return m_sites.ensure(site, [] { return SiteHistory { .last_navigated_at = UnixDateTime::now(), .origins = {} }; });
+}
+
+void ConnectionPredictor::record_origin(String const& site, String const& origin)
+{
+    auto& history = ensure_site(site);
+
+    auto existing = history.origins.find_if([&](auto const& predicted_origin) { return predicted_origin.origin == origin; });
+
+    if (existing != history.origins.end()) {
+        if (++existing->score < MAXIMUM_ORIGIN_SCORE)
+            return;
+
+        for (auto& predicted_origin : history.origins)
+            predicted_origin.score /= 2;
+        history.origins.remove_all_matching([](auto const& predicted_origin) { return predicted_origin.score == 0; });
+
+        return;
+    }
+
+    if (history.origins.size() >= MAXIMUM_ORIGINS_PER_SITE) {
+        size_t least_used = 0;
+
+        for (size_t i = 1; i < history.origins.size(); ++i) {
+            if (history.origins[i].score < history.origins[least_used].score)
+                least_used = i;
+        }
+
+        history.origins.remove(least_used);
+    }
+
+    history.origins.append({ .origin = origin, .score = 1 });
+}
+
+ErrorOr<void> ConnectionPredictor::load()
+{
+    auto file = Core::File::open(m_path.string(), Core::File::OpenMode::Read);
+    if (file.is_error()) {
+        if (file.error().is_errno() && file.error().code() == ENOENT)
+            return {};
+        return file.release_error();
+    }
+
+    auto contents = TRY(file.value()->read_until_eof());
+    auto json = TRY(JsonValue::from_string(contents));
+
+    if (!json.is_object())
+        return Error::from_string_literal("Expected connection history to be a JSON object");
+
+    auto const& root = json.as_object();
+
+    // NB: The history is only a hint. If its format changed, just start learning again.
+    if (root.get_u32("version"sv) != CONNECTION_PREDICTOR_VERSION)
+        return {};
+
+    auto sites = root.get_object("sites"sv);
+    if (!sites.has_value())
+        return {};
+
+    sites->for_each_member([&](String const& site, JsonValue const& value) {
+        if (!value.is_object() || m_sites.size() >= MAXIMUM_SITE_COUNT)
+            return;
+
+        auto const& object = value.as_object();
+
+        SiteHistory history;
+        history.last_navigated_at = UnixDateTime::from_seconds_since_epoch(object.get_i64("last-navigated"sv).value_or(0));
+
+        if (auto origins = object.get_object("origins"sv); origins.has_value()) {
+            origins->for_each_member([&](String const& origin, JsonValue const& score) {
+                if (history.origins.size() >= MAXIMUM_ORIGINS_PER_SITE || !score.is_integer<u32>())
+                    return;
+                history.origins.append({ .origin = origin, .score = min(score.as_integer<u32>(), MAXIMUM_ORIGIN_SCORE) });
+            });
+        }
+
+        m_sites.set(site, move(history));
+    });
+
+    return {};
+}
+
+ErrorOr<void> ConnectionPredictor::save()
+{
+    JsonObject sites;
+
+    for (auto const& [site, history] : m_sites) {
+        JsonObject origins;
+        for (auto const& predicted_origin : history.origins)
+            origins.set(predicted_origin.origin, predicted_origin.score);
+
+        JsonObject object;
+        object.set("last-navigated"sv, history.last_navigated_at.seconds_since_epoch());
+        object.set("origins"sv, move(origins));
+
+        sites.set(site, move(object));
+    }
+
+    JsonObject root;
+    root.set("version"sv, CONNECTION_PREDICTOR_VERSION);
+    root.set("sites"sv, move(sites));
+
+    // The history is written to a temporary file that replaces the existing one, so it is never left partially written.
+    auto temporary_path = ByteString::formatted("{}.tmp", m_path.string());
+
+    auto result = [&]() -> ErrorOr<void> {
+        auto file = TRY(Core::File::open(temporary_path, Core::File::OpenMode::Write | Core::File::OpenMode::Truncate));
+        TRY(file->write_until_depleted(root.serialized()));
+        file->close();
+
+        return FileSystem::move_file(m_path.string(), temporary_path);
+    }();
+
+    if (result.is_error()) {
+        (void)FileSystem::remove(temporary_path, FileSystem::RecursionMode::Disallowed);
+        return result.release_error();
+    }
+
+    m_is_dirty = false;
+    return {};
+}
+
+void ConnectionPredictor::schedule_save()
+{
+    m_is_dirty = true;
+
+    if (!m_save_timer->is_active())
+        m_save_timer->start();
+}
+
+}
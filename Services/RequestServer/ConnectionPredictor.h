@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Function.h>
+#include <AK/HashMap.h>
+#include <AK/HashTable.h>
+#include <AK/LexicalPath.h>
+#include <AK/Noncopyable.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Optional.h>
+#include <AK/RefPtr.h>
+#include <AK/String.h>
+#include <AK/Time.h>
+#include <AK/Vector.h>
+#include <LibCore/Forward.h>
+#include <LibHTTP/Forward.h>
+#include <LibURL/Forward.h>
+
+namespace RequestServer {
+
+// Learns which origins a top-level site contacts for its subresources (CDNs, APIs, etc.), so that the next navigation
+// to that site may resolve and connect to those origins before the document asks for them. The history is persisted
+// alongside the disk cache.
+class ConnectionPredictor {
+    AK_MAKE_NONCOPYABLE(ConnectionPredictor);
+    AK_MAKE_NONMOVABLE(ConnectionPredictor);
+
+public:
+    static NonnullOwnPtr<ConnectionPredictor> create(LexicalPath path);
+    ~ConnectionPredictor();
+
+    // The origins contacted on behalf of a single top-level navigation.
+    struct Navigation {
+        String site;
+        String document_origin;
+        HashTable<String> preconnected_origins;
+        HashTable<String> observed_origins;
+    };
+
+    struct Statistics {
+        u64 navigations { 0 };
+        u64 preconnects { 0 };
+        u64 hits { 0 };
+        u64 misses { 0 };
+    };
+
+    static bool is_navigation_request(StringView method, HTTP::HeaderList const&);
+
+    Optional<Navigation> did_start_navigation(URL::URL const&, Function<void(URL::URL)> const& preconnect);
+    void did_start_subresource_request(Navigation&, URL::URL const&);
+
+    // Forgets the sites navigated to since the given time, along with the origins learned for them. This is done along
+    // with clearing the disk cache, as the history reveals which sites were visited.
+    void remove_sites_navigated_since(UnixDateTime since);
+
+    Statistics const& statistics() const { return m_statistics; }
+
+private:
+    struct PredictedOrigin {
+        String origin;
+        u32 score { 0 };
+    };
+
+    struct SiteHistory {
+        UnixDateTime last_navigated_at;
+        Vector<PredictedOrigin> origins;
+    };
+
+    explicit ConnectionPredictor(LexicalPath path);
+
+    ErrorOr<void> load();
+    ErrorOr<void> save();
+    void schedule_save();
+
+    SiteHistory& ensure_site(String const& site);
+    void record_origin(String const& site, String const& origin);
+
+    LexicalPath m_path;
+    HashMap<String, SiteHistory> m_sites;
+
+    Statistics m_statistics;
+
+    RefPtr<Core::Timer> m_save_timer;
+    bool m_is_dirty { false };
+};
+
+}
@@ -9,6 +9,7 @@
 namespace RequestServer {
 
 class ConnectionFromClient;
+class ConnectionPredictor;
 class Request;
 class RequestPipe;
 
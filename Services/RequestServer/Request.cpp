@@ -27,6 +27,10 @@ extern OwnPtr<ResourceSubstitutionMap> g_resource_substitution_map;
 
 static long s_connect_timeout_seconds = 90L;
 
+// The most body data we hold onto for requests that have yet to coalesce with a request writing a cache entry. Requests
+// arriving after the response has grown past this size wait for the cache entry to be written instead.
+static constexpr size_t MAXIMUM_COALESCED_BODY_PREFIX_SIZE = 1 * MiB;
+
 Request::TransferredBodyFile::~TransferredBodyFile()
 {
     if (fd != -1)
@@ -393,12 +397,25 @@ NonnullOwnPtr<Request> Request::connect(
     URL::URL url,
     CacheLevel cache_level)
 {
-    auto request = adopt_own(*new Request { request_id, client, curl_multi, resolver, move(url) });
+    auto request = adopt_own(*new Request { request_id, RequestType::Connect, client, curl_multi, resolver, move(url) });
     request->m_connect_cache_level = cache_level;
     request->transition_to_state(State::DNSLookup);
     return request;
 }
 
+NonnullOwnPtr<Request> Request::preconnect(
+    u64 request_id,
+    ConnectionFromClient& client,
+    void* curl_multi,
+    Resolver& resolver,
+    URL::URL url)
+{
+    auto request = adopt_own(*new Request { request_id, RequestType::Preconnect, client, curl_multi, resolver, move(url) });
+    request->m_connect_cache_level = CacheLevel::CreateConnection;
+    request->transition_to_state(State::DNSLookup);
+    return request;
+}
+
 NonnullOwnPtr<Request> Request::revalidate(
     u64 request_id,
     Optional<HTTP::DiskCache&> disk_cache,
@@ -458,12 +475,13 @@ Request::Request(
 
 Request::Request(
     u64 request_id,
+    RequestType type,
     ConnectionFromClient& client,
     void* curl_multi,
     Resolver& resolver,
     URL::URL url)
     : m_request_id(request_id)
-    , m_type(RequestType::Connect)
+    , m_type(type)
     , m_client(&client)
     , m_curl_multi_handle(curl_multi)
     , m_resolver(resolver)
@@ -494,9 +512,11 @@ Request::~Request()
     for (auto* string_list : m_curl_string_lists)
         curl_slist_free_all(string_list);
 
+    finish_coalesced_requests();
+
     if (m_cache_entry_writer.has_value()) {
         if (m_state == State::Complete)
-            (void)m_cache_entry_writer->flush(m_request_headers, m_response_headers);
+            m_cache_entry_writer->flush(m_request_headers, m_response_headers);
         else
             m_cache_entry_writer->remove_incomplete_entry();
     }
@@ -507,6 +527,10 @@ Request::~Request()
 
 void Request::notify_request_unblocked(Badge<HTTP::DiskCache>)
 {
+    // We may have already been served by a request we coalesced with.
+    if (m_state != State::WaitForCache)
+        return;
+
     // FIXME: We may want a timer to limit how long we are waiting for a request before proceeding with a network
     //        request that skips the disk cache.
     transition_to_state(State::Init);
@@ -579,6 +603,9 @@ void Request::process()
     case State::WaitForCache:
         // Do nothing; we are waiting for the disk cache to notify us to proceed.
         break;
+    case State::Coalesced:
+        // Do nothing; we are waiting for the request we coalesced with to forward its response.
+        break;
     case State::FailedCacheOnly:
         handle_failed_cache_only_state();
         break;
@@ -642,9 +669,9 @@ void Request::handle_initial_state()
                         transition_to_state(State::Complete);
                     }
                 },
-                [&](HTTP::DiskCache::CacheHasOpenEntry) {
+                [&](HTTP::DiskCache::CacheHasOpenEntry const& open_entry) {
                     // If an existing entry is open for writing, we must wait for it to complete.
-                    transition_to_state(State::WaitForCache);
+                    wait_for_cache(open_entry.writer_request);
                 });
 
         if (m_state != State::Init)
@@ -662,12 +689,14 @@ void Request::handle_initial_state()
 
                     if (!m_cache_entry_writer.has_value())
                         m_cache_status = CacheStatus::NotCached;
+                    else if (m_type == RequestType::Fetch)
+                        m_accepts_coalesced_requests = true;
                 },
-                [&](HTTP::DiskCache::CacheHasOpenEntry) {
+                [&](HTTP::DiskCache::CacheHasOpenEntry const& open_entry) {
                     // If an existing entry is open for reading or writing, we must wait for it to complete. An entry being
                     // open for reading is a rare case, but may occur if a cached response expired between the existing
                     // entry's cache validation and the attempted reader validation when this request was created.
-                    transition_to_state(State::WaitForCache);
+                    wait_for_cache(open_entry.writer_request);
                 });
 
         if (m_state != State::Init)
@@ -707,7 +736,21 @@ void Request::handle_read_cache_state()
         return;
     }
 
-    auto body_file = m_cache_entry_reader->take_body_file();
+    // NB: The reader is closed once it has handed off its body file, which may only happen later if it had to be decoded.
+    m_cache_entry_reader->take_body_file([weak_this = make_weak_ptr<Request>()](ErrorOr<HTTP::CacheEntryBodyFile> body_file) {
+        if (!weak_this) {
+            if (!body_file.is_error())
+                (void)Core::System::close(body_file.value().fd);
+            return;
+        }
+        weak_this->did_take_cache_entry_body_file(move(body_file));
+    });
+}
+
+void Request::did_take_cache_entry_body_file(ErrorOr<HTTP::CacheEntryBodyFile> body_file)
+{
+    m_cache_entry_reader.clear();
+
     if (body_file.is_error()) {
         m_network_error = Requests::NetworkError::CacheReadFailed;
         transition_to_state(State::Error);
@@ -729,8 +772,6 @@ void Request::handle_read_cache_state()
         return;
     }
 
-    m_cache_entry_reader.clear();
-
     transition_to_state(State::Complete);
 }
 
@@ -841,7 +882,7 @@ void Request::handle_dns_lookup_state()
             } else if (first_is_one_of(self.m_type, RequestType::Fetch, RequestType::BackgroundRevalidation)) {
                 self.m_dns_result = move(dns_result);
                 self.transition_to_state(State::RetrieveCookie);
-            } else if (self.m_type == RequestType::Connect && self.m_connect_cache_level == CacheLevel::CreateConnection) {
+            } else if (first_is_one_of(self.m_type, RequestType::Connect, RequestType::Preconnect) && self.m_connect_cache_level == CacheLevel::CreateConnection) {
                 self.m_dns_result = move(dns_result);
                 self.transition_to_state(State::Connect);
             } else {
@@ -1058,30 +1099,52 @@ void Request::handle_complete_state()
 
         auto timing_info = acquire_timing_info();
         transfer_headers_to_client_if_needed();
+        finish_coalesced_requests();
 
         // Finalize the disk cache entry before notifying WebContent that the request is complete: WebContent may
         // immediately fire off a JavaScript bytecode cache store against this entry, and that store needs the cache
         // index row to already exist. If we notified first the store would race the index write and be rejected.
-        Optional<HTTP::CacheEntryBodyFile> cached_body_file;
         if (m_cache_entry_writer.has_value()) {
-            if (m_cache_entry_writer->body_size() >= static_cast<u64>(PAGE_SIZE)) {
-                auto body_file = m_cache_entry_writer->flush_and_take_body_file(m_request_headers, m_response_headers);
-                if (!body_file.is_error())
-                    cached_body_file = body_file.release_value();
+            auto& cache_entry_writer = *m_cache_entry_writer;
+            m_cache_entry_writer.clear();
+
+            // The entry is finalized once it has been written behind on the disk cache's IO thread, which we do not
+            // wait for here.
+            auto finish_request = [weak_this = make_weak_ptr<Request>(), timing_info](Optional<HTTP::CacheEntryBodyFile> cached_body_file) {
+                if (!weak_this) {
+                    if (cached_body_file.has_value())
+                        (void)Core::System::close(cached_body_file->fd);
+                    return;
+                }
+
+                auto& self = *weak_this;
+                if (cached_body_file.has_value())
+                    self.m_client->async_request_cached_body_file_available(self.m_request_id, IPC::File::adopt_fd(cached_body_file->fd), cached_body_file->offset, cached_body_file->size);
+
+                self.m_client->async_request_finished(self.m_request_id, self.m_bytes_transferred_to_client, timing_info, self.m_network_error);
+                self.m_client->request_complete({}, self);
+            };
+
+            if (cache_entry_writer.body_size() >= static_cast<u64>(PAGE_SIZE)) {
+                cache_entry_writer.flush_and_take_body_file(m_request_headers, m_response_headers, [finish_request = move(finish_request)](ErrorOr<HTTP::CacheEntryBodyFile> body_file) {
+                    if (body_file.is_error())
+                        finish_request({});
+                    else
+                        finish_request(body_file.release_value());
+                });
             } else {
-                (void)m_cache_entry_writer->flush(m_request_headers, m_response_headers);
+                cache_entry_writer.flush(m_request_headers, m_response_headers, [finish_request = move(finish_request)](ErrorOr<void>) {
+                    finish_request({});
+                });
             }
-            m_cache_entry_writer.clear();
+            return;
         }
 
-        if (cached_body_file.has_value())
-            m_client->async_request_cached_body_file_available(m_request_id, IPC::File::adopt_fd(cached_body_file->fd), cached_body_file->offset, cached_body_file->size);
-
         m_client->async_request_finished(m_request_id, m_bytes_transferred_to_client, timing_info, m_network_error);
     }
 
     if (m_cache_entry_writer.has_value()) {
-        (void)m_cache_entry_writer->flush(m_request_headers, m_response_headers);
+        m_cache_entry_writer->flush(m_request_headers, m_response_headers);
         m_cache_entry_writer.clear();
     }
 
@@ -1090,6 +1153,8 @@ void Request::handle_complete_state()
 
 void Request::handle_error_state()
 {
+    finish_coalesced_requests();
+
     if (m_type == RequestType::Fetch) {
         // FIXME: Implement timing info for failed requests.
         m_client->async_request_finished(m_request_id, m_bytes_transferred_to_client, {}, m_network_error.value_or(Requests::NetworkError::Unknown));
@@ -1161,6 +1226,8 @@ size_t Request::on_data_received(void* buffer, size_t size, size_t nmemb, void*
     auto total_size = size * nmemb;
     ReadonlyBytes bytes { static_cast<u8 const*>(buffer), total_size };
 
+    request.forward_data_to_coalesced_requests(bytes);
+
     auto result = [&] -> ErrorOr<void> {
         TRY(request.m_response_buffer.write_some(bytes));
         return request.write_queued_bytes_without_blocking();
@@ -1276,6 +1343,10 @@ void Request::transfer_headers_to_client_if_needed()
         if (m_cache_entry_writer->write_status_and_reason(*m_status_code, m_reason_phrase, m_request_headers, m_response_headers).is_error()) {
             m_cache_status = CacheStatus::NotCached;
             m_cache_entry_writer.clear();
+
+            // The response is not being stored (e.g. it is no-store or varies on every header), so it must not be shared
+            // with requests that were waiting on its cache entry either.
+            release_coalesced_requests();
         } else {
             m_cache_status = CacheStatus::WrittenToCache;
         }
@@ -1284,6 +1355,8 @@ void Request::transfer_headers_to_client_if_needed()
     if (m_type == RequestType::BackgroundRevalidation)
         return;
 
+    forward_response_headers_to_coalesced_requests();
+
     if (m_disk_cache.has_value() && m_disk_cache->mode() == HTTP::DiskCache::Mode::Testing) {
         switch (m_cache_status) {
         case CacheStatus::Unknown:
@@ -1417,12 +1490,151 @@ ErrorOr<void> Request::write_queued_bytes_without_blocking()
     return {};
 }
 
+void Request::wait_for_cache(WeakPtr<HTTP::CacheRequest> const& writer_request)
+{
+    // NB: Every cache request issued by RequestServer is a Request.
+    if (writer_request && coalesce_with(static_cast<Request&>(*writer_request)))
+        return;
+
+    transition_to_state(State::WaitForCache);
+}
+
+// Rather than waiting for another request to finish writing the cache entry for the same resource, we may receive that
+// request's response as it arrives from the network. We remain queued with the disk cache while doing so, in case that
+// request turns out to be unable to serve us.
+bool Request::coalesce_with(Request& writer_request)
+{
+    if (m_type != RequestType::Fetch || !writer_request.m_accepts_coalesced_requests)
+        return false;
+    if (m_include_credentials != writer_request.m_include_credentials)
+        return false;
+
+    dbgln_if(REQUESTSERVER_DEBUG, "RequestServer: Coalescing request {} for {} with request {}", m_request_id, m_url, writer_request.m_request_id);
+
+    writer_request.m_coalesced_requests.append(make_weak_ptr<Request>());
+    transition_to_state(State::Coalesced);
+
+    if (writer_request.m_sent_response_headers_to_client) {
+        receive_coalesced_response_headers(writer_request);
+
+        if (m_state == State::Coalesced)
+            receive_coalesced_data(writer_request.m_coalesced_body_prefix);
+    }
+
+    return true;
+}
+
+void Request::forward_response_headers_to_coalesced_requests()
+{
+    for (auto& request : m_coalesced_requests) {
+        if (request && request->m_state == State::Coalesced)
+            request->receive_coalesced_response_headers(*this);
+    }
+}
+
+void Request::forward_data_to_coalesced_requests(ReadonlyBytes bytes)
+{
+    if (m_accepts_coalesced_requests) {
+        if (m_coalesced_body_prefix.size() + bytes.size() > MAXIMUM_COALESCED_BODY_PREFIX_SIZE || m_coalesced_body_prefix.try_append(bytes).is_error()) {
+            m_accepts_coalesced_requests = false;
+            m_coalesced_body_prefix.clear();
+        }
+    }
+
+    for (auto& request : m_coalesced_requests) {
+        if (request && request->m_state == State::Coalesced)
+            request->receive_coalesced_data(bytes);
+    }
+}
+
+void Request::finish_coalesced_requests()
+{
+    m_accepts_coalesced_requests = false;
+    m_coalesced_body_prefix.clear();
+
+    for (auto& request : exchange(m_coalesced_requests, {})) {
+        if (request && request->m_state == State::Coalesced)
+            request->finish_coalesced_request(*this);
+    }
+}
+
+void Request::release_coalesced_requests()
+{
+    m_accepts_coalesced_requests = false;
+    m_coalesced_body_prefix.clear();
+
+    // NB: Our cache entry has been closed, and the disk cache will notify these requests to proceed once we are out of
+    //     the curl callback that we may be running in.
+    for (auto& request : exchange(m_coalesced_requests, {})) {
+        if (request && request->m_state == State::Coalesced)
+            request->transition_to_state(State::WaitForCache);
+    }
+}
+
+void Request::receive_coalesced_response_headers(Request const& writer_request)
+{
+    // The response may only be shared if it would have been stored under the same vary key for our request headers.
+    auto vary_key = HTTP::create_vary_key(*m_request_headers, *writer_request.m_response_headers);
+
+    if (vary_key != HTTP::create_vary_key(*writer_request.m_request_headers, *writer_request.m_response_headers)) {
+        transition_to_state(State::WaitForCache);
+        return;
+    }
+
+    m_status_code = writer_request.m_status_code;
+    m_reason_phrase = writer_request.m_reason_phrase;
+    m_response_headers = HTTP::HeaderList::create(writer_request.m_response_headers->headers());
+
+    if (inform_client_request_started().is_error())
+        return;
+    transfer_headers_to_client_if_needed();
+}
+
+void Request::receive_coalesced_data(ReadonlyBytes bytes)
+{
+    if (bytes.is_empty())
+        return;
+
+    auto result = [&] -> ErrorOr<void> {
+        TRY(m_response_buffer.write_some(bytes));
+        return write_queued_bytes_without_blocking();
+    }();
+
+    if (result.is_error()) {
+        dbgln("Request::receive_coalesced_data: Aborting request because error occurred whilst writing data to the client: {}", result.error());
+        m_network_error = Requests::NetworkError::Unknown;
+        transition_to_state(State::Error);
+    }
+}
+
+void Request::finish_coalesced_request(Request const& writer_request)
+{
+    if (writer_request.m_state == State::Complete) {
+        m_curl_result_code = CURLE_OK;
+
+        if (m_response_buffer.is_eof())
+            transition_to_state(State::Complete);
+        return;
+    }
+
+    // If the other request failed before we sent anything to our client, we may still issue our own request once the
+    // cache entry it was writing has been closed.
+    if (!m_sent_response_headers_to_client) {
+        transition_to_state(State::WaitForCache);
+        return;
+    }
+
+    m_network_error = writer_request.m_network_error.value_or(Requests::NetworkError::Unknown);
+    transition_to_state(State::Error);
+}
+
 bool Request::is_revalidation_request() const
 {
     switch (m_type) {
     case RequestType::Fetch:
         return m_cache_entry_reader.has_value() && m_cache_entry_reader->revalidation_type() == HTTP::CacheEntryReader::RevalidationType::MustRevalidate;
     case RequestType::Connect:
+    case RequestType::Preconnect:
         return false;
     case RequestType::BackgroundRevalidation:
         return m_cache_entry_reader.has_value();
@@ -12,6 +12,7 @@
 #include <AK/Optional.h>
 #include <AK/RefPtr.h>
 #include <AK/Time.h>
+#include <AK/WeakPtr.h>
 #include <LibCore/Proxy.h>
 #include <LibDNS/Resolver.h>
 #include <LibHTTP/Cache/CacheMode.h>
@@ -57,6 +58,13 @@ public:
         URL::URL url,
         CacheLevel cache_level);
 
+    static NonnullOwnPtr<Request> preconnect(
+        u64 request_id,
+        ConnectionFromClient& client,
+        void* curl_multi,
+        Resolver& resolver,
+        URL::URL url);
+
     static NonnullOwnPtr<Request> revalidate(
         u64 request_id,
         Optional<HTTP::DiskCache&> disk_cache,
@@ -103,6 +111,7 @@ private:
         Init,              // Decide whether to service this request from cache or the network.
         ReadCache,         // Read the cached response from disk.
         WaitForCache,      // Wait for an existing cache entry to complete before proceeding.
+        Coalesced,         // Receive the response of the request writing the cache entry for the same resource.
         FailedCacheOnly,   // An only-if-cached request failed to find a cache entry.
         ServeSubstitution, // Serve content from a local file substitution.
         DNSLookup,         // Resolve the URL's host.
@@ -122,6 +131,8 @@ private:
             return "ReadCache"sv;
         case State::WaitForCache:
             return "WaitForCache"sv;
+        case State::Coalesced:
+            return "Coalesced"sv;
         case State::FailedCacheOnly:
             return "FailedCacheOnly"sv;
         case State::ServeSubstitution:
@@ -161,6 +172,7 @@ private:
 
     Request(
         u64 request_id,
+        RequestType type,
         ConnectionFromClient& client,
         void* curl_multi,
         Resolver& resolver,
@@ -171,6 +183,7 @@ private:
 
     void handle_initial_state();
     void handle_read_cache_state();
+    void did_take_cache_entry_body_file(ErrorOr<HTTP::CacheEntryBodyFile>);
     void handle_failed_cache_only_state();
     void handle_serve_substitution_state();
     void handle_dns_lookup_state();
@@ -191,6 +204,16 @@ private:
     void send_headers_to_client(Optional<IPC::File> javascript_bytecode = {}, u64 javascript_bytecode_size = 0, Optional<u64> javascript_bytecode_cache_vary_key = {});
     ErrorOr<void> write_queued_bytes_without_blocking();
 
+    void wait_for_cache(WeakPtr<HTTP::CacheRequest> const& writer_request);
+    bool coalesce_with(Request& writer_request);
+    void forward_response_headers_to_coalesced_requests();
+    void forward_data_to_coalesced_requests(ReadonlyBytes);
+    void finish_coalesced_requests();
+    void release_coalesced_requests();
+    void receive_coalesced_response_headers(Request const& writer_request);
+    void receive_coalesced_data(ReadonlyBytes);
+    void finish_coalesced_request(Request const& writer_request);
+
     virtual bool is_revalidation_request() const override;
     ErrorOr<void> revalidation_failed();
 
@@ -243,6 +266,13 @@ private:
 
     Optional<Requests::NetworkError> m_network_error;
     bool m_keep_alive_for_transfer { false };
+
+    // Requests for the same resource that receive this request's response, and the body received so far for any that
+    // have yet to join.
+    Vector<WeakPtr<Request>> m_coalesced_requests;
+    ByteBuffer m_coalesced_body_prefix;
+    bool m_accepts_coalesced_requests { false };
+
     RefPtr<ConnectionFromClient> m_network_connection_keep_alive;
 };
 
@@ -5,12 +5,28 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Debug.h>
+#include <AK/JsonArray.h>
+#include <AK/JsonObject.h>
+#include <AK/JsonValue.h>
+#include <LibCore/File.h>
+#include <LibCore/Timer.h>
+#include <LibFileSystem/FileSystem.h>
 #include <LibTLS/TLSv12.h>
 #include <RequestServer/Resolver.h>
 
 namespace RequestServer {
 
+static constexpr u32 DNS_CACHE_VERSION = 1;
+
+// The number of most recently used names whose addresses are persisted.
+static constexpr size_t MAXIMUM_PERSISTED_NAME_COUNT = 256;
+
+// The persisted names are saved periodically, so that they survive RequestServer being killed rather than exiting.
+static constexpr int SAVE_INTERVAL_MS = 60'000;
+
 static ByteString g_default_certificate_path;
+static Optional<ByteString> g_dns_cache_path;
 
 ByteString const& default_certificate_path()
 {
@@ -22,6 +38,118 @@ void set_default_certificate_path(ByteString default_certificate_path)
     g_default_certificate_path = move(default_certificate_path);
 }
 
+void set_dns_cache_path(ByteString dns_cache_path)
+{
+    g_dns_cache_path = move(dns_cache_path);
+}
+
+static ErrorOr<void> load_dns_cache(DNS::Resolver& resolver, ByteString const& path)
+{
+    auto file = Core::File::open(path, Core::File::OpenMode::Read);
+    if (file.is_error()) {
+        if (file.error().is_errno() && file.error().code() == ENOENT)
+            return {};
+        return file.release_error();
+    }
+
+    auto contents = TRY(file.value()->read_until_eof());
+    auto json = TRY(JsonValue::from_string(contents));
+
+    if (!json.is_object())
+        return Error::from_string_literal("Expected DNS cache to be a JSON object");
+
+    auto const& root = json.as_object();
+
+    // NB: The persisted cache is only used to warm up the resolver. If its format changed, just start over.
+    if (root.get_u32("version"sv) != DNS_CACHE_VERSION)
+        return {};
+
+    auto names = root.get_object("names"sv);
+    if (!names.has_value())
+        return {};
+
+    Vector<DNS::Resolver::CachedAddresses> entries;
+
+    names->for_each_member([&](String const& name, JsonValue const& value) {
+        if (!value.is_object() || entries.size() >= MAXIMUM_PERSISTED_NAME_COUNT)
+            return;
+
+        auto const& object = value.as_object();
+
+        auto expiration = object.get_i64("expiration"sv);
+        auto ttl = object.get_u32("ttl"sv);
+        auto addresses = object.get_array("addresses"sv);
+        if (!expiration.has_value() || !ttl.has_value() || !addresses.has_value())
+            return;
+
+        DNS::Resolver::CachedAddresses entry {
+            .name = name.to_byte_string(),
+            .addresses = {},
+            .expiration = UnixDateTime::from_seconds_since_epoch(*expiration),
+            .ttl = *ttl,
+        };
+
+        addresses->for_each([&](JsonValue const& address) {
+            if (!address.is_string())
+                return;
+
+            auto string = address.as_string().bytes_as_string_view();
+
+            if (auto ipv4 = IPv4Address::from_string(string); ipv4.has_value())
+                entry.addresses.append(*ipv4);
+            else if (auto ipv6 = IPv6Address::from_string(string); ipv6.has_value())
+                entry.addresses.append(*ipv6);
+        });
+
+        entries.append(move(entry));
+    });
+
+    resolver.seed_cache(entries);
+    return {};
+}
+
+static ErrorOr<ByteString> serialize_dns_cache(DNS::Resolver& resolver)
+{
+    JsonObject names;
+
+    for (auto const& entry : resolver.most_recently_used_addresses(MAXIMUM_PERSISTED_NAME_COUNT)) {
+        JsonArray addresses;
+        for (auto const& address : entry.addresses)
+            TRY(addresses.append(TRY(address.visit([](auto const& address) { return address.to_string(); }))));
+
+        JsonObject object;
+        object.set("addresses"sv, move(addresses));
+        object.set("expiration"sv, entry.expiration.seconds_since_epoch());
+        object.set("ttl"sv, entry.ttl);
+
+        names.set(TRY(String::from_byte_string(entry.name)), move(object));
+    }
+
+    JsonObject root;
+    root.set("version"sv, DNS_CACHE_VERSION);
+    root.set("names"sv, move(names));
+
+    return root.serialized().to_byte_string();
+}
+
+// The cache is written to a temporary file that replaces the existing one, so it is never left partially written.
+static ErrorOr<void> write_dns_cache(ByteString const& path, StringView contents)
+{
+    auto temporary_path = ByteString::formatted("{}.tmp", path);
+
+    auto result = [&]() -> ErrorOr<void> {
+        auto file = TRY(Core::File::open(temporary_path, Core::File::OpenMode::Write | Core::File::OpenMode::Truncate));
+        TRY(file->write_until_depleted(contents));
+        file->close();
+
+        return FileSystem::move_file(path, temporary_path);
+    }();
+
+    if (result.is_error())
+        (void)FileSystem::remove(temporary_path, FileSystem::RecursionMode::Disallowed);
+    return result;
+}
+
 DNSInfo& DNSInfo::the()
 {
     static DNSInfo g_dns_info;
@@ -68,6 +196,16 @@ NonnullRefPtr<Resolver> Resolver::default_resolver()
         };
     }));
 
+    if (g_dns_cache_path.has_value()) {
+        if (auto result = load_dns_cache(resolver->dns, *g_dns_cache_path); result.is_error())
+            dbgln("Resolver: Unable to load DNS cache from '{}': {}", *g_dns_cache_path, result.error());
+
+        resolver->m_save_timer = Core::Timer::create_repeating(SAVE_INTERVAL_MS, [resolver = resolver.ptr()]() {
+            resolver->save_dns_cache();
+        });
+        resolver->m_save_timer->start();
+    }
+
     g_resolver = resolver;
     return resolver;
 }
@@ -77,4 +215,53 @@ Resolver::Resolver(Function<ErrorOr<DNS::Resolver::SocketResult>()> create_socke
 {
 }
 
+void Resolver::remove_cache_entries_used_since(UnixDateTime since)
+{
+    // NB: The resolver tracks when names were used on the monotonic clock.
+    auto time_since = UnixDateTime::now() - since;
+    dns.remove_cache_entries_used_since(MonotonicTime::now() - time_since);
+
+    // Save right away, rather than leaving the removed names on disk until the save timer fires.
+    save_dns_cache();
+}
+
+void Resolver::save_dns_cache()
+{
+    if (!g_dns_cache_path.has_value())
+        return;
+
+    auto result = [&]() -> ErrorOr<void> {
+        auto contents = TRY(serialize_dns_cache(dns));
+
+        // Most names keep their addresses between saves, so avoid rewriting the file when nothing changed.
+        if (contents == m_saved_dns_cache)
+            return {};
+
+        TRY(write_dns_cache(*g_dns_cache_path, contents));
+        m_saved_dns_cache = move(contents);
+
+        return {};
+    }();
+
+    if (result.is_error())
+        dbgln("Resolver: Unable to save DNS cache to '{}': {}", *g_dns_cache_path, result.error());
+}
+
+Resolver::~Resolver()
+{
+    if (m_save_timer)
+        m_save_timer->stop();
+
+    save_dns_cache();
+
+    if constexpr (REQUESTSERVER_DEBUG) {
+        auto const& statistics = dns.statistics();
+        auto average_latency_ms = statistics.resolved_lookups == 0 ? 0 : statistics.total_lookup_latency.to_milliseconds() / static_cast<i64>(statistics.resolved_lookups);
+
+        dbgln("Resolver: {} hits, {} stale hits, {} misses, {} refreshes, {} evictions, {} ms average / {} ms maximum lookup latency",
+            statistics.hits, statistics.stale_hits, statistics.misses, statistics.refreshes, statistics.evictions,
+            average_latency_ms, statistics.maximum_lookup_latency.to_milliseconds());
+    }
+}
+
 }
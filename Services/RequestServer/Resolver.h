@@ -9,6 +9,7 @@
 
 #include <AK/Optional.h>
 #include <AK/RefCounted.h>
+#include <AK/Time.h>
 #include <AK/Weakable.h>
 #include <LibCore/Forward.h>
 #include <LibDNS/Resolver.h>
@@ -32,14 +33,27 @@ struct Resolver
     : public RefCounted<Resolver>
     , public Weakable<Resolver> {
     static NonnullRefPtr<Resolver> default_resolver();
+    ~Resolver();
+
+    // Forgets the names looked up since the given time. This is done along with clearing the disk cache, as the
+    // persisted names reveal which hosts were contacted.
+    void remove_cache_entries_used_since(UnixDateTime since);
 
     DNS::Resolver dns;
 
 private:
     explicit Resolver(Function<ErrorOr<DNS::Resolver::SocketResult>()> create_socket);
+
+    void save_dns_cache();
+
+    RefPtr<Core::Timer> m_save_timer;
+    ByteString m_saved_dns_cache;
 };
 
 ByteString const& default_certificate_path();
 void set_default_certificate_path(ByteString);
 
+// The file in which the addresses of recently used names are persisted across restarts.
+void set_dns_cache_path(ByteString);
+
 }
@@ -18,6 +18,7 @@
 #include <LibMain/Main.h>
 #include <RequestServer/CURL.h>
 #include <RequestServer/ConnectionFromClient.h>
+#include <RequestServer/ConnectionPredictor.h>
 #include <RequestServer/Resolver.h>
 #include <RequestServer/ResourceSubstitutionMap.h>
 #include <RequestServer/Sandbox.h>
@@ -101,6 +102,14 @@ ErrorOr<int> ladybird_main(Main::Arguments arguments)
             disk_cache = cache.release_value();
     }
 
+    // We only learn from, speculatively connect for, and remember resolved names for browsing sessions that persist
+    // their cache.
+    OwnPtr<RequestServer::ConnectionPredictor> connection_predictor;
+    if (disk_cache.has_value() && disk_cache->mode() == HTTP::DiskCache::Mode::Normal) {
+        connection_predictor = RequestServer::ConnectionPredictor::create(LexicalPath::join(cache_path, "connection-predictor.json"sv));
+        RequestServer::set_dns_cache_path(LexicalPath::join(cache_path, "dns-cache.json"sv).string());
+    }
+
     TRY(RequestServer::initialize_libcurl());
 
     if (!disable_sandbox)
@@ -116,6 +125,7 @@ ErrorOr<int> ladybird_main(Main::Arguments arguments)
         RequestServer::IsPrivate::No,
         connections,
         disk_cache,
+        connection_predictor ? Optional<RequestServer::ConnectionPredictor&> { *connection_predictor } : Optional<RequestServer::ConnectionPredictor&> {},
         LexicalPath::join(cache_path, "alt-svc-cache.txt"sv).string()));
 
     return event_loop.exec();
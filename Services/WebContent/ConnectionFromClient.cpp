@@ -24,8 +24,10 @@
 #include <LibGfx/Bitmap.h>
 #include <LibGfx/Color.h>
 #include <LibGfx/Font/FontDatabase.h>
+#include <LibGfx/GlyphRunCache.h>
 #include <LibGfx/SystemTheme.h>
 #include <LibIPC/Transport.h>
+#include <LibJS/Bytecode/Statistics.h>
 #include <LibJS/Runtime/ConsoleObject.h>
 #include <LibJS/Runtime/Date.h>
 #include <LibUnicode/TimeZone.h>
@@ -34,6 +36,7 @@
 #include <LibWeb/Bindings/MainThreadVM.h>
 #include <LibWeb/CSS/CustomPropertyData.h>
 #include <LibWeb/CSS/Parser/ErrorReporter.h>
+#include <LibWeb/CSS/Parser/ParsedStyleSheetCache.h>
 #include <LibWeb/CSS/StyleComputer.h>
 #include <LibWeb/CSS/StyleSheetList.h>
 #include <LibWeb/Compositor/CompositorHost.h>
@@ -631,6 +634,16 @@ void ConnectionFromClient::debug_request(u64 page_id, ByteString request, ByteSt
         return;
     }
 
+    if (request == "dump-bytecode-stats") {
+        JS::Bytecode::Statistics::the().dump();
+        return;
+    }
+
+    if (request == "dump-glyph-run-cache-stats") {
+        Gfx::GlyphRunCache::the().dump();
+        return;
+    }
+
     if (request == "collect-garbage") {
         // NOTE: We use deferred_invoke here to ensure that GC runs with as little on the stack as possible.
         Core::deferred_invoke([] {
@@ -662,6 +675,7 @@ void ConnectionFromClient::debug_request(u64 page_id, ByteString request, ByteSt
 
     if (request == "clear-cache") {
         Web::Fetch::Fetching::clear_http_memory_cache();
+        Web::CSS::Parser::ParsedStyleSheetCache::the().clear();
         return;
     }
 
@@ -2456,6 +2470,10 @@ void ConnectionFromClient::set_system_visibility_state(u64 page_id, Web::HTML::V
 {
     if (auto page = this->page(page_id); page.has_value())
         page->page().top_level_traversable()->set_system_visibility_state(visibility_state);
+
+    // NB: A hidden page won't lay out or paint for a while, so let go of the glyph runs it no longer uses.
+    if (visibility_state == Web::HTML::VisibilityState::Hidden)
+        Gfx::GlyphRunCache::the().purge_unused_runs();
 }
 
 void ConnectionFromClient::reset_zoom(u64 page_id)
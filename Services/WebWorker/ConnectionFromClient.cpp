@@ -6,6 +6,8 @@
 
 #include <LibCore/Process.h>
 #include <LibCore/System.h>
+#include <LibJS/Runtime/ExecutionContext.h>
+#include <LibJS/Runtime/Realm.h>
 #include <LibWeb/HTML/BroadcastChannel.h>
 #include <LibWeb/HTML/WorkerAgentParent.h>
 #include <LibWeb/Platform/FontPlugin.h>
@@ -120,7 +122,32 @@ void ConnectionFromClient::start_worker(URL::URL url, Web::Bindings::WorkerType
 
     // FIXME: Add an assertion that the agent_type passed here is the same that was passed at process creation to initialize_main_thread_vm()
 
-    m_worker_host->run(page(), move(implicit_port), outside_settings, credentials, is_shared);
+    OwnPtr<JS::ExecutionContext> prepared_realm_execution_context;
+    if (auto prepared_worker_realm = m_prepared_worker_realm.take(); prepared_worker_realm.has_value() && prepared_worker_realm->is_shared == is_shared)
+        prepared_realm_execution_context = move(prepared_worker_realm->execution_context);
+
+    m_worker_host->run(page(), move(implicit_port), outside_settings, credentials, is_shared, move(prepared_realm_execution_context));
+}
+
+void ConnectionFromClient::prepare_worker_realm(Web::Bindings::AgentType agent_type)
+{
+    if (m_worker_host || m_prepared_worker_realm.has_value())
+        return;
+    if (agent_type != Web::Bindings::AgentType::DedicatedWorker && agent_type != Web::Bindings::AgentType::SharedWorker)
+        return;
+
+    bool const is_shared = agent_type == Web::Bindings::AgentType::SharedWorker;
+    auto execution_context = WorkerHost::create_realm_execution_context(page(), is_shared);
+
+    // NB: The execution context is not a cell, so we have to keep its realm (and with it, the global object) alive
+    //     ourselves until the worker is started.
+    GC::Root<JS::Realm> realm = *execution_context->realm;
+
+    m_prepared_worker_realm = PreparedWorkerRealm {
+        .execution_context = move(execution_context),
+        .realm = move(realm),
+        .is_shared = is_shared,
+    };
 }
 
 void ConnectionFromClient::connect_shared_worker(Web::HTML::TransferDataEncoder message_port, Web::HTML::SerializedEnvironmentSettingsObject outside_settings)
@@ -7,6 +7,8 @@
 #pragma once
 
 #include <AK/HashMap.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Optional.h>
 #include <AK/Utf16String.h>
 #include <LibGC/Root.h>
 #include <LibIPC/ConnectionFromClient.h>
@@ -37,6 +39,9 @@ public:
 
     void request_file(Web::FileRequest);
 
+    // Creates the realm for the worker this process will run, while it waits to be told which worker that is.
+    void prepare_worker_realm(Web::Bindings::AgentType);
+
     PageHost& page_host() { return *m_page_host; }
     PageHost const& page_host() const { return *m_page_host; }
 
@@ -74,6 +79,13 @@ private:
     int last_id { 0 };
 
     RefPtr<WorkerHost> m_worker_host;
+
+    struct PreparedWorkerRealm {
+        NonnullOwnPtr<JS::ExecutionContext> execution_context;
+        GC::Root<JS::Realm> realm;
+        bool is_shared { false };
+    };
+    Optional<PreparedWorkerRealm> m_prepared_worker_realm;
 };
 
 }
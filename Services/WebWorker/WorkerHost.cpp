@@ -50,8 +50,24 @@ static Web::HTML::WorkerGlobalScope::Owner relevant_owner_to_add(Web::HTML::Seri
         [](Web::HTML::SerializedWindow const& window) -> Web::HTML::WorkerGlobalScope::Owner { return window.associated_document; });
 }
 
+NonnullOwnPtr<JS::ExecutionContext> WorkerHost::create_realm_execution_context(GC::Ref<Web::Page> page, bool is_shared)
+{
+    // https://html.spec.whatwg.org/multipage/workers.html#run-a-worker
+    // 5. Let realm execution context be the result of creating a new realm given agent and the following customizations:
+    return Web::Bindings::create_a_new_javascript_realm(
+        Web::Bindings::main_thread_vm(),
+        [page, is_shared](JS::Realm& realm) -> JS::Object* {
+            // For the global object, if is shared is true, create a new SharedWorkerGlobalScope object.
+            if (is_shared)
+                return realm.heap().allocate<Web::HTML::SharedWorkerGlobalScope>(realm, page);
+            // Otherwise, create a new DedicatedWorkerGlobalScope object.
+            return realm.heap().allocate<Web::HTML::DedicatedWorkerGlobalScope>(realm, page);
+        },
+        nullptr);
+}
+
 // https://html.spec.whatwg.org/multipage/workers.html#run-a-worker
-void WorkerHost::run(GC::Ref<Web::Page> page, Web::HTML::TransferDataEncoder message_port_data, Web::HTML::SerializedEnvironmentSettingsObject const& outside_settings_snapshot, Web::Bindings::RequestCredentials credentials, bool is_shared)
+void WorkerHost::run(GC::Ref<Web::Page> page, Web::HTML::TransferDataEncoder message_port_data, Web::HTML::SerializedEnvironmentSettingsObject const& outside_settings_snapshot, Web::Bindings::RequestCredentials credentials, bool is_shared, OwnPtr<JS::ExecutionContext> prepared_realm_execution_context)
 {
     m_is_shared = is_shared;
 
@@ -63,16 +79,11 @@ void WorkerHost::run(GC::Ref<Web::Page> page, Web::HTML::TransferDataEncoder mes
     auto unsafe_worker_creation_time = Web::HighResolutionTime::unsafe_shared_current_time();
 
     // 5. Let realm execution context be the result of creating a new realm given agent and the following customizations:
-    auto realm_execution_context = Web::Bindings::create_a_new_javascript_realm(
-        Web::Bindings::main_thread_vm(),
-        [page, is_shared](JS::Realm& realm) -> JS::Object* {
-            // For the global object, if is shared is true, create a new SharedWorkerGlobalScope object.
-            if (is_shared)
-                return realm.heap().allocate<Web::HTML::SharedWorkerGlobalScope>(realm, page);
-            // Otherwise, create a new DedicatedWorkerGlobalScope object.
-            return realm.heap().allocate<Web::HTML::DedicatedWorkerGlobalScope>(realm, page);
-        },
-        nullptr);
+    // AD-HOC: The realm does not depend on anything but the page and is shared, so the process may have created it
+    //         before it was asked to run a worker.
+    auto realm_execution_context = prepared_realm_execution_context
+        ? prepared_realm_execution_context.release_nonnull()
+        : create_realm_execution_context(page, is_shared);
 
     // 6. Let worker global scope be the global object of realm execution context's Realm component.
     // NOTE: This is the DedicatedWorkerGlobalScope or SharedWorkerGlobalScope object created in the previous step.
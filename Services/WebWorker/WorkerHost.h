@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include <AK/NonnullOwnPtr.h>
+#include <AK/OwnPtr.h>
 #include <AK/RefCounted.h>
 #include <AK/Utf16String.h>
 #include <AK/Vector.h>
@@ -25,7 +27,11 @@ public:
     explicit WorkerHost(URL::URL url, Web::Bindings::WorkerType type, Utf16String name);
     ~WorkerHost();
 
-    void run(GC::Ref<Web::Page>, Web::HTML::TransferDataEncoder message_port_data, Web::HTML::SerializedEnvironmentSettingsObject const&, Web::Bindings::RequestCredentials, bool is_shared);
+    static NonnullOwnPtr<JS::ExecutionContext> create_realm_execution_context(GC::Ref<Web::Page>, bool is_shared);
+
+    // NB: prepared_realm_execution_context may hold a realm made by create_realm_execution_context() ahead of time, so
+    //     that the worker does not have to set up all of the JS intrinsics after it has been asked to start.
+    void run(GC::Ref<Web::Page>, Web::HTML::TransferDataEncoder message_port_data, Web::HTML::SerializedEnvironmentSettingsObject const&, Web::Bindings::RequestCredentials, bool is_shared, OwnPtr<JS::ExecutionContext> prepared_realm_execution_context = {});
     void connect_shared_worker(Web::HTML::TransferDataEncoder message_port_data, Web::HTML::SerializedEnvironmentSettingsObject);
 
 private:
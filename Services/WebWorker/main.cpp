@@ -114,6 +114,11 @@ ErrorOr<int> ladybird_main(Main::Arguments arguments)
             dbgln("Failed to connect to image decoder: {}", result.error());
     };
 
+    // Set up the JS realm while the browser is still sending us the service connections and the worker to run.
+    Core::deferred_invoke([client, worker_type] {
+        client->prepare_worker_realm(worker_type);
+    });
+
     return event_loop.exec();
 }
 
@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <Compositor/TileCache.h>
+#include <LibGfx/Bitmap.h>
+#include <LibGfx/PaintingSurface.h>
+#include <LibGfx/SkiaUtils.h>
+#include <LibTest/TestCase.h>
+#include <core/SkCanvas.h>
+
+static constexpr int tile_size = Compositor::TileCache::tile_size;
+
+static Gfx::Color color_for_tile_row(int row)
+{
+    return Gfx::Color(row * 16, 0, 255 - row * 16);
+}
+
+static NonnullRefPtr<Gfx::PaintingSurface> make_target(Gfx::IntSize size)
+{
+    return Gfx::PaintingSurface::create_with_size(size, Gfx::BitmapFormat::BGRA8888, Gfx::AlphaType::Premultiplied);
+}
+
+static void rasterize_tile_rows(Gfx::PaintingSurface& surface, Gfx::IntRect content_rect)
+{
+    for (auto y = content_rect.y(); y < content_rect.y() + content_rect.height(); y += tile_size) {
+        SkPaint paint;
+        paint.setColor(Gfx::to_skia_color(color_for_tile_row(y / tile_size)));
+        surface.canvas().drawRect(SkRect::MakeXYWH(0, y - content_rect.y(), content_rect.width(), tile_size), paint);
+    }
+}
+
+TEST_CASE(scrolling_only_rasterizes_tiles_that_scrolled_into_view)
+{
+    Compositor::TileCache tile_cache;
+    auto target = make_target({ 2 * tile_size, 2 * tile_size });
+    Gfx::IntRect target_rect { {}, target->size() };
+
+    size_t rasterizations = 0;
+    auto rasterize_content = [&](Gfx::PaintingSurface& surface, Gfx::IntRect content_rect) {
+        ++rasterizations;
+        rasterize_tile_rows(surface, content_rect);
+    };
+
+    auto statistics = tile_cache.composite(*target, {}, target_rect, rasterize_content);
+    EXPECT_EQ(statistics.composited_tiles, 4u);
+    EXPECT_EQ(statistics.rasterized_tiles, 4u);
+    EXPECT_EQ(rasterizations, 1u);
+
+    statistics = tile_cache.composite(*target, { 0, 100 }, target_rect, rasterize_content);
+    EXPECT_EQ(statistics.composited_tiles, 6u);
+    EXPECT_EQ(statistics.rasterized_tiles, 2u);
+    EXPECT_EQ(rasterizations, 2u);
+    EXPECT_EQ(tile_cache.tile_count(), 6u);
+
+    auto bitmap = target->snapshot_bitmap();
+    EXPECT_EQ(bitmap->get_pixel(0, 0), color_for_tile_row(0));
+    EXPECT_EQ(bitmap->get_pixel(0, tile_size - 101), color_for_tile_row(0));
+    EXPECT_EQ(bitmap->get_pixel(0, tile_size - 100), color_for_tile_row(1));
+    EXPECT_EQ(bitmap->get_pixel(0, 2 * tile_size - 100), color_for_tile_row(2));
+
+    statistics = tile_cache.composite(*target, {}, target_rect, rasterize_content);
+    EXPECT_EQ(statistics.rasterized_tiles, 0u);
+    EXPECT_EQ(rasterizations, 2u);
+}
+
+TEST_CASE(missing_tiles_are_rasterized_together_within_their_union)
+{
+    Compositor::TileCache tile_cache;
+    auto target = make_target({ 2 * tile_size, 2 * tile_size });
+    Gfx::IntRect target_rect { {}, target->size() };
+
+    Vector<Gfx::IntRect> rasterized_content_rects;
+    auto rasterize_content = [&](Gfx::PaintingSurface& surface, Gfx::IntRect content_rect) {
+        rasterized_content_rects.append(content_rect);
+        EXPECT(surface.canvas().getDeviceClipBounds() == SkIRect::MakeWH(content_rect.width(), content_rect.height()));
+        rasterize_tile_rows(surface, content_rect);
+    };
+
+    (void)tile_cache.composite(*target, {}, target_rect, rasterize_content);
+    tile_cache.invalidate({ 10, 10, 20, 20 });
+    tile_cache.invalidate({ tile_size + 10, tile_size + 10, 20, 20 });
+    EXPECT_EQ(tile_cache.tile_count(), 2u);
+
+    auto statistics = tile_cache.composite(*target, {}, target_rect, rasterize_content);
+    EXPECT_EQ(statistics.rasterized_tiles, 2u);
+    EXPECT_EQ(rasterized_content_rects.size(), 2u);
+    EXPECT_EQ(rasterized_content_rects.last(), Gfx::IntRect(0, 0, 2 * tile_size, 2 * tile_size));
+
+    // Each tile only takes its own part of the shared rasterization.
+    auto bitmap = target->snapshot_bitmap();
+    EXPECT_EQ(bitmap->get_pixel(0, 0), color_for_tile_row(0));
+    EXPECT_EQ(bitmap->get_pixel(tile_size - 1, tile_size - 1), color_for_tile_row(0));
+    EXPECT_EQ(bitmap->get_pixel(tile_size, tile_size), color_for_tile_row(1));
+    EXPECT_EQ(bitmap->get_pixel(2 * tile_size - 1, 2 * tile_size - 1), color_for_tile_row(1));
+}
+
+TEST_CASE(invalidation_only_drops_the_tiles_it_touches)
+{
+    Compositor::TileCache tile_cache;
+    auto target = make_target({ 2 * tile_size, 2 * tile_size });
+    Gfx::IntRect target_rect { {}, target->size() };
+    auto rasterize_content = [](Gfx::PaintingSurface& surface, Gfx::IntRect) {
+        surface.canvas().clear(SK_ColorWHITE);
+    };
+
+    (void)tile_cache.composite(*target, {}, target_rect, rasterize_content);
+    EXPECT_EQ(tile_cache.tile_count(), 4u);
+
+    tile_cache.invalidate({ tile_size + 10, 10, 20, 20 });
+    EXPECT_EQ(tile_cache.tile_count(), 3u);
+    EXPECT(!tile_cache.contains_tile({ 1, 0 }));
+    EXPECT(tile_cache.contains_tile({ 0, 0 }));
+
+    auto statistics = tile_cache.composite(*target, {}, target_rect, rasterize_content);
+    EXPECT_EQ(statistics.rasterized_tiles, 1u);
+
+    tile_cache.invalidate_all();
+    EXPECT_EQ(tile_cache.tile_count(), 0u);
+    EXPECT_EQ(tile_cache.memory_usage(), 0u);
+}
+
+TEST_CASE(rasterization_surface_counts_against_the_memory_budget)
+{
+    static constexpr size_t tile_byte_size = static_cast<size_t>(tile_size) * tile_size * 4;
+    auto target = make_target({ 2 * tile_size, 2 * tile_size });
+    Gfx::IntRect target_rect { {}, target->size() };
+
+    // The four missing tiles are rasterized into a surface that covers all of them, which is kept for the next frame.
+    Compositor::TileCache tile_cache;
+    (void)tile_cache.composite(*target, {}, target_rect, rasterize_tile_rows);
+    EXPECT_EQ(tile_cache.tile_count(), 4u);
+    EXPECT_EQ(tile_cache.memory_usage(), 8 * tile_byte_size);
+
+    // Over the budget, it is released before any tile is evicted.
+    Compositor::TileCache small_tile_cache { 6 * tile_byte_size };
+    auto statistics = small_tile_cache.composite(*target, {}, target_rect, rasterize_tile_rows);
+    EXPECT_EQ(statistics.evicted_tiles, 0u);
+    EXPECT_EQ(small_tile_cache.tile_count(), 4u);
+    EXPECT_EQ(small_tile_cache.memory_usage(), 4 * tile_byte_size);
+}
+
+TEST_CASE(least_recently_composited_tiles_are_evicted_over_the_memory_budget)
+{
+    static constexpr size_t tile_byte_size = static_cast<size_t>(tile_size) * tile_size * 4;
+    Compositor::TileCache tile_cache { 6 * tile_byte_size };
+    auto target = make_target({ tile_size, 2 * tile_size });
+    Gfx::IntRect target_rect { {}, target->size() };
+    for (int row = 0; row < 8; ++row)
+        (void)tile_cache.composite(*target, { 0, row * tile_size }, target_rect, rasterize_tile_rows);
+
+    EXPECT(tile_cache.memory_usage() <= tile_cache.memory_budget());
+    EXPECT(tile_cache.contains_tile({ 0, 8 }));
+    EXPECT(tile_cache.contains_tile({ 0, 7 }));
+    EXPECT(!tile_cache.contains_tile({ 0, 0 }));
+
+    // Surfaces taken over from evicted tiles are rasterized from scratch.
+    (void)tile_cache.composite(*target, { 0, 8 * tile_size }, target_rect, rasterize_tile_rows);
+    auto bitmap = target->snapshot_bitmap();
+    EXPECT_EQ(bitmap->get_pixel(0, 0), color_for_tile_row(8));
+    EXPECT_EQ(bitmap->get_pixel(0, tile_size), color_for_tile_row(9));
+}
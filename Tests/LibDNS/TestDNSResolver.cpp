@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Array.h>
 #include <AK/ByteBuffer.h>
 #include <AK/Endian.h>
 #include <AK/IPv4Address.h>
@@ -20,10 +21,10 @@
 
 namespace {
 
-// Builds a canned DNS response for a query: It echoes the question section and answers with one fixed A and one fixed
+// Builds a canned DNS response for a query: It echoes the question section and answers with one A and one fixed
 // AAAA record. The resolver correlates responses to lookups by header ID, and reads the answer section. Enough to drive
 // a successful lookup while exercising the real wire encode and decode paths — without depending on a live DNS server.
-ErrorOr<ByteBuffer> build_dns_response(ReadonlyBytes query_bytes)
+ErrorOr<ByteBuffer> build_dns_response(ReadonlyBytes query_bytes, IPv4Address address = { 192, 0, 2, 1 })
 {
     FixedMemoryStream stream { query_bytes };
     auto query = TRY(DNS::Messages::Message::from_raw(stream));
@@ -41,7 +42,7 @@ ErrorOr<ByteBuffer> build_dns_response(ReadonlyBytes query_bytes)
 
     response.answers.append(DNS::Messages::ResourceRecord {
         name, DNS::Messages::ResourceType::A, DNS::Messages::Class::IN, 300,
-        DNS::Messages::Records::A { IPv4Address { 192, 0, 2, 1 } }, {} });
+        DNS::Messages::Records::A { address }, {} });
     response.answers.append(DNS::Messages::ResourceRecord {
         name, DNS::Messages::ResourceType::AAAA, DNS::Messages::Class::IN, 300,
         DNS::Messages::Records::AAAA { IPv6Address::loopback() }, {} });
@@ -194,3 +195,170 @@ TEST_CASE(test_localhost_resolves_to_loopback_without_a_socket)
     // A multi-label subdomain: the case that the host resolver / upstream server may not map to loopback.
     expect_loopback("test-host.localhost"sv);
 }
+
+TEST_CASE(test_stale_answer_is_served_while_refreshing)
+{
+    Core::EventLoop loop;
+
+    auto server = Core::UDPServer::construct();
+    EXPECT(server->bind(IPv4Address { 127, 0, 0, 1 }, 0));
+    auto server_port = server->local_port().value();
+
+    size_t query_count = 0;
+    server->on_ready_to_receive = [&] {
+        sockaddr_in from {};
+        auto query = MUST(server->receive(4096, from));
+        auto response = MUST(build_dns_response(query.bytes(), IPv4Address { 192, 0, 2, 2 }));
+        MUST(server->send(response.bytes(), from));
+        ++query_count;
+    };
+
+    DNS::Resolver resolver {
+        [server_port] -> ErrorOr<DNS::Resolver::SocketResult> {
+            Core::SocketAddress address { IPv4Address { 127, 0, 0, 1 }, server_port };
+            return DNS::Resolver::SocketResult {
+                TRY(Core::BufferedSocket<Core::UDPSocket>::create(TRY(Core::UDPSocket::connect(address)))),
+                DNS::Resolver::ConnectionMode::UDP,
+            };
+        }
+    };
+    TRY_OR_FAIL(resolver.when_socket_ready()->await());
+
+    // Seed the cache as if it were restored from a previous session, with an answer which expired a minute ago.
+    DNS::Resolver::CachedAddresses stale_entry {
+        .name = "example.com",
+        .addresses = { IPv4Address { 192, 0, 2, 1 } },
+        .expiration = UnixDateTime::now() - AK::Duration::from_seconds(60),
+        .ttl = 300,
+    };
+    resolver.seed_cache({ &stale_entry, 1 });
+
+    auto first_ipv4_address = [](DNS::LookupResult const& result) -> Optional<IPv4Address> {
+        for (auto const& address : result.cached_addresses()) {
+            if (auto const* ipv4 = address.get_pointer<IPv4Address>())
+                return *ipv4;
+        }
+        return {};
+    };
+
+    // The stale answer is served immediately, without waiting on the upstream server.
+    auto promise = resolver.lookup("example.com", DNS::Messages::Class::IN, { DNS::Messages::ResourceType::A, DNS::Messages::ResourceType::AAAA });
+    EXPECT(promise->is_resolved());
+
+    auto stale_result = TRY_OR_FAIL(promise->await());
+    EXPECT(stale_result->is_stale());
+    EXPECT_EQ(first_ipv4_address(*stale_result), (IPv4Address { 192, 0, 2, 1 }));
+
+    // Meanwhile, the name is refreshed in the background.
+    for (size_t i = 0; i < 100 && resolver.lookup_in_cache("example.com"sv)->is_stale(); ++i)
+        loop.pump();
+
+    auto refreshed_result = resolver.lookup_in_cache("example.com"sv);
+    EXPECT(!refreshed_result->is_stale());
+    EXPECT_EQ(first_ipv4_address(*refreshed_result), (IPv4Address { 192, 0, 2, 2 }));
+    EXPECT_EQ(query_count, 1u);
+
+    auto const& statistics = resolver.statistics();
+    EXPECT_EQ(statistics.stale_hits, 1u);
+    EXPECT_EQ(statistics.refreshes, 1u);
+    EXPECT_EQ(statistics.misses, 0u);
+    EXPECT_EQ(statistics.resolved_lookups, 1u);
+}
+
+TEST_CASE(test_cache_evicts_least_recently_used_names)
+{
+    Core::EventLoop loop;
+
+    auto server = Core::UDPServer::construct();
+    EXPECT(server->bind(IPv4Address { 127, 0, 0, 1 }, 0));
+    auto server_port = server->local_port().value();
+
+    server->on_ready_to_receive = [&] {
+        sockaddr_in from {};
+        auto query = MUST(server->receive(4096, from));
+        auto response = MUST(build_dns_response(query.bytes()));
+        MUST(server->send(response.bytes(), from));
+    };
+
+    DNS::Resolver resolver {
+        [server_port] -> ErrorOr<DNS::Resolver::SocketResult> {
+            Core::SocketAddress address { IPv4Address { 127, 0, 0, 1 }, server_port };
+            return DNS::Resolver::SocketResult {
+                TRY(Core::BufferedSocket<Core::UDPSocket>::create(TRY(Core::UDPSocket::connect(address)))),
+                DNS::Resolver::ConnectionMode::UDP,
+            };
+        }
+    };
+    TRY_OR_FAIL(resolver.when_socket_ready()->await());
+
+    resolver.set_maximum_cache_entry_count(2);
+
+    auto lookup = [&](ByteString name) {
+        return resolver.lookup(move(name), DNS::Messages::Class::IN, { DNS::Messages::ResourceType::A, DNS::Messages::ResourceType::AAAA });
+    };
+
+    auto resolve_upstream = [&](ByteString name) {
+        lookup(move(name))
+            ->when_resolved([&](auto&) { loop.quit(0); })
+            .when_rejected([&](auto& error) {
+                outln("Failed to resolve: {}", error);
+                loop.quit(1);
+            });
+        EXPECT_EQ(0, loop.exec());
+    };
+
+    resolve_upstream("a.example.com");
+    resolve_upstream("b.example.com");
+
+    // Use the first name again, leaving the second as the least recently used.
+    EXPECT(lookup("a.example.com")->is_resolved());
+
+    resolve_upstream("c.example.com");
+
+    EXPECT(resolver.lookup_in_cache("a.example.com"sv));
+    EXPECT(!resolver.lookup_in_cache("b.example.com"sv));
+    EXPECT(resolver.lookup_in_cache("c.example.com"sv));
+
+    auto const& statistics = resolver.statistics();
+    EXPECT_EQ(statistics.hits, 1u);
+    EXPECT_EQ(statistics.misses, 3u);
+    EXPECT_EQ(statistics.evictions, 1u);
+}
+
+TEST_CASE(test_cache_entries_used_since_a_given_time_are_removed)
+{
+    Core::EventLoop loop;
+
+    DNS::Resolver resolver {
+        [] -> ErrorOr<DNS::Resolver::SocketResult> {
+            return Error::from_string_literal("No DNS server in this test");
+        }
+    };
+
+    Array entries {
+        DNS::Resolver::CachedAddresses {
+            .name = "a.example.com",
+            .addresses = { IPv4Address { 192, 0, 2, 1 } },
+            .expiration = UnixDateTime::now() + AK::Duration::from_seconds(300),
+            .ttl = 300,
+        },
+        DNS::Resolver::CachedAddresses {
+            .name = "b.example.com",
+            .addresses = { IPv4Address { 192, 0, 2, 2 } },
+            .expiration = UnixDateTime::now() + AK::Duration::from_seconds(300),
+            .ttl = 300,
+        },
+    };
+    resolver.seed_cache(entries);
+
+    // Names that were last used before the given time are kept.
+    resolver.remove_cache_entries_used_since(MonotonicTime::now() + AK::Duration::from_seconds(60));
+    EXPECT(resolver.lookup_in_cache("a.example.com"sv));
+    EXPECT(resolver.lookup_in_cache("b.example.com"sv));
+    EXPECT_EQ(resolver.most_recently_used_addresses(10).size(), 2u);
+
+    resolver.remove_cache_entries_used_since(MonotonicTime::now() - AK::Duration::from_seconds(60));
+    EXPECT(!resolver.lookup_in_cache("a.example.com"sv));
+    EXPECT(!resolver.lookup_in_cache("b.example.com"sv));
+    EXPECT(resolver.most_recently_used_addresses(10).is_empty());
+}
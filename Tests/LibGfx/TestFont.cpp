@@ -4,12 +4,15 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Array.h>
 #include <LibCore/MappedFile.h>
 #include <LibGfx/Font/Font.h>
 #include <LibGfx/Font/FontDatabase.h>
 #include <LibGfx/Font/PathFontProvider.h>
 #include <LibGfx/Font/Typeface.h>
+#include <LibGfx/TextLayout.h>
 #include <LibTest/TestCase.h>
+#include <LibThreading/Thread.h>
 
 #define TEST_INPUT(x) ("test-inputs/" x)
 
@@ -51,3 +54,43 @@ TEST_CASE(text_font_is_not_emoji_font)
 {
     EXPECT(!font_is_emoji(TEST_INPUT("fonts/text.ttf"sv)));
 }
+
+// Shaping with a font that has not shaped anything yet, from several threads at once, gives every thread the same
+// glyphs as shaping on a single thread.
+TEST_CASE(text_can_be_shaped_from_several_threads)
+{
+    static constexpr size_t thread_count = 8;
+
+    auto file = MUST(Core::MappedFile::map(TEST_INPUT("fonts/text.ttf"sv)));
+    auto typeface = MUST(Gfx::Typeface::try_load_from_externally_owned_memory(file->bytes()));
+    auto font = adopt_ref(*new Gfx::Font(typeface, 12, 12, {}, {}));
+
+    auto text = u"The quick brown fox jumps over the lazy dog"sv;
+    IGNORE_USE_IN_ESCAPING_LAMBDA Array<RefPtr<Gfx::GlyphRun>, thread_count> shaped_runs;
+    Vector<NonnullRefPtr<Threading::Thread>> threads;
+    for (size_t i = 0; i < thread_count; ++i) {
+        threads.append(Threading::Thread::construct("TextShaper"sv, [font, text, &shaped_runs, i] {
+            for (size_t iteration = 0; iteration < 100; ++iteration) {
+                (void)Gfx::shape_text({}, 0, u"a"sv, *font, Gfx::GlyphRun::TextType::Common);
+                shaped_runs[i] = Gfx::shape_text({}, 0, text, *font, Gfx::GlyphRun::TextType::Ltr);
+            }
+            return 0;
+        }));
+    }
+    for (auto& thread : threads)
+        thread->start();
+    for (auto& thread : threads)
+        (void)thread->join();
+
+    auto reference_font = adopt_ref(*new Gfx::Font(typeface, 12, 12, {}, {}));
+    auto reference = Gfx::shape_text({}, 0, text, *reference_font, Gfx::GlyphRun::TextType::Ltr);
+    for (auto const& run : shaped_runs) {
+        EXPECT(run);
+        if (!run)
+            continue;
+        EXPECT_EQ(run->width(), reference->width());
+        EXPECT_EQ(run->glyphs().size(), reference->glyphs().size());
+        for (size_t i = 0; i < min(run->glyphs().size(), reference->glyphs().size()); ++i)
+            EXPECT_EQ(run->glyphs()[i].glyph_id, reference->glyphs()[i].glyph_id);
+    }
+}
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibCore/MappedFile.h>
+#include <LibGfx/Font/Font.h>
+#include <LibGfx/Font/Typeface.h>
+#include <LibGfx/GlyphRunCache.h>
+#include <LibGfx/TextLayout.h>
+#include <LibTest/TestCase.h>
+
+#define TEST_INPUT(x) ("test-inputs/" x)
+
+static NonnullRefPtr<Gfx::Font> load_text_font()
+{
+    static auto file = MUST(Core::MappedFile::map(TEST_INPUT("fonts/text.ttf"sv)));
+    auto typeface = MUST(Gfx::Typeface::try_load_from_externally_owned_memory(file->bytes()));
+    return adopt_ref(*new Gfx::Font(typeface, 12, 12, {}, {}));
+}
+
+TEST_CASE(identical_glyphs_share_a_glyph_run)
+{
+    auto font = load_text_font();
+    auto& cache = Gfx::GlyphRunCache::the();
+    cache.clear();
+    auto statistics_before = cache.statistics();
+
+    auto shaped = Gfx::shape_text({}, 0, u"hello"sv, *font, Gfx::GlyphRun::TextType::Ltr);
+    auto first = cache.find_or_create(shaped->glyphs(), *font, Gfx::GlyphRun::TextType::Ltr, shaped->width());
+    auto second = cache.find_or_create(shaped->glyphs(), *font, Gfx::GlyphRun::TextType::Ltr, shaped->width());
+
+    EXPECT_EQ(first.ptr(), second.ptr());
+    EXPECT_EQ(cache.statistics().misses - statistics_before.misses, 1u);
+    EXPECT_EQ(cache.statistics().hits - statistics_before.hits, 1u);
+}
+
+TEST_CASE(different_glyphs_get_their_own_glyph_run)
+{
+    auto font = load_text_font();
+    auto& cache = Gfx::GlyphRunCache::the();
+    cache.clear();
+
+    auto shaped = Gfx::shape_text({}, 0, u"hello"sv, *font, Gfx::GlyphRun::TextType::Ltr);
+    auto moved = Gfx::shape_text({ 10, 0 }, 0, u"hello"sv, *font, Gfx::GlyphRun::TextType::Ltr);
+    auto run = cache.find_or_create(shaped->glyphs(), *font, Gfx::GlyphRun::TextType::Ltr, shaped->width());
+
+    EXPECT_NE(run.ptr(), cache.find_or_create(moved->glyphs(), *font, Gfx::GlyphRun::TextType::Ltr, moved->width()).ptr());
+    EXPECT_NE(run.ptr(), cache.find_or_create(shaped->glyphs(), *font, Gfx::GlyphRun::TextType::Rtl, shaped->width()).ptr());
+    EXPECT_NE(run.ptr(), cache.find_or_create(shaped->glyphs(), *font, Gfx::GlyphRun::TextType::Ltr, shaped->width() + 1).ptr());
+}
+
+TEST_CASE(purging_keeps_glyph_runs_that_are_still_in_use)
+{
+    auto font = load_text_font();
+    auto& cache = Gfx::GlyphRunCache::the();
+    cache.clear();
+
+    auto kept = Gfx::shape_text({}, 0, u"kept"sv, *font, Gfx::GlyphRun::TextType::Ltr);
+    auto dropped = Gfx::shape_text({}, 0, u"dropped"sv, *font, Gfx::GlyphRun::TextType::Ltr);
+    auto kept_run = cache.find_or_create(kept->glyphs(), *font, Gfx::GlyphRun::TextType::Ltr, kept->width());
+    (void)cache.find_or_create(dropped->glyphs(), *font, Gfx::GlyphRun::TextType::Ltr, dropped->width());
+
+    cache.purge_unused_runs();
+
+    EXPECT_EQ(cache.glyph_count(), kept->glyphs().size());
+    EXPECT_EQ(kept_run.ptr(), cache.find_or_create(kept->glyphs(), *font, Gfx::GlyphRun::TextType::Ltr, kept->width()).ptr());
+    cache.clear();
+}
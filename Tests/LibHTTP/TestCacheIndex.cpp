@@ -140,6 +140,115 @@ TEST_CASE(associated_data_counts_toward_cache_size)
     EXPECT(state.index.estimate_cache_size_accessed_since(UnixDateTime::earliest()).total <= 80u);
 }
 
+TEST_CASE(compact_segments_relocates_live_entries_out_of_mostly_removed_segments)
+{
+    auto state = create_cache_index();
+
+    auto request_headers = HTTP::HeaderList::create();
+    auto response_headers = HTTP::HeaderList::create();
+    auto vary_key = HTTP::create_vary_key(*request_headers, *response_headers);
+    auto now = UnixDateTime::now();
+
+    auto create_packed_entry = [&](u64 cache_key, u64 size) {
+        auto location = state.index.allocate_segment_space(size);
+        MUST(state.index.create_entry(cache_key, vary_key, MUST(String::formatted("https://example.com/{}", cache_key)), request_headers, response_headers, 10, now, now, location));
+        state.index.finish_segment_append(location);
+        return location;
+    };
+
+    auto first_location = create_packed_entry(1, 4 * MiB);
+    auto second_location = create_packed_entry(2, 4 * MiB);
+    EXPECT_EQ(second_location.segment_id, first_location.segment_id);
+    EXPECT_EQ(second_location.offset, 4 * MiB);
+
+    // The first segment is full, so further entries go into a new segment.
+    auto third_location = create_packed_entry(3, 100);
+    EXPECT_NE(third_location.segment_id, first_location.segment_id);
+
+    Vector<u32> compacted_segments;
+    state.index.compact_segments([&](auto segment_id, auto, auto) { compacted_segments.append(segment_id); });
+    EXPECT(compacted_segments.is_empty());
+
+    state.index.remove_entry(1, vary_key);
+
+    u32 compacted_segment_id = 0;
+    Vector<HTTP::CacheIndex::SegmentRelocation> relocations;
+    state.index.compact_segments([&](auto segment_id, auto new_segment_id, auto segment_relocations) {
+        compacted_segments.append(segment_id);
+        compacted_segment_id = new_segment_id;
+        relocations = move(segment_relocations);
+    });
+
+    EXPECT_EQ(compacted_segments, Vector<u32> { first_location.segment_id });
+    EXPECT_NE(compacted_segment_id, first_location.segment_id);
+    EXPECT_NE(compacted_segment_id, third_location.segment_id);
+    VERIFY(relocations.size() == 1);
+    EXPECT_EQ(relocations[0].cache_key, 2u);
+    EXPECT_EQ(relocations[0].from.offset, second_location.offset);
+    EXPECT_EQ(relocations[0].to.segment_id, compacted_segment_id);
+    EXPECT_EQ(relocations[0].to.offset, 0u);
+
+    // Until the copy has landed, the entry stays where it is, and the segment is not compacted again.
+    auto entry = state.index.find_entry(2, *request_headers);
+    VERIFY(entry.has_value());
+    EXPECT_EQ(entry->segment_location->segment_id, first_location.segment_id);
+
+    compacted_segments.clear();
+    state.index.compact_segments([&](auto segment_id, auto, auto) { compacted_segments.append(segment_id); });
+    EXPECT(compacted_segments.is_empty());
+
+    // New entries keep being appended to the active segment, never to the compacted one.
+    auto fourth_location = create_packed_entry(4, 100);
+    EXPECT_EQ(fourth_location.segment_id, third_location.segment_id);
+
+    state.index.commit_segment_compaction(first_location.segment_id, compacted_segment_id, relocations);
+
+    entry = state.index.find_entry(2, *request_headers);
+    VERIFY(entry.has_value());
+    VERIFY(entry->segment_location.has_value());
+    EXPECT_EQ(entry->segment_location->segment_id, compacted_segment_id);
+    EXPECT_EQ(entry->segment_location->offset, 0u);
+}
+
+TEST_CASE(compaction_leaves_entries_replaced_while_being_copied)
+{
+    auto state = create_cache_index();
+
+    auto request_headers = HTTP::HeaderList::create();
+    auto response_headers = HTTP::HeaderList::create();
+    auto vary_key = HTTP::create_vary_key(*request_headers, *response_headers);
+    auto now = UnixDateTime::now();
+
+    auto create_packed_entry = [&](u64 cache_key, u64 size) {
+        auto location = state.index.allocate_segment_space(size);
+        MUST(state.index.create_entry(cache_key, vary_key, MUST(String::formatted("https://example.com/{}", cache_key)), request_headers, response_headers, 10, now, now, location));
+        state.index.finish_segment_append(location);
+        return location;
+    };
+
+    auto first_location = create_packed_entry(1, 4 * MiB);
+    create_packed_entry(2, 4 * MiB);
+    create_packed_entry(3, 100);
+    state.index.remove_entry(1, vary_key);
+
+    u32 compacted_segment_id = 0;
+    Vector<HTTP::CacheIndex::SegmentRelocation> relocations;
+    state.index.compact_segments([&](auto, auto new_segment_id, auto segment_relocations) {
+        compacted_segment_id = new_segment_id;
+        relocations = move(segment_relocations);
+    });
+    VERIFY(relocations.size() == 1);
+
+    auto replacement_location = create_packed_entry(2, 200);
+    state.index.commit_segment_compaction(first_location.segment_id, compacted_segment_id, relocations);
+
+    auto entry = state.index.find_entry(2, *request_headers);
+    VERIFY(entry.has_value());
+    VERIFY(entry->segment_location.has_value());
+    EXPECT_EQ(entry->segment_location->segment_id, replacement_location.segment_id);
+    EXPECT_EQ(entry->segment_location->offset, replacement_location.offset);
+}
+
 TEST_CASE(newer_cache_index_schema_reports_database_too_new)
 {
     auto database = TRY_OR_FAIL(Database::Database::create_memory_backed());
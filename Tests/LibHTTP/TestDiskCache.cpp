@@ -5,8 +5,10 @@
  */
 
 #include <AK/ByteBuffer.h>
+#include <LibCore/EventLoop.h>
 #include <LibCore/ImmutableBytes.h>
 #include <LibCore/StandardPaths.h>
+#include <LibFileSystem/FileSystem.h>
 #include <LibHTTP/Cache/CacheRequest.h>
 #include <LibHTTP/Cache/DiskCache.h>
 #include <LibHTTP/Cache/Utilities.h>
@@ -16,7 +18,9 @@
 
 struct TestCacheRequest final : public HTTP::CacheRequest {
     virtual bool is_revalidation_request() const override { return false; }
-    virtual void notify_request_unblocked(Badge<HTTP::DiskCache>) override { }
+    virtual void notify_request_unblocked(Badge<HTTP::DiskCache>) override { was_unblocked = true; }
+
+    bool was_unblocked { false };
 };
 
 static URL::URL parse_url(StringView url)
@@ -60,8 +64,67 @@ static HTTP::CacheEntryWriter& create_cache_entry(HTTP::DiskCache& disk_cache, T
     return *writer;
 }
 
+// Entries are written behind on the disk cache's IO thread, and are only complete once the event loop is told so.
+static ErrorOr<void> flush_cache_entry(HTTP::CacheEntryWriter& writer, NonnullRefPtr<HTTP::HeaderList> request_headers, NonnullRefPtr<HTTP::HeaderList> response_headers)
+{
+    Optional<ErrorOr<void>> result;
+    writer.flush(move(request_headers), move(response_headers), [&](ErrorOr<void> flush_result) {
+        result = move(flush_result);
+    });
+
+    Core::EventLoop::current().spin_until([&] { return result.has_value(); });
+    return result.release_value();
+}
+
+static ErrorOr<HTTP::CacheEntryBodyFile> flush_cache_entry_and_take_body_file(HTTP::CacheEntryWriter& writer, NonnullRefPtr<HTTP::HeaderList> request_headers, NonnullRefPtr<HTTP::HeaderList> response_headers)
+{
+    Optional<ErrorOr<HTTP::CacheEntryBodyFile>> result;
+    writer.flush_and_take_body_file(move(request_headers), move(response_headers), [&](ErrorOr<HTTP::CacheEntryBodyFile> flush_result) {
+        result = move(flush_result);
+    });
+
+    Core::EventLoop::current().spin_until([&] { return result.has_value(); });
+    return result.release_value();
+}
+
+static ErrorOr<HTTP::CacheEntryBodyFile> read_cache_entry_body_file(HTTP::DiskCache& disk_cache, TestCacheRequest& request, URL::URL const& url, HTTP::HeaderList const& request_headers)
+{
+    Optional<HTTP::CacheEntryReader&> reader;
+
+    while (!reader.has_value()) {
+        request.was_unblocked = false;
+
+        disk_cache.open_entry(request, url, "GET"sv, request_headers, HTTP::CacheMode::Default, HTTP::DiskCache::OpenMode::Read)
+            .visit(
+                [&](Optional<HTTP::CacheEntryReader&> cache_entry_reader) {
+                    VERIFY(cache_entry_reader.has_value());
+                    reader = cache_entry_reader;
+                },
+                [&](HTTP::DiskCache::CacheHasOpenEntry) {
+                    // The entry's file may still have writes on their way to the disk, e.g. from compaction.
+                    Core::EventLoop::current().spin_until([&] { return request.was_unblocked; });
+                });
+    }
+
+    Optional<ErrorOr<HTTP::CacheEntryBodyFile>> result;
+    reader->take_body_file([&](ErrorOr<HTTP::CacheEntryBodyFile> body_file) {
+        result = move(body_file);
+    });
+
+    Core::EventLoop::current().spin_until([&] { return result.has_value(); });
+    return result.release_value();
+}
+
+static ByteBuffer read_cache_entry_body(HTTP::DiskCache& disk_cache, TestCacheRequest& request, URL::URL const& url, HTTP::HeaderList const& request_headers)
+{
+    auto body_file = MUST(read_cache_entry_body_file(disk_cache, request, url, request_headers));
+    auto body = MUST(Core::ImmutableBytes::map_from_fd_range_and_close(body_file.fd, "cache body"sv, body_file.offset, body_file.size));
+    return MUST(ByteBuffer::copy(body.bytes()));
+}
+
 TEST_CASE(associated_data_round_trips_with_cache_entry)
 {
+    Core::EventLoop event_loop;
     auto disk_cache = MUST(HTTP::DiskCache::create(HTTP::DiskCache::Mode::Testing, test_cache_root())).release_value();
     TestCacheRequest request;
 
@@ -72,7 +135,7 @@ TEST_CASE(associated_data_round_trips_with_cache_entry)
     auto& writer = create_cache_entry(disk_cache, request, url, *request_headers);
     TRY_OR_FAIL(writer.write_status_and_reason(200, "OK"_string, *request_headers, *response_headers));
     TRY_OR_FAIL(writer.write_data("console.log('hello');"sv.bytes()));
-    TRY_OR_FAIL(writer.flush(request_headers, response_headers));
+    TRY_OR_FAIL(flush_cache_entry(writer, request_headers, response_headers));
 
     auto bytecode = TRY_OR_FAIL(ByteBuffer::copy("bytecode"sv.bytes()));
     EXPECT(TRY_OR_FAIL(disk_cache.store_associated_data(url, "GET"sv, *request_headers, {}, HTTP::CacheEntryAssociatedData::JavaScriptBytecode, bytecode.bytes())));
@@ -94,6 +157,7 @@ TEST_CASE(associated_data_round_trips_with_cache_entry)
 
 TEST_CASE(replacing_cache_entry_removes_associated_data)
 {
+    Core::EventLoop event_loop;
     auto disk_cache = MUST(HTTP::DiskCache::create(HTTP::DiskCache::Mode::Testing, test_cache_root())).release_value();
     TestCacheRequest request;
 
@@ -104,7 +168,7 @@ TEST_CASE(replacing_cache_entry_removes_associated_data)
     auto& writer = create_cache_entry(disk_cache, request, url, *request_headers);
     TRY_OR_FAIL(writer.write_status_and_reason(200, "OK"_string, *request_headers, *response_headers));
     TRY_OR_FAIL(writer.write_data("console.log('old');"sv.bytes()));
-    TRY_OR_FAIL(writer.flush(request_headers, response_headers));
+    TRY_OR_FAIL(flush_cache_entry(writer, request_headers, response_headers));
 
     auto bytecode = TRY_OR_FAIL(ByteBuffer::copy("bytecode"sv.bytes()));
     EXPECT(TRY_OR_FAIL(disk_cache.store_associated_data(url, "GET"sv, *request_headers, {}, HTTP::CacheEntryAssociatedData::JavaScriptBytecode, bytecode.bytes())));
@@ -117,7 +181,7 @@ TEST_CASE(replacing_cache_entry_removes_associated_data)
     auto& replacement_writer = create_cache_entry(disk_cache, request, url, *replacement_request_headers);
     TRY_OR_FAIL(replacement_writer.write_status_and_reason(200, "OK"_string, *replacement_request_headers, *replacement_response_headers));
     TRY_OR_FAIL(replacement_writer.write_data("console.log('new');"sv.bytes()));
-    TRY_OR_FAIL(replacement_writer.flush(replacement_request_headers, replacement_response_headers));
+    TRY_OR_FAIL(flush_cache_entry(replacement_writer, replacement_request_headers, replacement_response_headers));
 
     retrieved_bytecode = TRY_OR_FAIL(disk_cache.retrieve_associated_data(url, "GET"sv, *request_headers, {}, HTTP::CacheEntryAssociatedData::JavaScriptBytecode));
     EXPECT(!retrieved_bytecode.has_value());
@@ -125,6 +189,7 @@ TEST_CASE(replacing_cache_entry_removes_associated_data)
 
 TEST_CASE(flush_returns_mappable_body_file)
 {
+    Core::EventLoop event_loop;
     auto disk_cache = MUST(HTTP::DiskCache::create(HTTP::DiskCache::Mode::Testing, test_cache_root())).release_value();
     TestCacheRequest request;
 
@@ -136,13 +201,39 @@ TEST_CASE(flush_returns_mappable_body_file)
     TRY_OR_FAIL(writer.write_status_and_reason(200, "OK"_string, *request_headers, *response_headers));
     TRY_OR_FAIL(writer.write_data("console.log('hello');"sv.bytes()));
 
-    auto body_file = TRY_OR_FAIL(writer.flush_and_take_body_file(request_headers, response_headers));
+    auto body_file = TRY_OR_FAIL(flush_cache_entry_and_take_body_file(writer, request_headers, response_headers));
     auto body = TRY_OR_FAIL(Core::ImmutableBytes::map_from_fd_range_and_close(body_file.fd, "cache body"sv, body_file.offset, body_file.size));
     EXPECT_EQ(body.bytes(), "console.log('hello');"sv.bytes());
 }
 
+TEST_CASE(flush_waits_for_data_written_behind)
+{
+    Core::EventLoop event_loop;
+    auto disk_cache = MUST(HTTP::DiskCache::create(HTTP::DiskCache::Mode::Testing, test_cache_root())).release_value();
+    TestCacheRequest request;
+
+    auto url = parse_url("https://example.com/script.js"sv);
+    auto request_headers = create_cacheable_request_headers();
+    auto response_headers = create_cacheable_response_headers();
+
+    auto& writer = create_cache_entry(disk_cache, request, url, *request_headers);
+    TRY_OR_FAIL(writer.write_status_and_reason(200, "OK"_string, *request_headers, *response_headers));
+
+    ByteBuffer expected_body;
+    for (size_t i = 0; i < 1000; ++i) {
+        auto chunk = ByteString::formatted("console.log({});", i);
+        TRY_OR_FAIL(writer.write_data(chunk.bytes()));
+        expected_body.append(chunk.bytes());
+    }
+
+    auto body_file = TRY_OR_FAIL(flush_cache_entry_and_take_body_file(writer, request_headers, response_headers));
+    auto body = TRY_OR_FAIL(Core::ImmutableBytes::map_from_fd_range_and_close(body_file.fd, "cache body"sv, body_file.offset, body_file.size));
+    EXPECT_EQ(body.bytes(), expected_body.bytes());
+}
+
 TEST_CASE(replacing_cache_entry_keeps_existing_body_mapping_stable)
 {
+    Core::EventLoop event_loop;
     auto disk_cache = MUST(HTTP::DiskCache::create(HTTP::DiskCache::Mode::Testing, test_cache_root())).release_value();
     TestCacheRequest request;
 
@@ -154,7 +245,7 @@ TEST_CASE(replacing_cache_entry_keeps_existing_body_mapping_stable)
     TRY_OR_FAIL(writer.write_status_and_reason(200, "OK"_string, *request_headers, *response_headers));
     TRY_OR_FAIL(writer.write_data("console.log('old');"sv.bytes()));
 
-    auto old_body_file = TRY_OR_FAIL(writer.flush_and_take_body_file(request_headers, response_headers));
+    auto old_body_file = TRY_OR_FAIL(flush_cache_entry_and_take_body_file(writer, request_headers, response_headers));
     auto old_body = TRY_OR_FAIL(Core::ImmutableBytes::map_from_fd_range_and_close(old_body_file.fd, "old cache body"sv, old_body_file.offset, old_body_file.size));
     EXPECT_EQ(old_body.bytes(), "console.log('old');"sv.bytes());
 
@@ -163,13 +254,14 @@ TEST_CASE(replacing_cache_entry_keeps_existing_body_mapping_stable)
     auto& replacement_writer = create_cache_entry(disk_cache, request, url, *replacement_request_headers);
     TRY_OR_FAIL(replacement_writer.write_status_and_reason(200, "OK"_string, *replacement_request_headers, *replacement_response_headers));
     TRY_OR_FAIL(replacement_writer.write_data("console.log('new');"sv.bytes()));
-    TRY_OR_FAIL(replacement_writer.flush(replacement_request_headers, replacement_response_headers));
+    TRY_OR_FAIL(flush_cache_entry(replacement_writer, replacement_request_headers, replacement_response_headers));
 
     EXPECT_EQ(old_body.bytes(), "console.log('old');"sv.bytes());
 }
 
 TEST_CASE(associated_data_round_trips_with_explicit_vary_key)
 {
+    Core::EventLoop event_loop;
     auto disk_cache = MUST(HTTP::DiskCache::create(HTTP::DiskCache::Mode::Testing, test_cache_root())).release_value();
     TestCacheRequest request;
 
@@ -188,7 +280,7 @@ TEST_CASE(associated_data_round_trips_with_explicit_vary_key)
     auto& writer = create_cache_entry(disk_cache, request, url, *request_headers);
     TRY_OR_FAIL(writer.write_status_and_reason(200, "OK"_string, *request_headers, *response_headers));
     TRY_OR_FAIL(writer.write_data("console.log('hello');"sv.bytes()));
-    TRY_OR_FAIL(writer.flush(request_headers, response_headers));
+    TRY_OR_FAIL(flush_cache_entry(writer, request_headers, response_headers));
 
     auto bytecode = TRY_OR_FAIL(ByteBuffer::copy("bytecode"sv.bytes()));
     EXPECT(!TRY_OR_FAIL(disk_cache.store_associated_data(url, "GET"sv, *mismatched_request_headers, {}, HTTP::CacheEntryAssociatedData::JavaScriptBytecode, bytecode.bytes())));
@@ -201,6 +293,7 @@ TEST_CASE(associated_data_round_trips_with_explicit_vary_key)
 
 TEST_CASE(associated_data_participates_in_cache_eviction)
 {
+    Core::EventLoop event_loop;
     auto disk_cache = MUST(HTTP::DiskCache::create(HTTP::DiskCache::Mode::Testing, test_cache_root())).release_value();
     TestCacheRequest request;
 
@@ -211,7 +304,7 @@ TEST_CASE(associated_data_participates_in_cache_eviction)
     auto& writer = create_cache_entry(disk_cache, request, url, *request_headers);
     TRY_OR_FAIL(writer.write_status_and_reason(200, "OK"_string, *request_headers, *response_headers));
     TRY_OR_FAIL(writer.write_data("console.log('hello');"sv.bytes()));
-    TRY_OR_FAIL(writer.flush(request_headers, response_headers));
+    TRY_OR_FAIL(flush_cache_entry(writer, request_headers, response_headers));
 
     disk_cache.set_maximum_disk_cache_size(80);
     auto bytecode = TRY_OR_FAIL(ByteBuffer::create_zeroed(100));
@@ -220,3 +313,184 @@ TEST_CASE(associated_data_participates_in_cache_eviction)
     auto retrieved_bytecode = TRY_OR_FAIL(disk_cache.retrieve_associated_data(url, "GET"sv, *request_headers, {}, HTTP::CacheEntryAssociatedData::JavaScriptBytecode));
     EXPECT(!retrieved_bytecode.has_value());
 }
+
+TEST_CASE(small_entries_are_packed_into_segments)
+{
+    Core::EventLoop event_loop;
+    auto disk_cache = MUST(HTTP::DiskCache::create(HTTP::DiskCache::Mode::Testing, test_cache_root())).release_value();
+    TestCacheRequest request;
+
+    auto request_headers = create_cacheable_request_headers();
+    auto response_headers = create_cacheable_response_headers();
+
+    for (size_t i = 0; i < 3; ++i) {
+        auto url = parse_url(ByteString::formatted("https://example.com/{}.json", i));
+        auto& writer = create_cache_entry(disk_cache, request, url, *request_headers);
+        TRY_OR_FAIL(writer.write_status_and_reason(200, "OK"_string, *request_headers, *response_headers));
+        TRY_OR_FAIL(writer.write_data(ByteString::formatted("{{\"index\":{}}}", i).bytes()));
+        TRY_OR_FAIL(flush_cache_entry(writer, request_headers, response_headers));
+    }
+
+    for (size_t i = 0; i < 3; ++i) {
+        auto url = parse_url(ByteString::formatted("https://example.com/{}.json", i));
+        auto cache_key = HTTP::create_cache_key(HTTP::serialize_url_for_cache_storage(url), "GET"sv);
+        EXPECT(!FileSystem::exists(HTTP::path_for_cache_entry(disk_cache.cache_directory(), cache_key, 0).string()));
+
+        auto body = read_cache_entry_body(disk_cache, request, url, *request_headers);
+        EXPECT_EQ(body.bytes(), ByteString::formatted("{{\"index\":{}}}", i).bytes());
+    }
+}
+
+TEST_CASE(compressed_bodies_round_trip)
+{
+    Core::EventLoop event_loop;
+    auto disk_cache = MUST(HTTP::DiskCache::create(HTTP::DiskCache::Mode::Testing, test_cache_root())).release_value();
+    TestCacheRequest request;
+
+    auto request_headers = create_cacheable_request_headers();
+    auto response_headers = HTTP::HeaderList::create({
+        { "Cache-Control"sv, "max-age=60"sv },
+        { "Content-Type"sv, "text/javascript; charset=utf-8"sv },
+    });
+
+    ByteBuffer expected_body;
+    for (size_t i = 0; i < 1000; ++i)
+        expected_body.append(ByteString::formatted("console.log({});\n", i).bytes());
+
+    // A body that is handed off as a file when it is written.
+    auto url = parse_url("https://example.com/large.js"sv);
+    auto& writer = create_cache_entry(disk_cache, request, url, *request_headers);
+    TRY_OR_FAIL(writer.write_status_and_reason(200, "OK"_string, *request_headers, *response_headers));
+    TRY_OR_FAIL(writer.write_data(expected_body.bytes()));
+
+    auto body_file = TRY_OR_FAIL(flush_cache_entry_and_take_body_file(writer, request_headers, response_headers));
+    auto body = TRY_OR_FAIL(Core::ImmutableBytes::map_from_fd_range_and_close(body_file.fd, "cache body"sv, body_file.offset, body_file.size));
+    EXPECT_EQ(body.bytes(), expected_body.bytes());
+    EXPECT_EQ(read_cache_entry_body(disk_cache, request, url, *request_headers).bytes(), expected_body.bytes());
+
+    // A body that is packed into a segment.
+    url = parse_url("https://example.com/packed.js"sv);
+    auto& packed_writer = create_cache_entry(disk_cache, request, url, *request_headers);
+    TRY_OR_FAIL(packed_writer.write_status_and_reason(200, "OK"_string, *request_headers, *response_headers));
+    TRY_OR_FAIL(packed_writer.write_data(expected_body.bytes()));
+    TRY_OR_FAIL(flush_cache_entry(packed_writer, request_headers, response_headers));
+
+    EXPECT_EQ(read_cache_entry_body(disk_cache, request, url, *request_headers).bytes(), expected_body.bytes());
+}
+
+TEST_CASE(waiting_requests_are_given_the_request_writing_the_entry)
+{
+    Core::EventLoop event_loop;
+    auto disk_cache = MUST(HTTP::DiskCache::create(HTTP::DiskCache::Mode::Testing, test_cache_root())).release_value();
+    TestCacheRequest writing_request;
+    TestCacheRequest waiting_request;
+
+    auto url = parse_url("https://example.com/coalesced.js"sv);
+    auto request_headers = create_cacheable_request_headers();
+    auto response_headers = create_cacheable_response_headers();
+
+    auto& writer = create_cache_entry(disk_cache, writing_request, url, *request_headers);
+
+    disk_cache.open_entry(waiting_request, url, "GET"sv, *request_headers, HTTP::CacheMode::Default, HTTP::DiskCache::OpenMode::Read)
+        .visit(
+            [](Optional<HTTP::CacheEntryReader&>) {
+                FAIL("Cache entry was unexpectedly not open");
+            },
+            [&](HTTP::DiskCache::CacheHasOpenEntry const& open_entry) {
+                EXPECT_EQ(open_entry.writer_request.ptr(), static_cast<HTTP::CacheRequest*>(&writing_request));
+            });
+
+    TRY_OR_FAIL(writer.write_status_and_reason(200, "OK"_string, *request_headers, *response_headers));
+    TRY_OR_FAIL(writer.write_data("console.log('coalesced');"sv.bytes()));
+    TRY_OR_FAIL(flush_cache_entry(writer, request_headers, response_headers));
+
+    disk_cache.remove_entries_accessed_since(UnixDateTime::earliest());
+}
+
+TEST_CASE(flushing_entry_stays_open_until_written_behind)
+{
+    Core::EventLoop event_loop;
+    auto disk_cache = MUST(HTTP::DiskCache::create(HTTP::DiskCache::Mode::Testing, test_cache_root())).release_value();
+    TestCacheRequest writing_request;
+    TestCacheRequest waiting_request;
+
+    auto url = parse_url("https://example.com/flushing.js"sv);
+    auto request_headers = create_cacheable_request_headers();
+    auto response_headers = create_cacheable_response_headers();
+
+    auto& writer = create_cache_entry(disk_cache, writing_request, url, *request_headers);
+    TRY_OR_FAIL(writer.write_status_and_reason(200, "OK"_string, *request_headers, *response_headers));
+    TRY_OR_FAIL(writer.write_data("console.log('flushing');"sv.bytes()));
+
+    Optional<ErrorOr<void>> result;
+    writer.flush(request_headers, response_headers, [&](ErrorOr<void> flush_result) {
+        result = move(flush_result);
+    });
+
+    // The event loop is never blocked on the disk, so the flush cannot have completed yet.
+    EXPECT(!result.has_value());
+
+    disk_cache.open_entry(waiting_request, url, "GET"sv, *request_headers, HTTP::CacheMode::Default, HTTP::DiskCache::OpenMode::Read)
+        .visit(
+            [](Optional<HTTP::CacheEntryReader&>) {
+                FAIL("Cache entry was unexpectedly not open");
+            },
+            [](HTTP::DiskCache::CacheHasOpenEntry const&) {});
+
+    event_loop.spin_until([&] { return result.has_value() && waiting_request.was_unblocked; });
+    TRY_OR_FAIL(result.release_value());
+
+    EXPECT_EQ(read_cache_entry_body(disk_cache, waiting_request, url, *request_headers).bytes(), "console.log('flushing');"sv.bytes());
+}
+
+TEST_CASE(packing_and_compacting_segments_keeps_mapped_bodies_intact)
+{
+    Core::EventLoop event_loop;
+    auto disk_cache = MUST(HTTP::DiskCache::create(HTTP::DiskCache::Mode::Testing, test_cache_root())).release_value();
+    TestCacheRequest request;
+
+    auto request_headers = create_cacheable_request_headers();
+    auto response_headers = create_cacheable_response_headers();
+
+    auto body_for_entry = [](size_t index, size_t size) {
+        auto body = MUST(ByteBuffer::create_uninitialized(size));
+        for (size_t i = 0; i < size; ++i)
+            body[i] = static_cast<u8>(index + i);
+        return body;
+    };
+    auto write_entry = [&](size_t index, size_t size) -> ErrorOr<void> {
+        auto url = parse_url(ByteString::formatted("https://example.com/{}.bin", index));
+        auto& writer = create_cache_entry(disk_cache, request, url, *request_headers);
+        TRY(writer.write_status_and_reason(200, "OK"_string, *request_headers, *response_headers));
+        auto body = body_for_entry(index, size);
+        TRY(writer.write_data(body.bytes()));
+        return flush_cache_entry(writer, request_headers, response_headers);
+    };
+
+    // Small enough to be packed, and enough of them to fill the first segment.
+    static constexpr size_t packed_size = 60 * KiB;
+    static constexpr size_t entry_count = 150;
+
+    TRY_OR_FAIL(write_entry(0, packed_size));
+    auto first_url = parse_url("https://example.com/0.bin"sv);
+    auto first_body_file = TRY_OR_FAIL(read_cache_entry_body_file(disk_cache, request, first_url, *request_headers));
+    auto first_body = TRY_OR_FAIL(Core::ImmutableBytes::map_from_fd_range_and_close(first_body_file.fd, "cache body"sv, first_body_file.offset, first_body_file.size));
+
+    // Entries appended after the first must not disturb it.
+    for (size_t i = 1; i < entry_count; ++i)
+        TRY_OR_FAIL(write_entry(i, packed_size));
+    EXPECT_EQ(first_body.bytes(), body_for_entry(0, packed_size).bytes());
+
+    // Replacing the other entries with bodies too large to be packed leaves little alive in the first segment, which
+    // is then compacted and removed.
+    for (size_t i = 1; i < entry_count; ++i)
+        TRY_OR_FAIL(write_entry(i, 2 * packed_size));
+
+    auto first_segment_path = HTTP::path_for_cache_segment(disk_cache.cache_directory(), 1);
+    while (FileSystem::exists(first_segment_path.string()))
+        event_loop.pump(Core::EventLoop::WaitMode::PollForEvents);
+
+    EXPECT_EQ(first_body.bytes(), body_for_entry(0, packed_size).bytes());
+    EXPECT_EQ(read_cache_entry_body(disk_cache, request, first_url, *request_headers).bytes(), body_for_entry(0, packed_size).bytes());
+    EXPECT_EQ(read_cache_entry_body(disk_cache, request, parse_url("https://example.com/1.bin"sv), *request_headers).bytes(), body_for_entry(1, 2 * packed_size).bytes());
+}
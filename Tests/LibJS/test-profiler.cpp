@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/JsonArray.h>
+#include <AK/JsonObject.h>
+#include <AK/JsonValue.h>
+#include <LibJS/Profiler.h>
+#include <LibJS/Runtime/GlobalObject.h>
+#include <LibJS/Runtime/VM.h>
+#include <LibJS/Script.h>
+#include <LibTest/TestCase.h>
+
+// Keeps the VM busy in a function of its own for long enough to collect a good number of samples.
+static constexpr auto busy_script = "function spin() {\n"
+                                    "    let end = Date.now() + 100;\n"
+                                    "    while (Date.now() < end) {}\n"
+                                    "}\n"
+                                    "spin();\n"sv;
+
+[[nodiscard]] static NonnullOwnPtr<JS::ExecutionContext> run_profiled(JS::VM& vm, StringView source)
+{
+    auto root_execution_context = JS::create_simple_execution_context<JS::GlobalObject>(vm);
+    auto& realm = *root_execution_context->realm;
+
+    auto script_or_error = JS::Script::parse(source, realm, "profiler.js"sv);
+    VERIFY(!script_or_error.is_error());
+
+    vm.enable_profiling();
+    MUST(vm.profiler()->start(AK::Duration::from_microseconds(200)));
+    auto result = vm.run(*script_or_error.value());
+    vm.profiler()->stop();
+    EXPECT(!result.is_error());
+    return root_execution_context;
+}
+
+TEST_CASE(profiler_rejects_a_zero_sampling_interval)
+{
+    if (!JS::Profiler::is_supported())
+        return;
+
+    auto vm = JS::VM::create();
+    vm->enable_profiling();
+    EXPECT(vm->profiler()->start(AK::Duration::zero()).is_error());
+    EXPECT(!vm->profiler()->is_running());
+}
+
+TEST_CASE(collapsed_stacks_have_one_line_per_stack_with_its_sample_count)
+{
+    if (!JS::Profiler::is_supported())
+        return;
+
+    auto vm = JS::VM::create();
+    auto root_execution_context = run_profiled(*vm, busy_script);
+
+    auto const& profiler = *vm->profiler();
+    EXPECT(profiler.sample_count() > 0);
+
+    auto collapsed_stacks = MUST(profiler.to_collapsed_stacks());
+    EXPECT(collapsed_stacks.ends_with('\n'));
+
+    size_t total_sample_count = 0;
+    bool saw_spin = false;
+    for (auto line : collapsed_stacks.bytes_as_string_view().lines()) {
+        auto separator = line.find_last(' ');
+        VERIFY(separator.has_value());
+
+        auto count = line.substring_view(*separator + 1).to_number<size_t>();
+        VERIFY(count.has_value());
+        EXPECT(*count > 0);
+        total_sample_count += *count;
+
+        // The outermost frame comes first.
+        auto frames = line.substring_view(0, *separator).split_view(';');
+        EXPECT(!frames.is_empty());
+        if (frames.size() >= 2 && frames[1].starts_with("spin (profiler.js:"sv)) {
+            EXPECT(frames[0].starts_with("(top-level) (profiler.js:"sv));
+            saw_spin = true;
+        }
+    }
+
+    EXPECT_EQ(total_sample_count, profiler.sample_count());
+    EXPECT(saw_spin);
+}
+
+TEST_CASE(cpu_profile_nodes_samples_and_time_deltas_are_consistent)
+{
+    if (!JS::Profiler::is_supported())
+        return;
+
+    auto vm = JS::VM::create();
+    auto root_execution_context = run_profiled(*vm, busy_script);
+
+    auto const& profiler = *vm->profiler();
+    auto json = MUST(JsonValue::from_string(MUST(profiler.to_cpu_profile_json())));
+    VERIFY(json.is_object());
+    auto const& profile = json.as_object();
+
+    auto nodes = profile.get_array("nodes"sv);
+    auto samples = profile.get_array("samples"sv);
+    auto time_deltas = profile.get_array("timeDeltas"sv);
+    VERIFY(nodes.has_value() && samples.has_value() && time_deltas.has_value());
+
+    EXPECT_EQ(samples->size(), profiler.sample_count());
+    EXPECT_EQ(time_deltas->size(), samples->size());
+    EXPECT(profile.get_integer<i64>("startTime"sv).value() <= profile.get_integer<i64>("endTime"sv).value());
+
+    // Node ids are 1-based indices into the node array, with the root first.
+    auto const& root = nodes->at(0).as_object();
+    EXPECT_EQ(root.get_integer<u32>("id"sv).value(), 1u);
+    EXPECT_EQ(root.get_object("callFrame"sv)->get_string("functionName"sv).value(), "(root)"sv);
+
+    u64 total_hit_count = 0;
+    bool saw_spin = false;
+    for (size_t i = 0; i < nodes->size(); ++i) {
+        auto const& node = nodes->at(i).as_object();
+        EXPECT_EQ(node.get_integer<u32>("id"sv).value(), i + 1);
+        total_hit_count += node.get_integer<u32>("hitCount"sv).value();
+
+        node.get_array("children"sv)->for_each([&](JsonValue const& child) {
+            auto child_id = child.get_integer<u32>().value();
+            EXPECT(child_id > i + 1 && child_id <= nodes->size());
+        });
+
+        auto const& call_frame = *node.get_object("callFrame"sv);
+        if (call_frame.get_string("functionName"sv).value() == "spin"sv) {
+            saw_spin = true;
+            EXPECT_EQ(call_frame.get_string("url"sv).value(), "profiler.js"sv);
+            // Zero-based, so the function's first line is below the line count of the script.
+            auto line_number = call_frame.get_integer<i64>("lineNumber"sv).value();
+            EXPECT(line_number >= 0 && line_number < 5);
+        }
+    }
+    EXPECT_EQ(total_hit_count, profiler.sample_count());
+    EXPECT(saw_spin);
+
+    samples->for_each([&](JsonValue const& sample) {
+        auto node_id = sample.get_integer<u32>().value();
+        EXPECT(node_id >= 1 && node_id <= nodes->size());
+    });
+}
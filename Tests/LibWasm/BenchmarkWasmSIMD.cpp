@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/MemoryStream.h>
+#include <LibCore/File.h>
+#include <LibTest/TestCase.h>
+#include <LibWasm/AbstractMachine/AbstractMachine.h>
+
+// Both inputs of the kernel fill half of its single page of memory.
+static constexpr i32 vector_count = 2048;
+static constexpr size_t iteration_count = 200;
+
+static void run_simd_kernel(Wasm::CompileToNative compile_to_native)
+{
+    auto file = MUST(Core::File::open("Fixtures/simd-kernel.wasm"sv, Core::File::OpenMode::Read));
+    auto bytes = MUST(file->read_until_eof());
+    FixedMemoryStream stream { bytes.bytes() };
+    auto module = MUST(Wasm::Module::parse(stream));
+
+    Wasm::AbstractMachine machine;
+    MUST(machine.validate(*module, {}, compile_to_native));
+    auto instance = MUST(machine.instantiate(*module, {}));
+
+    auto find_export = [&](StringView name) {
+        for (auto const& export_ : instance->exports()) {
+            if (export_.name() == name)
+                return export_.value().get<Wasm::FunctionAddress>();
+        }
+        VERIFY_NOT_REACHED();
+    };
+    auto fill = find_export("fill"sv);
+    auto dot = find_export("dot"sv);
+
+    EXPECT(!machine.invoke(fill, { Wasm::Value(vector_count), Wasm::Value(1.0f), Wasm::Value(1.0f) }).is_trap());
+    for (size_t i = 0; i < iteration_count; ++i) {
+        auto result = machine.invoke(dot, { Wasm::Value(vector_count) });
+        EXPECT_EQ(result.values()[0].to<float>(), static_cast<float>(vector_count * 4));
+    }
+}
+
+BENCHMARK_CASE(simd_dot_product_interpreter)
+{
+    run_simd_kernel(Wasm::CompileToNative::No);
+}
+
+BENCHMARK_CASE(simd_dot_product_cranelift)
+{
+    run_simd_kernel(Wasm::CompileToNative::Yes);
+}
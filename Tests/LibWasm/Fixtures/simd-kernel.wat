@@ -0,0 +1,39 @@
+(module
+  (memory (export "memory") 1)
+
+  ;; Splats $a into the first $count vectors of the first input, and $b into those of the second one at 32 KiB.
+  (func (export "fill") (param $count i32) (param $a f32) (param $b f32)
+    (local $offset i32)
+    (block $done
+      (loop $next
+        (br_if $done (i32.ge_u (local.get $offset) (i32.shl (local.get $count) (i32.const 4))))
+        (v128.store (local.get $offset) (f32x4.splat (local.get $a)))
+        (v128.store offset=32768 (local.get $offset) (f32x4.splat (local.get $b)))
+        (local.set $offset (i32.add (local.get $offset) (i32.const 16)))
+        (br $next))))
+
+  ;; The dot product of the first $count vectors of both inputs.
+  (func (export "dot") (param $count i32) (result f32)
+    (local $offset i32)
+    (local $sum v128)
+    (block $done
+      (loop $next
+        (br_if $done (i32.ge_u (local.get $offset) (i32.shl (local.get $count) (i32.const 4))))
+        (local.set $sum
+          (f32x4.relaxed_madd
+            (v128.load (local.get $offset))
+            (v128.load offset=32768 (local.get $offset))
+            (local.get $sum)))
+        (local.set $offset (i32.add (local.get $offset) (i32.const 16)))
+        (br $next)))
+    (f32.add
+      (f32.add (f32x4.extract_lane 0 (local.get $sum)) (f32x4.extract_lane 1 (local.get $sum)))
+      (f32.add (f32x4.extract_lane 2 (local.get $sum)) (f32x4.extract_lane 3 (local.get $sum)))))
+
+  ;; -($a * $b) + $c
+  (func (export "nmadd") (param $a f32) (param $b f32) (param $c f32) (result f32)
+    (f32x4.extract_lane 0
+      (f32x4.relaxed_nmadd
+        (f32x4.splat (local.get $a))
+        (f32x4.splat (local.get $b))
+        (f32x4.splat (local.get $c))))))
@@ -100,3 +100,38 @@ TEST_CASE(compiled_memory_access_traps_out_of_bounds)
     expect_oob_trap(invoke(load_high, { Wasm::Value(static_cast<i32>(0)) }));
     expect_oob_trap(invoke(load_high, { Wasm::Value(static_cast<i32>(0xffffffff)) }));
 }
+
+static Wasm::FunctionAddress find_function_export(Wasm::ModuleInstance const& instance, StringView name)
+{
+    for (auto const& export_ : instance.exports()) {
+        if (export_.name() == name)
+            return export_.value().get<Wasm::FunctionAddress>();
+    }
+    VERIFY_NOT_REACHED();
+}
+
+TEST_CASE(simd_kernel_gives_the_same_results_in_both_tiers)
+{
+    auto file = MUST(Core::File::open("Fixtures/simd-kernel.wasm"sv, Core::File::OpenMode::Read));
+    auto bytes = MUST(file->read_until_eof());
+
+    for (auto compile_to_native : { Wasm::CompileToNative::No, Wasm::CompileToNative::Yes }) {
+        FixedMemoryStream stream { bytes.bytes() };
+        auto module = MUST(Wasm::Module::parse(stream));
+
+        Wasm::AbstractMachine machine;
+        EXPECT(!machine.validate(*module, {}, compile_to_native).is_error());
+        auto instance = MUST(machine.instantiate(*module, {}));
+
+        // relaxed_nmadd is -(a * b) + c, not a * b - c.
+        auto nmadd = machine.invoke(find_function_export(*instance, "nmadd"sv), { Wasm::Value(2.0f), Wasm::Value(3.0f), Wasm::Value(10.0f) });
+        EXPECT(!nmadd.is_trap());
+        EXPECT_EQ(nmadd.values()[0].to<float>(), 4.0f);
+
+        auto fill = machine.invoke(find_function_export(*instance, "fill"sv), { Wasm::Value(static_cast<i32>(2048)), Wasm::Value(1.5f), Wasm::Value(2.0f) });
+        EXPECT(!fill.is_trap());
+        auto dot = machine.invoke(find_function_export(*instance, "dot"sv), { Wasm::Value(static_cast<i32>(2048)) });
+        EXPECT(!dot.is_trap());
+        EXPECT_EQ(dot.values()[0].to<float>(), 2048 * 4 * 1.5f * 2.0f);
+    }
+}
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibCore/File.h>
+#include <LibTest/TestCase.h>
+#include <LibWasm/AbstractMachine/AbstractMachine.h>
+#include <LibWasm/AbstractMachine/StreamingCompiler.h>
+
+static ByteBuffer read_fixture(StringView path)
+{
+    auto file = MUST(Core::File::open(path, Core::File::OpenMode::Read));
+    return MUST(file->read_until_eof());
+}
+
+static ErrorOr<NonnullRefPtr<Wasm::Module>, Wasm::ValidationError> stream_module(ReadonlyBytes bytes, size_t chunk_size)
+{
+    Wasm::StreamingCompiler compiler;
+    for (size_t offset = 0; offset < bytes.size(); offset += chunk_size)
+        TRY(compiler.append(bytes.slice(offset, min(chunk_size, bytes.size() - offset))));
+    return compiler.finish({}, {});
+}
+
+static Wasm::FunctionAddress find_function_export(Wasm::ModuleInstance const& instance, StringView name)
+{
+    for (auto const& export_ : instance.exports()) {
+        if (export_.name() == name)
+            return export_.value().get<Wasm::FunctionAddress>();
+    }
+    VERIFY_NOT_REACHED();
+}
+
+TEST_CASE(streamed_module_runs_whatever_the_chunk_boundaries)
+{
+    auto bytes = read_fixture("Fixtures/simd-kernel.wasm"sv);
+
+    // Chunks of one byte split every LEB128 and every code section entry; the last size delivers it all at once.
+    for (size_t chunk_size : { 1uz, 3uz, 16uz, 64uz, bytes.size() }) {
+        auto module = MUST(stream_module(bytes, chunk_size));
+        EXPECT_EQ(module->validation_status(), Wasm::Module::ValidationStatus::Valid);
+        EXPECT_EQ(module->code_section().functions().size(), 3u);
+
+        Wasm::AbstractMachine machine;
+        auto instance = MUST(machine.instantiate(*module, {}));
+
+        auto nmadd = machine.invoke(find_function_export(*instance, "nmadd"sv), { Wasm::Value(2.0f), Wasm::Value(3.0f), Wasm::Value(10.0f) });
+        EXPECT(!nmadd.is_trap());
+        EXPECT_EQ(nmadd.values()[0].to<float>(), 4.0f);
+
+        auto fill = machine.invoke(find_function_export(*instance, "fill"sv), { Wasm::Value(static_cast<i32>(64)), Wasm::Value(1.5f), Wasm::Value(2.0f) });
+        EXPECT(!fill.is_trap());
+        auto dot = machine.invoke(find_function_export(*instance, "dot"sv), { Wasm::Value(static_cast<i32>(64)) });
+        EXPECT(!dot.is_trap());
+        EXPECT_EQ(dot.values()[0].to<float>(), 64 * 4 * 1.5f * 2.0f);
+    }
+}
+
+TEST_CASE(streamed_module_without_a_code_section)
+{
+    // (module (memory (export "memory") 1))
+    constexpr Array<u8, 25> bytes {
+        0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00,
+        0x05, 0x03, 0x01, 0x00, 0x01,
+        0x07, 0x0a, 0x01, 0x06, 0x6d, 0x65, 0x6d, 0x6f, 0x72, 0x79, 0x02, 0x00
+    };
+
+    auto module = MUST(stream_module(bytes, 1));
+    EXPECT_EQ(module->validation_status(), Wasm::Module::ValidationStatus::Valid);
+    EXPECT_EQ(module->export_section().entries().size(), 1u);
+}
+
+TEST_CASE(truncated_module_is_rejected)
+{
+    auto bytes = read_fixture("Fixtures/simd-kernel.wasm"sv);
+
+    // Ending inside the last code section entry, and ending just after the header.
+    for (auto size : { bytes.size() - 1, 8uz }) {
+        auto result = stream_module(bytes.bytes().trim(size), 7);
+        EXPECT(result.is_error());
+    }
+}
+
+TEST_CASE(invalid_function_body_is_rejected)
+{
+    // (module (func (result i32)))
+    constexpr Array<u8, 25> bytes {
+        0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00,
+        0x01, 0x05, 0x01, 0x60, 0x00, 0x01, 0x7f,
+        0x03, 0x02, 0x01, 0x00,
+        0x0a, 0x04, 0x01, 0x02, 0x00, 0x0b
+    };
+
+    Wasm::StreamingCompiler compiler;
+    auto append_result = compiler.append(bytes);
+    // The body is validated as soon as it has been parsed, before the end of the module is known.
+    EXPECT(append_result.is_error());
+}
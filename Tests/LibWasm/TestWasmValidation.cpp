@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/HashMap.h>
+#include <AK/MemoryStream.h>
+#include <LibCore/System.h>
+#include <LibTest/TestCase.h>
+#include <LibWasm/AbstractMachine/AbstractMachine.h>
+#include <LibWasm/AbstractMachine/Validator.h>
+
+// Large enough for the code section to be validated on several threads.
+static constexpr size_t function_count = 1024;
+
+static void append_leb128(ByteBuffer& buffer, u32 value)
+{
+    do {
+        u8 byte = value & 0x7f;
+        value >>= 7;
+        buffer.append(value != 0 ? static_cast<u8>(byte | 0x80) : byte);
+    } while (value != 0);
+}
+
+static void append_section(ByteBuffer& module, u8 id, ByteBuffer const& contents)
+{
+    module.append(id);
+    append_leb128(module, static_cast<u32>(contents.size()));
+    module.append(contents);
+}
+
+// Every function is (i32) -> i32. Every fourth one returns its argument plus one, the others call the function right
+// before them and add one to its result, so that most bodies have to wait for their callee to be validated first.
+// The last function is exported as "last"; the bodies in `replaced_bodies` are used instead of the generated ones.
+static ByteBuffer build_call_chain_module(HashMap<size_t, Vector<u8>> const& replaced_bodies = {})
+{
+    ByteBuffer module;
+    module.append("\0asm\1\0\0\0"sv.bytes());
+
+    ByteBuffer types;
+    types.append(to_array<u8>({ 0x01, 0x60, 0x01, 0x7f, 0x01, 0x7f }).span());
+    append_section(module, 0x01, types);
+
+    ByteBuffer functions;
+    append_leb128(functions, static_cast<u32>(function_count));
+    for (size_t i = 0; i < function_count; ++i)
+        functions.append(0x00);
+    append_section(module, 0x03, functions);
+
+    ByteBuffer exports;
+    append_leb128(exports, 1);
+    append_leb128(exports, 4);
+    exports.append("last"sv.bytes());
+    exports.append(0x00);
+    append_leb128(exports, static_cast<u32>(function_count - 1));
+    append_section(module, 0x07, exports);
+
+    ByteBuffer code;
+    append_leb128(code, static_cast<u32>(function_count));
+    for (size_t i = 0; i < function_count; ++i) {
+        ByteBuffer body;
+        body.append(0x00);
+        if (auto replaced_body = replaced_bodies.get(i); replaced_body.has_value()) {
+            body.append(replaced_body->span());
+        } else {
+            body.append(to_array<u8>({ 0x20, 0x00 }).span());
+            if (i % 4 != 0) {
+                body.append(0x10);
+                append_leb128(body, static_cast<u32>(i - 1));
+            }
+            body.append(to_array<u8>({ 0x41, 0x01, 0x6a }).span());
+        }
+        body.append(0x0b);
+        append_leb128(code, static_cast<u32>(body.size()));
+        code.append(body);
+    }
+    append_section(module, 0x0a, code);
+
+    return module;
+}
+
+static NonnullRefPtr<Wasm::Module> parse_module(ReadonlyBytes bytes)
+{
+    FixedMemoryStream stream { bytes };
+    return MUST(Wasm::Module::parse(stream));
+}
+
+static void expect_code_section_was_split_over_threads(Wasm::Validator const& validator)
+{
+    if (Core::System::hardware_concurrency() > 1)
+        EXPECT(validator.code_section_thread_count() > 1);
+    else
+        EXPECT_EQ(validator.code_section_thread_count(), 1u);
+}
+
+TEST_CASE(parallel_validation_produces_the_same_code_as_sequential_validation)
+{
+    auto bytes = build_call_chain_module();
+
+    auto parallel_module = parse_module(bytes);
+    Wasm::Validator parallel_validator;
+    MUST(parallel_validator.validate(*parallel_module));
+    expect_code_section_was_split_over_threads(parallel_validator);
+
+    // Going through the code section one function at a time, like the streaming compiler does, never uses threads.
+    auto sequential_module = parse_module(bytes);
+    Wasm::Validator sequential_validator;
+    MUST(sequential_validator.begin_validation(*sequential_module));
+    auto const& sequential_functions = sequential_module->code_section().functions();
+    for (size_t code_index = 0; code_index < sequential_functions.size(); ++code_index)
+        MUST(sequential_validator.validate_function(sequential_functions[code_index].func(), code_index));
+    MUST(sequential_validator.finish_validation(*sequential_module));
+
+    // Callees are inlined, so this only matches if every body saw the same validated callees.
+    auto const& parallel_functions = parallel_module->code_section().functions();
+    for (size_t code_index = 0; code_index < function_count; ++code_index) {
+        auto const& parallel = parallel_functions[code_index].func().body().compiled_instructions;
+        auto const& sequential = sequential_functions[code_index].func().body().compiled_instructions;
+        EXPECT_EQ(parallel.dispatches.size(), sequential.dispatches.size());
+        EXPECT_EQ(parallel.max_call_rec_size, sequential.max_call_rec_size);
+    }
+    EXPECT_EQ(parallel_module->minimum_call_record_allocation_size(), sequential_module->minimum_call_record_allocation_size());
+
+    Wasm::AbstractMachine machine;
+    auto instance = MUST(machine.instantiate(*parallel_module, {}));
+    Optional<Wasm::FunctionAddress> last;
+    for (auto const& export_ : instance->exports()) {
+        if (export_.name() == "last"sv)
+            last = export_.value().get<Wasm::FunctionAddress>();
+    }
+    VERIFY(last.has_value());
+
+    // The last function is three calls away from one that doesn't call anything.
+    auto result = machine.invoke(*last, { Wasm::Value(static_cast<i32>(10)) });
+    EXPECT(!result.is_trap());
+    EXPECT_EQ(result.values()[0].to<i32>(), 14);
+}
+
+TEST_CASE(parallel_validation_reports_the_first_invalid_function)
+{
+    HashMap<size_t, Vector<u8>> replaced_bodies;
+    // f32.const 0
+    replaced_bodies.set(700, { 0x43, 0x00, 0x00, 0x00, 0x00 });
+    // i64.const 0
+    replaced_bodies.set(900, { 0x42, 0x00 });
+
+    auto module = parse_module(build_call_chain_module(replaced_bodies));
+    Wasm::Validator validator;
+    auto result = validator.validate(*module);
+    expect_code_section_was_split_over_threads(validator);
+
+    VERIFY(result.is_error());
+    EXPECT(result.error().error_string.contains("f32"sv));
+    EXPECT(!result.error().error_string.contains("i64"sv));
+    EXPECT_EQ(module->validation_status(), Wasm::Module::ValidationStatus::Invalid);
+}
@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+#include <LibWeb/Painting/DisplayList.h>
+#include <LibWeb/Painting/DisplayListOptimizer.h>
+
+using namespace Web::Painting;
+
+struct OptimizedCommand {
+    DisplayListCommandType type;
+    Gfx::IntRect bounding_rect;
+};
+
+static Vector<OptimizedCommand> optimized_commands(DisplayList const& display_list, AccumulatedVisualContextTree const& visual_context_tree, DisplayListOptimizationStatistics& statistics)
+{
+    auto optimized_display_list = optimize_display_list(display_list, visual_context_tree, statistics);
+    EXPECT_NE(optimized_display_list->id(), display_list.id());
+
+    Vector<OptimizedCommand> commands;
+    optimized_display_list->for_each_command_header([&](DisplayListCommandHeader const& header, ReadonlyBytes) {
+        commands.append({ header.type, header.bounding_rect });
+    });
+    EXPECT_EQ(commands.size(), statistics.commands_after);
+    return commands;
+}
+
+static void append_glyph_run(DisplayList& display_list, AccumulatedVisualContextTree const& visual_context_tree, Gfx::FloatPoint translation, u32 glyph_id)
+{
+    DisplayListGlyph glyph { .position = { 1, 0 }, .glyph_id = glyph_id };
+    auto bounding_rect = Gfx::IntRect { translation.to_type<int>(), { 8, 10 } };
+    display_list.append(
+        DrawGlyphRun {
+            .font_id = FontResourceId { 1 },
+            .glyphs = { static_cast<u32>(sizeof(DrawGlyphRun)), static_cast<u32>(sizeof(glyph)) },
+            .rect = bounding_rect,
+            .glyph_bounding_rect = bounding_rect,
+            .translation = translation,
+            .scale = 1,
+            .color = Gfx::Color::Black,
+            .orientation = Gfx::Orientation::Horizontal,
+        },
+        visual_context_tree,
+        VISUAL_VIEWPORT_NODE_INDEX,
+        false,
+        display_list_object_bytes(glyph));
+}
+
+TEST_CASE(adjacent_fills_of_the_same_color_are_merged)
+{
+    auto visual_context_tree = AccumulatedVisualContextTree::create();
+    auto display_list = DisplayList::create(visual_context_tree);
+    display_list->append(FillRect { { 0, 0, 10, 10 }, Gfx::Color::Red }, visual_context_tree, VISUAL_VIEWPORT_NODE_INDEX, false);
+    display_list->append(FillRect { { 10, 0, 10, 10 }, Gfx::Color::Red }, visual_context_tree, VISUAL_VIEWPORT_NODE_INDEX, false);
+    display_list->append(FillRect { { 0, 10, 20, 5 }, Gfx::Color::Red }, visual_context_tree, VISUAL_VIEWPORT_NODE_INDEX, false);
+    display_list->append(FillRect { { 0, 15, 20, 5 }, Gfx::Color::Blue }, visual_context_tree, VISUAL_VIEWPORT_NODE_INDEX, false);
+
+    DisplayListOptimizationStatistics statistics;
+    auto commands = optimized_commands(*display_list, visual_context_tree, statistics);
+    EXPECT_EQ(statistics.commands_before, 4u);
+    EXPECT_EQ(statistics.merged_commands, 2u);
+    EXPECT_EQ(commands.size(), 2u);
+    EXPECT_EQ(commands[0].bounding_rect, Gfx::IntRect(0, 0, 20, 15));
+    EXPECT_EQ(commands[1].bounding_rect, Gfx::IntRect(0, 15, 20, 5));
+}
+
+TEST_CASE(glyph_runs_on_the_same_baseline_are_merged)
+{
+    auto visual_context_tree = AccumulatedVisualContextTree::create();
+    auto display_list = DisplayList::create(visual_context_tree);
+    append_glyph_run(*display_list, visual_context_tree, { 10, 20 }, 1);
+    append_glyph_run(*display_list, visual_context_tree, { 20, 20 }, 2);
+    append_glyph_run(*display_list, visual_context_tree, { 30, 40 }, 3);
+
+    DisplayListOptimizationStatistics statistics;
+    auto optimized_display_list = optimize_display_list(*display_list, visual_context_tree, statistics);
+    EXPECT_EQ(statistics.merged_commands, 1u);
+    EXPECT_EQ(statistics.commands_after, 2u);
+
+    Vector<Vector<DisplayListGlyph>> runs;
+    optimized_display_list->for_each_command_header([&](DisplayListCommandHeader const& header, ReadonlyBytes payload) {
+        VERIFY(header.type == DisplayListCommandType::DrawGlyphRun);
+        auto run = read_display_list_command_payload<DrawGlyphRun>(payload);
+        Vector<DisplayListGlyph> glyphs;
+        for (size_t offset = 0; offset < run.glyphs.size; offset += sizeof(DisplayListGlyph))
+            glyphs.append(read_display_list_object<DisplayListGlyph>(payload.slice(run.glyphs.offset + offset)));
+        runs.append(move(glyphs));
+    });
+
+    EXPECT_EQ(runs.size(), 2u);
+    EXPECT_EQ(runs[0].size(), 2u);
+    EXPECT_EQ(runs[0][0].glyph_id, 1u);
+    EXPECT_EQ(runs[0][0].position, Gfx::FloatPoint(1, 0));
+    EXPECT_EQ(runs[0][1].glyph_id, 2u);
+    EXPECT_EQ(runs[0][1].position, Gfx::FloatPoint(11, 0));
+    EXPECT_EQ(runs[1].size(), 1u);
+}
+
+TEST_CASE(saves_that_nothing_is_drawn_under_are_dropped)
+{
+    auto visual_context_tree = AccumulatedVisualContextTree::create();
+    auto display_list = DisplayList::create(visual_context_tree);
+    display_list->append(Save {}, visual_context_tree, VISUAL_VIEWPORT_NODE_INDEX, false);
+    display_list->append(AddClipRect { { 0, 0, 10, 10 } }, visual_context_tree, VISUAL_VIEWPORT_NODE_INDEX, false);
+    display_list->append(SaveLayer {}, visual_context_tree, VISUAL_VIEWPORT_NODE_INDEX, false);
+    display_list->append(Restore {}, visual_context_tree, VISUAL_VIEWPORT_NODE_INDEX, false);
+    display_list->append(Restore {}, visual_context_tree, VISUAL_VIEWPORT_NODE_INDEX, false);
+    display_list->append(Save {}, visual_context_tree, VISUAL_VIEWPORT_NODE_INDEX, false);
+    display_list->append(FillRect { { 0, 0, 10, 10 }, Gfx::Color::Red }, visual_context_tree, VISUAL_VIEWPORT_NODE_INDEX, false);
+    display_list->append(Restore {}, visual_context_tree, VISUAL_VIEWPORT_NODE_INDEX, false);
+
+    DisplayListOptimizationStatistics statistics;
+    auto commands = optimized_commands(*display_list, visual_context_tree, statistics);
+    EXPECT_EQ(statistics.dropped_state_changes, 5u);
+    EXPECT_EQ(commands.size(), 3u);
+    EXPECT_EQ(commands[0].type, DisplayListCommandType::Save);
+    EXPECT_EQ(commands[1].type, DisplayListCommandType::FillRect);
+    EXPECT_EQ(commands[2].type, DisplayListCommandType::Restore);
+}
+
+TEST_CASE(commands_outside_of_their_clip_are_culled)
+{
+    auto visual_context_tree = AccumulatedVisualContextTree::create();
+    auto clip_index = visual_context_tree.append(ClipData { Web::DevicePixelRect { 0, 0, 50, 50 }, {} }, VISUAL_VIEWPORT_NODE_INDEX);
+    auto display_list = DisplayList::create(visual_context_tree);
+    display_list->append(FillRect { { 100, 100, 10, 10 }, Gfx::Color::Red }, visual_context_tree, clip_index, false);
+    display_list->append(FillRect { { 40, 40, 20, 20 }, Gfx::Color::Blue }, visual_context_tree, clip_index, false);
+    // Geometry-only commands ignore the clip.
+    display_list->append(FillRect { { 100, 100, 10, 10 }, Gfx::Color::Green }, visual_context_tree, clip_index, true);
+
+    DisplayListOptimizationStatistics statistics;
+    auto commands = optimized_commands(*display_list, visual_context_tree, statistics);
+    EXPECT_EQ(statistics.culled_commands, 1u);
+    EXPECT_EQ(commands.size(), 2u);
+    EXPECT_EQ(commands[0].bounding_rect, Gfx::IntRect(40, 40, 20, 20));
+}
+
+TEST_CASE(commands_covered_by_an_opaque_fill_are_dropped)
+{
+    auto visual_context_tree = AccumulatedVisualContextTree::create();
+    auto display_list = DisplayList::create(visual_context_tree);
+    display_list->append(FillRect { { 10, 10, 10, 10 }, Gfx::Color::Blue }, visual_context_tree, VISUAL_VIEWPORT_NODE_INDEX, false);
+    // Only partially covered at the edge of the fill.
+    display_list->append(FillRect { { 0, 0, 5, 5 }, Gfx::Color::Green }, visual_context_tree, VISUAL_VIEWPORT_NODE_INDEX, false);
+    display_list->append(FillRect { { 0, 0, 100, 100 }, Gfx::Color::Red }, visual_context_tree, VISUAL_VIEWPORT_NODE_INDEX, false);
+    display_list->append(FillRect { { 30, 30, 10, 10 }, Gfx::Color::Blue }, visual_context_tree, VISUAL_VIEWPORT_NODE_INDEX, false);
+    display_list->append(FillRect { { 0, 0, 100, 100 }, Gfx::Color(255, 0, 0, 128) }, visual_context_tree, VISUAL_VIEWPORT_NODE_INDEX, false);
+
+    DisplayListOptimizationStatistics statistics;
+    auto commands = optimized_commands(*display_list, visual_context_tree, statistics);
+    EXPECT_EQ(statistics.occluded_commands, 1u);
+    EXPECT_EQ(commands.size(), 4u);
+    EXPECT_EQ(commands[0].bounding_rect, Gfx::IntRect(0, 0, 5, 5));
+}
+
+TEST_CASE(commands_under_a_transform_are_not_dropped_for_occlusion)
+{
+    auto visual_context_tree = AccumulatedVisualContextTree::create();
+    auto transform_index = visual_context_tree.append(TransformData { Gfx::scale_matrix(Gfx::FloatVector3 { 0.5f, 0.5f, 1 }), {} }, VISUAL_VIEWPORT_NODE_INDEX);
+    auto display_list = DisplayList::create(visual_context_tree);
+    display_list->append(FillRect { { 10, 10, 10, 10 }, Gfx::Color::Blue }, visual_context_tree, transform_index, false);
+    display_list->append(FillRect { { 0, 0, 100, 100 }, Gfx::Color::Red }, visual_context_tree, transform_index, false);
+
+    DisplayListOptimizationStatistics statistics;
+    auto commands = optimized_commands(*display_list, visual_context_tree, statistics);
+    EXPECT_EQ(statistics.occluded_commands, 0u);
+    EXPECT_EQ(commands.size(), 2u);
+}
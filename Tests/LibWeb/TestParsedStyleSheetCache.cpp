@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/StringBuilder.h>
+#include <LibTest/TestCase.h>
+#include <LibURL/Parser.h>
+#include <LibWeb/CSS/Parser/ComponentValue.h>
+#include <LibWeb/CSS/Parser/ParsedStyleSheetCache.h>
+
+using Web::CSS::Parser::ParsedStyleSheetCache;
+
+static URL::URL parse_url(StringView url)
+{
+    return URL::Parser::basic_parse(url).release_value();
+}
+
+static Utf16String style_sheet_source(StringView color)
+{
+    StringBuilder builder;
+    while (builder.length() < ParsedStyleSheetCache::MINIMUM_SOURCE_LENGTH)
+        builder.appendff(".item-{} {{ color: {}; }}\n", builder.length(), color);
+    return Utf16String::from_utf8(builder.string_view());
+}
+
+static NonnullRefPtr<ParsedStyleSheetCache::Entry const> create_entry(Utf16String source)
+{
+    return adopt_ref(*new ParsedStyleSheetCache::Entry(move(source), {}));
+}
+
+TEST_CASE(small_style_sheets_are_not_cached)
+{
+    auto source = style_sheet_source("red"sv);
+    EXPECT(!ParsedStyleSheetCache::is_cacheable(u".item { color: red; }"sv));
+    EXPECT(ParsedStyleSheetCache::is_cacheable(source));
+}
+
+TEST_CASE(style_sheets_are_found_by_url_and_contents)
+{
+    auto& cache = ParsedStyleSheetCache::the();
+    cache.clear();
+
+    auto url = parse_url("https://example.com/styles/site.css"sv);
+    auto source = style_sheet_source("red"sv);
+    auto entry = create_entry(source);
+    cache.insert(url, entry);
+
+    auto hits = cache.statistics().hits;
+    auto misses = cache.statistics().misses;
+
+    EXPECT(cache.contains(url, source));
+    EXPECT_EQ(cache.find(url, source).ptr(), entry.ptr());
+    EXPECT_EQ(cache.statistics().hits, hits + 1);
+
+    // The same contents at another URL resolve their relative URLs against a different base.
+    EXPECT(!cache.find(parse_url("https://example.com/other/site.css"sv), source));
+
+    // The same URL may serve different contents over time.
+    auto changed_source = style_sheet_source("blue"sv);
+    EXPECT(!cache.find(url, changed_source));
+
+    EXPECT_EQ(cache.statistics().hits, hits + 1);
+    EXPECT_EQ(cache.statistics().misses, misses + 2);
+}
+
+TEST_CASE(inserting_at_the_same_url_replaces_the_entry)
+{
+    auto& cache = ParsedStyleSheetCache::the();
+    cache.clear();
+
+    auto url = parse_url("https://example.com/site.css"sv);
+    auto old_source = style_sheet_source("red"sv);
+    auto new_source = style_sheet_source("blue"sv);
+
+    cache.insert(url, create_entry(old_source));
+    auto new_entry = create_entry(new_source);
+    cache.insert(url, new_entry);
+
+    EXPECT(!cache.contains(url, old_source));
+    EXPECT_EQ(cache.find(url, new_source).ptr(), new_entry.ptr());
+}
+
+TEST_CASE(least_recently_used_style_sheets_are_evicted)
+{
+    auto& cache = ParsedStyleSheetCache::the();
+    cache.clear();
+
+    auto source = style_sheet_source("red"sv);
+    auto url_for = [](size_t index) { return parse_url(ByteString::formatted("https://example.com/{}.css", index)); };
+
+    for (size_t i = 0; i < ParsedStyleSheetCache::MAXIMUM_ENTRY_COUNT; ++i)
+        cache.insert(url_for(i), create_entry(source));
+
+    // Using the oldest entry keeps it around, so the next oldest is evicted instead.
+    EXPECT(cache.find(url_for(0), source));
+
+    auto evictions = cache.statistics().evictions;
+    cache.insert(url_for(ParsedStyleSheetCache::MAXIMUM_ENTRY_COUNT), create_entry(source));
+    EXPECT_EQ(cache.statistics().evictions, evictions + 1);
+
+    EXPECT(cache.contains(url_for(0), source));
+    EXPECT(!cache.contains(url_for(1), source));
+    EXPECT(cache.contains(url_for(ParsedStyleSheetCache::MAXIMUM_ENTRY_COUNT), source));
+}
+
+TEST_CASE(clearing_drops_every_style_sheet)
+{
+    auto& cache = ParsedStyleSheetCache::the();
+    cache.clear();
+
+    auto url = parse_url("https://example.com/site.css"sv);
+    auto source = style_sheet_source("red"sv);
+    auto entry = create_entry(source);
+    cache.insert(url, entry);
+
+    cache.clear();
+    EXPECT(!cache.contains(url, source));
+
+    // Documents still using the rules keep them alive.
+    EXPECT(entry->source == source);
+}
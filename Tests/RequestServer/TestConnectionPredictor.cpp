@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/AnyOf.h>
+#include <AK/LexicalPath.h>
+#include <LibCore/EventLoop.h>
+#include <LibCore/File.h>
+#include <LibCore/StandardPaths.h>
+#include <LibFileSystem/FileSystem.h>
+#include <LibHTTP/HeaderList.h>
+#include <LibTest/TestCase.h>
+#include <LibURL/Parser.h>
+#include <RequestServer/ConnectionPredictor.h>
+
+static URL::URL parse_url(StringView url)
+{
+    return URL::Parser::basic_parse(url).release_value();
+}
+
+static LexicalPath test_history_path()
+{
+    auto path = LexicalPath::join(Core::StandardPaths::tempfile_directory(), "ladybird-test-connection-predictor.json"sv);
+    if (FileSystem::exists(path.string()))
+        MUST(FileSystem::remove(path.string(), FileSystem::RecursionMode::Disallowed));
+    return path;
+}
+
+struct NavigationResult {
+    Optional<RequestServer::ConnectionPredictor::Navigation> navigation;
+    Vector<String> preconnected_origins;
+};
+
+static NavigationResult navigate(RequestServer::ConnectionPredictor& predictor, StringView url)
+{
+    NavigationResult result;
+    result.navigation = predictor.did_start_navigation(parse_url(url), [&](URL::URL origin_url) {
+        result.preconnected_origins.append(origin_url.origin().serialize());
+    });
+    return result;
+}
+
+static bool was_preconnected(NavigationResult const& result, StringView origin)
+{
+    return any_of(result.preconnected_origins, [&](auto const& preconnected_origin) { return preconnected_origin == origin; });
+}
+
+TEST_CASE(navigation_requests_are_recognized_by_their_fetch_metadata)
+{
+    auto navigation_headers = HTTP::HeaderList::create({
+        { "Sec-Fetch-Dest"sv, "document"sv },
+        { "Sec-Fetch-Mode"sv, "navigate"sv },
+    });
+    EXPECT(RequestServer::ConnectionPredictor::is_navigation_request("GET"sv, navigation_headers));
+    EXPECT(!RequestServer::ConnectionPredictor::is_navigation_request("POST"sv, navigation_headers));
+
+    auto iframe_headers = HTTP::HeaderList::create({
+        { "Sec-Fetch-Dest"sv, "iframe"sv },
+        { "Sec-Fetch-Mode"sv, "navigate"sv },
+    });
+    EXPECT(!RequestServer::ConnectionPredictor::is_navigation_request("GET"sv, iframe_headers));
+
+    auto script_headers = HTTP::HeaderList::create({
+        { "Sec-Fetch-Dest"sv, "script"sv },
+        { "Sec-Fetch-Mode"sv, "no-cors"sv },
+    });
+    EXPECT(!RequestServer::ConnectionPredictor::is_navigation_request("GET"sv, script_headers));
+
+    EXPECT(!RequestServer::ConnectionPredictor::is_navigation_request("GET"sv, HTTP::HeaderList::create()));
+}
+
+TEST_CASE(origins_seen_during_a_navigation_are_preconnected_on_the_next_one)
+{
+    Core::EventLoop event_loop;
+    auto predictor = RequestServer::ConnectionPredictor::create(test_history_path());
+
+    // Nothing is known about the site yet.
+    auto first = navigate(*predictor, "https://www.example.com/"sv);
+    VERIFY(first.navigation.has_value());
+    EXPECT(first.preconnected_origins.is_empty());
+
+    predictor->did_start_subresource_request(*first.navigation, parse_url("https://cdn.example.net/app.js"sv));
+    predictor->did_start_subresource_request(*first.navigation, parse_url("https://cdn.example.net/app.css"sv));
+    predictor->did_start_subresource_request(*first.navigation, parse_url("https://fonts.example.org/font.woff2"sv));
+    // Requests to the document's own origin reuse its connection, so they are not learned.
+    predictor->did_start_subresource_request(*first.navigation, parse_url("https://www.example.com/image.png"sv));
+
+    EXPECT_EQ(predictor->statistics().misses, 2u);
+    EXPECT_EQ(predictor->statistics().hits, 0u);
+
+    // Another page of the same site benefits from what the first one used.
+    auto second = navigate(*predictor, "https://www.example.com/other-page"sv);
+    VERIFY(second.navigation.has_value());
+    EXPECT_EQ(second.preconnected_origins.size(), 2u);
+    EXPECT(was_preconnected(second, "https://cdn.example.net"sv));
+    EXPECT(was_preconnected(second, "https://fonts.example.org"sv));
+    EXPECT_EQ(predictor->statistics().preconnects, 2u);
+
+    predictor->did_start_subresource_request(*second.navigation, parse_url("https://cdn.example.net/app.js"sv));
+    predictor->did_start_subresource_request(*second.navigation, parse_url("https://api.example.net/data"sv));
+
+    EXPECT_EQ(predictor->statistics().navigations, 2u);
+    EXPECT_EQ(predictor->statistics().hits, 1u);
+    EXPECT_EQ(predictor->statistics().misses, 3u);
+
+    // Other sites have their own history.
+    auto unrelated = navigate(*predictor, "https://unrelated.example/"sv);
+    VERIFY(unrelated.navigation.has_value());
+    EXPECT(unrelated.preconnected_origins.is_empty());
+
+    // Non-HTTP(S) navigations are not predicted for.
+    EXPECT(!navigate(*predictor, "file:///tmp/page.html"sv).navigation.has_value());
+}
+
+TEST_CASE(only_the_most_used_origins_are_preconnected)
+{
+    Core::EventLoop event_loop;
+    auto predictor = RequestServer::ConnectionPredictor::create(test_history_path());
+
+    static constexpr Array origins {
+        "https://a.example.net"sv,
+        "https://b.example.net"sv,
+        "https://c.example.net"sv,
+        "https://d.example.net"sv,
+        "https://e.example.net"sv,
+        "https://f.example.net"sv,
+        "https://g.example.net"sv,
+        "https://h.example.net"sv,
+    };
+
+    // The origin at index i is used by the last (origins.size() - i) navigations, so earlier origins score higher.
+    for (size_t navigation_index = 0; navigation_index < origins.size(); ++navigation_index) {
+        auto result = navigate(*predictor, "https://example.com/"sv);
+        VERIFY(result.navigation.has_value());
+
+        for (size_t origin_index = 0; origin_index <= navigation_index; ++origin_index)
+            predictor->did_start_subresource_request(*result.navigation, parse_url(ByteString::formatted("{}/resource", origins[origin_index])));
+    }
+
+    auto result = navigate(*predictor, "https://example.com/"sv);
+    EXPECT_EQ(result.preconnected_origins.size(), 6u);
+
+    for (size_t origin_index = 0; origin_index < origins.size(); ++origin_index)
+        EXPECT_EQ(was_preconnected(result, origins[origin_index]), origin_index < 6);
+}
+
+TEST_CASE(history_is_persisted_across_instances)
+{
+    Core::EventLoop event_loop;
+    auto path = test_history_path();
+
+    {
+        auto predictor = RequestServer::ConnectionPredictor::create(path);
+
+        auto result = navigate(*predictor, "https://example.com/"sv);
+        VERIFY(result.navigation.has_value());
+        predictor->did_start_subresource_request(*result.navigation, parse_url("https://cdn.example.net/app.js"sv));
+    }
+
+    // Unsaved history is written out when the predictor is destroyed.
+    EXPECT(FileSystem::exists(path.string()));
+
+    {
+        auto predictor = RequestServer::ConnectionPredictor::create(path);
+        auto result = navigate(*predictor, "https://example.com/"sv);
+        EXPECT_EQ(result.preconnected_origins.size(), 1u);
+        EXPECT(was_preconnected(result, "https://cdn.example.net"sv));
+    }
+
+    MUST(FileSystem::remove(path.string(), FileSystem::RecursionMode::Disallowed));
+}
+
+TEST_CASE(sites_navigated_since_a_given_time_are_forgotten)
+{
+    Core::EventLoop event_loop;
+    auto path = test_history_path();
+
+    {
+        auto predictor = RequestServer::ConnectionPredictor::create(path);
+
+        auto result = navigate(*predictor, "https://example.com/"sv);
+        VERIFY(result.navigation.has_value());
+        predictor->did_start_subresource_request(*result.navigation, parse_url("https://cdn.example.net/app.js"sv));
+
+        predictor->remove_sites_navigated_since(UnixDateTime::earliest());
+
+        // The removal is written out right away, without leaving a temporary file behind.
+        EXPECT(FileSystem::exists(path.string()));
+        EXPECT(!FileSystem::exists(ByteString::formatted("{}.tmp", path.string())));
+
+        result = navigate(*predictor, "https://example.com/"sv);
+        EXPECT(result.preconnected_origins.is_empty());
+
+        // Sites navigated to before the given time are kept.
+        predictor->did_start_subresource_request(*result.navigation, parse_url("https://cdn.example.net/app.js"sv));
+        predictor->remove_sites_navigated_since(UnixDateTime::now() + AK::Duration::from_seconds(60));
+
+        result = navigate(*predictor, "https://example.com/"sv);
+        EXPECT(was_preconnected(result, "https://cdn.example.net"sv));
+    }
+
+    MUST(FileSystem::remove(path.string(), FileSystem::RecursionMode::Disallowed));
+}
+
+TEST_CASE(corrupt_history_is_ignored)
+{
+    Core::EventLoop event_loop;
+    auto path = test_history_path();
+
+    {
+        auto file = MUST(Core::File::open(path.string(), Core::File::OpenMode::Write));
+        MUST(file->write_until_depleted("{ not json"sv));
+    }
+
+    {
+        auto predictor = RequestServer::ConnectionPredictor::create(path);
+        auto result = navigate(*predictor, "https://example.com/"sv);
+        VERIFY(result.navigation.has_value());
+        EXPECT(result.preconnected_origins.is_empty());
+    }
+
+    MUST(FileSystem::remove(path.string(), FileSystem::RecursionMode::Disallowed));
+}
@@ -19,10 +19,12 @@
 #include <LibCore/StandardPaths.h>
 #include <LibCrypto/Hash/SHA2.h>
 #include <LibJS/Bytecode/Debug.h>
+#include <LibJS/Bytecode/Statistics.h>
 #include <LibJS/Console.h>
 #include <LibJS/Contrib/Test262/GlobalObject.h>
 #include <LibJS/Debugger.h>
 #include <LibJS/Print.h>
+#include <LibJS/Profiler.h>
 #include <LibJS/Runtime/ConsoleObject.h>
 #include <LibJS/Runtime/DeclarativeEnvironment.h>
 #include <LibJS/Runtime/GlobalEnvironment.h>
@@ -1023,6 +1025,44 @@ static ErrorOr<int> run_repl(bool gc_on_every_allocation, [[maybe_unused]] bool
 
 #endif
 
+enum class ProfileFormat {
+    CpuProfile,
+    Collapsed,
+};
+
+static Optional<ProfileFormat> profile_format_from_string(StringView format)
+{
+    if (format == "cpuprofile"sv)
+        return ProfileFormat::CpuProfile;
+    if (format == "collapsed"sv)
+        return ProfileFormat::Collapsed;
+    return {};
+}
+
+static ErrorOr<void> write_profile(JS::Profiler& profiler, StringView path, ProfileFormat format)
+{
+    profiler.stop();
+
+    String profile;
+    switch (format) {
+    case ProfileFormat::CpuProfile:
+        profile = TRY(profiler.to_cpu_profile_json());
+        break;
+    case ProfileFormat::Collapsed:
+        profile = TRY(profiler.to_collapsed_stacks());
+        break;
+    }
+
+    auto file = TRY(Core::File::open(path, Core::File::OpenMode::Write));
+    TRY(file->write_until_depleted(profile.bytes()));
+
+    if (auto dropped_sample_count = profiler.dropped_sample_count(); dropped_sample_count > 0)
+        warnln("Profile written to {} with {} samples ({} dropped)", path, profiler.sample_count(), dropped_sample_count);
+    else
+        warnln("Profile written to {} with {} samples", path, profiler.sample_count());
+    return {};
+}
+
 ErrorOr<int> ladybird_main(Main::Arguments arguments)
 {
     bool gc_on_every_allocation = false;
@@ -1032,6 +1072,9 @@ ErrorOr<int> ladybird_main(Main::Arguments arguments)
     bool parse_only = false;
     bool debug = false;
     StringView evaluate_script;
+    StringView profile_path;
+    StringView profile_format_name = "cpuprofile"sv;
+    auto profile_interval_in_microseconds = static_cast<unsigned>(JS::Profiler::default_sampling_interval.to_microseconds());
     Vector<StringView> script_paths;
 
     Core::ArgsParser args_parser;
@@ -1050,9 +1093,23 @@ ErrorOr<int> ladybird_main(Main::Arguments arguments)
     args_parser.add_option(debug, "Run with the JavaScript debugger", "debug", {});
     args_parser.add_option(evaluate_script, "Evaluate argument as a script", "evaluate", 'c', "script");
     args_parser.add_option(use_test262_global, "Use test262 global ($262)", "use-test262-global", {});
+    args_parser.add_option(profile_path, "Write a sampling CPU profile of the script to a file", "profile", {}, "path");
+    args_parser.add_option(profile_format_name, "Format of the CPU profile: cpuprofile (Chrome DevTools) or collapsed (flame graph tools)", "profile-format", {}, "format");
+    args_parser.add_option(profile_interval_in_microseconds, "Sampling interval of the CPU profiler", "profile-interval", {}, "microseconds");
     args_parser.add_positional_argument(script_paths, "Path to script files", "scripts", Core::ArgsParser::Required::No);
     args_parser.parse(arguments);
 
+    // NB: Bad profiler options are rejected before running anything, rather than after the script has run to completion.
+    auto profile_format = profile_format_from_string(profile_format_name);
+    if (!profile_format.has_value()) {
+        warnln("Unknown profile format '{}', expected 'cpuprofile' or 'collapsed'", profile_format_name);
+        return 1;
+    }
+    if (profile_interval_in_microseconds == 0) {
+        warnln("The profile interval must be at least one microsecond");
+        return 1;
+    }
+
     [[maybe_unused]] bool syntax_highlight = !disable_syntax_highlight;
 
     JS::g_dump_ast = s_dump_ast;
@@ -1090,6 +1147,11 @@ ErrorOr<int> ladybird_main(Main::Arguments arguments)
         };
     }
 
+    ScopeGuard dump_bytecode_statistics = [] {
+        if constexpr (JS::Bytecode::Statistics::is_enabled())
+            JS::Bytecode::Statistics::the().dump();
+    };
+
     // FIXME: Figure out some way to interrupt the interpreter now that vm.exception() is gone.
 
     if (evaluate_script.is_empty() && script_paths.is_empty()) {
@@ -1141,9 +1203,18 @@ ErrorOr<int> ladybird_main(Main::Arguments arguments)
             source_name = "eval"sv;
         }
 
+        if (!profile_path.is_empty()) {
+            g_vm->enable_profiling();
+            TRY(g_vm->profiler()->start(AK::Duration::from_microseconds(profile_interval_in_microseconds)));
+        }
+
         // We resolve modules as if it is the first file
+        auto did_run = TRY(parse_and_run(realm, builder.string_view(), source_name, parse_only));
+
+        if (!profile_path.is_empty())
+            TRY(write_profile(*g_vm->profiler(), profile_path, *profile_format));
 
-        if (!TRY(parse_and_run(realm, builder.string_view(), source_name, parse_only)))
+        if (!did_run)
             return 1;
     }
 